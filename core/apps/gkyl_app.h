@@ -10,6 +10,12 @@ struct gkyl_update_status {
   double dt_suggested; // suggested stable time-step
 };
 
+// Explicit time-stepper used by an app
+enum gkyl_time_stepper_type {
+  GKYL_SSP_RK3 = 0, // three-stage, third-order SSP-RK (default)
+  GKYL_SSP_RK43, // four-stage, third-order low-storage SSP-RK
+};
+
 // Status of restart
 struct gkyl_app_restart_status {
   enum gkyl_array_rio_status io_status; // status of the file read
@@ -36,6 +42,12 @@ struct gkyl_app_parallelism_inp {
   bool use_gpu; // Run on the GPU(s).
   int cuts[3]; // Number of subdomain in each dimension.
   struct gkyl_comm *comm; // Communicator to use.
+
+  // Optional cost of each configuration-space cell (evaluated at cell
+  // centers), used to place the cuts so that subdomains have roughly the
+  // same cost. Subdomains have equal size if this is NULL.
+  void (*cell_cost)(double t, const double *xn, double *fout, void *ctx);
+  void *cell_cost_ctx; // Context for cell_cost.
 };
 
 // Boundary conditions on particles
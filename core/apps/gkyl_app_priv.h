@@ -2,10 +2,16 @@
 // in any public facing header!
 #pragma once
 
+#include <gkyl_alloc.h>
+#include <gkyl_app.h>
 #include <gkyl_array.h>
+#include <gkyl_array_numa.h>
 #include <gkyl_array_ops.h>
 #include <gkyl_comm.h>
+#include <gkyl_rect_decomp.h>
 
+#include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -29,6 +35,16 @@ mkarr(bool on_gpu, long nc, long size)
     a = gkyl_array_new(GKYL_DOUBLE, nc, size);
   return a;
 }
+// allocate double array for a distribution function (filled with
+// zeros). On the host its pages are first touched by the calling
+// thread, so they are placed on the NUMA node of the rank.
+static struct gkyl_array*
+mkarr_distf(bool on_gpu, long nc, long size)
+{
+  if (on_gpu)
+    return gkyl_array_cu_dev_new(GKYL_DOUBLE, nc, size);
+  return gkyl_array_numa_new(GKYL_DOUBLE, nc, size, 0);
+}
 // allocate integer array (filled with zeros)
 static struct gkyl_array*
 mk_int_arr(bool on_gpu, long nc, long size)
@@ -64,3 +80,94 @@ skin_ghost_ranges_init(struct app_skin_ghost_ranges *sgr,
       d, GKYL_UPPER_EDGE, parent, ghost);
   }
 }
+
+// Decompose the global range using the cuts in the parallelism input,
+// balancing the cost of the subdomains if a cell cost is provided.
+static struct gkyl_rect_decomp*
+app_decomp_new(const struct gkyl_app_parallelism_inp *par, const struct gkyl_rect_grid *grid,
+  const struct gkyl_range *global, const struct gkyl_range *global_ext)
+{
+  if (par->cell_cost == 0)
+    return gkyl_rect_decomp_new_from_cuts(grid->ndim, par->cuts, global);
+
+  struct gkyl_array *cost = gkyl_array_new(GKYL_DOUBLE, 1, global_ext->volume);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, global);
+  while (gkyl_range_iter_next(&iter)) {
+    double xc[GKYL_MAX_DIM];
+    gkyl_rect_grid_cell_center(grid, iter.idx, xc);
+    double *c = gkyl_array_fetch(cost, gkyl_range_idx(global, iter.idx));
+    par->cell_cost(0.0, xc, c, par->cell_cost_ctx);
+  }
+
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts_and_cost(grid->ndim,
+    par->cuts, global, cost);
+  gkyl_array_release(cost);
+  return decomp;
+}
+
+// Write the current and peak array memory and the number of live
+// arrays of each subsystem (see gkyl_mem_account_push), and the peak
+// array memory, as maxima over the ranks of comm, to fp on rank 0. If
+// target_bytes is positive, also estimate how many subdomains (at most
+// max_decomp) are needed to fit the peak memory per rank in it, assuming
+// it scales inversely with the number of subdomains. Returns the
+// suggested number of subdomains (ndecomp if the target is already met),
+// which is the same on all ranks.
+static int
+app_mem_report(struct gkyl_comm *comm, bool use_gpu, int ndecomp, int max_decomp,
+  double target_bytes, FILE *fp)
+{
+  int rank;
+  gkyl_comm_get_rank(comm, &rank);
+
+  // Ranks push the same subsystems in the same order, but a rank may
+  // not have reached all of them; its missing entries count as zero.
+  int nent_local = gkyl_mem_account_num_entries(), nent;
+  gkyl_comm_allreduce_host(comm, GKYL_INT, GKYL_MAX, 1, &nent_local, &nent);
+  struct gkyl_mem_account_stat stat = gkyl_mem_account_stat();
+  // Current bytes, peak bytes and number of arrays of each entry, then
+  // the peak totals.
+  int64_t bytes[3*nent+2], bytes_global[3*nent+2];
+  for (int i=0; i<nent; ++i) {
+    struct gkyl_mem_account_entry ent = i < nent_local ? gkyl_mem_account_entry(i)
+      : (struct gkyl_mem_account_entry) { };
+    bytes[3*i] = ent.curr_bytes;
+    bytes[3*i+1] = ent.peak_bytes;
+    bytes[3*i+2] = ent.num_arrays;
+  }
+  bytes[3*nent] = stat.peak_bytes[0];
+  bytes[3*nent+1] = stat.peak_bytes[1];
+  gkyl_comm_allreduce_host(comm, GKYL_INT_64, GKYL_MAX, 3*nent+2, bytes, bytes_global);
+
+  const double mb = 1024.0*1024.0;
+  if (rank == 0 && fp) {
+    fprintf(fp, "Array memory per rank (max over ranks):\n");
+    fprintf(fp, "  %-40s %15s %15s\n", "", "current", "peak");
+    for (int i=0; i<nent_local; ++i) {
+      if (bytes_global[3*i+1] == 0) continue;
+      struct gkyl_mem_account_entry ent = gkyl_mem_account_entry(i);
+      fprintf(fp, "  %-40s %12.3f MB %12.3f MB (%ld arrays)\n", ent.name,
+        bytes_global[3*i]/mb, bytes_global[3*i+1]/mb, (long) bytes_global[3*i+2]);
+    }
+    fprintf(fp, "  Peak host memory:   %12.3f MB\n", bytes_global[3*nent]/mb);
+    if (use_gpu)
+      fprintf(fp, "  Peak device memory: %12.3f MB\n", bytes_global[3*nent+1]/mb);
+  }
+
+  int suggested = ndecomp;
+  double peak = use_gpu ? bytes_global[3*nent+1] : bytes_global[3*nent];
+  if (target_bytes > 0.0 && peak > target_bytes) {
+    suggested = GKYL_MIN2(max_decomp, (int) ceil(ndecomp*peak/target_bytes));
+    if (rank == 0 && fp) {
+      fprintf(fp, "  Target of %.3f MB per rank needs about %d subdomains (now %d).\n",
+        target_bytes/mb, (int) ceil(ndecomp*peak/target_bytes), ndecomp);
+      if (suggested*target_bytes < ndecomp*peak)
+        fprintf(fp, "  *** Target can't be met with at most %d subdomains!\n", max_decomp);
+    }
+  }
+  else if (target_bytes > 0.0 && rank == 0 && fp) {
+    fprintf(fp, "  Fits in target of %.3f MB per rank.\n", target_bytes/mb);
+  }
+  return suggested;
+}
@@ -0,0 +1,251 @@
+// Benchmarks of core array and DG operations. Run with -h for options.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gkyl_array.h>
+#include <gkyl_array_ops.h>
+#include <gkyl_basis.h>
+#include <gkyl_bench.h>
+#include <gkyl_dg_bin_ops.h>
+#include <gkyl_proj_on_basis.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_grid.h>
+
+// Fill array with values in [0.5, 1.5), so that the DG expansions are
+// invertible.
+static void
+fill_array(struct gkyl_array *arr, unsigned seed)
+{
+  srand(seed);
+  double *d = arr->data;
+  for (long i=0; i<arr->size*arr->ncomp; ++i)
+    d[i] = 0.5 + rand()/(RAND_MAX+1.0);
+}
+
+struct array_ctx {
+  struct gkyl_array *out, *inp;
+};
+
+static void
+bench_array_clear(void *ctx, long ncells)
+{
+  struct array_ctx *ac = ctx;
+  gkyl_array_clear(ac->out, 0.0);
+}
+
+static void
+bench_array_set(void *ctx, long ncells)
+{
+  struct array_ctx *ac = ctx;
+  gkyl_array_set(ac->out, 1.0, ac->inp);
+}
+
+static void
+bench_array_scale(void *ctx, long ncells)
+{
+  struct array_ctx *ac = ctx;
+  gkyl_array_scale(ac->out, 0.999);
+}
+
+static void
+bench_array_accumulate(void *ctx, long ncells)
+{
+  struct array_ctx *ac = ctx;
+  gkyl_array_accumulate(ac->out, 1.0e-3, ac->inp);
+}
+
+static void
+array_ops(gkyl_bench *bench)
+{
+  int ncomp = 8;
+  long ncells = 1L << 21;
+  struct array_ctx ac = {
+    .out = gkyl_array_new(GKYL_DOUBLE, ncomp, ncells),
+    .inp = gkyl_array_new(GKYL_DOUBLE, ncomp, ncells),
+  };
+  fill_array(ac.out, 1);
+  fill_array(ac.inp, 2);
+
+  double sz = sizeof(double[ncomp]);
+  gkyl_bench_run(bench, "array_clear", bench_array_clear, &ac, ncells,
+    (struct gkyl_bench_work) { .flops = 0, .bytes = sz });
+  gkyl_bench_run(bench, "array_set", bench_array_set, &ac, ncells,
+    (struct gkyl_bench_work) { .flops = ncomp, .bytes = 2*sz });
+  gkyl_bench_run(bench, "array_scale", bench_array_scale, &ac, ncells,
+    (struct gkyl_bench_work) { .flops = ncomp, .bytes = 2*sz });
+  gkyl_bench_run(bench, "array_accumulate", bench_array_accumulate, &ac, ncells,
+    (struct gkyl_bench_work) { .flops = 2*ncomp, .bytes = 3*sz });
+
+  gkyl_array_release(ac.out);
+  gkyl_array_release(ac.inp);
+}
+
+static void
+make_basis(struct gkyl_basis *basis, int ndim, int poly_order, const char *bnm)
+{
+  if (strcmp(bnm, "ser") == 0)
+    gkyl_cart_modal_serendip(basis, ndim, poly_order);
+  else
+    gkyl_cart_modal_tensor(basis, ndim, poly_order);
+}
+
+// Twice the number of non-zero coupling coefficients of the weak
+// multiplication: found by multiplying pairs of basis functions.
+static double
+mul_op_flops(struct gkyl_basis basis)
+{
+  int nb = basis.num_basis;
+  struct gkyl_array *lop = gkyl_array_new(GKYL_DOUBLE, nb, 1);
+  struct gkyl_array *rop = gkyl_array_new(GKYL_DOUBLE, nb, 1);
+  struct gkyl_array *out = gkyl_array_new(GKYL_DOUBLE, nb, 1);
+  double *l = lop->data, *r = rop->data, *o = out->data;
+  long nnz = 0;
+  for (int i=0; i<nb; ++i) {
+    for (int j=0; j<nb; ++j) {
+      gkyl_array_clear(lop, 0.0); l[i] = 1.0;
+      gkyl_array_clear(rop, 0.0); r[j] = 1.0;
+      gkyl_dg_mul_op(basis, 0, out, 0, lop, 0, rop);
+      for (int k=0; k<nb; ++k)
+        nnz += fabs(o[k]) > 1e-14 ? 1 : 0;
+    }
+  }
+  gkyl_array_release(lop);
+  gkyl_array_release(rop);
+  gkyl_array_release(out);
+  return 2.0*nnz;
+}
+
+struct bin_op_ctx {
+  struct gkyl_basis basis;
+  gkyl_dg_bin_op_mem *mem;
+  struct gkyl_array *out, *lop, *rop;
+};
+
+static void
+bench_dg_mul_op(void *ctx, long ncells)
+{
+  struct bin_op_ctx *bc = ctx;
+  gkyl_dg_mul_op(bc->basis, 0, bc->out, 0, bc->lop, 0, bc->rop);
+}
+
+static void
+bench_dg_div_op(void *ctx, long ncells)
+{
+  struct bin_op_ctx *bc = ctx;
+  gkyl_dg_div_op(bc->mem, bc->basis, 0, bc->out, 0, bc->lop, 0, bc->rop);
+}
+
+static void
+bin_ops(gkyl_bench *bench, int ndim, int poly_order, const char *bnm)
+{
+  char mul_nm[64], div_nm[64];
+  snprintf(mul_nm, sizeof mul_nm, "dg_mul_op_%dx_%s_p%d", ndim, bnm, poly_order);
+  snprintf(div_nm, sizeof div_nm, "dg_div_op_%dx_%s_p%d", ndim, bnm, poly_order);
+  if (!gkyl_bench_enabled(bench, mul_nm) && !gkyl_bench_enabled(bench, div_nm))
+    return;
+
+  struct bin_op_ctx bc;
+  make_basis(&bc.basis, ndim, poly_order, bnm);
+  int nb = bc.basis.num_basis;
+  long ncells = (1L << 22)/nb;
+  bc.out = gkyl_array_new(GKYL_DOUBLE, nb, ncells);
+  bc.lop = gkyl_array_new(GKYL_DOUBLE, nb, ncells);
+  bc.rop = gkyl_array_new(GKYL_DOUBLE, nb, ncells);
+  fill_array(bc.lop, 1);
+  fill_array(bc.rop, 2);
+  bc.mem = gkyl_dg_bin_op_mem_new(ncells, nb);
+
+  double bytes = 3*sizeof(double[nb]);
+  gkyl_bench_run(bench, mul_nm, bench_dg_mul_op, &bc, ncells,
+    (struct gkyl_bench_work) { .flops = mul_op_flops(bc.basis), .bytes = bytes });
+  // The division solves a dense nb x nb system in each cell.
+  gkyl_bench_run(bench, div_nm, bench_dg_div_op, &bc, ncells,
+    (struct gkyl_bench_work) { .flops = mul_op_flops(bc.basis) + 2.0/3.0*nb*nb*nb, .bytes = bytes });
+
+  gkyl_dg_bin_op_mem_release(bc.mem);
+  gkyl_array_release(bc.out);
+  gkyl_array_release(bc.lop);
+  gkyl_array_release(bc.rop);
+}
+
+static void
+eval_func(double t, const double *xn, double *fout, void *ctx)
+{
+  fout[0] = 1.0 + 0.5*xn[0];
+}
+
+struct proj_ctx {
+  gkyl_proj_on_basis *proj;
+  struct gkyl_range range;
+  struct gkyl_array *out;
+};
+
+static void
+bench_proj_on_basis(void *ctx, long ncells)
+{
+  struct proj_ctx *pc = ctx;
+  gkyl_proj_on_basis_advance(pc->proj, 0.0, &pc->range, pc->out);
+}
+
+static void
+proj_on_basis(gkyl_bench *bench, int ndim, int poly_order, const char *bnm)
+{
+  char nm[64];
+  snprintf(nm, sizeof nm, "proj_on_basis_%dx_%s_p%d", ndim, bnm, poly_order);
+  if (!gkyl_bench_enabled(bench, nm))
+    return;
+
+  struct gkyl_basis basis;
+  make_basis(&basis, ndim, poly_order, bnm);
+  int nb = basis.num_basis, nq = poly_order+1;
+
+  int cells[GKYL_MAX_DIM];
+  double lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM];
+  int ncdir = ndim == 1 ? 1 << 16 : ndim == 2 ? 1 << 8 : 1 << 5;
+  for (int d=0; d<ndim; ++d) {
+    cells[d] = ncdir;
+    lower[d] = 0.0; upper[d] = 1.0;
+  }
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, ndim, lower, upper, cells);
+
+  struct proj_ctx pc;
+  gkyl_range_init_from_shape(&pc.range, ndim, cells);
+  pc.out = gkyl_array_new(GKYL_DOUBLE, nb, pc.range.volume);
+  pc.proj = gkyl_proj_on_basis_new(&grid, &basis, nq, 1, eval_func, 0);
+
+  // Each of the nq^ndim quadrature points adds to each coefficient.
+  double nqp = pow(nq, ndim);
+  gkyl_bench_run(bench, nm, bench_proj_on_basis, &pc, pc.range.volume,
+    (struct gkyl_bench_work) { .flops = 2*nqp*nb, .bytes = sizeof(double[nb]) });
+
+  gkyl_proj_on_basis_release(pc.proj);
+  gkyl_array_release(pc.out);
+}
+
+int
+main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "-h") == 0) {
+    printf("Usage: %s [-b baseline] [-o output] [-f filter] [-t threshold] [-m min-time]\n", argv[0]);
+    return 0;
+  }
+  struct gkyl_bench_inp inp = gkyl_bench_parse_args(argc, argv);
+  gkyl_bench *bench = gkyl_bench_new(&inp);
+
+  array_ops(bench);
+
+  const char *bnames[] = { "ser", "tensor" };
+  for (int b=0; b<2; ++b) {
+    for (int ndim=1; ndim<=3; ++ndim) {
+      for (int p=1; p<=2; ++p) {
+        bin_ops(bench, ndim, p, bnames[b]);
+        proj_on_basis(bench, ndim, p, bnames[b]);
+      }
+    }
+  }
+
+  return gkyl_bench_release(bench) > 0 ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+#ifdef __linux__
+#define _GNU_SOURCE // for sched_getaffinity and sched_getcpu
+#endif
+
+#include <acutest.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <gkyl_array_numa.h>
+#include <gkyl_thread_pool.h>
+
+struct job_ctx {
+  pthread_t thread; // thread job ran on
+  int cpu; // CPU job ran on (-1 if unknown)
+  double val;
+};
+
+static void
+job_func(void *ctx)
+{
+  struct job_ctx *jc = ctx;
+  jc->thread = pthread_self();
+#ifdef __linux__
+  jc->cpu = sched_getcpu();
+#else
+  jc->cpu = -1;
+#endif
+  jc->val += 1.0;
+}
+
+void
+test_pinned_pool()
+{
+  int nthreads = 3, njobs = 40;
+  struct gkyl_job_pool *jp = gkyl_thread_pool_pinned_new(nthreads, "compact");
+  TEST_CHECK( jp->pool_size == nthreads );
+
+  struct job_ctx ctx[2][njobs];
+  for (int r=0; r<2; ++r) {
+    for (int i=0; i<njobs; ++i) {
+      ctx[r][i].val = i;
+      gkyl_job_pool_add_work(jp, job_func, &ctx[r][i]);
+    }
+    gkyl_job_pool_wait(jp);
+  }
+
+  for (int i=0; i<njobs; ++i) {
+    TEST_CHECK( ctx[0][i].val == i+1.0 );
+    TEST_CHECK( ctx[1][i].val == i+1.0 );
+    // Job i runs on worker i % nthreads in every round.
+    TEST_CHECK( pthread_equal(ctx[0][i].thread, ctx[1][i].thread) );
+    TEST_CHECK( pthread_equal(ctx[0][i].thread, ctx[0][i % nthreads].thread) );
+    if (i >= nthreads)
+      continue;
+    for (int j=0; j<i; ++j)
+      TEST_CHECK( !pthread_equal(ctx[0][i].thread, ctx[0][j].thread) );
+  }
+
+  gkyl_job_pool_release(jp);
+
+  // Other affinity specs.
+  jp = gkyl_thread_pool_pinned_new(2, "scatter");
+  gkyl_job_pool_add_work(jp, job_func, &ctx[0][0]);
+  gkyl_job_pool_wait(jp);
+  gkyl_job_pool_release(jp);
+
+  jp = gkyl_thread_pool_pinned_new(4, "0,0-1");
+  gkyl_job_pool_add_work(jp, job_func, &ctx[0][0]);
+  gkyl_job_pool_wait(jp);
+  gkyl_job_pool_release(jp);
+}
+
+void
+test_pinned_pool_mask()
+{
+#ifdef __linux__
+  // Default pinning only uses CPUs in the process's affinity mask.
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  TEST_CHECK( sched_getaffinity(0, sizeof(set), &set) == 0 );
+
+  int nthreads = 2*CPU_COUNT(&set), njobs = 2*nthreads;
+  struct gkyl_job_pool *jp = gkyl_thread_pool_pinned_new(nthreads, 0);
+  struct job_ctx ctx[njobs];
+  for (int i=0; i<njobs; ++i) {
+    ctx[i].val = 0.0;
+    gkyl_job_pool_add_work(jp, job_func, &ctx[i]);
+  }
+  gkyl_job_pool_wait(jp);
+  for (int i=0; i<njobs; ++i) {
+    TEST_CHECK( ctx[i].cpu >= 0 && CPU_ISSET(ctx[i].cpu, &set) );
+    TEST_MSG( "job %d ran on CPU %d", i, ctx[i].cpu );
+  }
+  gkyl_job_pool_release(jp);
+#endif
+}
+
+void
+test_numa_array()
+{
+  int nthreads = 4;
+  struct gkyl_job_pool *jp = gkyl_thread_pool_pinned_new(nthreads, 0);
+
+  long size = 100000;
+  struct gkyl_array *arr = gkyl_array_numa_new(GKYL_DOUBLE, 3, size, jp);
+  TEST_CHECK( arr->size == size );
+  TEST_CHECK( arr->ncomp == 3 );
+
+  const double *d = arr->data;
+  bool all_zero = true;
+  for (long i=0; i<size*3; ++i)
+    all_zero = all_zero && d[i] == 0.0;
+  TEST_CHECK( all_zero );
+
+  // Splits own contiguous, non-overlapping pages covering the array.
+  long npages = gkyl_array_numa_num_pages(arr);
+  TEST_CHECK( npages >= size*3*sizeof(double)/4096 );
+  long next = 0;
+  for (int t=0; t<nthreads; ++t) {
+    long first, last;
+    gkyl_array_numa_split_pages(arr, nthreads, t, &first, &last);
+    TEST_CHECK( first == next );
+    TEST_CHECK( last >= first );
+    for (long p=first; p<last; ++p)
+      TEST_CHECK( gkyl_array_numa_page_owner(arr, nthreads, p) == t );
+    next = last;
+  }
+  TEST_CHECK( next == npages );
+
+  // All pages were touched, and all are accounted for.
+  struct gkyl_array_numa_stat stat = gkyl_array_numa_stat(arr, jp);
+  TEST_CHECK( stat.local_pages + stat.remote_pages + stat.unknown_pages == npages );
+  struct gkyl_array_numa_stat stat_self = gkyl_array_numa_stat(arr, 0);
+  TEST_CHECK( stat_self.local_pages + stat_self.remote_pages + stat_self.unknown_pages == npages );
+  TEST_CHECK( stat_self.unknown_pages == stat.unknown_pages );
+
+  gkyl_array_release(arr);
+
+  // Small array, with fewer pages than splits.
+  arr = gkyl_array_numa_new(GKYL_DOUBLE, 1, 10, jp);
+  long npages_small = gkyl_array_numa_num_pages(arr);
+  long tot = 0;
+  for (int t=0; t<nthreads; ++t) {
+    long first, last;
+    gkyl_array_numa_split_pages(arr, nthreads, t, &first, &last);
+    tot += last-first;
+  }
+  TEST_CHECK( tot == npages_small );
+  gkyl_array_release(arr);
+
+  arr = gkyl_array_numa_new(GKYL_DOUBLE, 2, 1000, 0);
+  d = arr->data;
+  TEST_CHECK( d[0] == 0.0 && d[1999] == 0.0 );
+  gkyl_array_release(arr);
+
+  gkyl_job_pool_release(jp);
+}
+
+TEST_LIST = {
+  { "test_pinned_pool", test_pinned_pool },
+  { "test_pinned_pool_mask", test_pinned_pool_mask },
+  { "test_numa_array", test_numa_array },
+  { NULL, NULL },
+};
@@ -108,6 +108,42 @@ void test_array_accumulate_range()
   gkyl_array_release(a2);
 }
 
+void test_array_combine3_range()
+{
+  int shape[] = {10, 20};
+  struct gkyl_range range;
+  gkyl_range_init_from_shape(&range, 2, shape);
+
+  struct gkyl_range sub_range;
+  gkyl_sub_range_init(&sub_range, &range, (int[]) { 2, 3 }, (int[]) { 7, 12 });
+  
+  struct gkyl_array *a1 = gkyl_array_new(GKYL_DOUBLE, 3, range.volume);
+  struct gkyl_array *a2 = gkyl_array_new(GKYL_DOUBLE, 3, range.volume);
+  struct gkyl_array *a3 = gkyl_array_new(GKYL_DOUBLE, 3, range.volume);
+
+  // test a2 = 0.75*a1 + 0.25*a2 + 0.5*a3 on a sub-range
+  gkyl_array_clear(a1, 0.5);
+  gkyl_array_clear(a2, 1.5);
+  gkyl_array_clear(a3, 2.5);
+
+  gkyl_array_combine3_range(a2, 0.75, a1, 0.25, a2, 0.5, a3, &sub_range);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&range, iter.idx);
+    double *a2d = gkyl_array_fetch(a2, loc);
+    bool in_sub = gkyl_range_contains_idx(&sub_range, iter.idx);
+    for (int i=0; i<3; ++i)
+      TEST_CHECK( a2d[i] == (in_sub ? 0.75*0.5 + 0.25*1.5 + 0.5*2.5 : 1.5) );
+  }
+
+  gkyl_array_release(a1);
+  gkyl_array_release(a2);
+  gkyl_array_release(a3);
+}
+
 void test_array_accumulate_offset()
 {
   struct gkyl_array *a1 = gkyl_array_new(GKYL_DOUBLE, 2, 10);
@@ -1790,6 +1826,7 @@ TEST_LIST = {
   { "array_clear_range", test_array_clear_range },
   { "array_accumulate", test_array_accumulate },
   { "array_accumulate_range", test_array_accumulate_range },
+  { "array_combine3_range", test_array_combine3_range },
   { "array_accumulate_offset", test_array_accumulate_offset },
   { "array_accumulate_offset_range", test_array_accumulate_offset_range },
   { "array_combine", test_array_combine },
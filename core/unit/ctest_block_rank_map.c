@@ -0,0 +1,279 @@
+#include <acutest.h>
+
+#include <gkyl_block_rank_map.h>
+
+static void
+test_single_block(void)
+{
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 2,
+      .num_blocks = 1,
+      .num_ranks = 4,
+      .cells = (int[]) { 16, 8 },
+    }
+  );
+
+  TEST_CHECK( 4 == brm->total_ranks );
+  TEST_CHECK( 4 == gkyl_block_rank_map_nranks(brm, 0) );
+
+  // 2x2 and 4x1 cuts have the same halo volume: first one found is used
+  int cuts[2];
+  gkyl_block_rank_map_getcuts(brm, 0, cuts);
+  TEST_CHECK( 2 == cuts[0] );
+  TEST_CHECK( 2 == cuts[1] );
+
+  int ranks[4];
+  gkyl_block_rank_map_getranks(brm, 0, ranks);
+  for (int i=0; i<4; ++i)
+    TEST_CHECK( i == ranks[i] );
+
+  TEST_CHECK( 32.0 == brm->max_cost );
+  TEST_CHECK( 32.0 == brm->avg_cost );
+
+  gkyl_block_rank_map_release(brm);
+}
+
+static void
+test_cell_balance(void)
+{
+  // large block gets more ranks
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 1,
+      .num_blocks = 3,
+      .num_ranks = 4,
+      .cells = (int[]) { 64, 32, 32 },
+    }
+  );
+
+  TEST_CHECK( 2 == gkyl_block_rank_map_nranks(brm, 0) );
+  TEST_CHECK( 1 == gkyl_block_rank_map_nranks(brm, 1) );
+  TEST_CHECK( 1 == gkyl_block_rank_map_nranks(brm, 2) );
+
+  int cuts[1], ranks[2];
+  gkyl_block_rank_map_getcuts(brm, 0, cuts);
+  TEST_CHECK( 2 == cuts[0] );
+
+  gkyl_block_rank_map_getranks(brm, 0, ranks);
+  TEST_CHECK( 0 == ranks[0] );
+  TEST_CHECK( 1 == ranks[1] );
+  gkyl_block_rank_map_getranks(brm, 1, ranks);
+  TEST_CHECK( 2 == ranks[0] );
+  gkyl_block_rank_map_getranks(brm, 2, ranks);
+  TEST_CHECK( 3 == ranks[0] );
+
+  TEST_CHECK( 32.0 == brm->max_cost );
+
+  gkyl_block_rank_map_release(brm);
+}
+
+static void
+test_cost_balance(void)
+{
+  // block 0 is four times as expensive as the others: it is split in
+  // two, and the two cheap blocks share a rank
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 1,
+      .num_blocks = 3,
+      .num_ranks = 3,
+      .cells = (int[]) { 32, 32, 32 },
+      .cost = (double[]) { 4.0, 1.0, 1.0 },
+    }
+  );
+
+  TEST_CHECK( 2 == gkyl_block_rank_map_nranks(brm, 0) );
+  TEST_CHECK( 1 == gkyl_block_rank_map_nranks(brm, 1) );
+  TEST_CHECK( 1 == gkyl_block_rank_map_nranks(brm, 2) );
+
+  int ranks[2];
+  gkyl_block_rank_map_getranks(brm, 0, ranks);
+  TEST_CHECK( 0 == ranks[0] );
+  TEST_CHECK( 1 == ranks[1] );
+  gkyl_block_rank_map_getranks(brm, 1, ranks);
+  TEST_CHECK( 2 == ranks[0] );
+  gkyl_block_rank_map_getranks(brm, 2, ranks);
+  TEST_CHECK( 2 == ranks[0] );
+
+  TEST_CHECK( gkyl_compare_double(2.0, brm->max_cost, 1e-14) );
+  TEST_CHECK( gkyl_compare_double(2.0, brm->avg_cost, 1e-14) );
+
+  gkyl_block_rank_map_release(brm);
+}
+
+static void
+test_colocate(void)
+{
+  // chain of four equal blocks on two ranks
+  struct gkyl_block_topo *btopo = gkyl_block_topo_new(1, 4);
+  for (int b=0; b<4; ++b) {
+    btopo->conn[b] = (struct gkyl_block_connections) {
+      .connections[0] = {
+        b > 0 ? (struct gkyl_target_edge) { .bid = b-1, .dir = 0, .edge = GKYL_UPPER_POSITIVE }
+              : (struct gkyl_target_edge) { .bid = b, .dir = 0, .edge = GKYL_PHYSICAL },
+        b < 3 ? (struct gkyl_target_edge) { .bid = b+1, .dir = 0, .edge = GKYL_LOWER_POSITIVE }
+              : (struct gkyl_target_edge) { .bid = b, .dir = 0, .edge = GKYL_PHYSICAL },
+      }
+    };
+  }
+  TEST_CHECK( 1 == gkyl_block_topo_check_consistency(btopo) );
+
+  struct gkyl_block_rank_map_inp inp = {
+    .ndim = 1,
+    .num_blocks = 4,
+    .num_ranks = 2,
+    .cells = (int[]) { 8, 8, 8, 8 },
+  };
+
+  // without topology blocks are dealt out to ranks
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&inp);
+  int r[4];
+  for (int b=0; b<4; ++b) {
+    TEST_CHECK( 1 == gkyl_block_rank_map_nranks(brm, b) );
+    gkyl_block_rank_map_getranks(brm, b, &r[b]);
+  }
+  TEST_CHECK( r[0] == r[2] );
+  TEST_CHECK( r[1] == r[3] );
+  TEST_CHECK( 16.0 == brm->max_cost );
+  gkyl_block_rank_map_release(brm);
+
+  // with topology the two middle blocks share a rank
+  inp.topo = btopo;
+  brm = gkyl_block_rank_map_new(&inp);
+  for (int b=0; b<4; ++b)
+    gkyl_block_rank_map_getranks(brm, b, &r[b]);
+  TEST_CHECK( r[0] == r[3] );
+  TEST_CHECK( r[1] == r[2] );
+  TEST_CHECK( r[0] != r[1] );
+  TEST_CHECK( 16.0 == brm->max_cost );
+  gkyl_block_rank_map_release(brm);
+
+  gkyl_block_topo_release(btopo);
+}
+
+static void
+test_uneven(void)
+{
+  // 5 ranks can't cut a 4x4 block, so the second block gets 3 ranks
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 2,
+      .num_blocks = 2,
+      .num_ranks = 5,
+      .cells = (int[]) { 4, 4, 4, 4 },
+    }
+  );
+
+  int nr0 = gkyl_block_rank_map_nranks(brm, 0), nr1 = gkyl_block_rank_map_nranks(brm, 1);
+  TEST_CHECK( 5 == nr0 + nr1 );
+
+  // every rank handles exactly one piece
+  int count[5] = { 0 };
+  for (int b=0; b<2; ++b) {
+    int cuts[2], ranks[5];
+    gkyl_block_rank_map_getcuts(brm, b, cuts);
+    TEST_CHECK( cuts[0]*cuts[1] == gkyl_block_rank_map_nranks(brm, b) );
+    gkyl_block_rank_map_getranks(brm, b, ranks);
+    for (int i=0; i<gkyl_block_rank_map_nranks(brm, b); ++i)
+      count[ranks[i]] += 1;
+  }
+  for (int i=0; i<5; ++i)
+    TEST_CHECK( 1 == count[i] );
+  TEST_CHECK( 8.0 == brm->max_cost );
+
+  gkyl_block_rank_map_release(brm);
+
+  // too few cells for the number of ranks
+  brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 2,
+      .num_blocks = 1,
+      .num_ranks = 5,
+      .cells = (int[]) { 4, 4 },
+    }
+  );
+  TEST_CHECK( 0 == brm );
+}
+
+static void
+test_uncut_dirs(void)
+{
+  // Only the last direction may be cut, as in the gyrokinetic app: the
+  // 2x2 cuts of test_single_block are not allowed.
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 2,
+      .num_blocks = 2,
+      .num_ranks = 6,
+      .cells = (int[]) { 16, 8, 16, 4 },
+      .uncut_dirs = { true, false },
+    }
+  );
+
+  TEST_CHECK( 4 == gkyl_block_rank_map_nranks(brm, 0) );
+  TEST_CHECK( 2 == gkyl_block_rank_map_nranks(brm, 1) );
+  for (int b=0; b<2; ++b) {
+    int cuts[2];
+    gkyl_block_rank_map_getcuts(brm, b, cuts);
+    TEST_CHECK( 1 == cuts[0] );
+    TEST_CHECK( gkyl_block_rank_map_nranks(brm, b) == cuts[1] );
+  }
+  gkyl_block_rank_map_release(brm);
+
+  // Not enough cells in the direction that may be cut.
+  brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 2,
+      .num_blocks = 1,
+      .num_ranks = 4,
+      .cells = (int[]) { 16, 2 },
+      .uncut_dirs = { true, false },
+    }
+  );
+  TEST_CHECK( 0 == brm );
+}
+
+static void
+test_even_cuts(void)
+{
+  // 8 cells can't be cut evenly into 3 pieces: with even cuts the
+  // middle block is cut into 2 or 4 pieces instead.
+  struct gkyl_block_rank_map_inp inp = {
+    .ndim = 1,
+    .num_blocks = 3,
+    .num_ranks = 6,
+    .cells = (int[]) { 4, 8, 4 },
+  };
+  const struct gkyl_block_rank_map *brm = gkyl_block_rank_map_new(&inp);
+  TEST_CHECK( 3 == gkyl_block_rank_map_nranks(brm, 1) );
+  gkyl_block_rank_map_release(brm);
+
+  inp.even_cuts = true;
+  brm = gkyl_block_rank_map_new(&inp);
+  int nranks = 0;
+  for (int b=0; b<3; ++b) {
+    int cuts[1];
+    gkyl_block_rank_map_getcuts(brm, b, cuts);
+    TEST_CHECK( 0 == inp.cells[b] % cuts[0] );
+    TEST_MSG( "block %d: %d cells, %d cuts", b, inp.cells[b], cuts[0] );
+    nranks += gkyl_block_rank_map_nranks(brm, b);
+  }
+  TEST_CHECK( nranks >= 6 );
+  gkyl_block_rank_map_release(brm);
+
+  // 6 cells can only be cut evenly into 1, 2, 3 or 6 pieces.
+  brm = gkyl_block_rank_map_new(&(struct gkyl_block_rank_map_inp) {
+      .ndim = 1,
+      .num_blocks = 1,
+      .num_ranks = 4,
+      .cells = (int[]) { 6 },
+      .even_cuts = true,
+    }
+  );
+  TEST_CHECK( 0 == brm );
+}
+
+TEST_LIST = {
+  { "test_single_block", test_single_block },
+  { "test_cell_balance", test_cell_balance },
+  { "test_cost_balance", test_cost_balance },
+  { "test_colocate", test_colocate },
+  { "test_uneven", test_uneven },
+  { "test_uncut_dirs", test_uncut_dirs },
+  { "test_even_cuts", test_even_cuts },
+  { NULL, NULL },
+};
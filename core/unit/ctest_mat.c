@@ -287,6 +287,52 @@ test_nmat_linsolve_(bool pre_alloc)
 void test_nmat_linsolve() { test_nmat_linsolve_(false); }
 void test_nmat_linsolve_pa() { test_nmat_linsolve_(true); }
 
+void
+test_nmat_linsolve_pa_num()
+{
+  struct gkyl_nmat *As = gkyl_nmat_new(5, 3, 3);
+  struct gkyl_nmat *xs = gkyl_nmat_new(5, 3, 1);
+
+  for (int n=0; n<As->num; ++n) {
+    struct gkyl_mat A = gkyl_nmat_get(As, n);
+    gkyl_mat_clear(&A, 0.0);
+    // A : matrix( [n+2,1,0], [1,n+2,1], [0,1,n+2] );
+    for (int i=0; i<A.nr; ++i) {
+      gkyl_mat_set(&A,i,i,n+2.0);
+      if (i>0) gkyl_mat_set(&A,i,i-1,1.0);
+      if (i<A.nr-1) gkyl_mat_set(&A,i,i+1,1.0);
+    }
+    struct gkyl_mat x = gkyl_nmat_get(xs, n);
+    gkyl_mat_clear(&x, 1.0);
+  }
+
+  // only the first three systems are solved, the rest are untouched
+  gkyl_nmat_mem *mem = gkyl_nmat_linsolve_lu_new(As->num, As->nr);
+  bool status = gkyl_nmat_linsolve_lu_pa_num(mem, 3, As, xs);
+  TEST_CHECK( status );
+
+  for (int n=0; n<xs->num; ++n) {
+    struct gkyl_mat A = gkyl_nmat_get(As, n);
+    struct gkyl_mat x = gkyl_nmat_get(xs, n);
+    if (n<3) {
+      // sol : matrix( [(a-1)/(a^2-2), (a-2)/(a^2-2), (a-1)/(a^2-2)] ), a = n+2
+      double a = n+2.0, det = a*a-2.0;
+      TEST_CHECK( gkyl_compare(gkyl_mat_get(&x,0,0), (a-1.0)/det, 1e-14) );
+      TEST_CHECK( gkyl_compare(gkyl_mat_get(&x,1,0), (a-2.0)/det, 1e-14) );
+      TEST_CHECK( gkyl_compare(gkyl_mat_get(&x,2,0), (a-1.0)/det, 1e-14) );
+    }
+    else {
+      for (int i=0; i<x.nr; ++i)
+        TEST_CHECK( gkyl_mat_get(&x,i,0) == 1.0 );
+      TEST_CHECK( gkyl_mat_get(&A,1,0) == 1.0 );
+    }
+  }
+
+  gkyl_nmat_linsolve_lu_release(mem);
+  gkyl_nmat_release(As);
+  gkyl_nmat_release(xs);
+}
+
 #ifdef GKYL_HAVE_CUDA
 
 void
@@ -895,6 +941,7 @@ TEST_LIST = {
   { "nmat_base", test_nmat_base },
   { "nmat_linsolve", test_nmat_linsolve },
   { "nmat_linsolve_pa", test_nmat_linsolve_pa },
+  { "nmat_linsolve_pa_num", test_nmat_linsolve_pa_num },
   { "mv", test_mat_mv},
   { "nmat_mv", test_nmat_mv},
   { "nmat_mm", test_nmat_mm},
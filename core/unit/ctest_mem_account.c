@@ -0,0 +1,173 @@
+#include <acutest.h>
+
+#include <pthread.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_array.h>
+
+// Index of entry with given name, or -1.
+static int
+find_entry(const char *name)
+{
+  for (int i=0; i<gkyl_mem_account_num_entries(); ++i)
+    if (strcmp(gkyl_mem_account_entry(i).name, name) == 0)
+      return i;
+  return -1;
+}
+
+void
+test_account()
+{
+  gkyl_mem_account_reset();
+  struct gkyl_mem_account_stat stat0 = gkyl_mem_account_stat();
+
+  gkyl_mem_account_push("elc");
+  struct gkyl_array *f = gkyl_array_new(GKYL_DOUBLE, 8, 100);
+
+  gkyl_mem_account_push("lbo");
+  struct gkyl_array *nu = gkyl_array_new(GKYL_DOUBLE, 2, 100);
+  struct gkyl_array *m = gkyl_array_new(GKYL_INT, 1, 10);
+  gkyl_mem_account_pop();
+
+  gkyl_mem_account_pop();
+
+  gkyl_mem_account_push("field");
+  struct gkyl_array *phi = gkyl_array_new(GKYL_DOUBLE, 2, 100);
+  gkyl_array_release(phi);
+  gkyl_mem_account_pop();
+
+  TEST_CHECK( gkyl_mem_account_num_entries() == 3 );
+
+  int ie = find_entry("elc"), il = find_entry("elc/lbo"), iff = find_entry("field");
+  TEST_CHECK( ie == 0 );
+  TEST_CHECK( il == 1 );
+  TEST_CHECK( iff == 2 );
+
+  TEST_CHECK( gkyl_mem_account_entry(ie).curr_bytes == sizeof(double[8*100]) );
+  TEST_CHECK( gkyl_mem_account_entry(ie).num_arrays == 1 );
+  TEST_CHECK( gkyl_mem_account_entry(il).curr_bytes == sizeof(double[2*100]) + sizeof(int[10]) );
+  TEST_CHECK( gkyl_mem_account_entry(il).num_arrays == 2 );
+  // Released arrays are given back to their entry, but count in its peak.
+  TEST_CHECK( gkyl_mem_account_entry(iff).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(iff).peak_bytes == sizeof(double[2*100]) );
+  TEST_CHECK( gkyl_mem_account_entry(iff).num_arrays == 0 );
+
+  struct gkyl_mem_account_stat stat = gkyl_mem_account_stat();
+  size_t live = sizeof(double[8*100]) + sizeof(double[2*100]) + sizeof(int[10]);
+  TEST_CHECK( stat.curr_bytes[0] - stat0.curr_bytes[0] == live );
+  TEST_CHECK( stat.peak_bytes[0] - stat0.curr_bytes[0] == live + sizeof(double[2*100]) );
+
+  // Clones are accounted, arrays on user buffers are not.
+  struct gkyl_array *fc = gkyl_array_clone(f);
+  double buff[10];
+  struct gkyl_array *ub = gkyl_array_new_from_buff(GKYL_DOUBLE, 1, 10, buff);
+  stat = gkyl_mem_account_stat();
+  TEST_CHECK( stat.curr_bytes[0] - stat0.curr_bytes[0] == live + sizeof(double[8*100]) );
+  gkyl_array_release(ub);
+  gkyl_array_release(fc);
+
+  gkyl_array_release(f);
+  gkyl_array_release(nu);
+  gkyl_array_release(m);
+
+  stat = gkyl_mem_account_stat();
+  TEST_CHECK( stat.curr_bytes[0] == stat0.curr_bytes[0] );
+
+  TEST_CHECK( gkyl_mem_account_entry(ie).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(ie).peak_bytes == sizeof(double[8*100]) );
+  TEST_CHECK( gkyl_mem_account_entry(il).num_arrays == 0 );
+
+  gkyl_mem_account_reset();
+  TEST_CHECK( gkyl_mem_account_num_entries() == 3 );
+  TEST_CHECK( gkyl_mem_account_entry(ie).peak_bytes == 0 );
+  stat = gkyl_mem_account_stat();
+  TEST_CHECK( stat.peak_bytes[0] == stat.curr_bytes[0] );
+}
+
+void
+test_peak()
+{
+  gkyl_mem_account_reset();
+
+  // Arrays freed in one entry are given back to it, even if another
+  // entry is active then.
+  gkyl_mem_account_push("peak");
+  struct gkyl_array *a = gkyl_array_new(GKYL_DOUBLE, 4, 100);
+  gkyl_mem_account_pop();
+  gkyl_mem_account_push("other");
+  gkyl_array_release(a);
+  gkyl_mem_account_pop();
+
+  int ip = find_entry("peak"), io = find_entry("other");
+  TEST_CHECK( gkyl_mem_account_entry(ip).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(io).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(io).peak_bytes == 0 );
+
+  // Peak is the largest live memory, not the sum of allocations.
+  gkyl_mem_account_push("peak");
+  for (int i=0; i<5; ++i) {
+    struct gkyl_array *t = gkyl_array_new(GKYL_DOUBLE, 1, 100);
+    gkyl_array_release(t);
+  }
+  a = gkyl_array_new(GKYL_DOUBLE, 1, 100);
+  struct gkyl_array *b = gkyl_array_new(GKYL_DOUBLE, 1, 100);
+  gkyl_array_release(b);
+  gkyl_mem_account_pop();
+
+  TEST_CHECK( gkyl_mem_account_entry(ip).curr_bytes == sizeof(double[100]) );
+  TEST_CHECK( gkyl_mem_account_entry(ip).peak_bytes == sizeof(double[4*100]) );
+  TEST_CHECK( gkyl_mem_account_entry(ip).num_arrays == 1 );
+
+  gkyl_mem_account_reset();
+  TEST_CHECK( gkyl_mem_account_entry(ip).peak_bytes == sizeof(double[100]) );
+  gkyl_array_release(a);
+  TEST_CHECK( gkyl_mem_account_entry(ip).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(ip).peak_bytes == sizeof(double[100]) );
+}
+
+static void*
+thread_alloc(void *ctx)
+{
+  struct gkyl_array **arr = ctx;
+  // This thread's stack starts empty, whatever the main thread pushed.
+  arr[0] = gkyl_array_new(GKYL_DOUBLE, 1, 10);
+  gkyl_mem_account_push("thr");
+  arr[1] = gkyl_array_new(GKYL_DOUBLE, 1, 20);
+  gkyl_mem_account_pop();
+  return 0;
+}
+
+void
+test_threads()
+{
+  gkyl_mem_account_reset();
+
+  gkyl_mem_account_push("main");
+  struct gkyl_array *arr[2];
+  pthread_t th;
+  pthread_create(&th, 0, thread_alloc, arr);
+  pthread_join(th, 0);
+  struct gkyl_array *m = gkyl_array_new(GKYL_DOUBLE, 1, 30);
+  gkyl_mem_account_pop();
+
+  int im = find_entry("main"), it = find_entry("thr");
+  TEST_CHECK( im >= 0 && it >= 0 );
+  TEST_CHECK( find_entry("main/thr") < 0 );
+  TEST_CHECK( gkyl_mem_account_entry(im).curr_bytes == sizeof(double[30]) );
+  TEST_CHECK( gkyl_mem_account_entry(im).num_arrays == 1 );
+  TEST_CHECK( gkyl_mem_account_entry(it).curr_bytes == sizeof(double[20]) );
+
+  gkyl_array_release(arr[0]);
+  gkyl_array_release(arr[1]);
+  gkyl_array_release(m);
+  TEST_CHECK( gkyl_mem_account_entry(im).curr_bytes == 0 );
+  TEST_CHECK( gkyl_mem_account_entry(it).curr_bytes == 0 );
+}
+
+TEST_LIST = {
+  { "test_account", test_account },
+  { "test_peak", test_peak },
+  { "test_threads", test_threads },
+  { NULL, NULL },
+};
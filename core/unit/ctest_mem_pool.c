@@ -0,0 +1,157 @@
+#include <acutest.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_array.h>
+#include <gkyl_array_ops.h>
+
+void
+test_alloc_free()
+{
+  gkyl_mem_pool *pool = gkyl_mem_pool_new("test");
+
+  double *d1 = gkyl_mem_pool_alloc(pool, sizeof(double[100]));
+  TEST_CHECK( ((uintptr_t) d1) % 64 == 0 );
+  for (int i=0; i<100; ++i) d1[i] = i;
+
+  char *c1 = gkyl_mem_pool_alloc(pool, 10);
+  TEST_CHECK( ((uintptr_t) c1) % 64 == 0 );
+  memset(c1, 1, 10);
+
+  struct gkyl_mem_pool_stat stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.num_alloc == 2 );
+  TEST_CHECK( stat.num_reuse == 0 );
+  TEST_CHECK( stat.curr_bytes >= 810 );
+  TEST_CHECK( stat.curr_bytes <= 1.25*800+64 );
+  TEST_CHECK( stat.peak_bytes == stat.curr_bytes );
+
+  // Freed block is reused for a request in the same size class.
+  gkyl_mem_pool_free(d1);
+  double *d2 = gkyl_mem_pool_alloc(pool, sizeof(double[98]));
+  TEST_CHECK( d2 == d1 );
+  stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.num_reuse == 1 );
+
+  // A larger request gets a new block.
+  double *d3 = gkyl_mem_pool_alloc(pool, sizeof(double[1000]));
+  TEST_CHECK( d3 != d1 );
+  for (int i=0; i<1000; ++i) d3[i] = i;
+
+  gkyl_mem_pool_free(d2);
+  gkyl_mem_pool_free(d3);
+  gkyl_mem_pool_free(c1);
+  stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.curr_bytes == 0 );
+  TEST_CHECK( stat.held_bytes > 0 );
+  TEST_CHECK( stat.peak_bytes >= 8000 );
+
+  gkyl_mem_pool_trim(pool);
+  stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.held_bytes == 0 );
+
+  gkyl_mem_pool_release(pool);
+}
+
+void
+test_arena()
+{
+  gkyl_mem_pool *pool = gkyl_mem_pool_new("test_arena");
+
+  void *keep = gkyl_mem_pool_alloc(pool, 256);
+
+  int a1 = gkyl_mem_pool_arena_begin(pool);
+  void *p1 = gkyl_mem_pool_alloc(pool, 1000);
+  void *p2 = gkyl_mem_pool_alloc(pool, 2000);
+  gkyl_mem_pool_free(p1);
+
+  int a2 = gkyl_mem_pool_arena_begin(pool);
+  void *p3 = gkyl_mem_pool_alloc(pool, 3000);
+  void *p4 = gkyl_mem_pool_alloc(pool, 900); // reuses p1
+  TEST_CHECK( p4 == p1 );
+  gkyl_mem_pool_arena_end(pool, a2);
+
+  struct gkyl_mem_pool_stat stat = gkyl_mem_pool_stat(pool);
+  size_t sz_outer = stat.curr_bytes;
+  TEST_CHECK( sz_outer >= 256+2000 );
+  TEST_CHECK( sz_outer < 256+2000+3000 );
+
+  void *p5 = gkyl_mem_pool_alloc(pool, 3000); // reuses p3
+  TEST_CHECK( p5 == p3 );
+  gkyl_mem_pool_arena_end(pool, a1);
+
+  stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.curr_bytes <= 320 );
+  TEST_CHECK( stat.peak_bytes >= 256+1000+2000+3000 );
+
+  // Arenas can be reopened.
+  int a3 = gkyl_mem_pool_arena_begin(pool);
+  TEST_CHECK( a3 == a1 );
+  void *p6 = gkyl_mem_pool_alloc(pool, 2000);
+  TEST_CHECK( p6 == p2 );
+  gkyl_mem_pool_arena_end(pool, a3);
+
+  gkyl_mem_pool_free(keep);
+  stat = gkyl_mem_pool_stat(pool);
+  TEST_CHECK( stat.curr_bytes == 0 );
+
+  gkyl_mem_pool_release(pool);
+}
+
+void
+test_array_pool()
+{
+  gkyl_mem_pool *pool = gkyl_mem_pool_new("test_array");
+
+  struct gkyl_array *a1 = gkyl_array_pool_new(pool, GKYL_DOUBLE, 3, 200);
+  TEST_CHECK( a1->ncomp == 3 );
+  TEST_CHECK( a1->size == 200 );
+  TEST_CHECK( ((uintptr_t) a1->data) % 32 == 0 );
+  const double *d = a1->data;
+  bool all_zero = true;
+  for (int i=0; i<600; ++i)
+    all_zero = all_zero && d[i] == 0.0;
+  TEST_CHECK( all_zero );
+  gkyl_array_clear(a1, 2.5);
+  TEST_CHECK( d[599] == 2.5 );
+
+  struct gkyl_array *a1_ref = gkyl_array_acquire(a1);
+  gkyl_array_release(a1);
+  TEST_CHECK( gkyl_mem_pool_stat(pool).curr_bytes > 0 );
+  gkyl_array_release(a1_ref);
+  TEST_CHECK( gkyl_mem_pool_stat(pool).curr_bytes == 0 );
+
+  // A clone of a pool array is heap-allocated, and released as such.
+  struct gkyl_array *a4 = gkyl_array_pool_new(pool, GKYL_DOUBLE, 3, 200);
+  gkyl_array_clear(a4, 1.5);
+  struct gkyl_array *a4_clone = gkyl_array_clone(a4);
+  gkyl_array_release(a4);
+  TEST_CHECK( ((const double*) a4_clone->data)[599] == 1.5 );
+  gkyl_array_release(a4_clone);
+  TEST_CHECK( gkyl_mem_pool_stat(pool).curr_bytes == 0 );
+
+  // Arrays released or not before the end of the arena.
+  int a = gkyl_mem_pool_arena_begin(pool);
+  struct gkyl_array *a2 = gkyl_array_pool_new(pool, GKYL_DOUBLE, 3, 200);
+  TEST_CHECK( a2 == a1 ); // same block reused
+  struct gkyl_array *a3 = gkyl_array_pool_new(pool, GKYL_INT, 1, 50);
+  gkyl_array_release(a3);
+  gkyl_mem_pool_arena_end(pool, a);
+  TEST_CHECK( gkyl_mem_pool_stat(pool).curr_bytes == 0 );
+
+  FILE *fp = tmpfile();
+  gkyl_mem_pool_stat_write(fp);
+  long sz = ftell(fp);
+  TEST_CHECK( sz > 0 );
+  fclose(fp);
+
+  gkyl_mem_pool_release(pool);
+}
+
+TEST_LIST = {
+  { "test_alloc_free", test_alloc_free },
+  { "test_arena", test_arena },
+  { "test_array_pool", test_array_pool },
+  { NULL, NULL },
+};
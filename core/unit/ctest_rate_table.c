@@ -0,0 +1,196 @@
+#include <acutest.h>
+
+#include <math.h>
+
+#include <gkyl_array.h>
+#include <gkyl_rate_table.h>
+#include <gkyl_rect_decomp.h>
+#include <gkyl_util.h>
+
+static double
+table_func(double log_temp, double log_den)
+{
+  return -14.0 + 0.7*log_temp - 0.2*log_den + 0.05*log_temp*log_den;
+}
+
+static struct gkyl_rate_table*
+mk_table(const char *name)
+{
+  int nt = 9, nn = 6;
+  double log_rate[nt*nn];
+  for (int i=0; i<nt; ++i)
+    for (int j=0; j<nn; ++j)
+      log_rate[i*nn+j] = table_func(-1.0+0.5*i, 16.0+1.0*j);
+
+  struct gkyl_rate_table_inp inp = {
+    .num_temp = nt,
+    .num_den = nn,
+    .log_temp_min = -1.0,
+    .log_temp_max = 3.0,
+    .log_den_min = 16.0,
+    .log_den_max = 21.0,
+    .log_rate = log_rate,
+  };
+  return gkyl_rate_table_new(&inp, name);
+}
+
+void
+test_eval()
+{
+  struct gkyl_rate_table *tab = mk_table(0);
+
+  // Bilinear function is interpolated exactly.
+  for (int i=0; i<17; ++i) {
+    for (int j=0; j<11; ++j) {
+      double lt = -1.0+0.25*i-(i==16? 1e-12 : 0.0), ln = 16.0+0.5*j;
+      TEST_CHECK( gkyl_compare(table_func(lt, ln), gkyl_rate_table_eval_log(tab, lt, ln), 1e-12) );
+    }
+  }
+  // Values outside the table are clamped.
+  TEST_CHECK( gkyl_compare(table_func(3.0, 16.0), gkyl_rate_table_eval_log(tab, 5.0, 10.0), 1e-12) );
+  TEST_CHECK( gkyl_compare(table_func(-1.0, 21.0), gkyl_rate_table_eval_log(tab, -3.0, 22.0), 1e-12) );
+
+  // DG representation agrees with the interpolation.
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &tab->range);
+  while (gkyl_range_iter_next(&iter)) {
+    double xc[2];
+    gkyl_rect_grid_cell_center(&tab->grid, iter.idx, xc);
+    const double *m = gkyl_array_cfetch(tab->modal, gkyl_range_idx(&tab->range_ext, iter.idx));
+    double z[2] = { 0.3, -0.6 };
+    double lt = xc[0]+0.5*tab->grid.dx[0]*z[0], ln = xc[1]+0.5*tab->grid.dx[1]*z[1];
+    TEST_CHECK( gkyl_compare(gkyl_rate_table_eval_log(tab, lt, ln), tab->basis.eval_expand(z, m), 1e-12) );
+  }
+
+  gkyl_rate_table_release(tab);
+}
+
+static double
+table_func_cubic(double log_temp, double log_den)
+{
+  return table_func(log_temp, log_den) + 0.02*log_temp*log_temp - 0.01*log_den*log_den;
+}
+
+void
+test_eval_bicubic()
+{
+  int nt = 9, nn = 6;
+  double log_rate[nt*nn];
+  for (int i=0; i<nt; ++i)
+    for (int j=0; j<nn; ++j)
+      log_rate[i*nn+j] = table_func_cubic(-1.0+0.5*i, 16.0+1.0*j);
+  struct gkyl_rate_table *tab = gkyl_rate_table_new(&(struct gkyl_rate_table_inp) {
+      .num_temp = nt, .num_den = nn,
+      .log_temp_min = -1.0, .log_temp_max = 3.0,
+      .log_den_min = 16.0, .log_den_max = 21.0,
+      .log_rate = log_rate,
+    }, 0
+  );
+
+  // Nodes are interpolated exactly, and a quadratic function is too
+  // away from the edges.
+  for (int i=0; i<nt; ++i)
+    for (int j=0; j<nn; ++j)
+      TEST_CHECK( gkyl_compare(log_rate[i*nn+j], gkyl_rate_table_eval_log_bicubic(tab, -1.0+0.5*i, 16.0+1.0*j), 1e-12) );
+  for (int i=0; i<9; ++i) {
+    for (int j=0; j<7; ++j) {
+      double lt = -0.5+0.3*i, ln = 17.0+0.45*j;
+      TEST_CHECK( gkyl_compare(table_func_cubic(lt, ln), gkyl_rate_table_eval_log_bicubic(tab, lt, ln), 1e-12) );
+    }
+  }
+  // Edge nodes are extrapolated linearly, so a bilinear function is
+  // interpolated exactly everywhere.
+  struct gkyl_rate_table *tab_lin = mk_table(0);
+  for (int i=0; i<17; ++i) {
+    for (int j=0; j<11; ++j) {
+      double lt = -1.0+0.25*i, ln = 16.0+0.5*j;
+      TEST_CHECK( gkyl_compare(table_func(lt, ln), gkyl_rate_table_eval_log_bicubic(tab_lin, lt, ln), 1e-12) );
+    }
+  }
+
+  gkyl_rate_table_release(tab_lin);
+  gkyl_rate_table_release(tab);
+}
+
+void
+test_eval_array()
+{
+  struct gkyl_rate_table *tab = mk_table(0);
+
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, 2, (double[]) { 0.0, 0.0 }, (double[]) { 1.0, 1.0 }, (int[]) { 5, 4 });
+  struct gkyl_range range, range_ext;
+  gkyl_create_grid_ranges(&grid, (int[]) { 1, 1 }, &range_ext, &range);
+
+  int nc = 3;
+  struct gkyl_array *log_temp = gkyl_array_new(GKYL_DOUBLE, nc, range_ext.volume);
+  struct gkyl_array *log_den = gkyl_array_new(GKYL_DOUBLE, nc, range_ext.volume);
+  struct gkyl_array *log_rate = gkyl_array_new(GKYL_DOUBLE, nc, range_ext.volume);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&range, iter.idx);
+    double *lt = gkyl_array_fetch(log_temp, loc), *ln = gkyl_array_fetch(log_den, loc);
+    for (int k=0; k<nc; ++k) {
+      lt[k] = -1.5 + 0.9*iter.idx[0] + 0.1*k;
+      ln[k] = 15.5 + 1.4*iter.idx[1] - 0.2*k;
+    }
+  }
+
+  for (int interp=GKYL_RATE_TABLE_BILINEAR; interp<=GKYL_RATE_TABLE_BICUBIC; ++interp) {
+    gkyl_rate_table_eval_log_array(tab, interp, &range, log_temp, log_den, log_rate);
+
+    gkyl_range_iter_init(&iter, &range);
+    while (gkyl_range_iter_next(&iter)) {
+      long loc = gkyl_range_idx(&range, iter.idx);
+      const double *lt = gkyl_array_cfetch(log_temp, loc), *ln = gkyl_array_cfetch(log_den, loc);
+      const double *lr = gkyl_array_cfetch(log_rate, loc);
+      for (int k=0; k<nc; ++k) {
+        double ref = interp == GKYL_RATE_TABLE_BICUBIC ?
+          gkyl_rate_table_eval_log_bicubic(tab, lt[k], ln[k]) : gkyl_rate_table_eval_log(tab, lt[k], ln[k]);
+        TEST_CHECK( lr[k] == ref );
+      }
+    }
+  }
+
+  gkyl_array_release(log_temp);
+  gkyl_array_release(log_den);
+  gkyl_array_release(log_rate);
+  gkyl_rate_table_release(tab);
+}
+
+void
+test_cache()
+{
+  TEST_CHECK( gkyl_rate_table_cache_find("tab_a") == 0 );
+
+  struct gkyl_rate_table *tab_a = mk_table("tab_a");
+  struct gkyl_rate_table *tab_b = mk_table("tab_b");
+
+  struct gkyl_rate_table *tab_a2 = gkyl_rate_table_cache_find("tab_a");
+  TEST_CHECK( tab_a2 == tab_a );
+  TEST_CHECK( gkyl_rate_table_cache_find("tab_c") == 0 );
+
+  // Table stays in the cache while it has users.
+  gkyl_rate_table_release(tab_a);
+  struct gkyl_rate_table *tab_a3 = gkyl_rate_table_cache_find("tab_a");
+  TEST_CHECK( tab_a3 == tab_a2 );
+  gkyl_rate_table_release(tab_a3);
+  gkyl_rate_table_release(tab_a2);
+  TEST_CHECK( gkyl_rate_table_cache_find("tab_a") == 0 );
+
+  struct gkyl_rate_table *tab_b2 = gkyl_rate_table_cache_find("tab_b");
+  TEST_CHECK( tab_b2 == tab_b );
+  gkyl_rate_table_release(tab_b2);
+  gkyl_rate_table_release(tab_b);
+  TEST_CHECK( gkyl_rate_table_cache_find("tab_b") == 0 );
+}
+
+TEST_LIST = {
+  { "test_eval", test_eval },
+  { "test_eval_bicubic", test_eval_bicubic },
+  { "test_eval_array", test_eval_array },
+  { "test_cache", test_cache },
+  { NULL, NULL },
+};
@@ -581,6 +581,186 @@ test_rect_decomp_2d_2v(void)
   gkyl_rect_decomp_release(ext_decomp);
 }
 
+static double
+range_cost(const struct gkyl_range *rng, const struct gkyl_range *range, const struct gkyl_array *cost)
+{
+  struct gkyl_range sub;
+  gkyl_sub_range_init(&sub, range, rng->lower, rng->upper);
+  double tot = 0.0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &sub);
+  while (gkyl_range_iter_next(&iter))
+    tot += ((const double*) gkyl_array_cfetch(cost, gkyl_range_idx(&sub, iter.idx)))[0];
+  return tot;
+}
+
+static void
+test_rect_decomp_cost_1d(void)
+{
+  struct gkyl_range range;
+  gkyl_range_init(&range, 1, (int[]) { 1 }, (int[]) { 100 });
+
+  // Cells near the lower boundary are 10 times as expensive.
+  struct gkyl_array *cost = gkyl_array_new(GKYL_DOUBLE, 1, range.volume);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  while (gkyl_range_iter_next(&iter)) {
+    double *c = gkyl_array_fetch(cost, gkyl_range_idx(&range, iter.idx));
+    c[0] = iter.idx[0] <= 10 ? 10.0 : 1.0;
+  }
+
+  int cuts[] = { 4 };
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts_and_cost(1, cuts, &range, cost);
+
+  TEST_CHECK( decomp->ndecomp == 4 );
+  TEST_CHECK( gkyl_rect_decomp_check_covering(decomp) );
+
+  // Ranges are ordered and cost at most one expensive cell more than
+  // the average.
+  for (int i=0; i<decomp->ndecomp; ++i) {
+    if (i > 0)
+      TEST_CHECK( decomp->ranges[i].lower[0] == decomp->ranges[i-1].upper[0]+1 );
+    TEST_CHECK( range_cost(&decomp->ranges[i], &range, cost) <= 190.0/4 + 10.0 );
+  }
+  TEST_CHECK( decomp->ranges[0].upper[0] < 10 );
+
+  gkyl_array_release(cost);
+  gkyl_rect_decomp_release(decomp);
+}
+
+static void
+test_rect_decomp_cost_2d(void)
+{
+  struct gkyl_range range;
+  gkyl_range_init(&range, 2, (int[]) { 1, 1 }, (int[]) { 60, 40 });
+
+  // Cost is uniform but for a skin layer at the upper x boundary.
+  struct gkyl_array *cost = gkyl_array_new(GKYL_DOUBLE, 1, range.volume);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  while (gkyl_range_iter_next(&iter)) {
+    double *c = gkyl_array_fetch(cost, gkyl_range_idx(&range, iter.idx));
+    c[0] = iter.idx[0] == 60 ? 21.0 : 1.0;
+  }
+
+  int cuts[] = { 2, 3 };
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts_and_cost(2, cuts, &range, cost);
+
+  TEST_CHECK( decomp->ndecomp == 6 );
+  TEST_CHECK( gkyl_rect_decomp_check_covering(decomp) );
+
+  double avg = range_cost(&range, &range, cost)/decomp->ndecomp;
+  for (int i=0; i<decomp->ndecomp; ++i) {
+    TEST_CHECK( fabs(range_cost(&decomp->ranges[i], &range, cost)/avg-1.0) < 0.1 );
+    TEST_MSG( "range %d: cost %g, average %g", i, range_cost(&decomp->ranges[i], &range, cost), avg );
+  }
+  // Range 0 has cut index (0,0) and range 5 cut index (1,2).
+  TEST_CHECK( decomp->ranges[0].lower[0] == 1 && decomp->ranges[0].lower[1] == 1 );
+  TEST_CHECK( decomp->ranges[5].upper[0] == 60 && decomp->ranges[5].upper[1] == 40 );
+  // Upper x sub-domains are narrower.
+  TEST_CHECK( gkyl_range_shape(&decomp->ranges[5], 0) < gkyl_range_shape(&decomp->ranges[0], 0) );
+
+  gkyl_array_release(cost);
+  gkyl_rect_decomp_release(decomp);
+}
+
+static void
+test_rect_decomp_from_decomp(void)
+{
+  // A cost-weighted 2D decomposition, cut in both directions.
+  struct gkyl_range range;
+  gkyl_range_init(&range, 2, (int[]) { 1, 1 }, (int[]) { 60, 40 });
+  struct gkyl_array *cost = gkyl_array_new(GKYL_DOUBLE, 1, range.volume);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  while (gkyl_range_iter_next(&iter)) {
+    double *c = gkyl_array_fetch(cost, gkyl_range_idx(&range, iter.idx));
+    c[0] = iter.idx[0] > 50 || iter.idx[1] > 36 ? 9.0 : 1.0;
+  }
+  int cuts[] = { 3, 2 };
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts_and_cost(2, cuts, &range, cost);
+  TEST_CHECK( decomp->ranges[0].upper[0] != 20 ); // Not uniform.
+
+  // Same partitioning on a grid with half the cells, and an extra
+  // undecomposed (e.g. velocity) direction.
+  struct gkyl_range crange;
+  gkyl_range_init(&crange, 3, (int[]) { 1, 1, 1 }, (int[]) { 30, 20, 8 });
+  struct gkyl_rect_decomp *cdecomp = gkyl_rect_decomp_new_from_decomp(decomp, (int[]) { 0, 1, -1 }, &crange);
+
+  TEST_CHECK( cdecomp->ndim == 3 );
+  TEST_CHECK( cdecomp->ndecomp == decomp->ndecomp );
+  TEST_CHECK( gkyl_rect_decomp_check_covering(cdecomp) );
+  for (int n=0; n<decomp->ndecomp; ++n) {
+    for (int d=0; d<2; ++d) {
+      TEST_CHECK( 2*cdecomp->ranges[n].lower[d]-1 == decomp->ranges[n].lower[d]
+        || 2*cdecomp->ranges[n].lower[d] == decomp->ranges[n].lower[d] );
+      TEST_CHECK( 2*cdecomp->ranges[n].upper[d] == decomp->ranges[n].upper[d]
+        || 2*cdecomp->ranges[n].upper[d]+1 == decomp->ranges[n].upper[d] );
+    }
+    TEST_CHECK( cdecomp->ranges[n].lower[2] == 1 && cdecomp->ranges[n].upper[2] == 8 );
+  }
+
+  // Drop the first direction of the decomposition, which is not cut, to
+  // follow it in a lower dimensional range (with the same cells, so
+  // ranges are unchanged in the kept direction).
+  int cuts_1[] = { 1, 4 };
+  struct gkyl_rect_decomp *decomp_1 = gkyl_rect_decomp_new_from_cuts_and_cost(2, cuts_1, &range, cost);
+  struct gkyl_range range_1;
+  gkyl_range_init(&range_1, 2, (int[]) { 1, 1 }, (int[]) { 40, 8 });
+  struct gkyl_rect_decomp *rdecomp = gkyl_rect_decomp_new_from_decomp(decomp_1, (int[]) { 1, -1 }, &range_1);
+  TEST_CHECK( gkyl_rect_decomp_check_covering(rdecomp) );
+  for (int n=0; n<decomp_1->ndecomp; ++n) {
+    TEST_CHECK( rdecomp->ranges[n].lower[0] == decomp_1->ranges[n].lower[1] );
+    TEST_CHECK( rdecomp->ranges[n].upper[0] == decomp_1->ranges[n].upper[1] );
+  }
+
+  gkyl_rect_decomp_release(rdecomp);
+  gkyl_rect_decomp_release(decomp_1);
+  gkyl_rect_decomp_release(cdecomp);
+  gkyl_rect_decomp_release(decomp);
+  gkyl_array_release(cost);
+}
+
+static void
+test_rect_decomp_from_ranges(void)
+{
+  // Cost-weighted in y only, so the x cuts are uniform.
+  struct gkyl_range range;
+  gkyl_range_init(&range, 2, (int[]) { 1, 1 }, (int[]) { 20, 40 });
+  struct gkyl_array *cost = gkyl_array_new(GKYL_DOUBLE, 1, range.volume);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &range);
+  while (gkyl_range_iter_next(&iter)) {
+    double *c = gkyl_array_fetch(cost, gkyl_range_idx(&range, iter.idx));
+    c[0] = iter.idx[1] > 30 ? 9.0 : 1.0;
+  }
+  int cuts[] = { 2, 4 };
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts_and_cost(2, cuts, &range, cost);
+
+  // The y surface seen by the ranks sharing the y extent of range 1,
+  // with y dropped.
+  int nsurf = 0;
+  struct gkyl_range surf_ranges[decomp->ndecomp];
+  for (int i=0; i<decomp->ndecomp; ++i) {
+    if (decomp->ranges[i].lower[1] == decomp->ranges[1].lower[1])
+      gkyl_range_init(&surf_ranges[nsurf++], 1, (int[]) { decomp->ranges[i].lower[0] },
+        (int[]) { decomp->ranges[i].upper[0] });
+  }
+  TEST_CHECK( nsurf == 2 );
+
+  struct gkyl_range surf;
+  gkyl_range_init(&surf, 1, (int[]) { 1 }, (int[]) { 20 });
+  struct gkyl_rect_decomp *sdecomp = gkyl_rect_decomp_new_from_ranges(nsurf, surf_ranges, &surf);
+  TEST_CHECK( sdecomp->ndim == 1 );
+  TEST_CHECK( sdecomp->ndecomp == 2 );
+  TEST_CHECK( gkyl_rect_decomp_check_covering(sdecomp) );
+  TEST_CHECK( sdecomp->ranges[0].upper[0] == 10 && sdecomp->ranges[1].lower[0] == 11 );
+
+  gkyl_rect_decomp_release(sdecomp);
+  gkyl_rect_decomp_release(decomp);
+  gkyl_array_release(cost);
+}
+
 static void
 test_rect_decomp_from_cuts_and_cells(void)
 {
@@ -623,6 +803,11 @@ TEST_LIST = {
   { "rect_decomp_2d_2v", test_rect_decomp_2d_2v },
 
   { "rect_decomp_from_cuts_and_cells", test_rect_decomp_from_cuts_and_cells },
+
+  { "rect_decomp_cost_1d", test_rect_decomp_cost_1d },
+  { "rect_decomp_cost_2d", test_rect_decomp_cost_2d },
+  { "rect_decomp_from_decomp", test_rect_decomp_from_decomp },
+  { "rect_decomp_from_ranges", test_rect_decomp_from_ranges },
   
   { NULL, NULL },
 };
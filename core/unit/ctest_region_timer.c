@@ -0,0 +1,162 @@
+#include <acutest.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <gkyl_null_comm.h>
+#include <gkyl_region_timer.h>
+
+// Do some work to measure.
+static double
+work(int n)
+{
+  volatile double s = 0.0;
+  for (int i=0; i<n; ++i)
+    s += 1.0/(i+1.0);
+  return s;
+}
+
+void
+test_regions()
+{
+  gkyl_region_timer *rt = gkyl_region_timer_new(true);
+
+  for (int s=0; s<3; ++s) {
+    gkyl_region_timer_begin(rt, "time_loop");
+
+    gkyl_region_timer_begin(rt, "rhs");
+    work(100000);
+    gkyl_region_timer_end(rt);
+
+    gkyl_region_timer_begin(rt, "field");
+    usleep(2000);
+    gkyl_region_timer_begin(rt, "solve");
+    usleep(1000);
+    gkyl_region_timer_end(rt);
+    gkyl_region_timer_end(rt);
+
+    gkyl_region_timer_end(rt);
+  }
+  gkyl_region_timer_begin(rt, "field");
+  usleep(1000);
+  gkyl_region_timer_end(rt);
+
+  struct gkyl_region_timer_stat tl = gkyl_region_timer_get(rt, "time_loop");
+  struct gkyl_region_timer_stat rhs = gkyl_region_timer_get(rt, "time_loop/rhs");
+  struct gkyl_region_timer_stat fld = gkyl_region_timer_get(rt, "time_loop/field");
+  struct gkyl_region_timer_stat slv = gkyl_region_timer_get(rt, "time_loop/field/solve");
+  struct gkyl_region_timer_stat fld0 = gkyl_region_timer_get(rt, "field");
+
+  TEST_CHECK( tl.ncalls == 3 );
+  TEST_CHECK( rhs.ncalls == 3 );
+  TEST_CHECK( slv.ncalls == 3 );
+  TEST_CHECK( fld0.ncalls == 1 );
+  TEST_CHECK( slv.tm >= 3e-3 );
+  TEST_CHECK( fld.tm >= 9e-3 );
+  TEST_CHECK( fld.self_tm >= 6e-3 );
+  TEST_CHECK( fld.self_tm <= fld.tm - slv.tm + 1e-12 );
+  TEST_CHECK( tl.tm >= rhs.tm + fld.tm );
+  TEST_CHECK( slv.self_tm == slv.tm );
+
+  // Unknown regions.
+  TEST_CHECK( gkyl_region_timer_get(rt, "rhs").ncalls == 0 );
+  TEST_CHECK( gkyl_region_timer_get(rt, "time_loop/solve").ncalls == 0 );
+  TEST_CHECK( gkyl_region_timer_get(rt, "time_loop/rhs/x").tm == 0.0 );
+
+  // Sum over regions of the same name.
+  TEST_CHECK( gkyl_region_timer_sum(rt, "field") == fld.tm + fld0.tm );
+
+  if (gkyl_region_timer_has_counters(rt)) {
+    TEST_CHECK( rhs.counters[GKYL_RTIMER_INSTRUCTIONS] > 100000 );
+    TEST_CHECK( tl.counters[GKYL_RTIMER_CYCLES] >= rhs.counters[GKYL_RTIMER_CYCLES] );
+  }
+  else {
+    TEST_CHECK( rhs.counters[GKYL_RTIMER_INSTRUCTIONS] == 0 );
+  }
+
+  gkyl_region_timer_release(rt);
+}
+
+void
+test_nested_same_name()
+{
+  gkyl_region_timer *rt = gkyl_region_timer_new(false);
+  TEST_CHECK( !gkyl_region_timer_has_counters(rt) );
+
+  // Enough regions to grow storage.
+  char name[16];
+  for (int i=0; i<40; ++i) {
+    snprintf(name, sizeof name, "r%d", i);
+    gkyl_region_timer_begin(rt, name);
+    gkyl_region_timer_end(rt);
+  }
+
+  gkyl_region_timer_begin(rt, "bc");
+  usleep(1000);
+  gkyl_region_timer_begin(rt, "bc");
+  usleep(1000);
+  gkyl_region_timer_end(rt);
+  gkyl_region_timer_end(rt);
+
+  struct gkyl_region_timer_stat outer = gkyl_region_timer_get(rt, "bc");
+  TEST_CHECK( gkyl_region_timer_get(rt, "bc/bc").ncalls == 1 );
+  TEST_CHECK( gkyl_region_timer_sum(rt, "bc") == outer.tm );
+  TEST_CHECK( gkyl_region_timer_get(rt, "r39").ncalls == 1 );
+
+  gkyl_region_timer_release(rt);
+}
+
+void
+test_write()
+{
+  struct gkyl_comm *comm = gkyl_null_comm_inew( &(struct gkyl_null_comm_inp) { } );
+  gkyl_region_timer *rt = gkyl_region_timer_new(false);
+
+  gkyl_region_timer_begin(rt, "time_loop");
+  gkyl_region_timer_begin(rt, "field");
+  usleep(2000);
+  gkyl_region_timer_end(rt);
+  usleep(1000);
+  gkyl_region_timer_end(rt);
+
+  char buff[4096];
+
+  FILE *fp = tmpfile();
+  gkyl_region_timer_write_json(rt, comm, fp);
+  rewind(fp);
+  size_t sz = fread(buff, 1, sizeof buff - 1, fp);
+  buff[sz] = '\0';
+  fclose(fp);
+  TEST_CHECK( strstr(buff, "\"consistent\" : true") != 0 );
+  TEST_CHECK( strstr(buff, "\"num_ranks\" : 1") != 0 );
+  TEST_CHECK( strstr(buff, "\"path\" : \"time_loop/field\"") != 0 );
+  TEST_CHECK( strstr(buff, "\"self_tm\"") != 0 );
+
+  fp = tmpfile();
+  gkyl_region_timer_write_folded(rt, comm, fp);
+  rewind(fp);
+  sz = fread(buff, 1, sizeof buff - 1, fp);
+  buff[sz] = '\0';
+  fclose(fp);
+  long us_loop = 0, us_field = 0;
+  char *l = strstr(buff, "time_loop ");
+  char *f = strstr(buff, "time_loop;field ");
+  TEST_CHECK( l && f );
+  if (l && f) {
+    sscanf(l, "time_loop %ld", &us_loop);
+    sscanf(f, "time_loop;field %ld", &us_field);
+  }
+  TEST_CHECK( us_field >= 2000 );
+  TEST_CHECK( us_loop >= 1000 );
+  TEST_CHECK( us_loop < us_field + 1000 + 5000 );
+
+  gkyl_region_timer_release(rt);
+  gkyl_comm_release(comm);
+}
+
+TEST_LIST = {
+  { "test_regions", test_regions },
+  { "test_nested_same_name", test_nested_same_name },
+  { "test_write", test_write },
+  { NULL, NULL },
+};
@@ -0,0 +1,151 @@
+#include <acutest.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_null_pool.h>
+#include <gkyl_task_graph.h>
+#include <gkyl_thread_pool.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+
+// Shared record of the order in which tasks finish.
+struct order_rec {
+  pthread_mutex_t lock;
+  int count;
+  int *finished; // finished[t] = position at which task t finished
+};
+
+struct task_ctx {
+  int id;
+  int work; // amount of busy work to do
+  struct order_rec *rec;
+  double sum; // result of busy work
+};
+
+static void
+task_func(void *ctx)
+{
+  struct task_ctx *tc = ctx;
+  double s = 0.0;
+  for (int i=0; i<tc->work; ++i)
+    s += 1.0/(1.0+i);
+  tc->sum = s;
+
+  pthread_mutex_lock(&tc->rec->lock);
+  tc->rec->finished[tc->id] = tc->rec->count++;
+  pthread_mutex_unlock(&tc->rec->lock);
+}
+
+// Build a random DAG with ntasks tasks, run it and check that every
+// task ran once, after all of its dependencies.
+static void
+test_random_dag(struct gkyl_job_pool *jp, int ntasks, int nruns)
+{
+  srand(ntasks);
+
+  struct order_rec rec = { .count = 0 };
+  pthread_mutex_init(&rec.lock, 0);
+  rec.finished = gkyl_malloc(sizeof(int[ntasks]));
+
+  struct task_ctx *ctx = gkyl_malloc(sizeof(struct task_ctx[ntasks]));
+  int *ndeps = gkyl_malloc(sizeof(int[ntasks]));
+  int (*deps)[4] = gkyl_malloc(sizeof(int[ntasks][4]));
+
+  gkyl_task_graph *tg = gkyl_task_graph_new();
+  for (int t=0; t<ntasks; ++t) {
+    // tasks of very unequal size, to exercise stealing
+    ctx[t] = (struct task_ctx) { .id = t, .work = (t % 7 == 0) ? 20000 : 100, .rec = &rec };
+    ndeps[t] = t == 0 ? 0 : rand() % 4;
+    for (int k=0; k<ndeps[t]; ++k)
+      deps[t][k] = t > 0 ? rand() % t : -1;
+    int id = gkyl_task_graph_add(tg, task_func, &ctx[t], ndeps[t], deps[t]);
+    TEST_CHECK( id == t );
+  }
+  TEST_CHECK( gkyl_task_graph_num_tasks(tg) == ntasks );
+
+  for (int r=0; r<nruns; ++r) {
+    rec.count = 0;
+    for (int t=0; t<ntasks; ++t) rec.finished[t] = -1;
+
+    gkyl_task_graph_run(tg, jp);
+
+    TEST_CHECK( rec.count == ntasks );
+    for (int t=0; t<ntasks; ++t) {
+      TEST_CHECK( rec.finished[t] >= 0 );
+      for (int k=0; k<ndeps[t]; ++k)
+        TEST_CHECK( rec.finished[deps[t][k]] < rec.finished[t] );
+    }
+  }
+
+  gkyl_task_graph_release(tg);
+  gkyl_free(ctx);
+  gkyl_free(ndeps);
+  gkyl_free(deps);
+  gkyl_free(rec.finished);
+  pthread_mutex_destroy(&rec.lock);
+}
+
+static void
+test_chain(void)
+{
+  struct gkyl_job_pool *jp = gkyl_thread_pool_new(4);
+
+  int ntasks = 50;
+  struct order_rec rec = { .count = 0 };
+  pthread_mutex_init(&rec.lock, 0);
+  rec.finished = gkyl_malloc(sizeof(int[ntasks]));
+  struct task_ctx ctx[ntasks];
+
+  // each task depends on the previous one, so the order is fixed
+  gkyl_task_graph *tg = gkyl_task_graph_new();
+  for (int t=0; t<ntasks; ++t) {
+    ctx[t] = (struct task_ctx) { .id = t, .work = 10, .rec = &rec };
+    gkyl_task_graph_add(tg, task_func, &ctx[t], 1, (int[]) { t-1 });
+  }
+  gkyl_task_graph_run(tg, jp);
+
+  for (int t=0; t<ntasks; ++t)
+    TEST_CHECK( rec.finished[t] == t );
+
+  // clearing the graph allows it to be reused
+  gkyl_task_graph_clear(tg);
+  TEST_CHECK( gkyl_task_graph_num_tasks(tg) == 0 );
+  gkyl_task_graph_run(tg, jp);
+
+  gkyl_task_graph_release(tg);
+  gkyl_free(rec.finished);
+  pthread_mutex_destroy(&rec.lock);
+  gkyl_job_pool_release(jp);
+}
+
+static void
+test_dag_null_pool(void)
+{
+  struct gkyl_job_pool *jp = gkyl_null_pool_new(4);
+  test_random_dag(jp, 200, 2);
+  gkyl_job_pool_release(jp);
+}
+
+static void
+test_dag_thread_pool(void)
+{
+  struct gkyl_job_pool *jp = gkyl_thread_pool_new(4);
+  test_random_dag(jp, 500, 5);
+  gkyl_job_pool_release(jp);
+}
+
+static void
+test_dag_pinned_pool(void)
+{
+  struct gkyl_job_pool *jp = gkyl_thread_pool_pinned_new(3, 0);
+  test_random_dag(jp, 300, 3);
+  gkyl_job_pool_release(jp);
+}
+
+TEST_LIST = {
+  { "test_chain", test_chain },
+  { "test_dag_null_pool", test_dag_null_pool },
+  { "test_dag_thread_pool", test_dag_thread_pool },
+  { "test_dag_pinned_pool", test_dag_pinned_pool },
+  { NULL, NULL },
+};
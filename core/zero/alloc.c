@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -188,6 +189,382 @@ gkyl_mem_buff_release(gkyl_mem_buff mem)
   gkyl_free(mem);
 }
 
+// Accounting of array memory. Entries live in a fixed table, and the
+// stack of active subsystems holds indices into it. Entries are never
+// removed, as live arrays hold the index of the entry they were
+// accounted to. The table and totals are shared and guarded by a lock;
+// each thread has its own stack, so pushes on one thread don't tag
+// arrays allocated on another.
+enum { MEM_ACCOUNT_MAX_ENTRIES = 512, MEM_ACCOUNT_MAX_DEPTH = 16, MEM_ACCOUNT_NAME_SZ = 128 };
+
+static struct {
+  char name[MEM_ACCOUNT_NAME_SZ];
+  size_t curr_bytes, peak_bytes;
+  long num_arrays;
+} mem_account_entries[MEM_ACCOUNT_MAX_ENTRIES];
+static int mem_account_num_entries = 0;
+static _Thread_local int mem_account_stack[MEM_ACCOUNT_MAX_DEPTH];
+static _Thread_local int mem_account_depth = 0;
+static struct gkyl_mem_account_stat mem_account_totals = { };
+static pthread_mutex_t mem_account_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void
+gkyl_mem_account_push(const char *name)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  char full_name[MEM_ACCOUNT_NAME_SZ];
+  int depth = GKYL_MIN2(mem_account_depth, MEM_ACCOUNT_MAX_DEPTH);
+  int parent = depth > 0 ? mem_account_stack[depth-1] : -1;
+  if (parent >= 0)
+    snprintf(full_name, sizeof full_name, "%s/%s", mem_account_entries[parent].name, name);
+  else
+    snprintf(full_name, sizeof full_name, "%s", name);
+
+  int idx = -1;
+  for (int i=0; i<mem_account_num_entries; ++i)
+    if (strcmp(mem_account_entries[i].name, full_name) == 0) {
+      idx = i;
+      break;
+    }
+  if (idx < 0 && mem_account_num_entries < MEM_ACCOUNT_MAX_ENTRIES) {
+    idx = mem_account_num_entries++;
+    strcpy(mem_account_entries[idx].name, full_name);
+    mem_account_entries[idx].curr_bytes = 0;
+    mem_account_entries[idx].peak_bytes = 0;
+    mem_account_entries[idx].num_arrays = 0;
+  }
+  // When the table or stack is full, allocations go to the enclosing
+  // subsystem.
+  if (idx < 0)
+    idx = parent;
+  if (mem_account_depth < MEM_ACCOUNT_MAX_DEPTH)
+    mem_account_stack[mem_account_depth] = idx; // -1 if not accounted
+  mem_account_depth += 1;
+  pthread_mutex_unlock(&mem_account_lock);
+}
+
+void
+gkyl_mem_account_pop(void)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  assert(mem_account_depth > 0);
+  mem_account_depth -= 1;
+  pthread_mutex_unlock(&mem_account_lock);
+}
+
+int
+gkyl_mem_account_alloc(bool on_gpu, size_t nbytes)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  int d = on_gpu ? 1 : 0;
+  mem_account_totals.curr_bytes[d] += nbytes;
+  if (mem_account_totals.curr_bytes[d] > mem_account_totals.peak_bytes[d])
+    mem_account_totals.peak_bytes[d] = mem_account_totals.curr_bytes[d];
+
+  int depth = GKYL_MIN2(mem_account_depth, MEM_ACCOUNT_MAX_DEPTH);
+  int idx = depth > 0 ? mem_account_stack[depth-1] : -1;
+  if (idx >= 0) {
+    mem_account_entries[idx].curr_bytes += nbytes;
+    mem_account_entries[idx].peak_bytes = GKYL_MAX2(mem_account_entries[idx].peak_bytes,
+      mem_account_entries[idx].curr_bytes);
+    mem_account_entries[idx].num_arrays += 1;
+  }
+  pthread_mutex_unlock(&mem_account_lock);
+  return idx;
+}
+
+void
+gkyl_mem_account_free(bool on_gpu, int entry, size_t nbytes)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  mem_account_totals.curr_bytes[on_gpu ? 1 : 0] -= nbytes;
+  if (entry >= 0) {
+    mem_account_entries[entry].curr_bytes -= nbytes;
+    mem_account_entries[entry].num_arrays -= 1;
+  }
+  pthread_mutex_unlock(&mem_account_lock);
+}
+
+struct gkyl_mem_account_stat
+gkyl_mem_account_stat(void)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  struct gkyl_mem_account_stat stat = mem_account_totals;
+  pthread_mutex_unlock(&mem_account_lock);
+  return stat;
+}
+
+int
+gkyl_mem_account_num_entries(void)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  int nent = mem_account_num_entries;
+  pthread_mutex_unlock(&mem_account_lock);
+  return nent;
+}
+
+struct gkyl_mem_account_entry
+gkyl_mem_account_entry(int i)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  struct gkyl_mem_account_entry ent = {
+    .name = mem_account_entries[i].name,
+    .curr_bytes = mem_account_entries[i].curr_bytes,
+    .peak_bytes = mem_account_entries[i].peak_bytes,
+    .num_arrays = mem_account_entries[i].num_arrays,
+  };
+  pthread_mutex_unlock(&mem_account_lock);
+  return ent;
+}
+
+void
+gkyl_mem_account_reset(void)
+{
+  pthread_mutex_lock(&mem_account_lock);
+  mem_account_depth = 0;
+  for (int i=0; i<mem_account_num_entries; ++i)
+    mem_account_entries[i].peak_bytes = mem_account_entries[i].curr_bytes;
+  for (int d=0; d<2; ++d)
+    mem_account_totals.peak_bytes[d] = mem_account_totals.curr_bytes[d];
+  pthread_mutex_unlock(&mem_account_lock);
+}
+
+// Memory pool. Each block has a header, padded to keep the data
+// 64-byte aligned, that links it into either the list of blocks handed
+// out (in allocation order) or the free list of its size class.
+struct mem_pool_block {
+  struct gkyl_mem_pool *pool; // pool block belongs to
+  struct mem_pool_block *prev, *next; // neighbours in list
+  size_t size; // usable size of block
+  int sclass; // size class (-1 if too large to cache)
+  int arena; // arena block was allocated in
+};
+
+static const size_t MEM_POOL_ALIGN = 64;
+static const size_t MEM_POOL_HDR_SZ = 64;
+
+// Size classes are 64 bytes and then four classes per power of two:
+// (5/4, 6/4, 7/4, 8/4) x 2^k for k = 6, 7, ...
+enum { MEM_POOL_MAX_POW2 = 36, MEM_POOL_NCLASS = 4*(MEM_POOL_MAX_POW2-6)+1 };
+
+struct gkyl_mem_pool {
+  char *name; // name of subsystem owning pool
+  pthread_mutex_t lock;
+  int arena; // current arena depth
+  struct mem_pool_block *live_head, *live_tail; // blocks handed out
+  struct mem_pool_block *free_list[MEM_POOL_NCLASS]; // free blocks by class
+  struct gkyl_mem_pool_stat stat;
+  struct gkyl_mem_pool *next_pool; // next pool in process-wide list
+};
+
+static struct gkyl_mem_pool *mem_pool_list = 0;
+static pthread_mutex_t mem_pool_list_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Size class of a request and the size of blocks in that class.
+static int
+mem_pool_size_class(size_t size, size_t *csize)
+{
+  if (size <= 64) {
+    *csize = 64;
+    return 0;
+  }
+  int k = 0; // 2^k < size <= 2^(k+1)
+  while (((size_t) 1 << (k+1)) < size) k += 1;
+  if (k >= MEM_POOL_MAX_POW2) {
+    *csize = size;
+    return -1;
+  }
+  size_t chunk = (size_t) 1 << (k-2), nchunk = (size+chunk-1)/chunk; // 5 to 8
+  *csize = nchunk*chunk;
+  return 4*(k-6) + (nchunk-5) + 1;
+}
+
+static void
+mem_pool_unlink(struct gkyl_mem_pool *pool, struct mem_pool_block *blk)
+{
+  if (blk->prev) blk->prev->next = blk->next;
+  else pool->live_head = blk->next;
+  if (blk->next) blk->next->prev = blk->prev;
+  else pool->live_tail = blk->prev;
+}
+
+// Move block from the live list to its free list (pool must be locked).
+static void
+mem_pool_put(struct gkyl_mem_pool *pool, struct mem_pool_block *blk)
+{
+  mem_pool_unlink(pool, blk);
+  pool->stat.curr_bytes -= blk->size;
+  if (blk->sclass < 0) {
+    pool->stat.held_bytes -= blk->size;
+    gkyl_aligned_free(blk);
+  }
+  else {
+    blk->next = pool->free_list[blk->sclass];
+    pool->free_list[blk->sclass] = blk;
+  }
+}
+
+gkyl_mem_pool*
+gkyl_mem_pool_new(const char *name)
+{
+  struct gkyl_mem_pool *pool = gkyl_malloc(sizeof(*pool));
+  pool->name = gkyl_malloc(strlen(name)+1);
+  strcpy(pool->name, name);
+  pthread_mutex_init(&pool->lock, 0);
+  pool->arena = 0;
+  pool->live_head = pool->live_tail = 0;
+  for (int i=0; i<MEM_POOL_NCLASS; ++i)
+    pool->free_list[i] = 0;
+  pool->stat = (struct gkyl_mem_pool_stat) { };
+
+  pthread_mutex_lock(&mem_pool_list_lock);
+  pool->next_pool = mem_pool_list;
+  mem_pool_list = pool;
+  pthread_mutex_unlock(&mem_pool_list_lock);
+
+  return pool;
+}
+
+void*
+gkyl_mem_pool_alloc_(const char *file, int line, const char *func,
+  gkyl_mem_pool *pool, size_t size)
+{
+  size_t csize;
+  int sclass = mem_pool_size_class(size, &csize);
+
+  pthread_mutex_lock(&pool->lock);
+  struct mem_pool_block *blk = 0;
+  if (sclass >= 0 && pool->free_list[sclass]) {
+    blk = pool->free_list[sclass];
+    pool->free_list[sclass] = blk->next;
+    pool->stat.num_reuse += 1;
+  }
+  else {
+    blk = gkyl_aligned_alloc(MEM_POOL_ALIGN, MEM_POOL_HDR_SZ+csize);
+    blk->pool = pool;
+    blk->size = csize;
+    blk->sclass = sclass;
+    pool->stat.held_bytes += csize;
+  }
+  blk->arena = pool->arena;
+  blk->next = 0;
+  blk->prev = pool->live_tail;
+  if (pool->live_tail) pool->live_tail->next = blk;
+  else pool->live_head = blk;
+  pool->live_tail = blk;
+
+  pool->stat.num_alloc += 1;
+  pool->stat.curr_bytes += csize;
+  if (pool->stat.curr_bytes > pool->stat.peak_bytes)
+    pool->stat.peak_bytes = pool->stat.curr_bytes;
+  pthread_mutex_unlock(&pool->lock);
+
+  void *ptr = (char*) blk + MEM_POOL_HDR_SZ;
+  GKYL_MEMMSG("%p [%zu] 0.pool_alloc(%s): %s %s:%d\n", ptr, size, pool->name, file, func, line);
+  return ptr;
+}
+
+void
+gkyl_mem_pool_free_(const char *file, int line, const char *func, void *ptr)
+{
+  assert(ptr);
+  GKYL_MEMMSG("%p 1.pool_free: %s %s:%d\n", ptr, file, func, line);
+
+  struct mem_pool_block *blk = (struct mem_pool_block*) ((char*) ptr - MEM_POOL_HDR_SZ);
+  struct gkyl_mem_pool *pool = blk->pool;
+  pthread_mutex_lock(&pool->lock);
+  mem_pool_put(pool, blk);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+int
+gkyl_mem_pool_arena_begin(gkyl_mem_pool *pool)
+{
+  pthread_mutex_lock(&pool->lock);
+  int arena = ++pool->arena;
+  pthread_mutex_unlock(&pool->lock);
+  return arena;
+}
+
+void
+gkyl_mem_pool_arena_end(gkyl_mem_pool *pool, int arena)
+{
+  pthread_mutex_lock(&pool->lock);
+  assert(arena == pool->arena);
+  // Blocks are in allocation order, and all blocks from inner arenas
+  // are reclaimed before an outer arena continues allocating, so the
+  // blocks of this arena are at the tail of the list.
+  while (pool->live_tail && pool->live_tail->arena >= arena) {
+    struct mem_pool_block *blk = pool->live_tail;
+    GKYL_MEMMSG("%p 1.pool_free: %s %s:%d\n", (void*) ((char*) blk + MEM_POOL_HDR_SZ),
+      "arena_end", pool->name, arena);
+    mem_pool_put(pool, blk);
+  }
+  pool->arena = arena-1;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+void
+gkyl_mem_pool_trim(gkyl_mem_pool *pool)
+{
+  pthread_mutex_lock(&pool->lock);
+  for (int i=0; i<MEM_POOL_NCLASS; ++i) {
+    while (pool->free_list[i]) {
+      struct mem_pool_block *blk = pool->free_list[i];
+      pool->free_list[i] = blk->next;
+      pool->stat.held_bytes -= blk->size;
+      gkyl_aligned_free(blk);
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+}
+
+struct gkyl_mem_pool_stat
+gkyl_mem_pool_stat(gkyl_mem_pool *pool)
+{
+  pthread_mutex_lock(&pool->lock);
+  struct gkyl_mem_pool_stat stat = pool->stat;
+  pthread_mutex_unlock(&pool->lock);
+  return stat;
+}
+
+void
+gkyl_mem_pool_stat_write(FILE *fp)
+{
+  pthread_mutex_lock(&mem_pool_list_lock);
+  for (struct gkyl_mem_pool *pool = mem_pool_list; pool; pool = pool->next_pool) {
+    struct gkyl_mem_pool_stat stat = gkyl_mem_pool_stat(pool);
+    fprintf(fp, " mem_pool[%s] : { curr_bytes : %zu, peak_bytes : %zu, held_bytes : %zu, num_alloc : %ld, num_reuse : %ld },\n",
+      pool->name, stat.curr_bytes, stat.peak_bytes, stat.held_bytes, stat.num_alloc, stat.num_reuse);
+  }
+  pthread_mutex_unlock(&mem_pool_list_lock);
+}
+
+void
+gkyl_mem_pool_release(gkyl_mem_pool *pool)
+{
+  pthread_mutex_lock(&mem_pool_list_lock);
+  for (struct gkyl_mem_pool **prev = &mem_pool_list; *prev; prev = &(*prev)->next_pool) {
+    if (*prev == pool) {
+      *prev = pool->next_pool;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&mem_pool_list_lock);
+
+  while (pool->live_head) {
+    struct mem_pool_block *blk = pool->live_head;
+    pool->live_head = blk->next;
+    gkyl_aligned_free(blk);
+  }
+  pool->live_tail = 0;
+  gkyl_mem_pool_trim(pool);
+
+  pthread_mutex_destroy(&pool->lock);
+  gkyl_free(pool->name);
+  gkyl_free(pool);
+}
+
 // CUDA specific code
 
 #ifdef GKYL_HAVE_CUDA
@@ -46,6 +46,14 @@ static const size_t array_elem_size[] = {
   [GKYL_USER] = 1,
 };
 
+// Report allocation of array data to the memory accounting, keeping
+// the entry it was accounted to for the deallocation.
+static void
+array_account(struct gkyl_array *arr)
+{
+  arr->mem_entry = gkyl_mem_account_alloc(GKYL_IS_CU_ALLOC(arr->flags), arr->size*arr->esznc);
+}
+
 static void
 array_free(const struct gkyl_ref_count *ref)
 {
@@ -53,6 +61,7 @@ array_free(const struct gkyl_ref_count *ref)
 
   if (false == GKYL_IS_ALLOC_EXTERN(arr->flags)) {
     // only free if we allocated memory ourselves
+    gkyl_mem_account_free(GKYL_IS_CU_ALLOC(arr->flags), arr->mem_entry, arr->size*arr->esznc);
   
     if (GKYL_IS_CU_ALLOC(arr->flags)) {
 #ifdef GKYL_HAVE_CUDA 
@@ -66,7 +75,10 @@ array_free(const struct gkyl_ref_count *ref)
     }
     
   }
-  gkyl_free(arr);
+  if (GKYL_IS_ALLOC_POOL(arr->flags))
+    gkyl_mem_pool_free(arr); // data is in the same block
+  else
+    gkyl_free(arr);
 }
 
 // internal method to allocate array
@@ -104,8 +116,11 @@ array_new(enum gkyl_elem_type type, size_t ncomp, size_t size, bool is_alloc_ext
   arr->nblocks = 1;
 
   arr->on_dev = arr; // on_dev reference
+  arr->mem_entry = -1;
 
   if (!is_alloc_extern) {
+    array_account(arr);
+
     // Zero out array elements (not for user-defined type).
     if (type == GKYL_INT) {
       int *dat_p = arr->data;
@@ -130,6 +145,40 @@ gkyl_array_new(enum gkyl_elem_type type, size_t ncomp, size_t size)
   return array_new(type, ncomp, size, false, 0);
 }
 
+struct gkyl_array*
+gkyl_array_pool_new(struct gkyl_mem_pool *pool,
+  enum gkyl_elem_type type, size_t ncomp, size_t size)
+{
+  // Array object followed by its data, which starts on an
+  // ARRAY_ALIGN_BND boundary as pool blocks are 64-byte aligned.
+  size_t hdr_sz = (sizeof(struct gkyl_array)+ARRAY_ALIGN_BND-1)/ARRAY_ALIGN_BND*ARRAY_ALIGN_BND;
+  size_t data_sz = size*ncomp*array_elem_size[type];
+  struct gkyl_array *arr = gkyl_mem_pool_alloc(pool, hdr_sz+data_sz);
+
+  arr->type = type;
+  arr->elemsz = array_elem_size[type];
+  arr->ncomp = ncomp;
+  arr->size = size;
+  arr->flags = 0;
+  GKYL_SET_ALLOC_EXTERN(arr->flags); // data is freed with the array object
+  GKYL_SET_ALLOC_POOL(arr->flags);
+  GKYL_CLEAR_CU_ALLOC(arr->flags);
+  GKYL_SET_ALLOC_ALIGNED(arr->flags);
+
+  arr->esznc = arr->elemsz*arr->ncomp;
+  arr->data = (char*) arr + hdr_sz;
+  arr->ref_count = gkyl_ref_count_init(array_free);
+  arr->nthreads = 1;
+  arr->nblocks = 1;
+  arr->on_dev = arr;
+  arr->mem_entry = -1;
+
+  if (type != GKYL_USER)
+    memset(arr->data, 0, data_sz);
+
+  return arr;
+}
+
 struct gkyl_array*
 gkyl_array_new_from_buff(enum gkyl_elem_type type, size_t ncomp, size_t size, void *buff)
 {
@@ -217,6 +266,8 @@ gkyl_array_clone(const struct gkyl_array* src)
   arr->flags = src->flags;
 
   GKYL_CLEAR_ALLOC_EXTERN(arr->flags);
+  GKYL_CLEAR_ALLOC_POOL(arr->flags);
+  array_account(arr);
 
   if (!GKYL_IS_CU_ALLOC(src->flags)) {
     arr->data = g_array_alloc(arr->size, arr->esznc);
@@ -291,6 +342,8 @@ gkyl_array_cu_dev_new(enum gkyl_elem_type type, size_t ncomp, size_t size)
   // (which is the host-side pointer to the device data)
   gkyl_cu_memcpy(&((arr->on_dev)->data), &arr->data, sizeof(void*), GKYL_CU_MEMCPY_H2D);
 
+  array_account(arr);
+
   // Zero out array elements (not for user-defined type).
   if (type == GKYL_INT) {
     int *data_ho = gkyl_malloc(arr->size*arr->esznc);
@@ -338,6 +391,8 @@ gkyl_array_cu_host_new(enum gkyl_elem_type type, size_t ncomp, size_t size)
   arr->nblocks = 1;
 
   arr->on_dev = arr; // on_dev reference
+
+  array_account(arr);
   
   // Zero out array elements (not for user-defined type).
   if (type == GKYL_INT) {
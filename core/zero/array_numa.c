@@ -0,0 +1,200 @@
+#ifdef __linux__
+#define _GNU_SOURCE // for syscall
+#endif
+
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include <gkyl_alloc.h>
+#include <gkyl_alloc_flags_priv.h>
+#include <gkyl_array_numa.h>
+#include <gkyl_util.h>
+
+static long
+page_size(void)
+{
+  long ps = sysconf(_SC_PAGESIZE);
+  return ps > 0 ? ps : 4096;
+}
+
+// Start of split tid of the index space [0, size), computed as in
+// gkyl_range_split.
+static long
+split_start(long size, int nsplits, int tid)
+{
+  long quot = size/nsplits, rem = size % nsplits;
+  return tid < rem ? tid*(quot+1) : rem*(quot+1) + (tid-rem)*quot;
+}
+
+// Split holding index idx of [0, size).
+static int
+split_of(long size, int nsplits, long idx)
+{
+  long quot = size/nsplits, rem = size % nsplits;
+  if (idx < rem*(quot+1))
+    return idx/(quot+1);
+  return quot > 0 ? rem + (idx-rem*(quot+1))/quot : nsplits-1;
+}
+
+// Offset in bytes of the data from the start of the page it is in.
+static long
+data_page_offset(const struct gkyl_array *arr)
+{
+  return ((uintptr_t) arr->data) % page_size();
+}
+
+// First page whose first byte is at or after byte offset off of the data.
+static long
+page_at_byte(const struct gkyl_array *arr, long off)
+{
+  long ps = page_size(), poff = data_page_offset(arr);
+  return off == 0 ? 0 : (off+poff+ps-1)/ps;
+}
+
+long
+gkyl_array_numa_num_pages(const struct gkyl_array *arr)
+{
+  long ps = page_size();
+  long nbytes = arr->size*arr->esznc + data_page_offset(arr);
+  return (nbytes+ps-1)/ps;
+}
+
+void
+gkyl_array_numa_split_pages(const struct gkyl_array *arr, int nsplits, int tid,
+  long *first, long *last)
+{
+  long npages = gkyl_array_numa_num_pages(arr);
+  *first = GKYL_MIN2(npages, page_at_byte(arr, split_start(arr->size, nsplits, tid)*arr->esznc));
+  *last = tid == nsplits-1 ? npages :
+    GKYL_MIN2(npages, page_at_byte(arr, split_start(arr->size, nsplits, tid+1)*arr->esznc));
+}
+
+int
+gkyl_array_numa_page_owner(const struct gkyl_array *arr, int nsplits, long page)
+{
+  long off = GKYL_MAX2(0, page*page_size() - data_page_offset(arr));
+  return split_of(arr->size, nsplits, off/arr->esznc);
+}
+
+struct numa_touch_ctx {
+  const struct gkyl_array *arr;
+  int nsplits, tid;
+  struct gkyl_array_numa_stat stat; // used by stat jobs
+};
+
+static void
+numa_touch_job(void *ctx)
+{
+  struct numa_touch_ctx *tc = ctx;
+  const struct gkyl_array *arr = tc->arr;
+  long first, last;
+  gkyl_array_numa_split_pages(arr, tc->nsplits, tc->tid, &first, &last);
+
+  long ps = page_size(), poff = data_page_offset(arr), nbytes = arr->size*arr->esznc;
+  long beg = GKYL_MAX2(0, first*ps-poff), end = GKYL_MIN2(nbytes, last*ps-poff);
+  if (end > beg)
+    memset((char*) arr->data + beg, 0, end-beg);
+}
+
+struct gkyl_array*
+gkyl_array_numa_new(enum gkyl_elem_type type, size_t ncomp, size_t size,
+  const struct gkyl_job_pool *jp)
+{
+  // Page-aligned buffer. Large allocations come straight from the OS
+  // and are not touched until the workers zero them.
+  struct gkyl_array *arr = gkyl_array_new_from_buff(type, ncomp, size, 0);
+  arr->data = gkyl_aligned_alloc(page_size(), arr->size*arr->esznc);
+  // The array owns the buffer, which is released with the same
+  // (aligned) free used by gkyl_array_new.
+  GKYL_CLEAR_ALLOC_EXTERN(arr->flags);
+  arr->mem_entry = gkyl_mem_account_alloc(false, arr->size*arr->esznc);
+
+  int nsplits = jp ? jp->pool_size : 1;
+  struct numa_touch_ctx ctx[nsplits];
+  for (int i=0; i<nsplits; ++i)
+    ctx[i] = (struct numa_touch_ctx) { .arr = arr, .nsplits = nsplits, .tid = i };
+
+  if (jp) {
+    for (int i=0; i<nsplits; ++i)
+      gkyl_job_pool_add_work(jp, numa_touch_job, &ctx[i]);
+    gkyl_job_pool_wait(jp);
+  }
+  else {
+    numa_touch_job(&ctx[0]);
+  }
+  return arr;
+}
+
+// Count placement of pages [first, last) relative to the node of the
+// calling thread.
+static struct gkyl_array_numa_stat
+numa_count_pages(const struct gkyl_array *arr, long first, long last)
+{
+  struct gkyl_array_numa_stat stat = { .unknown_pages = last-first };
+#ifdef __linux__
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, 0) != 0)
+    return stat;
+
+  enum { CHUNK = 1024 };
+  void *pages[CHUNK];
+  int status[CHUNK];
+  long ps = page_size();
+  char *base = (char*) arr->data - data_page_offset(arr);
+
+  for (long p=first; p<last; p+=CHUNK) {
+    long n = GKYL_MIN2(CHUNK, last-p);
+    for (long i=0; i<n; ++i)
+      pages[i] = base + (p+i)*ps;
+    // With no target nodes move_pages only reports where pages are.
+    if (syscall(SYS_move_pages, 0, n, pages, 0, status, 0) != 0)
+      return stat;
+    for (long i=0; i<n; ++i) {
+      if (status[i] < 0) continue; // not yet faulted in
+      stat.unknown_pages -= 1;
+      if (status[i] == (int) node)
+        stat.local_pages += 1;
+      else
+        stat.remote_pages += 1;
+    }
+  }
+#endif
+  return stat;
+}
+
+static void
+numa_stat_job(void *ctx)
+{
+  struct numa_touch_ctx *tc = ctx;
+  long first, last;
+  gkyl_array_numa_split_pages(tc->arr, tc->nsplits, tc->tid, &first, &last);
+  tc->stat = numa_count_pages(tc->arr, first, last);
+}
+
+struct gkyl_array_numa_stat
+gkyl_array_numa_stat(const struct gkyl_array *arr, const struct gkyl_job_pool *jp)
+{
+  if (!jp)
+    return numa_count_pages(arr, 0, gkyl_array_numa_num_pages(arr));
+
+  int nsplits = jp->pool_size;
+  struct numa_touch_ctx ctx[nsplits];
+  for (int i=0; i<nsplits; ++i) {
+    ctx[i] = (struct numa_touch_ctx) { .arr = arr, .nsplits = nsplits, .tid = i };
+    gkyl_job_pool_add_work(jp, numa_stat_job, &ctx[i]);
+  }
+  gkyl_job_pool_wait(jp);
+
+  struct gkyl_array_numa_stat stat = { };
+  for (int i=0; i<nsplits; ++i) {
+    stat.local_pages += ctx[i].stat.local_pages;
+    stat.remote_pages += ctx[i].stat.remote_pages;
+    stat.unknown_pages += ctx[i].stat.unknown_pages;
+  }
+  return stat;
+}
@@ -255,6 +255,41 @@ gkyl_array_accumulate_offset_range(struct gkyl_array *out,
   return out;
 }
 
+struct gkyl_array*
+gkyl_array_combine3_range(struct gkyl_array *out,
+  double a, const struct gkyl_array *inp1, double b, const struct gkyl_array *inp2,
+  double c, const struct gkyl_array *inp3, const struct gkyl_range *range)
+{
+  assert(out->type == GKYL_DOUBLE && inp1->type == GKYL_DOUBLE
+    && inp2->type == GKYL_DOUBLE && inp3->type == GKYL_DOUBLE);
+  assert(out->size == inp1->size && out->size == inp2->size && out->size == inp3->size);
+  assert(out->ncomp == inp1->ncomp && out->ncomp == inp2->ncomp && out->ncomp == inp3->ncomp);
+
+#ifdef GKYL_HAVE_CUDA
+  assert(gkyl_array_is_cu_dev(out)==gkyl_array_is_cu_dev(inp1));
+  assert(gkyl_array_is_cu_dev(out)==gkyl_array_is_cu_dev(inp2));
+  assert(gkyl_array_is_cu_dev(out)==gkyl_array_is_cu_dev(inp3));
+  if (gkyl_array_is_cu_dev(out)) { gkyl_array_combine3_range_cu(out, a, inp1, b, inp2, c, inp3, range); return out; }
+#endif
+
+  long n = NCOM(out);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, range);
+
+  while (gkyl_range_iter_next(&iter)) {
+    long start = gkyl_range_idx(range, iter.idx);
+    double *out_d = gkyl_array_fetch(out, start);
+    const double *inp1_d = gkyl_array_cfetch(inp1, start);
+    const double *inp2_d = gkyl_array_cfetch(inp2, start);
+    const double *inp3_d = gkyl_array_cfetch(inp3, start);
+    for (int k=0; k<n; ++k)
+      out_d[k] = a*inp1_d[k] + b*inp2_d[k] + c*inp3_d[k];
+  }
+
+  return out;
+}
+
 struct gkyl_array*
 gkyl_array_set_range(struct gkyl_array *out,
   double a, const struct gkyl_array *inp, const struct gkyl_range *range)
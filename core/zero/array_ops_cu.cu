@@ -244,6 +244,39 @@ gkyl_array_accumulate_range_cu_kernel(struct gkyl_array *out,
   }
 }
 
+__global__ void
+gkyl_array_combine3_range_cu_kernel(struct gkyl_array *out,
+  double a, const struct gkyl_array* inp1, double b, const struct gkyl_array* inp2,
+  double c, const struct gkyl_array* inp3, struct gkyl_range range)
+{
+  long n = NCOM(out);
+  int idx[GKYL_MAX_DIM];
+
+  int ndim = range.ndim;
+  // ac1 = size of last dimension of range (fastest moving dimension)
+  long ac1 = range.iac[ndim-1] > 0 ? range.iac[ndim-1] : 1;
+
+  // 2D thread grid
+  // linc2 = c + n*idx1 (contiguous data, including component index c, with idx1 = 0,.., ac1-1)
+  long linc2 = threadIdx.y + blockIdx.y*blockDim.y;
+  // linc1 = idx2 + ac2*idx3 + ...
+  for (unsigned long linc1 = threadIdx.x + blockIdx.x*blockDim.x;
+      linc1 < range.volume/ac1;
+      linc1 += gridDim.x*blockDim.x)
+  {
+    gkyl_sub_range_inv_idx(&range, ac1*linc1, idx);
+    long start = gkyl_range_idx(&range, idx);
+    
+    double* out_d = (double*) gkyl_array_fetch(out, start);
+    const double* inp1_d = (const double*) gkyl_array_cfetch(inp1, start);
+    const double* inp2_d = (const double*) gkyl_array_cfetch(inp2, start);
+    const double* inp3_d = (const double*) gkyl_array_cfetch(inp3, start);
+    // do operation on contiguous data block
+    if (linc2 < n*ac1)
+      out_d[linc2] = a*inp1_d[linc2] + b*inp2_d[linc2] + c*inp3_d[linc2];
+  }
+}
+
 __global__ void
 gkyl_array_accumulate_offset_range_cu_kernel(struct gkyl_array *out,
   double a, const struct gkyl_array* inp, int coff, struct gkyl_range range)
@@ -600,6 +633,18 @@ gkyl_array_accumulate_offset_range_cu(struct gkyl_array *out,
   gkyl_array_accumulate_offset_range_cu_kernel<<<dimGrid, dimBlock>>>(out->on_dev, a, inp->on_dev, coff, *range);
 }
 
+void
+gkyl_array_combine3_range_cu(struct gkyl_array *out,
+  double a, const struct gkyl_array *inp1, double b, const struct gkyl_array *inp2,
+  double c, const struct gkyl_array *inp3, const struct gkyl_range *range)
+{
+  dim3 dimGrid, dimBlock;
+  gkyl_get_array_range_kernel_launch_dims(&dimGrid, &dimBlock, *range, out->ncomp);
+
+  gkyl_array_combine3_range_cu_kernel<<<dimGrid, dimBlock>>>(out->on_dev,
+    a, inp1->on_dev, b, inp2->on_dev, c, inp3->on_dev, *range);
+}
+
 void
 gkyl_array_set_range_cu(struct gkyl_array *out,
   double a, const struct gkyl_array* inp, const struct gkyl_range *range)
@@ -0,0 +1,211 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_bench.h>
+#include <gkyl_util.h>
+
+enum { BENCH_NAME_SZ = 128 };
+
+struct bench_result {
+  char name[BENCH_NAME_SZ];
+  double ns_per_cell;
+};
+
+struct gkyl_bench {
+  struct gkyl_bench_inp inp;
+
+  int nbase; // number of baseline results
+  struct bench_result *base; // baseline results
+
+  int nres, nalloc; // number of results, and space for them
+  struct bench_result *res; // results of this run
+
+  int nregress; // number of regressions
+};
+
+// Read results written by an earlier run: one "name ns_per_cell" per
+// line, with lines starting with '#' ignored.
+static struct bench_result*
+read_baseline(const char *fname, int *nbase)
+{
+  *nbase = 0;
+  FILE *fp = fopen(fname, "r");
+  if (!fp) {
+    fprintf(stderr, "gkyl_bench: unable to open baseline file %s\n", fname);
+    return 0;
+  }
+
+  int nalloc = 64;
+  struct bench_result *base = gkyl_malloc(sizeof(struct bench_result[nalloc]));
+  char line[256];
+  while (fgets(line, sizeof line, fp)) {
+    if (line[0] == '#') continue;
+    struct bench_result r;
+    if (sscanf(line, "%127s %lg", r.name, &r.ns_per_cell) != 2) continue;
+    if (*nbase == nalloc) {
+      nalloc *= 2;
+      base = gkyl_realloc(base, sizeof(struct bench_result[nalloc]));
+    }
+    base[(*nbase)++] = r;
+  }
+  fclose(fp);
+  return base;
+}
+
+gkyl_bench*
+gkyl_bench_new(const struct gkyl_bench_inp *inp)
+{
+  struct gkyl_bench *bench = gkyl_malloc(sizeof *bench);
+  bench->inp = *inp;
+  if (bench->inp.threshold <= 0.0) bench->inp.threshold = 0.1;
+  if (bench->inp.min_time <= 0.0) bench->inp.min_time = 0.1;
+
+  bench->base = 0;
+  bench->nbase = 0;
+  if (inp->baseline)
+    bench->base = read_baseline(inp->baseline, &bench->nbase);
+
+  bench->nres = 0;
+  bench->nalloc = 64;
+  bench->res = gkyl_malloc(sizeof(struct bench_result[bench->nalloc]));
+  bench->nregress = 0;
+
+  printf("%-44s %12s %10s %10s %10s\n", "# Benchmark", "ns/cell", "GFLOP/s", "GB/s", "vs. base");
+  return bench;
+}
+
+struct gkyl_bench_inp
+gkyl_bench_parse_args(int argc, char **argv)
+{
+  struct gkyl_bench_inp inp = { };
+  for (int i=1; i<argc-1; ++i) {
+    if (strcmp(argv[i], "-b") == 0)
+      inp.baseline = argv[++i];
+    else if (strcmp(argv[i], "-o") == 0)
+      inp.output = argv[++i];
+    else if (strcmp(argv[i], "-f") == 0)
+      inp.filter = argv[++i];
+    else if (strcmp(argv[i], "-t") == 0)
+      inp.threshold = atof(argv[++i]);
+    else if (strcmp(argv[i], "-m") == 0)
+      inp.min_time = atof(argv[++i]);
+  }
+  return inp;
+}
+
+bool
+gkyl_bench_enabled(const gkyl_bench *bench, const char *name)
+{
+  return !bench->inp.filter || strstr(name, bench->inp.filter);
+}
+
+double
+gkyl_bench_linear_flops(gkyl_bench_linear_func_t func, void *ctx, int nin, int nout)
+{
+  double *inp = gkyl_malloc(sizeof(double[nin]));
+  double *out = gkyl_malloc(sizeof(double[nout]));
+  long nnz = 0;
+  for (int i=0; i<nin; ++i) {
+    for (int j=0; j<nin; ++j) inp[j] = i == j ? 1.0 : 0.0;
+    func(ctx, inp, out);
+    for (int k=0; k<nout; ++k)
+      nnz += out[k] != 0.0 ? 1 : 0;
+  }
+  gkyl_free(inp);
+  gkyl_free(out);
+  return 2.0*nnz;
+}
+
+// Time taken to call func nrep times.
+static double
+time_reps(gkyl_bench_func_t func, void *ctx, long ncells, long nrep)
+{
+  struct timespec tm = gkyl_wall_clock();
+  for (long r=0; r<nrep; ++r)
+    func(ctx, ncells);
+  return gkyl_time_diff_now_sec(tm);
+}
+
+double
+gkyl_bench_run(gkyl_bench *bench, const char *name,
+  gkyl_bench_func_t func, void *ctx, long ncells, struct gkyl_bench_work work)
+{
+  if (!gkyl_bench_enabled(bench, name) || ncells <= 0)
+    return 0.0;
+
+  // Warm up, and find the number of calls that takes a third of the
+  // minimum time.
+  double trial_tm = bench->inp.min_time/3.0;
+  long nrep = 1;
+  double tm = time_reps(func, ctx, ncells, nrep);
+  while (tm < trial_tm) {
+    nrep = tm > 0.0 ? GKYL_MAX2(2*nrep, (long) (1.1*nrep*trial_tm/tm)) : 10*nrep;
+    tm = time_reps(func, ctx, ncells, nrep);
+  }
+
+  double best = tm;
+  for (int t=0; t<2; ++t)
+    best = fmin(best, time_reps(func, ctx, ncells, nrep));
+  double ns_per_cell = 1e9*best/((double) nrep*ncells);
+
+  if (bench->nres == bench->nalloc) {
+    bench->nalloc *= 2;
+    bench->res = gkyl_realloc(bench->res, sizeof(struct bench_result[bench->nalloc]));
+  }
+  struct bench_result *res = &bench->res[bench->nres++];
+  snprintf(res->name, sizeof res->name, "%s", name);
+  res->ns_per_cell = ns_per_cell;
+
+  char gflops[16] = "-", gbs[16] = "-", cmp[32] = "-";
+  if (work.flops > 0.0)
+    snprintf(gflops, sizeof gflops, "%.3f", work.flops/ns_per_cell);
+  if (work.bytes > 0.0)
+    snprintf(gbs, sizeof gbs, "%.3f", work.bytes/ns_per_cell);
+  for (int i=0; i<bench->nbase; ++i) {
+    if (strcmp(bench->base[i].name, res->name) != 0) continue;
+    double rel = ns_per_cell/bench->base[i].ns_per_cell - 1.0;
+    bool regress = rel > bench->inp.threshold;
+    snprintf(cmp, sizeof cmp, "%+.1f%%%s", 100.0*rel, regress ? " REGRESSION" : "");
+    bench->nregress += regress ? 1 : 0;
+    break;
+  }
+
+  printf("%-44s %12.3f %10s %10s %10s\n", res->name, ns_per_cell, gflops, gbs, cmp);
+  fflush(stdout);
+  return ns_per_cell;
+}
+
+int
+gkyl_bench_num_regressions(const gkyl_bench *bench)
+{
+  return bench->nregress;
+}
+
+int
+gkyl_bench_release(gkyl_bench *bench)
+{
+  if (bench->inp.output) {
+    FILE *fp = fopen(bench->inp.output, "w");
+    if (fp) {
+      fprintf(fp, "# name ns_per_cell\n");
+      for (int i=0; i<bench->nres; ++i)
+        fprintf(fp, "%s %.6g\n", bench->res[i].name, bench->res[i].ns_per_cell);
+      fclose(fp);
+    }
+    else {
+      fprintf(stderr, "gkyl_bench: unable to open output file %s\n", bench->inp.output);
+    }
+  }
+
+  int nregress = bench->nregress;
+  if (bench->inp.baseline)
+    printf("# %d of %d benchmarks slower than baseline by more than %g%%\n",
+      nregress, bench->nres, 100.0*bench->inp.threshold);
+
+  gkyl_free(bench->base);
+  gkyl_free(bench->res);
+  gkyl_free(bench);
+  return nregress;
+}
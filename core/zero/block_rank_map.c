@@ -0,0 +1,319 @@
+#include <float.h>
+#include <limits.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_block_rank_map.h>
+#include <gkyl_util.h>
+
+// internal struct to represent the block-to-rank map
+struct block_rank_map {
+  struct gkyl_block_rank_map brm;
+  int *nranks; // number of ranks in each block
+  int *cuts; // cuts of each block (num_blocks*ndim)
+  int *offset; // offset of list of ranks of each block into ranks
+  int *ranks; // ranks handling pieces of each block
+};
+
+// Cuts of a block into a given number of pieces
+struct cut_choice {
+  long max_cells; // number of cells in largest piece
+  double halo; // halo volume between pieces
+  int cuts[GKYL_MAX_DIM];
+};
+
+// Recursively search all factorizations of n into cuts along
+// directions d, ..., ndim-1 (other than uncut ones, and only dividing
+// the cells evenly if even is true), keeping the one with the
+// smallest largest piece and, amongst those, the smallest halo volume.
+static void
+search_cuts(int ndim, const int *cells, const bool *uncut, bool even, int d, int n, int *cuts,
+  struct cut_choice *best)
+{
+  if (d == ndim-1) {
+    if ((n > cells[d]) || (uncut[d] && (n > 1))) return;
+    if (even && (cells[d] % n)) return;
+    cuts[d] = n;
+
+    long max_cells = 1;
+    double halo = 0.0;
+    for (int i=0; i<ndim; ++i) {
+      // rect_decomp splits cells as evenly as possible
+      max_cells *= (cells[i]+cuts[i]-1)/cuts[i];
+      double face = 1.0;
+      for (int j=0; j<ndim; ++j)
+        if (j != i) face *= cells[j];
+      halo += (cuts[i]-1)*face;
+    }
+    if ((max_cells < best->max_cells) ||
+      ((max_cells == best->max_cells) && (halo < best->halo))) {
+      best->max_cells = max_cells;
+      best->halo = halo;
+      for (int i=0; i<ndim; ++i) best->cuts[i] = cuts[i];
+    }
+    return;
+  }
+
+  int cmax = uncut[d] ? 1 : GKYL_MIN2(n, cells[d]);
+  for (int c=1; c<=cmax; ++c) {
+    if ((n % c == 0) && !(even && (cells[d] % c))) {
+      cuts[d] = c;
+      search_cuts(ndim, cells, uncut, even, d+1, n/c, cuts, best);
+    }
+  }
+}
+
+// Find best cuts of block with given cells into n pieces. Returns
+// false if the block can't be cut into n pieces.
+static bool
+best_cuts(int ndim, const int *cells, const bool *uncut, bool even, int n, struct cut_choice *best)
+{
+  best->max_cells = LONG_MAX;
+  best->halo = DBL_MAX;
+  int cuts[GKYL_MAX_DIM];
+  search_cuts(ndim, cells, uncut, even, 0, n, cuts, best);
+  return best->max_cells < LONG_MAX;
+}
+
+// Smallest number of pieces larger than n, and no larger than nmax,
+// the block can be cut into. Returns 0 if there is none.
+static int
+next_split(int ndim, const int *cells, const bool *uncut, bool even, int n, int nmax,
+  struct cut_choice *choice)
+{
+  for (int m=n+1; m<=nmax; ++m)
+    if (best_cuts(ndim, cells, uncut, even, m, choice)) return m;
+  return 0;
+}
+
+// Data needed to pack pieces of blocks onto ranks
+struct pack_ctx {
+  const struct gkyl_block_topo *topo;
+  int num_blocks, num_ranks;
+  const int *n; // number of pieces of each block
+  const double *piece_cost; // cost of a piece of each block
+
+  int *order; // blocks sorted by decreasing piece cost
+  double *load; // cost on each rank
+  char *hosts; // hosts[r*num_blocks+b] is 1 if rank r has a piece of b
+  int *piece_rank; // rank of each piece
+};
+
+// True if rank r has a piece of a block connected to block b.
+static bool
+has_neighbor(const struct pack_ctx *pc, int r, int b)
+{
+  if (!pc->topo) return false;
+  for (int d=0; d<pc->topo->ndim; ++d) {
+    for (int e=0; e<2; ++e) {
+      const struct gkyl_target_edge *te = &pc->topo->conn[b].connections[d][e];
+      if ((te->edge != GKYL_PHYSICAL) && pc->hosts[r*pc->num_blocks+te->bid])
+        return true;
+    }
+  }
+  return false;
+}
+
+// Assign pieces to ranks, largest first, each to the least loaded rank
+// that does not have a piece of the same block. Amongst equally
+// loaded ranks, prefer one that has a piece of a connected block so
+// the halo exchange between the blocks stays on the rank. Returns the
+// maximum cost on any rank.
+static double
+pack_pieces(struct pack_ctx *pc)
+{
+  int nb = pc->num_blocks, nr = pc->num_ranks;
+
+  for (int i=0; i<nb; ++i) {
+    int b = i, j = i;
+    for (; (j>0) && (pc->piece_cost[pc->order[j-1]] < pc->piece_cost[b]); --j)
+      pc->order[j] = pc->order[j-1];
+    pc->order[j] = b;
+  }
+  for (int r=0; r<nr; ++r) pc->load[r] = 0.0;
+  memset(pc->hosts, 0, nr*nb);
+
+  int *offset = gkyl_malloc(sizeof(int[nb]));
+  offset[0] = 0;
+  for (int b=1; b<nb; ++b) offset[b] = offset[b-1] + pc->n[b-1];
+
+  double max_load = 0.0;
+  for (int i=0; i<nb; ++i) {
+    int b = pc->order[i];
+    for (int k=0; k<pc->n[b]; ++k) {
+      int rmin = -1;
+      for (int r=0; r<nr; ++r) {
+        if (pc->hosts[r*nb+b]) continue;
+        if ((rmin < 0) || (pc->load[r] < pc->load[rmin]*(1.0-1e-12)))
+          rmin = r;
+        else if ((pc->load[r] <= pc->load[rmin]*(1.0+1e-12)) &&
+          !has_neighbor(pc, rmin, b) && has_neighbor(pc, r, b))
+          rmin = r;
+      }
+      pc->hosts[rmin*nb+b] = 1;
+      pc->load[rmin] += pc->piece_cost[b];
+      pc->piece_rank[offset[b]+k] = rmin;
+      max_load = GKYL_MAX2(max_load, pc->load[rmin]);
+    }
+  }
+
+  gkyl_free(offset);
+  return max_load;
+}
+
+const struct gkyl_block_rank_map*
+gkyl_block_rank_map_new(const struct gkyl_block_rank_map_inp *inp)
+{
+  int ndim = inp->ndim, nb = inp->num_blocks, nr = inp->num_ranks;
+
+  double *cell_cost = gkyl_malloc(sizeof(double[nb]));
+  double tot_cost = 0.0;
+  for (int b=0; b<nb; ++b) {
+    long ncells = 1;
+    for (int d=0; d<ndim; ++d) ncells *= inp->cells[b*ndim+d];
+    cell_cost[b] = inp->cost ? inp->cost[b]/ncells : 1.0;
+    tot_cost += cell_cost[b]*ncells;
+  }
+
+  int *n = gkyl_malloc(sizeof(int[nb]));
+  struct cut_choice *choice = gkyl_malloc(sizeof(struct cut_choice[nb]));
+  double *piece_cost = gkyl_malloc(sizeof(double[nb]));
+  // next number of pieces each block can be cut into
+  int *nnext = gkyl_malloc(sizeof(int[nb]));
+  struct cut_choice *next_choice = gkyl_malloc(sizeof(struct cut_choice[nb]));
+
+  for (int b=0; b<nb; ++b) {
+    n[b] = 1;
+    best_cuts(ndim, &inp->cells[b*ndim], inp->uncut_dirs, inp->even_cuts, 1, &choice[b]);
+    piece_cost[b] = cell_cost[b]*choice[b].max_cells;
+    nnext[b] = next_split(ndim, &inp->cells[b*ndim], inp->uncut_dirs, inp->even_cuts, 1, nr, &next_choice[b]);
+  }
+
+  // at most num_ranks pieces per block, and pieces are only added
+  // while there are fewer pieces than ranks or the max cost drops
+  long max_pieces = (long) nb*nr;
+  struct pack_ctx pc = {
+    .topo = inp->topo,
+    .num_blocks = nb,
+    .num_ranks = nr,
+    .n = n,
+    .piece_cost = piece_cost,
+    .order = gkyl_malloc(sizeof(int[nb])),
+    .load = gkyl_malloc(sizeof(double[nr])),
+    .hosts = gkyl_malloc(sizeof(char[nr*nb])),
+    .piece_rank = gkyl_malloc(sizeof(int[max_pieces])),
+  };
+
+  // Repeatedly cut the block with the most expensive pieces into more
+  // pieces: this is needed until there are at least as many pieces as
+  // ranks, after which it is kept only if it reduces the max cost.
+  int npieces = nb;
+  double max_cost = npieces >= nr ? pack_pieces(&pc) : DBL_MAX;
+  while (1) {
+    int bs = -1;
+    for (int b=0; b<nb; ++b)
+      if (nnext[b] && ((bs < 0) || (piece_cost[b] > piece_cost[bs]))) bs = b;
+    if (bs < 0) break;
+
+    int n_old = n[bs];
+    struct cut_choice choice_old = choice[bs];
+    double piece_cost_old = piece_cost[bs];
+
+    n[bs] = nnext[bs];
+    choice[bs] = next_choice[bs];
+    piece_cost[bs] = cell_cost[bs]*choice[bs].max_cells;
+    int npieces_new = npieces - n_old + n[bs];
+
+    double max_cost_new = npieces_new >= nr ? pack_pieces(&pc) : DBL_MAX;
+    if ((npieces >= nr) && !(max_cost_new < max_cost*(1.0-1e-12))) {
+      n[bs] = n_old;
+      choice[bs] = choice_old;
+      piece_cost[bs] = piece_cost_old;
+      break;
+    }
+    npieces = npieces_new;
+    max_cost = max_cost_new;
+    nnext[bs] = next_split(ndim, &inp->cells[bs*ndim], inp->uncut_dirs, inp->even_cuts, n[bs], nr, &next_choice[bs]);
+  }
+
+  struct block_rank_map *brm = 0;
+  if (npieces >= nr) {
+    max_cost = pack_pieces(&pc);
+
+    brm = gkyl_malloc(sizeof(*brm));
+    brm->brm.ndim = ndim;
+    brm->brm.num_blocks = nb;
+    brm->brm.total_ranks = nr;
+    brm->brm.max_cost = max_cost;
+    brm->brm.avg_cost = tot_cost/nr;
+
+    brm->nranks = gkyl_malloc(sizeof(int[nb]));
+    brm->cuts = gkyl_malloc(sizeof(int[nb*ndim]));
+    brm->offset = gkyl_malloc(sizeof(int[nb]));
+    brm->ranks = gkyl_malloc(sizeof(int[npieces]));
+
+    // Relabel ranks in order of the blocks they handle, so that ranks
+    // handling the same block are contiguous.
+    int *label = gkyl_malloc(sizeof(int[nr]));
+    for (int r=0; r<nr; ++r) label[r] = -1;
+    int next_label = 0;
+    for (int b=0, loc=0; b<nb; ++b) {
+      brm->nranks[b] = n[b];
+      brm->offset[b] = loc;
+      for (int d=0; d<ndim; ++d) brm->cuts[b*ndim+d] = choice[b].cuts[d];
+      for (int k=0; k<n[b]; ++k, ++loc) {
+        int r = pc.piece_rank[loc];
+        if (label[r] < 0) label[r] = next_label++;
+        brm->ranks[loc] = label[r];
+      }
+    }
+    gkyl_free(label);
+  }
+
+  gkyl_free(pc.order);
+  gkyl_free(pc.load);
+  gkyl_free(pc.hosts);
+  gkyl_free(pc.piece_rank);
+  gkyl_free(cell_cost);
+  gkyl_free(n);
+  gkyl_free(choice);
+  gkyl_free(piece_cost);
+  gkyl_free(nnext);
+  gkyl_free(next_choice);
+
+  return brm ? &brm->brm : 0;
+}
+
+int
+gkyl_block_rank_map_nranks(const struct gkyl_block_rank_map *brm, int bn)
+{
+  struct block_rank_map *map = container_of(brm, struct block_rank_map, brm);
+  return map->nranks[bn];
+}
+
+void
+gkyl_block_rank_map_getranks(const struct gkyl_block_rank_map *brm, int bn, int ranks[])
+{
+  struct block_rank_map *map = container_of(brm, struct block_rank_map, brm);
+  for (int i=0; i<map->nranks[bn]; ++i)
+    ranks[i] = map->ranks[map->offset[bn]+i];
+}
+
+void
+gkyl_block_rank_map_getcuts(const struct gkyl_block_rank_map *brm, int bn, int cuts[])
+{
+  struct block_rank_map *map = container_of(brm, struct block_rank_map, brm);
+  for (int d=0; d<brm->ndim; ++d)
+    cuts[d] = map->cuts[bn*brm->ndim+d];
+}
+
+void
+gkyl_block_rank_map_release(const struct gkyl_block_rank_map *brm)
+{
+  struct block_rank_map *map = container_of(brm, struct block_rank_map, brm);
+  gkyl_free(map->nranks);
+  gkyl_free(map->cuts);
+  gkyl_free(map->offset);
+  gkyl_free(map->ranks);
+  gkyl_free(map);
+}
@@ -115,6 +115,184 @@ char* gkyl_mem_buff_data(gkyl_mem_buff mem);
 /** Free buffer */
 void gkyl_mem_buff_release(gkyl_mem_buff mem);
 
+// Accounting of the memory used by array data. Bytes are attributed to
+// the subsystem active when the array is allocated, and given back to
+// it when the array is freed. Subsystems are nested with push/pop, and
+// their names are joined with '/' (e.g. "elc/lbo"). The active subsystem
+// is per thread: each thread has its own push/pop stack, and arrays
+// allocated on a thread with nothing pushed only count in the totals.
+struct gkyl_mem_account_entry {
+  const char *name; // full name of subsystem
+  size_t curr_bytes; // bytes of live array data allocated in subsystem
+  size_t peak_bytes; // peak value of curr_bytes
+  long num_arrays; // number of live arrays allocated in subsystem
+};
+
+// Totals of accounted memory ([0] host, [1] device)
+struct gkyl_mem_account_stat {
+  size_t curr_bytes[2]; // bytes currently allocated
+  size_t peak_bytes[2]; // peak value of curr_bytes
+};
+
+/**
+ * Make a (nested) subsystem active for accounting.
+ *
+ * @param name Name of subsystem
+ */
+void gkyl_mem_account_push(const char *name);
+
+/**
+ * Deactivate the innermost active subsystem.
+ */
+void gkyl_mem_account_pop(void);
+
+/**
+ * Account for allocation of array data to the active subsystem.
+ *
+ * @param on_gpu True if memory is on device
+ * @param nbytes Number of bytes allocated
+ * @return Entry the bytes were accounted to (-1 if none), to pass to
+ *   gkyl_mem_account_free
+ */
+int gkyl_mem_account_alloc(bool on_gpu, size_t nbytes);
+
+/**
+ * Account for deallocation of array data.
+ *
+ * @param on_gpu True if memory is on device
+ * @param entry Entry returned by gkyl_mem_account_alloc
+ * @param nbytes Number of bytes freed
+ */
+void gkyl_mem_account_free(bool on_gpu, int entry, size_t nbytes);
+
+/**
+ * Get totals of accounted memory.
+ *
+ * @return Current and peak bytes on host and device
+ */
+struct gkyl_mem_account_stat gkyl_mem_account_stat(void);
+
+/**
+ * Number of subsystems memory has been accounted to.
+ *
+ * @return Number of entries
+ */
+int gkyl_mem_account_num_entries(void);
+
+/**
+ * Get accounting entry of a subsystem. Entries are in the order the
+ * subsystems were first pushed.
+ *
+ * @param i Entry index [0, gkyl_mem_account_num_entries())
+ * @return Accounting entry
+ */
+struct gkyl_mem_account_entry gkyl_mem_account_entry(int i);
+
+/**
+ * Reset the peak bytes of the totals and of every entry to the current
+ * bytes, and empty the calling thread's stack of active subsystems.
+ */
+void gkyl_mem_account_reset(void);
+
+// Pool of host memory blocks, for temporary allocations that are made
+// and freed repeatedly. Requests are rounded up to one of a set of size
+// classes (at most 25% larger than the request) and freed blocks are
+// kept on per-class free lists for reuse, instead of being returned to
+// the heap. Blocks are 64-byte aligned. A pool is meant to be owned by
+// one subsystem, whose name is used when reporting usage.
+typedef struct gkyl_mem_pool gkyl_mem_pool;
+
+// Usage of a memory pool
+struct gkyl_mem_pool_stat {
+  size_t curr_bytes; // bytes in blocks currently handed out
+  size_t peak_bytes; // peak value of curr_bytes
+  size_t held_bytes; // bytes held by pool (handed out or on free lists)
+  long num_alloc; // number of allocations
+  long num_reuse; // number of allocations served from free lists
+};
+
+#define gkyl_mem_pool_alloc(pool, size)                                 \
+    gkyl_mem_pool_alloc_(__FILE__, __LINE__, __FUNCTION__, pool, size)
+#define gkyl_mem_pool_free(ptr)                                         \
+    gkyl_mem_pool_free_(__FILE__, __LINE__, __FUNCTION__, ptr)
+
+/**
+ * Create new memory pool. The pool is added to a process-wide list
+ * used by gkyl_mem_pool_stat_write.
+ *
+ * @param name Name of subsystem owning the pool
+ * @return New memory pool
+ */
+gkyl_mem_pool* gkyl_mem_pool_new(const char *name);
+
+/**
+ * Allocate block of memory from pool. Must be freed with
+ * gkyl_mem_pool_free(), or reclaimed by the end of the arena it was
+ * allocated in.
+ *
+ * @param pool Pool to allocate from
+ * @param size Number of bytes to allocate
+ * @return Pointer to 64-byte aligned memory
+ */
+void* gkyl_mem_pool_alloc_(const char *file, int line, const char *func,
+  gkyl_mem_pool *pool, size_t size);
+
+/**
+ * Return block of memory to the pool it was allocated from.
+ *
+ * @param ptr Memory to free
+ */
+void gkyl_mem_pool_free_(const char *file, int line, const char *func, void *ptr);
+
+/**
+ * Begin a scoped arena. All blocks allocated from the pool until the
+ * matching gkyl_mem_pool_arena_end() and not freed by then are
+ * reclaimed by it. Arenas nest, and must be ended in reverse order of
+ * their creation.
+ *
+ * @param pool Memory pool
+ * @return Arena ID, to pass to gkyl_mem_pool_arena_end()
+ */
+int gkyl_mem_pool_arena_begin(gkyl_mem_pool *pool);
+
+/**
+ * End a scoped arena, returning all blocks still allocated in it to
+ * the pool. Pointers to these blocks must not be used afterwards.
+ *
+ * @param pool Memory pool
+ * @param arena Arena ID returned by gkyl_mem_pool_arena_begin()
+ */
+void gkyl_mem_pool_arena_end(gkyl_mem_pool *pool, int arena);
+
+/**
+ * Return the memory on the free lists of the pool to the heap.
+ *
+ * @param pool Memory pool
+ */
+void gkyl_mem_pool_trim(gkyl_mem_pool *pool);
+
+/**
+ * Get usage of memory pool.
+ *
+ * @param pool Memory pool
+ * @return Usage statistics
+ */
+struct gkyl_mem_pool_stat gkyl_mem_pool_stat(gkyl_mem_pool *pool);
+
+/**
+ * Write usage (current, peak and held bytes) of all memory pools.
+ *
+ * @param fp File to write to
+ */
+void gkyl_mem_pool_stat_write(FILE *fp);
+
+/**
+ * Release memory pool, and all memory allocated from it.
+ *
+ * @param pool Memory pool to release
+ */
+void gkyl_mem_pool_release(gkyl_mem_pool *pool);
+
 // CUDA specific code (NV: Nvidia)
 
 #define gkyl_cu_malloc(size)                                    \
@@ -4,7 +4,7 @@
 #include <stdint.h>
 
 // flags and corresponding bit-masks
-enum gkyl_alloc_flags { GKYL_IS_CU_ALLOC, GKYL_IS_ALLOC_ALIGNED, GKYL_IS_ALLOC_EXTERN };
+enum gkyl_alloc_flags { GKYL_IS_CU_ALLOC, GKYL_IS_ALLOC_ALIGNED, GKYL_IS_ALLOC_EXTERN, GKYL_IS_ALLOC_POOL };
 static const uint32_t gkyl_alloc_flags_masks[] =
 { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
 
@@ -22,3 +22,8 @@ static const uint32_t gkyl_alloc_flags_masks[] =
 #define GKYL_SET_ALLOC_EXTERN(flags) ((flags) |= gkyl_alloc_flags_masks[GKYL_IS_ALLOC_EXTERN])
 #define GKYL_CLEAR_ALLOC_EXTERN(flags) ((flags) &= ~gkyl_alloc_flags_masks[GKYL_IS_ALLOC_EXTERN])
 #define GKYL_IS_ALLOC_EXTERN(flags) (((flags) & gkyl_alloc_flags_masks[GKYL_IS_ALLOC_EXTERN]) != 0)
+
+// Flag to indicate object was allocated from a gkyl_mem_pool
+#define GKYL_SET_ALLOC_POOL(flags) ((flags) |= gkyl_alloc_flags_masks[GKYL_IS_ALLOC_POOL])
+#define GKYL_CLEAR_ALLOC_POOL(flags) ((flags) &= ~gkyl_alloc_flags_masks[GKYL_IS_ALLOC_POOL])
+#define GKYL_IS_ALLOC_POOL(flags) (((flags) & gkyl_alloc_flags_masks[GKYL_IS_ALLOC_POOL]) != 0)
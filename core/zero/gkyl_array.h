@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <math.h>
 
+struct gkyl_mem_pool;
+
 /**
  * Array object. This is an untype, undimensioned, reference counted
  * array object. All additional structure is provided else where,
@@ -26,6 +28,7 @@ struct gkyl_array {
 
   int nthreads, nblocks; // threads per block, number of blocks
   struct gkyl_array *on_dev; // pointer to itself or device data
+  int mem_entry; // memory-accounting entry of data (-1 if none)
 #ifdef GKYL_HAVE_CUDA
   cudaStream_t iostream;
 #else
@@ -57,6 +60,23 @@ struct gkyl_array* gkyl_array_new(enum gkyl_elem_type type, size_t ncomp, size_t
 struct gkyl_array *gkyl_array_new_from_buff(
   enum gkyl_elem_type type, size_t ncomp, size_t size, void *buff);
 
+/**
+ * Create new array with the array object and its data allocated as a
+ * single block from a memory pool. This is meant for temporary arrays
+ * that are created and released repeatedly. The array must be
+ * released before the end of the pool arena it was allocated in, or
+ * not at all (in which case the arena end reclaims it). Delete using
+ * gkyl_array_release method.
+ *
+ * @param pool Memory pool to allocate from
+ * @param type Type of data in array
+ * @param ncomp Number of components at each index
+ * @param size Number of indices
+ * @return Pointer to newly allocated array.
+ */
+struct gkyl_array* gkyl_array_pool_new(struct gkyl_mem_pool *pool,
+  enum gkyl_elem_type type, size_t ncomp, size_t size);
+
 /**
  * Create new array with data on NV-GPU. Delete using
  * gkyl_array_release method.
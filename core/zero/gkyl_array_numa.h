@@ -0,0 +1,82 @@
+#pragma once
+
+#include <gkyl_array.h>
+#include <gkyl_job_pool.h>
+
+// Placement of the pages of an array relative to the NUMA nodes of the
+// threads that own them.
+struct gkyl_array_numa_stat {
+  long local_pages; // pages on the node of the owning thread
+  long remote_pages; // pages on another node
+  long unknown_pages; // pages not yet touched, or placement not available
+};
+
+/**
+ * Create new array whose pages are first-touched (zeroed) by the
+ * workers of a job pool, so that on a NUMA machine each page is
+ * placed on the node of the worker that owns it. The index space [0,
+ * size) is split into jp->pool_size contiguous pieces in the same way
+ * as gkyl_range_split splits a range, and a page is owned by the split
+ * that holds its first byte. Threaded sweeps over the range the array
+ * was allocated on, using gkyl_range_split with pool_size splits and
+ * one job per split, then mostly touch local memory. Use a pinned
+ * pool (gkyl_thread_pool_pinned_new) so that splits stay on the same
+ * core. If jp is NULL the array is zeroed by the calling thread. Delete
+ * using gkyl_array_release method.
+ *
+ * @param type Type of data in array
+ * @param ncomp Number of components at each index
+ * @param size Number of indices
+ * @param jp Job pool whose workers touch the pages (can be NULL)
+ * @return Pointer to newly allocated array.
+ */
+struct gkyl_array* gkyl_array_numa_new(enum gkyl_elem_type type, size_t ncomp, size_t size,
+  const struct gkyl_job_pool *jp);
+
+/**
+ * Number of memory pages spanned by the data of the array.
+ *
+ * @param arr Array (on host)
+ * @return Number of pages
+ */
+long gkyl_array_numa_num_pages(const struct gkyl_array *arr);
+
+/**
+ * Pages owned by a split of the index space of the array: pages
+ * [first, last) have their first byte in the indices of split tid
+ * (split as in gkyl_range_split). A split smaller than a page may own
+ * no pages, in which case first == last.
+ *
+ * @param arr Array (on host)
+ * @param nsplits Number of splits
+ * @param tid Split ID [0, nsplits)
+ * @param first On output, first page owned by split
+ * @param last On output, one past the last page owned by split
+ */
+void gkyl_array_numa_split_pages(const struct gkyl_array *arr, int nsplits, int tid,
+  long *first, long *last);
+
+/**
+ * Split that owns a page of the array.
+ *
+ * @param arr Array (on host)
+ * @param nsplits Number of splits
+ * @param page Page index [0, gkyl_array_numa_num_pages)
+ * @return Split ID [0, nsplits)
+ */
+int gkyl_array_numa_page_owner(const struct gkyl_array *arr, int nsplits, long page);
+
+/**
+ * Count the pages of the array that are on the NUMA node of the thread
+ * owning them. If jp is not NULL, each worker checks the pages owned
+ * by its split (with jp->pool_size splits) against its own node.
+ * Otherwise all pages are checked against the node of the calling
+ * thread. Placement can only be queried on Linux; elsewhere all pages
+ * are reported as unknown.
+ *
+ * @param arr Array (on host)
+ * @param jp Job pool (can be NULL)
+ * @return Page placement counts
+ */
+struct gkyl_array_numa_stat gkyl_array_numa_stat(const struct gkyl_array *arr,
+  const struct gkyl_job_pool *jp);
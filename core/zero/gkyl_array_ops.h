@@ -167,6 +167,25 @@ struct gkyl_array* gkyl_array_accumulate_range(struct gkyl_array *out,
 struct gkyl_array* gkyl_array_accumulate_offset_range(struct gkyl_array *out,
   double a, const struct gkyl_array *inp, int coff, const struct gkyl_range *range);
 
+/**
+ * Compute out = a*inp1 + b*inp2 + c*inp3 over a range of indices, in a
+ * single pass. out may be the same array as any of the inputs. All arrays
+ * must have the same number of components.
+ *
+ * @param out Output array
+ * @param a Factor to multiply first input array
+ * @param inp1 First input array
+ * @param b Factor to multiply second input array
+ * @param inp2 Second input array
+ * @param c Factor to multiply third input array
+ * @param inp3 Third input array
+ * @param range Range specifying region to set
+ * @return out array
+ */
+struct gkyl_array* gkyl_array_combine3_range(struct gkyl_array *out,
+  double a, const struct gkyl_array *inp1, double b, const struct gkyl_array *inp2,
+  double c, const struct gkyl_array *inp3, const struct gkyl_range *range);
+
 /**
  * Set out = a*inp. Returns out.
  *
@@ -348,6 +367,10 @@ void gkyl_array_accumulate_range_cu(struct gkyl_array *out,
 void gkyl_array_accumulate_offset_range_cu(struct gkyl_array *out,
   double a, const struct gkyl_array* inp, int coff, const struct gkyl_range *range);
 
+void gkyl_array_combine3_range_cu(struct gkyl_array *out,
+  double a, const struct gkyl_array *inp1, double b, const struct gkyl_array *inp2,
+  double c, const struct gkyl_array *inp3, const struct gkyl_range *range);
+
 void gkyl_array_set_range_cu(struct gkyl_array *out,
   double a, const struct gkyl_array* inp, const struct gkyl_range *range);
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// Benchmark harness for kernels and other per-cell operations. Each
+// benchmark times a function that updates a given number of cells, and
+// reports the time per cell, the achieved GFLOP/s and the achieved
+// bandwidth. Results can be compared with a baseline file written by
+// an earlier run, and benchmarks slower than the baseline by more than
+// a threshold are flagged as regressions.
+
+// Function to benchmark: must update ncells cells.
+typedef void (*gkyl_bench_func_t)(void *ctx, long ncells);
+
+// Description of work per cell, used to compute rates.
+struct gkyl_bench_work {
+  double flops; // floating-point operations per cell (0 if not known)
+  double bytes; // bytes moved to/from memory per cell (0 if not known)
+};
+
+// Kernel that is linear in its input, for use in counting its FLOPs.
+typedef void (*gkyl_bench_linear_func_t)(void *ctx, const double *inp, double *out);
+
+// Input to create a new benchmark harness.
+struct gkyl_bench_inp {
+  const char *baseline; // file with baseline results to compare with (can be NULL)
+  const char *output; // file to write results to, usable as a baseline (can be NULL)
+  const char *filter; // only run benchmarks whose name contains this (can be NULL)
+  double threshold; // relative slow-down flagged as regression (default 0.1)
+  double min_time; // minimum time, in seconds, to run each benchmark (default 0.1)
+};
+
+/** Object type */
+typedef struct gkyl_bench gkyl_bench;
+
+/**
+ * Create new benchmark harness.
+ *
+ * @param inp Input parameters
+ * @return New harness
+ */
+gkyl_bench* gkyl_bench_new(const struct gkyl_bench_inp *inp);
+
+/**
+ * Parse the command line of a benchmark program into the input of the
+ * harness. Options are -b <baseline>, -o <output>, -f <filter>, -t
+ * <threshold> and -m <min-time>. Strings point into argv.
+ *
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return Harness input
+ */
+struct gkyl_bench_inp gkyl_bench_parse_args(int argc, char **argv);
+
+/**
+ * Check if a benchmark would run, i.e. it passes the filter. Use this
+ * to skip the setup of benchmarks that would not run.
+ *
+ * @param bench Harness
+ * @param name Name of benchmark
+ * @return True if benchmark would run
+ */
+bool gkyl_bench_enabled(const gkyl_bench *bench, const char *name);
+
+/**
+ * Estimate the FLOPs of a kernel that is linear in its input (with
+ * other inputs held fixed), such as a DG volume or surface kernel. The
+ * kernel is applied to each unit vector of its input to find the
+ * number of non-zero entries of the matrix it applies, and two FLOPs
+ * (a multiply and an add) are counted for each. Generated kernels that
+ * factor out common terms can do fewer.
+ *
+ * @param func Kernel: must overwrite all nout entries of out
+ * @param ctx Context passed to func
+ * @param nin Number of inputs
+ * @param nout Number of outputs
+ * @return Estimated FLOPs per call
+ */
+double gkyl_bench_linear_flops(gkyl_bench_linear_func_t func, void *ctx, int nin, int nout);
+
+/**
+ * Time a function and report the result. The function is called
+ * repeatedly until min_time has elapsed, and the best of three such
+ * trials is reported, so the function must be safe to call more than
+ * once on the same data.
+ *
+ * @param bench Harness
+ * @param name Unique name of benchmark (no white space)
+ * @param func Function to benchmark
+ * @param ctx Context passed to func
+ * @param ncells Number of cells func updates per call
+ * @param work Work per cell
+ * @return Time per cell in nanoseconds (0 if the benchmark did not run)
+ */
+double gkyl_bench_run(gkyl_bench *bench, const char *name,
+  gkyl_bench_func_t func, void *ctx, long ncells, struct gkyl_bench_work work);
+
+/**
+ * Number of benchmarks that were slower than the baseline by more than
+ * the threshold.
+ *
+ * @param bench Harness
+ * @return Number of regressions
+ */
+int gkyl_bench_num_regressions(const gkyl_bench *bench);
+
+/**
+ * Write the results to the output file (if any), print a summary and
+ * release the harness.
+ *
+ * @param bench Harness to release
+ * @return Number of regressions
+ */
+int gkyl_bench_release(gkyl_bench *bench);
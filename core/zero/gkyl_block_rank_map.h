@@ -0,0 +1,95 @@
+#pragma once
+
+#include <gkyl_block_topo.h>
+
+#include <stdbool.h>
+
+// Inputs to construct a cost-balanced block-to-rank map
+struct gkyl_block_rank_map_inp {
+  // Block topology: used to co-locate connected blocks on a rank when
+  // doing so does not increase the maximum per-rank cost. May be NULL.
+  const struct gkyl_block_topo *topo;
+
+  int ndim; // dimension of blocks
+  int num_blocks; // number of blocks
+  int num_ranks; // number of ranks to distribute blocks over
+
+  // Number of cells in each direction of each block: cells[b*ndim+d]
+  // is the number of cells in direction d of block b.
+  const int *cells;
+  // Optional measured cost of each block (e.g. time per step). If
+  // NULL, the cost of a block is proportional to its number of cells.
+  const double *cost;
+
+  // Directions in which blocks may not be cut (e.g. the app only
+  // supports decomposition along some directions). By default blocks
+  // may be cut in every direction.
+  bool uncut_dirs[GKYL_MAX_DIM];
+  // If true, only cuts that divide the cells of a block evenly are
+  // used (e.g. the app gathers the pieces of a block with
+  // gkyl_comm_array_allgather, which needs pieces of the same size).
+  bool even_cuts;
+};
+
+// Block-to-rank map: each block is cut into one or more pieces, each
+// handled by a different rank. A rank may handle pieces of several
+// blocks.
+struct gkyl_block_rank_map {
+  int ndim; // dimension of blocks
+  int num_blocks; // number of blocks in map
+  int total_ranks; // total number of ranks in map
+
+  double max_cost; // maximum cost on any rank
+  double avg_cost; // average cost per rank
+};
+
+/**
+ * Create a new block-to-rank map. The number of ranks handling each
+ * block, and the cuts of each block, are chosen to minimize the
+ * maximum cost on any rank. Amongst cuts with the same cost, those
+ * with the smallest halo volume between the pieces of a block are
+ * used. Every rank handles at least one piece. Returns NULL if the
+ * blocks can't be cut, in the directions that may be cut (and evenly
+ * if requested), into enough pieces to be distributed over all ranks.
+ *
+ * @param inp Input parameters
+ * @return New block-to-rank map
+ */
+const struct gkyl_block_rank_map* gkyl_block_rank_map_new(const struct gkyl_block_rank_map_inp *inp);
+
+/**
+ * Get number of ranks in block @a bn.
+ *
+ * @param brm Block-to-rank map
+ * @param bn Block number
+ * @return Number of ranks in block @a bn
+ */
+int gkyl_block_rank_map_nranks(const struct gkyl_block_rank_map *brm, int bn);
+
+/**
+ * Get the list of ranks in block @a bn. The ranks are returned in @a
+ * ranks, which must be big enough to store the list. The i-th rank
+ * handles the i-th sub-range of the decomposition of the block made
+ * with the cuts returned by gkyl_block_rank_map_getcuts.
+ *
+ * @param brm Block-to-rank map
+ * @param bn Block number for which to fetch rank list
+ * @param ranks On output, list of ranks in block @a bn
+ */
+void gkyl_block_rank_map_getranks(const struct gkyl_block_rank_map *brm, int bn, int ranks[]);
+
+/**
+ * Get the cuts of block @a bn.
+ *
+ * @param brm Block-to-rank map
+ * @param bn Block number for which to fetch cuts
+ * @param cuts On output, number of cuts in each direction
+ */
+void gkyl_block_rank_map_getcuts(const struct gkyl_block_rank_map *brm, int bn, int cuts[]);
+
+/**
+ * Release block-to-rank map.
+ *
+ * @param brm Block-to-rank map to release
+ */
+void gkyl_block_rank_map_release(const struct gkyl_block_rank_map *brm);
@@ -37,6 +37,10 @@ struct gkyl_nmat {
   struct  gkyl_nmat *on_dev; // pointer to itself or device data
 };
 
+// Default number of cells in a tile for updaters that assemble and
+// solve per-cell linear systems in batches, reusing a tile-sized nmat
+#define GKYL_NMAT_TILE_CELLS 256
+
 // Type for storing preallocating memory needed in various batch
 // operations
 typedef struct gkyl_nmat_mem gkyl_nmat_mem;
@@ -410,6 +414,20 @@ bool gkyl_nmat_linsolve_lu(struct gkyl_nmat *A, struct gkyl_nmat *x);
  */
 bool gkyl_nmat_linsolve_lu_pa(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nmat *x);
 
+/**
+ * Same as gkyl_nmat_linsolve_lu_pa, except only the first @a num
+ * systems in the batch are solved. This allows a fixed-size batch to
+ * be reused as a workspace for partially filled batches. Only
+ * supported on host.
+ *
+ * @param mem Preallocated memory needed in the solve
+ * @param num Number of systems to solve (at most A->num)
+ * @param A list of LHS matrices, replaced by LU factors on return
+ * @param x list of RHS vectors, replace by solution in exit.
+ */
+bool gkyl_nmat_linsolve_lu_pa_num(gkyl_nmat_mem *mem, size_t num,
+  struct gkyl_nmat *A, struct gkyl_nmat *x);
+
 /**
  * Release multi-matrix
  *
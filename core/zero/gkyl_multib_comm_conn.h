@@ -100,6 +100,52 @@ struct gkyl_multib_comm_conn *gkyl_multib_comm_conn_new_recv_from_connections(
   int nconnected, int* block_list, int dir,
   struct gkyl_rect_decomp **decomp);
 
+/**
+ * Construct the send communication connections for a rank to gather
+ * its slab of the blocks connected along a direction. The slab of a
+ * rank is the part of the multib range spanning the connected blocks
+ * (see gkyl_multib_comm_conn_create_multib_ranges_in_dir) that has
+ * the same extents as the rank's range in the slab directions. Unlike
+ * gkyl_multib_comm_conn_new_send_from_connections, only the part of
+ * our range lying in the slab of each target rank is sent. The ranges
+ * in the connections are in the index space of the block.
+ *
+ * @param block_id ID of block
+ * @param block_rank Local rank in block
+ * @param nconnected Number of blocks including self connected along direction
+ * @param block list Ordered (based on topology) list of connected block ids (including self)
+ * @param dir direction in which blocks are connected
+ * @param num_slab_dirs Number of slab directions
+ * @param slab_dirs Directions (other than dir) in which the slab is restricted
+ * @param decomp List of decomposition objects for each block
+ * @return New communication connection object for sends
+ */
+struct gkyl_multib_comm_conn *gkyl_multib_comm_conn_new_send_slab_from_connections(
+  int block_id, int block_rank, const int *nghost,
+  int nconnected, int* block_list, int dir,
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_rect_decomp **decomp);
+
+/**
+ * Construct the recv communication connections for a rank to gather
+ * its slab of the blocks connected along a direction (see
+ * gkyl_multib_comm_conn_new_send_slab_from_connections). The ranges
+ * in the connections are in the index space of the multib range.
+ *
+ * @param block_id ID of block
+ * @param block_rank Local rank in block
+ * @param nconnected Number of blocks including self connected along direction
+ * @param block list Ordered (based on topology) list of connected block ids (including self)
+ * @param dir direction in which blocks are connected
+ * @param num_slab_dirs Number of slab directions
+ * @param slab_dirs Directions (other than dir) in which the slab is restricted
+ * @param decomp List of decomposition objects for each block
+ * @return New communication connection object for recvs
+ */
+struct gkyl_multib_comm_conn *gkyl_multib_comm_conn_new_recv_slab_from_connections(
+  int block_id, int block_rank, const int *nghost,
+  int nconnected, int* block_list, int dir,
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_rect_decomp **decomp);
+
 /**
  * Transfer data from 'ain' and to 'aout' according to connections in
  * 'mbcc_send' and 'mbcc_recv'.
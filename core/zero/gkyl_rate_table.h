@@ -0,0 +1,183 @@
+#pragma once
+
+#include <math.h>
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_grid.h>
+#include <gkyl_ref_count.h>
+#include <gkyl_util.h>
+
+// Interpolation used to evaluate a rate table.
+enum gkyl_rate_table_interp {
+  GKYL_RATE_TABLE_BILINEAR = 0, // Bilinear (default; same as the p=1 DG representation).
+  GKYL_RATE_TABLE_BICUBIC, // Bicubic (Catmull-Rom) with linearly extrapolated edge nodes.
+};
+
+// Input to create a new reaction-rate table.
+struct gkyl_rate_table_inp {
+  int num_temp, num_den; // Number of nodes in log10(T) and log10(n).
+  double log_temp_min, log_temp_max; // Range of log10(T) covered by the table.
+  double log_den_min, log_den_max; // Range of log10(n) covered by the table.
+  const double *log_rate; // log10(rate) at the nodes (num_temp x num_den, density varies fastest).
+};
+
+// Reaction rate (or any other coefficient) tabulated on a uniform
+// (log10(T), log10(n)) grid, e.g. from ADAS.
+struct gkyl_rate_table {
+  int num_temp, num_den; // Number of nodes in log10(T) and log10(n).
+  double log_temp_min, log_temp_max, dlog_temp; // log10(T) nodes.
+  double log_den_min, log_den_max, dlog_den; // log10(n) nodes.
+  double *log_rate; // log10(rate) at the nodes (density varies fastest).
+
+  // p=1 DG representation of the table, with the nodes at cell corners, for
+  // updaters that evaluate it in device kernels.
+  struct gkyl_rect_grid grid; // Grid in (log10(T), log10(n)).
+  struct gkyl_range range, range_ext; // Range (w/o and w/ ghosts) of grid.
+  struct gkyl_basis basis; // 2D p=1 serendipity basis.
+  struct gkyl_array *modal; // DG coefficients, defined on range_ext (host memory).
+
+  char *name; // Name the table is cached under (NULL if not cached).
+  struct gkyl_ref_count ref_count;
+};
+
+/**
+ * Create a new rate table. If a name is given the table is added to a
+ * process-wide cache, so that other updaters needing the same table can
+ * get it with gkyl_rate_table_cache_find instead of reading and projecting
+ * it again. The table is removed from the cache once it is released by all
+ * its users.
+ *
+ * @param inp Table data.
+ * @param name Name to cache the table under (NULL to not cache it).
+ * @return New rate table.
+ */
+struct gkyl_rate_table* gkyl_rate_table_new(const struct gkyl_rate_table_inp *inp,
+  const char *name);
+
+/**
+ * Find a table in the process-wide cache. The returned table must be
+ * released with gkyl_rate_table_release.
+ *
+ * @param name Name of the table.
+ * @return Acquired pointer to the table, or NULL if it is not in the cache.
+ */
+struct gkyl_rate_table* gkyl_rate_table_cache_find(const char *name);
+
+/**
+ * Evaluate log10 of the rate at a given log10(T) and log10(n) using
+ * bilinear interpolation. Values outside the table are clamped to its
+ * edges. This is equivalent to evaluating the p=1 DG representation of
+ * the table.
+ *
+ * @param tab Rate table.
+ * @param log_temp log10 of the temperature.
+ * @param log_den log10 of the density.
+ * @return log10 of the rate.
+ */
+static inline double
+gkyl_rate_table_eval_log(const struct gkyl_rate_table *tab, double log_temp, double log_den)
+{
+  double xt = (fmin(fmax(log_temp, tab->log_temp_min), tab->log_temp_max) - tab->log_temp_min)/tab->dlog_temp;
+  double xn = (fmin(fmax(log_den, tab->log_den_min), tab->log_den_max) - tab->log_den_min)/tab->dlog_den;
+  int it = GKYL_MIN2((int) xt, tab->num_temp-2);
+  int in = GKYL_MIN2((int) xn, tab->num_den-2);
+  double at = xt-it, an = xn-in;
+
+  const double *r = tab->log_rate + it*tab->num_den + in;
+  return (1.0-at)*((1.0-an)*r[0] + an*r[1]) + at*((1.0-an)*r[tab->num_den] + an*r[tab->num_den+1]);
+}
+
+// Catmull-Rom weights of the four nodes around a point a fraction a of
+// the way between the middle two.
+static inline void
+rate_table_cubic_weights(double a, double w[4])
+{
+  double a2 = a*a, a3 = a2*a;
+  w[0] = 0.5*(-a3 + 2.0*a2 - a);
+  w[1] = 0.5*(3.0*a3 - 5.0*a2 + 2.0);
+  w[2] = 0.5*(-3.0*a3 + 4.0*a2 + a);
+  w[3] = 0.5*(a3 - a2);
+}
+
+// Node (it, in) of the table, with nodes one past the edges linearly
+// extrapolated from the two nearest ones.
+static inline double
+rate_table_node(const struct gkyl_rate_table *tab, int it, int in)
+{
+  if (it < 0)
+    return 2.0*rate_table_node(tab, 0, in) - rate_table_node(tab, 1, in);
+  if (it > tab->num_temp-1)
+    return 2.0*rate_table_node(tab, tab->num_temp-1, in) - rate_table_node(tab, tab->num_temp-2, in);
+  if (in < 0)
+    return 2.0*tab->log_rate[it*tab->num_den] - tab->log_rate[it*tab->num_den+1];
+  if (in > tab->num_den-1)
+    return 2.0*tab->log_rate[it*tab->num_den+tab->num_den-1] - tab->log_rate[it*tab->num_den+tab->num_den-2];
+  return tab->log_rate[it*tab->num_den+in];
+}
+
+/**
+ * Evaluate log10 of the rate at a given log10(T) and log10(n) using
+ * bicubic (Catmull-Rom) interpolation, which is smooth across table
+ * nodes. Values outside the table are clamped to its edges.
+ *
+ * @param tab Rate table.
+ * @param log_temp log10 of the temperature.
+ * @param log_den log10 of the density.
+ * @return log10 of the rate.
+ */
+static inline double
+gkyl_rate_table_eval_log_bicubic(const struct gkyl_rate_table *tab, double log_temp, double log_den)
+{
+  double xt = (fmin(fmax(log_temp, tab->log_temp_min), tab->log_temp_max) - tab->log_temp_min)/tab->dlog_temp;
+  double xn = (fmin(fmax(log_den, tab->log_den_min), tab->log_den_max) - tab->log_den_min)/tab->dlog_den;
+  int it = GKYL_MIN2((int) xt, tab->num_temp-2);
+  int in = GKYL_MIN2((int) xn, tab->num_den-2);
+
+  double wt[4], wn[4];
+  rate_table_cubic_weights(xt-it, wt);
+  rate_table_cubic_weights(xn-in, wn);
+
+  double val = 0.0;
+  for (int i=0; i<4; ++i) {
+    double row = 0.0;
+    for (int j=0; j<4; ++j)
+      row += wn[j]*rate_table_node(tab, it-1+i, in-1+j);
+    val += wt[i]*row;
+  }
+  return val;
+}
+
+/**
+ * Evaluate log10 of the rate in every cell of a range, for arrays of
+ * log10(T) and log10(n) values (e.g. at the nodes or quadrature points
+ * of each cell). Component k of log_rate is computed from component k
+ * of log_temp and log_den.
+ *
+ * @param tab Rate table.
+ * @param interp Interpolation to use.
+ * @param range Range of cells to evaluate in.
+ * @param log_temp log10 of the temperature (same number of components as log_rate).
+ * @param log_den log10 of the density (same number of components as log_rate).
+ * @param log_rate On output, log10 of the rate.
+ */
+void gkyl_rate_table_eval_log_array(const struct gkyl_rate_table *tab,
+  enum gkyl_rate_table_interp interp, const struct gkyl_range *range,
+  const struct gkyl_array *log_temp, const struct gkyl_array *log_den,
+  struct gkyl_array *log_rate);
+
+/**
+ * Acquire pointer to rate table. Delete using gkyl_rate_table_release.
+ *
+ * @param tab Rate table.
+ * @return Acquired pointer.
+ */
+struct gkyl_rate_table* gkyl_rate_table_acquire(const struct gkyl_rate_table *tab);
+
+/**
+ * Release rate table.
+ *
+ * @param tab Rate table to release.
+ */
+void gkyl_rate_table_release(const struct gkyl_rate_table *tab);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <gkyl_array.h>
 #include <gkyl_range.h>
 #include <gkyl_rect_grid.h>
 #include <gkyl_ref_count.h>
@@ -38,6 +39,27 @@ struct gkyl_rect_decomp_neigh {
 struct gkyl_rect_decomp* gkyl_rect_decomp_new_from_cuts(int ndim, const int cuts[],
   const struct gkyl_range *range);
 
+/**
+ * Create a new decomposition of @a range, given @a cuts in each
+ * direction, such that the total @a cost in each decomposed range is
+ * roughly the same. The ranges are found by recursive bisection:
+ * each step splits the direction with the most cuts left at the
+ * position that best divides the cost in proportion to the cuts on
+ * either side. Decomposed ranges are rectangular but, unlike those from
+ * gkyl_rect_decomp_new_from_cuts, do not in general form a tensor
+ * product of 1D cuts, unless only one direction is cut. Range i is the
+ * one with cut index given by the row-major linear index i into @a
+ * cuts.
+ *
+ * @param ndim Number of dimensions
+ * @param cuts Cuts in each direction.
+ * @param range Range to decompose
+ * @param cost Cost of each cell (one component, indexed using @a range)
+ * @return Decomposition of @a range
+ */
+struct gkyl_rect_decomp* gkyl_rect_decomp_new_from_cuts_and_cost(int ndim,
+  const int cuts[], const struct gkyl_range *range, const struct gkyl_array *cost);
+
 /**
  * Create a new decomposition given @a cuts and cells in each
  * direction. The total number of decomposed ranges are product of all
@@ -51,6 +73,38 @@ struct gkyl_rect_decomp* gkyl_rect_decomp_new_from_cuts(int ndim, const int cuts
 struct gkyl_rect_decomp *gkyl_rect_decomp_new_from_cuts_and_cells(int ndim,
   const int cuts[], const int cells[]);
 
+/**
+ * Create a new decomposition of @a range that follows a given
+ * decomposition, e.g. to read a file written on a different grid with
+ * the same (possibly cost-weighted) partitioning as the app. Direction
+ * d of @a range corresponds to direction dirs[d] of @a decomp, or is
+ * not decomposed if dirs[d] is -1. Region boundaries are scaled by the
+ * ratio of cells in the two directions, so region n covers the same
+ * part of the domain as region n of @a decomp. No region may become
+ * empty, i.e. @a range must not be coarser than the narrowest region.
+ *
+ * @param decomp Decomposition to follow
+ * @param dirs Direction of @a decomp corresponding to each direction of @a range
+ * @param range Range to decompose
+ * @return Decomposition of @a range
+ */
+struct gkyl_rect_decomp *gkyl_rect_decomp_new_from_decomp(const struct gkyl_rect_decomp *decomp,
+  const int *dirs, const struct gkyl_range *range);
+
+/**
+ * Create a new decomposition of @a range from a list of ranges,
+ * e.g. the local ranges of a subset of the ranks of a communicator
+ * restricted to a surface. The ranges are copied, and must cover @a
+ * range without overlapping (not checked).
+ *
+ * @param ndecomp Number of ranges
+ * @param ranges Decomposed ranges
+ * @param range Range that is decomposed
+ * @return Decomposition of @a range
+ */
+struct gkyl_rect_decomp *gkyl_rect_decomp_new_from_ranges(int ndecomp,
+  const struct gkyl_range *ranges, const struct gkyl_range *range);
+
 /**
  * Create a new decomposition from a given decomposition. The new
  * decomposition extends each region by a tensor product with @a
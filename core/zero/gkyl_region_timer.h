@@ -0,0 +1,123 @@
+#pragma once
+
+#include <gkyl_comm.h>
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// Hardware counters measured in each region, if available.
+enum gkyl_region_timer_counter {
+  GKYL_RTIMER_CYCLES = 0, // CPU cycles
+  GKYL_RTIMER_INSTRUCTIONS, // instructions retired
+  GKYL_RTIMER_CACHE_MISSES, // last-level cache misses
+  GKYL_RTIMER_NUM_COUNTERS,
+};
+
+// Totals of a region, and its hardware counters.
+struct gkyl_region_timer_stat {
+  long ncalls; // number of times region was entered
+  double tm; // total time in region (including sub-regions)
+  double self_tm; // time not in any sub-region
+  long counters[GKYL_RTIMER_NUM_COUNTERS]; // counter totals (if available)
+};
+
+/** Object type */
+typedef struct gkyl_region_timer gkyl_region_timer;
+
+/**
+ * Create new hierarchical region timer. Regions are entered and left
+ * with gkyl_region_timer_begin/end, and regions entered inside another
+ * one are its sub-regions. A region is identified by its path, the
+ * names of its enclosing regions and its own joined with '/'
+ * (e.g. "time_loop/field"). The timer is not thread-safe: use it from
+ * one thread only.
+ *
+ * If use_counters is true, the cycles, instructions and last-level
+ * cache misses of the calling thread are also measured in each region,
+ * using Linux perf events. If the events can't be opened (other OS, no
+ * PMU, or not permitted by perf_event_paranoid) only times are
+ * measured. Counters cost a system call at each begin/end, so only
+ * enable them when profiling.
+ *
+ * @param use_counters Measure hardware counters
+ * @return New region timer
+ */
+gkyl_region_timer* gkyl_region_timer_new(bool use_counters);
+
+/**
+ * Check if hardware counters are measured.
+ *
+ * @param rt Region timer
+ * @return True if counters are measured
+ */
+bool gkyl_region_timer_has_counters(const gkyl_region_timer *rt);
+
+/**
+ * Enter a sub-region of the current region.
+ *
+ * @param rt Region timer
+ * @param name Name of region (without '/')
+ */
+void gkyl_region_timer_begin(gkyl_region_timer *rt, const char *name);
+
+/**
+ * Leave the current region.
+ *
+ * @param rt Region timer
+ */
+void gkyl_region_timer_end(gkyl_region_timer *rt);
+
+/**
+ * Get totals of a region. All zero if region was never entered.
+ *
+ * @param rt Region timer
+ * @param path Full path of region
+ * @return Region totals
+ */
+struct gkyl_region_timer_stat gkyl_region_timer_get(const gkyl_region_timer *rt,
+  const char *path);
+
+/**
+ * Get the total time of all regions with the given name, at any
+ * depth. Regions nested in a region of the same name are not counted
+ * twice.
+ *
+ * @param rt Region timer
+ * @param name Name of region (last component of path)
+ * @return Total time in seconds
+ */
+double gkyl_region_timer_sum(const gkyl_region_timer *rt, const char *name);
+
+/**
+ * Write region totals as JSON, with the min, max and average over the
+ * ranks of comm. The regions must be the same on all ranks (as they
+ * are in an SPMD code); otherwise only the values of rank 0 are
+ * written and "consistent" is false. Collective on comm; only rank 0
+ * writes.
+ *
+ * @param rt Region timer
+ * @param comm Communicator
+ * @param fp File to write to (only used on rank 0)
+ */
+void gkyl_region_timer_write_json(const gkyl_region_timer *rt, struct gkyl_comm *comm,
+  FILE *fp);
+
+/**
+ * Write the average (over the ranks of comm) self time of each region
+ * in microseconds, in the folded-stack format read by flame-graph
+ * tools: one "a;b;c <value>" line per region. Same requirements as
+ * gkyl_region_timer_write_json.
+ *
+ * @param rt Region timer
+ * @param comm Communicator
+ * @param fp File to write to (only used on rank 0)
+ */
+void gkyl_region_timer_write_folded(const gkyl_region_timer *rt, struct gkyl_comm *comm,
+  FILE *fp);
+
+/**
+ * Release region timer.
+ *
+ * @param rt Region timer to release.
+ */
+void gkyl_region_timer_release(gkyl_region_timer *rt);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <gkyl_job_pool.h>
+
+// Object type
+typedef struct gkyl_task_graph gkyl_task_graph;
+
+/**
+ * Create a new, empty task graph. A task graph is a set of jobs with
+ * dependencies between them: a job only starts once all the jobs it
+ * depends on have finished, but it does not wait for any other
+ * job. Tasks are added with gkyl_task_graph_add and the whole graph
+ * is executed with gkyl_task_graph_run.
+ *
+ * @return New task graph
+ */
+gkyl_task_graph* gkyl_task_graph_new(void);
+
+/**
+ * Add a task to the graph. The dependencies must be tasks that were
+ * already added, so that the graph is always acyclic.
+ *
+ * @param tg Task graph
+ * @param func Function that does the work
+ * @param ctx Context object to pass to func
+ * @param ndeps Number of tasks this task depends on
+ * @param deps IDs of tasks this task depends on (may contain -1
+ *   entries, which are ignored)
+ * @return ID of the new task
+ */
+int gkyl_task_graph_add(gkyl_task_graph *tg, jp_work_func func, void *ctx,
+  int ndeps, const int *deps);
+
+/**
+ * Number of tasks in the graph.
+ *
+ * @param tg Task graph
+ * @return Number of tasks
+ */
+int gkyl_task_graph_num_tasks(const gkyl_task_graph *tg);
+
+/**
+ * Run all tasks in the graph using the threads of a job pool, and
+ * return once all of them have finished. Each worker of the pool
+ * keeps its own queue of ready tasks: tasks that become ready when a
+ * worker finishes one of their dependencies are queued on that
+ * worker, and a worker with an empty queue steals from the other
+ * workers. Tasks without dependencies are dealt out round-robin, in
+ * the order they were added.
+ *
+ * The graph is not modified, so it can be run again.
+ *
+ * @param tg Task graph
+ * @param jp Job pool whose threads run the tasks
+ */
+void gkyl_task_graph_run(gkyl_task_graph *tg, const struct gkyl_job_pool *jp);
+
+/**
+ * Remove all tasks from the graph, so that it can be reused.
+ *
+ * @param tg Task graph
+ */
+void gkyl_task_graph_clear(gkyl_task_graph *tg);
+
+/**
+ * Release task graph.
+ *
+ * @param tg Task graph to release
+ */
+void gkyl_task_graph_release(gkyl_task_graph *tg);
@@ -10,3 +10,25 @@
  */
 struct gkyl_job_pool* gkyl_thread_pool_new(int nthreads);
 
+
+/**
+ * Create a new thread-pool object with workers pinned to CPUs. The
+ * jobs added between two calls to gkyl_job_pool_wait are dealt out
+ * round-robin: the i-th job always runs on worker i % nthreads. Hence
+ * a sweep that adds one job per range split runs each split on the
+ * same core every time, which is what first-touch placement of memory
+ * (see gkyl_array_numa_new) relies on.
+ *
+ * The affinity spec is one of "compact" (worker i on the i-th CPU in
+ * the process's affinity mask), "scatter" (the CPUs in the mask dealt
+ * round-robin over the sockets) or an explicit CPU list such as
+ * "0-7,16-23" (worker i on the i-th listed CPU). NULL is the same as
+ * "compact". Workers wrap around the list if there are more workers
+ * than CPUs. Pinning is only done on Linux; a worker that can't be
+ * pinned reports it on stderr and runs unpinned.
+ *
+ * @param nthreads Number of threads to create
+ * @param affinity Affinity spec (see above)
+ * @return Pointer to new job-pool object
+ */
+struct gkyl_job_pool* gkyl_thread_pool_pinned_new(int nthreads, const char *affinity);
@@ -575,13 +575,13 @@ gkyl_nmat_mv(double alpha, double beta, enum gkyl_mat_trans transa, struct gkyl_
 }
 
 
+// Solve the first num systems in the batch
 static bool
-ho_nmat_linsolve_lu(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nmat *x)
+ho_nmat_linsolve_lu_num(gkyl_nmat_mem *mem, size_t num, struct gkyl_nmat *A, struct gkyl_nmat *x)
 {
-  size_t num = A->num;
+  assert( num <= A->num );
   assert( num <= x->num );
   assert(mem->on_gpu == false);
-  assert(mem->num == A->num);
   assert(mem->nrows == A->nr);
 
   bool status = true;
@@ -596,6 +596,13 @@ ho_nmat_linsolve_lu(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nmat *x
   return status;
 }
 
+static bool
+ho_nmat_linsolve_lu(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nmat *x)
+{
+  assert(mem->num == A->num);
+  return ho_nmat_linsolve_lu_num(mem, A->num, A, x);
+}
+
 static bool
 cu_nmat_linsolve_lu(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nmat *x)
 {
@@ -746,6 +753,14 @@ gkyl_nmat_linsolve_lu_pa(gkyl_nmat_mem *mem, struct gkyl_nmat *A, struct gkyl_nm
   return status;  
 }
 
+bool
+gkyl_nmat_linsolve_lu_pa_num(gkyl_nmat_mem *mem, size_t num,
+  struct gkyl_nmat *A, struct gkyl_nmat *x)
+{
+  assert(!gkyl_nmat_is_cu_dev(A) && !gkyl_nmat_is_cu_dev(x));
+  return ho_nmat_linsolve_lu_num(mem, num, A, x);
+}
+
 void
 gkyl_nmat_release(struct gkyl_nmat *mat)
 {
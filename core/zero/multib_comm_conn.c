@@ -332,6 +332,144 @@ gkyl_multib_comm_conn_new_recv_from_connections(
   return mbcc;
 }
 
+// Shift taking the index space of block bid into that of the multib
+// range spanning the blocks in block_list along dir.
+static void
+multib_shift_in_dir(int bid, int nconnected, const int *block_list, int dir,
+  struct gkyl_rect_decomp **decomp, int *delta)
+{
+  int ndim = decomp[0]->ndim;
+  for (int d=0; d<ndim; ++d)
+    delta[d] = 0;
+  for (int i=0; (i<nconnected) && (block_list[i] != bid); ++i)
+    delta[dir] += gkyl_range_shape(&decomp[block_list[i]]->parent_range, dir);
+}
+
+// Range with the extents of perp in the slab directions, and those of
+// rng in all other directions.
+static void
+multib_slab(struct gkyl_range *slab, const struct gkyl_range *rng,
+  const struct gkyl_range *perp, int num_slab_dirs, const int *slab_dirs)
+{
+  int lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM];
+  for (int d=0; d<rng->ndim; ++d) {
+    lower[d] = rng->lower[d];
+    upper[d] = rng->upper[d];
+  }
+  for (int i=0; i<num_slab_dirs; ++i) {
+    lower[slab_dirs[i]] = perp->lower[slab_dirs[i]];
+    upper[slab_dirs[i]] = perp->upper[slab_dirs[i]];
+  }
+  gkyl_range_init(slab, rng->ndim, lower, upper);
+}
+
+// public method to compute slab send connections from block list
+struct gkyl_multib_comm_conn *
+gkyl_multib_comm_conn_new_send_slab_from_connections(
+  int block_id, int block_rank, const int *nghost,
+  int nconnected, int* block_list, int dir,
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_rect_decomp **decomp)
+{
+  int max_sr_ranks = 0;
+  for (int i=0; i<nconnected; i++)
+    max_sr_ranks += decomp[block_list[i]]->ndecomp;
+
+  int comm_conn_idx = 0;
+  struct gkyl_comm_conn *comm_conn
+    = gkyl_malloc(sizeof(struct gkyl_comm_conn[max_sr_ranks]));
+
+  struct gkyl_range cross_range, cross_range_ext;
+  gkyl_multib_comm_conn_create_multib_ranges_in_dir(&cross_range_ext, &cross_range, nghost, nconnected, block_list, dir, decomp);
+
+  // Our rank's range shifted into the index space of the cross range.
+  int delta[GKYL_MAX_DIM], minus_delta[GKYL_MAX_DIM];
+  multib_shift_in_dir(block_id, nconnected, block_list, dir, decomp, delta);
+  for (int d=0; d<decomp[0]->ndim; ++d)
+    minus_delta[d] = -delta[d];
+  struct gkyl_range sub_range;
+  gkyl_range_shift(&sub_range, &decomp[block_id]->ranges[block_rank], delta);
+
+  // Each target rank only needs the part of our range inside its slab
+  // of the cross range.
+  for (int ib=0; ib<nconnected; ib++) {
+    int tar_bid = block_list[ib];
+    int tar_delta[GKYL_MAX_DIM];
+    multib_shift_in_dir(tar_bid, nconnected, block_list, dir, decomp, tar_delta);
+    for (int ir=0; ir<decomp[tar_bid]->ndecomp; ir++) {
+      struct gkyl_range tar_range, slab, irng;
+      gkyl_range_shift(&tar_range, &decomp[tar_bid]->ranges[ir], tar_delta);
+      multib_slab(&slab, &cross_range, &tar_range, num_slab_dirs, slab_dirs);
+      if (gkyl_range_intersect(&irng, &slab, &sub_range)) {
+        comm_conn[comm_conn_idx].sr = GKYL_COMM_CONN_SEND;
+        comm_conn[comm_conn_idx].src_edge = 0;
+        comm_conn[comm_conn_idx].tar_edge = 0;
+        comm_conn[comm_conn_idx].rank = ir;
+        comm_conn[comm_conn_idx].block_id = tar_bid;
+        gkyl_range_shift(&comm_conn[comm_conn_idx].range, &irng, minus_delta);
+        comm_conn_idx += 1;
+      }
+    }
+  }
+  struct gkyl_multib_comm_conn *mbcc =
+    gkyl_multib_comm_conn_new(comm_conn_idx, comm_conn);
+
+  gkyl_free(comm_conn);
+  
+  return mbcc;
+}
+
+// public method to compute slab recv connections from block list
+struct gkyl_multib_comm_conn *
+gkyl_multib_comm_conn_new_recv_slab_from_connections(
+  int block_id, int block_rank, const int *nghost,
+  int nconnected, int* block_list, int dir,
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_rect_decomp **decomp)
+{
+  int max_sr_ranks = 0;
+  for (int i=0; i<nconnected; i++)
+    max_sr_ranks += decomp[block_list[i]]->ndecomp;
+
+  int comm_conn_idx = 0;
+  struct gkyl_comm_conn *comm_conn
+    = gkyl_malloc(sizeof(struct gkyl_comm_conn[max_sr_ranks]));
+
+  struct gkyl_range cross_range, cross_range_ext;
+  gkyl_multib_comm_conn_create_multib_ranges_in_dir(&cross_range_ext, &cross_range, nghost, nconnected, block_list, dir, decomp);
+
+  // Our slab of the cross range.
+  int delta[GKYL_MAX_DIM];
+  multib_shift_in_dir(block_id, nconnected, block_list, dir, decomp, delta);
+  struct gkyl_range sub_range, slab;
+  gkyl_range_shift(&sub_range, &decomp[block_id]->ranges[block_rank], delta);
+  multib_slab(&slab, &cross_range, &sub_range, num_slab_dirs, slab_dirs);
+
+  for (int ib=0; ib<nconnected; ib++) {
+    int tar_bid = block_list[ib];
+    int tar_delta[GKYL_MAX_DIM];
+    multib_shift_in_dir(tar_bid, nconnected, block_list, dir, decomp, tar_delta);
+    for (int ir=0; ir<decomp[tar_bid]->ndecomp; ir++) {
+      struct gkyl_range tar_range;
+      gkyl_range_shift(&tar_range, &decomp[tar_bid]->ranges[ir], tar_delta);
+      struct gkyl_range irng;
+      if (gkyl_range_intersect(&irng, &slab, &tar_range)) {
+        comm_conn[comm_conn_idx].sr = GKYL_COMM_CONN_RECV;
+        comm_conn[comm_conn_idx].src_edge = 0;
+        comm_conn[comm_conn_idx].tar_edge = 0;
+        comm_conn[comm_conn_idx].rank = ir;
+        comm_conn[comm_conn_idx].block_id = tar_bid;
+        memcpy(&comm_conn[comm_conn_idx].range, &irng, sizeof(struct gkyl_range));
+        comm_conn_idx += 1;
+      }
+    }
+  }
+  struct gkyl_multib_comm_conn *mbcc =
+    gkyl_multib_comm_conn_new(comm_conn_idx, comm_conn);
+
+  gkyl_free(comm_conn);
+  
+  return mbcc;
+}
+
 struct gkyl_multib_comm_conn *
 gkyl_multib_comm_conn_new_send(
   int block_id, int block_rank, const int *nghost,
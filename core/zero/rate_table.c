@@ -0,0 +1,157 @@
+#include <pthread.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_nodal_ops.h>
+#include <gkyl_rate_table.h>
+#include <gkyl_rect_decomp.h>
+
+// Process-wide cache of named tables: a linked list, protected by a
+// mutex. Tables hold no reference to themselves through the cache, and
+// are removed from it when they are freed.
+struct rate_table_cache_node {
+  struct gkyl_rate_table *tab;
+  struct rate_table_cache_node *next;
+};
+
+static struct rate_table_cache_node *rate_table_cache = 0;
+static pthread_mutex_t rate_table_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void
+rate_table_free(const struct gkyl_ref_count *ref)
+{
+  struct gkyl_rate_table *tab = container_of(ref, struct gkyl_rate_table, ref_count);
+  gkyl_array_release(tab->modal);
+  gkyl_free(tab->log_rate);
+  if (tab->name)
+    gkyl_free(tab->name);
+  gkyl_free(tab);
+}
+
+struct gkyl_rate_table*
+gkyl_rate_table_new(const struct gkyl_rate_table_inp *inp, const char *name)
+{
+  struct gkyl_rate_table *tab = gkyl_malloc(sizeof(*tab));
+
+  tab->num_temp = inp->num_temp;
+  tab->num_den = inp->num_den;
+  tab->log_temp_min = inp->log_temp_min;
+  tab->log_temp_max = inp->log_temp_max;
+  tab->log_den_min = inp->log_den_min;
+  tab->log_den_max = inp->log_den_max;
+  tab->dlog_temp = (inp->log_temp_max - inp->log_temp_min)/(inp->num_temp-1);
+  tab->dlog_den = (inp->log_den_max - inp->log_den_min)/(inp->num_den-1);
+
+  long sz = inp->num_temp*inp->num_den;
+  tab->log_rate = gkyl_malloc(sizeof(double[sz]));
+  memcpy(tab->log_rate, inp->log_rate, sizeof(double[sz]));
+
+  // p=1 DG representation, with the nodes at the cell corners.
+  gkyl_rect_grid_init(&tab->grid, 2,
+    (double[]) { tab->log_temp_min, tab->log_den_min },
+    (double[]) { tab->log_temp_max, tab->log_den_max },
+    (int[]) { tab->num_temp-1, tab->num_den-1 }
+  );
+  gkyl_create_grid_ranges(&tab->grid, (int[]) { 1, 1 }, &tab->range_ext, &tab->range);
+  gkyl_cart_modal_serendip(&tab->basis, 2, 1);
+
+  struct gkyl_range nodal_range;
+  gkyl_range_init_from_shape(&nodal_range, 2, (int[]) { tab->num_temp, tab->num_den });
+  struct gkyl_array *nodal = gkyl_array_new(GKYL_DOUBLE, 1, sz);
+  memcpy(nodal->data, tab->log_rate, sizeof(double[sz]));
+
+  tab->modal = gkyl_array_new(GKYL_DOUBLE, tab->basis.num_basis, tab->range_ext.volume);
+  struct gkyl_nodal_ops *n2m = gkyl_nodal_ops_new(&tab->basis, &tab->grid, false);
+  gkyl_nodal_ops_n2m(n2m, &tab->basis, &tab->grid, &nodal_range, &tab->range, 1, nodal, tab->modal);
+  gkyl_nodal_ops_release(n2m);
+  gkyl_array_release(nodal);
+
+  tab->name = 0;
+  tab->ref_count = gkyl_ref_count_init(rate_table_free);
+
+  if (name) {
+    tab->name = gkyl_malloc(strlen(name)+1);
+    strcpy(tab->name, name);
+
+    struct rate_table_cache_node *node = gkyl_malloc(sizeof(*node));
+    node->tab = tab;
+    pthread_mutex_lock(&rate_table_cache_lock);
+    node->next = rate_table_cache;
+    rate_table_cache = node;
+    pthread_mutex_unlock(&rate_table_cache_lock);
+  }
+
+  return tab;
+}
+
+struct gkyl_rate_table*
+gkyl_rate_table_cache_find(const char *name)
+{
+  struct gkyl_rate_table *tab = 0;
+  pthread_mutex_lock(&rate_table_cache_lock);
+  for (struct rate_table_cache_node *node = rate_table_cache; node; node = node->next) {
+    if (strcmp(node->tab->name, name) == 0) {
+      tab = node->tab;
+      gkyl_ref_count_inc(&tab->ref_count);
+      break;
+    }
+  }
+  pthread_mutex_unlock(&rate_table_cache_lock);
+  return tab;
+}
+
+void
+gkyl_rate_table_eval_log_array(const struct gkyl_rate_table *tab,
+  enum gkyl_rate_table_interp interp, const struct gkyl_range *range,
+  const struct gkyl_array *log_temp, const struct gkyl_array *log_den,
+  struct gkyl_array *log_rate)
+{
+  int nc = log_rate->ncomp;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, range);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(range, iter.idx);
+    const double *lt = gkyl_array_cfetch(log_temp, loc);
+    const double *ln = gkyl_array_cfetch(log_den, loc);
+    double *lr = gkyl_array_fetch(log_rate, loc);
+
+    if (interp == GKYL_RATE_TABLE_BICUBIC) {
+      for (int k=0; k<nc; ++k)
+        lr[k] = gkyl_rate_table_eval_log_bicubic(tab, lt[k], ln[k]);
+    }
+    else {
+      for (int k=0; k<nc; ++k)
+        lr[k] = gkyl_rate_table_eval_log(tab, lt[k], ln[k]);
+    }
+  }
+}
+
+struct gkyl_rate_table*
+gkyl_rate_table_acquire(const struct gkyl_rate_table *tab)
+{
+  pthread_mutex_lock(&rate_table_cache_lock);
+  gkyl_ref_count_inc(&tab->ref_count);
+  pthread_mutex_unlock(&rate_table_cache_lock);
+  return (struct gkyl_rate_table*) tab;
+}
+
+void
+gkyl_rate_table_release(const struct gkyl_rate_table *tab)
+{
+  // The count is changed under the cache lock so that a table can't be
+  // found in the cache while it is being freed.
+  pthread_mutex_lock(&rate_table_cache_lock);
+  if (tab->ref_count.count == 1 && tab->name) {
+    struct rate_table_cache_node **prev = &rate_table_cache;
+    for (struct rate_table_cache_node *node = rate_table_cache; node; node = node->next) {
+      if (node->tab == tab) {
+        *prev = node->next;
+        gkyl_free(node);
+        break;
+      }
+      prev = &node->next;
+    }
+  }
+  gkyl_ref_count_dec(&tab->ref_count);
+  pthread_mutex_unlock(&rate_table_cache_lock);
+}
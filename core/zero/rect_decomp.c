@@ -4,6 +4,9 @@
 #include <gkyl_rect_decomp.h>
 #include <gkyl_util.h>
 
+#include <assert.h>
+#include <float.h>
+#include <math.h>
 #include <string.h>
 
 // define container to store vector of ints
@@ -94,6 +97,108 @@ gkyl_rect_decomp_new_from_cuts(int ndim, const int cuts[], const struct gkyl_ran
   return decomp;
 }
 
+// Recursively bisect the box [lower, upper] of range, which is to be
+// split into cnt[d] pieces in each direction, the first of which has
+// cut index coff.
+static void
+rect_decomp_bisect(struct gkyl_rect_decomp *decomp, const struct gkyl_range *rcuts,
+  const struct gkyl_range *range, const struct gkyl_array *cost,
+  const int *lower, const int *upper, const int *coff, const int *cnt)
+{
+  int ndim = range->ndim;
+
+  // Bisect direction with most cuts left (longest one on ties).
+  int dir = -1;
+  for (int d=0; d<ndim; ++d) {
+    if (cnt[d] > 1) {
+      if (dir < 0 || cnt[d] > cnt[dir] ||
+        (cnt[d] == cnt[dir] && upper[d]-lower[d] > upper[dir]-lower[dir]))
+        dir = d;
+    }
+  }
+
+  if (dir < 0) {
+    gkyl_range_init(&decomp->ranges[gkyl_range_idx(rcuts, coff)], ndim, lower, upper);
+    return;
+  }
+
+  int len = upper[dir]-lower[dir]+1;
+  assert(len >= cnt[dir]);
+
+  // Cost profile along dir.
+  double *prof = gkyl_malloc(sizeof(double[len]));
+  for (int i=0; i<len; ++i) prof[i] = 0.0;
+
+  struct gkyl_range box;
+  gkyl_sub_range_init(&box, range, lower, upper);
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &box);
+  while (gkyl_range_iter_next(&iter)) {
+    const double *c = gkyl_array_cfetch(cost, gkyl_range_idx(&box, iter.idx));
+    prof[iter.idx[dir]-lower[dir]] += c[0];
+  }
+
+  double total = 0.0;
+  for (int i=0; i<len; ++i) total += prof[i];
+
+  // Split after the cell that best matches the cost fraction of the
+  // lower part, leaving at least one cell per cut on each side.
+  int c1 = cnt[dir]/2, c2 = cnt[dir]-c1;
+  double target = total*c1/cnt[dir];
+  double acc = 0.0, best_diff = DBL_MAX;
+  int split = c1-1;
+  for (int i=0; i<len-c2; ++i) {
+    acc += prof[i];
+    if (i >= c1-1 && fabs(acc-target) < best_diff) {
+      best_diff = fabs(acc-target);
+      split = i;
+    }
+  }
+  gkyl_free(prof);
+
+  int sub_upper[GKYL_MAX_DIM], sub_lower[GKYL_MAX_DIM];
+  int sub_coff[GKYL_MAX_DIM], sub_cnt[GKYL_MAX_DIM];
+  for (int d=0; d<ndim; ++d) {
+    sub_lower[d] = lower[d]; sub_upper[d] = upper[d];
+    sub_coff[d] = coff[d]; sub_cnt[d] = cnt[d];
+  }
+
+  sub_upper[dir] = lower[dir]+split;
+  sub_cnt[dir] = c1;
+  rect_decomp_bisect(decomp, rcuts, range, cost, lower, sub_upper, coff, sub_cnt);
+
+  sub_lower[dir] = lower[dir]+split+1;
+  sub_coff[dir] = coff[dir]+c1;
+  sub_cnt[dir] = c2;
+  rect_decomp_bisect(decomp, rcuts, range, cost, sub_lower, upper, sub_coff, sub_cnt);
+}
+
+struct gkyl_rect_decomp*
+gkyl_rect_decomp_new_from_cuts_and_cost(int ndim, const int cuts[],
+  const struct gkyl_range *range, const struct gkyl_array *cost)
+{
+  struct gkyl_rect_decomp *decomp = gkyl_malloc(sizeof(*decomp));
+
+  int ndecomp = 1;
+  decomp->ndim = ndim;
+
+  for (int d=0; d<ndim; ++d) ndecomp *= cuts[d];
+  decomp->ndecomp = ndecomp;
+  decomp->ranges = gkyl_malloc(sizeof(struct gkyl_range[ndecomp]));
+
+  memcpy(&decomp->parent_range, range, sizeof(struct gkyl_range));
+
+  struct gkyl_range rcuts;
+  gkyl_range_init_from_shape(&rcuts, ndim, cuts);
+
+  int coff[GKYL_MAX_DIM] = { 0 };
+  rect_decomp_bisect(decomp, &rcuts, range, cost, range->lower, range->upper, coff, cuts);
+
+  decomp->ref_count = gkyl_ref_count_init(rect_decomp_free);
+  
+  return decomp;
+}
+
 struct gkyl_rect_decomp*
 gkyl_rect_decomp_new_from_cuts_and_cells(int ndim, const int cuts[], const int cells[])
 {
@@ -102,6 +207,64 @@ gkyl_rect_decomp_new_from_cuts_and_cells(int ndim, const int cuts[], const int c
   return gkyl_rect_decomp_new_from_cuts(ndim, cuts, &range);
 }
 
+struct gkyl_rect_decomp*
+gkyl_rect_decomp_new_from_decomp(const struct gkyl_rect_decomp *decomp,
+  const int *dirs, const struct gkyl_range *range)
+{
+  struct gkyl_rect_decomp *ndecomp = gkyl_malloc(sizeof(*ndecomp));
+
+  int ndim = ndecomp->ndim = range->ndim;
+  ndecomp->ndecomp = decomp->ndecomp;
+  ndecomp->ranges = gkyl_malloc(sizeof(struct gkyl_range[decomp->ndecomp]));
+  memcpy(&ndecomp->parent_range, range, sizeof(struct gkyl_range));
+
+  const struct gkyl_range *parent = &decomp->parent_range;
+  for (int n=0; n<decomp->ndecomp; ++n) {
+    int lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM];
+    for (int d=0; d<ndim; ++d) {
+      if (dirs[d] < 0) {
+        lower[d] = range->lower[d];
+        upper[d] = range->upper[d];
+      }
+      else {
+        // Map the cell edges of the region, so that neighboring regions
+        // still tile the range.
+        int dd = dirs[d];
+        long np = gkyl_range_shape(parent, dd), nr = gkyl_range_shape(range, d);
+        lower[d] = range->lower[d] + (decomp->ranges[n].lower[dd]-parent->lower[dd])*nr/np;
+        upper[d] = range->lower[d] + (decomp->ranges[n].upper[dd]+1-parent->lower[dd])*nr/np - 1;
+        // A region narrower than the coarsening ratio would be empty.
+        assert(upper[d] >= lower[d]);
+      }
+    }
+    gkyl_range_init(&ndecomp->ranges[n], ndim, lower, upper);
+  }
+
+  ndecomp->ref_count = gkyl_ref_count_init(rect_decomp_free);
+
+  return ndecomp;
+}
+
+struct gkyl_rect_decomp*
+gkyl_rect_decomp_new_from_ranges(int ndecomp, const struct gkyl_range *ranges,
+  const struct gkyl_range *range)
+{
+  struct gkyl_rect_decomp *decomp = gkyl_malloc(sizeof(*decomp));
+
+  decomp->ndim = range->ndim;
+  decomp->ndecomp = ndecomp;
+  decomp->ranges = gkyl_malloc(sizeof(struct gkyl_range[ndecomp]));
+  memcpy(&decomp->parent_range, range, sizeof(struct gkyl_range));
+  for (int n=0; n<ndecomp; ++n) {
+    assert(ranges[n].ndim == range->ndim);
+    memcpy(&decomp->ranges[n], &ranges[n], sizeof(struct gkyl_range));
+  }
+
+  decomp->ref_count = gkyl_ref_count_init(rect_decomp_free);
+
+  return decomp;
+}
+
 // ext_range = a X b 
 static void
 init_extend_range(struct gkyl_range *ext_range,
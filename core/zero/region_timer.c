@@ -0,0 +1,372 @@
+#ifdef __linux__
+#define _GNU_SOURCE // for syscall
+#endif
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include <gkyl_alloc.h>
+#include <gkyl_region_timer.h>
+#include <gkyl_util.h>
+
+enum { RT_NAME_SZ = 64 };
+
+// Region: nodes are stored in the order regions are first entered, so a
+// parent always comes before its sub-regions.
+struct rt_node {
+  char name[RT_NAME_SZ];
+  int parent; // index of parent, -1 for top-level regions
+  long ncalls;
+  double tm;
+  long counters[GKYL_RTIMER_NUM_COUNTERS];
+  struct timespec start; // time region was last entered
+  long cstart[GKYL_RTIMER_NUM_COUNTERS]; // counters when region was last entered
+};
+
+struct gkyl_region_timer {
+  int nnodes, nalloc;
+  struct rt_node *nodes;
+  int curr; // current region, -1 if not in any region
+  int perf_fd[GKYL_RTIMER_NUM_COUNTERS]; // perf events, [0] is group leader (-1 if not used)
+};
+
+// Open perf events of the calling thread as one group, so that they are
+// read together. On failure all fds are set to -1.
+static void
+perf_open(int fds[GKYL_RTIMER_NUM_COUNTERS])
+{
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    fds[c] = -1;
+#ifdef __linux__
+  const uint64_t config[GKYL_RTIMER_NUM_COUNTERS] = {
+    [GKYL_RTIMER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+    [GKYL_RTIMER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+    [GKYL_RTIMER_CACHE_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+  };
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c) {
+    struct perf_event_attr attr = {
+      .type = PERF_TYPE_HARDWARE,
+      .size = sizeof(struct perf_event_attr),
+      .config = config[c],
+      .disabled = c == 0 ? 1 : 0,
+      .exclude_kernel = 1,
+      .exclude_hv = 1,
+      .read_format = PERF_FORMAT_GROUP,
+    };
+    fds[c] = syscall(SYS_perf_event_open, &attr, 0, -1, c == 0 ? -1 : fds[0], 0);
+    if (fds[c] < 0) {
+      for (int i=0; i<=c; ++i) {
+        if (fds[i] >= 0) close(fds[i]);
+        fds[i] = -1;
+      }
+      return;
+    }
+  }
+  ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+static void
+perf_read(const struct gkyl_region_timer *rt, long counters[GKYL_RTIMER_NUM_COUNTERS])
+{
+  uint64_t buff[1+GKYL_RTIMER_NUM_COUNTERS] = { 0 };
+  if (rt->perf_fd[0] >= 0)
+    if (read(rt->perf_fd[0], buff, sizeof buff) != sizeof buff)
+      buff[0] = 0;
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    counters[c] = buff[0] == GKYL_RTIMER_NUM_COUNTERS ? buff[1+c] : 0;
+}
+
+gkyl_region_timer*
+gkyl_region_timer_new(bool use_counters)
+{
+  struct gkyl_region_timer *rt = gkyl_malloc(sizeof *rt);
+  rt->nnodes = 0;
+  rt->nalloc = 16;
+  rt->nodes = gkyl_malloc(sizeof(struct rt_node[rt->nalloc]));
+  rt->curr = -1;
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    rt->perf_fd[c] = -1;
+  if (use_counters)
+    perf_open(rt->perf_fd);
+  return rt;
+}
+
+bool
+gkyl_region_timer_has_counters(const gkyl_region_timer *rt)
+{
+  return rt->perf_fd[0] >= 0;
+}
+
+// Sub-region of parent with given name, or -1.
+static int
+find_child(const struct gkyl_region_timer *rt, int parent, const char *name, size_t len)
+{
+  for (int i=0; i<rt->nnodes; ++i)
+    if (rt->nodes[i].parent == parent && strlen(rt->nodes[i].name) == len &&
+      strncmp(rt->nodes[i].name, name, len) == 0)
+      return i;
+  return -1;
+}
+
+void
+gkyl_region_timer_begin(gkyl_region_timer *rt, const char *name)
+{
+  size_t len = strlen(name);
+  if (len >= RT_NAME_SZ) len = RT_NAME_SZ-1;
+  int idx = find_child(rt, rt->curr, name, len);
+  if (idx < 0) {
+    if (rt->nnodes == rt->nalloc) {
+      rt->nalloc *= 2;
+      rt->nodes = gkyl_realloc(rt->nodes, sizeof(struct rt_node[rt->nalloc]));
+    }
+    idx = rt->nnodes++;
+    struct rt_node *node = &rt->nodes[idx];
+    *node = (struct rt_node) { .parent = rt->curr };
+    memcpy(node->name, name, len);
+    node->name[len] = '\0';
+  }
+
+  struct rt_node *node = &rt->nodes[idx];
+  node->ncalls += 1;
+  rt->curr = idx;
+  perf_read(rt, node->cstart);
+  node->start = gkyl_wall_clock();
+}
+
+void
+gkyl_region_timer_end(gkyl_region_timer *rt)
+{
+  assert(rt->curr >= 0);
+  struct rt_node *node = &rt->nodes[rt->curr];
+  node->tm += gkyl_time_diff_now_sec(node->start);
+  long cend[GKYL_RTIMER_NUM_COUNTERS];
+  perf_read(rt, cend);
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    node->counters[c] += cend[c]-node->cstart[c];
+  rt->curr = node->parent;
+}
+
+// Time spent in sub-regions of a region.
+static double
+children_tm(const struct gkyl_region_timer *rt, int idx)
+{
+  double tm = 0.0;
+  for (int i=idx+1; i<rt->nnodes; ++i)
+    if (rt->nodes[i].parent == idx)
+      tm += rt->nodes[i].tm;
+  return tm;
+}
+
+static struct gkyl_region_timer_stat
+node_stat(const struct gkyl_region_timer *rt, int idx)
+{
+  const struct rt_node *node = &rt->nodes[idx];
+  struct gkyl_region_timer_stat stat = {
+    .ncalls = node->ncalls,
+    .tm = node->tm,
+    .self_tm = fmax(0.0, node->tm - children_tm(rt, idx)),
+  };
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    stat.counters[c] = node->counters[c];
+  return stat;
+}
+
+struct gkyl_region_timer_stat
+gkyl_region_timer_get(const gkyl_region_timer *rt, const char *path)
+{
+  int idx = -1;
+  const char *p = path;
+  do {
+    const char *sep = strchr(p, '/');
+    size_t len = sep ? sep-p : strlen(p);
+    idx = find_child(rt, idx, p, len);
+    p = sep ? sep+1 : 0;
+  } while (idx >= 0 && p);
+
+  if (idx < 0)
+    return (struct gkyl_region_timer_stat) { };
+  return node_stat(rt, idx);
+}
+
+double
+gkyl_region_timer_sum(const gkyl_region_timer *rt, const char *name)
+{
+  double tm = 0.0;
+  for (int i=0; i<rt->nnodes; ++i) {
+    if (strcmp(rt->nodes[i].name, name) != 0)
+      continue;
+    bool nested = false;
+    for (int p=rt->nodes[i].parent; p>=0 && !nested; p=rt->nodes[p].parent)
+      nested = strcmp(rt->nodes[p].name, name) == 0;
+    if (!nested)
+      tm += rt->nodes[i].tm;
+  }
+  return tm;
+}
+
+// Write path of region, with components separated by sep.
+static void
+write_path(const struct gkyl_region_timer *rt, int idx, char sep, FILE *fp)
+{
+  if (rt->nodes[idx].parent >= 0) {
+    write_path(rt, rt->nodes[idx].parent, sep, fp);
+    fputc(sep, fp);
+  }
+  fputs(rt->nodes[idx].name, fp);
+}
+
+// Values of each region reduced over ranks.
+enum { RT_NCALLS, RT_TM, RT_SELF_TM, RT_COUNTERS, RT_NVALS = RT_COUNTERS+GKYL_RTIMER_NUM_COUNTERS };
+
+struct rt_reduced {
+  bool consistent; // regions are the same on all ranks
+  bool has_counters; // counters are measured on all ranks
+  int nranks; // number of ranks values are reduced over
+  double *min, *max, *avg; // RT_NVALS values per region
+};
+
+// FNV-1a hash of the region tree.
+static int64_t
+tree_hash(const struct gkyl_region_timer *rt)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (int i=0; i<rt->nnodes; ++i) {
+    for (const char *c = rt->nodes[i].name; *c; ++c)
+      h = (h ^ (unsigned char) *c) * 1099511628211ULL;
+    h = (h ^ (uint64_t) (rt->nodes[i].parent+1)) * 1099511628211ULL;
+  }
+  return (int64_t) (h >> 2); // keep positive so it can be negated
+}
+
+static struct rt_reduced
+reduce(const struct gkyl_region_timer *rt, struct gkyl_comm *comm)
+{
+  int nranks;
+  gkyl_comm_get_size(comm, &nranks);
+
+  int64_t h = tree_hash(rt);
+  int64_t chk[4] = { h, -h, rt->nnodes, gkyl_region_timer_has_counters(rt) ? 0 : 1 };
+  int64_t chk_global[4];
+  gkyl_comm_allreduce_host(comm, GKYL_INT_64, GKYL_MAX, 4, chk, chk_global);
+
+  struct rt_reduced red = {
+    .consistent = chk_global[0] == h && chk_global[1] == -h && chk_global[2] == rt->nnodes,
+    .has_counters = chk_global[3] == 0,
+    .nranks = nranks,
+  };
+  int nv = rt->nnodes*RT_NVALS;
+  red.min = gkyl_malloc(sizeof(double[3*nv+1]));
+  red.max = red.min + nv;
+  red.avg = red.max + nv;
+
+  double *vals = gkyl_malloc(sizeof(double[nv+1]));
+  for (int i=0; i<rt->nnodes; ++i) {
+    struct gkyl_region_timer_stat stat = node_stat(rt, i);
+    double *v = vals + i*RT_NVALS;
+    v[RT_NCALLS] = stat.ncalls;
+    v[RT_TM] = stat.tm;
+    v[RT_SELF_TM] = stat.self_tm;
+    for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+      v[RT_COUNTERS+c] = stat.counters[c];
+  }
+
+  if (red.consistent) {
+    gkyl_comm_allreduce_host(comm, GKYL_DOUBLE, GKYL_MIN, nv, vals, red.min);
+    gkyl_comm_allreduce_host(comm, GKYL_DOUBLE, GKYL_MAX, nv, vals, red.max);
+    gkyl_comm_allreduce_host(comm, GKYL_DOUBLE, GKYL_SUM, nv, vals, red.avg);
+    for (int i=0; i<nv; ++i)
+      red.avg[i] /= nranks;
+  }
+  else {
+    // Region trees differ: use local values.
+    red.nranks = 1;
+    memcpy(red.min, vals, sizeof(double[nv]));
+    memcpy(red.max, vals, sizeof(double[nv]));
+    memcpy(red.avg, vals, sizeof(double[nv]));
+  }
+  gkyl_free(vals);
+  return red;
+}
+
+static void
+write_min_max_avg(FILE *fp, const char *key, const struct rt_reduced *red, int i, int v)
+{
+  fprintf(fp, ", \"%s\" : { \"min\" : %.10g, \"max\" : %.10g, \"avg\" : %.10g }", key,
+    red->min[i*RT_NVALS+v], red->max[i*RT_NVALS+v], red->avg[i*RT_NVALS+v]);
+}
+
+void
+gkyl_region_timer_write_json(const gkyl_region_timer *rt, struct gkyl_comm *comm,
+  FILE *fp)
+{
+  int rank;
+  gkyl_comm_get_rank(comm, &rank);
+  struct rt_reduced red = reduce(rt, comm);
+
+  if (rank == 0 && fp) {
+    const char *counter_names[] = {
+      [GKYL_RTIMER_CYCLES] = "cycles",
+      [GKYL_RTIMER_INSTRUCTIONS] = "instructions",
+      [GKYL_RTIMER_CACHE_MISSES] = "cache_misses",
+    };
+
+    fprintf(fp, "{\n");
+    fprintf(fp, " \"consistent\" : %s,\n", red.consistent ? "true" : "false");
+    fprintf(fp, " \"num_ranks\" : %d,\n", red.nranks);
+    fprintf(fp, " \"has_counters\" : %s,\n", red.has_counters ? "true" : "false");
+    fprintf(fp, " \"regions\" : [");
+    for (int i=0; i<rt->nnodes; ++i) {
+      fprintf(fp, "%s\n  { \"path\" : \"", i > 0 ? "," : "");
+      write_path(rt, i, '/', fp);
+      fprintf(fp, "\"");
+      write_min_max_avg(fp, "ncalls", &red, i, RT_NCALLS);
+      write_min_max_avg(fp, "tm", &red, i, RT_TM);
+      write_min_max_avg(fp, "self_tm", &red, i, RT_SELF_TM);
+      for (int c=0; red.has_counters && c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+        write_min_max_avg(fp, counter_names[c], &red, i, RT_COUNTERS+c);
+      fprintf(fp, " }");
+    }
+    fprintf(fp, "\n ]\n}\n");
+  }
+  gkyl_free(red.min);
+}
+
+void
+gkyl_region_timer_write_folded(const gkyl_region_timer *rt, struct gkyl_comm *comm,
+  FILE *fp)
+{
+  int rank;
+  gkyl_comm_get_rank(comm, &rank);
+  struct rt_reduced red = reduce(rt, comm);
+
+  if (rank == 0 && fp) {
+    for (int i=0; i<rt->nnodes; ++i) {
+      long us = (long) (1e6*red.avg[i*RT_NVALS+RT_SELF_TM] + 0.5);
+      if (us == 0) continue;
+      write_path(rt, i, ';', fp);
+      fprintf(fp, " %ld\n", us);
+    }
+  }
+  gkyl_free(red.min);
+}
+
+void
+gkyl_region_timer_release(gkyl_region_timer *rt)
+{
+  for (int c=0; c<GKYL_RTIMER_NUM_COUNTERS; ++c)
+    if (rt->perf_fd[c] >= 0)
+      close(rt->perf_fd[c]);
+  gkyl_free(rt->nodes);
+  gkyl_free(rt);
+}
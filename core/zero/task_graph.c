@@ -0,0 +1,236 @@
+#include <gkyl_alloc.h>
+#include <gkyl_task_graph.h>
+#include <gkyl_util.h>
+
+#include <pthread.h>
+
+struct tg_task {
+  jp_work_func func; // function that does the work
+  void *ctx; // context passed to func
+  int ndeps; // number of tasks this task depends on
+  int nsucc, csucc; // number of tasks depending on this one, capacity
+  int *succ; // tasks depending on this one
+};
+
+// Per-worker queue of ready tasks. The owner pushes and pops at the
+// tail, other workers steal from the head. Each task is queued once
+// per run, so a queue with room for all tasks never overflows.
+struct tg_worker {
+  struct gkyl_task_graph *tg;
+  int id; // worker ID
+  pthread_mutex_t lock;
+  int *queue; // queued tasks
+  int head, tail; // queue[head..tail-1] are the queued tasks
+};
+
+struct gkyl_task_graph {
+  int ntasks, ctasks; // number of tasks, capacity
+  struct tg_task *tasks;
+
+  // state of the current run
+  int nworkers;
+  struct tg_worker *workers;
+  int *pending; // number of unfinished dependencies of each task
+  pthread_mutex_t lock;
+  pthread_cond_t cond; // signalled when a task is queued or all are done
+  int remaining; // number of unfinished tasks
+  int num_ready; // number of queued tasks
+};
+
+gkyl_task_graph*
+gkyl_task_graph_new(void)
+{
+  struct gkyl_task_graph *tg = gkyl_malloc(sizeof(*tg));
+  tg->ntasks = 0;
+  tg->ctasks = 16;
+  tg->tasks = gkyl_malloc(sizeof(struct tg_task[tg->ctasks]));
+  pthread_mutex_init(&tg->lock, 0);
+  pthread_cond_init(&tg->cond, 0);
+  return tg;
+}
+
+int
+gkyl_task_graph_add(gkyl_task_graph *tg, jp_work_func func, void *ctx,
+  int ndeps, const int *deps)
+{
+  if (tg->ntasks == tg->ctasks) {
+    tg->ctasks *= 2;
+    tg->tasks = gkyl_realloc(tg->tasks, sizeof(struct tg_task[tg->ctasks]));
+  }
+  int id = tg->ntasks++;
+  struct tg_task *t = &tg->tasks[id];
+  t->func = func;
+  t->ctx = ctx;
+  t->ndeps = 0;
+  t->nsucc = t->csucc = 0;
+  t->succ = 0;
+
+  for (int i=0; i<ndeps; ++i) {
+    int d = deps[i];
+    if (d < 0) continue;
+    if (d >= id)
+      gkyl_exit("gkyl_task_graph_add: dependency on a task not yet added");
+
+    struct tg_task *dt = &tg->tasks[d];
+    // skip repeated dependencies
+    if (dt->nsucc > 0 && dt->succ[dt->nsucc-1] == id) continue;
+
+    if (dt->nsucc == dt->csucc) {
+      dt->csucc = dt->csucc == 0 ? 4 : 2*dt->csucc;
+      dt->succ = gkyl_realloc(dt->succ, sizeof(int[dt->csucc]));
+    }
+    dt->succ[dt->nsucc++] = id;
+    t->ndeps += 1;
+  }
+  return id;
+}
+
+int
+gkyl_task_graph_num_tasks(const gkyl_task_graph *tg)
+{
+  return tg->ntasks;
+}
+
+// Queue a ready task on worker w.
+static void
+tg_push(struct tg_worker *w, int task)
+{
+  struct gkyl_task_graph *tg = w->tg;
+
+  pthread_mutex_lock(&w->lock);
+  w->queue[w->tail++] = task;
+  pthread_mutex_unlock(&w->lock);
+
+  pthread_mutex_lock(&tg->lock);
+  tg->num_ready += 1;
+  pthread_cond_signal(&tg->cond);
+  pthread_mutex_unlock(&tg->lock);
+}
+
+// Take the most recently queued task of w (if own is true), or the
+// oldest one (when stealing). Returns -1 if the queue is empty.
+static int
+tg_take(struct tg_worker *w, bool own)
+{
+  int task = -1;
+  pthread_mutex_lock(&w->lock);
+  if (w->tail > w->head)
+    task = own ? w->queue[--w->tail] : w->queue[w->head++];
+  pthread_mutex_unlock(&w->lock);
+
+  if (task >= 0) {
+    pthread_mutex_lock(&w->tg->lock);
+    w->tg->num_ready -= 1;
+    pthread_mutex_unlock(&w->tg->lock);
+  }
+  return task;
+}
+
+static void
+tg_worker_do(void *ctx)
+{
+  struct tg_worker *w = ctx;
+  struct gkyl_task_graph *tg = w->tg;
+
+  while (1) {
+    int task = tg_take(w, true);
+    for (int i=1; task < 0 && i<tg->nworkers; ++i)
+      task = tg_take(&tg->workers[(w->id+i) % tg->nworkers], false);
+
+    if (task < 0) {
+      // nothing to do: wait till a task is queued or all are done
+      pthread_mutex_lock(&tg->lock);
+      while (tg->num_ready == 0 && tg->remaining > 0)
+        pthread_cond_wait(&tg->cond, &tg->lock);
+      bool done = tg->remaining == 0;
+      pthread_mutex_unlock(&tg->lock);
+      if (done) break;
+      continue;
+    }
+
+    struct tg_task *t = &tg->tasks[task];
+    t->func(t->ctx);
+
+    for (int i=0; i<t->nsucc; ++i) {
+      int s = t->succ[i];
+      pthread_mutex_lock(&tg->lock);
+      bool ready = --tg->pending[s] == 0;
+      pthread_mutex_unlock(&tg->lock);
+      if (ready)
+        tg_push(w, s);
+    }
+
+    pthread_mutex_lock(&tg->lock);
+    if (--tg->remaining == 0)
+      pthread_cond_broadcast(&tg->cond);
+    pthread_mutex_unlock(&tg->lock);
+  }
+}
+
+void
+gkyl_task_graph_run(gkyl_task_graph *tg, const struct gkyl_job_pool *jp)
+{
+  int ntasks = tg->ntasks;
+  if (ntasks == 0) return;
+
+  int nworkers = GKYL_MAX2(1, GKYL_MIN2(jp->pool_size, ntasks));
+
+  tg->nworkers = nworkers;
+  tg->workers = gkyl_malloc(sizeof(struct tg_worker[nworkers]));
+  tg->pending = gkyl_malloc(sizeof(int[ntasks]));
+  tg->remaining = ntasks;
+  tg->num_ready = 0;
+
+  for (int i=0; i<nworkers; ++i) {
+    struct tg_worker *w = &tg->workers[i];
+    w->tg = tg;
+    w->id = i;
+    pthread_mutex_init(&w->lock, 0);
+    w->queue = gkyl_malloc(sizeof(int[ntasks]));
+    w->head = w->tail = 0;
+  }
+
+  // deal out tasks without dependencies round-robin; each queue is
+  // filled in reverse so that its owner starts with the first one
+  int nroots = 0;
+  for (int t=0; t<ntasks; ++t) {
+    tg->pending[t] = tg->tasks[t].ndeps;
+    if (tg->pending[t] == 0) nroots += 1;
+  }
+  for (int t=ntasks-1, r=nroots-1; t>=0; --t) {
+    if (tg->pending[t] == 0) {
+      struct tg_worker *w = &tg->workers[r-- % nworkers];
+      w->queue[w->tail++] = t;
+    }
+  }
+  tg->num_ready = nroots;
+
+  for (int i=0; i<nworkers; ++i)
+    gkyl_job_pool_add_work(jp, tg_worker_do, &tg->workers[i]);
+  gkyl_job_pool_wait(jp);
+
+  for (int i=0; i<nworkers; ++i) {
+    pthread_mutex_destroy(&tg->workers[i].lock);
+    gkyl_free(tg->workers[i].queue);
+  }
+  gkyl_free(tg->workers);
+  gkyl_free(tg->pending);
+}
+
+void
+gkyl_task_graph_clear(gkyl_task_graph *tg)
+{
+  for (int i=0; i<tg->ntasks; ++i)
+    gkyl_free(tg->tasks[i].succ);
+  tg->ntasks = 0;
+}
+
+void
+gkyl_task_graph_release(gkyl_task_graph *tg)
+{
+  gkyl_task_graph_clear(tg);
+  gkyl_free(tg->tasks);
+  pthread_mutex_destroy(&tg->lock);
+  pthread_cond_destroy(&tg->cond);
+  gkyl_free(tg);
+}
@@ -1,8 +1,20 @@
+#ifdef __linux__
+#define _GNU_SOURCE // for pthread_setaffinity_np and sched_getaffinity
+#endif
+
 #include <gkyl_thread_pool.h>
 #include <gkyl_alloc.h>
+#include <gkyl_util.h>
 
 #include <thpool.h>
 
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
 struct jp_thread_pool {
   struct gkyl_job_pool jp; // base job-pool object
   threadpool thpool; // thread-pool object
@@ -48,3 +60,285 @@ gkyl_thread_pool_new(int nthreads)
     
   return &th->jp;
 }
+
+// Pool with workers pinned to CPUs. Each worker has its own job queue,
+// and the jobs added between two waits are dealt out round-robin, so that
+// the i-th job always runs on worker i % pool_size.
+struct pinned_worker {
+  struct jp_pinned_pool *pool; // pool this worker belongs to
+  int id, cpu; // worker ID and CPU it is pinned to (-1 if not pinned)
+  pthread_t thread;
+
+  pthread_mutex_t lock;
+  pthread_cond_t has_work;
+  struct pinned_job { jp_work_func func; void *ctx; } *jobs; // queued jobs
+  int njobs, head, cap; // number of queued jobs, next job, queue capacity
+  bool shutdown; // set (under lock) when the pool is released
+};
+
+struct jp_pinned_pool {
+  struct gkyl_job_pool jp; // base job-pool object
+  struct pinned_worker *workers;
+
+  pthread_mutex_t lock;
+  pthread_cond_t all_done;
+  long next; // index of next job since last wait
+  long pending; // number of jobs not yet finished
+};
+
+// Parse a CPU list like "0-3,8,10-11" into cpus (at most max_cpus
+// entries). Returns number of CPUs, or -1 if the spec is malformed.
+static int
+parse_cpu_list(const char *spec, int *cpus, int max_cpus)
+{
+  int n = 0;
+  const char *s = spec;
+  while (*s) {
+    char *end;
+    long lo = strtol(s, &end, 10);
+    if (end == s || lo < 0) return -1;
+    long hi = lo;
+    s = end;
+    if (*s == '-') {
+      hi = strtol(s+1, &end, 10);
+      if (end == s+1 || hi < lo) return -1;
+      s = end;
+    }
+    for (long c=lo; c<=hi && n<max_cpus; ++c)
+      cpus[n++] = c;
+    if (*s == ',') s += 1;
+    else if (*s) return -1;
+  }
+  return n;
+}
+
+// Socket (physical package) of a CPU, or 0 if it can't be determined.
+static int
+cpu_package_id(int cpu)
+{
+  int pkg = 0;
+  char fname[128];
+  snprintf(fname, sizeof fname, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+  FILE *fp = fopen(fname, "r");
+  if (fp) {
+    if (fscanf(fp, "%d", &pkg) != 1) pkg = 0;
+    fclose(fp);
+  }
+  return pkg;
+}
+
+// CPUs this process may run on, in increasing order. This is the
+// affinity mask set by the launcher (taskset, mpirun --bind-to, cgroups),
+// which need not be CPUs 0 to N-1. Returns number of CPUs in list.
+static int
+allowed_cpus(int *cpus, int max_cpus)
+{
+  int n = 0;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int c=0; c<CPU_SETSIZE && n<max_cpus; ++c)
+      if (CPU_ISSET(c, &set)) cpus[n++] = c;
+  }
+#endif
+  if (n == 0) {
+    int ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    ncpu = ncpu < 1 ? 1 : GKYL_MIN2(ncpu, max_cpus);
+    for (int c=0; c<ncpu; ++c) cpus[n++] = c;
+  }
+  return n;
+}
+
+// List of CPUs workers are pinned to, in worker order. Returns number
+// of CPUs in list.
+static int
+affinity_cpus(const char *affinity, int *cpus, int max_cpus)
+{
+  if (affinity == 0 || strcmp(affinity, "") == 0 || strcmp(affinity, "compact") == 0)
+    return allowed_cpus(cpus, max_cpus);
+
+  if (strcmp(affinity, "scatter") == 0) {
+    // Round-robin over the sockets, in CPU order within each socket.
+    int ncpu = allowed_cpus(cpus, max_cpus);
+    int allowed[ncpu], pkg[ncpu], npkg = 0;
+    for (int i=0; i<ncpu; ++i) {
+      allowed[i] = cpus[i];
+      pkg[i] = cpu_package_id(allowed[i]);
+      npkg = GKYL_MAX2(npkg, pkg[i]+1);
+    }
+    int n = 0;
+    bool taken[ncpu];
+    for (int i=0; i<ncpu; ++i) taken[i] = false;
+    while (n < ncpu) {
+      for (int p=0; p<npkg; ++p) {
+        for (int i=0; i<ncpu; ++i) {
+          if (!taken[i] && pkg[i] == p) {
+            taken[i] = true;
+            cpus[n++] = allowed[i];
+            break;
+          }
+        }
+      }
+    }
+    return ncpu;
+  }
+
+  int n = parse_cpu_list(affinity, cpus, max_cpus);
+  if (n <= 0)
+    gkyl_exit("gkyl_thread_pool_pinned_new: malformed affinity spec");
+  return n;
+}
+
+// Pin calling thread to a CPU. Returns false if the CPU is not
+// available to this process (or pinning is not supported).
+static bool
+pin_to_cpu(int cpu)
+{
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+static void*
+pinned_worker_do(void *arg)
+{
+  struct pinned_worker *w = arg;
+  struct jp_pinned_pool *pool = w->pool;
+  if (w->cpu >= 0 && !pin_to_cpu(w->cpu)) {
+    fprintf(stderr, "gkyl_thread_pool_pinned_new: unable to pin worker %d to CPU %d\n",
+      w->id, w->cpu);
+    w->cpu = -1;
+  }
+
+  while (1) {
+    pthread_mutex_lock(&w->lock);
+    while (w->njobs == 0 && !w->shutdown)
+      pthread_cond_wait(&w->has_work, &w->lock);
+    if (w->njobs == 0) { // shutdown with an empty queue
+      pthread_mutex_unlock(&w->lock);
+      break;
+    }
+    struct pinned_job job = w->jobs[w->head];
+    w->head = (w->head+1) % w->cap;
+    w->njobs -= 1;
+    pthread_mutex_unlock(&w->lock);
+
+    job.func(job.ctx);
+
+    pthread_mutex_lock(&pool->lock);
+    if (--pool->pending == 0)
+      pthread_cond_broadcast(&pool->all_done);
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return 0;
+}
+
+static void
+pinned_pool_free(const struct gkyl_ref_count *ref)
+{
+  struct gkyl_job_pool *base = container_of(ref, struct gkyl_job_pool, ref_count);
+  struct jp_pinned_pool *pool = container_of(base, struct jp_pinned_pool, jp);
+
+  for (int i=0; i<pool->jp.pool_size; ++i) {
+    struct pinned_worker *w = &pool->workers[i];
+    pthread_mutex_lock(&w->lock);
+    w->shutdown = true;
+    pthread_cond_signal(&w->has_work);
+    pthread_mutex_unlock(&w->lock);
+  }
+  for (int i=0; i<pool->jp.pool_size; ++i) {
+    struct pinned_worker *w = &pool->workers[i];
+    pthread_join(w->thread, 0);
+    pthread_mutex_destroy(&w->lock);
+    pthread_cond_destroy(&w->has_work);
+    gkyl_free(w->jobs);
+  }
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->all_done);
+  gkyl_free(pool->workers);
+  gkyl_free(pool);
+}
+
+static bool
+pinned_pool_add_work(const struct gkyl_job_pool *jp, jp_work_func func, void *ctx)
+{
+  struct jp_pinned_pool *pool = container_of(jp, struct jp_pinned_pool, jp);
+
+  pthread_mutex_lock(&pool->lock);
+  struct pinned_worker *w = &pool->workers[pool->next % pool->jp.pool_size];
+  pool->next += 1;
+  pool->pending += 1;
+  pthread_mutex_unlock(&pool->lock);
+
+  pthread_mutex_lock(&w->lock);
+  if (w->njobs == w->cap) {
+    // Grow the queue, unwrapping it so that it starts at index 0.
+    int ncap = 2*w->cap;
+    struct pinned_job *jobs = gkyl_malloc(sizeof(struct pinned_job[ncap]));
+    for (int i=0; i<w->njobs; ++i)
+      jobs[i] = w->jobs[(w->head+i) % w->cap];
+    gkyl_free(w->jobs);
+    w->jobs = jobs;
+    w->head = 0;
+    w->cap = ncap;
+  }
+  w->jobs[(w->head+w->njobs) % w->cap] = (struct pinned_job) { .func = func, .ctx = ctx };
+  w->njobs += 1;
+  pthread_cond_signal(&w->has_work);
+  pthread_mutex_unlock(&w->lock);
+
+  return true;
+}
+
+static void
+pinned_pool_wait(const struct gkyl_job_pool *jp)
+{
+  struct jp_pinned_pool *pool = container_of(jp, struct jp_pinned_pool, jp);
+  pthread_mutex_lock(&pool->lock);
+  while (pool->pending > 0)
+    pthread_cond_wait(&pool->all_done, &pool->lock);
+  pool->next = 0;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+struct gkyl_job_pool*
+gkyl_thread_pool_pinned_new(int nthreads, const char *affinity)
+{
+  struct jp_pinned_pool *pool = gkyl_malloc(sizeof(struct jp_pinned_pool));
+
+  int max_cpus = 4096, cpus[max_cpus];
+  int ncpus = affinity_cpus(affinity, cpus, max_cpus);
+
+  pool->next = pool->pending = 0;
+  pthread_mutex_init(&pool->lock, 0);
+  pthread_cond_init(&pool->all_done, 0);
+
+  pool->workers = gkyl_malloc(sizeof(struct pinned_worker[nthreads]));
+  for (int i=0; i<nthreads; ++i) {
+    struct pinned_worker *w = &pool->workers[i];
+    w->pool = pool;
+    w->id = i;
+    w->cpu = cpus[i % ncpus];
+    w->cap = 16;
+    w->njobs = w->head = 0;
+    w->shutdown = false;
+    w->jobs = gkyl_malloc(sizeof(struct pinned_job[w->cap]));
+    pthread_mutex_init(&w->lock, 0);
+    pthread_cond_init(&w->has_work, 0);
+  }
+  for (int i=0; i<nthreads; ++i)
+    pthread_create(&pool->workers[i].thread, 0, pinned_worker_do, &pool->workers[i]);
+
+  pool->jp.pool_size = nthreads;
+  pool->jp.add_work = pinned_pool_add_work;
+  pool->jp.wait = pinned_pool_wait;
+  pool->jp.ref_count = gkyl_ref_count_init(pinned_pool_free);
+
+  return &pool->jp;
+}
@@ -78,6 +78,8 @@ gk_field_add_TSBC_and_SSFG_updaters(struct gkyl_gyrokinetic_app *app, struct gk_
       .shift_func = bcz->lower.aux_profile,
       .shift_func_ctx = bcz->lower.aux_ctx,
       .use_gpu = app->use_gpu,
+      .comm = app->comm,
+      .decomp = app->decomp,
     };
     // Add the forward TS updater to f
     f->bc_T_LU_lo = gkyl_bc_twistshift_new(&T_LU_lo);
@@ -11,15 +11,6 @@
 #include <float.h>
 #include <time.h>
 
-// compute total number of ranges specified by cuts
-static inline int
-calc_cuts(int ndim, const int *cuts)
-{
-  int tc = 1;
-  for (int d=0; d<ndim; ++d) tc *= cuts[d];
-  return tc;
-}
-
 static struct gkyl_array**
 gk_multib_field_mkarr(bool on_gpu, long nc, struct gkyl_range **ranges, int num_arr)
 {
@@ -63,10 +54,11 @@ gk_multib_field_release_connected_list(struct gkyl_gyrokinetic_multib_app *mbapp
 
 static void 
 gk_multib_field_new_allgather_ranges(struct gk_multib_field *mbf, struct gkyl_gyrokinetic_multib_app *mbapp, int dir,
-  struct gkyl_range **multibz_ranges, struct gkyl_range **multibz_ranges_ext)
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_range **multibz_ranges, struct gkyl_range **multibz_ranges_ext)
 {
   // Construct the local and global ranges for the allgather along a given
-  // direction 'dir'. This function allocates 'multib_ranges' and
+  // direction 'dir'. In the 'slab_dirs' directions the ranges only span
+  // the local range. This function allocates 'multib_ranges' and
   // 'multib_ranges_ext', which must be freed when releasing mbf.
 
   // Get blocks connected along the specified direction.
@@ -78,10 +70,26 @@ gk_multib_field_new_allgather_ranges(struct gk_multib_field *mbf, struct gkyl_gy
   int *local_blocks = mbapp->local_blocks;
   for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
     int bid = local_blocks[bI];
+    struct gkyl_range multib_range, multib_range_ext;
+    gkyl_multib_comm_conn_create_multib_ranges_in_dir(&multib_range_ext,
+      &multib_range, nghost, nconnected[bid], block_list[bid], dir, mbapp->decomp);
+
+    int lower[GKYL_MAX_CDIM], upper[GKYL_MAX_CDIM];
+    for (int d=0; d<mbf->cdim; ++d) {
+      lower[d] = multib_range.lower[d];
+      upper[d] = multib_range.upper[d];
+    }
+    const struct gkyl_range *local = &mbapp->singleb_apps[bI]->local;
+    for (int i=0; i<num_slab_dirs; ++i) {
+      lower[slab_dirs[i]] = local->lower[slab_dirs[i]];
+      upper[slab_dirs[i]] = local->upper[slab_dirs[i]];
+    }
+    struct gkyl_range slab_range;
+    gkyl_range_init(&slab_range, mbf->cdim, lower, upper);
+
     multibz_ranges[bI] = gkyl_malloc(sizeof(struct gkyl_range));
     multibz_ranges_ext[bI] = gkyl_malloc(sizeof(struct gkyl_range));
-    gkyl_multib_comm_conn_create_multib_ranges_in_dir(multibz_ranges_ext[bI],
-      multibz_ranges[bI], nghost, nconnected[bid], block_list[bid], dir, mbapp->decomp);
+    gkyl_create_ranges(&slab_range, nghost, multibz_ranges_ext[bI], multibz_ranges[bI]);
   }
 
   gk_multib_field_release_connected_list(mbapp, block_list);
@@ -89,23 +97,22 @@ gk_multib_field_new_allgather_ranges(struct gk_multib_field *mbf, struct gkyl_gy
 
 static void
 gk_multib_field_new_allgather_comm_conns(struct gk_multib_field *mbf, struct gkyl_gyrokinetic_multib_app *mbapp, int dir,
-  struct gkyl_range **multib_ranges_ext, struct gkyl_multib_comm_conn **mbcc_allgather_send,
-  struct gkyl_multib_comm_conn **mbcc_allgather_recv)
+  int num_slab_dirs, const int *slab_dirs, struct gkyl_rect_decomp **decomp,
+  const struct gkyl_range *send_ranges, struct gkyl_range **multib_ranges_ext,
+  struct gkyl_multib_comm_conn **mbcc_allgather_send, struct gkyl_multib_comm_conn **mbcc_allgather_recv)
 {
-  // Construct the comm_conns for the allgather in a given direction.
+  // Construct the comm_conns for the allgather in a given direction, of
+  // the data on the ranges of the decomposition 'decomp' (given by
+  // 'send_ranges' on this rank). If there are slab directions, only the
+  // data in the local slab (see gk_multib_field_new_allgather_ranges) is
+  // gathered.
 
   int my_rank, num_ranks;
   gkyl_comm_get_rank(mbapp->comm, &my_rank);
   gkyl_comm_get_size(mbapp->comm, &num_ranks);
 
-  // Get branks (number of cuts per block)
   int num_blocks = mbapp->block_topo->num_blocks;
-  int *branks = gkyl_malloc(sizeof(int[num_blocks]));
-  for (int i=0; i<num_blocks; ++i) {
-    const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, i);
-    branks[i] = calc_cuts(mbf->cdim, bgi->cuts);
-  }
-  
+
   // Get blocks connected along the specified direction.
   int nconnected[num_blocks];
   int **block_list = gk_multib_field_new_connected_list(mbapp, dir, nconnected);
@@ -115,29 +122,43 @@ gk_multib_field_new_allgather_comm_conns(struct gk_multib_field *mbf, struct gky
   int rank_list[num_ranks];
   for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
     int bid = mbapp->local_blocks[bI];
-    gkyl_rrobin_decomp_getranks(mbapp->round_robin, bid, rank_list);
+    int nbranks = gyrokinetic_multib_block_ranks(mbapp, bid, rank_list);
     int brank = -1;
-    for (int i=0; i<branks[bid]; ++i)
+    for (int i=0; i<nbranks; ++i)
       if (rank_list[i] == my_rank) brank = i;
 
-    mbcc_allgather_send[bI] = gkyl_multib_comm_conn_new_send_from_connections(bid, brank, 
-      nghost, nconnected[bid], block_list[bid], dir, mbapp->decomp);
-    mbcc_allgather_recv[bI] = gkyl_multib_comm_conn_new_recv_from_connections(bid, brank,
-      nghost, nconnected[bid], block_list[bid], dir, mbapp->decomp);
+    if (num_slab_dirs > 0) {
+      mbcc_allgather_send[bI] = gkyl_multib_comm_conn_new_send_slab_from_connections(bid, brank, 
+        nghost, nconnected[bid], block_list[bid], dir, num_slab_dirs, slab_dirs, decomp);
+      mbcc_allgather_recv[bI] = gkyl_multib_comm_conn_new_recv_slab_from_connections(bid, brank,
+        nghost, nconnected[bid], block_list[bid], dir, num_slab_dirs, slab_dirs, decomp);
+    }
+    else {
+      mbcc_allgather_send[bI] = gkyl_multib_comm_conn_new_send_from_connections(bid, brank, 
+        nghost, nconnected[bid], block_list[bid], dir, decomp);
+      mbcc_allgather_recv[bI] = gkyl_multib_comm_conn_new_recv_from_connections(bid, brank,
+        nghost, nconnected[bid], block_list[bid], dir, decomp);
+    }
 
     for (int ns=0; ns<mbcc_allgather_send[bI]->num_comm_conn; ++ns) {
       // Need to get the actual rank that owns this cut.
       int rank_idx = mbcc_allgather_send[bI]->comm_conn[ns].rank;
-      gkyl_rrobin_decomp_getranks(mbapp->round_robin, 
+      gyrokinetic_multib_block_ranks(mbapp,
         mbcc_allgather_send[bI]->comm_conn[ns].block_id, rank_list);
       mbcc_allgather_send[bI]->comm_conn[ns].rank = rank_list[rank_idx];
-      // Make range the local range (a subrange of local_ext).
-      mbcc_allgather_send[bI]->comm_conn[ns].range = mbapp->singleb_apps[bI]->local;
+      // Make range a subrange of the send range (the whole send range
+      // if gathering the whole block).
+      if (num_slab_dirs > 0)
+        gkyl_sub_range_init(&mbcc_allgather_send[bI]->comm_conn[ns].range,
+          &send_ranges[bI], mbcc_allgather_send[bI]->comm_conn[ns].range.lower,
+          mbcc_allgather_send[bI]->comm_conn[ns].range.upper);
+      else
+        mbcc_allgather_send[bI]->comm_conn[ns].range = send_ranges[bI];
     }
     for (int nr=0; nr<mbcc_allgather_recv[bI]->num_comm_conn; ++nr) {
       // Need to get the actual rank that owns this cut.
       int rank_idx = mbcc_allgather_recv[bI]->comm_conn[nr].rank;
-      gkyl_rrobin_decomp_getranks(mbapp->round_robin, 
+      gyrokinetic_multib_block_ranks(mbapp,
         mbcc_allgather_recv[bI]->comm_conn[nr].block_id, rank_list);
       mbcc_allgather_recv[bI]->comm_conn[nr].rank = rank_list[rank_idx];
       // Make range a subrange.
@@ -152,39 +173,6 @@ gk_multib_field_new_allgather_comm_conns(struct gk_multib_field *mbf, struct gky
   }
 
   gk_multib_field_release_connected_list(mbapp, block_list);
-  gkyl_free(branks);
-}
-
-static struct gkyl_range **
-gk_multib_field_new_multib_to_global_ranges(struct gk_multib_field *mbf,
-  struct gkyl_gyrokinetic_multib_app *mbapp, int dir, struct gkyl_range **multib_ranges)
-{
-  // Create ranges for copying smoothed quantity from multib to global after smoothing.
-
-  // Get blocks connected along the specified direction.
-  int nconnected[mbapp->block_topo->num_blocks];
-  int **block_list = gk_multib_field_new_connected_list(mbapp, dir, nconnected);
-
-  struct gkyl_range **parent_subranges = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_range *));
-  for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-    int bid = mbapp->local_blocks[bI];
-    int shift[GKYL_MAX_DIM] = {0};
-    for (int i=0; i<nconnected[bid]; i++) {
-      if (block_list[bid][i] == bid)
-        break;
-      else 
-        shift[dir] += gkyl_range_shape(&mbapp->decomp[block_list[bid][i]]->parent_range, dir);
-    }
-    struct gkyl_range shifted_parent_range;
-    gkyl_range_shift(&shifted_parent_range, &mbapp->singleb_apps[bI]->global, shift);
-    parent_subranges[bI] = gkyl_malloc(sizeof(struct gkyl_range));
-    int inter = gkyl_sub_range_intersect(parent_subranges[bI],
-      multib_ranges[bI], &shifted_parent_range);
-  }
-
-  gk_multib_field_release_connected_list(mbapp, block_list);
-
-  return parent_subranges;
 }
 
 static struct gkyl_range **
@@ -219,17 +207,29 @@ gk_multib_field_new_multib_to_local_ranges(struct gk_multib_field *mbf,
   return block_subranges; 
 }
 
+static bool
+gk_multib_field_is_par_periodic(struct gkyl_gyrokinetic_multib_app *mbapp,
+  struct gk_multib_field *mbf, int bid)
+{
+  // No BC for the parallel smoother, unless we are in the core in 2x in
+  // which case periodic BCs are needed.
+  const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, bid);
+  enum gkyl_tok_geo_type ftype = bgi->geometry.tok_grid_info.ftype;
+  return mbf->cdim == 2 && (ftype == GKYL_CORE || ftype == GKYL_CORE_R || ftype == GKYL_CORE_L);
+}
+
 static void
-gk_multib_field_new_par_smooth(const struct gkyl_gyrokinetic_multib *mbinp,
+gk_multib_field_new_par_smooth_allgather(const struct gkyl_gyrokinetic_multib *mbinp,
   struct gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *mbf)
 {
-  // Initialize objects needed for the multiblock parallel smoothing.
+  // Initialize objects needed for the multiblock parallel smoothing with
+  // the whole field line gathered on each rank.
   int dir = mbf->cdim-1;
  
   // Construct the local and global ranges for the allgather along z.
   mbf->multibz_ranges = gkyl_malloc(mbf->num_local_blocks* sizeof(struct gkyl_range *));
   mbf->multibz_ranges_ext = gkyl_malloc(mbf->num_local_blocks* sizeof(struct gkyl_range *));
-  gk_multib_field_new_allgather_ranges(mbf, mbapp, dir, mbf->multibz_ranges, mbf->multibz_ranges_ext);
+  gk_multib_field_new_allgather_ranges(mbf, mbapp, dir, 0, 0, mbf->multibz_ranges, mbf->multibz_ranges_ext);
 
   // Allocate global-in-z arrays for charge density and potential.
   int num_basis = mbapp->singleb_apps[0]->basis.num_basis;
@@ -241,11 +241,11 @@ gk_multib_field_new_par_smooth(const struct gkyl_gyrokinetic_multib *mbinp,
   // Construct the comm_conns for the allgather along z.
   mbf->mbcc_allgatherz_send = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
   mbf->mbcc_allgatherz_recv = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
-  gk_multib_field_new_allgather_comm_conns(mbf, mbapp, dir, mbf->multibz_ranges_ext,
-    mbf->mbcc_allgatherz_send, mbf->mbcc_allgatherz_recv);
-  
-  // Create ranges for copying smoothed quantity from multib to global after smoothing.
-  mbf->parent_subrangesz = gk_multib_field_new_multib_to_global_ranges(mbf, mbapp, dir, mbf->multibz_ranges);
+  struct gkyl_range send_ranges[mbf->num_local_blocks];
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+    send_ranges[bI] = mbapp->singleb_apps[bI]->local;
+  gk_multib_field_new_allgather_comm_conns(mbf, mbapp, dir, 0, 0, mbapp->decomp, send_ranges,
+    mbf->multibz_ranges_ext, mbf->mbcc_allgatherz_send, mbf->mbcc_allgatherz_recv);
 
   // Create ranges for copying smoothed quantity from multib to local after smoothing.
   mbf->block_subrangesz = gk_multib_field_new_multib_to_local_ranges(mbf, mbapp, dir, mbf->multibz_ranges);
@@ -295,19 +295,152 @@ gk_multib_field_new_par_smooth(const struct gkyl_gyrokinetic_multib *mbinp,
     int bid = mbapp->local_blocks[bI];
     struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
 
-    // Choose no BC for the parallel smoother, unless we are in the core in 2x
-    // in which case periodic BCs are needed.
-    enum gkyl_fem_parproj_bc_type fem_parbc = GKYL_FEM_PARPROJ_NONE;
-    const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, bid);
-    enum gkyl_tok_geo_type ftype = bgi->geometry.tok_grid_info.ftype;
-    if (mbf->cdim == 2 && (ftype == GKYL_CORE || ftype == GKYL_CORE_R || ftype == GKYL_CORE_L))
-      fem_parbc = GKYL_FEM_PARPROJ_PERIODIC;
+    enum gkyl_fem_parproj_bc_type fem_parbc = gk_multib_field_is_par_periodic(mbapp, mbf, bid) ?
+      GKYL_FEM_PARPROJ_PERIODIC : GKYL_FEM_PARPROJ_NONE;
 
     mbf->fem_parproj[bI] = gkyl_fem_parproj_new(mbf->multibz_ranges[bI],
       &sbapp->basis, fem_parbc, mbf->lhs_weight_multibz[bI], mbf->rhs_weight_multibz[bI], mbapp->use_gpu);
   }
 }
 
+static void
+gk_multib_field_new_par_smooth_schur(const struct gkyl_gyrokinetic_multib *mbinp,
+  struct gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *mbf)
+{
+  // Initialize objects needed for the multiblock parallel smoothing with
+  // each local block solving for its piece of the field line, and only
+  // exchanging interface data with the other pieces along the field line.
+  int cdim = mbf->cdim, dir = cdim-1;
+  int num_blocks = mbapp->block_topo->num_blocks;
+
+  int my_rank, num_ranks;
+  gkyl_comm_get_rank(mbapp->comm, &my_rank);
+  gkyl_comm_get_size(mbapp->comm, &num_ranks);
+
+  // Decompositions of the interface data: each block has a single cell
+  // along z per piece, and the same perpendicular cells and cuts as the
+  // block.
+  mbf->decomp_iface = gkyl_malloc(num_blocks * sizeof(struct gkyl_rect_decomp *));
+  for (int bid=0; bid<num_blocks; ++bid) {
+    int cuts[GKYL_MAX_CDIM], cells[GKYL_MAX_CDIM];
+    gyrokinetic_multib_block_cuts(mbapp, bid, cuts);
+    for (int d=0; d<cdim; ++d)
+      cells[d] = gkyl_range_shape(&mbapp->decomp[bid]->parent_range, d);
+    cells[dir] = cuts[dir];
+    struct gkyl_range range;
+    gkyl_create_global_range(cdim, cells, &range);
+    mbf->decomp_iface[bid] = gkyl_rect_decomp_new_from_cuts(cdim, cuts, &range);
+  }
+
+  // Get blocks connected along z.
+  int nconnected[num_blocks];
+  int **block_list = gk_multib_field_new_connected_list(mbapp, dir, nconnected);
+
+  mbf->iface_ranges = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_range));
+  mbf->chain_ranges = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_range));
+  int piece[mbf->num_local_blocks], num_pieces[mbf->num_local_blocks];
+  int nghost[] = {1, 1, 1};
+  int rank_list[num_ranks];
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
+    int bid = mbapp->local_blocks[bI];
+    struct gkyl_range *iface = &mbf->iface_ranges[bI];
+    int nbranks = gyrokinetic_multib_block_ranks(mbapp, bid, rank_list);
+    for (int i=0; i<nbranks; ++i)
+      if (rank_list[i] == my_rank) *iface = mbf->decomp_iface[bid]->ranges[i];
+
+    // The interface data of all pieces along z, in our perpendicular slab.
+    struct gkyl_range multib_range, multib_range_ext;
+    gkyl_multib_comm_conn_create_multib_ranges_in_dir(&multib_range_ext, &multib_range,
+      nghost, nconnected[bid], block_list[bid], dir, mbf->decomp_iface);
+    int lower[GKYL_MAX_CDIM], upper[GKYL_MAX_CDIM];
+    for (int d=0; d<cdim; ++d) {
+      lower[d] = iface->lower[d];
+      upper[d] = iface->upper[d];
+    }
+    lower[dir] = multib_range.lower[dir];
+    upper[dir] = multib_range.upper[dir];
+    gkyl_range_init(&mbf->chain_ranges[bI], cdim, lower, upper);
+
+    // Position of our piece along z.
+    int shift = 0;
+    for (int i=0; (i<nconnected[bid]) && (block_list[bid][i] != bid); ++i)
+      shift += gkyl_range_shape(&mbf->decomp_iface[block_list[bid][i]]->parent_range, dir);
+    piece[bI] = iface->lower[dir] + shift - lower[dir];
+    num_pieces[bI] = upper[dir] - lower[dir] + 1;
+  }
+
+  gk_multib_field_release_connected_list(mbapp, block_list);
+
+  // Construct the comm_conns for the exchange of interface data.
+  int slab_dirs[GKYL_MAX_CDIM];
+  for (int d=0; d<dir; ++d)
+    slab_dirs[d] = d;
+  struct gkyl_range *chain_ranges[mbf->num_local_blocks];
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+    chain_ranges[bI] = &mbf->chain_ranges[bI];
+  mbf->mbcc_iface_send = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
+  mbf->mbcc_iface_recv = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
+  gk_multib_field_new_allgather_comm_conns(mbf, mbapp, dir, dir, slab_dirs, mbf->decomp_iface,
+    mbf->iface_ranges, chain_ranges, mbf->mbcc_iface_send, mbf->mbcc_iface_recv);
+
+  // Create the parallel smoother.
+  mbf->fem_parproj_schur = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_fem_parproj_schur *));
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
+    int bid = mbapp->local_blocks[bI];
+    struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
+    // The LHS weight is the polarization weight in 1x, and the weights
+    // are 1 otherwise.
+    mbf->fem_parproj_schur[bI] = gkyl_fem_parproj_schur_new(&(struct gkyl_fem_parproj_schur_inp) {
+        .local_range = &sbapp->local,
+        .basis = &sbapp->basis,
+        .piece = piece[bI],
+        .num_pieces = num_pieces[bI],
+        .is_periodic = gk_multib_field_is_par_periodic(mbapp, mbf, bid),
+        .weight_left = cdim == 1 ? sbapp->field->epsilon : 0,
+        .weight_right = 0,
+      }
+    );
+  }
+
+  // Exchange the Schur complements of the pieces and set up the
+  // interface systems.
+  int schur_ncomp = gkyl_fem_parproj_schur_schur_ncomp(mbf->fem_parproj_schur[0]);
+  struct gkyl_range *iface_ranges[mbf->num_local_blocks];
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+    iface_ranges[bI] = &mbf->iface_ranges[bI];
+  struct gkyl_array **schur_local = gk_multib_field_mkarr(false, schur_ncomp, iface_ranges, mbf->num_local_blocks);
+  struct gkyl_array **schur_chain = gk_multib_field_mkarr(false, schur_ncomp, chain_ranges, mbf->num_local_blocks);
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+    gkyl_fem_parproj_schur_get_schur(mbf->fem_parproj_schur[bI], &mbf->iface_ranges[bI], schur_local[bI]);
+  int stat = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks,
+    mbapp->local_blocks, mbf->mbcc_iface_send, mbf->mbcc_iface_recv, schur_local, schur_chain);
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
+    gkyl_fem_parproj_schur_set_schur(mbf->fem_parproj_schur[bI], &mbf->chain_ranges[bI], schur_chain[bI]);
+    gkyl_array_release(schur_local[bI]);
+    gkyl_array_release(schur_chain[bI]);
+  }
+  gkyl_free(schur_local);
+  gkyl_free(schur_chain);
+
+  // Allocate the interface residuals.
+  int resid_ncomp = gkyl_fem_parproj_schur_resid_ncomp(mbf->fem_parproj_schur[0]);
+  mbf->resid_local = gk_multib_field_mkarr(false, resid_ncomp, iface_ranges, mbf->num_local_blocks);
+  mbf->resid_chain = gk_multib_field_mkarr(false, resid_ncomp, chain_ranges, mbf->num_local_blocks);
+}
+
+static void
+gk_multib_field_new_par_smooth(const struct gkyl_gyrokinetic_multib *mbinp,
+  struct gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *mbf)
+{
+  // Initialize objects needed for the multiblock parallel smoothing. The
+  // substructured smoother is CPU only and supports p=1 only.
+  mbf->use_schur = !mbapp->use_gpu && mbapp->singleb_apps[0]->basis.poly_order == 1;
+  if (mbf->use_schur)
+    gk_multib_field_new_par_smooth_schur(mbinp, mbapp, mbf);
+  else
+    gk_multib_field_new_par_smooth_allgather(mbinp, mbapp, mbf);
+}
+
 static bool
 in_array_int(int inp, const int *arr, int num_elements)
 {
@@ -360,24 +493,29 @@ gk_multib_field_new_perp_solve(const struct gkyl_gyrokinetic_multib *mbinp,
   int dir = 0; // Note that for cdim=3 we here assume there are is everywhere a
                // single block along y.
  
-  // Construct the local and global ranges for the perpendicular allgather.
+  // The perpendicular planes are solved independently, so only gather the
+  // blocks along x in the local slab of z.
+  int slab_dirs[] = {mbf->cdim-1};
+
+  // Construct the local and global ranges for the perpendicular gather.
   mbf->multib_perp_ranges = gkyl_malloc(mbf->num_local_blocks* sizeof(struct gkyl_range *));
   mbf->multib_perp_ranges_ext = gkyl_malloc(mbf->num_local_blocks* sizeof(struct gkyl_range *));
-  gk_multib_field_new_allgather_ranges(mbf, mbapp, dir, mbf->multib_perp_ranges, mbf->multib_perp_ranges_ext);
+  gk_multib_field_new_allgather_ranges(mbf, mbapp, dir, 1, slab_dirs,
+    mbf->multib_perp_ranges, mbf->multib_perp_ranges_ext);
 
   // Allocate global-in-x arrays for charge density and potential.
   int num_basis = mbapp->singleb_apps[0]->basis.num_basis;
   mbf->phi_multib_perp = gk_multib_field_mkarr(mbapp->use_gpu, num_basis, mbf->multib_perp_ranges_ext, mbf->num_local_blocks);
   mbf->rho_c_multib_perp = gk_multib_field_mkarr(mbapp->use_gpu, num_basis, mbf->multib_perp_ranges_ext, mbf->num_local_blocks);
 
-  // Construct the comm_conns for the allgather along z.
+  // Construct the comm_conns for the gather along x.
+  struct gkyl_range send_ranges[mbf->num_local_blocks];
+  for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+    send_ranges[bI] = mbapp->singleb_apps[bI]->local_ext;
   mbf->mbcc_allgather_perp_send = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
   mbf->mbcc_allgather_perp_recv = gkyl_malloc(mbf->num_local_blocks * sizeof(struct gkyl_multib_comm_conn *));
-  gk_multib_field_new_allgather_comm_conns(mbf, mbapp, dir, mbf->multib_perp_ranges_ext,
-    mbf->mbcc_allgather_perp_send, mbf->mbcc_allgather_perp_recv);
-  
-  // Create ranges for copying smoothed quantity from multib to global.
-  mbf->parent_subranges_perp = gk_multib_field_new_multib_to_global_ranges(mbf, mbapp, dir, mbf->multib_perp_ranges);
+  gk_multib_field_new_allgather_comm_conns(mbf, mbapp, dir, 1, slab_dirs, mbapp->decomp, send_ranges,
+    mbf->multib_perp_ranges_ext, mbf->mbcc_allgather_perp_send, mbf->mbcc_allgather_perp_recv);
 
   // Create ranges for copying smoothed quantity from multib to local.
   mbf->block_subranges_perp = gk_multib_field_new_multib_to_local_ranges(mbf, mbapp, dir, mbf->multib_perp_ranges);
@@ -435,6 +573,7 @@ gk_multib_field_new(const struct gkyl_gyrokinetic_multib *mbinp, struct gkyl_gyr
   mbf->info = mbinp->field;
   mbf->gkfield_id = mbf->info.gkfield_id? mbf->info.gkfield_id : GKYL_GK_FIELD_ES;
   mbf->num_local_blocks = mbapp->num_local_blocks;
+  mbf->num_blocks = mbapp->block_topo->num_blocks;
   mbf->cdim = mbapp->block_topo->ndim;
 
   // Allocate local arrays for charge density and potential.
@@ -457,6 +596,37 @@ gk_multib_field_new(const struct gkyl_gyrokinetic_multib *mbinp, struct gkyl_gyr
   return mbf;
 }
 
+static void
+gk_multib_field_par_smooth(gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *mbf,
+  struct gkyl_array **fin, struct gkyl_array **fout)
+{
+  // Make the DG field 'fin' of each local block continuous along the
+  // magnetic field, and store it in 'fout' (which can be the same as fin).
+  if (mbf->use_schur) {
+    for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+      gkyl_fem_parproj_schur_set_rhs(mbf->fem_parproj_schur[bI], fin[bI],
+        &mbf->iface_ranges[bI], mbf->resid_local[bI]);
+    // Exchange the interface residuals along the magnetic field.
+    int stat = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks, mbapp->local_blocks,
+      mbf->mbcc_iface_send, mbf->mbcc_iface_recv, mbf->resid_local, mbf->resid_chain);
+    for (int bI=0; bI<mbf->num_local_blocks; ++bI)
+      gkyl_fem_parproj_schur_solve(mbf->fem_parproj_schur[bI], &mbf->chain_ranges[bI],
+        mbf->resid_chain[bI], fout[bI]);
+  }
+  else {
+    // Gather the field along the magnetic field.
+    int stat = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks, mbapp->local_blocks,
+      mbf->mbcc_allgatherz_send, mbf->mbcc_allgatherz_recv, fin, mbf->rho_c_multibz_dg);
+    // Make the field continuous on the multibz range and copy it back to local.
+    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
+      gkyl_fem_parproj_set_rhs(mbf->fem_parproj[bI], mbf->rho_c_multibz_dg[bI], mbf->rho_c_multibz_dg[bI]);
+      gkyl_fem_parproj_solve(mbf->fem_parproj[bI], mbf->rho_c_multibz_smooth[bI]);
+      gkyl_array_copy_range_to_range(fout[bI], mbf->rho_c_multibz_smooth[bI],
+        &mbapp->singleb_apps[bI]->local, mbf->block_subrangesz[bI]);
+    }
+  }
+}
+
 // Compute the electrostatic potential.
 void
 gk_multib_field_rhs(gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *mbf, const struct gkyl_array *fin[])
@@ -476,44 +646,13 @@ gk_multib_field_rhs(gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *
 
   struct timespec wst = gkyl_wall_clock();
 
-  // Gather the charge density along the magnetic field.
-  int stat_par_rho = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks, mbapp->local_blocks,
-    mbf->mbcc_allgatherz_send, mbf->mbcc_allgatherz_recv, mbf->rho_c_local, mbf->rho_c_multibz_dg);
-  // Make charge density continuous on the multibz range.
-  for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-    gkyl_fem_parproj_set_rhs(mbf->fem_parproj[bI], mbf->rho_c_multibz_dg[bI], mbf->rho_c_multibz_dg[bI]);
-    gkyl_fem_parproj_solve(mbf->fem_parproj[bI], mbf->rho_c_multibz_smooth[bI]);
-  }
-
   if (mbf->cdim == 1) {
-    // Copy continuous charge density back to apps.
-    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-      gkyl_array_copy_range_to_range(mbapp->singleb_apps[bI]->field->phi_smooth, mbf->rho_c_multibz_smooth[bI],
-        &mbapp->singleb_apps[bI]->local, mbf->block_subrangesz[bI]);
-    }
+    // Make the charge density continuous and store it in the potential.
+    gk_multib_field_par_smooth(mbapp, mbf, mbf->rho_c_local, mbf->phi_local);
   }
   else {
-//    // Copy continuous charge density back to apps.
-//    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-//      struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
-//      gkyl_array_copy_range_to_range(sbapp->field->rho_c_global_smooth,
-//        mbf->rho_c_multibz_smooth[bI], &sbapp->global, mbf->parent_subrangesz[bI]);
-//    }
-//    // Every block Solves the poisson equation.
-//    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-//      struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
-//      gkyl_deflated_fem_poisson_advance(sbapp->field->deflated_fem_poisson, 
-//        sbapp->field->rho_c_global_smooth, 0, sbapp->field->phi_smooth);
-//    }
-    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-      struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
-      // Copy continuous charge density back to apps.
-      gkyl_array_copy_range_to_range(sbapp->field->rho_c_global_smooth,
-        mbf->rho_c_multibz_smooth[bI], &sbapp->global, mbf->parent_subrangesz[bI]);
-      // Copy from block-global to block local.
-      gkyl_array_copy_range_to_range(sbapp->field->rho_c, sbapp->field->rho_c_global_smooth,
-        &sbapp->local, &sbapp->field->global_sub_range);
-    }
+    // Make the charge density continuous along the magnetic field.
+    gk_multib_field_par_smooth(mbapp, mbf, mbf->rho_c_local, mbf->rho_c_local);
 
     //
     // Solve the perpendicular Poisson problem.
@@ -522,7 +661,6 @@ gk_multib_field_rhs(gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *
     int stat_perp = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks, mbapp->local_blocks,
       mbf->mbcc_allgather_perp_send, mbf->mbcc_allgather_perp_recv, mbf->rho_c_local, mbf->rho_c_multib_perp);
     for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-      struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
       // Solve the perp problem.
       gkyl_fem_poisson_perp_set_rhs(mbf->fem_poisson[bI], mbf->rho_c_multib_perp[bI]);
       gkyl_fem_poisson_perp_solve(mbf->fem_poisson[bI], mbf->phi_multib_perp[bI]);
@@ -534,23 +672,8 @@ gk_multib_field_rhs(gkyl_gyrokinetic_multib_app *mbapp, struct gk_multib_field *
     // Finished solving the perpendicular Poisson problem.
     //
 
-    // Gather the potential along the magnetic field.
-    int stat_par_phi = gkyl_multib_comm_conn_array_transfer(mbapp->comm, mbf->num_local_blocks, mbapp->local_blocks,
-      mbf->mbcc_allgatherz_send, mbf->mbcc_allgatherz_recv, mbf->phi_local, mbf->phi_multibz_dg);
-    // Make the potential continuous along B on the multibz range.
-    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-      gkyl_fem_parproj_set_rhs(mbf->fem_parproj[bI], mbf->phi_multibz_dg[bI], mbf->phi_multibz_dg[bI]);
-      gkyl_fem_parproj_solve(mbf->fem_parproj[bI], mbf->phi_multibz_smooth[bI]);
-    }
-    // Copy continuous potential back to apps.
-    for (int bI=0; bI<mbf->num_local_blocks; ++bI) {
-      struct gkyl_gyrokinetic_app *sbapp = mbapp->singleb_apps[bI];
-      gkyl_array_copy_range_to_range(sbapp->field->rho_c_global_smooth,
-        mbf->phi_multibz_smooth[bI], &sbapp->global, mbf->parent_subrangesz[bI]);
-      // Copy from block-global to block local.
-      gkyl_array_copy_range_to_range(sbapp->field->phi_smooth, sbapp->field->rho_c_global_smooth,
-        &sbapp->local, &sbapp->field->global_sub_range);
-    }
+    // Make the potential continuous along the magnetic field.
+    gk_multib_field_par_smooth(mbapp, mbf, mbf->phi_local, mbf->phi_local);
   }
 
   mbapp->stat.field_phi_solve_tm += gkyl_time_diff_now_sec(wst);
@@ -568,41 +691,59 @@ gk_multib_field_release(struct gk_multib_field *mbf)
   gkyl_free(mbf->rho_c_local);
 
   // Free memory allocated for parallel smoothing.
-  for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
-    gkyl_free(mbf->multibz_ranges[bI]);
-    gkyl_free(mbf->multibz_ranges_ext[bI]);
-    gkyl_free(mbf->parent_subrangesz[bI]);
-    gkyl_free(mbf->block_subrangesz[bI]);
-    gkyl_multib_comm_conn_release(mbf->mbcc_allgatherz_send[bI]);
-    gkyl_multib_comm_conn_release(mbf->mbcc_allgatherz_recv[bI]);
-    gkyl_array_release(mbf->phi_multibz_dg[bI]);
-    gkyl_array_release(mbf->phi_multibz_smooth[bI]);
-    gkyl_array_release(mbf->rho_c_multibz_dg[bI]);
-    gkyl_array_release(mbf->rho_c_multibz_smooth[bI]);
-    gkyl_array_release(mbf->lhs_weight_multibz[bI]);
-    gkyl_array_release(mbf->rhs_weight_multibz[bI]);
-    gkyl_fem_parproj_release(mbf->fem_parproj[bI]);
+  if (mbf->use_schur) {
+    for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
+      gkyl_multib_comm_conn_release(mbf->mbcc_iface_send[bI]);
+      gkyl_multib_comm_conn_release(mbf->mbcc_iface_recv[bI]);
+      gkyl_array_release(mbf->resid_local[bI]);
+      gkyl_array_release(mbf->resid_chain[bI]);
+      gkyl_fem_parproj_schur_release(mbf->fem_parproj_schur[bI]);
+    }
+    for (int bid=0; bid<mbf->num_blocks; ++bid)
+      gkyl_rect_decomp_release(mbf->decomp_iface[bid]);
+    gkyl_free(mbf->decomp_iface);
+    gkyl_free(mbf->mbcc_iface_send);
+    gkyl_free(mbf->mbcc_iface_recv);
+    gkyl_free(mbf->iface_ranges);
+    gkyl_free(mbf->chain_ranges);
+    gkyl_free(mbf->resid_local);
+    gkyl_free(mbf->resid_chain);
+    gkyl_free(mbf->fem_parproj_schur);
+  }
+  else {
+    for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
+      gkyl_free(mbf->multibz_ranges[bI]);
+      gkyl_free(mbf->multibz_ranges_ext[bI]);
+      gkyl_free(mbf->block_subrangesz[bI]);
+      gkyl_multib_comm_conn_release(mbf->mbcc_allgatherz_send[bI]);
+      gkyl_multib_comm_conn_release(mbf->mbcc_allgatherz_recv[bI]);
+      gkyl_array_release(mbf->phi_multibz_dg[bI]);
+      gkyl_array_release(mbf->phi_multibz_smooth[bI]);
+      gkyl_array_release(mbf->rho_c_multibz_dg[bI]);
+      gkyl_array_release(mbf->rho_c_multibz_smooth[bI]);
+      gkyl_array_release(mbf->lhs_weight_multibz[bI]);
+      gkyl_array_release(mbf->rhs_weight_multibz[bI]);
+      gkyl_fem_parproj_release(mbf->fem_parproj[bI]);
+    }
+    gkyl_free(mbf->multibz_ranges);
+    gkyl_free(mbf->multibz_ranges_ext);
+    gkyl_free(mbf->block_subrangesz);
+    gkyl_free(mbf->mbcc_allgatherz_send);
+    gkyl_free(mbf->mbcc_allgatherz_recv);
+    gkyl_free(mbf->phi_multibz_dg);
+    gkyl_free(mbf->phi_multibz_smooth);
+    gkyl_free(mbf->rho_c_multibz_dg);
+    gkyl_free(mbf->rho_c_multibz_smooth);
+    gkyl_free(mbf->lhs_weight_multibz);
+    gkyl_free(mbf->rhs_weight_multibz);
+    gkyl_free(mbf->fem_parproj);
   }
-  gkyl_free(mbf->multibz_ranges);
-  gkyl_free(mbf->multibz_ranges_ext);
-  gkyl_free(mbf->parent_subrangesz);
-  gkyl_free(mbf->block_subrangesz);
-  gkyl_free(mbf->mbcc_allgatherz_send);
-  gkyl_free(mbf->mbcc_allgatherz_recv);
-  gkyl_free(mbf->phi_multibz_dg);
-  gkyl_free(mbf->phi_multibz_smooth);
-  gkyl_free(mbf->rho_c_multibz_dg);
-  gkyl_free(mbf->rho_c_multibz_smooth);
-  gkyl_free(mbf->lhs_weight_multibz);
-  gkyl_free(mbf->rhs_weight_multibz);
-  gkyl_free(mbf->fem_parproj);
 
   if (mbf->cdim > 1) {
     // Free memory allocated for perp solve.
     for (int bI= 0; bI<mbf->num_local_blocks; bI++) {
       gkyl_free(mbf->multib_perp_ranges[bI]);
       gkyl_free(mbf->multib_perp_ranges_ext[bI]);
-      gkyl_free(mbf->parent_subranges_perp[bI]);
       gkyl_free(mbf->block_subranges_perp[bI]);
       gkyl_multib_comm_conn_release(mbf->mbcc_allgather_perp_send[bI]);
       gkyl_multib_comm_conn_release(mbf->mbcc_allgather_perp_recv[bI]);
@@ -613,7 +754,6 @@ gk_multib_field_release(struct gk_multib_field *mbf)
     }
     gkyl_free(mbf->multib_perp_ranges);
     gkyl_free(mbf->multib_perp_ranges_ext);
-    gkyl_free(mbf->parent_subranges_perp);
     gkyl_free(mbf->block_subranges_perp);
     gkyl_free(mbf->mbcc_allgather_perp_send);
     gkyl_free(mbf->mbcc_allgather_perp_recv);
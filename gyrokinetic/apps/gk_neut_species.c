@@ -203,6 +203,22 @@ gk_neut_species_combine_static(struct gkyl_array *out, double c1,
   // do nothing
 }
 
+static void
+gk_neut_species_step_combine_dynamic(struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  gkyl_array_combine3_range(out, c1, arr1, c2, arr2, c2*dt, rhs, rng);
+}
+
+static void
+gk_neut_species_step_combine_static(struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  // do nothing
+}
+
 static void
 gk_neut_species_copy_range_dynamic(struct gkyl_array *out,
   const struct gkyl_array *inp, const struct gkyl_range *range)
@@ -542,8 +558,8 @@ gk_neut_species_new_dynamic(struct gkyl_gk *gk, struct gkyl_gyrokinetic_app *app
   int pdim = cdim+vdim;
   
   // allocate additional distribution function arrays for time stepping
-  s->f1 = mkarr(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
-  s->fnew = mkarr(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
+  s->f1 = mkarr_distf(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
+  s->fnew = mkarr_distf(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
   
   // Allocate cflrate (scalar array).
   s->cflrate = mkarr(app->use_gpu, 1, s->local_ext.volume);
@@ -684,6 +700,7 @@ gk_neut_species_new_dynamic(struct gkyl_gk *gk, struct gkyl_gyrokinetic_app *app
   s->release_func = gk_neut_species_release_dynamic;
   s->step_f_func = gk_neut_species_step_f_dynamic;
   s->combine_func = gk_neut_species_combine_dynamic;
+  s->step_combine_func = gk_neut_species_step_combine_dynamic;
   s->copy_func = gk_neut_species_copy_range_dynamic;
   if (s->enforce_positivity)
     s->apply_pos_shift_func = gk_neut_species_apply_pos_shift_enabled;
@@ -709,6 +726,7 @@ gk_neut_species_new_static(struct gkyl_gk *gk, struct gkyl_gyrokinetic_app *app,
   s->release_func = gk_neut_species_release_static;
   s->step_f_func = gk_neut_species_step_f_static;
   s->combine_func = gk_neut_species_combine_static;
+  s->step_combine_func = gk_neut_species_step_combine_static;
   s->copy_func = gk_neut_species_copy_range_static;
   s->apply_pos_shift_func = gk_neut_species_apply_pos_shift_disabled;
   s->write_func = gk_neut_species_write_static;
@@ -807,26 +825,27 @@ gk_neut_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_neu
   struct gkyl_range global_ext_do, global_do;
   gkyl_create_grid_ranges(&grid_do, ghost_do, &global_ext_do, &global_do);
 
-  // Create a donor communicator.
-  int cuts_tar[GKYL_MAX_DIM] = {-1}, cuts_do[GKYL_MAX_CDIM] = {-1};
-  gkyl_rect_decomp_get_cuts(app->decomp, cuts_tar);
+  // Create a donor communicator. The donor decomposition follows the
+  // app's (possibly cost-weighted) one, so that the donor local range
+  // covers the same part of the domain as the local range.
+  int dirs_do[GKYL_MAX_DIM];
   if (cdim_do == cdim-1) {
     for (int d=0; d<cdim_do-1; d++) {
-      cuts_do[d] = cuts_tar[d];
+      dirs_do[d] = d;
     }
-    cuts_do[cdim_do-1] = cuts_tar[cdim-1];
+    dirs_do[cdim_do-1] = cdim-1;
   }
   else {
     for (int d=0; d<cdim; d++) {
-      cuts_do[d] = cuts_tar[d];
+      dirs_do[d] = d;
     }
   }
-  // Set velocity space cuts to 1 as we do not use MPI in vel-space.
+  // Velocity space is not decomposed as we do not use MPI in vel-space.
   for (int d=0; d<vdim; d++) {
-    cuts_do[cdim_do+d] = 1;
+    dirs_do[cdim_do+d] = -1;
   }
 
-  struct gkyl_rect_decomp *decomp_do = gkyl_rect_decomp_new_from_cuts(pdim_do, cuts_do, &global_do);
+  struct gkyl_rect_decomp *decomp_do = gkyl_rect_decomp_new_from_decomp(app->decomp, dirs_do, &global_do);
   struct gkyl_comm* comm_do = gkyl_comm_split_comm(s->comm, 0, decomp_do);
 
   // Donor local range.
@@ -836,10 +855,12 @@ gk_neut_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_neu
   struct gkyl_range local_ext_do, local_do;
   gkyl_create_ranges(&decomp_do->ranges[my_rank], ghost_do, &local_ext_do, &local_do);
 
-  // Donor array.
-  struct gkyl_array *fdo = mkarr(app->use_gpu, basis_do.num_basis, local_ext_do.volume);
-  struct gkyl_array *fdo_host = app->use_gpu? mkarr(false, basis_do.num_basis, local_ext_do.volume)
-                                            : gkyl_array_acquire(fdo);
+  // Donor array. Host buffers are temporaries from the app's pool.
+  int arena = gkyl_mem_pool_arena_begin(app->mem_pool);
+  struct gkyl_array *fdo_host = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+    basis_do.num_basis, local_ext_do.volume);
+  struct gkyl_array *fdo = app->use_gpu? mkarr(true, basis_do.num_basis, local_ext_do.volume)
+                                       : gkyl_array_acquire(fdo_host);
 
   // Read donor distribution function and Jacobian inverse.
   struct gkyl_app_restart_status rstat;
@@ -854,13 +875,14 @@ gk_neut_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_neu
     struct gkyl_range conf_local_ext_do, conf_local_do, conf_global_ext_do, conf_global_do;
     gkyl_create_grid_ranges(&conf_grid_do, ghost_do, &conf_global_ext_do, &conf_global_do);
     // Create configuration space local ranges
-    struct gkyl_rect_decomp *conf_decomp_do = gkyl_rect_decomp_new_from_cuts(cdim_do, cuts_do, &conf_global_do);
+    struct gkyl_rect_decomp *conf_decomp_do = gkyl_rect_decomp_new_from_decomp(app->decomp, dirs_do, &conf_global_do);
     gkyl_create_ranges(&conf_decomp_do->ranges[my_rank], ghost_do, &conf_local_ext_do, &conf_local_do);
     // Create a configuration space basis.
     struct gkyl_basis conf_basis_do;
     gkyl_cart_modal_serendip(&conf_basis_do, cdim_do, poly_order);
     // Array for Jacobian inverse
-    struct gkyl_array *jacobgeo_inv_do_host = mkarr(false, conf_basis_do.num_basis, conf_local_ext_do.volume);
+    struct gkyl_array *jacobgeo_inv_do_host = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+      conf_basis_do.num_basis, conf_local_ext_do.volume);
     rstat.io_status = gkyl_comm_array_read(comm_do, &conf_grid_do, &conf_local_do, jacobgeo_inv_do_host, inp.jacobtot_inv_file_name);
     gkyl_dg_mul_conf_phase_op_range(&conf_basis_do, &basis_do, fdo_host, jacobgeo_inv_do_host, fdo_host, &conf_local_ext_do, &local_ext_do);
     gkyl_array_release(jacobgeo_inv_do_host);
@@ -895,15 +917,16 @@ gk_neut_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_neu
     // Scale f by a conf-space factor.
     gkyl_proj_on_basis *proj_conf_scale = gkyl_proj_on_basis_new(&app->grid, &app->basis,
       poly_order+1, 1, inp.conf_scale, inp.conf_scale_ctx);
-    struct gkyl_array *xfac = mkarr(app->use_gpu, app->basis.num_basis, app->local_ext.volume);
-    struct gkyl_array *xfac_ho = app->use_gpu? mkarr(false, app->basis.num_basis, app->local_ext.volume)
-                                             : gkyl_array_acquire(xfac_ho);
+    struct gkyl_array *xfac_ho = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+      app->basis.num_basis, app->local_ext.volume);
+    struct gkyl_array *xfac = app->use_gpu? mkarr(true, app->basis.num_basis, app->local_ext.volume)
+                                          : gkyl_array_acquire(xfac_ho);
     gkyl_proj_on_basis_advance(proj_conf_scale, 0.0, &app->local, xfac_ho);
     gkyl_array_copy(xfac, xfac_ho);
     gkyl_dg_mul_conf_phase_op_range(&app->basis, &s->basis, s->f, xfac, s->f, &app->local, &s->local);
     gkyl_proj_on_basis_release(proj_conf_scale);
-    gkyl_array_release(xfac_ho);
     gkyl_array_release(xfac);
+    gkyl_array_release(xfac_ho);
   }
   if (inp.type == GKYL_IC_IMPORT_F_B || inp.type == GKYL_IC_IMPORT_AF_B) {
     // Add a phase factor to f.
@@ -922,6 +945,9 @@ gk_neut_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_neu
   gkyl_comm_release(comm_do);
   gkyl_array_release(fdo);
   gkyl_array_release(fdo_host);
+  gkyl_mem_pool_arena_end(app->mem_pool, arena);
+  // The donor buffers are only needed once.
+  gkyl_mem_pool_trim(app->mem_pool);
 }
 
 static void
@@ -1052,7 +1078,7 @@ gk_neut_species_init(struct gkyl_gk *gk, struct gkyl_gyrokinetic_app *app, struc
   }
 
   // Allocate distribution function array for initialization and I/O.
-  s->f = mkarr(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
+  s->f = mkarr_distf(app->use_gpu, s->basis.num_basis, s->local_ext.volume);
 
   s->f_host = s->f;
   if (app->use_gpu) {
@@ -1261,6 +1287,15 @@ gk_neut_species_combine(struct gk_neut_species *species, struct gkyl_array *out,
   species->combine_func(out, c1, arr1, c2, arr2, rng);
 }
 
+// Fused forward euler step and combine function for rk3 updates.
+void
+gk_neut_species_step_combine(struct gk_neut_species *species, struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  species->step_combine_func(out, c1, arr1, c2, arr2, dt, rhs, rng);
+}
+
 // Copy function for rk3 updates.
 void
 gk_neut_species_copy_range(struct gk_neut_species *species, struct gkyl_array *out,
@@ -760,17 +760,23 @@ gk_neut_species_bflux_init(struct gkyl_gyrokinetic_app *app, void *species,
             struct gkyl_range range_surf;
             gkyl_range_init(&range_surf, surf_dim, lower_surf, upper_surf);
         
-            // Create decomp.
-            int cuts_plane[GKYL_MAX_CDIM], cuts_surf[surf_dim];
-            gkyl_rect_decomp_get_cuts(app->decomp_plane[dir], cuts_plane);
-            c = 0;
-            for (int d=0; d<app->cdim; ++d) {
-              if (d != dir) {
-                cuts_surf[c] = cuts_plane[d];
-                c++;
+            // Create decomp from the local ranges of the ranks on the surface
+            // with dir dropped, so it matches the (possibly cost-weighted) app
+            // decomposition.
+            struct gkyl_range ranges_surf[num_ranks_surf];
+            for (int i=0; i<num_ranks_surf; i++) {
+              const struct gkyl_range *rng = &app->decomp->ranges[ranks_surf[i]];
+              c = 0;
+              for (int d=0; d<app->cdim; ++d) {
+                if (d != dir) {
+                  lower_surf[c] = rng->lower[d];
+                  upper_surf[c] = rng->upper[d];
+                  c++;
+                }
               }
+              gkyl_range_init(&ranges_surf[i], surf_dim, lower_surf, upper_surf);
             }
-            bflux->decomp_surf[dir] = gkyl_rect_decomp_new_from_cuts(surf_dim, cuts_surf, &range_surf);
+            bflux->decomp_surf[dir] = gkyl_rect_decomp_new_from_ranges(num_ranks_surf, ranges_surf, &range_surf);
         
             // Create a new communicator with ranks on surf.
             bool is_comm_valid;
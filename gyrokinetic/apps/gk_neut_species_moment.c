@@ -8,6 +8,8 @@ gk_neut_species_moment_init(struct gkyl_gyrokinetic_app *app, struct gk_neut_spe
 {
   sm->is_integrated = is_integrated;
   sm->is_maxwellian_moms = mom_type == GKYL_F_MOMENT_LTE;
+  sm->mom_type = mom_type;
+  sm->cache = 0;
 
   if (sm->is_integrated) {
     // Create moment operator.
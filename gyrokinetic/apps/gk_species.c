@@ -330,6 +330,22 @@ gk_species_combine_static(struct gkyl_array *out, double c1,
   // do nothing
 }
 
+static void
+gk_species_step_combine_dynamic(struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  gkyl_array_combine3_range(out, c1, arr1, c2, arr2, c2*dt, rhs, rng);
+}
+
+static void
+gk_species_step_combine_static(struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  // do nothing
+}
+
 static void
 gk_species_copy_range_dynamic(struct gkyl_array *out,
   const struct gkyl_array *inp, const struct gkyl_range *range)
@@ -884,8 +900,8 @@ gk_species_new_dynamic(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *
   }
 
   // Allocate distribution function arrays.
-  gks->f1 = mkarr(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
-  gks->fnew = mkarr(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
+  gks->f1 = mkarr_distf(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
+  gks->fnew = mkarr_distf(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
 
   // Allocate cflrate (scalar array).
   gks->cflrate = mkarr(app->use_gpu, 1, gks->local_ext.volume);
@@ -949,18 +965,26 @@ gk_species_new_dynamic(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *
   
   // Determine collision type and initialize it.
   if (gks->info.collisions.collision_id == GKYL_LBO_COLLISIONS) {
+    gkyl_mem_account_push("lbo");
     gk_species_lbo_init(app, gks, &gks->lbo);
+    gkyl_mem_account_pop();
   }
   if (gks->info.collisions.collision_id == GKYL_BGK_COLLISIONS) {
+    gkyl_mem_account_push("bgk");
     gk_species_bgk_init(app, gks, &gks->bgk);
+    gkyl_mem_account_pop();
   }
 
   // Determine reaction type(s) and initialize them.
   if (gks->info.react.num_react) {
+    gkyl_mem_account_push("react");
     gk_species_react_init(app, gks, gks->info.react, &gks->react, true);
+    gkyl_mem_account_pop();
   }
   if (gks->info.react_neut.num_react) {
+    gkyl_mem_account_push("react_neut");
     gk_species_react_init(app, gks, gks->info.react_neut, &gks->react_neut, false);
+    gkyl_mem_account_pop();
   }
 
   // Initialize diffusion if present.
@@ -1041,6 +1065,8 @@ gk_species_new_dynamic(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *
           .shift_func = gks->lower_bc[d].aux_profile,
           .shift_func_ctx = gks->lower_bc[d].aux_ctx,
           .use_gpu = app->use_gpu,
+          .comm = gks->comm,
+          .decomp = app->decomp,
         };
 
         gks->bc_ts_lo = gkyl_bc_twistshift_new(&tsinp);
@@ -1100,6 +1126,8 @@ gk_species_new_dynamic(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *
           .shift_func = gks->upper_bc[d].aux_profile,
           .shift_func_ctx = gks->upper_bc[d].aux_ctx,
           .use_gpu = app->use_gpu,
+          .comm = gks->comm,
+          .decomp = app->decomp,
         };
 
         gks->bc_ts_up = gkyl_bc_twistshift_new(&tsinp);
@@ -1171,6 +1199,7 @@ gk_species_new_dynamic(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *
   gks->release_func = gk_species_release_dynamic;
   gks->step_f_func = gk_species_step_f_dynamic;
   gks->combine_func = gk_species_combine_dynamic;
+  gks->step_combine_func = gk_species_step_combine_dynamic;
   gks->copy_func = gk_species_copy_range_dynamic;
   if (gks->enforce_positivity)
     gks->apply_pos_shift_func = gk_species_apply_pos_shift_enabled;
@@ -1209,6 +1238,7 @@ gk_species_new_static(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *a
   gks->release_func = gk_species_release_static;
   gks->step_f_func = gk_species_step_f_static;
   gks->combine_func = gk_species_combine_static;
+  gks->step_combine_func = gk_species_step_combine_static;
   gks->copy_func = gk_species_copy_range_static;
   gks->apply_pos_shift_func = gk_species_apply_pos_shift_disabled;
   gks->write_func = gk_species_write_static;
@@ -1321,26 +1351,27 @@ gk_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_species
   struct gkyl_range global_ext_do, global_do;
   gkyl_create_grid_ranges(&grid_do, ghost_do, &global_ext_do, &global_do);
 
-  // Create a donor communicator.
-  int cuts_tar[GKYL_MAX_DIM] = {-1}, cuts_do[GKYL_MAX_CDIM] = {-1};
-  gkyl_rect_decomp_get_cuts(app->decomp, cuts_tar);
+  // Create a donor communicator. The donor decomposition follows the
+  // app's (possibly cost-weighted) one, so that the donor local range
+  // covers the same part of the domain as the local range.
+  int dirs_do[GKYL_MAX_DIM];
   if (cdim_do == cdim-1) {
     for (int d=0; d<cdim_do-1; d++) {
-      cuts_do[d] = cuts_tar[d];
+      dirs_do[d] = d;
     }
-    cuts_do[cdim_do-1] = cuts_tar[cdim-1];
+    dirs_do[cdim_do-1] = cdim-1;
   }
   else {
     for (int d=0; d<cdim; d++) {
-      cuts_do[d] = cuts_tar[d];
+      dirs_do[d] = d;
     }
   }
-  // Set velocity space cuts to 1 as we do not use MPI in vel-space.
+  // Velocity space is not decomposed as we do not use MPI in vel-space.
   for (int d=0; d<vdim; d++) {
-    cuts_do[cdim_do+d] = 1;
+    dirs_do[cdim_do+d] = -1;
   }
 
-  struct gkyl_rect_decomp *decomp_do = gkyl_rect_decomp_new_from_cuts(pdim_do, cuts_do, &global_do);
+  struct gkyl_rect_decomp *decomp_do = gkyl_rect_decomp_new_from_decomp(app->decomp, dirs_do, &global_do);
   struct gkyl_comm* comm_do = gkyl_comm_split_comm(gks->comm, 0, decomp_do);
 
   // Donor local range.
@@ -1350,10 +1381,12 @@ gk_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_species
   struct gkyl_range local_ext_do, local_do;
   gkyl_create_ranges(&decomp_do->ranges[my_rank], ghost_do, &local_ext_do, &local_do);
 
-  // Donor array.
-  struct gkyl_array *fdo = mkarr(app->use_gpu, basis_do.num_basis, local_ext_do.volume);
-  struct gkyl_array *fdo_host = app->use_gpu? mkarr(false, basis_do.num_basis, local_ext_do.volume)
-                                            : gkyl_array_acquire(fdo);
+  // Donor array. Host buffers are temporaries from the app's pool.
+  int arena = gkyl_mem_pool_arena_begin(app->mem_pool);
+  struct gkyl_array *fdo_host = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+    basis_do.num_basis, local_ext_do.volume);
+  struct gkyl_array *fdo = app->use_gpu? mkarr(true, basis_do.num_basis, local_ext_do.volume)
+                                       : gkyl_array_acquire(fdo_host);
 
   // Read donor distribution function and Jacobian inverse.
   struct gkyl_app_restart_status rstat;
@@ -1368,13 +1401,14 @@ gk_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_species
     struct gkyl_range conf_local_ext_do, conf_local_do, conf_global_ext_do, conf_global_do;
     gkyl_create_grid_ranges(&conf_grid_do, ghost_do, &conf_global_ext_do, &conf_global_do);
     // Create configuration space local ranges
-    struct gkyl_rect_decomp *conf_decomp_do = gkyl_rect_decomp_new_from_cuts(cdim_do, cuts_do, &conf_global_do);
+    struct gkyl_rect_decomp *conf_decomp_do = gkyl_rect_decomp_new_from_decomp(app->decomp, dirs_do, &conf_global_do);
     gkyl_create_ranges(&conf_decomp_do->ranges[my_rank], ghost_do, &conf_local_ext_do, &conf_local_do);
     // Create a configuration space basis.
     struct gkyl_basis conf_basis_do;
     gkyl_cart_modal_serendip(&conf_basis_do, cdim_do, poly_order);
     // Array for Jacobian inverse
-    struct gkyl_array *jacobtot_inv_do_host = mkarr(false, conf_basis_do.num_basis, conf_local_ext_do.volume);
+    struct gkyl_array *jacobtot_inv_do_host = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+      conf_basis_do.num_basis, conf_local_ext_do.volume);
     rstat.io_status = gkyl_comm_array_read(comm_do, &conf_grid_do, &conf_local_do, jacobtot_inv_do_host, inp.jacobtot_inv_file_name);
     gkyl_dg_mul_conf_phase_op_range(&conf_basis_do, &basis_do, fdo_host, jacobtot_inv_do_host, fdo_host, &conf_local_ext_do, &local_ext_do);
     gkyl_array_release(jacobtot_inv_do_host);
@@ -1409,15 +1443,16 @@ gk_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_species
     // Scale f by a conf-space factor.
     gkyl_proj_on_basis *proj_conf_scale = gkyl_proj_on_basis_new(&app->grid, &app->basis,
       poly_order+1, 1, inp.conf_scale, inp.conf_scale_ctx);
-    struct gkyl_array *xfac = mkarr(app->use_gpu, app->basis.num_basis, app->local_ext.volume);
-    struct gkyl_array *xfac_ho = app->use_gpu? mkarr(false, app->basis.num_basis, app->local_ext.volume)
-                                             : gkyl_array_acquire(xfac);
+    struct gkyl_array *xfac_ho = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,
+      app->basis.num_basis, app->local_ext.volume);
+    struct gkyl_array *xfac = app->use_gpu? mkarr(true, app->basis.num_basis, app->local_ext.volume)
+                                          : gkyl_array_acquire(xfac_ho);
     gkyl_proj_on_basis_advance(proj_conf_scale, 0.0, &app->local, xfac_ho);
     gkyl_array_copy(xfac, xfac_ho);
     gkyl_dg_mul_conf_phase_op_range(&app->basis, &gks->basis, gks->f, xfac, gks->f, &app->local, &gks->local);
     gkyl_proj_on_basis_release(proj_conf_scale);
-    gkyl_array_release(xfac_ho);
     gkyl_array_release(xfac);
+    gkyl_array_release(xfac_ho);
   }
   if (inp.type == GKYL_IC_IMPORT_F_B || inp.type == GKYL_IC_IMPORT_AF_B) {
     // Add a phase factor to f.
@@ -1436,6 +1471,9 @@ gk_species_file_import_init(struct gkyl_gyrokinetic_app *app, struct gk_species
   gkyl_comm_release(comm_do);
   gkyl_array_release(fdo);
   gkyl_array_release(fdo_host);
+  gkyl_mem_pool_arena_end(app->mem_pool, arena);
+  // The donor buffers are only needed once.
+  gkyl_mem_pool_trim(app->mem_pool);
 }
 
 static bool
@@ -1622,7 +1660,7 @@ gk_species_init(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *app, st
   }
 
   // Allocate distribution function arrays.
-  gks->f = mkarr(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
+  gks->f = mkarr_distf(app->use_gpu, gks->basis.num_basis, gks->local_ext.volume);
 
   gks->f_host = gks->f;
   if (app->use_gpu) {
@@ -1682,11 +1720,17 @@ gk_species_init(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *app, st
   // Allocate data for density (for charge density or upar calculation).
   gk_species_moment_init(app, gks, &gks->m0, GKYL_F_MOMENT_M0, false);
 
+  // Moments of f shared by the collision, reaction and radiation terms are
+  // created when the first of them registers with the cache.
+  gks->moms_cache = 0;
+
   // Allocate data for diagnostic moments.
   int ndm = gks->info.num_diag_moments;
   gks->moms = gkyl_malloc(sizeof(struct gk_species_moment[ndm]));
+  gkyl_mem_account_push("diagnostics");
   for (int m=0; m<ndm; ++m)
     gk_species_moment_init(app, gks, &gks->moms[m], gks->info.diag_moments[m], false);
+  gkyl_mem_account_pop();
 
   // initialize projection routine for initial conditions
   if (gks->info.init_from_file.type == 0) {
@@ -1790,7 +1834,9 @@ gk_species_init(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *app, st
   }
 
   // Introduce new moments into moms_inp if needed.
+  gkyl_mem_account_push("bflux");
   gk_species_bflux_init(app, gks, &gks->bflux, bflux_type, add_bflux_moms_inp);
+  gkyl_mem_account_pop();
   
   // Initialize a Maxwellian/LTE (local thermodynamic equilibrium) projection routine
   // Projection routine optionally corrects all the Maxwellian/LTE moments
@@ -1803,7 +1849,9 @@ gk_species_init(struct gkyl_gk *gk_app_inp, struct gkyl_gyrokinetic_app *app, st
   struct correct_all_moms_inp corr_inp = { .correct_all_moms = correct_all_moms, 
     .max_iter = max_iter, .iter_eps = iter_eps, 
     .use_last_converged = use_last_converged };
+  gkyl_mem_account_push("lte");
   gk_species_lte_init(app, gks, &gks->lte, corr_inp);
+  gkyl_mem_account_pop();
 
   // Initialize empty structs. New methods will fill them if specified.
   gks->src = (struct gk_source) { };
@@ -1953,6 +2001,15 @@ gk_species_combine(struct gk_species *species, struct gkyl_array *out, double c1
   species->combine_func(out, c1, arr1, c2, arr2, rng);
 }
 
+// Fused forward euler step and combine function for rk3 updates.
+void
+gk_species_step_combine(struct gk_species *species, struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng)
+{
+  species->step_combine_func(out, c1, arr1, c2, arr2, dt, rhs, rng);
+}
+
 // Copy function for rk3 updates.
 void
 gk_species_copy_range(struct gk_species *species, struct gkyl_array *out,
@@ -2057,6 +2114,8 @@ gk_species_release(const gkyl_gyrokinetic_app* app, const struct gk_species *s)
 
   // Release moment data.
   gk_species_moment_release(app, &s->m0);
+  if (s->moms_cache)
+    gk_species_moment_cache_release(app, s->moms_cache);
   for (int i=0; i<s->info.num_diag_moments; ++i) {
     gk_species_moment_release(app, &s->moms[i]);
   }
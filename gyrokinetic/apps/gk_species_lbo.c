@@ -108,6 +108,7 @@ gk_species_lbo_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s, stru
 
   // Allocate moments needed for LBO update.
   gk_species_moment_init(app, s, &lbo->moms, GKYL_F_MOMENT_M0M1M2, false);
+  gk_species_moment_use_cache(app, s, &lbo->moms);
 
   // Allocate needed arrays (boundary corrections, primitive moments, and nu*primitive moments)
   lbo->boundary_corrections = mkarr(app->use_gpu, 2*app->basis.num_basis, app->local_ext.volume);
@@ -139,6 +140,7 @@ gk_species_lbo_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s, stru
 
     // Allocate moments app used to compute vtsq.
     gk_species_moment_init(app, s, &lbo->maxwellian_moms, GKYL_F_MOMENT_MAXWELLIAN, false);
+    gk_species_moment_use_cache(app, s, &lbo->maxwellian_moms);
 
     lbo->vtsq = mkarr(app->use_gpu, app->basis.num_basis, app->local_ext.volume);
 
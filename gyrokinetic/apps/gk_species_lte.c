@@ -9,6 +9,7 @@ gk_species_lte_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s, stru
 
   // Allocate moments needed for Maxwellian (LTE=local thermodynamic equilibrium) update.
   gk_species_moment_init(app, s, &lte->moms, GKYL_F_MOMENT_MAXWELLIAN, false);
+  gk_species_moment_use_cache(app, s, &lte->moms);
 
   struct gkyl_gk_maxwellian_proj_on_basis_inp inp_proj = {
     .phase_grid = &s->grid,
@@ -7,6 +7,8 @@ gk_species_moment_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
   struct gk_species_moment *sm, enum gkyl_distribution_moments mom_type, bool is_integrated)
 {
   sm->is_integrated = is_integrated;
+  sm->mom_type = mom_type;
+  sm->cache = 0;
   sm->is_maxwellian_moms = mom_type == GKYL_F_MOMENT_MAXWELLIAN;
   sm->is_bimaxwellian_moms = mom_type == GKYL_F_MOMENT_BIMAXWELLIAN;
 
@@ -72,11 +74,97 @@ gk_species_moment_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
   }
 }
 
+void
+gk_species_moment_use_cache(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
+  struct gk_species_moment *sm)
+{
+  if (sm->is_integrated)
+    return;
+  if (!(sm->mom_type == GKYL_F_MOMENT_M0 || sm->mom_type == GKYL_F_MOMENT_M0M1M2
+        || sm->is_maxwellian_moms || sm->is_bimaxwellian_moms))
+    return;
+
+  if (!s->moms_cache) {
+    struct gk_species_moment_cache *cache = gkyl_malloc(sizeof(*cache));
+    cache->mcalc = gkyl_dg_updater_moment_gyrokinetic_new(&s->grid, &app->basis, 
+      &s->basis, &app->local, s->info.mass, s->info.charge, s->vel_map, app->gk_geom,
+      0, GKYL_F_MOMENT_M0M1M2PARM2PERP, false, app->use_gpu);
+    int num_mom = gkyl_dg_updater_moment_gyrokinetic_num_mom(cache->mcalc);
+    cache->marr = mkarr(app->use_gpu, num_mom*app->basis.num_basis, app->local_ext.volume);
+    cache->m0m1m2 = mkarr(app->use_gpu, 3*app->basis.num_basis, app->local_ext.volume);
+    cache->m2perp = num_mom > 3 ? mkarr(app->use_gpu, app->basis.num_basis, app->local_ext.volume) : 0;
+    cache->phase_rng = s->local;
+    cache->conf_rng = app->local;
+    cache->app_epoch = &app->moms_epoch;
+    cache->epoch = 0;
+    cache->fin = 0;
+    s->moms_cache = cache;
+  }
+  sm->cache = s->moms_cache;
+}
+
+void
+gk_species_moment_cache_begin(struct gkyl_gyrokinetic_app *app)
+{
+  app->moms_epoch = ++app->moms_epoch_count;
+}
+
+void
+gk_species_moment_cache_end(struct gkyl_gyrokinetic_app *app)
+{
+  app->moms_epoch = 0;
+}
+
+// Compute the moments from the cache, updating it first if it doesn't hold
+// the moments of fin. Returns false if the cache can't be used.
+static bool
+gk_species_moment_calc_cached(const struct gk_species_moment *sm,
+  const struct gkyl_range *phase_rng, const struct gkyl_range *conf_rng,
+  const struct gkyl_array *fin)
+{
+  struct gk_species_moment_cache *cache = sm->cache;
+  if (*cache->app_epoch == 0 || !gkyl_range_compare(phase_rng, &cache->phase_rng)
+      || !gkyl_range_compare(conf_rng, &cache->conf_rng))
+    return false;
+
+  if (cache->fin != fin || cache->epoch != *cache->app_epoch) {
+    gkyl_dg_updater_moment_gyrokinetic_advance(cache->mcalc, 
+      phase_rng, conf_rng, fin, cache->marr);
+
+    // M2 = M2par + M2perp (M2 = M2par if vdim=1).
+    gkyl_array_set_range(cache->m0m1m2, 1.0, cache->marr, conf_rng);
+    if (cache->m2perp) {
+      int num_basis = cache->m2perp->ncomp;
+      gkyl_array_set_offset_range(cache->m2perp, 1.0, cache->marr, 3*num_basis, conf_rng);
+      gkyl_array_accumulate_offset_range(cache->m0m1m2, 1.0, cache->m2perp, 2*num_basis, conf_rng);
+    }
+
+    cache->fin = fin;
+    cache->epoch = *cache->app_epoch;
+  }
+
+  if (sm->is_maxwellian_moms)
+    gkyl_gk_maxwellian_moments_from_moms_advance(sm->gyrokinetic_maxwellian_moms, 
+      conf_rng, cache->marr, sm->marr);
+  else if (sm->is_bimaxwellian_moms)
+    gkyl_gk_bimaxwellian_moments_from_moms_advance(sm->gyrokinetic_maxwellian_moms, 
+      conf_rng, cache->marr, sm->marr);
+  else if (sm->mom_type == GKYL_F_MOMENT_M0M1M2)
+    gkyl_array_set_range(sm->marr, 1.0, cache->m0m1m2, conf_rng);
+  else
+    gkyl_array_set_offset_range(sm->marr, 1.0, cache->marr, 0, conf_rng);
+
+  return true;
+}
+
 void
 gk_species_moment_calc(const struct gk_species_moment *sm,
   const struct gkyl_range phase_rng, const struct gkyl_range conf_rng,
   const struct gkyl_array *fin)
 {
+  if (sm->cache && gk_species_moment_calc_cached(sm, &phase_rng, &conf_rng, fin))
+    return;
+
   if (sm->is_integrated) {
     gkyl_dg_updater_moment_gyrokinetic_advance(sm->mcalc, 
       &phase_rng, &conf_rng, fin, sm->marr);
@@ -119,3 +207,15 @@ gk_species_moment_release(const struct gkyl_gyrokinetic_app *app, const struct g
     gkyl_dg_bin_op_mem_release(sm->mem_geo);
   }
 }
+
+void
+gk_species_moment_cache_release(const struct gkyl_gyrokinetic_app *app,
+  struct gk_species_moment_cache *cache)
+{
+  gkyl_dg_updater_moment_gyrokinetic_release(cache->mcalc);
+  gkyl_array_release(cache->marr);
+  gkyl_array_release(cache->m0m1m2);
+  if (cache->m2perp)
+    gkyl_array_release(cache->m2perp);
+  gkyl_free(cache);
+}
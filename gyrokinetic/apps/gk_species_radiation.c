@@ -109,6 +109,7 @@ gk_species_radiation_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s
       rad->is_neut_species[i] = false;
       // allocate density calculation needed for radiation update
       gk_species_moment_init(app, rad->collide_with[i], &rad->moms[i], GKYL_F_MOMENT_M0, false);
+      gk_species_moment_use_cache(app, rad->collide_with[i], &rad->moms[i]);
     }
 
     if (status == 1) {
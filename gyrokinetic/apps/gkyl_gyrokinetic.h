@@ -415,6 +415,16 @@ struct gkyl_gk {
   bool enforce_positivity; // Enforce f>=0 for all species and quasineutrality
                            // of charged species after enforcing f_s>=0.
 
+  bool fuse_rk_stages; // Take the forward Euler step of each RK stage in the
+                       // same pass over f as the stage combination.
+
+  enum gkyl_time_stepper_type time_stepper; // Explicit time-stepper (default
+                                            // GKYL_SSP_RK3). GKYL_SSP_RK43
+                                            // allows twice the forward Euler dt.
+
+  bool use_hw_counters; // Also measure hardware counters (cycles,
+                        // instructions, cache misses) in timed regions.
+
   int num_periodic_dir; // Number of periodic directions.
   int periodic_dirs[3]; // List of periodic directions.
 
@@ -539,6 +549,10 @@ struct gkyl_gyrokinetic_stat {
   long n_field_diag; // total number of calls to diagnostics for field
   long n_field_io; // number of calls to IO for field
   long n_field_diag_io; // number of calls to IO for field diagnostics
+
+  long numa_local_pages; // pages of the distribution functions on the NUMA node of the rank
+                         // (counted when the app is created)
+  long numa_remote_pages; // pages of the distribution functions on another NUMA node
 };
 
 // Object representing gk app
@@ -1059,6 +1073,17 @@ void gkyl_gyrokinetic_app_write_conf(gkyl_gyrokinetic_app* app, double tm, int f
  */
 void gkyl_gyrokinetic_app_write(gkyl_gyrokinetic_app* app, double tm, int frame);
 
+/**
+ * Write the times (and hardware counters, if measured) of the timed
+ * regions of the app, with their min, max and average over ranks, to
+ * <name>-timers.json, and the average self time of each region to
+ * <name>-timers.folded for flame-graph tools. Called by
+ * gkyl_gyrokinetic_app_stat_write.
+ *
+ * @param app App object.
+ */
+void gkyl_gyrokinetic_app_write_region_timers(gkyl_gyrokinetic_app* app);
+
 /**
  * Write stats to file. Data is written in json format.
  *
@@ -1066,6 +1091,36 @@ void gkyl_gyrokinetic_app_write(gkyl_gyrokinetic_app* app, double tm, int frame)
  */
 void gkyl_gyrokinetic_app_stat_write(gkyl_gyrokinetic_app* app);
 
+/**
+ * Estimate the array memory per rank of an app from its inputs, without
+ * creating the app or allocating anything, so it can be called before
+ * gkyl_gyrokinetic_app_new. It counts the geometry, field and species
+ * arrays from the grids, basis and species inputs; updater workspaces and
+ * optional operators (sources, reactions, radiation, diagnostics) are not
+ * included, so gkyl_gyrokinetic_app_mem_report of the created app gives
+ * somewhat more.
+ *
+ * @param gk App inputs.
+ * @param iostream Where to write estimate to (NULL for none).
+ * @return Estimated array bytes per rank.
+ */
+double gkyl_gyrokinetic_app_mem_estimate(const struct gkyl_gk *gk, FILE *iostream);
+
+/**
+ * Write the current and peak array memory used by each species,
+ * operator and the field, and the peak array memory per rank (max over
+ * ranks). The numbers are for the whole process, so they include other
+ * apps in it. If target_bytes is positive, also suggest the number of
+ * cuts along z needed for the peak memory per rank to fit in it.
+ *
+ * @param app App object.
+ * @param target_bytes Target memory per rank, in bytes (0 for none).
+ * @param iostream Where to write report to (e.g. stdout, stderr).
+ * @return Suggested number of cuts along z (same as now if target is met).
+ */
+int gkyl_gyrokinetic_app_mem_report(gkyl_gyrokinetic_app* app, double target_bytes,
+  FILE *iostream);
+
 /**
  * Print timing of solver components to iostream.
  *
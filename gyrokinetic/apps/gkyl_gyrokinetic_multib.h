@@ -186,10 +186,25 @@ struct gkyl_gyrokinetic_multib {
   // geometry and topology of all blocks in simulation
   struct gkyl_gk_block_geom *gk_block_geom;
 
+  // If true, ignore the cuts in the block geometry and choose the
+  // number of ranks and cuts of each block to balance the cost on
+  // each rank.
+  bool auto_decomp;
+  // Optional measured cost of each block (e.g. wall-clock time per
+  // step from an earlier run), used if auto_decomp is true. If NULL,
+  // the cost of a block is proportional to its number of cells.
+  const double *block_cost;
+
   double cfl_frac; // CFL fraction to use (default 1.0)
 
   bool enforce_positivity; // Positivity enforcement via shift in f.
 
+  bool fuse_rk_stages; // Take the forward Euler step of each RK stage in the
+                       // same pass over f as the stage combination.
+
+  bool use_hw_counters; // Also measure hardware counters (cycles,
+                        // instructions, cache misses) in timed regions.
+
   int num_species; // number of species
   // species inputs
   struct gkyl_gyrokinetic_multib_species species[GKYL_MAX_SPECIES];
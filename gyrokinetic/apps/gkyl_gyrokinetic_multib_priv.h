@@ -5,6 +5,8 @@
 #include <gkyl_gyrokinetic_priv.h>
 #include <gkyl_gyrokinetic_multib.h>
 #include <gkyl_rrobin_decomp.h>
+#include <gkyl_block_rank_map.h>
+#include <gkyl_fem_parproj_schur.h>
 #include <gkyl_multib_comm_conn.h>
 #include <gkyl_rescale_ghost_jacf.h>
 
@@ -25,6 +27,8 @@ struct gkyl_gyrokinetic_multib_app {
   
   double cfl_frac; // CFL fraction to use
   double bmag_ref; // Reference magnetic field
+  bool fuse_rk_stages; // =true leaves the RHS in fout after the forward Euler
+                       // step, and steps f when combining the RK stages.
   int num_species; // number of species
   int num_neut_species; // number of neutral species
 
@@ -40,7 +44,8 @@ struct gkyl_gyrokinetic_multib_app {
   int *local_blocks; // local blocks IDs handled by current rank
   struct gkyl_gyrokinetic_app **singleb_apps; // App objects: one per local block
 
-  const struct gkyl_rrobin_decomp *round_robin; // round-robin decomp
+  const struct gkyl_rrobin_decomp *round_robin; // round-robin decomp (user cuts)
+  const struct gkyl_block_rank_map *rank_map; // cost-balanced map (auto_decomp)
   struct gkyl_rect_decomp **decomp; // list of decomps (num_blocks)
 
   struct gkyl_mbcc_sr *mbcc_sync_conf; // Connections for conf-space sync.
@@ -54,6 +59,7 @@ struct gkyl_gyrokinetic_multib_app {
   double tcurr; // current time
   
   struct gkyl_gyrokinetic_stat stat; // statistics
+  gkyl_region_timer *rtimer; // Timer of the regions of the time loop.
 
   gkyl_dynvec dts; // Record time step over time.
   bool is_first_dt_write_call; // flag for integrated moments dynvec written first time
@@ -72,6 +78,7 @@ struct gk_multib_field {
   struct gkyl_gyrokinetic_multib_field info; // data for field
   enum gkyl_gkfield_id gkfield_id; // type of field
   int num_local_blocks; // total number of blocks on current rank
+  int num_blocks; // total number of blocks
   int cdim; // number of configuration space dimensions
 
   struct gkyl_array **phi_local;
@@ -80,13 +87,28 @@ struct gk_multib_field {
   //
   // Objects for parallel smoothing.
   //
+  // On the CPU each local block solves for its piece of the field line,
+  // and only exchanges data on the interfaces between pieces with the
+  // other pieces along the field line (see gkyl_fem_parproj_schur.h).
+  // On the GPU the data along the field line is allgathered instead.
+  bool use_schur;
+  // Decomps with a single cell along z per piece, for interface data.
+  struct gkyl_rect_decomp **decomp_iface;
+  // Comm conn for sends/recvs of interface data.
+  struct gkyl_multib_comm_conn **mbcc_iface_send;
+  struct gkyl_multib_comm_conn **mbcc_iface_recv;
+  struct gkyl_range *iface_ranges; // Interface data range of local pieces.
+  struct gkyl_range *chain_ranges; // Interface data range of all pieces along z.
+  struct gkyl_array **resid_local; // Interface residuals of local pieces.
+  struct gkyl_array **resid_chain; // Interface residuals of all pieces along z.
+  struct gkyl_fem_parproj_schur **fem_parproj_schur; // Substructured smoother.
+
   // Comm conn for sends/recvs in allgather.
   struct gkyl_multib_comm_conn **mbcc_allgatherz_send;
   struct gkyl_multib_comm_conn **mbcc_allgatherz_recv;
   struct gkyl_range **multibz_ranges; // Multib ranges.
   struct gkyl_range **multibz_ranges_ext; // Extended multib ranges.
   struct gkyl_range **block_subrangesz; // Ranges for copying from multib to local range.
-  struct gkyl_range **parent_subrangesz; // Ranges for copying from multib to global range.
   // Parallel multib potential (DG and smoothed).
   struct gkyl_array **phi_multibz_dg;
   struct gkyl_array **phi_multibz_smooth;
@@ -99,15 +121,16 @@ struct gk_multib_field {
   struct gkyl_fem_parproj **fem_parproj; // FEM smoothing operator.
   
   //
-  // Objects for perpendicular Poisson solve.
+  // Objects for perpendicular Poisson solve. The perpendicular planes
+  // are independent, so each rank only gathers the blocks along x in
+  // its own slab of z.
   //
-  // Comm conn for sends/recvs in allgather.
+  // Comm conn for sends/recvs in gather.
   struct gkyl_multib_comm_conn **mbcc_allgather_perp_send;
   struct gkyl_multib_comm_conn **mbcc_allgather_perp_recv;
-  struct gkyl_range **multib_perp_ranges; // Multib ranges.
+  struct gkyl_range **multib_perp_ranges; // Multib ranges (local z slab).
   struct gkyl_range **multib_perp_ranges_ext; // Extended multib ranges.
   struct gkyl_range **block_subranges_perp; // Ranges for copying from multib to local range.
-  struct gkyl_range **parent_subranges_perp; // Ranges for copying from multib to global range.
   // Potential and charge density on perpendicular multib range.
   struct gkyl_array **phi_multib_perp;
   struct gkyl_array **rho_c_multib_perp;
@@ -115,6 +138,27 @@ struct gk_multib_field {
   struct gkyl_fem_poisson_perp **fem_poisson; // Perpendicular Poisson solver.
 };
 
+/**
+ * Get the list of ranks handling a block. The i-th rank handles the
+ * i-th sub-range of the decomposition of the block.
+ *
+ * @param mbapp Multiblock gyrokinetic app.
+ * @param bid Block ID.
+ * @param ranks On output, list of ranks handling block @a bid.
+ * @return Number of ranks handling block @a bid.
+ */
+int gyrokinetic_multib_block_ranks(const struct gkyl_gyrokinetic_multib_app *mbapp, int bid, int *ranks);
+
+/**
+ * Get the cuts used to decompose a block: those in the block geometry,
+ * or those chosen by the block-to-rank map if auto_decomp is set.
+ *
+ * @param mbapp Multiblock gyrokinetic app.
+ * @param bid Block ID.
+ * @param cuts On output, number of cuts in each direction.
+ */
+void gyrokinetic_multib_block_cuts(const struct gkyl_gyrokinetic_multib_app *mbapp, int bid, int *cuts);
+
 /** Time stepping API */
 
 /**
@@ -84,6 +84,7 @@
 #include <gkyl_radiation_read.h>
 #include <gkyl_rect_decomp.h>
 #include <gkyl_rect_grid.h>
+#include <gkyl_region_timer.h>
 #include <gkyl_spitzer_coll_freq.h>
 #include <gkyl_skin_surf_from_ghost.h>
 #include <gkyl_tok_geo.h>
@@ -114,6 +115,21 @@ struct correct_all_moms_inp {
   bool use_last_converged; // use last iteration value regardless of convergence?
 };
 
+// Cache of the velocity moments J*(M0, M1, M2par[, M2perp]) of a species'
+// distribution function, computed in a single sweep over f and shared by
+// the moments that registered with it. Entries are only valid while
+// app->moms_epoch is nonzero and unchanged (i.e. within one RHS evaluation).
+struct gk_species_moment_cache {
+  struct gkyl_dg_updater_moment *mcalc; // Updater for M0, M1, M2par and M2perp.
+  struct gkyl_array *marr; // J*(M0, M1, M2par[, M2perp]).
+  struct gkyl_array *m0m1m2; // J*(M0, M1, M2) with M2 = M2par + M2perp.
+  struct gkyl_array *m2perp; // J*M2perp buffer (NULL if vdim=1).
+  struct gkyl_range phase_rng, conf_rng; // Ranges the cached moments cover.
+  const long *app_epoch; // Pointer to app->moms_epoch.
+  long epoch; // Value of app->moms_epoch when marr was computed.
+  const struct gkyl_array *fin; // Distribution function marr was computed from.
+};
+
 // data for gyrokinetic moments
 struct gk_species_moment {
   struct gk_geometry *gk_geom; // geometry struct for dividing moments by Jacobian
@@ -144,6 +160,8 @@ struct gk_species_moment {
   };
   bool is_maxwellian_moms;
   bool is_bimaxwellian_moms;
+  enum gkyl_distribution_moments mom_type; // Type of moment computed.
+  struct gk_species_moment_cache *cache; // Cache this moment is served from (NULL if none).
 };
 
 struct gk_rad_drag {  
@@ -654,6 +672,7 @@ struct gk_species {
   struct gkyl_dg_calc_gyrokinetic_vars *calc_gk_vars;
 
   struct gk_species_moment m0; // for computing charge density
+  struct gk_species_moment_cache *moms_cache; // Shared velocity moments of f (NULL if unused).
   struct gk_species_moment integ_moms; // integrated moments
   struct gk_species_moment *moms; // diagnostic moments
   double *red_integ_diag, *red_integ_diag_global; // for reduction of integrated moments
@@ -758,6 +777,9 @@ struct gk_species {
   void (*combine_func)(struct gkyl_array *out, double c1,
     const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
     const struct gkyl_range *rng);
+  void (*step_combine_func)(struct gkyl_array *out, double c1,
+    const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+    double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng);
   void (*copy_func)(struct gkyl_array *out, const struct gkyl_array *inp,
     const struct gkyl_range *range);
   void (*apply_pos_shift_func)(gkyl_gyrokinetic_app* app, struct gk_species *gks);
@@ -905,6 +927,9 @@ struct gk_neut_species {
   void (*combine_func)(struct gkyl_array *out, double c1,
     const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
     const struct gkyl_range *rng);
+  void (*step_combine_func)(struct gkyl_array *out, double c1,
+    const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+    double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng);
   void (*copy_func)(struct gkyl_array *out, const struct gkyl_array *inp,
     const struct gkyl_range *range);
   void (*write_func)(gkyl_gyrokinetic_app* app, struct gk_neut_species *gkns, double tm, int frame);
@@ -1079,14 +1104,26 @@ struct gkyl_gyrokinetic_app {
 
   bool enforce_positivity; // =true enforces positivity for all species and
                            // enforces quasineutrality of the shift for charged species.
+
+  bool fuse_rk_stages; // =true leaves the RHS in fout after the forward Euler
+                       // step, and steps f when combining the RK stages.
+
+  enum gkyl_time_stepper_type time_stepper; // Explicit SSP-RK method.
+
+  long moms_epoch; // Nonzero while species moment caches may be used.
+  long moms_epoch_count; // Number of epochs opened so far.
   struct gkyl_array *ps_delta_m0_ions; // Number density of the total ion positivity shift.
   struct gkyl_array *ps_delta_m0_elcs; // Number density of the total elc positivity shift.
   void (*pos_shift_quasineutrality_func)(gkyl_gyrokinetic_app *app);
   
   // pointer to function that takes a single-step of simulation
   struct gkyl_update_status (*update_func)(gkyl_gyrokinetic_app *app, double dt0);
+  // Explicit SSP-RK stepper, called by update_func.
+  struct gkyl_update_status (*ssp_rk_func)(gkyl_gyrokinetic_app *app, double dt0);
 
   struct gkyl_gyrokinetic_stat stat; // statistics
+  gkyl_region_timer *rtimer; // Timer of the regions of the time loop.
+  gkyl_mem_pool *mem_pool; // Pool of temporary host arrays (geometry I/O, IC import).
 
   gkyl_dynvec dts; // Record time step over time.
   bool is_first_dt_write_call; // flag for integrated moments dynvec written first time
@@ -1192,6 +1229,46 @@ int gk_find_neut_species_idx(const gkyl_gyrokinetic_app *app, const char *nm);
 void gk_species_moment_init(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
   struct gk_species_moment *sm, enum gkyl_distribution_moments mom_type, bool is_integrated);
 
+/**
+ * Register a species moment with the species' moment cache, so that it is
+ * computed from velocity moments shared with other registered moments of
+ * the same distribution function instead of in its own sweep over it.
+ * Only M0, M0M1M2, Maxwellian and Bi-Maxwellian moments can be cached;
+ * other moments are left as they are.
+ *
+ * @param app gyrokinetic app object
+ * @param s Species object whose distribution function the moment is of
+ * @param sm Species moment object
+ */
+void gk_species_moment_use_cache(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
+  struct gk_species_moment *sm);
+
+/**
+ * Start a new moment cache epoch: moments computed from here on can be
+ * reused by other registered moments of the same distribution function,
+ * until gk_species_moment_cache_end is called. Distribution functions must
+ * not be modified in between.
+ *
+ * @param app gyrokinetic app object
+ */
+void gk_species_moment_cache_begin(struct gkyl_gyrokinetic_app *app);
+
+/**
+ * End the current moment cache epoch.
+ *
+ * @param app gyrokinetic app object
+ */
+void gk_species_moment_cache_end(struct gkyl_gyrokinetic_app *app);
+
+/**
+ * Release a species moment cache.
+ *
+ * @param app gyrokinetic app object
+ * @param cache Moment cache to release
+ */
+void gk_species_moment_cache_release(const struct gkyl_gyrokinetic_app *app,
+  struct gk_species_moment_cache *cache);
+
 /**
  * Calculate moment, given distribution function @a fin.
  * 
@@ -2244,6 +2321,25 @@ void gk_species_combine(struct gk_species *species, struct gkyl_array *out, doub
   const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
   const struct gkyl_range *rng);
 
+/**
+ * Forward Euler step and rk3 combination in a single pass over the
+ * arrays: out = c1*arr1 + c2*(arr2 + dt*rhs). out may be any of the
+ * input arrays.
+ *
+ * @param species Pointer to species.
+ * @param out Output array.
+ * @param c1 Scaling factor.
+ * @param arr1 Input array.
+ * @param c2 Scaling factor.
+ * @param arr2 Input array the forward Euler step is taken from.
+ * @param dt Timestep.
+ * @param rhs Time rate of change of arr2.
+ * @param rng Range.
+ */
+void gk_species_step_combine(struct gk_species *species, struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng);
+
 /**
  * Copy for rk3 method.
  *
@@ -2833,6 +2929,25 @@ void gk_neut_species_combine(struct gk_neut_species *species, struct gkyl_array
   const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
   const struct gkyl_range *rng);
 
+/**
+ * Forward Euler step and rk3 combination in a single pass over the
+ * arrays: out = c1*arr1 + c2*(arr2 + dt*rhs). out may be any of the
+ * input arrays.
+ *
+ * @param species Pointer to species.
+ * @param out Output array.
+ * @param c1 Scaling factor.
+ * @param arr1 Input array.
+ * @param c2 Scaling factor.
+ * @param arr2 Input array the forward Euler step is taken from.
+ * @param dt Timestep.
+ * @param rhs Time rate of change of arr2.
+ * @param rng Range.
+ */
+void gk_neut_species_step_combine(struct gk_neut_species *species, struct gkyl_array *out, double c1,
+  const struct gkyl_array *arr1, double c2, const struct gkyl_array *arr2,
+  double dt, const struct gkyl_array *rhs, const struct gkyl_range *rng);
+
 /**
  * Copy for rk3 method.
  *
@@ -3028,8 +3143,46 @@ void gyrokinetic_rhs(gkyl_gyrokinetic_app* app, double tcurr, double dt,
  * @param app Gyrokinetic app.
  * @param dt0 Suggessted time step.
  */
+/**
+ * Take a forward Euler step with the suggested time-step dt. This may
+ * not be the actual time-step taken, which is returned in the status
+ * object together with the suggested time-step. If app->fuse_rk_stages
+ * is set fout keeps df/dt and f is stepped when the stages are combined.
+ *
+ * @param app Gyrokinetic app.
+ * @param tcurr Current simulation time.
+ * @param dt Suggested time step.
+ * @param fin Input array of charged-species distribution functions.
+ * @param fout Output array of charged-species distribution functions.
+ * @param bflux_in Input array of charged-species boundary fluxes.
+ * @param bflux_out Output array of charged-species boundary fluxes.
+ * @param fin_neut Input array of neutral-species distribution functions.
+ * @param fout_neut Output array of neutral-species distribution functions.
+ * @param bflux_in_neut Input array of neutral-species boundary fluxes.
+ * @param bflux_out_neut Output array of neutral-species boundary fluxes.
+ * @param st Time stepping status object.
+ */
+void gyrokinetic_forward_euler(gkyl_gyrokinetic_app* app, double tcurr, double dt,
+  const struct gkyl_array *fin[], struct gkyl_array *fout[],
+  const struct gkyl_array **bflux_in[], struct gkyl_array **bflux_out[],
+  const struct gkyl_array *fin_neut[], struct gkyl_array *fout_neut[],
+  const struct gkyl_array **bflux_in_neut[], struct gkyl_array **bflux_out_neut[],
+  struct gkyl_update_status *st);
+
 struct gkyl_update_status gyrokinetic_update_ssp_rk3(gkyl_gyrokinetic_app* app, double dt0);
 
+/**
+ * Take time-step using the four-stage, third-order low-storage SSP-RK
+ * method. Each stage is a forward Euler step of dt/2, so the stable
+ * time-step is twice the forward Euler one. Uses the same f, f1 and fnew
+ * arrays as the RK3 method. Also sets the status object which has the
+ * actual and suggested dts used.
+ *
+ * @param app Gyrokinetic app.
+ * @param dt0 Suggessted time step.
+ */
+struct gkyl_update_status gyrokinetic_update_ssp_rk43(gkyl_gyrokinetic_app* app, double dt0);
+
 /**
  * Take time-step of the (BGK) collision operator using a first order implicit method. 
  *
@@ -3040,7 +3193,7 @@ void gyrokinetic_update_implicit_coll(gkyl_gyrokinetic_app *app,  double dt0);
 
 /**
  * Take time-step using a first order operator split combining 
- * the RK3 method for the collisionless advection with a first order implicit
+ * the SSP-RK method (app->ssp_rk_func) for the collisionless advection with a first order implicit
  * method for BGK collisions. The first order implicit step occurs *after* the 
  * RK3 step and utilizes the stable RK3 time step. Also sets the status object
  * which has the actual and suggested dts used. These can be different
@@ -1,6 +1,7 @@
 #include <stdarg.h>
 
 #include <gkyl_alloc.h>
+#include <gkyl_array_numa.h>
 #include <gkyl_array_ops.h>
 #include <gkyl_array_rio_priv.h>
 #include <gkyl_basis.h>
@@ -171,6 +172,7 @@ gkyl_gyrokinetic_app_new_geom(struct gkyl_gk *gk)
 
   strcpy(app->name, gk->name);
   app->tcurr = 0.0; // reset on init
+  app->mem_pool = gkyl_mem_pool_new(app->name);
 
   if (app->use_gpu) {
     // allocate device basis if we are using GPUs
@@ -216,7 +218,7 @@ gkyl_gyrokinetic_app_new_geom(struct gkyl_gk *gk)
     gyrokinetic_cuts_check(app, gk->parallelism.comm, gk->parallelism.cuts, stdout);
 
     // Create decomp.
-    app->decomp = gkyl_rect_decomp_new_from_cuts(app->cdim, gk->parallelism.cuts, &app->global);
+    app->decomp = app_decomp_new(&gk->parallelism, &app->grid, &app->global, &app->global_ext);
 
     // Create a new communicator with the decomposition in it.
     app->comm = gkyl_comm_split_comm(gk->parallelism.comm, 0, app->decomp);
@@ -254,12 +256,12 @@ gkyl_gyrokinetic_app_new_geom(struct gkyl_gk *gk)
       struct gkyl_range range_plane;
       gkyl_range_init(&range_plane, app->cdim, lower_plane, upper_plane);
   
-      // Create decomp.
-      int cuts_plane[GKYL_MAX_CDIM];
-      for (int d=0; d<app->cdim; ++d)
-        cuts_plane[d] = gk->parallelism.cuts[d];
-      cuts_plane[dir] = 1;
-      app->decomp_plane[dir] = gkyl_rect_decomp_new_from_cuts(app->cdim, cuts_plane, &range_plane);
+      // Create decomp from the local ranges of the ranks on the plane, so it
+      // matches the app's (possibly cost-weighted) decomp.
+      struct gkyl_range ranges_plane[num_ranks_plane];
+      for (int i=0; i<num_ranks_plane; i++)
+        memcpy(&ranges_plane[i], &app->decomp->ranges[ranks_plane[i]], sizeof(struct gkyl_range));
+      app->decomp_plane[dir] = gkyl_rect_decomp_new_from_ranges(num_ranks_plane, ranges_plane, &range_plane);
   
       // Create a new communicator with ranks on plane.
       bool is_comm_valid;
@@ -401,6 +403,8 @@ gkyl_gyrokinetic_app_new_geom(struct gkyl_gk *gk)
   }
 
   gkyl_gyrokinetic_app_write_geometry(app, &geometry_inp);
+  // Geometry buffers are not used again; return them to the heap.
+  gkyl_mem_pool_trim(app->mem_pool);
 
   // Allocate 1/(J.B) using weak mul/div.
   struct gkyl_array *tmp = mkarr(app->use_gpu, app->basis.num_basis, app->local_ext.volume);
@@ -459,7 +463,7 @@ gkyl_gyrokinetic_app_new_geom(struct gkyl_gk *gk)
 static void
 gyrokinetic_calc_field_update(gkyl_gyrokinetic_app* app, double tcurr, const struct gkyl_array *fin[])
 {
-  struct timespec wtm = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "field");
   // Compute electrostatic potential from gyrokinetic Poisson's equation.
   gk_field_accumulate_rho_c(app, app->field, fin);
 
@@ -471,7 +475,7 @@ gyrokinetic_calc_field_update(gkyl_gyrokinetic_app* app, double tcurr, const str
 
   // Solve the field equation.
   gk_field_rhs(app, app->field);
-  app->stat.field_tm += gkyl_time_diff_now_sec(wtm);
+  gkyl_region_timer_end(app->rtimer);
 }
 
 static void
@@ -578,6 +582,31 @@ gyrokinetic_pos_shift_quasineutrality(gkyl_gyrokinetic_app *app)
   app->pos_shift_quasineutrality_func(app);
 }
 
+// Count the pages of the distribution functions that are on the NUMA
+// node this rank runs on (CPU only). The apps don't use threads, so the
+// rank's thread touches (see mkarr_distf) and owns every page. This
+// queries the placement of each page, so it is done once, after the
+// species are allocated.
+static void
+numa_stat_calc(gkyl_gyrokinetic_app* app)
+{
+  struct gkyl_gyrokinetic_stat *stat = &app->stat;
+  stat->numa_local_pages = stat->numa_remote_pages = 0;
+  if (app->use_gpu)
+    return;
+
+  for (int i=0; i<app->num_species; ++i) {
+    struct gkyl_array_numa_stat ns = gkyl_array_numa_stat(app->species[i].f, 0);
+    stat->numa_local_pages += ns.local_pages;
+    stat->numa_remote_pages += ns.remote_pages;
+  }
+  for (int i=0; i<app->num_neut_species; ++i) {
+    struct gkyl_array_numa_stat ns = gkyl_array_numa_stat(app->neut_species[i].f, 0);
+    stat->numa_local_pages += ns.local_pages;
+    stat->numa_remote_pages += ns.remote_pages;
+  }
+}
+
 void
 gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
 {
@@ -595,7 +624,9 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
   for (int i=0; i<neuts; ++i)
     app->neut_species[i].info = gk->neut_species[i];
 
+  gkyl_mem_account_push("field");
   app->field = gk_field_new(gk, app); // Initialize field, even if we are  skipping field updates.
+  gkyl_mem_account_pop();
 
   // Choose the function that updates the fields in time.
   if (app->field->update_field)
@@ -603,6 +634,8 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
   else
     app->calc_field_func = gyrokinetic_calc_field_none;
 
+  app->fuse_rk_stages = gk->fuse_rk_stages;
+  app->moms_epoch = app->moms_epoch_count = 0;
   app->enforce_positivity = gk->enforce_positivity;
   app->pos_shift_quasineutrality_func = gyrokinetic_pos_shift_quasineutrality_disabled;
   if (app->enforce_positivity) {
@@ -615,15 +648,22 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
   }
 
   // Initialize each species.
-  for (int i=0; i<ns; ++i)
+  for (int i=0; i<ns; ++i) {
+    gkyl_mem_account_push(app->species[i].info.name);
     gk_species_init(gk, app, &app->species[i]);
+    gkyl_mem_account_pop();
+  }
 
-  for (int i=0; i<neuts; ++i)
+  for (int i=0; i<neuts; ++i) {
+    gkyl_mem_account_push(app->neut_species[i].info.name);
     gk_neut_species_init(gk, app, &app->neut_species[i]);
+    gkyl_mem_account_pop();
+  }
 
   // Initialize each species cross-collisions terms.
   for (int i=0; i<ns; ++i) {
     struct gk_species *gk_s = &app->species[i];
+    gkyl_mem_account_push(gk_s->info.name);
 
     // Initialize cross-species collisions (e.g, LBO or BGK)
     if (gk_s->lbo.collision_id == GKYL_LBO_COLLISIONS) {
@@ -644,13 +684,17 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
     }
     // Initial radiation (e.g., line radiation from cross-collisions of electrons with ions)
     if (gk_s->info.radiation.radiation_id == GKYL_GK_RADIATION) {
+      gkyl_mem_account_push("radiation");
       gk_species_radiation_init(app, &app->species[i], &gk_s->rad);
+      gkyl_mem_account_pop();
     }
+    gkyl_mem_account_pop();
   }
 
   // Initialize neutral species cross-species reactions with plasma species.
   for (int i=0; i<neuts; ++i) {
     struct gk_neut_species *gkns = &app->neut_species[i]; 
+    gkyl_mem_account_push(gkns->info.name);
     if (gkns->react_neut.num_react) {
       gk_neut_species_react_cross_init(app, gkns, &gkns->react_neut);
     }
@@ -664,15 +708,24 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
           gk_neut_species_recycle_cross_init(app, gkns, &gkns->bc_recycle_up);
       }
     }
+    gkyl_mem_account_pop();
   }
 
   // Initialize source terms. Done here as sources may initialize
   // a boundary flux updater for their source species.
   for (int i=0; i<ns; ++i) {
+    gkyl_mem_account_push(app->species[i].info.name);
+    gkyl_mem_account_push("source");
     gk_species_source_init(app, &app->species[i], &app->species[i].src);
+    gkyl_mem_account_pop();
+    gkyl_mem_account_pop();
   }
   for (int i=0; i<neuts; ++i) {
+    gkyl_mem_account_push(app->neut_species[i].info.name);
+    gkyl_mem_account_push("source");
     gk_neut_species_source_init(app, &app->neut_species[i], &app->neut_species[i].src);
+    gkyl_mem_account_pop();
+    gkyl_mem_account_pop();
   }
 
   // Use implicit BGK collisions if specified
@@ -686,12 +739,18 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
   // Set the appropriate update function for taking a single time step
   // If we have implicit BGK collisions for either the gyrokinetic or neutral species, 
   // we perform a first-order operator split and treat those terms implicitly.
-  // Otherwise, we default to an SSP-RK3 method. 
+  // Otherwise, we only take an SSP-RK step (RK3 unless RK43 is requested).
+  app->time_stepper = gk->time_stepper;
+  if (app->time_stepper == GKYL_SSP_RK43)
+    app->ssp_rk_func = gyrokinetic_update_ssp_rk43;
+  else
+    app->ssp_rk_func = gyrokinetic_update_ssp_rk3;
+
   if (app->has_implicit_coll_scheme) {
     app->update_func = gyrokinetic_update_op_split;
   }
   else {
-    app->update_func = gyrokinetic_update_ssp_rk3;
+    app->update_func = app->ssp_rk_func;
   }
 
   // Pre-compute time-independent factors in omega_H.
@@ -703,6 +762,8 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
     .stage_2_dt_diff = { DBL_MAX, 0.0 },
     .stage_3_dt_diff = { DBL_MAX, 0.0 },
   };
+  app->rtimer = gkyl_region_timer_new(gk->use_hw_counters);
+  numa_stat_calc(app);
 
   app->dts = gkyl_dynvec_new(GKYL_DOUBLE, 1); // Dynvector to store time steps.
   app->is_first_dt_write_call = true;
@@ -712,7 +773,10 @@ gkyl_gyrokinetic_app_new_solver(struct gkyl_gk *gk, gkyl_gyrokinetic_app *app)
 gkyl_gyrokinetic_app*
 gkyl_gyrokinetic_app_new(struct gkyl_gk *gk)
 {
+  gkyl_mem_account_push("geometry");
   gkyl_gyrokinetic_app* app = gkyl_gyrokinetic_app_new_geom(gk);
+  gkyl_mem_account_pop();
+
   gkyl_gyrokinetic_app_new_solver(gk, app);
 
   return app;
@@ -736,14 +800,14 @@ gyrokinetic_calc_field_and_apply_bc(gkyl_gyrokinetic_app* app, double tcurr,
   gyrokinetic_calc_field(app, tcurr, (const struct gkyl_array **) distf);
 
   // Apply boundary conditions.
-  struct timespec wst = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "bc");
   for (int i=0; i<app->num_species; ++i) {
     gk_species_apply_bc(app, &app->species[i], distf[i]);
   }
   for (int i=0; i<app->num_neut_species; ++i) {
     gk_neut_species_apply_bc(app, &app->neut_species[i], distf_neut[i]);
   }
-  app->stat.bc_tm += gkyl_time_diff_now_sec(wst);
+  gkyl_region_timer_end(app->rtimer);
 }
 
 struct gk_species *
@@ -947,11 +1011,12 @@ gkyl_gyrokinetic_app_write_geometry(gkyl_gyrokinetic_app* app, struct gkyl_gk_ge
   );
 
   // Gather geo into a global array
-  struct gkyl_array* arr_ho1 = mkarr(false,   app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_hocdim = mkarr(false, app->cdim*app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho3 = mkarr(false, 3*app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho6 = mkarr(false, 6*app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho9 = mkarr(false, 9*app->basis.num_basis, app->local_ext.volume);
+  int arena = gkyl_mem_pool_arena_begin(app->mem_pool);
+  struct gkyl_array* arr_ho1 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,   app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_hocdim = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, app->cdim*app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho3 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 3*app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho6 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 6*app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho9 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 9*app->basis.num_basis, app->local_ext.volume);
 
   gyrokinetic_app_geometry_copy_and_write(app, app->gk_geom->mc2p        , arr_ho3, "mapc2p", mt);
   gyrokinetic_app_geometry_copy_and_write(app, app->gk_geom->mc2nu_pos   , arr_ho3, "mc2nu_pos", mt);
@@ -986,7 +1051,7 @@ gkyl_gyrokinetic_app_write_geometry(gkyl_gyrokinetic_app* app, struct gkyl_gk_ge
   // Write out nodes. This has to be done from rank 0 so we need to gather mc2p.
   struct gkyl_array *mc2p_global = mkarr(app->use_gpu, app->gk_geom->mc2p->ncomp, app->global_ext.volume);
   gkyl_comm_array_allgather(app->comm, &app->local, &app->global, app->gk_geom->mc2p, mc2p_global);
-  struct gkyl_array *mc2p_global_ho = mkarr(false, mc2p_global->ncomp, mc2p_global->size);
+  struct gkyl_array *mc2p_global_ho = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, mc2p_global->ncomp, mc2p_global->size);
   gkyl_array_copy(mc2p_global_ho, mc2p_global);
 
   int rank;
@@ -995,7 +1060,7 @@ gkyl_gyrokinetic_app_write_geometry(gkyl_gyrokinetic_app* app, struct gkyl_gk_ge
     // Create Nodal Range and Grid and Write Nodal Coordinates
     struct gkyl_range nrange;
     gkyl_gk_geometry_init_nodal_range(&nrange, &app->global, app->poly_order);
-    struct gkyl_array* mc2p_nodal = mkarr(false, 3, nrange.volume);
+    struct gkyl_array* mc2p_nodal = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 3, nrange.volume);
     struct gkyl_nodal_ops *n2m = gkyl_nodal_ops_new(&app->basis, &app->grid, false);
     gkyl_nodal_ops_m2n(n2m, &app->basis, &app->grid, &nrange, &app->global, 3, mc2p_nodal, mc2p_global_ho);
     struct gkyl_rect_grid ngrid;
@@ -1019,6 +1084,7 @@ gkyl_gyrokinetic_app_write_geometry(gkyl_gyrokinetic_app* app, struct gkyl_gk_ge
   gkyl_array_release(arr_ho3);
   gkyl_array_release(arr_ho6);
   gkyl_array_release(arr_ho9);
+  gkyl_mem_pool_arena_end(app->mem_pool, arena);
 
   gk_array_meta_release(mt);
 }
@@ -1574,6 +1640,10 @@ gyrokinetic_rhs(gkyl_gyrokinetic_app* app, double tcurr, double dt,
 {
   double dtmin = DBL_MAX;
 
+  // Moments of fin computed until the end of the epoch are shared between
+  // the collision, reaction and radiation terms.
+  gk_species_moment_cache_begin(app);
+
   // Compute necessary moments and boundary corrections for collisions.
   for (int i=0; i<app->num_species; ++i) {
     if (app->species[i].lbo.collision_id == GKYL_LBO_COLLISIONS) {
@@ -1635,6 +1705,8 @@ gyrokinetic_rhs(gkyl_gyrokinetic_app* app, double tcurr, double dt,
     }
   }
 
+  gk_species_moment_cache_end(app);
+
   // Compute collisionless terms of charged species.
   for (int i=0; i<app->num_species; ++i) {
     struct gk_species *s = &app->species[i];
@@ -1665,7 +1737,7 @@ gyrokinetic_rhs(gkyl_gyrokinetic_app* app, double tcurr, double dt,
       &app->neut_species[i].src, fin_neut[i], fout_neut[i]);
   }
 
-  struct timespec wtm = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "dfdt_dt_reduce");
   double dt_max_rel_diff = 0.01;
   // Check if dtmin is slightly smaller than dt. Use dt if it is
   // (avoids retaking steps if dt changes are very small).
@@ -1681,30 +1753,45 @@ gyrokinetic_rhs(gkyl_gyrokinetic_app* app, double tcurr, double dt,
   // Don't take a time-step larger that input dt.
   double dta = st->dt_actual = dt < dtmin ? dt : dtmin;
   st->dt_suggested = dtmin;
-  app->stat.dfdt_dt_reduce_tm += gkyl_time_diff_now_sec(wtm);
+  gkyl_region_timer_end(app->rtimer);
 }
 
 struct gkyl_update_status
 gkyl_gyrokinetic_update(gkyl_gyrokinetic_app* app, double dt)
 {
   app->stat.nup += 1;
-  struct timespec wst = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "time_loop");
 
   struct gkyl_update_status status = app->update_func(app, dt);
   app->tcurr += status.dt_actual;
 
-  app->stat.time_loop_tm += gkyl_time_diff_now_sec(wst);
+  gkyl_region_timer_end(app->rtimer);
   // Check for any CUDA errors during time step
   if (app->use_gpu)
     checkCuda(cudaGetLastError());
   return status;
 }
 
+// Set the timers measured with the region timer.
+static void
+region_timer_stat_calc(gkyl_gyrokinetic_app* app)
+{
+  struct gkyl_gyrokinetic_stat *stat = &app->stat;
+  stat->time_loop_tm = gkyl_region_timer_sum(app->rtimer, "time_loop");
+  stat->fwd_euler_tm = gkyl_region_timer_sum(app->rtimer, "fwd_euler");
+  stat->fwd_euler_step_f_tm = gkyl_region_timer_sum(app->rtimer, "step_f");
+  stat->dfdt_dt_reduce_tm = gkyl_region_timer_sum(app->rtimer, "dfdt_dt_reduce");
+  stat->field_tm = gkyl_region_timer_sum(app->rtimer, "field");
+  stat->bc_tm = gkyl_region_timer_sum(app->rtimer, "bc");
+}
+
 struct gkyl_gyrokinetic_stat
 gkyl_gyrokinetic_app_stat(gkyl_gyrokinetic_app* app)
 {
   struct gkyl_gyrokinetic_stat *stat = &app->stat;
 
+  region_timer_stat_calc(app);
+
   // Timers not yet computed in app directly.
   stat->time_rate_diags_tm = stat->fdot_tm + stat->phidot_tm;
   stat->pos_shift_tm = stat->species_pos_shift_tm + stat->neut_species_pos_shift_tm + stat->pos_shift_quasineut_tm;
@@ -1739,10 +1826,141 @@ ratio_to_percent(double num, double den, double alt)
   return den > 1e-12 ? 100.*num/den : alt;
 }
 
+// Number of basis functions of the species' phase basis and of its
+// surface and surface-quadrature bases (see gk_species_new).
+static void
+gk_species_num_basis(int cdim, int vdim, int poly_order, int *nb, int *nb_surf, int *nb_surf_quad)
+{
+  int pdim = cdim+vdim;
+  struct gkyl_basis basis, surf_basis, surf_quad_basis;
+  if (poly_order > 1) {
+    gkyl_cart_modal_serendip(&basis, pdim, poly_order);
+    gkyl_cart_modal_serendip(&surf_basis, pdim-1, poly_order);
+    gkyl_cart_modal_tensor(&surf_quad_basis, pdim-1, poly_order);
+  }
+  else {
+    gkyl_cart_modal_gkhybrid(&basis, cdim, vdim);
+    if (vdim > 1) {
+      gkyl_cart_modal_gkhybrid(&surf_basis, cdim-1, vdim);
+      gkyl_cart_modal_gkhybrid(&surf_quad_basis, cdim-1, vdim);
+    }
+    else {
+      gkyl_cart_modal_serendip(&surf_basis, pdim-1, 2);
+      gkyl_cart_modal_tensor(&surf_quad_basis, pdim-1, 2);
+    }
+  }
+  *nb = basis.num_basis;
+  *nb_surf = surf_basis.num_basis;
+  *nb_surf_quad = surf_quad_basis.num_basis;
+}
+
+double
+gkyl_gyrokinetic_app_mem_estimate(const struct gkyl_gk *gk, FILE *iostream)
+{
+  int cdim = gk->cdim, vdim = gk->vdim;
+
+  // Configuration-space cells per rank, with one ghost cell on each
+  // side. Cuts are only used if a communicator is given.
+  long conf_ext = 1, conf_global_ext = 1;
+  for (int d=0; d<cdim; ++d) {
+    int cuts = gk->parallelism.comm && gk->parallelism.cuts[d] > 0 ? gk->parallelism.cuts[d] : 1;
+    conf_ext *= (gk->cells[d]+cuts-1)/cuts + 2;
+    conf_global_ext *= gk->cells[d] + 2;
+  }
+
+  struct gkyl_basis conf_basis;
+  if (gk->basis_type == GKYL_BASIS_MODAL_TENSOR)
+    gkyl_cart_modal_tensor(&conf_basis, cdim, gk->poly_order);
+  else
+    gkyl_cart_modal_serendip(&conf_basis, cdim, gk->poly_order);
+  double conf_bytes = sizeof(double[conf_basis.num_basis])*conf_ext;
+
+  // Geometry: 79+2*cdim components (see struct gk_geometry).
+  double geom_bytes = (79+2*cdim)*conf_bytes;
+
+  // Field: charge density, smoothed potential, polarization weight and
+  // energy factor, wall potentials, and the global charge density and
+  // FEM potential.
+  int eps_ncomp = 2*(cdim/3)+1;
+  double field_bytes = (4+2*eps_ncomp)*conf_bytes
+    + 3*sizeof(double[conf_basis.num_basis])*conf_global_ext;
+
+  // Species: f, f1, fnew, the LTE distribution, the cfl rate, surface
+  // fluxes and their signs, plus the BGK nu*f_max. Configuration-space
+  // moments, potentials and collision coefficients are about 16 arrays.
+  double species_bytes[GKYL_MAX_SPECIES];
+  for (int i=0; i<gk->num_species; ++i) {
+    const struct gkyl_gyrokinetic_species *sp = &gk->species[i];
+    long vel_cells = 1;
+    for (int d=0; d<vdim; ++d)
+      vel_cells *= sp->cells[d];
+    long phase_ext = conf_ext*vel_cells;
+
+    int nb, nb_surf, nb_surf_quad;
+    gk_species_num_basis(cdim, vdim, gk->poly_order, &nb, &nb_surf, &nb_surf_quad);
+    int num_distf = 4 + (sp->collisions.collision_id == GKYL_BGK_COLLISIONS ? 1 : 0);
+    species_bytes[i] = phase_ext*(sizeof(double[num_distf*nb + 1 + (cdim+1)*(nb_surf+nb_surf_quad)])
+      + sizeof(int[cdim+1])) + 16*conf_bytes;
+  }
+
+  // Neutral species: f, f1, fnew and the cfl rate in 3 velocity dimensions.
+  double neut_bytes[GKYL_MAX_SPECIES];
+  for (int i=0; i<gk->num_neut_species; ++i) {
+    const struct gkyl_gyrokinetic_neut_species *sp = &gk->neut_species[i];
+    long phase_ext = conf_ext*sp->cells[0]*sp->cells[1]*sp->cells[2];
+    struct gkyl_basis basis;
+    if (gk->poly_order > 1)
+      gkyl_cart_modal_serendip(&basis, cdim+3, gk->poly_order);
+    else
+      gkyl_cart_modal_tensor(&basis, cdim+3, gk->poly_order);
+    neut_bytes[i] = phase_ext*sizeof(double[3*basis.num_basis + 1]) + 16*conf_bytes;
+  }
+
+  double total = geom_bytes + field_bytes;
+  for (int i=0; i<gk->num_species; ++i)
+    total += species_bytes[i];
+  for (int i=0; i<gk->num_neut_species; ++i)
+    total += neut_bytes[i];
+
+  if (iostream) {
+    const double mb = 1024.0*1024.0;
+    fprintf(iostream, "Estimated array memory per rank:\n");
+    fprintf(iostream, "  %-40s %12.3f MB\n", "geometry", geom_bytes/mb);
+    fprintf(iostream, "  %-40s %12.3f MB\n", "field", field_bytes/mb);
+    for (int i=0; i<gk->num_species; ++i)
+      fprintf(iostream, "  %-40s %12.3f MB\n", gk->species[i].name, species_bytes[i]/mb);
+    for (int i=0; i<gk->num_neut_species; ++i)
+      fprintf(iostream, "  %-40s %12.3f MB\n", gk->neut_species[i].name, neut_bytes[i]/mb);
+    fprintf(iostream, "  Total: %12.3f MB\n", total/mb);
+  }
+  return total;
+}
+
+int
+gkyl_gyrokinetic_app_mem_report(gkyl_gyrokinetic_app* app, double target_bytes,
+  FILE *iostream)
+{
+  // Only z is decomposed, so at most one subdomain per cell along z.
+  int ndecomp = app->decomp->ndecomp;
+  int cuts_z = app_mem_report(app->comm, app->use_gpu, ndecomp,
+    app->grid.cells[app->cdim-1], target_bytes, iostream);
+  if (cuts_z != ndecomp) {
+    char cuts_str[64] = "";
+    for (int d=0; d<app->cdim; ++d) {
+      char c[16];
+      snprintf(c, sizeof c, "%s%d", d > 0 ? ", " : "", d == app->cdim-1 ? cuts_z : 1);
+      strcat(cuts_str, c);
+    }
+    gkyl_gyrokinetic_app_cout(app, iostream, "  Suggested cuts: { %s }\n", cuts_str);
+  }
+  return cuts_z;
+}
+
 void
 gkyl_gyrokinetic_app_print_timings(gkyl_gyrokinetic_app* app, FILE *iostream)
 {
   struct gkyl_gyrokinetic_stat *stat = &app->stat;
+  region_timer_stat_calc(app);
 
   double bflux_tm = stat->species_bflux_calc_tm+stat->species_bflux_moms_tm;
 
@@ -1874,6 +2092,13 @@ comm_reduce_app_stat(const gkyl_gyrokinetic_app* app,
   gkyl_comm_allreduce_host(app->comm, GKYL_INT_64, GKYL_MAX, app->num_species, 
     l_red_num_corr, l_red_global_num_corr);
 
+  // Page counts are summed over ranks.
+  int64_t l_numa[] = { local->numa_local_pages, local->numa_remote_pages };
+  int64_t l_numa_global[2];
+  gkyl_comm_allreduce_host(app->comm, GKYL_INT_64, GKYL_SUM, 2, l_numa, l_numa_global);
+  global->numa_local_pages = l_numa_global[0];
+  global->numa_remote_pages = l_numa_global[1];
+
   for (int s=0; s<app->num_species; ++s) {
     global->n_iter_corr[s] = l_red_global_n_iter_corr[s];
     global->num_corr[s] = l_red_global_num_corr[s];
@@ -2073,6 +2298,8 @@ gkyl_gyrokinetic_app_stat_write(gkyl_gyrokinetic_app* app)
 
   gk_neut_species_n_iter_corr(app); 
 
+  region_timer_stat_calc(app);
+
   struct gkyl_gyrokinetic_stat stat = { };
   comm_reduce_app_stat(app, &app->stat, &stat);
   
@@ -2097,6 +2324,8 @@ gkyl_gyrokinetic_app_stat_write(gkyl_gyrokinetic_app* app)
   gkyl_gyrokinetic_app_cout(app, fp, " nfeuler : %ld,\n", stat.nfeuler);
   gkyl_gyrokinetic_app_cout(app, fp, " nstage_2_fail : %ld,\n", stat.nstage_2_fail);
   gkyl_gyrokinetic_app_cout(app, fp, " nstage_3_fail : %ld,\n", stat.nstage_3_fail);
+  gkyl_gyrokinetic_app_cout(app, fp, " numa_local_pages : %ld,\n", stat.numa_local_pages);
+  gkyl_gyrokinetic_app_cout(app, fp, " numa_remote_pages : %ld,\n", stat.numa_remote_pages);
 
   gkyl_gyrokinetic_app_cout(app, fp, " stage_2_dt_diff : [ %lg, %lg ],\n",
     stat.stage_2_dt_diff[0], stat.stage_2_dt_diff[1]);
@@ -2200,6 +2429,31 @@ gkyl_gyrokinetic_app_stat_write(gkyl_gyrokinetic_app* app)
   if (rank == 0)
     fclose(fp);  
 
+  gkyl_gyrokinetic_app_write_region_timers(app);
+}
+
+void
+gkyl_gyrokinetic_app_write_region_timers(gkyl_gyrokinetic_app* app)
+{
+  int rank;
+  gkyl_comm_get_rank(app->comm, &rank);
+
+  const char *fmt = "%s-%s";
+  const char *suffix[] = { "timers.json", "timers.folded" };
+  for (int k=0; k<2; ++k) {
+    int sz = gkyl_calc_strlen(fmt, app->name, suffix[k]);
+    char fileNm[sz+1]; // ensures no buffer overflow
+    snprintf(fileNm, sizeof fileNm, fmt, app->name, suffix[k]);
+
+    FILE *fp = 0;
+    if (rank == 0) fp = fopen(fileNm, "w");
+    if (k == 0)
+      gkyl_region_timer_write_json(app->rtimer, app->comm, fp);
+    else
+      gkyl_region_timer_write_folded(app->rtimer, app->comm, fp);
+    if (fp)
+      fclose(fp);
+  }
 }
 
 void
@@ -2294,10 +2548,13 @@ gyrokinetic_app_geometry_read_and_copy(gkyl_gyrokinetic_app* app, struct gkyl_ar
 void
 gkyl_gyrokinetic_app_read_geometry(gkyl_gyrokinetic_app* app)
 {
-  struct gkyl_array* arr_ho1 = mkarr(false,   app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho3 = mkarr(false, 3*app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho6 = mkarr(false, 6*app->basis.num_basis, app->local_ext.volume);
-  struct gkyl_array* arr_ho9 = mkarr(false, 9*app->basis.num_basis, app->local_ext.volume);
+  // Buffers come from the app's pool, so that writing the geometry
+  // afterwards reuses them.
+  int arena = gkyl_mem_pool_arena_begin(app->mem_pool);
+  struct gkyl_array* arr_ho1 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE,   app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho3 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 3*app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho6 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 6*app->basis.num_basis, app->local_ext.volume);
+  struct gkyl_array* arr_ho9 = gkyl_array_pool_new(app->mem_pool, GKYL_DOUBLE, 9*app->basis.num_basis, app->local_ext.volume);
 
   gyrokinetic_app_geometry_read_and_copy(app, app->gk_geom->mc2p        , arr_ho3, "mapc2p");
   gyrokinetic_app_geometry_read_and_copy(app, app->gk_geom->mc2nu_pos   , arr_ho3, "mc2nu_pos");
@@ -2326,6 +2583,7 @@ gkyl_gyrokinetic_app_read_geometry(gkyl_gyrokinetic_app* app)
   gkyl_array_release(arr_ho3);
   gkyl_array_release(arr_ho6);
   gkyl_array_release(arr_ho9);
+  gkyl_mem_pool_arena_end(app->mem_pool, arena);
 }
 
 struct gkyl_app_restart_status
@@ -2608,6 +2866,8 @@ gkyl_gyrokinetic_app_release(gkyl_gyrokinetic_app* app)
   }
 
   gkyl_dynvec_release(app->dts);
+  gkyl_region_timer_release(app->rtimer);
+  gkyl_mem_pool_release(app->mem_pool);
 
   gkyl_free(app);
 }
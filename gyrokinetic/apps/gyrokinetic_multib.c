@@ -43,6 +43,30 @@ calc_tot_and_max_cuts(const struct gkyl_gk_block_geom *gk_block_geom, int tot_ma
   tot_max[1] = max_cuts;
 }
 
+int
+gyrokinetic_multib_block_ranks(const struct gkyl_gyrokinetic_multib_app *mbapp, int bid, int *ranks)
+{
+  if (mbapp->rank_map) {
+    gkyl_block_rank_map_getranks(mbapp->rank_map, bid, ranks);
+    return gkyl_block_rank_map_nranks(mbapp->rank_map, bid);
+  }
+  gkyl_rrobin_decomp_getranks(mbapp->round_robin, bid, ranks);
+  return gkyl_rrobin_decomp_nranks(mbapp->round_robin, bid);
+}
+
+void
+gyrokinetic_multib_block_cuts(const struct gkyl_gyrokinetic_multib_app *mbapp, int bid, int *cuts)
+{
+  int cdim = gkyl_gk_block_geom_ndim(mbapp->gk_block_geom);
+  if (mbapp->rank_map) {
+    gkyl_block_rank_map_getcuts(mbapp->rank_map, bid, cuts);
+  }
+  else {
+    const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, bid);
+    for (int d=0; d<cdim; ++d) cuts[d] = bgi->cuts[d];
+  }
+}
+
 // Construct the mpack meta-data for multi-block data files.
 static struct gkyl_msgpack_data *
 gyrokinetic_multib_meta(struct gyrokinetic_multib_output_meta meta)
@@ -219,7 +243,7 @@ singleb_app_new_geom(const struct gkyl_gyrokinetic_multib *mbinp, int bid,
 
   struct gkyl_app_parallelism_inp parallel_inp = {};
   parallel_inp.use_gpu = mbinp->use_gpu;
-  for (int d=0; d<cdim; ++d) parallel_inp.cuts[d] = bgi->cuts[d];
+  gyrokinetic_multib_block_cuts(mbapp, bid, parallel_inp.cuts);
   parallel_inp.comm = comm;
   // Copy parallelism input into app input.
   memcpy(&app_inp.parallelism, &parallel_inp, sizeof(struct gkyl_app_parallelism_inp));
@@ -259,6 +283,8 @@ singleb_app_new_solver(const struct gkyl_gyrokinetic_multib *mbinp, int bid,
   app_inp.cfl_frac = mbinp->cfl_frac; 
 
   app_inp.enforce_positivity = mbinp->enforce_positivity;
+  app_inp.fuse_rk_stages = mbinp->fuse_rk_stages;
+  app_inp.use_hw_counters = mbinp->use_hw_counters;
 
   for (int i=0; i<num_species; ++i) {
     const struct gkyl_gyrokinetic_multib_species *sp = &mbinp->species[i];
@@ -577,12 +603,48 @@ gkyl_gyrokinetic_multib_app* gkyl_gyrokinetic_multib_app_new(const struct gkyl_g
   gkyl_comm_get_rank(mbinp->comm, &my_rank);
   gkyl_comm_get_size(mbinp->comm, &num_ranks);
 
-  int tot_max[2];
-  calc_tot_and_max_cuts(mbinp->gk_block_geom, tot_max);
-  if ((num_ranks > tot_max[0]) || (num_ranks < tot_max[1])) {
-    fprintf(stderr, "\nSpecified %d total cuts but provided %d processes, \
+  int cdim = gkyl_gk_block_geom_ndim(mbinp->gk_block_geom);
+  int num_blocks = gkyl_gk_block_geom_num_blocks(mbinp->gk_block_geom);
+
+  const struct gkyl_block_rank_map *rank_map = 0;
+  if (mbinp->auto_decomp) {
+    // Choose the ranks and cuts of each block to balance the cost.
+    int *cells = gkyl_malloc(sizeof(int[num_blocks*cdim]));
+    for (int i=0; i<num_blocks; ++i) {
+      const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbinp->gk_block_geom, i);
+      for (int d=0; d<cdim; ++d) cells[i*cdim+d] = bgi->cells[d];
+    }
+    struct gkyl_block_topo *topo = gkyl_gk_block_geom_topo(mbinp->gk_block_geom);
+    struct gkyl_block_rank_map_inp rank_map_inp = {
+      .topo = topo,
+      .ndim = cdim,
+      .num_blocks = num_blocks,
+      .num_ranks = num_ranks,
+      .cells = cells,
+      .cost = mbinp->block_cost,
+    };
+    // Parallelization is only allowed in z (see gyrokinetic_cuts_check),
+    // and the field solve gathers pieces of a block that must be of the
+    // same size.
+    for (int d=0; d<cdim-1; ++d)
+      rank_map_inp.uncut_dirs[d] = true;
+    rank_map_inp.even_cuts = true;
+    rank_map = gkyl_block_rank_map_new(&rank_map_inp);
+    gkyl_block_topo_release(topo);
+    gkyl_free(cells);
+    if (!rank_map) {
+      fprintf(stderr, "\nUnable to distribute %d blocks over %d processes\n\n", num_blocks, num_ranks);
+      return 0;
+    }
+  }
+  else {
+    int tot_max[2];
+    calc_tot_and_max_cuts(mbinp->gk_block_geom, tot_max);
+    if ((num_ranks > tot_max[0]) || (num_ranks < tot_max[1])) {
+      fprintf(stderr, "\nSpecified %d total cuts but provided %d processes, \
 and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot_max[1]);
-    return 0;
+      return 0;
+    }
   }
 
   struct gkyl_gyrokinetic_multib_app *mbapp = gkyl_malloc(sizeof(*mbapp));
@@ -593,17 +655,27 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
   
   mbapp->gk_block_geom = gkyl_gk_block_geom_acquire(mbinp->gk_block_geom);
   mbapp->block_topo = gkyl_gk_block_geom_topo(mbinp->gk_block_geom);
-  
-  int cdim = gkyl_gk_block_geom_ndim(mbapp->gk_block_geom);
-  int num_blocks = gkyl_gk_block_geom_num_blocks(mbapp->gk_block_geom);
 
-  // Construct round-robin decomposition.
+  if (rank_map)
+    gkyl_gyrokinetic_multib_app_cout(mbapp, stdout, "Automatic decomposition: max/average cost per rank is %g\n",
+      rank_map->max_cost/rank_map->avg_cost);
+
+  // Construct round-robin decomposition, unless ranks were assigned
+  // to blocks automatically.
+  mbapp->rank_map = rank_map;
+  mbapp->round_robin = 0;
   int *branks = gkyl_malloc(sizeof(int[num_blocks]));
-  for (int i=0; i<num_blocks; ++i) {
-    const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, i);
-    branks[i] = calc_cuts(cdim, bgi->cuts);
+  if (rank_map) {
+    for (int i=0; i<num_blocks; ++i)
+      branks[i] = gkyl_block_rank_map_nranks(rank_map, i);
+  }
+  else {
+    for (int i=0; i<num_blocks; ++i) {
+      const struct gkyl_gk_block_geom_info *bgi = gkyl_gk_block_geom_get_block(mbapp->gk_block_geom, i);
+      branks[i] = calc_cuts(cdim, bgi->cuts);
+    }
+    mbapp->round_robin = gkyl_rrobin_decomp_new(num_ranks, num_blocks, branks);
   }
-  mbapp->round_robin = gkyl_rrobin_decomp_new(num_ranks, num_blocks, branks);
 
   int num_local_blocks = 0;
   mbapp->local_blocks = gkyl_malloc(sizeof(int[num_blocks]));
@@ -619,7 +691,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
   // num_local_blocks.
   mbapp->block_comms = gkyl_malloc(num_blocks*sizeof(struct gkyl_comm *));
   for (int i=0; i<num_blocks; ++i) {
-    gkyl_rrobin_decomp_getranks(mbapp->round_robin, i, rank_list);
+    gyrokinetic_multib_block_ranks(mbapp, i, rank_list);
 
     bool is_my_rank_in_decomp = has_int(branks[i], my_rank, rank_list);
 
@@ -632,8 +704,10 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
     struct gkyl_range block_global_range;
     gkyl_create_global_range(cdim, bgi->cells, &block_global_range);
 
+    int cuts[GKYL_MAX_CDIM];
+    gyrokinetic_multib_block_cuts(mbapp, i, cuts);
     mbapp->decomp[i] = gkyl_rect_decomp_new_from_cuts(
-      cdim, bgi->cuts, &block_global_range);
+      cdim, cuts, &block_global_range);
 
     bool status;
     mbapp->block_comms[i] = gkyl_comm_create_comm_from_ranks(mbinp->comm,
@@ -650,6 +724,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
   mbapp->num_neut_species = 0;
   mbapp->update_field = 0;
   mbapp->singleb_apps = 0;
+  mbapp->fuse_rk_stages = mbinp->fuse_rk_stages;
 
   if (num_local_blocks > 0) {
     mbapp->num_species = mbinp->num_species;
@@ -705,7 +780,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
   for (int bI=0; bI<num_local_blocks; ++bI) {
     int bid = mbapp->local_blocks[bI];
 
-    gkyl_rrobin_decomp_getranks(mbapp->round_robin, bid, rank_list);
+    gyrokinetic_multib_block_ranks(mbapp, bid, rank_list);
     int brank = -1;
     for (int i=0; i<branks[bid]; ++i)
       if (rank_list[i] == my_rank) brank = i;
@@ -722,7 +797,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
       // Translate the "rank" in gkyl_multib_comm_conn (right now it is a rank index).
       struct gkyl_comm_conn *ccs = &mbcc_s->comm_conn[ns];
       int rankIdx = ccs->rank;
-      gkyl_rrobin_decomp_getranks(mbapp->round_robin, ccs->block_id, rank_list);
+      gyrokinetic_multib_block_ranks(mbapp, ccs->block_id, rank_list);
       ccs->rank = rank_list[rankIdx];
       // Make range a sub range.
       gkyl_sub_range_init(&ccs->range, &sbapp->local_ext, ccs->range.lower, ccs->range.upper);
@@ -731,7 +806,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
       // Translate the "rank" in gkyl_multib_comm_conn (right now it is a rank index).
       struct gkyl_comm_conn *ccr = &mbcc_r->comm_conn[nr];
       int rankIdx = ccr->rank;
-      gkyl_rrobin_decomp_getranks(mbapp->round_robin, ccr->block_id, rank_list);
+      gyrokinetic_multib_block_ranks(mbapp, ccr->block_id, rank_list);
       ccr->rank = rank_list[rankIdx];
       // Make range a sub range.
       gkyl_sub_range_init(&ccr->range, &sbapp->local_ext, ccr->range.lower, ccr->range.upper);
@@ -836,6 +911,7 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
   }
 
   mbapp->stat = (struct gkyl_gyrokinetic_stat) {};
+  mbapp->rtimer = gkyl_region_timer_new(mbinp->use_hw_counters);
 
   mbapp->dts = gkyl_dynvec_new(GKYL_DOUBLE, 1); // Dynvector to store time steps.
   mbapp->is_first_dt_write_call = true;
@@ -849,13 +925,13 @@ and the maximum number of cuts in a block is %d\n\n", tot_max[0], num_ranks, tot
 void
 gyrokinetic_multib_calc_field(struct gkyl_gyrokinetic_multib_app* app, double tcurr, const struct gkyl_array *fin[])
 {
-  struct timespec wtm = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "field");
   // Compute fields.
   if (app->update_field) {
     // Solve the field equation.
     gk_multib_field_rhs(app, app->field, fin);
   }
-  app->stat.field_tm += gkyl_time_diff_now_sec(wtm);
+  gkyl_region_timer_end(app->rtimer);
 }
 
 static void
@@ -960,9 +1036,9 @@ gyrokinetic_multib_calc_field_and_apply_bc(struct gkyl_gyrokinetic_multib_app* a
   gyrokinetic_multib_calc_field(app, tcurr, (const struct gkyl_array **) distf);
 
   // Apply boundary conditions.
-  struct timespec wst = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "bc");
   gyrokinetic_multib_apply_bc(app, tcurr, distf, distf_neut);
-  app->stat.bc_tm += gkyl_time_diff_now_sec(wst);
+  gkyl_region_timer_end(app->rtimer);
 }
 
 void
@@ -1597,12 +1673,12 @@ struct gkyl_update_status
 gkyl_gyrokinetic_multib_update(gkyl_gyrokinetic_multib_app* app, double dt)
 {
   app->stat.nup += 1;
-  struct timespec wst = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "time_loop");
 
   struct gkyl_update_status status = gyrokinetic_multib_update_ssp_rk3(app, dt);
   app->tcurr += status.dt_actual;
 
-  app->stat.time_loop_tm += gkyl_time_diff_now_sec(wst);
+  gkyl_region_timer_end(app->rtimer);
 
   // Check for any CUDA errors during time step
   if (app->use_gpu)
@@ -1611,9 +1687,24 @@ gkyl_gyrokinetic_multib_update(gkyl_gyrokinetic_multib_app* app, double dt)
   return status;
 }
 
+// Set the timers measured with the region timer.
+static void
+region_timer_stat_calc(gkyl_gyrokinetic_multib_app* app)
+{
+  struct gkyl_gyrokinetic_stat *stat = &app->stat;
+  stat->time_loop_tm = gkyl_region_timer_sum(app->rtimer, "time_loop");
+  stat->fwd_euler_tm = gkyl_region_timer_sum(app->rtimer, "fwd_euler");
+  stat->fwd_euler_step_f_tm = gkyl_region_timer_sum(app->rtimer, "step_f");
+  stat->dfdt_dt_reduce_tm = gkyl_region_timer_sum(app->rtimer, "dfdt_dt_reduce");
+  stat->field_tm = gkyl_region_timer_sum(app->rtimer, "field");
+  stat->bc_tm = gkyl_region_timer_sum(app->rtimer, "bc");
+}
+
 struct gkyl_gyrokinetic_stat
 gkyl_gyrokinetic_multib_app_stat(gkyl_gyrokinetic_multib_app* app)
 {
+  region_timer_stat_calc(app);
+
   for (int i=0; i<app->num_species; ++i) {
     app->stat.n_iter_corr[i] = 0;
     app->stat.num_corr[i] = 0;
@@ -1790,6 +1881,32 @@ void gkyl_gyrokinetic_multib_app_species_ktm_rhs(gkyl_gyrokinetic_multib_app* ap
   // TO DO
 }
 
+// Write the region timers of the multiblock time loop, in the formats
+// of gkyl_gyrokinetic_app_write_region_timers.
+static void
+gyrokinetic_multib_write_region_timers(gkyl_gyrokinetic_multib_app* app)
+{
+  int rank;
+  gkyl_comm_get_rank(app->comm, &rank);
+
+  const char *fmt = "%s-%s";
+  const char *suffix[] = { "timers.json", "timers.folded" };
+  for (int k=0; k<2; ++k) {
+    int sz = gkyl_calc_strlen(fmt, app->name, suffix[k]);
+    char fileNm[sz+1]; // ensures no buffer overflow
+    snprintf(fileNm, sizeof fileNm, fmt, app->name, suffix[k]);
+
+    FILE *fp = 0;
+    if (rank == 0) fp = fopen(fileNm, "w");
+    if (k == 0)
+      gkyl_region_timer_write_json(app->rtimer, app->comm, fp);
+    else
+      gkyl_region_timer_write_folded(app->rtimer, app->comm, fp);
+    if (fp)
+      fclose(fp);
+  }
+}
+
 void
 gkyl_gyrokinetic_multib_app_stat_write(gkyl_gyrokinetic_multib_app* app)
 {
@@ -1797,6 +1914,7 @@ gkyl_gyrokinetic_multib_app_stat_write(gkyl_gyrokinetic_multib_app* app)
     struct gkyl_gyrokinetic_app *sbapp = app->singleb_apps[b];
     gkyl_gyrokinetic_app_stat_write(sbapp);
   }
+  gyrokinetic_multib_write_region_timers(app);
 }
 
 void
@@ -1895,7 +2013,10 @@ void gkyl_gyrokinetic_multib_app_release(gkyl_gyrokinetic_multib_app* mbapp)
 
   gkyl_free(mbapp->local_blocks);    
 
-  gkyl_rrobin_decomp_release(mbapp->round_robin);
+  if (mbapp->rank_map)
+    gkyl_block_rank_map_release(mbapp->rank_map);
+  else
+    gkyl_rrobin_decomp_release(mbapp->round_robin);
   
   gkyl_gk_block_geom_release(mbapp->gk_block_geom);
   gkyl_block_topo_release(mbapp->block_topo);
@@ -1903,6 +2024,7 @@ void gkyl_gyrokinetic_multib_app_release(gkyl_gyrokinetic_multib_app* mbapp)
   gkyl_comm_release(mbapp->comm);
 
   gkyl_dynvec_release(mbapp->dts);
+  gkyl_region_timer_release(mbapp->rtimer);
 
   gkyl_free(mbapp);
 }
@@ -8,7 +8,7 @@ gyrokinetic_multib_forward_euler(struct gkyl_gyrokinetic_multib_app* app, double
   const struct gkyl_array **bflux_in_neut[], struct gkyl_array **bflux_out_neut[], 
   struct gkyl_update_status *st)
 {
-  struct timespec wst_fe = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "fwd_euler");
   // Take a forward Euler step with the suggested time-step dt. This may
   // not be the actual time-step taken. However, the function will never
   // take a time-step larger than dt even if it is allowed by
@@ -16,7 +16,8 @@ gyrokinetic_multib_forward_euler(struct gkyl_gyrokinetic_multib_app* app, double
   // the status object.
   app->stat.nfeuler += 1;
 
-  double dtmin = DBL_MAX;
+  // Minimum actual and suggested time-steps.
+  double dtmin[2] = { DBL_MAX, DBL_MAX };
 
   // Compute the time rate of change of the distributions, df/dt.
   for (int b=0; b<app->num_local_blocks; ++b) {
@@ -24,18 +25,22 @@ gyrokinetic_multib_forward_euler(struct gkyl_gyrokinetic_multib_app* app, double
     int li_neut = b * app->num_neut_species;
     gyrokinetic_rhs(app->singleb_apps[b], tcurr, dt, &fin[li_charged], &fout[li_charged],
       &bflux_out[li_charged], &fin_neut[li_neut], &fout_neut[li_neut], &bflux_out_neut[li_neut], st);
-    dtmin = fmin(dtmin, st->dt_actual);
+    dtmin[0] = fmin(dtmin[0], st->dt_actual);
+    dtmin[1] = fmin(dtmin[1], st->dt_suggested);
   }
 
-  struct timespec wtm = gkyl_wall_clock();
-  // Compute minimum time-step across all processors.
-  double dtmin_local = dtmin, dtmin_global;
-  gkyl_comm_allreduce_host(app->comm, GKYL_DOUBLE, GKYL_MIN, 1, &dtmin_local, &dtmin_global);
-  st->dt_actual = dtmin_global;
-  app->stat.dfdt_dt_reduce_tm += gkyl_time_diff_now_sec(wtm);
-
-  struct timespec wst = gkyl_wall_clock();
-  // Complete update of distribution functions.
+  gkyl_region_timer_begin(app->rtimer, "dfdt_dt_reduce");
+  // Compute minimum time-steps across all processors, so that they do
+  // not depend on which blocks a rank handles.
+  double dtmin_global[2];
+  gkyl_comm_allreduce_host(app->comm, GKYL_DOUBLE, GKYL_MIN, 2, dtmin, dtmin_global);
+  st->dt_actual = dtmin_global[0];
+  st->dt_suggested = dtmin_global[1];
+  gkyl_region_timer_end(app->rtimer);
+
+  gkyl_region_timer_begin(app->rtimer, "step_f");
+  // Complete update of distribution functions. If the RK stages are fused
+  // fout keeps df/dt, and f is stepped when the stages are combined.
   double dta = st->dt_actual;
   for (int b=0; b<app->num_local_blocks; ++b) {
     struct gkyl_gyrokinetic_app *sbapp = app->singleb_apps[b];
@@ -43,18 +48,20 @@ gyrokinetic_multib_forward_euler(struct gkyl_gyrokinetic_multib_app* app, double
     int li_neut = b * app->num_neut_species;
     for (int i=0; i<app->num_species; ++i) {
       struct gk_species *gks = &sbapp->species[i];
-      gk_species_step_f(gks, fout[li_charged+i], dta, fin[li_charged+i]);
+      if (!app->fuse_rk_stages)
+        gk_species_step_f(gks, fout[li_charged+i], dta, fin[li_charged+i]);
       gk_species_bflux_step_f(sbapp, &gks->bflux, bflux_out[li_charged+i], dta, bflux_in[li_charged+i]);
     }
     for (int i=0; i<app->num_neut_species; ++i) {
       struct gk_neut_species *gkns = &sbapp->neut_species[i];
-      gk_neut_species_step_f(gkns, fout_neut[li_charged+i], dta, fin_neut[li_charged+i]);
+      if (!app->fuse_rk_stages)
+        gk_neut_species_step_f(gkns, fout_neut[li_neut+i], dta, fin_neut[li_neut+i]);
       gk_neut_species_bflux_step_f(sbapp, &gkns->bflux, bflux_out_neut[li_neut+i], dta, bflux_in_neut[li_neut+i]);
     }
   }
 
-  app->stat.fwd_euler_step_f_tm += gkyl_time_diff_now_sec(wst);
-  app->stat.fwd_euler_tm += gkyl_time_diff_now_sec(wst_fe);
+  gkyl_region_timer_end(app->rtimer); // step_f
+  gkyl_region_timer_end(app->rtimer); // fwd_euler
 }
 
 struct gkyl_update_status
@@ -116,6 +123,22 @@ gyrokinetic_multib_update_ssp_rk3(struct gkyl_gyrokinetic_multib_app* app, doubl
           fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
         dt = st.dt_actual;
 
+        if (app->fuse_rk_stages) {
+          struct timespec wst = gkyl_wall_clock();
+          for (int b=0; b<nblocks_local; ++b) {
+            struct gkyl_gyrokinetic_app *sbapp = app->singleb_apps[b];
+            for (int i=0; i<ns_charged; ++i) {
+              struct gk_species *gks = &sbapp->species[i];
+              gk_species_step_combine(gks, gks->f1, 0.0, gks->f, 1.0, gks->f, dt, gks->f1, &gks->local_ext);
+            }
+            for (int i=0; i<ns_neut; ++i) {
+              struct gk_neut_species *gkns = &sbapp->neut_species[i];
+              gk_neut_species_step_combine(gkns, gkns->f1, 0.0, gkns->f, 1.0, gkns->f, dt, gkns->f1, &gkns->local_ext);
+            }
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+        }
+
         for (int b=0; b<nblocks_local; ++b) {
           struct gkyl_gyrokinetic_app *sbapp = app->singleb_apps[b];
           for (int i=0; i<ns_charged; ++i) {
@@ -190,13 +213,19 @@ gyrokinetic_multib_update_ssp_rk3(struct gkyl_gyrokinetic_multib_app* app, doubl
             struct gkyl_gyrokinetic_app *sbapp = app->singleb_apps[b];
             for (int i=0; i<ns_charged; ++i) {
 	      struct gk_species *gks = &sbapp->species[i]; 
-	      gk_species_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->fnew, &gks->local_ext);
+              if (app->fuse_rk_stages)
+                gk_species_step_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->f1, dt, gks->fnew, &gks->local_ext);
+              else
+                gk_species_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->fnew, &gks->local_ext);
               gk_species_bflux_combine(sbapp, &gks->bflux, gks->bflux.f1,
                 3.0/4.0, gks->bflux.f, 1.0/4.0, gks->bflux.fnew);
 	    }
             for (int i=0; i<ns_neut; ++i) {
 	      struct gk_neut_species *gkns = &sbapp->neut_species[i]; 
-	      gk_neut_species_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->fnew, &gkns->local_ext);
+              if (app->fuse_rk_stages)
+                gk_neut_species_step_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->f1, dt, gkns->fnew, &gkns->local_ext);
+              else
+                gk_neut_species_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->fnew, &gkns->local_ext);
               gk_neut_species_bflux_combine(sbapp, &gkns->bflux, gkns->bflux.f1,
                 3.0/4.0, gkns->bflux.f, 1.0/4.0, gkns->bflux.fnew);
             }
@@ -277,8 +306,13 @@ gyrokinetic_multib_update_ssp_rk3(struct gkyl_gyrokinetic_multib_app* app, doubl
             for (int i=0; i<ns_charged; ++i) {
 	      struct gk_species *gks = &sbapp->species[i]; 
               // Step f.
-	      gk_species_combine(gks, gks->f1, 1.0/3.0, gks->f, 2.0/3.0, gks->fnew, &gks->local_ext);
-	      gk_species_copy_range(gks, gks->f, gks->f1, &gks->local_ext);
+              if (app->fuse_rk_stages) {
+                gk_species_step_combine(gks, gks->f, 1.0/3.0, gks->f, 2.0/3.0, gks->f1, dt, gks->fnew, &gks->local_ext);
+              }
+              else {
+                gk_species_combine(gks, gks->f1, 1.0/3.0, gks->f, 2.0/3.0, gks->fnew, &gks->local_ext);
+                gk_species_copy_range(gks, gks->f, gks->f1, &gks->local_ext);
+              }
               // Step boundary fluxes.
               gk_species_bflux_combine(sbapp, &gks->bflux, gks->bflux.f1,
                 1.0/3.0, gks->bflux.f, 2.0/3.0, gks->bflux.fnew);
@@ -288,8 +322,13 @@ gyrokinetic_multib_update_ssp_rk3(struct gkyl_gyrokinetic_multib_app* app, doubl
 	    }
             for (int i=0; i<ns_neut; ++i) {
 	      struct gk_neut_species *gkns = &sbapp->neut_species[i]; 
-	      gk_neut_species_combine(gkns, gkns->f1, 1.0/3.0, gkns->f, 2.0/3.0, gkns->fnew, &gkns->local_ext);
-	      gk_neut_species_copy_range(gkns, gkns->f, gkns->f1, &gkns->local_ext);
+              if (app->fuse_rk_stages) {
+                gk_neut_species_step_combine(gkns, gkns->f, 1.0/3.0, gkns->f, 2.0/3.0, gkns->f1, dt, gkns->fnew, &gkns->local_ext);
+              }
+              else {
+                gk_neut_species_combine(gkns, gkns->f1, 1.0/3.0, gkns->f, 2.0/3.0, gkns->fnew, &gkns->local_ext);
+                gk_neut_species_copy_range(gkns, gkns->f, gkns->f1, &gkns->local_ext);
+              }
               // Step boundary fluxes.
               gk_neut_species_bflux_combine(sbapp, &gkns->bflux, gkns->bflux.f1,
                 1.0/3.0, gkns->bflux.f, 2.0/3.0, gkns->bflux.fnew);
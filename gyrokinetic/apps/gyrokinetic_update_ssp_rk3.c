@@ -1,6 +1,6 @@
 #include <gkyl_gyrokinetic_priv.h>
 
-static void
+void
 gyrokinetic_forward_euler(gkyl_gyrokinetic_app* app, double tcurr, double dt,
   const struct gkyl_array *fin[], struct gkyl_array *fout[], 
   const struct gkyl_array **bflux_in[], struct gkyl_array **bflux_out[], 
@@ -9,7 +9,7 @@ gyrokinetic_forward_euler(gkyl_gyrokinetic_app* app, double tcurr, double dt,
   struct gkyl_update_status *st)
 {
 
-  struct timespec wst_fe = gkyl_wall_clock();
+  gkyl_region_timer_begin(app->rtimer, "fwd_euler");
   // Take a forward Euler step with the suggested time-step dt. This may
   // not be the actual time-step taken. However, the function will never
   // take a time-step larger than dt even if it is allowed by
@@ -20,22 +20,24 @@ gyrokinetic_forward_euler(gkyl_gyrokinetic_app* app, double tcurr, double dt,
   // Compute the time rate of change of the distributions, df/dt.
   gyrokinetic_rhs(app, tcurr, dt, fin, fout, bflux_out, fin_neut, fout_neut, bflux_out_neut, st);
 
-  struct timespec wst = gkyl_wall_clock();
-  // Complete update of distribution functions.
+  gkyl_region_timer_begin(app->rtimer, "step_f");
+  // Complete update of distribution functions. If the RK stages are fused
+  // fout keeps df/dt, and f is stepped when the stages are combined.
   double dta = st->dt_actual;
   for (int i=0; i<app->num_species; ++i) {
     struct gk_species *gks = &app->species[i];
-    gk_species_step_f(gks, fout[i], dta, fin[i]);
+    if (!app->fuse_rk_stages)
+      gk_species_step_f(gks, fout[i], dta, fin[i]);
     gk_species_bflux_step_f(app, &gks->bflux, bflux_out[i], dta, bflux_in[i]);
   }
   for (int i=0; i<app->num_neut_species; ++i) {
     struct gk_neut_species *gkns = &app->neut_species[i];
-    gk_neut_species_step_f(gkns, fout_neut[i], dta, fin_neut[i]);
+    if (!app->fuse_rk_stages)
+      gk_neut_species_step_f(gkns, fout_neut[i], dta, fin_neut[i]);
     gk_neut_species_bflux_step_f(app, &gkns->bflux, bflux_out_neut[i], dta, bflux_in_neut[i]);
   }
-  app->stat.fwd_euler_step_f_tm += gkyl_time_diff_now_sec(wst);
-  app->stat.fwd_euler_tm += gkyl_time_diff_now_sec(wst_fe);
-
+  gkyl_region_timer_end(app->rtimer); // step_f
+  gkyl_region_timer_end(app->rtimer); // fwd_euler
 }
 
 struct gkyl_update_status
@@ -88,6 +90,19 @@ gyrokinetic_update_ssp_rk3(gkyl_gyrokinetic_app* app, double dt0)
           fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
         dt = st.dt_actual;
 
+        if (app->fuse_rk_stages) {
+          struct timespec wst = gkyl_wall_clock();
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            gk_species_step_combine(gks, gks->f1, 0.0, gks->f, 1.0, gks->f, dt, gks->f1, &gks->local_ext);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            gk_neut_species_step_combine(gkns, gkns->f1, 0.0, gkns->f, 1.0, gkns->f, dt, gkns->f1, &gkns->local_ext);
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+        }
+
         for (int i=0; i<app->num_species; ++i) {
           struct gk_species *gks = &app->species[i];
           // Compute moment of f_old to later compute moment of df/dt.
@@ -148,13 +163,19 @@ gyrokinetic_update_ssp_rk3(gkyl_gyrokinetic_app* app, double dt0)
           struct timespec wst = gkyl_wall_clock();
           for (int i=0; i<app->num_species; ++i) {
             struct gk_species *gks = &app->species[i];
-            gk_species_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->fnew, &gks->local_ext);
+            if (app->fuse_rk_stages)
+              gk_species_step_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->f1, dt, gks->fnew, &gks->local_ext);
+            else
+              gk_species_combine(gks, gks->f1, 3.0/4.0, gks->f, 1.0/4.0, gks->fnew, &gks->local_ext);
             gk_species_bflux_combine(app, &gks->bflux, gks->bflux.f1,
               3.0/4.0, gks->bflux.f, 1.0/4.0, gks->bflux.fnew);
           }
           for (int i=0; i<app->num_neut_species; ++i) {
             struct gk_neut_species *gkns = &app->neut_species[i];
-            gk_neut_species_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->fnew, &gkns->local_ext);
+            if (app->fuse_rk_stages)
+              gk_neut_species_step_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->f1, dt, gkns->fnew, &gkns->local_ext);
+            else
+              gk_neut_species_combine(gkns, gkns->f1, 3.0/4.0, gkns->f, 1.0/4.0, gkns->fnew, &gkns->local_ext);
             gk_neut_species_bflux_combine(app, &gkns->bflux, gkns->bflux.f1,
               3.0/4.0, gkns->bflux.f, 1.0/4.0, gkns->bflux.fnew);
           }
@@ -218,8 +239,13 @@ gyrokinetic_update_ssp_rk3(gkyl_gyrokinetic_app* app, double dt0)
           for (int i=0; i<app->num_species; ++i) {
 	          struct gk_species *gks = &app->species[i];
             // Step f.
-            gk_species_combine(gks, gks->f1, 1.0/3.0, gks->f, 2.0/3.0, gks->fnew, &gks->local_ext);
-            gk_species_copy_range(gks, gks->f, gks->f1, &gks->local_ext);
+            if (app->fuse_rk_stages) {
+              gk_species_step_combine(gks, gks->f, 1.0/3.0, gks->f, 2.0/3.0, gks->f1, dt, gks->fnew, &gks->local_ext);
+            }
+            else {
+              gk_species_combine(gks, gks->f1, 1.0/3.0, gks->f, 2.0/3.0, gks->fnew, &gks->local_ext);
+              gk_species_copy_range(gks, gks->f, gks->f1, &gks->local_ext);
+            }
             // Step boundary fluxes.
             gk_species_bflux_combine(app, &gks->bflux, gks->bflux.f1,
               1.0/3.0, gks->bflux.f, 2.0/3.0, gks->bflux.fnew);
@@ -230,8 +256,13 @@ gyrokinetic_update_ssp_rk3(gkyl_gyrokinetic_app* app, double dt0)
 
           for (int i=0; i<app->num_neut_species; ++i) {
             struct gk_neut_species *gkns = &app->neut_species[i];
-            gk_neut_species_combine(gkns, gkns->f1, 1.0/3.0, gkns->f, 2.0/3.0, gkns->fnew, &gkns->local_ext);
-            gk_neut_species_copy_range(gkns, gkns->f, gkns->f1, &gkns->local_ext);
+            if (app->fuse_rk_stages) {
+              gk_neut_species_step_combine(gkns, gkns->f, 1.0/3.0, gkns->f, 2.0/3.0, gkns->f1, dt, gkns->fnew, &gkns->local_ext);
+            }
+            else {
+              gk_neut_species_combine(gkns, gkns->f1, 1.0/3.0, gkns->f, 2.0/3.0, gkns->fnew, &gkns->local_ext);
+              gk_neut_species_copy_range(gkns, gkns->f, gkns->f1, &gkns->local_ext);
+            }
             // Step boundary fluxes.
             gk_neut_species_bflux_combine(app, &gkns->bflux, gkns->bflux.f1,
               1.0/3.0, gkns->bflux.f, 2.0/3.0, gkns->bflux.fnew);
@@ -0,0 +1,302 @@
+#include <gkyl_gyrokinetic_priv.h>
+
+// Four-stage, third-order SSP-RK method (SSPRK(4,3)) in two-register form:
+//   f1   = f + h*L(f)
+//   f1   = f1 + h*L(f1)
+//   f1   = 2/3*f + 1/3*(f1 + h*L(f1))
+//   fnew = f1 + h*L(f1)
+// with h = dt/2. Every stage is a forward Euler step of h, so the method is
+// stable for dt up to twice the forward Euler time-step, compared to once
+// for SSP-RK3, for 4 RHS evaluations instead of 3. fnew only holds the
+// output of the forward Euler step, as in the RK3 stepper.
+
+// Point fin/fout (and the boundary fluxes) at the registers used by a stage:
+// stage 1 steps f into f1, the other stages step f1 into fnew.
+static void
+rk43_stage_arrays(gkyl_gyrokinetic_app* app, bool first_stage,
+  const struct gkyl_array *fin[], struct gkyl_array *fout[],
+  const struct gkyl_array **bflux_in[], struct gkyl_array **bflux_out[],
+  const struct gkyl_array *fin_neut[], struct gkyl_array *fout_neut[],
+  const struct gkyl_array **bflux_in_neut[], struct gkyl_array **bflux_out_neut[])
+{
+  for (int i=0; i<app->num_species; ++i) {
+    struct gk_species *gks = &app->species[i];
+    fin[i] = first_stage ? gks->f : gks->f1;
+    fout[i] = first_stage ? gks->f1 : gks->fnew;
+    bflux_in[i] = (const struct gkyl_array **)(first_stage ? gks->bflux.f : gks->bflux.f1);
+    bflux_out[i] = first_stage ? gks->bflux.f1 : gks->bflux.fnew;
+  }
+  for (int i=0; i<app->num_neut_species; ++i) {
+    struct gk_neut_species *gkns = &app->neut_species[i];
+    fin_neut[i] = first_stage ? gkns->f : gkns->f1;
+    fout_neut[i] = first_stage ? gkns->f1 : gkns->fnew;
+    bflux_in_neut[i] = (const struct gkyl_array **)(first_stage ? gkns->bflux.f : gkns->bflux.f1);
+    bflux_out_neut[i] = first_stage ? gkns->bflux.f1 : gkns->bflux.fnew;
+  }
+}
+
+// Handle a stage that could not take the step h. Recomputes the field from
+// f, collects stats and returns the step to restart stage 1 with.
+static double
+rk43_stage_fail(gkyl_gyrokinetic_app* app, double tcurr, double h, double h_actual,
+  bool second_stage)
+{
+  const struct gkyl_array *fin[app->num_species];
+  for (int i=0; i<app->num_species; ++i)
+    fin[i] = app->species[i].f;
+  gyrokinetic_calc_field(app, tcurr, fin);
+
+  double dt_rel_diff = (h-h_actual)/h_actual;
+  double *dt_diff = second_stage ? app->stat.stage_2_dt_diff : app->stat.stage_3_dt_diff;
+  dt_diff[0] = fmin(dt_diff[0], dt_rel_diff);
+  dt_diff[1] = fmax(dt_diff[1], dt_rel_diff);
+  if (second_stage)
+    app->stat.nstage_2_fail += 1;
+  else
+    app->stat.nstage_3_fail += 1;
+
+  return h_actual;
+}
+
+struct gkyl_update_status
+gyrokinetic_update_ssp_rk43(gkyl_gyrokinetic_app* app, double dt0)
+{
+  const struct gkyl_array *fin[app->num_species];
+  struct gkyl_array *fout[app->num_species];
+  const struct gkyl_array **bflux_in[app->num_species];
+  struct gkyl_array **bflux_out[app->num_species];
+
+  const struct gkyl_array *fin_neut[app->num_neut_species];
+  struct gkyl_array *fout_neut[app->num_neut_species];
+  const struct gkyl_array **bflux_in_neut[app->num_neut_species];
+  struct gkyl_array **bflux_out_neut[app->num_neut_species];
+
+  struct gkyl_update_status st = { .success = true };
+
+  // time-stepper state
+  enum { RK_STAGE_1, RK_STAGE_2, RK_STAGE_3, RK_STAGE_4, RK_COMPLETE } state = RK_STAGE_1;
+
+  // h is the forward Euler step of each stage, dt = 2*h.
+  double tcurr = app->tcurr, h = dt0/2.0;
+  while (state != RK_COMPLETE) {
+    switch (state) {
+      case RK_STAGE_1:
+        for (int i=0; i<app->num_species; ++i) {
+          struct gk_species *gks = &app->species[i];
+          gk_species_bflux_clear(app, &gks->bflux, gks->bflux.f, 0.0);
+          gk_species_bflux_clear(app, &gks->bflux, gks->bflux.f1, 0.0);
+        }
+        for (int i=0; i<app->num_neut_species; ++i) {
+          struct gk_neut_species *gkns = &app->neut_species[i];
+          gk_neut_species_bflux_clear(app, &gkns->bflux, gkns->bflux.f, 0.0);
+          gk_neut_species_bflux_clear(app, &gkns->bflux, gkns->bflux.f1, 0.0);
+        }
+        rk43_stage_arrays(app, true, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+
+        gyrokinetic_forward_euler(app, tcurr, h, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
+        h = st.dt_actual;
+
+        if (app->fuse_rk_stages) {
+          struct timespec wst = gkyl_wall_clock();
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            gk_species_step_combine(gks, gks->f1, 0.0, gks->f, 1.0, gks->f, h, gks->f1, &gks->local_ext);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            gk_neut_species_step_combine(gkns, gkns->f1, 0.0, gkns->f, 1.0, gkns->f, h, gkns->f1, &gkns->local_ext);
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+        }
+
+        for (int i=0; i<app->num_species; ++i) {
+          struct gk_species *gks = &app->species[i];
+          // Compute moment of f_old to later compute moment of df/dt.
+          gk_species_calc_int_mom_dt(app, gks, 2.0*h, gks->fdot_mom_old);
+        }
+
+        // Compute field energy divided by dt for energy balance diagnostics.
+        gk_field_calc_energy_dt(app, app->field, 2.0*h, app->field->em_energy_red_old);
+
+        // Compute the fields and apply BCs.
+        gyrokinetic_calc_field_and_apply_bc(app, tcurr, fout, fout_neut);
+
+        state = RK_STAGE_2;
+        break;
+
+      case RK_STAGE_2:
+        rk43_stage_arrays(app, false, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+
+        gyrokinetic_forward_euler(app, tcurr+h, h, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
+
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, tcurr, h, st.dt_actual, true);
+          state = RK_STAGE_1; // Restart from stage 1.
+        }
+        else {
+          // f1 = f1 + h*L(f1).
+          struct timespec wst = gkyl_wall_clock();
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            if (app->fuse_rk_stages)
+              gk_species_step_combine(gks, gks->f1, 0.0, gks->f, 1.0, gks->f1, h, gks->fnew, &gks->local_ext);
+            else
+              gk_species_copy_range(gks, gks->f1, gks->fnew, &gks->local_ext);
+            gk_species_bflux_copy(app, &gks->bflux, gks->bflux.f1, gks->bflux.fnew);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            if (app->fuse_rk_stages)
+              gk_neut_species_step_combine(gkns, gkns->f1, 0.0, gkns->f, 1.0, gkns->f1, h, gkns->fnew, &gkns->local_ext);
+            else
+              gk_neut_species_copy_range(gkns, gkns->f1, gkns->fnew, &gkns->local_ext);
+            gk_neut_species_bflux_copy(app, &gkns->bflux, gkns->bflux.f1, gkns->bflux.fnew);
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+
+          // Compute the fields and apply BCs.
+          rk43_stage_arrays(app, true, fin, fout, bflux_in, bflux_out,
+            fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+          gyrokinetic_calc_field_and_apply_bc(app, tcurr, fout, fout_neut);
+
+          state = RK_STAGE_3;
+        }
+        break;
+
+      case RK_STAGE_3:
+        rk43_stage_arrays(app, false, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+
+        gyrokinetic_forward_euler(app, tcurr+2.0*h, h, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
+
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, tcurr, h, st.dt_actual, false);
+          state = RK_STAGE_1; // Restart from stage 1.
+        }
+        else {
+          // f1 = 2/3*f + 1/3*(f1 + h*L(f1)).
+          struct timespec wst = gkyl_wall_clock();
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            if (app->fuse_rk_stages)
+              gk_species_step_combine(gks, gks->f1, 2.0/3.0, gks->f, 1.0/3.0, gks->f1, h, gks->fnew, &gks->local_ext);
+            else
+              gk_species_combine(gks, gks->f1, 1.0/3.0, gks->fnew, 2.0/3.0, gks->f, &gks->local_ext);
+            gk_species_bflux_combine(app, &gks->bflux, gks->bflux.f1,
+              1.0/3.0, gks->bflux.fnew, 2.0/3.0, gks->bflux.f);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            if (app->fuse_rk_stages)
+              gk_neut_species_step_combine(gkns, gkns->f1, 2.0/3.0, gkns->f, 1.0/3.0, gkns->f1, h, gkns->fnew, &gkns->local_ext);
+            else
+              gk_neut_species_combine(gkns, gkns->f1, 1.0/3.0, gkns->fnew, 2.0/3.0, gkns->f, &gkns->local_ext);
+            gk_neut_species_bflux_combine(app, &gkns->bflux, gkns->bflux.f1,
+              1.0/3.0, gkns->bflux.fnew, 2.0/3.0, gkns->bflux.f);
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+
+          // Compute the fields and apply BCs.
+          rk43_stage_arrays(app, true, fin, fout, bflux_in, bflux_out,
+            fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+          gyrokinetic_calc_field_and_apply_bc(app, tcurr, fout, fout_neut);
+
+          state = RK_STAGE_4;
+        }
+        break;
+
+      case RK_STAGE_4:
+        rk43_stage_arrays(app, false, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut);
+
+        gyrokinetic_forward_euler(app, tcurr+h, h, fin, fout, bflux_in, bflux_out,
+          fin_neut, fout_neut, bflux_in_neut, bflux_out_neut, &st);
+
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, tcurr, h, st.dt_actual, false);
+          state = RK_STAGE_1; // Restart from stage 1.
+        }
+        else {
+          double dt = 2.0*h;
+          // f = f1 + h*L(f1).
+          struct timespec wst = gkyl_wall_clock();
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            if (app->fuse_rk_stages)
+              gk_species_step_combine(gks, gks->f, 0.0, gks->f, 1.0, gks->f1, h, gks->fnew, &gks->local_ext);
+            else
+              gk_species_copy_range(gks, gks->f, gks->fnew, &gks->local_ext);
+            // Step boundary fluxes.
+            gk_species_bflux_copy(app, &gks->bflux, gks->bflux.f, gks->bflux.fnew);
+            gk_species_bflux_calc_voltime_integrated_mom(app, gks, &gks->bflux, tcurr);
+            gk_species_bflux_scale(app, &gks->bflux, gks->bflux.f, 1.0/dt);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            if (app->fuse_rk_stages)
+              gk_neut_species_step_combine(gkns, gkns->f, 0.0, gkns->f, 1.0, gkns->f1, h, gkns->fnew, &gkns->local_ext);
+            else
+              gk_neut_species_copy_range(gkns, gkns->f, gkns->fnew, &gkns->local_ext);
+            // Step boundary fluxes.
+            gk_neut_species_bflux_copy(app, &gkns->bflux, gkns->bflux.f, gkns->bflux.fnew);
+            gk_neut_species_bflux_calc_voltime_integrated_mom(app, gkns, &gkns->bflux, tcurr);
+            gk_neut_species_bflux_scale(app, &gkns->bflux, gkns->bflux.f, 1.0/dt);
+          }
+          app->stat.time_stepper_arithmetic_tm += gkyl_time_diff_now_sec(wst);
+
+          // Apply positivity shift if requested.
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            gk_species_apply_pos_shift(app, gks);
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            struct gk_neut_species *gkns = &app->neut_species[i];
+            gk_neut_species_apply_pos_shift(app, gkns);
+          }
+
+          // Enforce quasineutrality of the positivity shifts.
+          gyrokinetic_pos_shift_quasineutrality(app);
+
+          // Compute the fields and apply BCs
+          for (int i=0; i<app->num_species; ++i) {
+            fout[i] = app->species[i].f;
+          }
+          for (int i=0; i<app->num_neut_species; ++i) {
+            fout_neut[i] = app->neut_species[i].f;
+          }
+          gyrokinetic_calc_field_and_apply_bc(app, tcurr, fout, fout_neut);
+
+          for (int i=0; i<app->num_species; ++i) {
+            struct gk_species *gks = &app->species[i];
+            // Compute moment of f_new to compute moment of df/dt.
+            // Need to do it after the fields are updated.
+            gk_species_calc_int_mom_dt(app, gks, dt, gks->fdot_mom_new);
+
+            // adapt the sources
+            gk_species_source_adapt(app, gks, &gks->src, gks->lte.f_lte, tcurr);
+          }
+
+          // Compute field energy divided by dt for energy balance diagnostics.
+          gk_field_calc_energy_dt(app, app->field, dt, app->field->em_energy_red_new);
+
+          // Report the full step, and the largest stable one, which is
+          // twice the forward Euler step.
+          st.dt_actual = dt;
+          st.dt_suggested = 2.0*st.dt_suggested;
+
+          state = RK_COMPLETE;
+        }
+        break;
+
+      case RK_COMPLETE: // can't happen: suppresses warning
+        break;
+    }
+  }
+
+  return st;
+}
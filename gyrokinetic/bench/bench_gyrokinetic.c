@@ -0,0 +1,325 @@
+// Benchmarks of the gyrokinetic volume, surface and boundary-surface
+// kernels over dimensions. The kernels are called directly on synthetic
+// data laid out as in the app. Run with -h for options.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_basis.h>
+#include <gkyl_bench.h>
+#include <gkyl_gyrokinetic_kernels.h>
+#include <gkyl_util.h>
+
+typedef double (*gk_vol_t)(const double *w, const double *dxv,
+  const double *vmap, const double *vmapSq, const double q_, const double m_,
+  const double *bmag, const double *jacobtot_inv, const double *cmag, const double *b_i, const double *phi,
+  const double *apar, const double* apardot, const double *fin, double* GKYL_RESTRICT out);
+
+typedef double (*gk_surf_t)(const double *w, const double *dxv,
+  const double *vmap_prime_l, const double *vmap_prime_c, const double *vmap_prime_r,
+  const double *alpha_surf_l, const double *alpha_surf_r,
+  const double *sgn_alpha_surf_l, const double *sgn_alpha_surf_r,
+  const int *const_sgn_alpha_l, const int *const_sgn_alpha_r,
+  const double *fl, const double *fc, const double *fr, double* GKYL_RESTRICT out);
+
+typedef double (*gk_boundary_surf_t)(const double *w, const double *dxv,
+  const double *vmap_prime_edge, const double *vmap_prime_skin,
+  const double *alpha_surf_edge, const double *alpha_surf_skin,
+  const double *sgn_alpha_surf_edge, const double *sgn_alpha_surf_skin,
+  const int *const_sgn_alpha_edge, const int *const_sgn_alpha_skin,
+  const int edge, const double *fedge, const double *fskin, double* GKYL_RESTRICT out);
+
+// Kernels for one dimensionality and polynomial order. Surface kernels
+// are indexed by direction: configuration-space directions, then vpar.
+struct gk_kernels {
+  int cdim, vdim, poly_order;
+  gk_vol_t vol;
+  gk_surf_t surf[4];
+  gk_boundary_surf_t boundary_surf[4];
+};
+
+#define GK_KERNELS_1X(cd, vd, p) { cd, vd, p,                           \
+    gyrokinetic_vol_##cd##x##vd##v_ser_p##p,                            \
+    { gyrokinetic_surfx_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfvpar_##cd##x##vd##v_ser_p##p },                   \
+    { gyrokinetic_boundary_surfx_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfvpar_##cd##x##vd##v_ser_p##p } }
+
+#define GK_KERNELS_2X(cd, vd, p) { cd, vd, p,                           \
+    gyrokinetic_vol_##cd##x##vd##v_ser_p##p,                            \
+    { gyrokinetic_surfx_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfy_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfvpar_##cd##x##vd##v_ser_p##p },                   \
+    { gyrokinetic_boundary_surfx_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfy_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfvpar_##cd##x##vd##v_ser_p##p } }
+
+#define GK_KERNELS_3X(cd, vd, p) { cd, vd, p,                           \
+    gyrokinetic_vol_##cd##x##vd##v_ser_p##p,                            \
+    { gyrokinetic_surfx_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfy_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfz_##cd##x##vd##v_ser_p##p,                        \
+      gyrokinetic_surfvpar_##cd##x##vd##v_ser_p##p },                   \
+    { gyrokinetic_boundary_surfx_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfy_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfz_##cd##x##vd##v_ser_p##p,               \
+      gyrokinetic_boundary_surfvpar_##cd##x##vd##v_ser_p##p } }
+
+// Only p=1 kernels are generated at present.
+static const struct gk_kernels gk_kernel_list[] = {
+  GK_KERNELS_1X(1, 1, 1),
+  GK_KERNELS_1X(1, 2, 1),
+  GK_KERNELS_2X(2, 2, 1),
+  GK_KERNELS_3X(3, 2, 1),
+};
+
+// Size of buffers for configuration-space fields and velocity maps:
+// larger than any of the kernels read.
+enum { AUX_SZ = 128 };
+
+struct gk_ctx {
+  const struct gk_kernels *kern;
+  int pdim, num_basis;
+  long ncells; // number of phase-space cells
+  long stride[GKYL_MAX_DIM]; // stride between neighbors in each direction
+  int alpha_sz, sgn_alpha_sz, const_sgn_sz; // per-cell sizes of alpha_surf etc
+  double w[GKYL_MAX_DIM], dxv[GKYL_MAX_DIM];
+  double *f, *rhs;
+  double *alpha_surf, *sgn_alpha_surf;
+  int *const_sgn_alpha;
+  // Same configuration-space fields and velocity map in each cell.
+  double vmap[AUX_SZ], vmapSq[AUX_SZ], vmap_prime[AUX_SZ];
+  double bmag[AUX_SZ], jacobtot_inv[AUX_SZ], cmag[AUX_SZ], b_i[3*AUX_SZ];
+  double phi[AUX_SZ], apar[AUX_SZ], apardot[AUX_SZ];
+  int dir; // direction for surface kernels
+};
+
+static void
+fill(double *d, long n, double offset, double scale)
+{
+  for (long i=0; i<n; ++i)
+    d[i] = offset + scale*(rand()/(RAND_MAX+1.0) - 0.5);
+}
+
+static inline void
+call_vol(const struct gk_ctx *gc, const double *fin, double *out)
+{
+  gc->kern->vol(gc->w, gc->dxv, gc->vmap, gc->vmapSq, 1.0, 1.0,
+    gc->bmag, gc->jacobtot_inv, gc->cmag, gc->b_i, gc->phi, gc->apar, gc->apardot,
+    fin, out);
+}
+
+static inline void
+call_surf(const struct gk_ctx *gc, long lc, long lr,
+  const double *fl, const double *fc, const double *fr, double *out)
+{
+  gc->kern->surf[gc->dir](gc->w, gc->dxv,
+    gc->vmap_prime, gc->vmap_prime, gc->vmap_prime,
+    gc->alpha_surf+lc*gc->alpha_sz, gc->alpha_surf+lr*gc->alpha_sz,
+    gc->sgn_alpha_surf+lc*gc->sgn_alpha_sz, gc->sgn_alpha_surf+lr*gc->sgn_alpha_sz,
+    gc->const_sgn_alpha+lc*gc->const_sgn_sz, gc->const_sgn_alpha+lr*gc->const_sgn_sz,
+    fl, fc, fr, out);
+}
+
+static inline void
+call_boundary_surf(const struct gk_ctx *gc, long le, long ls,
+  const double *fedge, const double *fskin, double *out)
+{
+  gc->kern->boundary_surf[gc->dir](gc->w, gc->dxv,
+    gc->vmap_prime, gc->vmap_prime,
+    gc->alpha_surf+le*gc->alpha_sz, gc->alpha_surf+ls*gc->alpha_sz,
+    gc->sgn_alpha_surf+le*gc->sgn_alpha_sz, gc->sgn_alpha_surf+ls*gc->sgn_alpha_sz,
+    gc->const_sgn_alpha+le*gc->const_sgn_sz, gc->const_sgn_alpha+ls*gc->const_sgn_sz,
+    -1, fedge, fskin, out);
+}
+
+static void
+bench_vol(void *ctx, long ncells)
+{
+  struct gk_ctx *gc = ctx;
+  int nb = gc->num_basis;
+  for (long i=0; i<ncells; ++i)
+    call_vol(gc, gc->f+i*nb, gc->rhs+i*nb);
+}
+
+// Surface kernels are timed in all cells with both neighbors in dir.
+static void
+bench_surf(void *ctx, long ncells)
+{
+  struct gk_ctx *gc = ctx;
+  int nb = gc->num_basis;
+  long s = gc->stride[gc->dir];
+  for (long i=s; i<s+ncells; ++i)
+    call_surf(gc, i, i+s, gc->f+(i-s)*nb, gc->f+i*nb, gc->f+(i+s)*nb, gc->rhs+i*nb);
+}
+
+// Boundary-surface kernels are timed in all cells with an upper
+// neighbor in dir, to get a stable time per call.
+static void
+bench_boundary_surf(void *ctx, long ncells)
+{
+  struct gk_ctx *gc = ctx;
+  int nb = gc->num_basis;
+  long s = gc->stride[gc->dir];
+  for (long i=0; i<ncells; ++i)
+    call_boundary_surf(gc, i+s, i, gc->f+(i+s)*nb, gc->f+i*nb, gc->rhs+i*nb);
+}
+
+// Kernels applied to a single cell, for counting FLOPs.
+static void
+linear_vol(void *ctx, const double *inp, double *out)
+{
+  struct gk_ctx *gc = ctx;
+  for (int k=0; k<gc->num_basis; ++k) out[k] = 0.0;
+  call_vol(gc, inp, out);
+}
+
+static void
+linear_surf(void *ctx, const double *inp, double *out)
+{
+  struct gk_ctx *gc = ctx;
+  int nb = gc->num_basis;
+  for (int k=0; k<nb; ++k) out[k] = 0.0;
+  call_surf(gc, gc->stride[gc->dir], 2*gc->stride[gc->dir], inp, inp+nb, inp+2*nb, out);
+}
+
+static void
+linear_boundary_surf(void *ctx, const double *inp, double *out)
+{
+  struct gk_ctx *gc = ctx;
+  int nb = gc->num_basis;
+  for (int k=0; k<nb; ++k) out[k] = 0.0;
+  call_boundary_surf(gc, gc->stride[gc->dir], 0, inp, inp+nb, out);
+}
+
+static void
+gk_kernels(gkyl_bench *bench, const struct gk_kernels *kern)
+{
+  int cdim = kern->cdim, vdim = kern->vdim, poly_order = kern->poly_order;
+  int pdim = cdim+vdim;
+
+  // Bases and sizes of alpha_surf and sgn_alpha_surf, as in the app.
+  struct gkyl_basis basis, surf_basis, surf_quad_basis;
+  if (poly_order > 1) {
+    gkyl_cart_modal_serendip(&basis, pdim, poly_order);
+    gkyl_cart_modal_serendip(&surf_basis, pdim-1, poly_order);
+    gkyl_cart_modal_tensor(&surf_quad_basis, pdim-1, poly_order);
+  }
+  else {
+    gkyl_cart_modal_gkhybrid(&basis, cdim, vdim);
+    if (vdim > 1) {
+      gkyl_cart_modal_gkhybrid(&surf_basis, cdim-1, vdim);
+      gkyl_cart_modal_gkhybrid(&surf_quad_basis, cdim-1, vdim);
+    }
+    else {
+      gkyl_cart_modal_serendip(&surf_basis, pdim-1, 2);
+      gkyl_cart_modal_tensor(&surf_quad_basis, pdim-1, 2);
+    }
+  }
+  int nb = basis.num_basis;
+
+  struct gk_ctx gc = {
+    .kern = kern,
+    .pdim = pdim,
+    .num_basis = nb,
+    .alpha_sz = (cdim+1)*surf_basis.num_basis,
+    .sgn_alpha_sz = (cdim+1)*surf_quad_basis.num_basis,
+    .const_sgn_sz = cdim+1,
+  };
+
+  // About 32 MB in f, with at least 4 cells in each direction.
+  int ncdir = GKYL_MAX2(4, (int) floor(pow((1L << 22)/nb, 1.0/pdim)));
+  gc.ncells = 1;
+  for (int d=pdim-1; d>=0; --d) {
+    gc.stride[d] = gc.ncells;
+    gc.ncells *= ncdir;
+    gc.w[d] = 0.1*(d+1);
+    gc.dxv[d] = 2.0/ncdir;
+  }
+
+  srand(1);
+  gc.f = gkyl_malloc(sizeof(double[gc.ncells*nb]));
+  gc.rhs = gkyl_malloc(sizeof(double[gc.ncells*nb]));
+  gc.alpha_surf = gkyl_malloc(sizeof(double[gc.ncells*gc.alpha_sz]));
+  gc.sgn_alpha_surf = gkyl_malloc(sizeof(double[gc.ncells*gc.sgn_alpha_sz]));
+  gc.const_sgn_alpha = gkyl_malloc(sizeof(int[gc.ncells*gc.const_sgn_sz]));
+  fill(gc.f, gc.ncells*nb, 1.0, 1.0);
+  fill(gc.rhs, gc.ncells*nb, 0.0, 0.0);
+  fill(gc.alpha_surf, gc.ncells*gc.alpha_sz, 0.0, 1.0);
+  // Mixed signs at the quadrature points, so the kernels take the
+  // general (most expensive) upwinding path.
+  for (long i=0; i<gc.ncells*gc.sgn_alpha_sz; ++i)
+    gc.sgn_alpha_surf[i] = i % 2 ? 1.0 : -1.0;
+  for (long i=0; i<gc.ncells*gc.const_sgn_sz; ++i)
+    gc.const_sgn_alpha[i] = 0;
+
+  fill(gc.vmap, AUX_SZ, 1.0, 0.5);
+  fill(gc.vmapSq, AUX_SZ, 1.0, 0.5);
+  fill(gc.vmap_prime, AUX_SZ, 1.0, 0.5);
+  fill(gc.bmag, AUX_SZ, 1.0, 0.5);
+  fill(gc.jacobtot_inv, AUX_SZ, 1.0, 0.5);
+  fill(gc.cmag, AUX_SZ, 1.0, 0.5);
+  fill(gc.b_i, 3*AUX_SZ, 0.5, 0.5);
+  fill(gc.phi, AUX_SZ, 0.0, 1.0);
+  fill(gc.apar, AUX_SZ, 0.0, 1.0);
+  fill(gc.apardot, AUX_SZ, 0.0, 1.0);
+
+  char prefix[64], nm[128];
+  snprintf(prefix, sizeof prefix, "gyrokinetic_%dx%dv_ser_p%d", cdim, vdim, poly_order);
+
+  double fbytes = sizeof(double[nb]);
+  // f is read, and the RHS read and written.
+  struct gkyl_bench_work work = { .bytes = 3*fbytes };
+
+  snprintf(nm, sizeof nm, "%s_vol", prefix);
+  if (gkyl_bench_enabled(bench, nm)) {
+    work.flops = gkyl_bench_linear_flops(linear_vol, &gc, nb, nb);
+    gkyl_bench_run(bench, nm, bench_vol, &gc, gc.ncells, work);
+  }
+
+  // The surface kernels also read alpha_surf and its sign.
+  struct gkyl_bench_work surf_work = {
+    .bytes = 3*fbytes + sizeof(double[gc.alpha_sz + gc.sgn_alpha_sz]) + sizeof(int[gc.const_sgn_sz])
+  };
+  const char *dnames[] = { "x", "y", "z" };
+  for (int d=0; d<=cdim; ++d) {
+    gc.dir = d;
+    const char *dnm = d < cdim ? dnames[d] : "vpar";
+
+    snprintf(nm, sizeof nm, "%s_surf%s", prefix, dnm);
+    if (gkyl_bench_enabled(bench, nm)) {
+      surf_work.flops = gkyl_bench_linear_flops(linear_surf, &gc, 3*nb, nb);
+      gkyl_bench_run(bench, nm, bench_surf, &gc, gc.ncells-2*gc.stride[d], surf_work);
+    }
+
+    snprintf(nm, sizeof nm, "%s_boundary_surf%s", prefix, dnm);
+    if (gkyl_bench_enabled(bench, nm)) {
+      surf_work.flops = gkyl_bench_linear_flops(linear_boundary_surf, &gc, 2*nb, nb);
+      gkyl_bench_run(bench, nm, bench_boundary_surf, &gc, gc.ncells-gc.stride[d], surf_work);
+    }
+  }
+
+  gkyl_free(gc.f);
+  gkyl_free(gc.rhs);
+  gkyl_free(gc.alpha_surf);
+  gkyl_free(gc.sgn_alpha_surf);
+  gkyl_free(gc.const_sgn_alpha);
+}
+
+int
+main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "-h") == 0) {
+    printf("Usage: %s [-b baseline] [-o output] [-f filter] [-t threshold] [-m min-time]\n", argv[0]);
+    return 0;
+  }
+  struct gkyl_bench_inp inp = gkyl_bench_parse_args(argc, argv);
+  gkyl_bench *bench = gkyl_bench_new(&inp);
+
+  for (int i=0; i<sizeof(gk_kernel_list)/sizeof(gk_kernel_list[0]); ++i)
+    gk_kernels(bench, &gk_kernel_list[i]);
+
+  return gkyl_bench_release(bench) > 0 ? 1 : 0;
+}
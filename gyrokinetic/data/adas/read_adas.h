@@ -7,6 +7,7 @@
 #include <gkyl_array.h>
 #include <gkyl_eqn_type.h>
 #include <gkyl_range.h>
+#include <gkyl_rate_table.h>
 #include <gkyl_util.h>
 
 typedef struct adas_field {
@@ -45,6 +46,45 @@ minmax_from_numpy(FILE *fp, long sz, double minmax[2])
   minmax[1] = max;
 }
 
+// Get the rate table for a charge state from the ADAS data, only reading
+// and projecting it if it isn't already in the process-wide cache. Closes
+// the ADAS data files.
+static inline struct gkyl_rate_table*
+adas_rate_table(struct adas_field *data, int charge_state, const char *name)
+{
+  struct gkyl_rate_table *tab = gkyl_rate_table_cache_find(name);
+  if (!tab) {
+    if (data->logT == NULL) fprintf(stderr, "Unable to load ADAS 'logT_<elem>.npy' file. ");
+    if (data->logN == NULL) fprintf(stderr, "Unable to load ADAS 'logN_<elem>.npy' file. ");
+    if (data->logData == NULL) fprintf(stderr, "Unable to load ADAS data file. ");
+
+    long sz = data->NT*data->NN;
+    double minmax_t[2], minmax_n[2];
+    minmax_from_numpy(data->logT, data->NT, minmax_t);
+    minmax_from_numpy(data->logN, data->NN, minmax_n);
+    struct gkyl_array *adas_nodal = gkyl_array_new(GKYL_DOUBLE, 1, sz);
+    array_from_numpy(data->logData, sz, data->Zmax, charge_state, adas_nodal);
+
+    tab = gkyl_rate_table_new( &(struct gkyl_rate_table_inp) {
+        .num_temp = data->NT,
+        .num_den = data->NN,
+        .log_temp_min = minmax_t[0],
+        .log_temp_max = minmax_t[1],
+        // Adjust for 1/cm^3 to 1/m^3 conversion.
+        .log_den_min = minmax_n[0]+6.,
+        .log_den_max = minmax_n[1]+6.,
+        .log_rate = adas_nodal->data,
+      }, name
+    );
+    gkyl_array_release(adas_nodal);
+  }
+
+  if (data->logT) fclose(data->logT);
+  if (data->logN) fclose(data->logN);
+  if (data->logData) fclose(data->logData);
+  return tab;
+}
+
 void
 read_adas_field_iz(enum gkyl_ion_type type_ion, struct adas_field *data);
  
@@ -0,0 +1,178 @@
+// Test the substructured parallel projection against the projection
+// solved on the whole range.
+//
+#include <acutest.h>
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_fem_parproj.h>
+#include <gkyl_fem_parproj_schur.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_decomp.h>
+
+#include <math.h>
+
+static double
+rand_in(double lo, double hi)
+{
+  return lo + (hi - lo)*rand()/(double) RAND_MAX;
+}
+
+// Fill field with random coefficients, with a mean of 'mean' and
+// small variations (so that weights stay positive).
+static void
+rand_field(struct gkyl_array *fld, double mean, double amp)
+{
+  for (long i=0; i<fld->size; ++i) {
+    double *f = gkyl_array_fetch(fld, i);
+    for (int k=0; k<fld->ncomp; ++k)
+      f[k] = rand_in(-amp, amp);
+    f[0] += mean;
+  }
+}
+
+static void
+test_chain(int ndim, int num_pieces, const int *piece_cells, bool is_periodic, bool use_weights)
+{
+  srand(ndim*10 + num_pieces);
+
+  int cells[] = { 3, 2, 0 };
+  cells[ndim-1] = 0;
+  for (int q=0; q<num_pieces; ++q)
+    cells[ndim-1] += piece_cells[q];
+  int pardir = ndim-1;
+
+  struct gkyl_basis basis;
+  gkyl_cart_modal_serendip(&basis, ndim, 1);
+
+  int lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM], nghost[GKYL_MAX_DIM];
+  for (int d=0; d<ndim; ++d) {
+    lower[d] = 1;
+    upper[d] = cells[d];
+    nghost[d] = 1;
+  }
+  struct gkyl_range range_base, range, range_ext;
+  gkyl_range_init(&range_base, ndim, lower, upper);
+  gkyl_create_ranges(&range_base, nghost, &range_ext, &range);
+
+  double wfac = sqrt(pow(2.0, ndim));
+  struct gkyl_array *rho = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, range_ext.volume);
+  struct gkyl_array *phi = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, range_ext.volume);
+  struct gkyl_array *phi_ref = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, range_ext.volume);
+  rand_field(rho, 0.0, 1.0);
+  struct gkyl_array *wl = 0, *wr = 0;
+  if (use_weights) {
+    wl = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, range_ext.volume);
+    wr = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, range_ext.volume);
+    rand_field(wl, 2.0*wfac, 0.2);
+    rand_field(wr, 1.0*wfac, 0.2);
+  }
+
+  // Reference solution.
+  enum gkyl_fem_parproj_bc_type bc = is_periodic ? GKYL_FEM_PARPROJ_PERIODIC : GKYL_FEM_PARPROJ_NONE;
+  struct gkyl_fem_parproj *parproj = gkyl_fem_parproj_new(&range, &basis, bc, wl, wr, false);
+  gkyl_fem_parproj_set_rhs(parproj, rho, rho);
+  gkyl_fem_parproj_solve(parproj, phi_ref);
+
+  // Range of the interface records: one cell along z per piece.
+  int chain_lower[GKYL_MAX_DIM], chain_upper[GKYL_MAX_DIM];
+  for (int d=0; d<ndim; ++d) {
+    chain_lower[d] = lower[d];
+    chain_upper[d] = upper[d];
+  }
+  chain_lower[pardir] = 0;
+  chain_upper[pardir] = num_pieces-1;
+  struct gkyl_range chain_range;
+  gkyl_range_init(&chain_range, ndim, chain_lower, chain_upper);
+
+  struct gkyl_fem_parproj_schur *pieces[num_pieces];
+  struct gkyl_range piece_range[num_pieces], iface_range[num_pieces];
+  for (int q=0, zlo=1; q<num_pieces; zlo+=piece_cells[q], ++q) {
+    int plo[GKYL_MAX_DIM], pup[GKYL_MAX_DIM];
+    for (int d=0; d<ndim; ++d) {
+      plo[d] = lower[d];
+      pup[d] = upper[d];
+    }
+    plo[pardir] = zlo;
+    pup[pardir] = zlo + piece_cells[q] - 1;
+    gkyl_sub_range_init(&piece_range[q], &range_ext, plo, pup);
+
+    chain_lower[pardir] = chain_upper[pardir] = q;
+    gkyl_sub_range_init(&iface_range[q], &chain_range, chain_lower, chain_upper);
+
+    pieces[q] = gkyl_fem_parproj_schur_new(&(struct gkyl_fem_parproj_schur_inp) {
+        .local_range = &piece_range[q],
+        .basis = &basis,
+        .piece = q,
+        .num_pieces = num_pieces,
+        .is_periodic = is_periodic,
+        .weight_left = wl,
+        .weight_right = wr,
+      }
+    );
+  }
+
+  struct gkyl_array *schur = gkyl_array_new(GKYL_DOUBLE,
+    gkyl_fem_parproj_schur_schur_ncomp(pieces[0]), chain_range.volume);
+  struct gkyl_array *resid = gkyl_array_new(GKYL_DOUBLE,
+    gkyl_fem_parproj_schur_resid_ncomp(pieces[0]), chain_range.volume);
+
+  for (int q=0; q<num_pieces; ++q)
+    gkyl_fem_parproj_schur_get_schur(pieces[q], &iface_range[q], schur);
+  for (int q=0; q<num_pieces; ++q)
+    gkyl_fem_parproj_schur_set_schur(pieces[q], &chain_range, schur);
+
+  // Solve twice, in place, to check that the solve can be repeated.
+  for (int s=0; s<2; ++s) {
+    gkyl_array_copy(phi, rho);
+    for (int q=0; q<num_pieces; ++q)
+      gkyl_fem_parproj_schur_set_rhs(pieces[q], phi, &iface_range[q], resid);
+    for (int q=0; q<num_pieces; ++q)
+      gkyl_fem_parproj_schur_solve(pieces[q], &chain_range, resid, phi);
+
+    struct gkyl_range_iter iter;
+    gkyl_range_iter_init(&iter, &range);
+    while (gkyl_range_iter_next(&iter)) {
+      long loc = gkyl_range_idx(&range, iter.idx);
+      const double *f = gkyl_array_cfetch(phi, loc), *fref = gkyl_array_cfetch(phi_ref, loc);
+      for (int k=0; k<basis.num_basis; ++k) {
+        TEST_CHECK( fabs(fref[k] - f[k]) < 1e-12*(1.0 + fabs(fref[k])) );
+        TEST_MSG("ndim %d, pieces %d, cell %d k %d: expected %.14e, got %.14e", ndim, num_pieces, iter.idx[pardir], k, fref[k], f[k]);
+      }
+    }
+  }
+
+  for (int q=0; q<num_pieces; ++q)
+    gkyl_fem_parproj_schur_release(pieces[q]);
+  gkyl_fem_parproj_release(parproj);
+  gkyl_array_release(schur);
+  gkyl_array_release(resid);
+  gkyl_array_release(rho);
+  gkyl_array_release(phi);
+  gkyl_array_release(phi_ref);
+  if (use_weights) {
+    gkyl_array_release(wl);
+    gkyl_array_release(wr);
+  }
+}
+
+void test_1x_single() { test_chain(1, 1, (int[]) { 12 }, false, true); }
+void test_1x_chain() { test_chain(1, 3, (int[]) { 3, 5, 4 }, false, true); }
+void test_1x_chain_periodic() { test_chain(1, 3, (int[]) { 3, 5, 4 }, true, false); }
+void test_2x_single_periodic() { test_chain(2, 1, (int[]) { 12 }, true, false); }
+void test_2x_chain() { test_chain(2, 4, (int[]) { 3, 3, 1, 5 }, false, false); }
+void test_2x_chain_periodic() { test_chain(2, 3, (int[]) { 4, 4, 4 }, true, true); }
+void test_3x_chain() { test_chain(3, 3, (int[]) { 2, 6, 4 }, false, true); }
+void test_3x_chain_periodic() { test_chain(3, 2, (int[]) { 5, 7 }, true, false); }
+
+TEST_LIST = {
+  { "test_1x_single", test_1x_single },
+  { "test_1x_chain", test_1x_chain },
+  { "test_1x_chain_periodic", test_1x_chain_periodic },
+  { "test_2x_single_periodic", test_2x_single_periodic },
+  { "test_2x_chain", test_2x_chain },
+  { "test_2x_chain_periodic", test_2x_chain_periodic },
+  { "test_3x_chain", test_3x_chain },
+  { "test_3x_chain_periodic", test_3x_chain_periodic },
+  { NULL, NULL },
+};
@@ -0,0 +1,196 @@
+#include <acutest.h>
+
+#include <gkyl_array_ops.h>
+#include <gkyl_gyrokinetic.h>
+#include <gkyl_gyrokinetic_priv.h>
+#include <gkyl_util.h>
+
+// 1x2v ion-sound problem with kinetic electrons, small enough to step
+// in a unit test. The strong density perturbation makes the field, and
+// with it the time-step, change within a step, so RK stages fail and
+// the step is retried with a smaller dt.
+struct ion_sound_ctx {
+  double n0, alpha, kz, Te, Ti, B0;
+};
+
+static void
+eval_density_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0;
+}
+
+static void
+eval_density_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0*(1.0 + app->alpha*cos(app->kz*xn[0]));
+}
+
+static void
+eval_temp_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Te;
+}
+
+static void
+eval_temp_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Ti;
+}
+
+static void
+eval_upar(double t, const double *xn, double *fout, void *ctx)
+{
+  fout[0] = 0.0;
+}
+
+static void
+mapc2p(double t, const double *zc, double *xp, void *ctx)
+{
+  xp[0] = zc[0]; xp[1] = zc[1]; xp[2] = zc[2];
+}
+
+static void
+bmag_func(double t, const double *zc, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->B0;
+}
+
+static gkyl_gyrokinetic_app*
+ion_sound_app_new(struct ion_sound_ctx *ctx, bool fuse_rk_stages)
+{
+  double mass_elc = 1.0/1836.16, mass_ion = 1.0;
+  double vte = sqrt(ctx->Te/mass_elc), vti = sqrt(ctx->Ti/mass_ion);
+  double Lz = 2.0*M_PI/ctx->kz;
+
+  struct gkyl_gyrokinetic_projection proj_elc = {
+    .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+    .density = eval_density_elc, .ctx_density = ctx,
+    .temp = eval_temp_elc, .ctx_temp = ctx,
+    .upar = eval_upar, .ctx_upar = ctx,
+  };
+  struct gkyl_gyrokinetic_projection proj_ion = proj_elc;
+  proj_ion.density = eval_density_ion;
+  proj_ion.temp = eval_temp_ion;
+
+  struct gkyl_gyrokinetic_species elc = {
+    .name = "elc",
+    .charge = -1.0, .mass = mass_elc,
+    .lower = { -6.0*vte, 0.0 },
+    .upper = { 6.0*vte, mass_elc*pow(6.0*vte, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_elc,
+  };
+  struct gkyl_gyrokinetic_species ion = {
+    .name = "ion",
+    .charge = 1.0, .mass = mass_ion,
+    .lower = { -6.0*vti, 0.0 },
+    .upper = { 6.0*vti, mass_ion*pow(6.0*vti, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_ion,
+  };
+
+  struct gkyl_gk app_inp = {
+    .name = "ctest_gk_fused_rk3",
+    .cdim = 1, .vdim = 2,
+    .lower = { -0.5*Lz },
+    .upper = { 0.5*Lz },
+    .cells = { 8 },
+    .poly_order = 1,
+    .basis_type = GKYL_BASIS_MODAL_SERENDIPITY,
+    .cfl_frac = 1.0,
+    .fuse_rk_stages = fuse_rk_stages,
+    .geometry = {
+      .geometry_id = GKYL_MAPC2P,
+      .world = { 0.0, 0.0 },
+      .mapc2p = mapc2p,
+      .bmag_func = bmag_func,
+      .bmag_ctx = ctx,
+    },
+    .num_periodic_dir = 1,
+    .periodic_dirs = { 0 },
+    .num_species = 2,
+    .species = { elc, ion },
+    .field = { .kperpSq = 0.01 },
+  };
+
+  return gkyl_gyrokinetic_app_new(&app_inp);
+}
+
+// Largest absolute difference between the distribution functions of the
+// two apps, relative to the largest value of f.
+static double
+max_rel_diff_f(const struct gk_species *s1, const struct gk_species *s2)
+{
+  double max_f = 0.0, max_df = 0.0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &s1->local);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&s1->local, iter.idx);
+    const double *f1 = gkyl_array_cfetch(s1->f, loc), *f2 = gkyl_array_cfetch(s2->f, loc);
+    for (int k=0; k<s1->f->ncomp; ++k) {
+      max_f = fmax(max_f, fabs(f1[k]));
+      max_df = fmax(max_df, fabs(f1[k]-f2[k]));
+    }
+  }
+  return max_df/max_f;
+}
+
+void
+test_fused_rk3()
+{
+  struct ion_sound_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.5, .kz = 0.5, .Te = 1.0, .Ti = 1.0, .B0 = 1.0,
+  };
+
+  gkyl_gyrokinetic_app *app_ref = ion_sound_app_new(&ctx, false);
+  gkyl_gyrokinetic_app *app_fused = ion_sound_app_new(&ctx, true);
+
+  gkyl_gyrokinetic_app_apply_ic(app_ref, 0.0);
+  gkyl_gyrokinetic_app_apply_ic(app_fused, 0.0);
+
+  // Ask for a dt far above the CFL limit: stage 1 takes the stable dt, and
+  // stages 2 and 3 fail whenever the field lowers it within the step.
+  int nsteps = 40;
+  for (int n=0; n<nsteps; ++n) {
+    struct gkyl_update_status st_ref = gkyl_gyrokinetic_update(app_ref, 1.0);
+    struct gkyl_update_status st_fused = gkyl_gyrokinetic_update(app_fused, 1.0);
+
+    TEST_CHECK( st_ref.success && st_fused.success );
+    TEST_CHECK( gkyl_compare_double(st_ref.dt_actual, st_fused.dt_actual, 1e-12) );
+    TEST_MSG( "step %d: dt %.15e (unfused) vs %.15e (fused)", n, st_ref.dt_actual, st_fused.dt_actual );
+  }
+
+  struct gkyl_gyrokinetic_stat stat_ref = gkyl_gyrokinetic_app_stat(app_ref);
+  struct gkyl_gyrokinetic_stat stat_fused = gkyl_gyrokinetic_app_stat(app_fused);
+
+  // The retry path was taken, and in the same steps.
+  TEST_CHECK( stat_ref.nstage_2_fail > 0 );
+  TEST_MSG( "no failed RK stage in %d steps", nsteps );
+  TEST_CHECK( stat_ref.nstage_2_fail == stat_fused.nstage_2_fail );
+  TEST_CHECK( stat_ref.nstage_3_fail == stat_fused.nstage_3_fail );
+  TEST_CHECK( stat_ref.nfeuler == stat_fused.nfeuler );
+
+  TEST_CHECK( gkyl_compare_double(app_ref->tcurr, app_fused->tcurr, 1e-12) );
+
+  // The fused stages round differently, so f agrees to round-off.
+  for (int s=0; s<app_ref->num_species; ++s) {
+    double rel_diff = max_rel_diff_f(&app_ref->species[s], &app_fused->species[s]);
+    TEST_CHECK( rel_diff < 1e-12 );
+    TEST_MSG( "species %s: relative difference %g", app_ref->species[s].info.name, rel_diff );
+  }
+
+  gkyl_gyrokinetic_app_release(app_ref);
+  gkyl_gyrokinetic_app_release(app_fused);
+}
+
+TEST_LIST = {
+  { "fused_rk3", test_fused_rk3 },
+  { NULL, NULL },
+};
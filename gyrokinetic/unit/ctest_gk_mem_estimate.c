@@ -0,0 +1,166 @@
+#include <acutest.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_gyrokinetic.h>
+#include <gkyl_util.h>
+
+// 1x2v ion-sound problem with kinetic electrons, with LBO electrons and
+// BGK ions.
+struct ion_sound_ctx {
+  double n0, alpha, kz, Te, Ti, B0;
+};
+
+static void
+eval_density_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0;
+}
+
+static void
+eval_density_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0*(1.0 + app->alpha*cos(app->kz*xn[0]));
+}
+
+static void
+eval_temp_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Te;
+}
+
+static void
+eval_temp_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Ti;
+}
+
+static void
+eval_upar(double t, const double *xn, double *fout, void *ctx)
+{
+  fout[0] = 0.0;
+}
+
+static void
+eval_nu(double t, const double *xn, double *fout, void *ctx)
+{
+  fout[0] = 0.1;
+}
+
+static void
+mapc2p(double t, const double *zc, double *xp, void *ctx)
+{
+  xp[0] = zc[0]; xp[1] = zc[1]; xp[2] = zc[2];
+}
+
+static void
+bmag_func(double t, const double *zc, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->B0;
+}
+
+static void
+ion_sound_inp(struct ion_sound_ctx *ctx, struct gkyl_gk *app_inp)
+{
+  double mass_elc = 1.0/1836.16, mass_ion = 1.0;
+  double vte = sqrt(ctx->Te/mass_elc), vti = sqrt(ctx->Ti/mass_ion);
+  double Lz = 2.0*M_PI/ctx->kz;
+
+  struct gkyl_gyrokinetic_projection proj_elc = {
+    .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+    .density = eval_density_elc, .ctx_density = ctx,
+    .temp = eval_temp_elc, .ctx_temp = ctx,
+    .upar = eval_upar, .ctx_upar = ctx,
+  };
+  struct gkyl_gyrokinetic_projection proj_ion = proj_elc;
+  proj_ion.density = eval_density_ion;
+  proj_ion.temp = eval_temp_ion;
+
+  struct gkyl_gyrokinetic_species elc = {
+    .name = "elc",
+    .charge = -1.0, .mass = mass_elc,
+    .lower = { -6.0*vte, 0.0 },
+    .upper = { 6.0*vte, mass_elc*pow(6.0*vte, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_elc,
+    .collisions = {
+      .collision_id = GKYL_LBO_COLLISIONS,
+      .self_nu = eval_nu, .ctx = ctx,
+    },
+  };
+  struct gkyl_gyrokinetic_species ion = {
+    .name = "ion",
+    .charge = 1.0, .mass = mass_ion,
+    .lower = { -6.0*vti, 0.0 },
+    .upper = { 6.0*vti, mass_ion*pow(6.0*vti, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_ion,
+    .collisions = {
+      .collision_id = GKYL_BGK_COLLISIONS,
+      .self_nu = eval_nu, .ctx = ctx,
+    },
+  };
+
+  *app_inp = (struct gkyl_gk) {
+    .name = "ctest_gk_mem_estimate",
+    .cdim = 1, .vdim = 2,
+    .lower = { -0.5*Lz },
+    .upper = { 0.5*Lz },
+    .cells = { 8 },
+    .poly_order = 1,
+    .basis_type = GKYL_BASIS_MODAL_SERENDIPITY,
+    .cfl_frac = 1.0,
+    .geometry = {
+      .geometry_id = GKYL_MAPC2P,
+      .world = { 0.0, 0.0 },
+      .mapc2p = mapc2p,
+      .bmag_func = bmag_func,
+      .bmag_ctx = ctx,
+    },
+    .num_periodic_dir = 1,
+    .periodic_dirs = { 0 },
+    .num_species = 2,
+    .species = { elc, ion },
+    .field = { .kperpSq = 0.01 },
+  };
+
+}
+
+static void
+test_mem_estimate(void)
+{
+  struct ion_sound_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.1, .kz = 0.5, .Te = 1.0, .Ti = 1.0, .B0 = 1.0,
+  };
+  struct gkyl_gk app_inp;
+  ion_sound_inp(&ctx, &app_inp);
+
+  // The estimate allocates nothing.
+  struct gkyl_mem_account_stat stat0 = gkyl_mem_account_stat();
+  double est = gkyl_gyrokinetic_app_mem_estimate(&app_inp, 0);
+  struct gkyl_mem_account_stat stat1 = gkyl_mem_account_stat();
+  TEST_CHECK( stat1.curr_bytes[0] == stat0.curr_bytes[0] );
+  TEST_CHECK( stat1.peak_bytes[0] == stat0.peak_bytes[0] );
+
+  gkyl_gyrokinetic_app *app = gkyl_gyrokinetic_app_new(&app_inp);
+  struct gkyl_mem_account_stat stat = gkyl_mem_account_stat();
+  double used = stat.curr_bytes[0] - stat0.curr_bytes[0];
+
+  // The estimate leaves out workspaces and optional operators, but
+  // accounts for the bulk of the arrays of the app.
+  TEST_CHECK( est > 0.75*used && est < 1.1*used );
+  TEST_MSG( "estimated %g bytes, app has %g bytes of arrays", est, used );
+
+  gkyl_gyrokinetic_app_release(app);
+}
+
+TEST_LIST = {
+  { "test_mem_estimate", test_mem_estimate },
+  { NULL, NULL },
+};
@@ -0,0 +1,241 @@
+#include <acutest.h>
+
+#include <gkyl_array_ops.h>
+#include <gkyl_gyrokinetic.h>
+#include <gkyl_gyrokinetic_priv.h>
+#include <gkyl_util.h>
+
+// 1x2v problem with LBO electrons and BGK ions. The LBO (M0M1M2) and
+// LTE (Maxwellian) moments of a species share one moment cache.
+struct coll_ctx {
+  double n0, alpha, kz, Te, Ti, B0, nu;
+};
+
+static void
+eval_density(double t, const double *xn, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = app->n0*(1.0 + app->alpha*cos(app->kz*xn[0]));
+}
+
+static void
+eval_upar(double t, const double *xn, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = 0.1*sin(app->kz*xn[0]);
+}
+
+static void
+eval_temp_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = app->Te;
+}
+
+static void
+eval_temp_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = app->Ti;
+}
+
+static void
+eval_nu(double t, const double *xn, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = app->nu;
+}
+
+static void
+mapc2p(double t, const double *zc, double *xp, void *ctx)
+{
+  xp[0] = zc[0]; xp[1] = zc[1]; xp[2] = zc[2];
+}
+
+static void
+bmag_func(double t, const double *zc, double *fout, void *ctx)
+{
+  struct coll_ctx *app = ctx;
+  fout[0] = app->B0;
+}
+
+static gkyl_gyrokinetic_app*
+coll_app_new(struct coll_ctx *ctx)
+{
+  double mass_elc = 1.0/1836.16, mass_ion = 1.0;
+  double vte = sqrt(ctx->Te/mass_elc), vti = sqrt(ctx->Ti/mass_ion);
+  double Lz = 2.0*M_PI/ctx->kz;
+
+  struct gkyl_gyrokinetic_projection proj_elc = {
+    .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+    .density = eval_density, .ctx_density = ctx,
+    .temp = eval_temp_elc, .ctx_temp = ctx,
+    .upar = eval_upar, .ctx_upar = ctx,
+  };
+  struct gkyl_gyrokinetic_projection proj_ion = proj_elc;
+  proj_ion.temp = eval_temp_ion;
+
+  struct gkyl_gyrokinetic_species elc = {
+    .name = "elc",
+    .charge = -1.0, .mass = mass_elc,
+    .lower = { -6.0*vte, 0.0 },
+    .upper = { 6.0*vte, mass_elc*pow(6.0*vte, 2)/(2.0*ctx->B0) },
+    .cells = { 12, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_elc,
+    .collisions = {
+      .collision_id = GKYL_LBO_COLLISIONS,
+      .self_nu = eval_nu, .ctx = ctx,
+    },
+  };
+  struct gkyl_gyrokinetic_species ion = {
+    .name = "ion",
+    .charge = 1.0, .mass = mass_ion,
+    .lower = { -6.0*vti, 0.0 },
+    .upper = { 6.0*vti, mass_ion*pow(6.0*vti, 2)/(2.0*ctx->B0) },
+    .cells = { 12, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_ion,
+    .collisions = {
+      .collision_id = GKYL_BGK_COLLISIONS,
+      .self_nu = eval_nu, .ctx = ctx,
+    },
+  };
+
+  struct gkyl_gk app_inp = {
+    .name = "ctest_gk_moment_cache",
+    .cdim = 1, .vdim = 2,
+    .lower = { -0.5*Lz },
+    .upper = { 0.5*Lz },
+    .cells = { 8 },
+    .poly_order = 1,
+    .basis_type = GKYL_BASIS_MODAL_SERENDIPITY,
+    .cfl_frac = 1.0,
+    .geometry = {
+      .geometry_id = GKYL_MAPC2P,
+      .world = { 0.0, 0.0 },
+      .mapc2p = mapc2p,
+      .bmag_func = bmag_func,
+      .bmag_ctx = ctx,
+    },
+    .num_periodic_dir = 1,
+    .periodic_dirs = { 0 },
+    .num_species = 2,
+    .species = { elc, ion },
+    .field = { .kperpSq = 0.01 },
+  };
+
+  return gkyl_gyrokinetic_app_new(&app_inp);
+}
+
+// Compute moment sm of fin, which may be served from the cache, and the
+// same moment from an uncached moment object, and compare them.
+static void
+check_moment(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
+  struct gk_species_moment *sm, struct gk_species_moment *sm_ref,
+  const struct gkyl_array *fin, const char *label)
+{
+  gk_species_moment_calc(sm, s->local, app->local, fin);
+  gk_species_moment_calc(sm_ref, s->local, app->local, fin);
+
+  double max_diff = 0.0, max_val = 0.0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &app->local);
+  while (gkyl_range_iter_next(&iter)) {
+    long linidx = gkyl_range_idx(&app->local, iter.idx);
+    const double *m = gkyl_array_cfetch(sm->marr, linidx);
+    const double *m_ref = gkyl_array_cfetch(sm_ref->marr, linidx);
+    for (int k=0; k<sm->marr->ncomp; ++k) {
+      max_diff = fmax(max_diff, fabs(m[k]-m_ref[k]));
+      max_val = fmax(max_val, fabs(m_ref[k]));
+    }
+  }
+  TEST_CHECK( max_val > 0.0 );
+  TEST_CHECK( max_diff <= 1e-12*max_val );
+  TEST_MSG( "species %s, %s: max difference %g (max value %g)",
+    s->info.name, label, max_diff, max_val );
+}
+
+// Moments of a species registered with its cache, and uncached references.
+struct cached_moms {
+  int num;
+  struct gk_species_moment *sm[2];
+  struct gk_species_moment sm_ref[2];
+  const char *label[2];
+};
+
+static void
+check_cached_moms(struct gkyl_gyrokinetic_app *app, struct gk_species *s,
+  struct cached_moms *cm, const struct gkyl_array *fin)
+{
+  for (int i=0; i<cm->num; ++i)
+    check_moment(app, s, cm->sm[i], &cm->sm_ref[i], fin, cm->label[i]);
+}
+
+static void
+test_moment_cache(void)
+{
+  struct coll_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.3, .kz = 0.5, .Te = 1.0, .Ti = 0.5, .B0 = 1.0, .nu = 0.1,
+  };
+  gkyl_gyrokinetic_app *app = coll_app_new(&ctx);
+  gkyl_gyrokinetic_app_apply_ic(app, 0.0);
+
+  for (int si=0; si<app->num_species; ++si) {
+    struct gk_species *s = &app->species[si];
+    TEST_CHECK( s->moms_cache != 0 );
+
+    struct cached_moms cm = { .num = 0 };
+    if (s->info.collisions.collision_id == GKYL_LBO_COLLISIONS) {
+      cm.sm[cm.num] = &s->lbo.moms;
+      gk_species_moment_init(app, s, &cm.sm_ref[cm.num], GKYL_F_MOMENT_M0M1M2, false);
+      cm.label[cm.num++] = "LBO M0M1M2";
+    }
+    cm.sm[cm.num] = &s->lte.moms;
+    gk_species_moment_init(app, s, &cm.sm_ref[cm.num], GKYL_F_MOMENT_MAXWELLIAN, false);
+    cm.label[cm.num++] = "LTE Maxwellian moments";
+    for (int i=0; i<cm.num; ++i) {
+      TEST_CHECK( cm.sm[i]->cache == s->moms_cache );
+      TEST_CHECK( cm.sm_ref[i].cache == 0 );
+    }
+    struct gk_species_moment_cache *cache = s->moms_cache;
+
+    // Outside an epoch the cache is bypassed.
+    check_cached_moms(app, s, &cm, s->f);
+    TEST_CHECK( cache->fin == 0 );
+
+    // First epoch: one sweep over f serves all registered moments.
+    gk_species_moment_cache_begin(app);
+    long epoch1 = app->moms_epoch;
+    check_cached_moms(app, s, &cm, s->f);
+    TEST_CHECK( cache->fin == s->f && cache->epoch == epoch1 );
+
+    // A different distribution in the same epoch invalidates the cache.
+    gkyl_array_set(s->f1, 2.0, s->f);
+    check_cached_moms(app, s, &cm, s->f1);
+    TEST_CHECK( cache->fin == s->f1 && cache->epoch == epoch1 );
+    check_cached_moms(app, s, &cm, s->f);
+    TEST_CHECK( cache->fin == s->f );
+    gk_species_moment_cache_end(app);
+
+    // Second epoch: f changed in place between epochs, so the moments
+    // of the same pointer are recomputed.
+    gkyl_array_scale(s->f, 0.5);
+    gk_species_moment_cache_begin(app);
+    long epoch2 = app->moms_epoch;
+    TEST_CHECK( epoch2 != epoch1 );
+    check_cached_moms(app, s, &cm, s->f);
+    TEST_CHECK( cache->fin == s->f && cache->epoch == epoch2 );
+    gk_species_moment_cache_end(app);
+
+    for (int i=0; i<cm.num; ++i)
+      gk_species_moment_release(app, &cm.sm_ref[i]);
+  }
+
+  gkyl_gyrokinetic_app_release(app);
+}
+
+TEST_LIST = {
+  { "test_moment_cache", test_moment_cache },
+  { NULL, NULL },
+};
@@ -0,0 +1,304 @@
+#include <acutest.h>
+
+#include <gkyl_array_ops.h>
+#include <gkyl_gyrokinetic.h>
+#include <gkyl_gyrokinetic_priv.h>
+#include <gkyl_util.h>
+
+// 1x2v ion-sound problem with kinetic electrons, small enough to step
+// in a unit test. The strong density perturbation makes the field, and
+// with it the time-step, change within a step, so RK stages fail and
+// the step is retried with a smaller dt.
+struct ion_sound_ctx {
+  double n0, alpha, kz, Te, Ti, B0;
+};
+
+static void
+eval_density_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0;
+}
+
+static void
+eval_density_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->n0*(1.0 + app->alpha*cos(app->kz*xn[0]));
+}
+
+static void
+eval_temp_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Te;
+}
+
+static void
+eval_temp_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->Ti;
+}
+
+static void
+eval_upar(double t, const double *xn, double *fout, void *ctx)
+{
+  fout[0] = 0.0;
+}
+
+static void
+mapc2p(double t, const double *zc, double *xp, void *ctx)
+{
+  xp[0] = zc[0]; xp[1] = zc[1]; xp[2] = zc[2];
+}
+
+static void
+bmag_func(double t, const double *zc, double *fout, void *ctx)
+{
+  struct ion_sound_ctx *app = ctx;
+  fout[0] = app->B0;
+}
+
+static gkyl_gyrokinetic_app*
+ion_sound_app_new(struct ion_sound_ctx *ctx, enum gkyl_time_stepper_type time_stepper,
+  bool fuse_rk_stages)
+{
+  double mass_elc = 1.0/1836.16, mass_ion = 1.0;
+  double vte = sqrt(ctx->Te/mass_elc), vti = sqrt(ctx->Ti/mass_ion);
+  double Lz = 2.0*M_PI/ctx->kz;
+
+  struct gkyl_gyrokinetic_projection proj_elc = {
+    .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+    .density = eval_density_elc, .ctx_density = ctx,
+    .temp = eval_temp_elc, .ctx_temp = ctx,
+    .upar = eval_upar, .ctx_upar = ctx,
+  };
+  struct gkyl_gyrokinetic_projection proj_ion = proj_elc;
+  proj_ion.density = eval_density_ion;
+  proj_ion.temp = eval_temp_ion;
+
+  struct gkyl_gyrokinetic_species elc = {
+    .name = "elc",
+    .charge = -1.0, .mass = mass_elc,
+    .lower = { -6.0*vte, 0.0 },
+    .upper = { 6.0*vte, mass_elc*pow(6.0*vte, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_elc,
+  };
+  struct gkyl_gyrokinetic_species ion = {
+    .name = "ion",
+    .charge = 1.0, .mass = mass_ion,
+    .lower = { -6.0*vti, 0.0 },
+    .upper = { 6.0*vti, mass_ion*pow(6.0*vti, 2)/(2.0*ctx->B0) },
+    .cells = { 16, 4 },
+    .polarization_density = ctx->n0,
+    .projection = proj_ion,
+  };
+
+  struct gkyl_gk app_inp = {
+    .name = "ctest_gk_ssp_rk43",
+    .cdim = 1, .vdim = 2,
+    .lower = { -0.5*Lz },
+    .upper = { 0.5*Lz },
+    .cells = { 8 },
+    .poly_order = 1,
+    .basis_type = GKYL_BASIS_MODAL_SERENDIPITY,
+    .cfl_frac = 1.0,
+    .time_stepper = time_stepper,
+    .fuse_rk_stages = fuse_rk_stages,
+    .geometry = {
+      .geometry_id = GKYL_MAPC2P,
+      .world = { 0.0, 0.0 },
+      .mapc2p = mapc2p,
+      .bmag_func = bmag_func,
+      .bmag_ctx = ctx,
+    },
+    .num_periodic_dir = 1,
+    .periodic_dirs = { 0 },
+    .num_species = 2,
+    .species = { elc, ion },
+    .field = { .kperpSq = 0.01 },
+  };
+
+  return gkyl_gyrokinetic_app_new(&app_inp);
+}
+
+// Largest absolute difference between the distribution functions of the
+// two apps, relative to the largest value of f.
+static double
+max_rel_diff_f(const struct gk_species *s1, const struct gk_species *s2)
+{
+  double max_f = 0.0, max_df = 0.0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &s1->local);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&s1->local, iter.idx);
+    const double *f1 = gkyl_array_cfetch(s1->f, loc), *f2 = gkyl_array_cfetch(s2->f, loc);
+    for (int k=0; k<s1->f->ncomp; ++k) {
+      max_f = fmax(max_f, fabs(f1[k]));
+      max_df = fmax(max_df, fabs(f1[k]-f2[k]));
+    }
+  }
+  return max_df/max_f;
+}
+
+// Step app to time tend with steps of at most dt, or of the suggested dt
+// if dt is not positive. Returns the number of steps taken.
+static int
+run_to(gkyl_gyrokinetic_app *app, double tend, double dt)
+{
+  int nsteps = 0;
+  double dt_next = dt > 0.0 ? dt : 1.0;
+  while (app->tcurr < tend*(1.0-1e-12)) {
+    double dt_try = fmin(dt_next, tend-app->tcurr);
+    struct gkyl_update_status st = gkyl_gyrokinetic_update(app, dt_try);
+    TEST_CHECK( st.success );
+    if (dt > 0.0)
+      TEST_CHECK( gkyl_compare_double(st.dt_actual, dt_try, 1e-12) );
+    else
+      dt_next = st.dt_suggested;
+    nsteps += 1;
+  }
+  return nsteps;
+}
+
+void
+test_ssp_rk43_order()
+{
+  struct ion_sound_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.5, .kz = 0.5, .Te = 1.0, .Ti = 1.0, .B0 = 1.0,
+  };
+
+  // Forward Euler time-step of the initial condition.
+  gkyl_gyrokinetic_app *app_probe = ion_sound_app_new(&ctx, GKYL_SSP_RK3, false);
+  gkyl_gyrokinetic_app_apply_ic(app_probe, 0.0);
+  double dt_fe = gkyl_gyrokinetic_update(app_probe, 1.0).dt_suggested;
+  gkyl_gyrokinetic_app_release(app_probe);
+
+  // Fixed steps well within the stability limit of both methods. The RK3
+  // solution with dt/16 is the reference for the time discretization error.
+  double dt = 0.25*dt_fe, tend = 8*dt;
+  gkyl_gyrokinetic_app *app_ref = ion_sound_app_new(&ctx, GKYL_SSP_RK3, false);
+  gkyl_gyrokinetic_app_apply_ic(app_ref, 0.0);
+  run_to(app_ref, tend, dt/16.0);
+
+  double err[2];
+  for (int r=0; r<2; ++r) {
+    gkyl_gyrokinetic_app *app = ion_sound_app_new(&ctx, GKYL_SSP_RK43, false);
+    gkyl_gyrokinetic_app_apply_ic(app, 0.0);
+    int nsteps = run_to(app, tend, dt/(1 << r));
+    TEST_CHECK( nsteps == 8*(1 << r) );
+
+    struct gkyl_gyrokinetic_stat stat = gkyl_gyrokinetic_app_stat(app);
+    TEST_CHECK( stat.nfeuler == 4*nsteps );
+
+    err[r] = 0.0;
+    for (int s=0; s<app->num_species; ++s)
+      err[r] = fmax(err[r], max_rel_diff_f(&app->species[s], &app_ref->species[s]));
+    gkyl_gyrokinetic_app_release(app);
+  }
+
+  // Third order: halving dt divides the error by 8.
+  double ratio = err[0]/err[1];
+  TEST_CHECK( err[1] > 0.0 && ratio > 6.0 && ratio < 10.0 );
+  TEST_MSG( "errors %g (dt) and %g (dt/2), ratio %g", err[0], err[1], ratio );
+
+  gkyl_gyrokinetic_app_release(app_ref);
+}
+
+void
+test_ssp_rk43_fused()
+{
+  struct ion_sound_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.5, .kz = 0.5, .Te = 1.0, .Ti = 1.0, .B0 = 1.0,
+  };
+
+  gkyl_gyrokinetic_app *app_ref = ion_sound_app_new(&ctx, GKYL_SSP_RK43, false);
+  gkyl_gyrokinetic_app *app_fused = ion_sound_app_new(&ctx, GKYL_SSP_RK43, true);
+
+  gkyl_gyrokinetic_app_apply_ic(app_ref, 0.0);
+  gkyl_gyrokinetic_app_apply_ic(app_fused, 0.0);
+
+  // Ask for a dt far above the CFL limit, so stages fail and are retried.
+  int nsteps = 40;
+  for (int n=0; n<nsteps; ++n) {
+    struct gkyl_update_status st_ref = gkyl_gyrokinetic_update(app_ref, 1.0);
+    struct gkyl_update_status st_fused = gkyl_gyrokinetic_update(app_fused, 1.0);
+
+    TEST_CHECK( st_ref.success && st_fused.success );
+    TEST_CHECK( gkyl_compare_double(st_ref.dt_actual, st_fused.dt_actual, 1e-12) );
+    TEST_MSG( "step %d: dt %.15e (unfused) vs %.15e (fused)", n, st_ref.dt_actual, st_fused.dt_actual );
+  }
+
+  struct gkyl_gyrokinetic_stat stat_ref = gkyl_gyrokinetic_app_stat(app_ref);
+  struct gkyl_gyrokinetic_stat stat_fused = gkyl_gyrokinetic_app_stat(app_fused);
+
+  TEST_CHECK( stat_ref.nstage_2_fail + stat_ref.nstage_3_fail > 0 );
+  TEST_MSG( "no failed RK stage in %d steps", nsteps );
+  TEST_CHECK( stat_ref.nstage_2_fail == stat_fused.nstage_2_fail );
+  TEST_CHECK( stat_ref.nstage_3_fail == stat_fused.nstage_3_fail );
+  TEST_CHECK( stat_ref.nfeuler == stat_fused.nfeuler );
+
+  TEST_CHECK( gkyl_compare_double(app_ref->tcurr, app_fused->tcurr, 1e-12) );
+
+  for (int s=0; s<app_ref->num_species; ++s) {
+    double rel_diff = max_rel_diff_f(&app_ref->species[s], &app_fused->species[s]);
+    TEST_CHECK( rel_diff < 1e-12 );
+    TEST_MSG( "species %s: relative difference %g", app_ref->species[s].info.name, rel_diff );
+  }
+
+  gkyl_gyrokinetic_app_release(app_ref);
+  gkyl_gyrokinetic_app_release(app_fused);
+}
+
+void
+test_ssp_rk43_vs_rk3()
+{
+  struct ion_sound_ctx ctx = {
+    .n0 = 1.0, .alpha = 0.5, .kz = 0.5, .Te = 1.0, .Ti = 1.0, .B0 = 1.0,
+  };
+
+  gkyl_gyrokinetic_app *app_rk3 = ion_sound_app_new(&ctx, GKYL_SSP_RK3, false);
+  gkyl_gyrokinetic_app *app_rk43 = ion_sound_app_new(&ctx, GKYL_SSP_RK43, false);
+
+  gkyl_gyrokinetic_app_apply_ic(app_rk3, 0.0);
+  gkyl_gyrokinetic_app_apply_ic(app_rk43, 0.0);
+
+  // Step both with the suggested dt to the same time.
+  int nsteps_rk3 = 60;
+  double dt = 1.0;
+  for (int n=0; n<nsteps_rk3; ++n)
+    dt = gkyl_gyrokinetic_update(app_rk3, dt).dt_suggested;
+  int nsteps_rk43 = run_to(app_rk43, app_rk3->tcurr, 0.0);
+
+  struct gkyl_gyrokinetic_stat stat_rk3 = gkyl_gyrokinetic_app_stat(app_rk3);
+  struct gkyl_gyrokinetic_stat stat_rk43 = gkyl_gyrokinetic_app_stat(app_rk43);
+
+  // RK43 takes steps of twice the forward Euler dt, RK3 steps of one, so
+  // RK43 needs 4 RHS evaluations where RK3 needs 6. The electron dt varies
+  // strongly within a step here, so both retry stages, RK43 more often.
+  TEST_CHECK( 4*nsteps_rk43 < 0.8*3*nsteps_rk3 );
+  TEST_CHECK( stat_rk43.nfeuler < stat_rk3.nfeuler );
+  TEST_MSG( "RK3: %d steps, %ld RHS evaluations; RK43: %d steps, %ld RHS evaluations",
+    nsteps_rk3, stat_rk3.nfeuler, nsteps_rk43, stat_rk43.nfeuler );
+
+  // Both are third order, so they agree to the time discretization error of
+  // steps at the stability limit.
+  for (int s=0; s<app_rk3->num_species; ++s) {
+    double rel_diff = max_rel_diff_f(&app_rk3->species[s], &app_rk43->species[s]);
+    TEST_CHECK( rel_diff < 1e-2 );
+    TEST_MSG( "species %s: relative difference %g", app_rk3->species[s].info.name, rel_diff );
+  }
+
+  gkyl_gyrokinetic_app_release(app_rk3);
+  gkyl_gyrokinetic_app_release(app_rk43);
+}
+
+TEST_LIST = {
+  { "ssp_rk43_order", test_ssp_rk43_order },
+  { "ssp_rk43_fused", test_ssp_rk43_fused },
+  { "ssp_rk43_vs_rk3", test_ssp_rk43_vs_rk3 },
+  { NULL, NULL },
+};
@@ -0,0 +1,196 @@
+// Test the twist-shift BC on a field decomposed along the shift direction,
+// comparing against the same BC applied on a single rank.
+//
+#include <acutest.h>
+
+#ifdef GKYL_HAVE_MPI
+
+#include <math.h>
+#include <mpi.h>
+
+#include <gkyl_array_ops.h>
+#include <gkyl_basis.h>
+#include <gkyl_bc_twistshift.h>
+#include <gkyl_mpi_comm.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_decomp.h>
+#include <gkyl_rect_grid.h>
+
+static void
+shift_func(double t, const double *xn, double* GKYL_RESTRICT fout, void *ctx)
+{
+  double x = xn[0];
+  fout[0] = 0.3 + 0.8*x + 0.2*sin(3.0*x);
+}
+
+static void
+fill_field(struct gkyl_array *f, const struct gkyl_range *range)
+{
+  // Fill a field with values that only depend on the global cell index.
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, range);
+  while (gkyl_range_iter_next(&iter)) {
+    long linidx = gkyl_range_idx(range, iter.idx);
+    double *f_c = gkyl_array_fetch(f, linidx);
+    double arg = 0.0;
+    for (int d=0; d<range->ndim; d++)
+      arg += (0.3+0.4*d)*iter.idx[d];
+    for (int k=0; k<f->ncomp; k++)
+      f_c[k] = cos(arg+0.5*k);
+  }
+}
+
+static void
+bcdir_ext_range(struct gkyl_range *bcdir_ext_r, const struct gkyl_range *local,
+  const struct gkyl_range *local_ext, int bc_dir)
+{
+  // Local range extended in bc_dir.
+  int lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM];
+  for (int d=0; d<local->ndim; d++) {
+    lower[d] = local->lower[d];
+    upper[d] = local->upper[d];
+  }
+  lower[bc_dir] = local_ext->lower[bc_dir];
+  upper[bc_dir] = local_ext->upper[bc_dir];
+  gkyl_sub_range_init(bcdir_ext_r, local_ext, lower, upper);
+}
+
+static void
+test_ts_ydecomp(int vdim, enum gkyl_edge_loc edge)
+{
+  int m_sz, rank;
+  MPI_Comm_size(MPI_COMM_WORLD, &m_sz);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  const int cdim = 3, pdim = cdim+vdim;
+  int cells[] = {6, 8, 4, 4, 3};
+  if (cells[1] % m_sz != 0) return;
+
+  double lower[] = {0.0, -1.0, -M_PI, -2.0, 0.0}, upper[] = {1.5, 1.0, M_PI, 2.0, 1.0};
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, pdim, lower, upper, cells);
+
+  struct gkyl_basis basis;
+  if (vdim == 0)
+    gkyl_cart_modal_serendip(&basis, pdim, 1);
+  else
+    gkyl_cart_modal_gkhybrid(&basis, cdim, vdim);
+
+  int ghost[] = {1, 1, 1, 0, 0};
+  struct gkyl_range global, global_ext;
+  gkyl_create_grid_ranges(&grid, ghost, &global_ext, &global);
+
+  // Decompose configuration space along y, and extend it to phase space.
+  struct gkyl_range conf_global;
+  gkyl_range_init(&conf_global, cdim, global.lower, global.upper);
+  int cuts[] = {1, m_sz, 1};
+  struct gkyl_rect_decomp *decomp = gkyl_rect_decomp_new_from_cuts(cdim, cuts, &conf_global);
+
+  struct gkyl_comm *comm = gkyl_mpi_comm_new( &(struct gkyl_mpi_comm_inp) {
+      .mpi_comm = MPI_COMM_WORLD,
+      .decomp = decomp
+    }
+  );
+
+  int lower_loc[GKYL_MAX_DIM], upper_loc[GKYL_MAX_DIM];
+  for (int d=0; d<pdim; d++) {
+    lower_loc[d] = d < cdim? decomp->ranges[rank].lower[d] : global.lower[d];
+    upper_loc[d] = d < cdim? decomp->ranges[rank].upper[d] : global.upper[d];
+  }
+  struct gkyl_range local_phase, local, local_ext;
+  gkyl_range_init(&local_phase, pdim, lower_loc, upper_loc);
+  gkyl_create_ranges(&local_phase, ghost, &local_ext, &local);
+
+  int bc_dir = 2;
+  struct gkyl_range bcdir_ext_r, global_bcdir_ext_r;
+  bcdir_ext_range(&bcdir_ext_r, &local, &local_ext, bc_dir);
+  bcdir_ext_range(&global_bcdir_ext_r, &global, &global_ext, bc_dir);
+
+  // Reference: the whole domain on a single rank.
+  struct gkyl_array *fref = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, global_ext.volume);
+  fill_field(fref, &global_ext);
+  struct gkyl_bc_twistshift *ts_ref = gkyl_bc_twistshift_new( &(struct gkyl_bc_twistshift_inp) {
+      .bc_dir = bc_dir,
+      .shift_dir = 1,
+      .shear_dir = 0,
+      .edge = edge,
+      .cdim = cdim,
+      .bcdir_ext_update_r = global_bcdir_ext_r,
+      .num_ghost = ghost,
+      .basis = basis,
+      .grid = grid,
+      .shift_func = shift_func,
+      .shift_func_ctx = 0,
+      .use_gpu = false,
+    }
+  );
+  gkyl_bc_twistshift_advance(ts_ref, fref, fref);
+
+  // Decomposed along y.
+  struct gkyl_array *f = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, local_ext.volume);
+  fill_field(f, &local_ext);
+  struct gkyl_bc_twistshift *ts = gkyl_bc_twistshift_new( &(struct gkyl_bc_twistshift_inp) {
+      .bc_dir = bc_dir,
+      .shift_dir = 1,
+      .shear_dir = 0,
+      .edge = edge,
+      .cdim = cdim,
+      .bcdir_ext_update_r = bcdir_ext_r,
+      .num_ghost = ghost,
+      .basis = basis,
+      .grid = grid,
+      .shift_func = shift_func,
+      .shift_func_ctx = 0,
+      .use_gpu = false,
+      .comm = comm,
+      .decomp = decomp,
+    }
+  );
+  gkyl_bc_twistshift_advance(ts, f, f);
+
+  struct gkyl_range ghost_r;
+  if (edge == GKYL_LOWER_EDGE)
+    gkyl_range_shorten_from_above(&ghost_r, &bcdir_ext_r, bc_dir, ghost[bc_dir]);
+  else
+    gkyl_range_shorten_from_below(&ghost_r, &bcdir_ext_r, bc_dir, ghost[bc_dir]);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &ghost_r);
+  while (gkyl_range_iter_next(&iter)) {
+    const double *f_c = gkyl_array_cfetch(f, gkyl_range_idx(&local_ext, iter.idx));
+    const double *fref_c = gkyl_array_cfetch(fref, gkyl_range_idx(&global_ext, iter.idx));
+    for (int k=0; k<basis.num_basis; k++) {
+      TEST_CHECK( gkyl_compare(fref_c[k], f_c[k], 1e-12) );
+      TEST_MSG( "rank %d, k=%d: expected %.13e | got %.13e", rank, k, fref_c[k], f_c[k]);
+    }
+  }
+
+  gkyl_bc_twistshift_release(ts);
+  gkyl_bc_twistshift_release(ts_ref);
+  gkyl_array_release(f);
+  gkyl_array_release(fref);
+  gkyl_comm_release(comm);
+  gkyl_rect_decomp_release(decomp);
+}
+
+void test_ts_ydecomp_3x_lo() { test_ts_ydecomp(0, GKYL_LOWER_EDGE); }
+void test_ts_ydecomp_3x_up() { test_ts_ydecomp(0, GKYL_UPPER_EDGE); }
+void test_ts_ydecomp_3x2v_lo() { test_ts_ydecomp(2, GKYL_LOWER_EDGE); }
+void test_ts_ydecomp_3x2v_up() { test_ts_ydecomp(2, GKYL_UPPER_EDGE); }
+
+TEST_LIST = {
+  { "test_ts_ydecomp_3x_lo", test_ts_ydecomp_3x_lo },
+  { "test_ts_ydecomp_3x_up", test_ts_ydecomp_3x_up },
+  { "test_ts_ydecomp_3x2v_lo", test_ts_ydecomp_3x2v_lo },
+  { "test_ts_ydecomp_3x2v_up", test_ts_ydecomp_3x2v_up },
+  { NULL, NULL },
+};
+
+#else
+
+// nothing to test if not building with MPI
+TEST_LIST = {
+  {NULL, NULL},
+};
+
+#endif
@@ -0,0 +1,372 @@
+#include <acutest.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_block_rank_map.h>
+#include <gkyl_const.h>
+#include <gkyl_gyrokinetic_comms.h>
+#include <gkyl_gyrokinetic_multib.h>
+#include <gkyl_gyrokinetic_multib_priv.h>
+#include <gkyl_gyrokinetic_priv.h>
+
+// Three-block 1x2v sheath problem (lower, middle and upper SOL along z),
+// small enough to step in a unit test. The middle block has twice the
+// cells of the others, so a balanced map does not give each block the
+// same number of ranks.
+struct sheath_ctx {
+  double mass_elc, charge_elc, mass_ion, charge_ion;
+  double Te, Ti, n0, B0, k_perp;
+  double Lz;
+};
+
+static struct sheath_ctx
+create_ctx(void)
+{
+  double mass_ion = 2.014*GKYL_PROTON_MASS;
+  double Te = 40.0*GKYL_ELEMENTARY_CHARGE;
+  double B0 = 0.5*0.85/(0.85+0.15);
+  double rho_s = sqrt(Te/mass_ion)/(GKYL_ELEMENTARY_CHARGE*B0/mass_ion);
+  return (struct sheath_ctx) {
+    .mass_elc = GKYL_ELECTRON_MASS,
+    .charge_elc = -GKYL_ELEMENTARY_CHARGE,
+    .mass_ion = mass_ion,
+    .charge_ion = GKYL_ELEMENTARY_CHARGE,
+    .Te = Te,
+    .Ti = Te,
+    .n0 = 7.0e18,
+    .B0 = B0,
+    .k_perp = 0.3/rho_s,
+    .Lz = 4.0,
+  };
+}
+
+static void
+mapc2p(double t, const double *zc, double *xp, void *ctx)
+{
+  xp[0] = zc[0]; xp[1] = zc[1]; xp[2] = zc[2];
+}
+
+static void
+bmag_func(double t, const double *zc, double *fout, void *ctx)
+{
+  struct sheath_ctx *app = ctx;
+  fout[0] = app->B0;
+}
+
+static void
+eval_density(double t, const double *xn, double *fout, void *ctx)
+{
+  struct sheath_ctx *app = ctx;
+  double z = xn[0];
+  fout[0] = app->n0*(1.0 + 0.5*cos(M_PI*z/app->Lz));
+}
+
+static void
+eval_upar_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct sheath_ctx *app = ctx;
+  // Offset so that the momentum of the middle block does not vanish.
+  fout[0] = (0.25 + 2.0*xn[0]/app->Lz)*sqrt(app->Te/app->mass_ion);
+}
+
+static void
+eval_upar_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  eval_upar_elc(t, xn, fout, ctx);
+}
+
+static void
+eval_temp_elc(double t, const double *xn, double *fout, void *ctx)
+{
+  struct sheath_ctx *app = ctx;
+  fout[0] = app->Te;
+}
+
+static void
+eval_temp_ion(double t, const double *xn, double *fout, void *ctx)
+{
+  struct sheath_ctx *app = ctx;
+  fout[0] = app->Ti;
+}
+
+static struct gkyl_gk_block_geom*
+create_gk_block_geom(struct sheath_ctx *ctx)
+{
+  struct gkyl_gk_block_geom *bgeom = gkyl_gk_block_geom_new(1, 3);
+
+  double Lz = ctx->Lz;
+  double zlo[] = { -Lz/2.0, -Lz/4.0, Lz/4.0 };
+  double zup[] = { -Lz/4.0, Lz/4.0, Lz/2.0 };
+  int nz[] = { 4, 8, 4 };
+  for (int b=0; b<3; ++b) {
+    struct gkyl_gk_block_geom_info info = {
+      .lower = { zlo[b] },
+      .upper = { zup[b] },
+      .cells = { nz[b] },
+      .cuts = { 1 },
+      .geometry = {
+        .geometry_id = GKYL_MAPC2P,
+        .world = { 0.0, 0.0 },
+        .mapc2p = mapc2p,
+        .c2p_ctx = ctx,
+        .bmag_func = bmag_func,
+        .bmag_ctx = ctx,
+      },
+      .connections[0] = { // z-direction connections
+        b == 0 ? (struct gkyl_target_edge) { .bid = 0, .dir = 0, .edge = GKYL_PHYSICAL }
+               : (struct gkyl_target_edge) { .bid = b-1, .dir = 0, .edge = GKYL_UPPER_POSITIVE },
+        b == 2 ? (struct gkyl_target_edge) { .bid = 0, .dir = 0, .edge = GKYL_PHYSICAL }
+               : (struct gkyl_target_edge) { .bid = b+1, .dir = 0, .edge = GKYL_LOWER_POSITIVE },
+      },
+    };
+    gkyl_gk_block_geom_set_block(bgeom, b, &info);
+  }
+  return bgeom;
+}
+
+static gkyl_gyrokinetic_multib_app*
+sheath_app_new(struct sheath_ctx *ctx, struct gkyl_gk_block_geom *bgeom,
+  struct gkyl_comm *comm, bool auto_decomp, bool fuse_rk_stages)
+{
+  double vte = sqrt(ctx->Te/ctx->mass_elc), vti = sqrt(ctx->Ti/ctx->mass_ion);
+
+  struct gkyl_gyrokinetic_multib_species_pb elc_blocks[] = {
+    {
+      .polarization_density = ctx->n0,
+      .projection = {
+        .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+        .density = eval_density, .ctx_density = ctx,
+        .upar = eval_upar_elc, .ctx_upar = ctx,
+        .temp = eval_temp_elc, .ctx_temp = ctx,
+      },
+    },
+  };
+  struct gkyl_gyrokinetic_multib_species_pb ion_blocks[] = {
+    {
+      .polarization_density = ctx->n0,
+      .projection = {
+        .proj_id = GKYL_PROJ_MAXWELLIAN_PRIM,
+        .density = eval_density, .ctx_density = ctx,
+        .upar = eval_upar_ion, .ctx_upar = ctx,
+        .temp = eval_temp_ion, .ctx_temp = ctx,
+      },
+    },
+  };
+
+  struct gkyl_gyrokinetic_block_physical_bcs species_bcs[] = {
+    { .bidx = 0, .dir = 0, .edge = GKYL_LOWER_EDGE, .bc_type = GKYL_BC_GK_SPECIES_GK_SHEATH },
+    { .bidx = 2, .dir = 0, .edge = GKYL_UPPER_EDGE, .bc_type = GKYL_BC_GK_SPECIES_GK_SHEATH },
+  };
+
+  struct gkyl_gyrokinetic_multib_species elc = {
+    .name = "elc",
+    .charge = ctx->charge_elc, .mass = ctx->mass_elc,
+    .lower = { -4.0*vte, 0.0 },
+    .upper = { 4.0*vte, 0.75*ctx->mass_elc*pow(4.0*vte, 2)/(2.0*ctx->B0) },
+    .cells = { 6, 4 },
+    .duplicate_across_blocks = true,
+    .blocks = elc_blocks,
+    .num_physical_bcs = 2,
+    .bcs = species_bcs,
+  };
+  struct gkyl_gyrokinetic_multib_species ion = {
+    .name = "ion",
+    .charge = ctx->charge_ion, .mass = ctx->mass_ion,
+    .lower = { -4.0*vti, 0.0 },
+    .upper = { 4.0*vti, 0.75*ctx->mass_ion*pow(4.0*vti, 2)/(2.0*ctx->B0) },
+    .cells = { 6, 4 },
+    .duplicate_across_blocks = true,
+    .blocks = ion_blocks,
+    .num_physical_bcs = 2,
+    .bcs = species_bcs,
+  };
+
+  struct gkyl_gyrokinetic_multib_field_pb field_blocks[] = {
+    {
+      .polarization_bmag = ctx->B0,
+      .kperpSq = ctx->k_perp*ctx->k_perp,
+    },
+  };
+
+  struct gkyl_gyrokinetic_multib app_inp = {
+    .name = "mctest_gk_multib_auto_decomp",
+    .cdim = 1, .vdim = 2,
+    .poly_order = 1,
+    .basis_type = GKYL_BASIS_MODAL_SERENDIPITY,
+    .cfl_frac = 1.0,
+    .gk_block_geom = bgeom,
+    .auto_decomp = auto_decomp,
+    .fuse_rk_stages = fuse_rk_stages,
+    .num_species = 2,
+    .species = { elc, ion },
+    .field = {
+      .duplicate_across_blocks = true,
+      .blocks = field_blocks,
+    },
+    .comm = comm,
+  };
+
+  return gkyl_gyrokinetic_multib_app_new(&app_inp);
+}
+
+// Find the single-block app of block bid on this rank (NULL if the
+// block is not handled here).
+static struct gkyl_gyrokinetic_app*
+block_app(const gkyl_gyrokinetic_multib_app *mbapp, int bid)
+{
+  for (int i=0; i<mbapp->num_local_blocks; ++i)
+    if (mbapp->local_blocks[i] == bid)
+      return mbapp->singleb_apps[i];
+  return 0;
+}
+
+static void
+test_auto_decomp(bool use_mpi)
+{
+  struct sheath_ctx ctx = create_ctx();
+  struct gkyl_gk_block_geom *bgeom = create_gk_block_geom(&ctx);
+  int num_blocks = gkyl_gk_block_geom_num_blocks(bgeom);
+
+  struct gkyl_comm *comm = gkyl_gyrokinetic_comms_new(use_mpi, false, stderr);
+  int my_rank, num_ranks;
+  gkyl_comm_get_rank(comm, &my_rank);
+  gkyl_comm_get_size(comm, &num_ranks);
+  if (num_ranks > 8) {
+    // Blocks are only cut along z, which has few cells to spread.
+    gkyl_gyrokinetic_comms_release(comm);
+    gkyl_gk_block_geom_release(bgeom);
+    return;
+  }
+
+  gkyl_gyrokinetic_multib_app *app = sheath_app_new(&ctx, bgeom, comm, true, false);
+
+  // Every rank handles a piece of some block, and the middle block,
+  // which costs twice as much as the others, gets at least as many ranks.
+  const struct gkyl_block_rank_map *rank_map = app->rank_map;
+  TEST_CHECK( rank_map != 0 );
+  TEST_CHECK( app->num_local_blocks > 0 );
+  TEST_CHECK( rank_map->total_ranks == num_ranks );
+  int num_pieces = 0, nranks[3];
+  for (int b=0; b<num_blocks; ++b) {
+    int cuts[1];
+    gkyl_block_rank_map_getcuts(rank_map, b, cuts);
+    nranks[b] = gkyl_block_rank_map_nranks(rank_map, b);
+    TEST_CHECK( cuts[0] == nranks[b] );
+    TEST_MSG( "block %d: %d cuts, %d ranks", b, cuts[0], nranks[b] );
+    num_pieces += nranks[b];
+  }
+  TEST_CHECK( num_pieces >= num_ranks );
+  TEST_CHECK( nranks[1] >= nranks[0] && nranks[1] >= nranks[2] );
+
+  // Reference: the same problem on this rank alone.
+  struct gkyl_comm *comm_serial = gkyl_gyrokinetic_comms_new(false, false, stderr);
+  gkyl_gyrokinetic_multib_app *app_serial = sheath_app_new(&ctx, bgeom, comm_serial, false, false);
+
+  gkyl_gyrokinetic_multib_app_apply_ic(app, 0.0);
+  gkyl_gyrokinetic_multib_app_apply_ic(app_serial, 0.0);
+
+  double dt = 1.0e-6;
+  for (int n=0; n<3; ++n) {
+    struct gkyl_update_status st = gkyl_gyrokinetic_multib_update(app, dt);
+    struct gkyl_update_status st_serial = gkyl_gyrokinetic_multib_update(app_serial, dt);
+    TEST_CHECK( st.success && st_serial.success );
+    TEST_CHECK( gkyl_compare_double(st.dt_actual, st_serial.dt_actual, 1e-12) );
+    TEST_MSG( "step %d: dt %.15e (auto decomp) vs %.15e (serial)", n, st.dt_actual, st_serial.dt_actual );
+    dt = st.dt_suggested;
+  }
+
+  // Integrated moments of each block agree with the serial run up to
+  // the order of the reductions.
+  double tm = app->tcurr;
+  gkyl_gyrokinetic_multib_app_calc_integrated_mom(app, tm);
+  gkyl_gyrokinetic_multib_app_calc_integrated_mom(app_serial, tm);
+  for (int i=0; i<app->num_local_blocks; ++i) {
+    int bid = app->local_blocks[i];
+    struct gkyl_gyrokinetic_app *sb = app->singleb_apps[i];
+    struct gkyl_gyrokinetic_app *sb_serial = block_app(app_serial, bid);
+    for (int s=0; s<sb->num_species; ++s) {
+      int num_mom = sb->species[s].integ_moms.num_mom;
+      double mom[num_mom], mom_serial[num_mom];
+      gkyl_dynvec_getlast(sb->species[s].integ_diag, mom);
+      gkyl_dynvec_getlast(sb_serial->species[s].integ_diag, mom_serial);
+      for (int k=0; k<num_mom; ++k) {
+        TEST_CHECK( gkyl_compare_double(mom[k], mom_serial[k], 1e-10) );
+        TEST_MSG( "block %d, species %s, moment %d: %.15e vs %.15e",
+          bid, sb->species[s].info.name, k, mom[k], mom_serial[k] );
+      }
+    }
+  }
+
+  // Stats and timers are gathered across ranks.
+  struct gkyl_gyrokinetic_stat stat = gkyl_gyrokinetic_multib_app_stat(app);
+  TEST_CHECK( stat.nup == 3 );
+
+  gkyl_gyrokinetic_multib_app_release(app_serial);
+  gkyl_gyrokinetic_comms_release(comm_serial);
+  gkyl_gyrokinetic_multib_app_release(app);
+  gkyl_gyrokinetic_comms_release(comm);
+  gkyl_gk_block_geom_release(bgeom);
+}
+
+static void
+test_auto_decomp_ho(void)
+{
+#ifdef GKYL_HAVE_MPI
+  test_auto_decomp(true);
+#else
+  test_auto_decomp(false);
+#endif
+}
+
+// Fusing the forward Euler step into the RK stage combination changes
+// only the order of floating point operations.
+static void
+test_fused_rk3_ho(void)
+{
+  struct sheath_ctx ctx = create_ctx();
+  struct gkyl_gk_block_geom *bgeom = create_gk_block_geom(&ctx);
+
+  struct gkyl_comm *comm = gkyl_gyrokinetic_comms_new(false, false, stderr);
+  gkyl_gyrokinetic_multib_app *app = sheath_app_new(&ctx, bgeom, comm, false, false);
+  gkyl_gyrokinetic_multib_app *app_fused = sheath_app_new(&ctx, bgeom, comm, false, true);
+
+  gkyl_gyrokinetic_multib_app_apply_ic(app, 0.0);
+  gkyl_gyrokinetic_multib_app_apply_ic(app_fused, 0.0);
+
+  double dt = 1.0e-6;
+  for (int n=0; n<3; ++n) {
+    struct gkyl_update_status st = gkyl_gyrokinetic_multib_update(app, dt);
+    struct gkyl_update_status st_fused = gkyl_gyrokinetic_multib_update(app_fused, dt);
+    TEST_CHECK( st.success && st_fused.success );
+    TEST_CHECK( gkyl_compare_double(st.dt_actual, st_fused.dt_actual, 1e-12) );
+    TEST_MSG( "step %d: dt %.15e (unfused) vs %.15e (fused)", n, st.dt_actual, st_fused.dt_actual );
+    dt = st.dt_suggested;
+  }
+
+  for (int i=0; i<app->num_local_blocks; ++i) {
+    struct gkyl_gyrokinetic_app *sb = app->singleb_apps[i];
+    struct gkyl_gyrokinetic_app *sb_fused = app_fused->singleb_apps[i];
+    for (int s=0; s<sb->num_species; ++s) {
+      const struct gkyl_array *f = sb->species[s].f, *f_fused = sb_fused->species[s].f;
+      double err = 0.0, fnorm = 0.0;
+      for (size_t k=0; k<f->size*f->ncomp; ++k) {
+        const double *v = f->data, *v_fused = f_fused->data;
+        err = fmax(err, fabs(v[k]-v_fused[k]));
+        fnorm = fmax(fnorm, fabs(v[k]));
+      }
+      TEST_CHECK( err <= 1e-12*fnorm );
+      TEST_MSG( "block %d, species %s: max diff %g (max |f| %g)",
+        app->local_blocks[i], sb->species[s].info.name, err, fnorm );
+    }
+  }
+
+  gkyl_gyrokinetic_multib_app_release(app_fused);
+  gkyl_gyrokinetic_multib_app_release(app);
+  gkyl_gyrokinetic_comms_release(comm);
+  gkyl_gk_block_geom_release(bgeom);
+}
+
+TEST_LIST = {
+  { "test_auto_decomp_ho", test_auto_decomp_ho },
+  { "test_fused_rk3_ho", test_fused_rk3_ho },
+  { NULL, NULL },
+};
@@ -1061,6 +1061,105 @@ test_L_domain_allgather_dir0_cuts2_par()
   gkyl_comm_release(comm);
 }
 
+static void
+test_SOL_domain_slab_connections_dir1()
+{
+  int num_blocks = 3; // SOL-shaped example.
+  int ndim = 2;
+  int cuts_flat[] = {
+    2, 1, // Block 0.
+    1, 2, // Block 1.
+    2, 1, // Block 2.
+  };
+  int **cuts = cuts_array_new(num_blocks, ndim, cuts_flat);
+  struct gkyl_block_geom *geom  = create_SOL_domain_block_geom(cuts);
+  cuts_array_release(num_blocks, cuts);
+
+  int nghost[] = { 1, 1 };
+
+  // Setup for a gather along y, restricted to the x-extents of each rank.
+  int block_list[3][3] = {{0,1,2},{0,1,2},{0,1,2}};
+  int dir = 1;
+  int nconnected[3] = {3,3,3};
+  int slab_dirs[] = { 0 };
+
+  struct gkyl_rect_decomp **decomp =
+    gkyl_malloc(sizeof(struct gkyl_rect_decomp*[num_blocks]));
+  for (int i=0; i<num_blocks; ++i) {
+    const struct gkyl_block_geom_info *ginfo = gkyl_block_geom_get_block(geom, i);
+    struct gkyl_range range;
+    gkyl_create_global_range(2, ginfo->cells, &range);
+    decomp[i] = gkyl_rect_decomp_new_from_cuts(2, ginfo->cuts, &range);
+  }
+
+  // Block 0, rank 0 (x in [1,2]) sends its whole range to the ranks
+  // whose slab overlaps it: itself, both ranks of block 1 and rank 0
+  // of block 2. Its slab only contains the x in [1,2] half of the
+  // others' ranges.
+  struct gkyl_multib_comm_conn *mbcc_s = gkyl_multib_comm_conn_new_send_slab_from_connections(0, 0,
+    nghost, nconnected[0], block_list[0], dir, 1, slab_dirs, decomp);
+  struct gkyl_multib_comm_conn *mbcc_r = gkyl_multib_comm_conn_new_recv_slab_from_connections(0, 0,
+    nghost, nconnected[0], block_list[0], dir, 1, slab_dirs, decomp);
+  TEST_CHECK( 4 == mbcc_s->num_comm_conn );
+  TEST_CHECK( 4 == mbcc_r->num_comm_conn );
+
+  struct gkyl_comm_conn send_0[] = {
+    { .block_id = 0, .rank = 0 },
+    { .block_id = 1, .rank = 0 },
+    { .block_id = 1, .rank = 1 },
+    { .block_id = 2, .rank = 0 },
+  };
+  struct gkyl_comm_conn recv_0[] = {
+    { .block_id = 0, .rank = 0 },
+    { .block_id = 1, .rank = 0 },
+    { .block_id = 1, .rank = 1 },
+    { .block_id = 2, .rank = 0 },
+  };
+  for (int i=0; i<4; ++i)
+    gkyl_range_init(&send_0[i].range, 2, (int[]) { 1, 1 }, (int[]) { 2, 8 });
+  gkyl_range_init(&recv_0[0].range, 2, (int[]) { 1, 1 }, (int[]) { 2, 8 });
+  gkyl_range_init(&recv_0[1].range, 2, (int[]) { 1, 9 }, (int[]) { 2, 12 });
+  gkyl_range_init(&recv_0[2].range, 2, (int[]) { 1, 13 }, (int[]) { 2, 16 });
+  gkyl_range_init(&recv_0[3].range, 2, (int[]) { 1, 17 }, (int[]) { 2, 24 });
+  for (int i=0; i<4; ++i) {
+    TEST_CHECK( send_0[i].block_id == mbcc_s->comm_conn[i].block_id );
+    TEST_CHECK( send_0[i].rank == mbcc_s->comm_conn[i].rank );
+    TEST_CHECK( gkyl_range_compare(&send_0[i].range, &mbcc_s->comm_conn[i].range) );
+    TEST_CHECK( recv_0[i].block_id == mbcc_r->comm_conn[i].block_id );
+    TEST_CHECK( recv_0[i].rank == mbcc_r->comm_conn[i].rank );
+    TEST_CHECK( gkyl_range_compare(&recv_0[i].range, &mbcc_r->comm_conn[i].range) );
+  }
+  gkyl_multib_comm_conn_release(mbcc_s);
+  gkyl_multib_comm_conn_release(mbcc_r);
+
+  // Block 1, rank 1 (y in [5,8]) sends the x in [1,2] and [3,4] halves
+  // of its range to the two ranks of blocks 0 and 2, and receives all
+  // ranges along y.
+  mbcc_s = gkyl_multib_comm_conn_new_send_slab_from_connections(1, 1,
+    nghost, nconnected[1], block_list[1], dir, 1, slab_dirs, decomp);
+  mbcc_r = gkyl_multib_comm_conn_new_recv_slab_from_connections(1, 1,
+    nghost, nconnected[1], block_list[1], dir, 1, slab_dirs, decomp);
+  TEST_CHECK( 6 == mbcc_s->num_comm_conn );
+  TEST_CHECK( 6 == mbcc_r->num_comm_conn );
+
+  struct gkyl_range rng;
+  gkyl_range_init(&rng, 2, (int[]) { 3, 5 }, (int[]) { 4, 8 });
+  TEST_CHECK( 0 == mbcc_s->comm_conn[1].block_id );
+  TEST_CHECK( 1 == mbcc_s->comm_conn[1].rank );
+  TEST_CHECK( gkyl_range_compare(&rng, &mbcc_s->comm_conn[1].range) );
+  gkyl_range_init(&rng, 2, (int[]) { 1, 13 }, (int[]) { 4, 16 });
+  TEST_CHECK( 1 == mbcc_r->comm_conn[3].block_id );
+  TEST_CHECK( 1 == mbcc_r->comm_conn[3].rank );
+  TEST_CHECK( gkyl_range_compare(&rng, &mbcc_r->comm_conn[3].range) );
+  gkyl_multib_comm_conn_release(mbcc_s);
+  gkyl_multib_comm_conn_release(mbcc_r);
+
+  for (int i=0; i<num_blocks; ++i)
+    gkyl_rect_decomp_release(decomp[i]);
+  gkyl_free(decomp);
+  gkyl_block_geom_release(geom);
+}
+
 static void
 test_SOL_domain_allgather_dir1_cuts2_par(bool use_gpu)
 {
@@ -1367,6 +1466,7 @@ TEST_LIST = {
   //{ "test_L_domain_send_connections_dir0_cuts2_par", test_L_domain_send_connections_dir0_cuts2_par},
   //{ "test_L_domain_recv_connections_dir0_cuts2_par", test_L_domain_recv_connections_dir0_cuts2_par},
   //{ "test_L_domain_allgather_dir0_cuts2_par", test_L_domain_allgather_dir0_cuts2_par},
+  { "test_SOL_domain_slab_connections_dir1", test_SOL_domain_slab_connections_dir1},
   { "test_SOL_domain_allgather_dir1_cuts2_par_ho", test_SOL_domain_allgather_dir1_cuts2_par_ho},
 #ifdef GKYL_HAVE_NCCL
   { "test_SOL_domain_allgather_dir1_cuts2_par_dev", test_SOL_domain_allgather_dir1_cuts2_par_dev},
@@ -2,6 +2,64 @@
 #include <gkyl_bc_sheath_gyrokinetic_priv.h>
 #include <gkyl_alloc.h>
 #include <assert.h>
+#include <string.h>
+
+// Precompute the data needed to find the cells absorbed entirely.
+static void
+bc_gksheath_init_cutoff_data(struct gkyl_bc_sheath_gyrokinetic *up)
+{
+  int cdim = up->cdim, pdim = up->skin_r->ndim, vdim = pdim-cdim;
+  gkyl_cart_modal_serendip(&up->cbasis, cdim, up->basis->poly_order);
+
+  // The reflectedf kernels evaluate phi-phi_wall at the sheath edge, at
+  // Gauss-Legendre nodes in the other directions.
+  up->num_surf_nodes = 1 << (cdim-1);
+  up->surf_nodes = gkyl_malloc(sizeof(double[up->num_surf_nodes*cdim]));
+  for (int n=0; n<up->num_surf_nodes; ++n) {
+    double *node = &up->surf_nodes[n*cdim];
+    for (int d=0, k=0; d<cdim; ++d) {
+      if (d == up->dir)
+        node[d] = up->edge == GKYL_LOWER_EDGE? -1.0 : 1.0;
+      else
+        node[d] = ((n >> k++) & 1)? 1.0/sqrt(3.0) : -1.0/sqrt(3.0);
+    }
+  }
+
+  gkyl_range_init(&up->conf_skin_r, cdim, up->skin_r->lower, up->skin_r->upper);
+  gkyl_range_init(&up->vel_skin_r, vdim, up->skin_r->lower+cdim, up->skin_r->upper+cdim);
+
+  // Smallest vpar^2 in each velocity cell, computed as in the kernels.
+  up->vpar_abs_sq_lo = gkyl_malloc(sizeof(double[up->vel_skin_r.volume]));
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &up->vel_skin_r);
+  while (gkyl_range_iter_next(&iter)) {
+    long vel_loc = gkyl_range_idx(&up->vel_map->local_vel, iter.idx);
+    const double *vmap = (const double*) gkyl_array_cfetch(up->vel_map->vmap, vel_loc);
+    double vparLo = 0.7071067811865475*vmap[0]-1.224744871391589*vmap[1];
+    double vparUp = 1.224744871391589*vmap[1]+0.7071067811865475*vmap[0];
+    up->vpar_abs_sq_lo[gkyl_range_idx(&up->vel_skin_r, iter.idx)] =
+      vmap[0]>0.? vparLo*vparLo : vparUp*vparUp;
+  }
+}
+
+// Largest vcut^2 on the sheath surface of a conf-space cell, and a bound
+// on the round-off error in its value.
+static void
+bc_gksheath_vcut_sq_max(const struct gkyl_bc_sheath_gyrokinetic *up,
+  const double *phi, const double *phi_wall, double *vcut_sq_max, double *tol)
+{
+  double vmax = -INFINITY;
+  for (int n=0; n<up->num_surf_nodes; ++n) {
+    const double *node = &up->surf_nodes[n*up->cdim];
+    double dphi = up->cbasis.eval_expand(node, phi_wall) - up->cbasis.eval_expand(node, phi);
+    vmax = fmax(vmax, up->q2Dm*dphi);
+  }
+  double mag = 0.0;
+  for (int k=0; k<up->cbasis.num_basis; ++k)
+    mag += fabs(phi[k]) + fabs(phi_wall[k]);
+  vcut_sq_max[0] = vmax;
+  tol[0] = 1e-10*fabs(up->q2Dm)*mag;
+}
 
 struct gkyl_bc_sheath_gyrokinetic*
 gkyl_bc_sheath_gyrokinetic_new(int dir, enum gkyl_edge_loc edge, const struct gkyl_basis *basis,
@@ -40,6 +98,11 @@ gkyl_bc_sheath_gyrokinetic_new(int dir, enum gkyl_edge_loc edge, const struct gk
   up->kernels_cu = up->kernels;
 #endif
 
+  up->surf_nodes = 0;
+  up->vpar_abs_sq_lo = 0;
+  if (!use_gpu)
+    bc_gksheath_init_cutoff_data(up);
+
   return up;
 }
 
@@ -55,46 +118,63 @@ gkyl_bc_sheath_gyrokinetic_advance(const struct gkyl_bc_sheath_gyrokinetic *up,
   }
 #endif
 
-  int fidx[GKYL_MAX_DIM]; // Flipped index.
-  int vidx[2];
+  int idx[GKYL_MAX_DIM], fidx[GKYL_MAX_DIM]; // Skin and flipped ghost index.
 
-  int pdim = up->skin_r->ndim; 
+  int cdim = up->cdim;
   int vpar_dir = up->cdim;
   int uplo = up->skin_r->upper[vpar_dir]+up->skin_r->lower[vpar_dir];
+  int num_basis = up->basis->num_basis;
 
-  struct gkyl_range_iter iter;
-  gkyl_range_iter_init(&iter, up->skin_r);
-  while (gkyl_range_iter_next(&iter)) {
+  struct gkyl_range_iter conf_iter, vel_iter;
+  gkyl_range_iter_init(&conf_iter, &up->conf_skin_r);
+  while (gkyl_range_iter_next(&conf_iter)) {
 
-    gkyl_copy_int_arr(pdim, iter.idx, fidx);
-    fidx[vpar_dir] = uplo - iter.idx[vpar_dir];
-    // Turn this skin fidx into a ghost fidx.
-    fidx[up->dir] = up->ghost_r->lower[up->dir];
+    long conf_loc = gkyl_range_idx(conf_r, conf_iter.idx);
+    const double *phi_p = (const double*) gkyl_array_cfetch(phi, conf_loc);
+    const double *phi_wall_p = (const double*) gkyl_array_cfetch(phi_wall, conf_loc);
 
-    long skin_loc = gkyl_range_idx(up->skin_r, iter.idx);
-    long ghost_loc = gkyl_range_idx(up->ghost_r, fidx);
+    // Velocity cells with vpar^2 above the largest vcut^2 on the surface
+    // are absorbed entirely, so the kernel is only needed in cells that
+    // are fully or partially reflected.
+    double vcut_sq_max, tol;
+    bc_gksheath_vcut_sq_max(up, phi_p, phi_wall_p, &vcut_sq_max, &tol);
 
-    const double *inp = (const double*) gkyl_array_cfetch(distf, skin_loc);
-    double *out = (double*) gkyl_array_fetch(distf, ghost_loc);
+    for (int d=0; d<cdim; d++) idx[d] = conf_iter.idx[d];
 
-    for (int d=up->cdim; d<pdim; d++) vidx[d-up->cdim] = iter.idx[d]; 
-    long conf_loc = gkyl_range_idx(conf_r, iter.idx);
-    long vel_loc = gkyl_range_idx(&up->vel_map->local_vel, vidx);
+    gkyl_range_iter_init(&vel_iter, &up->vel_skin_r);
+    while (gkyl_range_iter_next(&vel_iter)) {
 
-    const double *phi_p = (const double*) gkyl_array_cfetch(phi, conf_loc);
-    const double *phi_wall_p = (const double*) gkyl_array_cfetch(phi_wall, conf_loc);
-    const double *vmap_p = (const double*) gkyl_array_cfetch(up->vel_map->vmap, vel_loc);
-
-    // Calculate reflected distribution function fhat.
-    // note: reflected distribution can be
-    // 1) fhat=0 (no reflection, i.e. absorb),
-    // 2) fhat=f (full reflection)
-    // 3) fhat=c*f (partial reflection)
-    double fhat[up->basis->num_basis];
-    up->kernels->reflectedf(vmap_p, up->q2Dm, phi_p, phi_wall_p, inp, fhat);
-
-    // Reflect fhat into skin cells.
-    bc_gksheath_reflect(up->dir, up->basis, up->cdim, out, fhat);
+      for (int d=cdim; d<up->skin_r->ndim; d++) idx[d] = vel_iter.idx[d-cdim];
+      gkyl_copy_int_arr(up->skin_r->ndim, idx, fidx);
+      fidx[vpar_dir] = uplo - idx[vpar_dir];
+      // Turn this skin fidx into a ghost fidx.
+      fidx[up->dir] = up->ghost_r->lower[up->dir];
+
+      long ghost_loc = gkyl_range_idx(up->ghost_r, fidx);
+      double *out = (double*) gkyl_array_fetch(distf, ghost_loc);
+
+      if (vcut_sq_max + tol < up->vpar_abs_sq_lo[gkyl_range_idx(&up->vel_skin_r, vel_iter.idx)]) {
+        memset(out, 0, sizeof(double[num_basis]));
+        continue;
+      }
+
+      long skin_loc = gkyl_range_idx(up->skin_r, idx);
+      const double *inp = (const double*) gkyl_array_cfetch(distf, skin_loc);
+
+      long vel_loc = gkyl_range_idx(&up->vel_map->local_vel, vel_iter.idx);
+      const double *vmap_p = (const double*) gkyl_array_cfetch(up->vel_map->vmap, vel_loc);
+
+      // Calculate reflected distribution function fhat.
+      // note: reflected distribution can be
+      // 1) fhat=0 (no reflection, i.e. absorb),
+      // 2) fhat=f (full reflection)
+      // 3) fhat=c*f (partial reflection)
+      double fhat[num_basis];
+      up->kernels->reflectedf(vmap_p, up->q2Dm, phi_p, phi_wall_p, inp, fhat);
+
+      // Reflect fhat into skin cells.
+      bc_gksheath_reflect(up->dir, up->basis, up->cdim, out, fhat);
+    }
   }
 }
 
@@ -107,6 +187,10 @@ void gkyl_bc_sheath_gyrokinetic_release(struct gkyl_bc_sheath_gyrokinetic *up)
   }
 #endif
   gkyl_velocity_map_release(up->vel_map);
+  if (up->surf_nodes) {
+    gkyl_free(up->surf_nodes);
+    gkyl_free(up->vpar_abs_sq_lo);
+  }
   gkyl_free(up->kernels);
   gkyl_free(up);
 }
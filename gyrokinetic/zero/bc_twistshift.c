@@ -64,9 +64,13 @@
 //   - ts_subcellint_sxv_sxvi: subcell integral sxv or sxvi.
 //   - ts_calc_mats: create scimat with the result of the subcell integrals.
 //
-//  Two additional helper functions:
-//   - ts_calc_num_numcol_fidx_do: index map to populate fmat with donors.
-//   - ts_calc_num_numcol_fidx_tar: index map to get mat-mat mult results.
+//  Additional helper functions:
+//   - ts_calc_num_numcol_fidx_do: index map to populate fmat with donors (GPU).
+//   - ts_calc_num_numcol_fidx_tar: index map to get mat-mat mult results (GPU).
+//   - ts_donor_interval: shift_dir interval of donors owned by another rank.
+//   - ts_calc_comm_plan: send/recv connections for a field decomposed along shift_dir.
+//   - ts_calc_lines: gather/scatter lists used by the CPU advance.
+//   - ts_advance_cpu: apply the BC as a block-sparse mat-vec per target cell (CPU).
 
 // Minimum allowed spacing between the lower and
 // upper xi (logical x) limits of subcell integral.
@@ -1635,6 +1639,279 @@ ts_calc_num_numcol_fidx_tar(struct gkyl_bc_twistshift *up)
   return num_numcol_fidx_tar;
 }
 
+bool
+ts_donor_interval(struct gkyl_bc_twistshift *up, int tar_lo, int tar_up,
+  int own_lo, int own_up, int *interval)
+{
+  // Find the smallest shift_dir interval containing all the donors, owned
+  // by the rank with cells own_lo-own_up along shift_dir, needed by targets
+  // tar_lo-tar_up. Returns false if no donors are needed.
+  interval[0] = own_up+1;
+  interval[1] = own_lo-1;
+  for (int i=0; i<up->shear_r.volume; i++) {
+    int shear_idx = up->shear_r.lower[0]+i;
+    for (int j=tar_lo; j<=tar_up; j++) {
+      long linidx_do = ts_shift_dir_idx_do_linidx(up->num_do, shear_idx, j,
+        up->shift_r.volume, up->shear_r.lower[0]);
+      for (int k=0; k<up->num_do[i]; k++) {
+        int shift_idx_do = up->shift_dir_idx_do[linidx_do+k];
+        if (own_lo <= shift_idx_do && shift_idx_do <= own_up) {
+          interval[0] = GKYL_MIN2(interval[0], shift_idx_do);
+          interval[1] = GKYL_MAX2(interval[1], shift_idx_do);
+        }
+      }
+    }
+  }
+  return interval[0] <= interval[1];
+}
+
+void
+ts_calc_comm_plan(struct gkyl_bc_twistshift *up, const struct gkyl_bc_twistshift_inp *inp)
+{
+  // Create the array holding local and remote donors, and the send/recv
+  // connections with the other ranks on the same bc_dir plane (i.e. the
+  // ranks whose range differs from ours only along shift_dir). There is at
+  // most one message to/from each partner, containing the smallest
+  // shift_dir interval that holds all the donors needed.
+  int ndim = up->local_bcdir_ext_r.ndim;
+
+  int bc_dir_loc = up->edge == GKYL_LOWER_EDGE? up->local_bcdir_ext_r.lower[up->bc_dir]
+                                              : up->local_bcdir_ext_r.upper[up->bc_dir];
+
+  int lo[GKYL_MAX_DIM], hi[GKYL_MAX_DIM];
+  for (int d=0; d<ndim; d++) {
+    lo[d] = up->local_bcdir_ext_r.lower[d];
+    hi[d] = up->local_bcdir_ext_r.upper[d];
+  }
+  lo[up->bc_dir] = hi[up->bc_dir] = bc_dir_loc;
+
+  // Range covering the bc_dir plane, spanning the global shift_dir range.
+  lo[up->shift_dir] = up->shift_r.lower[0];
+  hi[up->shift_dir] = up->shift_r.upper[0];
+  gkyl_range_init(&up->donor_r, ndim, lo, hi);
+  up->fdo_ext = gkyl_array_new(GKYL_DOUBLE, up->basis.num_basis, up->donor_r.volume);
+
+  lo[up->shift_dir] = up->local_bcdir_ext_r.lower[up->shift_dir];
+  hi[up->shift_dir] = up->local_bcdir_ext_r.upper[up->shift_dir];
+  gkyl_sub_range_init(&up->local_donor_r, &up->donor_r, lo, hi);
+  gkyl_sub_range_init(&up->local_plane_r, &up->local_bcdir_ext_r, lo, hi);
+
+  int rank;
+  gkyl_comm_get_rank(inp->comm, &rank);
+  const struct gkyl_range *my_r = &inp->decomp->ranges[rank];
+
+  enum gkyl_oriented_edge edge = up->edge == GKYL_LOWER_EDGE? GKYL_LOWER_POSITIVE : GKYL_UPPER_POSITIVE;
+
+  int num_send = 0, num_recv = 0;
+  struct gkyl_comm_conn send_conn[inp->decomp->ndecomp], recv_conn[inp->decomp->ndecomp];
+  for (int r=0; r<inp->decomp->ndecomp; r++) {
+    const struct gkyl_range *rr = &inp->decomp->ranges[r];
+
+    bool is_partner = r != rank;
+    for (int d=0; d<inp->decomp->ndim; d++) {
+      if (d != up->shift_dir && (rr->lower[d] != my_r->lower[d] || rr->upper[d] != my_r->upper[d]))
+        is_partner = false;
+    }
+    if (!is_partner)
+      continue;
+
+    int interval[2];
+    // Donors r needs from us.
+    if (ts_donor_interval(up, rr->lower[up->shift_dir], rr->upper[up->shift_dir],
+          my_r->lower[up->shift_dir], my_r->upper[up->shift_dir], interval)) {
+      lo[up->shift_dir] = interval[0];
+      hi[up->shift_dir] = interval[1];
+      send_conn[num_send] = (struct gkyl_comm_conn) {
+        .sr = GKYL_COMM_CONN_SEND,
+        .block_id = 0,
+        .rank = r,
+        .src_edge = edge,
+        .tar_edge = edge,
+      };
+      gkyl_sub_range_init(&send_conn[num_send].range, &up->local_bcdir_ext_r, lo, hi);
+      num_send++;
+    }
+
+    // Donors we need from r.
+    if (ts_donor_interval(up, my_r->lower[up->shift_dir], my_r->upper[up->shift_dir],
+          rr->lower[up->shift_dir], rr->upper[up->shift_dir], interval)) {
+      lo[up->shift_dir] = interval[0];
+      hi[up->shift_dir] = interval[1];
+      recv_conn[num_recv] = (struct gkyl_comm_conn) {
+        .sr = GKYL_COMM_CONN_RECV,
+        .block_id = 0,
+        .rank = r,
+        .src_edge = edge,
+        .tar_edge = edge,
+      };
+      gkyl_sub_range_init(&recv_conn[num_recv].range, &up->donor_r, lo, hi);
+      num_recv++;
+    }
+  }
+
+  up->mbcc_send = gkyl_multib_comm_conn_new(num_send, send_conn);
+  up->mbcc_recv = gkyl_multib_comm_conn_new(num_recv, recv_conn);
+  up->comm = gkyl_comm_acquire(inp->comm);
+}
+
+void
+ts_calc_lines(struct gkyl_bc_twistshift *up, const int *num_ghost)
+{
+  // Create the lists used by the CPU advance: the linear index of the first
+  // cell of each line along shift_dir in the plane the BC fills (donors and
+  // targets live in the same plane), the shear_dir index of each line, and
+  // the 0-based shift_dir index of each donor.
+  int ndim = up->local_bcdir_ext_r.ndim;
+
+  int bc_dir_loc = up->edge == GKYL_LOWER_EDGE? up->local_bcdir_ext_r.lower[up->bc_dir]
+                                              : up->local_bcdir_ext_r.upper[up->bc_dir];
+
+  // Range over the plane perpendicular to bc_dir.
+  struct gkyl_range plane_r;
+  int remove[GKYL_MAX_DIM] = {0}, loc_in_dir[GKYL_MAX_DIM] = {0};
+  remove[up->bc_dir] = 1;
+  loc_in_dir[up->bc_dir] = bc_dir_loc;
+  gkyl_range_deflate(&plane_r, &up->local_bcdir_ext_r, remove, loc_in_dir);
+
+  int shift_dir_in_plane = up->shift_dir < up->bc_dir? up->shift_dir : up->shift_dir-1;
+  int shear_dir_in_plane = up->shear_dir < up->bc_dir? up->shear_dir : up->shear_dir-1;
+
+  // Targets are the local cells along shift_dir.
+  up->num_shift_tar = up->local_bcdir_ext_r.upper[up->shift_dir]-up->local_bcdir_ext_r.lower[up->shift_dir]+1;
+  up->shift_tar_off = up->local_bcdir_ext_r.lower[up->shift_dir]-up->shift_r.lower[0];
+
+  up->num_lines = plane_r.volume / up->num_shift_tar;
+  up->line_loc = gkyl_malloc(up->num_lines * sizeof(long));
+  up->line_shear_idx = gkyl_malloc(up->num_lines * sizeof(int));
+  if (up->is_distributed)
+    up->line_ext_loc = gkyl_malloc(up->num_lines * sizeof(long));
+
+  long line_count = 0;
+  int idx[GKYL_MAX_DIM];
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &plane_r);
+  while (gkyl_range_iter_next(&iter)) {
+    if (iter.idx[shift_dir_in_plane] != up->local_bcdir_ext_r.lower[up->shift_dir])
+      continue;
+
+    for (int d=0, ic=0; d<ndim; d++) {
+      if (d == up->bc_dir)
+        idx[d] = bc_dir_loc;
+      else {
+        idx[d] = iter.idx[ic];
+        ic++;
+      }
+    }
+    up->line_loc[line_count] = gkyl_range_idx(&up->local_bcdir_ext_r, idx);
+    up->line_shear_idx[line_count] = iter.idx[shear_dir_in_plane]-up->shear_r.lower[0];
+    if (up->is_distributed) {
+      idx[up->shift_dir] = up->shift_r.lower[0];
+      up->line_ext_loc[line_count] = gkyl_range_idx(&up->donor_r, idx);
+    }
+    line_count += 1;
+  }
+
+  int idx_lo[GKYL_MAX_DIM], idx_up[GKYL_MAX_DIM];
+  for (int d=0; d<ndim; d++)
+    idx_lo[d] = idx_up[d] = up->local_bcdir_ext_r.lower[d];
+  idx_up[up->shift_dir] += 1;
+  up->shift_dir_stride = gkyl_range_idx(&up->local_bcdir_ext_r, idx_up)
+                        -gkyl_range_idx(&up->local_bcdir_ext_r, idx_lo);
+  if (up->is_distributed) {
+    idx_lo[up->bc_dir] = idx_up[up->bc_dir] = bc_dir_loc;
+    idx_lo[up->shift_dir] = up->shift_r.lower[0];
+    idx_up[up->shift_dir] = up->shift_r.lower[0]+1;
+    up->ext_shift_dir_stride = gkyl_range_idx(&up->donor_r, idx_up)
+                              -gkyl_range_idx(&up->donor_r, idx_lo);
+  }
+
+  int num_do_tot = 0;
+  for (int i=0; i<up->shear_r.volume; i++)
+    num_do_tot += up->num_do[i];
+  long num_do_off = num_do_tot * up->shift_r.volume;
+  up->do_off = gkyl_malloc(num_do_off * sizeof(int));
+  for (long i=0; i<num_do_off; i++)
+    up->do_off[i] = up->shift_dir_idx_do[i]-up->shift_r.lower[0];
+
+  up->line_buff = gkyl_malloc(up->shift_r.volume * up->basis.num_basis * sizeof(double));
+
+  // If there is more than one ghost layer, the layers other than the one
+  // filled by this BC are cleared in the advance.
+  up->clear_ghost_inner = num_ghost[up->bc_dir] > 1;
+  if (up->clear_ghost_inner) {
+    if (up->edge == GKYL_LOWER_EDGE)
+      gkyl_range_shorten_from_below(&up->ghost_inner_r, &up->ghost_r, up->bc_dir, num_ghost[up->bc_dir]-1);
+    else
+      gkyl_range_shorten_from_above(&up->ghost_inner_r, &up->ghost_r, up->bc_dir, num_ghost[up->bc_dir]-1);
+  }
+}
+
+void
+ts_advance_cpu(struct gkyl_bc_twistshift *up, struct gkyl_array *fdo, struct gkyl_array *ftar)
+{
+  // For each target cell, ftar = sum_q^{num_do} A_q . fdo_q, where A_q are
+  // the subcell integral matrices of this shear_dir cell (stored contiguously
+  // in column-major order) and fdo_q the donors in the same line.
+  int num_basis = up->basis.num_basis;
+  int num_shift = up->shift_r.volume;
+  bool in_place = fdo == ftar;
+
+  if (up->is_distributed) {
+    // Gather local and remote donors into fdo_ext.
+    gkyl_array_copy_range_to_range(up->fdo_ext, fdo, &up->local_donor_r, &up->local_plane_r);
+    gkyl_multib_comm_conn_array_transfer(up->comm, 1, (int[]) {0},
+      &up->mbcc_send, &up->mbcc_recv, &fdo, &up->fdo_ext);
+  }
+
+  if (up->clear_ghost_inner)
+    gkyl_array_clear_range(ftar, 0.0, &up->ghost_inner_r);
+
+  for (long l=0; l<up->num_lines; l++) {
+    int shear_idx = up->line_shear_idx[l];
+    int num_do = up->num_do[shear_idx];
+    const double *scimat_c = up->scimat->data + up->num_do_cum[shear_idx]*num_basis*num_basis;
+    const int *do_off_c = up->do_off + up->num_do_cum[shear_idx]*num_shift;
+
+    // Donors are read directly from fdo, unless the BC is applied in place,
+    // in which case the line is copied first (targets overwrite donors), or
+    // the field is decomposed along shift_dir (donors are in fdo_ext).
+    const double *fdo_line;
+    long fdo_stride;
+    if (up->is_distributed) {
+      fdo_line = (const double*) gkyl_array_cfetch(up->fdo_ext, up->line_ext_loc[l]);
+      fdo_stride = up->ext_shift_dir_stride * up->fdo_ext->ncomp;
+    }
+    else {
+      fdo_line = (const double*) gkyl_array_cfetch(fdo, up->line_loc[l]);
+      fdo_stride = up->shift_dir_stride * fdo->ncomp;
+      if (in_place) {
+        for (int j=0; j<num_shift; j++)
+          memcpy(up->line_buff+j*num_basis, fdo_line+j*fdo_stride, num_basis*sizeof(double));
+        fdo_line = up->line_buff;
+        fdo_stride = num_basis;
+      }
+    }
+
+    for (int j=0; j<up->num_shift_tar; j++) {
+      double *ftar_c = (double*) gkyl_array_fetch(ftar, up->line_loc[l]+j*up->shift_dir_stride);
+      for (int k=0; k<num_basis; k++)
+        ftar_c[k] = 0.0;
+
+      const int *do_off_tar = do_off_c + (j+up->shift_tar_off)*num_do;
+      for (int q=0; q<num_do; q++) {
+        const double *mat = scimat_c + q*num_basis*num_basis;
+        const double *fdo_c = fdo_line + do_off_tar[q]*fdo_stride;
+        for (int c=0; c<num_basis; c++) {
+          const double *mat_col = mat + c*num_basis;
+          double fdo_k = fdo_c[c];
+          for (int k=0; k<num_basis; k++)
+            ftar_c[k] += mat_col[k]*fdo_k;
+        }
+      }
+    }
+  }
+}
+
 void
 gkyl_bc_twistshift_choose_kernels(struct gkyl_basis basis, int cdim,
   struct gkyl_bc_twistshift_kernels *kers)
@@ -1701,8 +1978,9 @@ gkyl_bc_twistshift_new(const struct gkyl_bc_twistshift_inp *inp)
   long linidx = gkyl_range_idx(&up->shear_r, idx);
 
   // Create 1D grid and range in the diretion of the shift.
-  gkyl_range_init(&up->shift_r, 1, (int[]) {up->local_bcdir_ext_r.lower[inp->shift_dir]},
-                                   (int[]) {up->local_bcdir_ext_r.upper[inp->shift_dir]});
+  // Donors are found for the global range in the shift direction, in case the
+  // field is decomposed along shift_dir.
+  gkyl_range_init(&up->shift_r, 1, (int[]) {1}, (int[]) {inp->grid.cells[inp->shift_dir]});
   lo1d[0] = inp->grid.lower[up->shift_dir];
   up1d[0] = inp->grid.upper[up->shift_dir];
   cells1d[0] = inp->grid.cells[up->shift_dir];
@@ -1722,8 +2000,11 @@ gkyl_bc_twistshift_new(const struct gkyl_bc_twistshift_inp *inp)
     up->shift_dir_in_ts_grid = 1;
     up->shear_dir_in_ts_grid = 0;
   }
-  gkyl_range_init(&up->ts_r, 2, (int[]) {up->local_bcdir_ext_r.lower[dimlo], up->local_bcdir_ext_r.lower[dimup]},
-                                (int[]) {up->local_bcdir_ext_r.upper[dimlo], up->local_bcdir_ext_r.upper[dimup]});
+  int ts_lo[2] = {up->local_bcdir_ext_r.lower[dimlo], up->local_bcdir_ext_r.lower[dimup]};
+  int ts_up[2] = {up->local_bcdir_ext_r.upper[dimlo], up->local_bcdir_ext_r.upper[dimup]};
+  ts_lo[up->shift_dir_in_ts_grid] = up->shift_r.lower[0];
+  ts_up[up->shift_dir_in_ts_grid] = up->shift_r.upper[0];
+  gkyl_range_init(&up->ts_r, 2, ts_lo, ts_up);
   double lo2d[] = {inp->grid.lower[dimlo], inp->grid.lower[dimup]};
   double up2d[] = {inp->grid.upper[dimlo], inp->grid.upper[dimup]};
   int cells2d[] = {inp->grid.cells[dimlo], inp->grid.cells[dimup]};
@@ -1788,24 +2069,20 @@ gkyl_bc_twistshift_new(const struct gkyl_bc_twistshift_inp *inp)
       fmat_num_col *= up->local_bcdir_ext_r.upper[d] - up->local_bcdir_ext_r.lower[d] + 1;
   }
 
-  if (!up->use_gpu) {
-    up->fmat = gkyl_nmat_new(up->scimat->num, up->scimat->nr, fmat_num_col);
-    up->mm_contr = gkyl_nmat_new(up->scimat->num, up->scimat->nr, fmat_num_col);
-  }
 #ifdef GKYL_HAVE_CUDA
   if (up->use_gpu) {
     up->fmat = gkyl_nmat_cu_dev_new(up->scimat->num, up->scimat->nr, fmat_num_col);
     up->mm_contr = gkyl_nmat_cu_dev_new(up->scimat->num, up->scimat->nr, fmat_num_col);
-  }
-#endif
 
-  // Index translation from num-numcol plane index to linear index into the
-  // donor distribution function gkyl_array.
-  up->num_numcol_fidx_do = ts_calc_num_numcol_fidx_do(up);
+    // Index translation from num-numcol plane index to linear index into the
+    // donor distribution function gkyl_array.
+    up->num_numcol_fidx_do = ts_calc_num_numcol_fidx_do(up);
 
-  // Index translation from num-numcol plane index to linear index into the
-  // tar distribution function gkyl_array.
-  up->num_numcol_fidx_tar = ts_calc_num_numcol_fidx_tar(up);
+    // Index translation from num-numcol plane index to linear index into the
+    // tar distribution function gkyl_array.
+    up->num_numcol_fidx_tar = ts_calc_num_numcol_fidx_tar(up);
+  }
+#endif
 
   // Permutted ghost range, for indexing into the target field.
   // Order: Shift direction, redundant directions, shear direction.
@@ -1830,6 +2107,21 @@ gkyl_bc_twistshift_new(const struct gkyl_bc_twistshift_inp *inp)
   else
     gkyl_range_shorten_from_below(&up->ghost_r, &up->local_bcdir_ext_r, inp->bc_dir, inp->num_ghost[inp->bc_dir]);
 
+  // The field is distributed if it is decomposed along shift_dir. In this case
+  // donors owned by other ranks must be communicated.
+  up->is_distributed = inp->comm && inp->decomp &&
+    (up->local_bcdir_ext_r.lower[up->shift_dir] != up->shift_r.lower[0] ||
+     up->local_bcdir_ext_r.upper[up->shift_dir] != up->shift_r.upper[0]);
+  // Decomposition along shift_dir not yet supported on GPUs.
+  assert(!(up->is_distributed && up->use_gpu));
+  if (up->is_distributed)
+    ts_calc_comm_plan(up, inp);
+
+  // On the CPU we instead precompute gather/scatter lists and apply the BC
+  // directly from fdo to ftar (no fmat/mm_contr).
+  if (!up->use_gpu)
+    ts_calc_lines(up, inp->num_ghost);
+
   return up;
 }
 
@@ -1844,86 +2136,35 @@ gkyl_bc_twistshift_advance(struct gkyl_bc_twistshift *up, struct gkyl_array *fdo
   }
 #endif
 
-  // Assign the distribution matrices.
-  // This assumes that fdo->ncomp = fmat->nr.
-  // Recall:
-  //   fmat->num = sum_i^Nx num_do(i)
-  //   fmat->nr = num_basis = ncomp
-  //   fmat->nc = Ny*Nvpar*Nmu
-  for (size_t i=0; i<up->fmat->num * up->fmat->nr * up->fmat->nc; i++) {
-
-    long nc_idx = i / up->fmat->nr; // num-num_col index: current num-num_col plane.
-    int row_idx = i % up->fmat->nr; // row index: current DG coeff.
-
-    // This if-statement may only be needed in GPU kernel, not for CPUs.
-    if ((nc_idx < up->fmat->num * up->fmat->nc) && (row_idx < fdo->ncomp)) {
-      const double *fdo_c = (const double*) gkyl_array_cfetch(fdo, up->num_numcol_fidx_do[nc_idx]);
-      struct gkyl_mat mcurr = gkyl_nmat_get(up->fmat, nc_idx % up->fmat->num);
-
-      gkyl_mat_set(&mcurr, row_idx, nc_idx/up->fmat->num, fdo_c[row_idx]);
-    }
-  }
-
-  // Perform the mat-mat multiplications.
-  gkyl_nmat_mm(1.0, 0.0, GKYL_NO_TRANS, up->scimat, GKYL_NO_TRANS, up->fmat, up->mm_contr);
-
-  // Clear the ghost range.
-  gkyl_array_clear_range(ftar, 0.0, &up->ghost_r);
-
-  // Perform reduction over num_do contributions from mat-mat mults (mm_contr).
-  int num_cells_skin = (up->shear_r.upper[0]-up->shear_r.lower[0]+1) * up->fmat->nc;
-  for (size_t i=0; i<ftar->ncomp * num_cells_skin; i++) {
-
-    long linidx_tar = i / ftar->ncomp;
-    int row_idx = i % ftar->ncomp;
-
-    // This if-statement may only be needed in GPU kernel, not for CPUs.
-    if ((linidx_tar < num_cells_skin) && (row_idx < ftar->ncomp)) {
-      double *ftar_c = (double*) gkyl_array_fetch(ftar, up->num_numcol_fidx_tar[linidx_tar]);
-
-      int idx[GKYL_MAX_DIM] = {1};
-      gkyl_sub_range_inv_idx(&up->permutted_ghost_r, linidx_tar, idx);
-
-      int ac[GKYL_MAX_DIM] = {1};
-      for (int d=2; d<up->grid.ndim-1; d++)
-        ac[d-2] = up->grid.cells[d+1];
-      ac[up->permutted_ghost_r.ndim-2] = up->mm_contr->num;
-  
-      int start = 0;
-      for (int d=0; d<up->permutted_ghost_r.ndim-1; d++)
-        start = (start + (idx[d]-1)) * ac[d];
-
-      int shear_idx = idx[up->permutted_ghost_r.ndim-1];
-
-      int do_start = up->num_do_cum[shear_idx-1];
-      int do_end   = up->num_do_cum[shear_idx-1+1];
-      for (int j=do_start; j<do_end; j++) { // Only loop over num_do[i] elements.
-        long linidx_mm_contr = start + j;
-        struct gkyl_mat mat = gkyl_nmat_get(up->mm_contr, linidx_mm_contr % up->mm_contr->num);
-        ftar_c[row_idx] += gkyl_mat_get(&mat, row_idx, linidx_mm_contr / up->mm_contr->num);
-      }
-    }
-  }
+  ts_advance_cpu(up, fdo, ftar);
 }
 
 void gkyl_bc_twistshift_release(struct gkyl_bc_twistshift *up) {
   // Release memory associated with this updater.
   if (!up->use_gpu) {
     gkyl_free(up->num_do_cum);
-    gkyl_free(up->num_numcol_fidx_do);
-    gkyl_free(up->num_numcol_fidx_tar);
+    gkyl_free(up->line_loc);
+    gkyl_free(up->line_shear_idx);
+    gkyl_free(up->do_off);
+    gkyl_free(up->line_buff);
+  }
+  if (up->is_distributed) {
+    gkyl_free(up->line_ext_loc);
+    gkyl_array_release(up->fdo_ext);
+    gkyl_multib_comm_conn_release(up->mbcc_send);
+    gkyl_multib_comm_conn_release(up->mbcc_recv);
+    gkyl_comm_release(up->comm);
   }
 #ifdef GKYL_HAVE_CUDA
   if (up->use_gpu) {
     gkyl_cu_free(up->num_do_cum);
     gkyl_cu_free(up->num_numcol_fidx_do);
     gkyl_cu_free(up->num_numcol_fidx_tar);
+    gkyl_nmat_release(up->fmat);
+    gkyl_nmat_release(up->mm_contr);
   }
 #endif
 
-  gkyl_nmat_release(up->fmat);
-  gkyl_nmat_release(up->mm_contr);
-
   gkyl_nmat_release(up->scimat);
 
   gkyl_free(up->kernels);
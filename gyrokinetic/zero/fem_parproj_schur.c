@@ -0,0 +1,539 @@
+#include <gkyl_alloc.h>
+#include <gkyl_fem_parproj_schur.h>
+#include <gkyl_gauss_quad_data.h>
+#include <gkyl_mat.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of Gauss points per direction used to compute the element
+// matrices (exact for the products of p=1 functions involved).
+static const int schur_nquad = 3;
+
+struct gkyl_fem_parproj_schur {
+  int ndim; // number of dimensions
+  int pardir; // parallel direction
+  int num_basis; // number of DG basis functions
+  int nperp_nodes; // number of nodes in a perpendicular layer of a cell
+  int nloc; // number of nodes in a cell
+  int nz; // number of cells of this piece along the parallel direction
+  int nunk; // number of unknowns of each perpendicular cell
+  int bw; // half-bandwidth of the matrices
+  long nperp; // number of perpendicular cells
+  struct gkyl_range local_range; // cells of this piece
+  struct gkyl_range perp_range; // perpendicular cells
+
+  int num_pieces; // number of pieces in chain
+  bool is_periodic; // chain is periodic
+  int num_iface; // number of interfaces in chain
+  int iface[2]; // interfaces at the lower/upper end of this piece (-1 if none)
+
+  int nmat; // number of matrices: one, or one per perpendicular cell
+  double *amat; // banded matrices
+  double *afac; // LU factors of amat with interface unknowns decoupled
+  double *zcol; // interior response to a unit value on each interface node
+  double *schur_loc; // Schur complement of interior nodes (2m x 2m)
+
+  const struct gkyl_array *weight_right; // weight on the right side (may be NULL)
+  double *to_modal; // to_modal[k*nloc+i] = int w_k N_i
+  double *rhs_tensor; // rhs_tensor[(i*nb+k)*nb+l] = int N_i w_k w_l (weight_right)
+
+  double *xint; // solution with interface values set to zero
+  double *bvec; // RHS vector (work space)
+  double *gvec; // residuals on all interfaces of chain (work space)
+  double *sinv; // rows of the inverse interface system for this piece
+  double *schur_chain; // interface system of chain (work space)
+};
+
+static inline long
+band_idx(int bw, int r, int c)
+{
+  return (long) r*(2*bw+1) + c - r + bw;
+}
+
+// Entry (r,c) of banded matrix, zero outside the band.
+static inline double
+band_get(int bw, const double *a, int r, int c)
+{
+  return abs(r-c) <= bw ? a[band_idx(bw,r,c)] : 0.0;
+}
+
+// In-place LU factorization of banded matrix without pivoting (the
+// matrices are symmetric positive definite).
+static void
+band_lu(int n, int bw, double *a)
+{
+  for (int k=0; k<n; ++k) {
+    double piv = a[band_idx(bw,k,k)];
+    int rmax = GKYL_MIN2(n-1, k+bw);
+    for (int r=k+1; r<=rmax; ++r) {
+      double l = a[band_idx(bw,r,k)]/piv;
+      a[band_idx(bw,r,k)] = l;
+      if (l == 0.0) continue;
+      for (int c=k+1; c<=rmax; ++c)
+        a[band_idx(bw,r,c)] -= l*a[band_idx(bw,k,c)];
+    }
+  }
+}
+
+// Solve with banded LU factors in place.
+static void
+band_solve(int n, int bw, const double *a, double *x)
+{
+  for (int r=1; r<n; ++r)
+    for (int c=GKYL_MAX2(0, r-bw); c<r; ++c)
+      x[r] -= a[band_idx(bw,r,c)]*x[c];
+  for (int r=n-1; r>=0; --r) {
+    for (int c=r+1; c<=GKYL_MIN2(n-1, r+bw); ++c)
+      x[r] -= a[band_idx(bw,r,c)]*x[c];
+    x[r] /= a[band_idx(bw,r,r)];
+  }
+}
+
+// Row r of banded matrix times vector x.
+static double
+band_row_dot(int n, int bw, const double *a, int r, const double *x)
+{
+  double s = 0.0;
+  for (int c=GKYL_MAX2(0, r-bw); c<=GKYL_MIN2(n-1, r+bw); ++c)
+    s += a[band_idx(bw,r,c)]*x[c];
+  return s;
+}
+
+// Interfaces at the lower and upper end of piece q of a chain.
+static void
+piece_ifaces(int q, int num_pieces, bool is_periodic, int iface[2])
+{
+  iface[0] = q > 0 ? q-1 : (is_periodic ? num_pieces-1 : -1);
+  iface[1] = q < num_pieces-1 ? q : (is_periodic ? num_pieces-1 : -1);
+}
+
+// Local unknown of node r (0<=r<2m) of the interface records.
+static inline int
+iface_unknown(const struct gkyl_fem_parproj_schur *up, int r)
+{
+  int m = up->nperp_nodes;
+  return r < m ? r : up->nz*m + r - m;
+}
+
+// Index of the record of a perpendicular cell in a range of records.
+static long
+record_loc(const struct gkyl_fem_parproj_schur *up, const struct gkyl_range *rng,
+  const int *pidx, int zidx)
+{
+  int idx[GKYL_MAX_DIM];
+  for (int d=0; d<up->pardir; ++d) idx[d] = pidx[d];
+  idx[up->pardir] = zidx;
+  return gkyl_range_idx(rng, idx);
+}
+
+// Linear index of the perpendicular cell of a cell.
+static inline long
+perp_loc(const struct gkyl_fem_parproj_schur *up, const int *idx)
+{
+  return up->ndim > 1 ? gkyl_range_idx(&up->perp_range, idx) : 0;
+}
+
+struct gkyl_fem_parproj_schur*
+gkyl_fem_parproj_schur_new(const struct gkyl_fem_parproj_schur_inp *inp)
+{
+  assert(inp->basis->poly_order == 1);
+
+  struct gkyl_fem_parproj_schur *up = gkyl_malloc(sizeof(*up));
+
+  int ndim = up->ndim = inp->local_range->ndim;
+  int pardir = up->pardir = ndim-1;
+  int nb = up->num_basis = inp->basis->num_basis;
+  int m = up->nperp_nodes = 1 << (ndim-1);
+  int nloc = up->nloc = 2*m;
+  up->local_range = *inp->local_range;
+  up->nz = gkyl_range_shape(inp->local_range, pardir);
+  up->nunk = m*(up->nz+1);
+  up->bw = 2*m-1;
+
+  if (ndim > 1)
+    gkyl_range_init(&up->perp_range, ndim-1, inp->local_range->lower, inp->local_range->upper);
+  else
+    gkyl_range_init(&up->perp_range, 1, (int[]) { 0 }, (int[]) { 0 });
+  up->nperp = up->perp_range.volume;
+
+  up->num_pieces = inp->num_pieces;
+  up->is_periodic = inp->is_periodic;
+  up->num_iface = inp->is_periodic ? inp->num_pieces : inp->num_pieces-1;
+  piece_ifaces(inp->piece, inp->num_pieces, inp->is_periodic, up->iface);
+
+  // Values of the basis functions at quadrature points. Node i is the
+  // corner with coordinate +1 in direction d if bit d of i is set.
+  int nq1 = schur_nquad, nq = 1;
+  for (int d=0; d<ndim; ++d) nq *= nq1;
+  const double *ord = gkyl_gauss_ordinates[nq1], *wgt = gkyl_gauss_weights[nq1];
+  double *qw = gkyl_malloc(sizeof(double[nq]));
+  double *qb = gkyl_malloc(sizeof(double[nq*nb]));
+  double *qn = gkyl_malloc(sizeof(double[nq*nloc]));
+  for (int q=0; q<nq; ++q) {
+    double xc[GKYL_MAX_DIM];
+    qw[q] = 1.0;
+    for (int d=0, qr=q; d<ndim; ++d, qr/=nq1) {
+      xc[d] = ord[qr % nq1];
+      qw[q] *= wgt[qr % nq1];
+    }
+    inp->basis->eval(xc, &qb[q*nb]);
+    for (int i=0; i<nloc; ++i) {
+      double n = 1.0;
+      for (int d=0; d<ndim; ++d)
+        n *= 0.5*(1.0 + ((i >> d) & 1 ? xc[d] : -xc[d]));
+      qn[q*nloc+i] = n;
+    }
+  }
+
+  up->to_modal = gkyl_malloc(sizeof(double[nb*nloc]));
+  for (int k=0; k<nb; ++k) {
+    for (int i=0; i<nloc; ++i) {
+      double s = 0.0;
+      for (int q=0; q<nq; ++q)
+        s += qw[q]*qb[q*nb+k]*qn[q*nloc+i];
+      up->to_modal[k*nloc+i] = s;
+    }
+  }
+
+  up->weight_right = inp->weight_right ? gkyl_array_acquire(inp->weight_right) : 0;
+  up->rhs_tensor = 0;
+  if (inp->weight_right) {
+    up->rhs_tensor = gkyl_malloc(sizeof(double[nloc*nb*nb]));
+    for (int i=0; i<nloc; ++i)
+      for (int k=0; k<nb; ++k)
+        for (int l=0; l<nb; ++l) {
+          double s = 0.0;
+          for (int q=0; q<nq; ++q)
+            s += qw[q]*qn[q*nloc+i]*qb[q*nb+k]*qb[q*nb+l];
+          up->rhs_tensor[(i*nb+k)*nb+l] = s;
+        }
+  }
+
+  // Element mass matrices, mass_tensor[(i*nloc+j)*nb+k] = int N_i N_j w_k
+  // so that the weighted mass matrix is a contraction with the weight.
+  double *mass_tensor = gkyl_malloc(sizeof(double[nloc*nloc*nb]));
+  double *mass_el = gkyl_malloc(sizeof(double[nloc*nloc]));
+  for (int i=0; i<nloc; ++i)
+    for (int j=0; j<nloc; ++j) {
+      double s = 0.0;
+      for (int q=0; q<nq; ++q)
+        s += qw[q]*qn[q*nloc+i]*qn[q*nloc+j];
+      mass_el[i*nloc+j] = s;
+      for (int k=0; k<nb; ++k) {
+        s = 0.0;
+        for (int q=0; q<nq; ++q)
+          s += qw[q]*qn[q*nloc+i]*qn[q*nloc+j]*qb[q*nb+k];
+        mass_tensor[(i*nloc+j)*nb+k] = s;
+      }
+    }
+
+  // Assemble the matrices: without a left weight all perpendicular
+  // cells share the same matrix.
+  int nunk = up->nunk, bw = up->bw;
+  long bsz = (long) nunk*(2*bw+1);
+  up->nmat = inp->weight_left ? up->nperp : 1;
+  up->amat = gkyl_calloc(up->nmat*bsz, sizeof(double));
+  if (inp->weight_left) {
+    struct gkyl_range_iter iter;
+    gkyl_range_iter_init(&iter, inp->local_range);
+    while (gkyl_range_iter_next(&iter)) {
+      const double *wl = gkyl_array_cfetch(inp->weight_left, gkyl_range_idx(inp->local_range, iter.idx));
+      double *a = &up->amat[perp_loc(up, iter.idx)*bsz];
+      int kz = iter.idx[pardir] - inp->local_range->lower[pardir];
+      for (int i=0; i<nloc; ++i)
+        for (int j=0; j<nloc; ++j) {
+          double s = 0.0;
+          for (int k=0; k<nb; ++k)
+            s += mass_tensor[(i*nloc+j)*nb+k]*wl[k];
+          a[band_idx(bw, kz*m+i, kz*m+j)] += s;
+        }
+    }
+  }
+  else {
+    for (int kz=0; kz<up->nz; ++kz)
+      for (int i=0; i<nloc; ++i)
+        for (int j=0; j<nloc; ++j)
+          up->amat[band_idx(bw, kz*m+i, kz*m+j)] += mass_el[i*nloc+j];
+  }
+
+  // Decouple the interface unknowns and factorize. Then compute the
+  // interior response to each interface node and the local Schur
+  // complement S = A_GG - A_GI A_II^{-1} A_IG.
+  up->afac = gkyl_malloc(sizeof(double[up->nmat*bsz]));
+  up->zcol = gkyl_calloc(up->nmat*nloc*nunk, sizeof(double));
+  up->schur_loc = gkyl_calloc(up->nmat*nloc*nloc, sizeof(double));
+  memcpy(up->afac, up->amat, sizeof(double[up->nmat*bsz]));
+  for (long p=0; p<up->nmat; ++p) {
+    const double *a = &up->amat[p*bsz];
+    double *af = &up->afac[p*bsz];
+    for (int r=0; r<nloc; ++r) {
+      if (up->iface[r/m] < 0) continue;
+      int u = iface_unknown(up, r);
+      for (int c=GKYL_MAX2(0, u-bw); c<=GKYL_MIN2(nunk-1, u+bw); ++c) {
+        af[band_idx(bw,u,c)] = 0.0;
+        af[band_idx(bw,c,u)] = 0.0;
+      }
+      af[band_idx(bw,u,u)] = 1.0;
+    }
+    band_lu(nunk, bw, af);
+
+    for (int c=0; c<nloc; ++c) {
+      if (up->iface[c/m] < 0) continue;
+      int gc = iface_unknown(up, c);
+      double *z = &up->zcol[(p*nloc+c)*nunk];
+      for (int j=GKYL_MAX2(0, gc-bw); j<=GKYL_MIN2(nunk-1, gc+bw); ++j)
+        z[j] = -a[band_idx(bw,j,gc)];
+      for (int r=0; r<nloc; ++r)
+        if (up->iface[r/m] >= 0) z[iface_unknown(up, r)] = 0.0;
+      band_solve(nunk, bw, af, z);
+
+      for (int r=0; r<nloc; ++r) {
+        if (up->iface[r/m] < 0) continue;
+        int gr = iface_unknown(up, r);
+        up->schur_loc[(p*nloc+r)*nloc+c] = band_get(bw, a, gr, gc) + band_row_dot(nunk, bw, a, gr, z);
+      }
+    }
+  }
+
+  int niface_unk = up->num_iface*m;
+  up->xint = gkyl_malloc(sizeof(double[up->nperp*nunk]));
+  up->bvec = gkyl_malloc(sizeof(double[nunk]));
+  up->gvec = gkyl_malloc(sizeof(double[GKYL_MAX2(1, niface_unk)]));
+  up->sinv = gkyl_calloc(up->nperp*nloc*GKYL_MAX2(1, niface_unk), sizeof(double));
+  up->schur_chain = gkyl_malloc(sizeof(double[GKYL_MAX2(1, 2*niface_unk*niface_unk)]));
+
+  gkyl_free(qw);
+  gkyl_free(qb);
+  gkyl_free(qn);
+  gkyl_free(mass_tensor);
+  gkyl_free(mass_el);
+
+  return up;
+}
+
+int
+gkyl_fem_parproj_schur_schur_ncomp(const struct gkyl_fem_parproj_schur *up)
+{
+  return up->nloc*up->nloc;
+}
+
+int
+gkyl_fem_parproj_schur_resid_ncomp(const struct gkyl_fem_parproj_schur *up)
+{
+  return up->nloc;
+}
+
+void
+gkyl_fem_parproj_schur_get_schur(const struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *iface_range, struct gkyl_array *schur)
+{
+  int ns = up->nloc*up->nloc;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &up->perp_range);
+  while (gkyl_range_iter_next(&iter)) {
+    long p = gkyl_range_idx(&up->perp_range, iter.idx);
+    double *rec = gkyl_array_fetch(schur, record_loc(up, iface_range, iter.idx, iface_range->lower[up->pardir]));
+    memcpy(rec, &up->schur_loc[(up->nmat > 1 ? p : 0)*ns], sizeof(double[ns]));
+  }
+}
+
+void
+gkyl_fem_parproj_schur_set_schur(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *chain_range, const struct gkyl_array *schur_chain)
+{
+  int m = up->nperp_nodes, nloc = up->nloc, n = up->num_iface*m;
+  if (n == 0) return;
+
+  // The interface system of the previous perpendicular cell is kept
+  // in the upper half of schur_chain, to reuse its inverse when the
+  // systems are the same (e.g. without a left weight).
+  double *smat = up->schur_chain, *sprev = up->schur_chain + n*n;
+  struct gkyl_mat *sm = gkyl_mat_new(n, n, 0.0);
+  struct gkyl_mat *sinv = gkyl_mat_new(n, n, 0.0);
+  long *ipiv = gkyl_malloc(sizeof(long[n]));
+
+  long pprev = -1;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &up->perp_range);
+  while (gkyl_range_iter_next(&iter)) {
+    long p = gkyl_range_idx(&up->perp_range, iter.idx);
+
+    for (long k=0; k<n*n; ++k) smat[k] = 0.0;
+    for (int q=0; q<up->num_pieces; ++q) {
+      int qface[2];
+      piece_ifaces(q, up->num_pieces, up->is_periodic, qface);
+      const double *rec = gkyl_array_cfetch(schur_chain,
+        record_loc(up, chain_range, iter.idx, chain_range->lower[up->pardir]+q));
+      for (int r=0; r<nloc; ++r) {
+        if (qface[r/m] < 0) continue;
+        int row = qface[r/m]*m + r%m;
+        for (int c=0; c<nloc; ++c) {
+          if (qface[c/m] < 0) continue;
+          smat[row*n + qface[c/m]*m + c%m] += rec[r*nloc+c];
+        }
+      }
+    }
+
+    double *sp = &up->sinv[p*nloc*n];
+    if ((pprev >= 0) && (memcmp(smat, sprev, sizeof(double[n*n])) == 0)) {
+      memcpy(sp, &up->sinv[pprev*nloc*n], sizeof(double[nloc*n]));
+    }
+    else {
+      gkyl_mat_clear(sinv, 0.0);
+      for (int i=0; i<n; ++i) {
+        gkyl_mat_set(sinv, i, i, 1.0);
+        for (int j=0; j<n; ++j)
+          gkyl_mat_set(sm, i, j, smat[i*n+j]);
+      }
+      gkyl_mat_linsolve_lu(sm, sinv, ipiv);
+
+      // Keep only the rows of the nodes on the ends of this piece.
+      for (int r=0; r<nloc; ++r) {
+        if (up->iface[r/m] < 0) continue;
+        int row = up->iface[r/m]*m + r%m;
+        for (int c=0; c<n; ++c)
+          sp[r*n+c] = gkyl_mat_get(sinv, row, c);
+      }
+      memcpy(sprev, smat, sizeof(double[n*n]));
+    }
+    pprev = p;
+  }
+
+  gkyl_mat_release(sm);
+  gkyl_mat_release(sinv);
+  gkyl_free(ipiv);
+}
+
+void
+gkyl_fem_parproj_schur_set_rhs(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_array *rhsin, const struct gkyl_range *iface_range, struct gkyl_array *resid)
+{
+  int m = up->nperp_nodes, nloc = up->nloc, nb = up->num_basis;
+  int nunk = up->nunk, bw = up->bw, pardir = up->pardir;
+  long bsz = (long) nunk*(2*bw+1);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &up->perp_range);
+  while (gkyl_range_iter_next(&iter)) {
+    long p = gkyl_range_idx(&up->perp_range, iter.idx);
+    const double *a = &up->amat[(up->nmat > 1 ? p : 0)*bsz];
+    const double *af = &up->afac[(up->nmat > 1 ? p : 0)*bsz];
+
+    // Assemble the RHS vector of this perpendicular cell.
+    double *b = up->bvec;
+    for (int j=0; j<nunk; ++j) b[j] = 0.0;
+    int idx[GKYL_MAX_DIM];
+    for (int d=0; d<pardir; ++d) idx[d] = iter.idx[d];
+    for (int kz=0; kz<up->nz; ++kz) {
+      idx[pardir] = up->local_range.lower[pardir]+kz;
+      long loc = gkyl_range_idx(&up->local_range, idx);
+      const double *rho = gkyl_array_cfetch(rhsin, loc);
+      const double *wr = up->weight_right ? gkyl_array_cfetch(up->weight_right, loc) : 0;
+      for (int i=0; i<nloc; ++i) {
+        double s = 0.0;
+        if (wr) {
+          for (int k=0; k<nb; ++k)
+            for (int l=0; l<nb; ++l)
+              s += up->rhs_tensor[(i*nb+k)*nb+l]*wr[k]*rho[l];
+        }
+        else {
+          for (int l=0; l<nb; ++l)
+            s += up->to_modal[l*nloc+i]*rho[l];
+        }
+        b[kz*m+i] += s;
+      }
+    }
+
+    // Solve for the interior with zero interface values, and compute
+    // the residuals on the interfaces.
+    double *x = &up->xint[p*nunk];
+    memcpy(x, b, sizeof(double[nunk]));
+    for (int r=0; r<nloc; ++r)
+      if (up->iface[r/m] >= 0) x[iface_unknown(up, r)] = 0.0;
+    band_solve(nunk, bw, af, x);
+
+    double *g = gkyl_array_fetch(resid, record_loc(up, iface_range, iter.idx, iface_range->lower[pardir]));
+    for (int r=0; r<nloc; ++r) {
+      int gr = iface_unknown(up, r);
+      g[r] = up->iface[r/m] >= 0 ? b[gr] - band_row_dot(nunk, bw, a, gr, x) : 0.0;
+    }
+  }
+}
+
+void
+gkyl_fem_parproj_schur_solve(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *chain_range, const struct gkyl_array *resid_chain,
+  struct gkyl_array *phiout)
+{
+  int m = up->nperp_nodes, nloc = up->nloc, nb = up->num_basis;
+  int nunk = up->nunk, pardir = up->pardir, n = up->num_iface*m;
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &up->perp_range);
+  while (gkyl_range_iter_next(&iter)) {
+    long p = gkyl_range_idx(&up->perp_range, iter.idx);
+    double *x = &up->xint[p*nunk];
+
+    if (n > 0) {
+      // Residuals on all interfaces of the chain.
+      double *g = up->gvec;
+      for (int j=0; j<n; ++j) g[j] = 0.0;
+      for (int q=0; q<up->num_pieces; ++q) {
+        int qface[2];
+        piece_ifaces(q, up->num_pieces, up->is_periodic, qface);
+        const double *rec = gkyl_array_cfetch(resid_chain,
+          record_loc(up, chain_range, iter.idx, chain_range->lower[pardir]+q));
+        for (int r=0; r<nloc; ++r)
+          if (qface[r/m] >= 0) g[qface[r/m]*m + r%m] += rec[r];
+      }
+
+      // Interface values, and their contribution to the interior.
+      const double *sp = &up->sinv[p*nloc*n];
+      const double *z = &up->zcol[(up->nmat > 1 ? p : 0)*nloc*nunk];
+      for (int r=0; r<nloc; ++r) {
+        if (up->iface[r/m] < 0) continue;
+        double u = 0.0;
+        for (int c=0; c<n; ++c)
+          u += sp[r*n+c]*g[c];
+        for (int j=0; j<nunk; ++j)
+          x[j] += z[r*nunk+j]*u;
+        x[iface_unknown(up, r)] = u;
+      }
+    }
+
+    // Project the nodal solution onto the DG basis.
+    int idx[GKYL_MAX_DIM];
+    for (int d=0; d<pardir; ++d) idx[d] = iter.idx[d];
+    for (int kz=0; kz<up->nz; ++kz) {
+      idx[pardir] = up->local_range.lower[pardir]+kz;
+      double *phi = gkyl_array_fetch(phiout, gkyl_range_idx(&up->local_range, idx));
+      for (int k=0; k<nb; ++k) {
+        double s = 0.0;
+        for (int i=0; i<nloc; ++i)
+          s += up->to_modal[k*nloc+i]*x[kz*m+i];
+        phi[k] = s;
+      }
+    }
+  }
+}
+
+void
+gkyl_fem_parproj_schur_release(struct gkyl_fem_parproj_schur *up)
+{
+  if (up->weight_right)
+    gkyl_array_release(up->weight_right);
+  gkyl_free(up->to_modal);
+  gkyl_free(up->rhs_tensor);
+  gkyl_free(up->amat);
+  gkyl_free(up->afac);
+  gkyl_free(up->zcol);
+  gkyl_free(up->schur_loc);
+  gkyl_free(up->xint);
+  gkyl_free(up->bvec);
+  gkyl_free(up->gvec);
+  gkyl_free(up->sinv);
+  gkyl_free(up->schur_chain);
+  gkyl_free(up);
+}
@@ -64,21 +64,17 @@ gkyl_gk_maxwellian_moments_inew(const struct gkyl_gk_maxwellian_moments_inp *inp
     }
   }
 
-  // Moment calculator for needed moments (M0, M1, and M2)
+  // Moment calculators for M0 alone, and for (M0, M1, M2par, M2perp) computed
+  // together in a single sweep over the distribution function.
   up->M0_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
     inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M0, 0, inp->use_gpu);
-  up->M1_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
-    inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M1, 0, inp->use_gpu);
-  up->M2_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
-    inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M2, 0, inp->use_gpu);   
-
-  if (vdim == 2) {
-    // Additional moment calculators for Bi-Maxwellian moments (M2par, M2perp) 
-    up->M2_par_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
-      inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M2PAR, 0, inp->use_gpu);   
-    up->M2_perp_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
-      inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M2PERP, 0, inp->use_gpu);  
-  } 
+  up->moms_calc = gkyl_dg_updater_moment_gyrokinetic_new(inp->phase_grid, inp->conf_basis,
+    inp->phase_basis, inp->conf_range, inp->mass, 0, inp->vel_map, inp->gk_geom, NULL, GKYL_F_MOMENT_M0M1M2PARM2PERP, 0, inp->use_gpu);
+  int num_mom = gkyl_dg_updater_moment_gyrokinetic_num_mom(up->moms_calc);
+  if (inp->use_gpu)
+    up->moms = gkyl_array_cu_dev_new(GKYL_DOUBLE, num_mom*up->num_conf_basis, conf_range_ext_ncells);
+  else
+    up->moms = gkyl_array_new(GKYL_DOUBLE, num_mom*up->num_conf_basis, conf_range_ext_ncells);
 
   return up;
 }
@@ -102,15 +98,15 @@ gkyl_gk_maxwellian_density_moment_advance(struct gkyl_gk_maxwellian_moments *up,
 }
 
 void 
-gkyl_gk_maxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up, 
-  const struct gkyl_range *phase_range, const struct gkyl_range *conf_range, 
-  const struct gkyl_array *fin, struct gkyl_array *moms_out)
+gkyl_gk_maxwellian_moments_from_moms_advance(struct gkyl_gk_maxwellian_moments *up, 
+  const struct gkyl_range *conf_range, const struct gkyl_array *moms_in,
+  struct gkyl_array *moms_out)
 {
-  // compute J*M0 and J*M1 where J is the configurations-space Jacobian
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M0_calc, phase_range, conf_range, 
-    fin, up->M0);
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M1_calc, phase_range, conf_range, 
-    fin, up->M1);
+  int num_conf_basis = up->num_conf_basis;
+
+  // Separate J*M0 and J*M1 where J is the configurations-space Jacobian
+  gkyl_array_set_offset_range(up->M0, 1.0, moms_in, 0*num_conf_basis, conf_range);
+  gkyl_array_set_offset_range(up->M1, 1.0, moms_in, 1*num_conf_basis, conf_range);
 
   // Isolate u_par by dividing J*M1 by J*M0
   gkyl_dg_div_op_range(up->mem, up->conf_basis, 
@@ -120,9 +116,10 @@ gkyl_gk_maxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up,
   gkyl_dg_mul_op_range(up->conf_basis, 
     0, up->u_par_dot_M1, 0, up->u_par, 0, up->M1, conf_range); 
 
-  // Compute J*M2 = vdim_phys*J*n*T/m + J*M1*upar.
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M2_calc, phase_range, conf_range, 
-    fin, up->pressure);
+  // J*M2 = J*M2par + J*M2perp = vdim_phys*J*n*T/m + J*M1*upar.
+  gkyl_array_set_offset_range(up->pressure, 1.0, moms_in, 2*num_conf_basis, conf_range);
+  if (up->vdim_phys == 3)
+    gkyl_array_accumulate_offset_range(up->pressure, 1.0, moms_in, 3*num_conf_basis, conf_range);
   // Subtract off J*M1*upar from total J*M2
   gkyl_array_accumulate_range(up->pressure, -1.0, 
     up->u_par_dot_M1, conf_range); 
@@ -141,21 +138,31 @@ gkyl_gk_maxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up,
     gkyl_array_set_range(moms_out, 1.0, up->M0, conf_range);
   }
   // Save the other outputs to moms_out (n, V_drift, T/m):
-  int num_conf_basis = up->num_conf_basis;
   gkyl_array_set_offset_range(moms_out, 1.0, up->u_par, 1*num_conf_basis, conf_range);
   gkyl_array_set_offset_range(moms_out, 1.0, up->temperature, 2*num_conf_basis, conf_range);
 }
 
 void 
-gkyl_gk_bimaxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up, 
+gkyl_gk_maxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up, 
   const struct gkyl_range *phase_range, const struct gkyl_range *conf_range, 
   const struct gkyl_array *fin, struct gkyl_array *moms_out)
 {
-  // compute J*M0 and J*M1 where J is the configurations-space Jacobian
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M0_calc, phase_range, conf_range, 
-    fin, up->M0);
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M1_calc, phase_range, conf_range, 
-    fin, up->M1);
+  // Compute J*(M0, M1, M2par, M2perp) in a single sweep over fin.
+  gkyl_dg_updater_moment_gyrokinetic_advance(up->moms_calc, phase_range, conf_range, 
+    fin, up->moms);
+  gkyl_gk_maxwellian_moments_from_moms_advance(up, conf_range, up->moms, moms_out);
+}
+
+void 
+gkyl_gk_bimaxwellian_moments_from_moms_advance(struct gkyl_gk_maxwellian_moments *up, 
+  const struct gkyl_range *conf_range, const struct gkyl_array *moms_in,
+  struct gkyl_array *moms_out)
+{
+  int num_conf_basis = up->num_conf_basis;
+
+  // Separate J*M0 and J*M1 where J is the configurations-space Jacobian
+  gkyl_array_set_offset_range(up->M0, 1.0, moms_in, 0*num_conf_basis, conf_range);
+  gkyl_array_set_offset_range(up->M1, 1.0, moms_in, 1*num_conf_basis, conf_range);
 
   // Isolate u_par by dividing J*M1 by J*M0
   gkyl_dg_div_op_range(up->mem, up->conf_basis, 
@@ -165,16 +172,14 @@ gkyl_gk_bimaxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up,
   gkyl_dg_mul_op_range(up->conf_basis, 
     0, up->u_par_dot_M1, 0, up->u_par, 0, up->M1, conf_range); 
 
-  // Compute J*M2_par = J*n*T_par/m + J*M1*upar.
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M2_par_calc, phase_range, conf_range, 
-    fin, up->p_par);
+  // J*M2_par = J*n*T_par/m + J*M1*upar.
+  gkyl_array_set_offset_range(up->p_par, 1.0, moms_in, 2*num_conf_basis, conf_range);
   // Subtract off J*M1*upar from total J*M2_par
   gkyl_array_accumulate_range(up->p_par, -1.0, 
     up->u_par_dot_M1, conf_range); 
 
-  // Compute J*M2_perp = 2*J*n*T_perp/m.
-  gkyl_dg_updater_moment_gyrokinetic_advance(up->M2_perp_calc, phase_range, conf_range, 
-    fin, up->p_perp);
+  // J*M2_perp = 2*J*n*T_perp/m.
+  gkyl_array_set_offset_range(up->p_perp, 1.0, moms_in, 3*num_conf_basis, conf_range);
 
   // Rescale J*n*T_perp by 1/2 and divide out J*M0 to get T_par/m, T_perp/m
   // from n*T_par/m, n*T_perp/m.
@@ -193,12 +198,22 @@ gkyl_gk_bimaxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up,
     gkyl_array_set_range(moms_out, 1.0, up->M0, conf_range);
   }
   // Save the other outputs to moms_out (n, u_par, T_par/m, T_perp/m):
-  int num_conf_basis = up->num_conf_basis;
   gkyl_array_set_offset_range(moms_out, 1.0, up->u_par, 1*num_conf_basis, conf_range);
   gkyl_array_set_offset_range(moms_out, 1.0, up->t_par, 2*num_conf_basis, conf_range);
   gkyl_array_set_offset_range(moms_out, 1.0, up->t_perp, 3*num_conf_basis, conf_range);
 }
 
+void 
+gkyl_gk_bimaxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up, 
+  const struct gkyl_range *phase_range, const struct gkyl_range *conf_range, 
+  const struct gkyl_array *fin, struct gkyl_array *moms_out)
+{
+  // Compute J*(M0, M1, M2par, M2perp) in a single sweep over fin.
+  gkyl_dg_updater_moment_gyrokinetic_advance(up->moms_calc, phase_range, conf_range, 
+    fin, up->moms);
+  gkyl_gk_bimaxwellian_moments_from_moms_advance(up, conf_range, up->moms, moms_out);
+}
+
 void 
 gkyl_gk_maxwellian_moments_release(gkyl_gk_maxwellian_moments *up)
 {
@@ -211,16 +226,14 @@ gkyl_gk_maxwellian_moments_release(gkyl_gk_maxwellian_moments *up)
   gkyl_array_release(up->temperature);
   gkyl_dg_bin_op_mem_release(up->mem);
 
+  gkyl_array_release(up->moms);
   gkyl_dg_updater_moment_gyrokinetic_release(up->M0_calc);
-  gkyl_dg_updater_moment_gyrokinetic_release(up->M1_calc);
-  gkyl_dg_updater_moment_gyrokinetic_release(up->M2_calc);
+  gkyl_dg_updater_moment_gyrokinetic_release(up->moms_calc);
   if (up->vdim_phys == 3) {
     gkyl_array_release(up->p_par);
     gkyl_array_release(up->t_par);
     gkyl_array_release(up->p_perp);
     gkyl_array_release(up->t_perp);
-    gkyl_dg_updater_moment_gyrokinetic_release(up->M2_par_calc);
-    gkyl_dg_updater_moment_gyrokinetic_release(up->M2_perp_calc);
   }
 
   gkyl_free(up);
@@ -48,6 +48,15 @@ struct gkyl_bc_sheath_gyrokinetic {
   struct gkyl_bc_sheath_gyrokinetic_kernels *kernels_cu;  // device copy.
   const struct gkyl_range *skin_r, *ghost_r; // Skin and ghost ranges.
   const struct gkyl_velocity_map *vel_map; // Velocity space mapping.
+
+  // CPU-only data used to skip the reflectedf kernel in cells that are
+  // absorbed entirely, i.e. where vpar^2 > vcut^2 at all surface nodes.
+  struct gkyl_basis cbasis; // Conf-space basis.
+  int num_surf_nodes; // Number of nodes on the sheath surface.
+  double *surf_nodes; // Logical coords of the nodes on the sheath surface.
+  struct gkyl_range conf_skin_r; // Conf-space part of the skin range.
+  struct gkyl_range vel_skin_r; // Velocity-space part of the skin range.
+  double *vpar_abs_sq_lo; // Smallest vpar^2 in each cell of vel_skin_r.
 };
 
 void
@@ -5,6 +5,8 @@
 #include <gkyl_array.h>
 #include <gkyl_rect_grid.h>
 #include <gkyl_evalf_def.h>
+#include <gkyl_comm.h>
+#include <gkyl_rect_decomp.h>
 #include <assert.h>
 
 // Object type
@@ -25,6 +27,11 @@ struct gkyl_bc_twistshift_inp {
   bool use_gpu; // Whether to apply the BC using the GPU.
   // Optional inputs:
   int shift_poly_order; // Basis order for the DG representation of the shift.
+  // For fields decomposed along shift_dir, the communicator (of the shifted
+  // field) and the configuration-space decomposition. Donors owned by other
+  // ranks are then gathered with one message per partner rank.
+  struct gkyl_comm *comm;
+  const struct gkyl_rect_decomp *decomp;
 };
 
 /**
@@ -37,7 +44,9 @@ struct gkyl_bc_twistshift* gkyl_bc_twistshift_new(const struct gkyl_bc_twistshif
  
 /**
  * Apply the twist-shift. It assumes that periodicity along bc_dir has been
- * applied to the donor field. Can be used in-place.
+ * applied to the donor field. Can be used in-place. If the field is
+ * decomposed along shift_dir (comm and decomp given at construction) this
+ * must be called by all ranks on the same bc_dir plane.
  *
  * @param up Twist-shift BC updater object.
  * @param fdo Donor field.
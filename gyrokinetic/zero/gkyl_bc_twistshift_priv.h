@@ -8,6 +8,7 @@
 #include <gkyl_mat.h>
 #include <gkyl_math.h>
 #include <gkyl_eval_on_nodes.h>
+#include <gkyl_multib_comm_conn.h>
 #include <string.h> // memcpy
 
 // Function pointer type for twistshift kernels.
@@ -73,7 +74,7 @@ struct gkyl_bc_twistshift {
   bool use_gpu; // Whether to apply the BC on the GPU.
 
   struct gkyl_rect_grid shift_grid; // 1D grid in the direction of the shift.
-  struct gkyl_range shift_r; // 1D range in the direction of the shift.
+  struct gkyl_range shift_r; // 1D global range in the direction of the shift.
 
   struct gkyl_rect_grid shear_grid; // 1D grid in the direction of the shear.
   struct gkyl_range shear_r; // 1D range in the direction of the shear.
@@ -114,6 +115,34 @@ struct gkyl_bc_twistshift {
   struct gkyl_range permutted_ghost_r; // Ghost range to populate in the target
                                        // field, with some dimensions permutted.
   struct gkyl_range ghost_r; // Ghost range this BC fills.
+
+  // CPU-only data. The BC is applied as a block-sparse mat-vec per target cell,
+  // gathering donors directly from fdo (or from a copy of the donor line if
+  // applied in-place) and writing the result directly into ftar.
+  long num_lines; // Number of lines along shift_dir in the plane filled by the BC.
+  long *line_loc; // Linear index (in fdo/ftar) of the first cell of each line.
+  int *line_shear_idx; // 0-based shear_dir index of each line.
+  long shift_dir_stride; // Linear index stride along shift_dir.
+  int *do_off; // 0-based shift_dir index of each donor (same layout as shift_dir_idx_do).
+  double *line_buff; // Buffer holding a copy of the donor line (in-place use).
+  bool clear_ghost_inner; // =true if there are ghost layers this BC doesn't fill.
+  struct gkyl_range ghost_inner_r; // Ghost layers this BC doesn't fill.
+
+  // Data used when the field is decomposed along shift_dir (CPU only). The
+  // local donors and those received from other ranks are placed in fdo_ext,
+  // defined on the bc_dir plane but spanning the global shift_dir range.
+  bool is_distributed; // =true if the field is decomposed along shift_dir.
+  struct gkyl_comm *comm; // Communicator.
+  int shift_tar_off; // Offset of the local shift_dir range from the global one.
+  int num_shift_tar; // Number of local cells along shift_dir.
+  struct gkyl_range donor_r; // Range fdo_ext is defined on.
+  struct gkyl_range local_donor_r; // Local part of donor_r.
+  struct gkyl_range local_plane_r; // Local part of the plane in the donor field.
+  struct gkyl_array *fdo_ext; // Local and remote donors.
+  long *line_ext_loc; // Linear index (in fdo_ext) of the first cell of each line.
+  long ext_shift_dir_stride; // Linear index stride along shift_dir in fdo_ext.
+  struct gkyl_multib_comm_conn *mbcc_send; // Donors other ranks need from us.
+  struct gkyl_multib_comm_conn *mbcc_recv; // Donors we need from other ranks.
 };
 
 #ifdef GKYL_HAVE_CUDA
@@ -33,6 +33,7 @@ struct gkyl_dg_iz {
   struct gkyl_basis *pbasis;
 
   struct gkyl_array *ioniz_data;
+  struct gkyl_rate_table *rate_tab; // ADAS rate table (possibly shared).
   struct gkyl_range adas_rng;
   struct gkyl_basis adas_basis;
   struct gkyl_basis *basis_on_dev;
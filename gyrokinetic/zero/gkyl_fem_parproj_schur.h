@@ -0,0 +1,120 @@
+#pragma once
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_range.h>
+
+// Object type
+typedef struct gkyl_fem_parproj_schur gkyl_fem_parproj_schur;
+
+// Input to create a new substructured parallel projection updater.
+struct gkyl_fem_parproj_schur_inp {
+  const struct gkyl_range *local_range; // Cells of this piece of the chain.
+  const struct gkyl_basis *basis; // Basis functions of the DG field (p=1).
+  int piece; // Index of this piece along the chain.
+  int num_pieces; // Number of pieces in the chain.
+  bool is_periodic; // Whether the chain is periodic along the parallel direction.
+  // Optional weights on the left and right side of the operator
+  // (time-independent, defined over local_range).
+  const struct gkyl_array *weight_left, *weight_right;
+};
+
+/**
+ * Create new updater to solve the same problem as gkyl_fem_parproj,
+ *    wgtL*phi_{fem} \doteq wgtR*rho_{dg},
+ * with p=1 FEM basis functions on a chain of pieces along the parallel
+ * (last) direction, each piece handled by one updater that only has
+ * the data in its local range. The nodes shared by neighboring pieces
+ * (interfaces) are solved for with the Schur complement of the
+ * interior nodes. Only the Schur complement (once) and the residuals
+ * on the interfaces (every solve) of each piece, stored as one record
+ * per perpendicular cell, need to be exchanged between the pieces.
+ * A solve is then:
+ *   gkyl_fem_parproj_schur_set_rhs -> gather residuals of all pieces
+ *   -> gkyl_fem_parproj_schur_solve.
+ * The interfaces of the chain must have been set with
+ * gkyl_fem_parproj_schur_set_schur first.
+ *
+ * A chain with a single non-periodic piece is solved directly, and
+ * needs no exchange.
+ *
+ * @param inp Input parameters.
+ * @return New updater pointer.
+ */
+struct gkyl_fem_parproj_schur* gkyl_fem_parproj_schur_new(
+  const struct gkyl_fem_parproj_schur_inp *inp);
+
+/**
+ * Number of components of the Schur complement record of a piece.
+ *
+ * @param up Updater.
+ * @return Number of components.
+ */
+int gkyl_fem_parproj_schur_schur_ncomp(const struct gkyl_fem_parproj_schur *up);
+
+/**
+ * Number of components of the residual record of a piece.
+ *
+ * @param up Updater.
+ * @return Number of components.
+ */
+int gkyl_fem_parproj_schur_resid_ncomp(const struct gkyl_fem_parproj_schur *up);
+
+/**
+ * Write the Schur complement of the interior nodes of this piece. The
+ * record of a perpendicular cell is written to the cell of @a
+ * iface_range with the same perpendicular index and lower parallel
+ * index of @a iface_range.
+ *
+ * @param up Updater.
+ * @param iface_range Range to write the records into.
+ * @param schur Output Schur complement records.
+ */
+void gkyl_fem_parproj_schur_get_schur(const struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *iface_range, struct gkyl_array *schur);
+
+/**
+ * Assemble and invert the interface system of the chain from the
+ * Schur complement records of all pieces. The record of piece q is in
+ * the cell of @a chain_range with parallel index
+ * chain_range->lower[dir]+q.
+ *
+ * @param up Updater.
+ * @param chain_range Range of the records of the chain.
+ * @param schur_chain Schur complement records of the chain.
+ */
+void gkyl_fem_parproj_schur_set_schur(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *chain_range, const struct gkyl_array *schur_chain);
+
+/**
+ * Assign the right-side vector with the discontinuous (DG) source
+ * field, and compute the residuals on the interfaces of this piece.
+ *
+ * @param up Updater.
+ * @param rhsin DG field to set as RHS source.
+ * @param iface_range Range to write the residual records into.
+ * @param resid Output residual records.
+ */
+void gkyl_fem_parproj_schur_set_rhs(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_array *rhsin, const struct gkyl_range *iface_range, struct gkyl_array *resid);
+
+/**
+ * Solve the linear problem given the residual records of all pieces
+ * (laid out as in gkyl_fem_parproj_schur_set_schur). @a phiout may be
+ * the same array as the source passed to set_rhs.
+ *
+ * @param up Updater.
+ * @param chain_range Range of the records of the chain.
+ * @param resid_chain Residual records of the chain.
+ * @param phiout Output continuous field.
+ */
+void gkyl_fem_parproj_schur_solve(struct gkyl_fem_parproj_schur *up,
+  const struct gkyl_range *chain_range, const struct gkyl_array *resid_chain,
+  struct gkyl_array *phiout);
+
+/**
+ * Delete updater.
+ *
+ * @param up Updater to delete.
+ */
+void gkyl_fem_parproj_schur_release(struct gkyl_fem_parproj_schur *up);
@@ -88,6 +88,35 @@ void gkyl_gk_bimaxwellian_moments_advance(struct gkyl_gk_maxwellian_moments *up,
   const struct gkyl_range *phase_local, const struct gkyl_range *conf_local, 
   const struct gkyl_array *fin, struct gkyl_array *moms_out);
 
+/**
+ * Compute the Maxwellian moments (n, u_par, T/m) from the velocity moments
+ * J*(M0, M1, M2par[, M2perp]) of a distribution function, e.g. those
+ * computed by a GKYL_F_MOMENT_M0M1M2PARM2PERP moment updater. This lets
+ * moments already computed for another purpose be reused without another
+ * sweep over the distribution function.
+ *
+ * @param up Maxwellian moments updater
+ * @param conf_local Configuration-space range on which to compute moments.
+ * @param moms_in Input velocity moments J*(M0, M1, M2par[, M2perp]).
+ * @param moms_out Output Maxwellian moments (n, u_par, T/m)
+ */
+void gkyl_gk_maxwellian_moments_from_moms_advance(struct gkyl_gk_maxwellian_moments *up, 
+  const struct gkyl_range *conf_local, const struct gkyl_array *moms_in,
+  struct gkyl_array *moms_out);
+
+/**
+ * Compute the Bi-Maxwellian moments (n, u_par, T_par/m, T_perp/m) from the
+ * velocity moments J*(M0, M1, M2par, M2perp) of a distribution function.
+ *
+ * @param up Maxwellian moments updater
+ * @param conf_local Configuration-space range on which to compute moments.
+ * @param moms_in Input velocity moments J*(M0, M1, M2par, M2perp).
+ * @param moms_out Output Bi-Maxwellian moments (n, u_par, T_par/m, T_perp/m)
+ */
+void gkyl_gk_bimaxwellian_moments_from_moms_advance(struct gkyl_gk_maxwellian_moments *up, 
+  const struct gkyl_range *conf_local, const struct gkyl_array *moms_in,
+  struct gkyl_array *moms_out);
+
 /**
  * Delete updater.
  *
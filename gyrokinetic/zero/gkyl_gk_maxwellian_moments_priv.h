@@ -17,6 +17,7 @@ struct gkyl_gk_maxwellian_moments
   bool divide_jacobgeo; // Boolean for if we are dividing out the configuration-space Jacobian from density
   double mass; // Species mass
   
+  struct gkyl_array *moms; // J*(M0, M1, M2par[, M2perp]) computed in a single sweep over f.
   struct gkyl_array *M0; 
   struct gkyl_array *M1;  
   struct gkyl_array *u_par;
@@ -30,8 +31,5 @@ struct gkyl_gk_maxwellian_moments
   struct gkyl_dg_bin_op_mem *mem;
 
   struct gkyl_dg_updater_moment *M0_calc; 
-  struct gkyl_dg_updater_moment *M1_calc;
-  struct gkyl_dg_updater_moment *M2_calc;
-  struct gkyl_dg_updater_moment *M2_par_calc;
-  struct gkyl_dg_updater_moment *M2_perp_calc;
+  struct gkyl_dg_updater_moment *moms_calc; // Fused M0, M1, M2par and M2perp.
 };
@@ -639,7 +639,8 @@ block_uu_restriction_op(const int tbid, const int tdir, const int i, const int d
 }
 
 void
-euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_data bdata[], struct gkyl_array* fld[])
+euler_sync_block(const struct gkyl_block_topo* btopo, const struct euler_block_data bdata[], int tbid,
+  struct gkyl_array* bc_buffer, struct gkyl_array* fld[])
 {
   int num_blocks = btopo->num_blocks;
   int ndim = btopo->ndim;
@@ -648,12 +649,9 @@ euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_
     for (int d = 0; d < ndim; d++) {
       const struct gkyl_target_edge *te = btopo->conn[i].connections[d];
 
-      if (te[0].edge != GKYL_PHYSICAL) {
-        struct gkyl_array *bc_buffer = bdata[i].bc_buffer;
-
+      if ((te[0].edge != GKYL_PHYSICAL) && (te[0].bid == tbid)) {
         gkyl_array_copy_to_buffer(bc_buffer->data, fld[i], &(bdata[i].skin_ghost.lower_skin[d]));
 
-        int tbid = te[0].bid;
         int tdir = te[0].dir;
 
         if (te[0].edge == GKYL_LOWER_POSITIVE) {
@@ -680,12 +678,9 @@ euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_
         }
       }
 
-      if (te[1].edge != GKYL_PHYSICAL) {
-        struct gkyl_array *bc_buffer = bdata[i].bc_buffer;
-
+      if ((te[1].edge != GKYL_PHYSICAL) && (te[1].bid == tbid)) {
         gkyl_array_copy_to_buffer(bc_buffer->data, fld[i], &(bdata[i].skin_ghost.upper_skin[d]));
 
-        int tbid = te[1].bid;
         int tdir = te[1].dir;
 
         if (te[1].edge == GKYL_LOWER_POSITIVE) {
@@ -715,6 +710,50 @@ euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_
   }
 }
 
+void
+euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_data bdata[], struct gkyl_array* fld[])
+{
+  int num_blocks = btopo->num_blocks;
+
+  // Blocks are synchronized one after another, so the largest buffer can be shared.
+  struct gkyl_array *bc_buffer = bdata[0].bc_buffer;
+  for (int i = 1; i < num_blocks; i++) {
+    if (bdata[i].bc_buffer->size > bc_buffer->size) {
+      bc_buffer = bdata[i].bc_buffer;
+    }
+  }
+
+  for (int i = 0; i < num_blocks; i++) {
+    euler_sync_block(btopo, bdata, i, bc_buffer, fld);
+  }
+}
+
+int
+block_sync_sources(const struct gkyl_block_topo* btopo, int tbid, int* srcs)
+{
+  int num_srcs = 0;
+
+  for (int i = 0; i < btopo->num_blocks; i++) {
+    bool is_src = false;
+
+    for (int d = 0; d < btopo->ndim; d++) {
+      for (int e = 0; e < 2; e++) {
+        const struct gkyl_target_edge *te = &btopo->conn[i].connections[d][e];
+
+        if ((te->edge != GKYL_PHYSICAL) && (te->bid == tbid)) {
+          is_src = true;
+        }
+      }
+    }
+
+    if (is_src) {
+      srcs[num_srcs++] = i;
+    }
+  }
+
+  return num_srcs;
+}
+
 void
 euler_block_data_write(const char* file_nm, const struct euler_block_data* bdata)
 {
@@ -748,6 +787,14 @@ euler_update_block_job_func(void* ctx)
   euler_block_bc_updaters_apply(bdata, t_curr, bdata->f[d + 1]);
 }
 
+void
+euler_sync_block_job_func(void* ctx)
+{
+  struct euler_sync_block_ctx *sb_ctx = ctx;
+
+  euler_sync_block(sb_ctx->btopo, sb_ctx->bdata, sb_ctx->bidx, sb_ctx->bc_buffer, sb_ctx->fld);
+}
+
 struct gkyl_update_status
 euler_update_all_blocks(const struct gkyl_job_pool* job_pool, const struct gkyl_block_topo* btopo,
   const struct euler_block_data bdata[], double t_curr, double dt)
@@ -757,45 +804,93 @@ euler_update_all_blocks(const struct gkyl_job_pool* job_pool, const struct gkyl_
 
   double dt_suggested = DBL_MAX;
 
+  struct euler_update_block_ctx euler_block_ctx[ndim][num_blocks];
+  struct gkyl_array *fld[ndim][num_blocks];
+
   for (int d = 0; d < ndim; d++) {
-    struct euler_update_block_ctx euler_block_ctx[num_blocks];
-    
     for (int i = 0; i < num_blocks; i++) {
-      euler_block_ctx[i] = (struct euler_update_block_ctx) {
+      euler_block_ctx[d][i] = (struct euler_update_block_ctx) {
         .bdata = &bdata[i],
         .t_curr = t_curr,
         .dir = d,
         .dt = dt,
         .bidx = i,
       };
+      fld[d][i] = bdata[i].f[d + 1];
     }
+  }
 
 #ifdef AMR_USETHREADS
+  // Each block starts its update in a direction as soon as its own ghost cells from the previous direction have been
+  // filled, and its ghost cells are filled as soon as the blocks it is connected to have been updated.
+  struct euler_sync_block_ctx euler_sync_ctx[ndim][num_blocks];
+  struct gkyl_array *sync_buffer[num_blocks];
+
+  long buff_sz = 0;
+  for (int i = 0; i < num_blocks; i++) {
+    buff_sz = GKYL_MAX2(buff_sz, bdata[i].bc_buffer->size);
+  }
+  for (int i = 0; i < num_blocks; i++) {
+    sync_buffer[i] = gkyl_array_new(GKYL_DOUBLE, bdata[i].bc_buffer->ncomp, buff_sz);
+  }
+
+  gkyl_task_graph *tg = gkyl_task_graph_new();
+  int update_id[num_blocks], sync_id[num_blocks];
+
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      gkyl_job_pool_add_work(job_pool, euler_update_block_job_func, &euler_block_ctx[i]);
+      update_id[i] = gkyl_task_graph_add(tg, euler_update_block_job_func, &euler_block_ctx[d][i],
+        d > 0 ? 1 : 0, d > 0 ? &sync_id[i] : 0);
+    }
+
+    for (int i = 0; i < num_blocks; i++) {
+      euler_sync_ctx[d][i] = (struct euler_sync_block_ctx) {
+        .btopo = btopo,
+        .bdata = bdata,
+        .bidx = i,
+        .bc_buffer = sync_buffer[i],
+        .fld = fld[d],
+      };
+
+      int srcs[num_blocks], deps[num_blocks + 1];
+      int num_srcs = block_sync_sources(btopo, i, srcs);
+
+      deps[0] = update_id[i];
+      for (int k = 0; k < num_srcs; k++) {
+        deps[k + 1] = update_id[srcs[k]];
+      }
+
+      sync_id[i] = gkyl_task_graph_add(tg, euler_sync_block_job_func, &euler_sync_ctx[d][i], num_srcs + 1, deps);
     }
-    gkyl_job_pool_wait(job_pool);
+  }
+
+  gkyl_task_graph_run(tg, job_pool);
+
+  gkyl_task_graph_release(tg);
+  for (int i = 0; i < num_blocks; i++) {
+    gkyl_array_release(sync_buffer[i]);
+  }
 #else
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      euler_update_block_job_func(&euler_block_ctx[i]);
+      euler_update_block_job_func(&euler_block_ctx[d][i]);
     }
-#endif
 
-    struct gkyl_array *fld[num_blocks];
+    euler_sync_blocks(btopo, bdata, fld[d]);
+  }
+#endif
 
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      if (euler_block_ctx[i].stat.success == false) {
+      if (euler_block_ctx[d][i].stat.success == false) {
         return (struct gkyl_update_status) {
           .success = false,
-          .dt_suggested = euler_block_ctx[i].stat.dt_suggested,
+          .dt_suggested = euler_block_ctx[d][i].stat.dt_suggested,
         };
       }
 
-      dt_suggested = fmin(dt_suggested, euler_block_ctx[i].stat.dt_suggested);
-      fld[i] = bdata[i].f[d + 1];
+      dt_suggested = fmin(dt_suggested, euler_block_ctx[d][i].stat.dt_suggested);
     }
-
-    euler_sync_blocks(btopo, bdata, fld);
   }
 
   return (struct gkyl_update_status) {
@@ -698,7 +698,8 @@ block_coupled_uu_restriction_op(const int tbid, const int tdir, const int i, con
 }
 
 void
-five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_moment_block_data bdata[],
+five_moment_sync_block(const struct gkyl_block_topo* btopo, const struct five_moment_block_data bdata[], int tbid,
+  struct gkyl_array* bc_buffer_elc, struct gkyl_array* bc_buffer_ion, struct gkyl_array* bc_buffer_maxwell,
   struct gkyl_array* fld_elc[], struct gkyl_array* fld_ion[], struct gkyl_array* fld_maxwell[])
 {
   int num_blocks = btopo->num_blocks;
@@ -708,16 +709,11 @@ five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_m
     for (int d = 0; d < ndim; d++) {
       const struct gkyl_target_edge *te = btopo->conn[i].connections[d];
 
-      if (te[0].edge != GKYL_PHYSICAL) {
-        struct gkyl_array *bc_buffer_elc = bdata[i].bc_buffer_elc;
-        struct gkyl_array *bc_buffer_ion = bdata[i].bc_buffer_ion;
-        struct gkyl_array *bc_buffer_maxwell = bdata[i].bc_buffer_maxwell;
-
+      if ((te[0].edge != GKYL_PHYSICAL) && (te[0].bid == tbid)) {
         gkyl_array_copy_to_buffer(bc_buffer_elc->data, fld_elc[i], &(bdata[i].skin_ghost.lower_skin[d]));
         gkyl_array_copy_to_buffer(bc_buffer_ion->data, fld_ion[i], &(bdata[i].skin_ghost.lower_skin[d]));
         gkyl_array_copy_to_buffer(bc_buffer_maxwell->data, fld_maxwell[i], &(bdata[i].skin_ghost.lower_skin[d]));
 
-        int tbid = te[0].bid;
         int tdir = te[0].dir;
 
         if (te[0].edge == GKYL_LOWER_POSITIVE) {
@@ -752,16 +748,11 @@ five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_m
         }
       }
 
-      if (te[1].edge != GKYL_PHYSICAL) {
-        struct gkyl_array *bc_buffer_elc = bdata[i].bc_buffer_elc;
-        struct gkyl_array *bc_buffer_ion = bdata[i].bc_buffer_ion;
-        struct gkyl_array *bc_buffer_maxwell = bdata[i].bc_buffer_maxwell;
-
+      if ((te[1].edge != GKYL_PHYSICAL) && (te[1].bid == tbid)) {
         gkyl_array_copy_to_buffer(bc_buffer_elc->data, fld_elc[i], &(bdata[i].skin_ghost.upper_skin[d]));
         gkyl_array_copy_to_buffer(bc_buffer_ion->data, fld_ion[i], &(bdata[i].skin_ghost.upper_skin[d]));
         gkyl_array_copy_to_buffer(bc_buffer_maxwell->data, fld_maxwell[i], &(bdata[i].skin_ghost.upper_skin[d]));
 
-        int tbid = te[1].bid;
         int tdir = te[1].dir;
 
         if (te[1].edge == GKYL_LOWER_POSITIVE) {
@@ -799,6 +790,26 @@ five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_m
   }
 }
 
+void
+five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_moment_block_data bdata[],
+  struct gkyl_array* fld_elc[], struct gkyl_array* fld_ion[], struct gkyl_array* fld_maxwell[])
+{
+  int num_blocks = btopo->num_blocks;
+
+  // Blocks are synchronized one after another, so the largest buffers can be shared.
+  int bmax = 0;
+  for (int i = 1; i < num_blocks; i++) {
+    if (bdata[i].bc_buffer_elc->size > bdata[bmax].bc_buffer_elc->size) {
+      bmax = i;
+    }
+  }
+
+  for (int i = 0; i < num_blocks; i++) {
+    five_moment_sync_block(btopo, bdata, i, bdata[bmax].bc_buffer_elc, bdata[bmax].bc_buffer_ion, bdata[bmax].bc_buffer_maxwell,
+      fld_elc, fld_ion, fld_maxwell);
+  }
+}
+
 void
 five_moment_block_data_write(const char* file_nm_elc, const char* file_nm_ion, const char* file_nm_maxwell, const struct five_moment_block_data* bdata)
 {
@@ -871,6 +882,52 @@ five_moment_update_block_job_func_source(void* ctx)
   five_moment_block_bc_updaters_apply(bdata, t_curr, bdata->f_elc[nstrang], bdata->f_ion[nstrang], bdata->f_maxwell[nstrang]);
 }
 
+void
+five_moment_sync_block_job_func(void* ctx)
+{
+  struct five_moment_sync_block_ctx *sb_ctx = ctx;
+
+  five_moment_sync_block(sb_ctx->btopo, sb_ctx->bdata, sb_ctx->bidx, sb_ctx->bc_buffer_elc, sb_ctx->bc_buffer_ion,
+    sb_ctx->bc_buffer_maxwell, sb_ctx->fld_elc, sb_ctx->fld_ion, sb_ctx->fld_maxwell);
+}
+
+#ifdef AMR_USETHREADS
+// Allocate one set of inter-block copy buffers per block, each large enough for a copy from any other block.
+static void
+five_moment_sync_buffers_new(int num_blocks, const struct five_moment_block_data bdata[], struct gkyl_array* buff_elc[],
+  struct gkyl_array* buff_ion[], struct gkyl_array* buff_maxwell[])
+{
+  long buff_sz = 0;
+  for (int i = 0; i < num_blocks; i++) {
+    buff_sz = GKYL_MAX2(buff_sz, bdata[i].bc_buffer_elc->size);
+  }
+
+  for (int i = 0; i < num_blocks; i++) {
+    buff_elc[i] = gkyl_array_new(GKYL_DOUBLE, bdata[i].bc_buffer_elc->ncomp, buff_sz);
+    buff_ion[i] = gkyl_array_new(GKYL_DOUBLE, bdata[i].bc_buffer_ion->ncomp, buff_sz);
+    buff_maxwell[i] = gkyl_array_new(GKYL_DOUBLE, bdata[i].bc_buffer_maxwell->ncomp, buff_sz);
+  }
+}
+
+// Add a task to the graph that fills the ghost cells of block tbid, once the tasks in stage_id that produce the block and
+// all of its neighbours have finished.
+static int
+five_moment_sync_block_task_add(gkyl_task_graph* tg, const struct gkyl_block_topo* btopo, int tbid, const int* stage_id,
+  struct five_moment_sync_block_ctx* sync_ctx)
+{
+  int num_blocks = btopo->num_blocks;
+  int srcs[num_blocks], deps[num_blocks + 1];
+  int num_srcs = block_sync_sources(btopo, tbid, srcs);
+
+  deps[0] = stage_id[tbid];
+  for (int k = 0; k < num_srcs; k++) {
+    deps[k + 1] = stage_id[srcs[k]];
+  }
+
+  return gkyl_task_graph_add(tg, five_moment_sync_block_job_func, sync_ctx, num_srcs + 1, deps);
+}
+#endif
+
 struct gkyl_update_status
 five_moment_update_all_blocks(const struct gkyl_job_pool* job_pool, const struct gkyl_block_topo* btopo,
   const struct five_moment_block_data bdata[], double t_curr, double dt)
@@ -880,11 +937,14 @@ five_moment_update_all_blocks(const struct gkyl_job_pool* job_pool, const struct
 
   double dt_suggested = DBL_MAX;
 
-  for (int d = 0; d < ndim; d++) {
-    struct five_moment_update_block_ctx five_moment_block_ctx[num_blocks];
+  struct five_moment_update_block_ctx five_moment_block_ctx[ndim][num_blocks];
+  struct gkyl_array *fld_elc[ndim][num_blocks];
+  struct gkyl_array *fld_ion[ndim][num_blocks];
+  struct gkyl_array *fld_maxwell[ndim][num_blocks];
 
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      five_moment_block_ctx[i] = (struct five_moment_update_block_ctx) {
+      five_moment_block_ctx[d][i] = (struct five_moment_update_block_ctx) {
         .bdata = &bdata[i],
         .t_curr = t_curr,
         .dir = d,
@@ -892,45 +952,79 @@ five_moment_update_all_blocks(const struct gkyl_job_pool* job_pool, const struct
         .bidx = i,
         .nstrang = 0,
       };
+
+      fld_elc[d][i] = bdata[i].f_elc[d + 1];
+      fld_ion[d][i] = bdata[i].f_ion[d + 1];
+      fld_maxwell[d][i] = bdata[i].f_maxwell[d + 1];
     }
+  }
 
 #ifdef AMR_USETHREADS
+  // Each block starts its update in a direction as soon as its own ghost cells from the previous direction have been
+  // filled, and its ghost cells are filled as soon as the blocks it is connected to have been updated.
+  struct five_moment_sync_block_ctx five_moment_sync_ctx[ndim][num_blocks];
+  struct gkyl_array *buff_elc[num_blocks], *buff_ion[num_blocks], *buff_maxwell[num_blocks];
+  five_moment_sync_buffers_new(num_blocks, bdata, buff_elc, buff_ion, buff_maxwell);
+
+  gkyl_task_graph *tg = gkyl_task_graph_new();
+  int update_id[num_blocks], sync_id[num_blocks];
+
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      gkyl_job_pool_add_work(job_pool, five_moment_update_block_job_func, &five_moment_block_ctx[i]);
+      update_id[i] = gkyl_task_graph_add(tg, five_moment_update_block_job_func, &five_moment_block_ctx[d][i],
+        d > 0 ? 1 : 0, d > 0 ? &sync_id[i] : 0);
     }
-    gkyl_job_pool_wait(job_pool);
+
+    for (int i = 0; i < num_blocks; i++) {
+      five_moment_sync_ctx[d][i] = (struct five_moment_sync_block_ctx) {
+        .btopo = btopo,
+        .bdata = bdata,
+        .bidx = i,
+        .bc_buffer_elc = buff_elc[i],
+        .bc_buffer_ion = buff_ion[i],
+        .bc_buffer_maxwell = buff_maxwell[i],
+        .fld_elc = fld_elc[d],
+        .fld_ion = fld_ion[d],
+        .fld_maxwell = fld_maxwell[d],
+      };
+
+      sync_id[i] = five_moment_sync_block_task_add(tg, btopo, i, update_id, &five_moment_sync_ctx[d][i]);
+    }
+  }
+
+  gkyl_task_graph_run(tg, job_pool);
+
+  gkyl_task_graph_release(tg);
+  for (int i = 0; i < num_blocks; i++) {
+    gkyl_array_release(buff_elc[i]);
+    gkyl_array_release(buff_ion[i]);
+    gkyl_array_release(buff_maxwell[i]);
+  }
 #else
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      five_moment_update_block_job_func(&five_moment_block_ctx[i]);
+      five_moment_update_block_job_func(&five_moment_block_ctx[d][i]);
     }
-#endif
 
-    struct gkyl_array *fld_elc[num_blocks];
-    struct gkyl_array *fld_ion[num_blocks];
-    struct gkyl_array *fld_maxwell[num_blocks];
+    five_moment_sync_blocks(btopo, bdata, fld_elc[d], fld_ion[d], fld_maxwell[d]);
+  }
+#endif
 
+  for (int d = 0; d < ndim; d++) {
     for (int i = 0; i < num_blocks; i++) {
-      if (five_moment_block_ctx[i].stat_elc.success == false || five_moment_block_ctx[i].stat_ion.success == false || five_moment_block_ctx[i].stat_maxwell.success == false) {
-        dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_elc.dt_suggested);
-        dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_ion.dt_suggested);
-        dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_maxwell.dt_suggested);
+      const struct five_moment_update_block_ctx *ctx = &five_moment_block_ctx[d][i];
 
+      dt_suggested = fmin(dt_suggested, ctx->stat_elc.dt_suggested);
+      dt_suggested = fmin(dt_suggested, ctx->stat_ion.dt_suggested);
+      dt_suggested = fmin(dt_suggested, ctx->stat_maxwell.dt_suggested);
+
+      if (ctx->stat_elc.success == false || ctx->stat_ion.success == false || ctx->stat_maxwell.success == false) {
         return (struct gkyl_update_status) {
           .success = false,
           .dt_suggested = dt_suggested,
         };
       }
-
-      dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_elc.dt_suggested);
-      dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_ion.dt_suggested);
-      dt_suggested = fmin(dt_suggested, five_moment_block_ctx[i].stat_maxwell.dt_suggested);
-
-      fld_elc[i] = bdata[i].f_elc[d + 1];
-      fld_ion[i] = bdata[i].f_ion[d + 1];
-      fld_maxwell[i] = bdata[i].f_maxwell[d + 1];
     }
-
-    five_moment_sync_blocks(btopo, bdata, fld_elc, fld_ion, fld_maxwell);
   }
 
   return (struct gkyl_update_status) {
@@ -946,6 +1040,9 @@ five_moment_update_all_blocks_source(const struct gkyl_job_pool* job_pool, const
   int num_blocks = btopo->num_blocks;
 
   struct five_moment_update_block_ctx five_moment_block_ctx[num_blocks];
+  struct gkyl_array *fld_elc[num_blocks];
+  struct gkyl_array *fld_ion[num_blocks];
+  struct gkyl_array *fld_maxwell[num_blocks];
 
   for (int i = 0; i < num_blocks; i++) {
     five_moment_block_ctx[i] = (struct five_moment_update_block_ctx) {
@@ -956,30 +1053,56 @@ five_moment_update_all_blocks_source(const struct gkyl_job_pool* job_pool, const
       .bidx = i,
       .nstrang = nstrang,
     };
+
+    fld_elc[i] = bdata[i].f_elc[nstrang];
+    fld_ion[i] = bdata[i].f_ion[nstrang];
+    fld_maxwell[i] = bdata[i].f_maxwell[nstrang];
   }
 
 #ifdef AMR_USETHREADS
+  // The ghost cells of each block are filled as soon as the source update of the block and of its neighbours is done.
+  struct five_moment_sync_block_ctx five_moment_sync_ctx[num_blocks];
+  struct gkyl_array *buff_elc[num_blocks], *buff_ion[num_blocks], *buff_maxwell[num_blocks];
+  five_moment_sync_buffers_new(num_blocks, bdata, buff_elc, buff_ion, buff_maxwell);
+
+  gkyl_task_graph *tg = gkyl_task_graph_new();
+  int source_id[num_blocks];
+
   for (int i = 0; i < num_blocks; i++) {
-    gkyl_job_pool_add_work(job_pool, five_moment_update_block_job_func_source, &five_moment_block_ctx[i]);
+    source_id[i] = gkyl_task_graph_add(tg, five_moment_update_block_job_func_source, &five_moment_block_ctx[i], 0, 0);
   }
-  gkyl_job_pool_wait(job_pool);
-#else
+
   for (int i = 0; i < num_blocks; i++) {
-    five_moment_update_block_job_func_source(&five_moment_block_ctx[i]);
+    five_moment_sync_ctx[i] = (struct five_moment_sync_block_ctx) {
+      .btopo = btopo,
+      .bdata = bdata,
+      .bidx = i,
+      .bc_buffer_elc = buff_elc[i],
+      .bc_buffer_ion = buff_ion[i],
+      .bc_buffer_maxwell = buff_maxwell[i],
+      .fld_elc = fld_elc,
+      .fld_ion = fld_ion,
+      .fld_maxwell = fld_maxwell,
+    };
+
+    five_moment_sync_block_task_add(tg, btopo, i, source_id, &five_moment_sync_ctx[i]);
   }
-#endif
 
-  struct gkyl_array *fld_elc[num_blocks];
-  struct gkyl_array *fld_ion[num_blocks];
-  struct gkyl_array *fld_maxwell[num_blocks];
+  gkyl_task_graph_run(tg, job_pool);
 
+  gkyl_task_graph_release(tg);
   for (int i = 0; i < num_blocks; i++) {
-    fld_elc[i] = bdata[i].f_elc[nstrang];
-    fld_ion[i] = bdata[i].f_ion[nstrang];
-    fld_maxwell[i] = bdata[i].f_maxwell[nstrang];
+    gkyl_array_release(buff_elc[i]);
+    gkyl_array_release(buff_ion[i]);
+    gkyl_array_release(buff_maxwell[i]);
+  }
+#else
+  for (int i = 0; i < num_blocks; i++) {
+    five_moment_update_block_job_func_source(&five_moment_block_ctx[i]);
   }
 
   five_moment_sync_blocks(btopo, bdata, fld_elc, fld_ion, fld_maxwell);
+#endif
 }
 
 void
@@ -1,6 +1,7 @@
 #include <gkyl_amr_core.h>
 #include <gkyl_amr_block_priv.h>
 #include <gkyl_amr_block_coupled_priv.h>
+#include <gkyl_amr_dynamic_priv.h>
 #include <gkyl_amr_patch_priv.h>
 #include <gkyl_amr_patch_coupled_priv.h>
 
@@ -970,4 +971,96 @@ euler2d_run_double(int argc, char **argv, struct euler2d_double_init* init)
 
   gkyl_block_topo_release(btopo);
   gkyl_job_pool_release(mesh_job_pool);
-}
\ No newline at end of file
+}
+void
+euler1d_run_dynamic(int argc, char **argv, struct euler1d_dynamic_init* init)
+{
+  struct gkyl_app_args app_args = parse_app_args(argc, argv);
+
+  if (app_args.trace_mem) {
+    gkyl_cu_dev_mem_debug_set(true);
+    gkyl_mem_debug_set(true);
+  }
+
+  struct gkyl_wv_eqn *euler;
+  if (init->low_order_flux) {
+    struct gkyl_wv_euler_inp inp = {
+      .gas_gamma = init->gas_gamma,
+      .rp_type = WV_EULER_RP_HLL,
+      .use_gpu = false,
+    };
+    euler = gkyl_wv_euler_inew(&inp);
+  }
+  else {
+    euler = gkyl_wv_euler_new(init->gas_gamma, false);
+  }
+
+  struct amr_dyn_inp inp = {
+    .ndim = 1,
+    .lower = { init->x1 },
+    .upper = { init->x2 },
+    .base_cells = { init->base_Nx },
+    .max_levels = init->max_levels,
+    .ref_factor = init->ref_factor,
+    .eqn = euler,
+    .cfl_frac = init->cfl_frac,
+    .eval = init->eval,
+    .tag_comp = 0,
+    .tag_threshold = init->tag_threshold,
+    .tag_buffer = init->tag_buffer,
+    .cluster_efficiency = init->cluster_efficiency,
+    .regrid_steps = init->regrid_steps,
+  };
+
+  amr_dyn_run(&app_args, &inp, init->euler_output, init->t_end, init->num_frames, init->dt_failure_tol,
+    init->num_failures_max);
+
+  gkyl_wv_eqn_release(euler);
+}
+
+void
+euler2d_run_dynamic(int argc, char **argv, struct euler2d_dynamic_init* init)
+{
+  struct gkyl_app_args app_args = parse_app_args(argc, argv);
+
+  if (app_args.trace_mem) {
+    gkyl_cu_dev_mem_debug_set(true);
+    gkyl_mem_debug_set(true);
+  }
+
+  struct gkyl_wv_eqn *euler;
+  if (init->low_order_flux) {
+    struct gkyl_wv_euler_inp inp = {
+      .gas_gamma = init->gas_gamma,
+      .rp_type = WV_EULER_RP_HLL,
+      .use_gpu = false,
+    };
+    euler = gkyl_wv_euler_inew(&inp);
+  }
+  else {
+    euler = gkyl_wv_euler_new(init->gas_gamma, false);
+  }
+
+  struct amr_dyn_inp inp = {
+    .ndim = 2,
+    .lower = { init->x1, init->y1 },
+    .upper = { init->x2, init->y2 },
+    .base_cells = { init->base_Nx, init->base_Ny },
+    .max_levels = init->max_levels,
+    .ref_factor = init->ref_factor,
+    .eqn = euler,
+    .cfl_frac = init->cfl_frac,
+    .eval = init->eval,
+    .wall = { init->wall_x, init->wall_y },
+    .tag_comp = 0,
+    .tag_threshold = init->tag_threshold,
+    .tag_buffer = init->tag_buffer,
+    .cluster_efficiency = init->cluster_efficiency,
+    .regrid_steps = init->regrid_steps,
+  };
+
+  amr_dyn_run(&app_args, &inp, init->euler_output, init->t_end, init->num_frames, init->dt_failure_tol,
+    init->num_failures_max);
+
+  gkyl_wv_eqn_release(euler);
+}
@@ -1,6 +1,7 @@
 #include <gkyl_amr_core.h>
 #include <gkyl_amr_block_priv.h>
 #include <gkyl_amr_block_coupled_priv.h>
+#include <gkyl_amr_dynamic_priv.h>
 #include <gkyl_amr_patch_priv.h>
 #include <gkyl_amr_patch_coupled_priv.h>
 
@@ -1003,4 +1004,38 @@ ten_moment_2d_run_double(int argc, char **argv, struct ten_moment_2d_double_init
 
   gkyl_block_topo_release(btopo);
   gkyl_job_pool_release(mesh_job_pool);
-}
\ No newline at end of file
+}
+void
+ten_moment_1d_run_dynamic(int argc, char **argv, struct ten_moment_1d_dynamic_init* init)
+{
+  struct gkyl_app_args app_args = parse_app_args(argc, argv);
+
+  if (app_args.trace_mem) {
+    gkyl_cu_dev_mem_debug_set(true);
+    gkyl_mem_debug_set(true);
+  }
+
+  struct gkyl_wv_eqn *ten_moment = gkyl_wv_ten_moment_new(init->k0, false, false, 0, 0, false);
+
+  struct amr_dyn_inp inp = {
+    .ndim = 1,
+    .lower = { init->x1 },
+    .upper = { init->x2 },
+    .base_cells = { init->base_Nx },
+    .max_levels = init->max_levels,
+    .ref_factor = init->ref_factor,
+    .eqn = ten_moment,
+    .cfl_frac = init->cfl_frac,
+    .eval = init->eval,
+    .tag_comp = 0,
+    .tag_threshold = init->tag_threshold,
+    .tag_buffer = init->tag_buffer,
+    .cluster_efficiency = init->cluster_efficiency,
+    .regrid_steps = init->regrid_steps,
+  };
+
+  amr_dyn_run(&app_args, &inp, init->ten_moment_output, init->t_end, init->num_frames, init->dt_failure_tol,
+    init->num_failures_max);
+
+  gkyl_wv_eqn_release(ten_moment);
+}
@@ -0,0 +1,1010 @@
+#include <gkyl_amr_dynamic_priv.h>
+
+#include <limits.h>
+
+// Floor of a / b, for b > 0.
+static inline int
+floor_div(int a, int b)
+{
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Index of the coarse cell containing the fine cell with index i (cells on each level are numbered from 1).
+static inline int
+coarse_idx(int i, int ref_factor)
+{
+  return floor_div(i - 1, ref_factor) + 1;
+}
+
+static inline double
+minmod(double a, double b)
+{
+  if (a * b <= 0.0) {
+    return 0.0;
+  }
+  return fabs(a) < fabs(b) ? a : b;
+}
+
+static void
+amr_dyn_copy_bc(const struct gkyl_wv_eqn* eqn, double t, int nc, const double* GKYL_RESTRICT skin, double* GKYL_RESTRICT ghost, void* ctx)
+{
+  for (int i = 0; i < nc; i++) {
+    ghost[i] = skin[i];
+  }
+}
+
+// List of clusters of tagged cells.
+struct cluster_list {
+  int num;
+  int cap;
+  struct gkyl_range *boxes;
+};
+
+static void
+cluster_list_push(struct cluster_list* list, int ndim, const int* lower, const int* upper)
+{
+  if (list->num == list->cap) {
+    list->cap = list->cap == 0 ? 8 : 2 * list->cap;
+    list->boxes = gkyl_realloc(list->boxes, list->cap * sizeof(struct gkyl_range));
+  }
+  gkyl_range_init(&list->boxes[list->num++], ndim, lower, upper);
+}
+
+// Recursively split the region lower..upper of box until each piece has a fraction of tagged cells of at least
+// efficiency: split at holes in the signatures (number of tagged cells in each plane) first, then at the strongest
+// inflection point of the signatures, and otherwise bisect the longest direction.
+static void
+cluster_box(const struct gkyl_range* box, const char* tags, double efficiency, const int* lower, const int* upper,
+  struct cluster_list* list)
+{
+  int ndim = box->ndim;
+
+  struct gkyl_range sub;
+  gkyl_range_init(&sub, ndim, lower, upper);
+
+  int *sig[GKYL_MAX_CDIM];
+  int lo[GKYL_MAX_CDIM], up[GKYL_MAX_CDIM];
+  for (int d = 0; d < ndim; d++) {
+    sig[d] = gkyl_calloc(upper[d] - lower[d] + 1, sizeof(int));
+    lo[d] = upper[d];
+    up[d] = lower[d];
+  }
+
+  long count = 0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &sub);
+  while (gkyl_range_iter_next(&iter)) {
+    if (tags[gkyl_range_idx(box, iter.idx)]) {
+      count += 1;
+      for (int d = 0; d < ndim; d++) {
+        sig[d][iter.idx[d] - lower[d]] += 1;
+        lo[d] = GKYL_MIN2(lo[d], iter.idx[d]);
+        up[d] = GKYL_MAX2(up[d], iter.idx[d]);
+      }
+    }
+  }
+
+  if (count > 0) {
+    long vol = 1;
+    for (int d = 0; d < ndim; d++) {
+      vol *= up[d] - lo[d] + 1;
+    }
+
+    // The region is split into lo..split_idx-1 and split_idx..up along split_dir.
+    int split_dir = -1, split_idx = 0;
+
+    if (count < efficiency * vol) {
+      // Holes in the signatures, closest to the middle of the bounding box.
+      int best_dist = INT_MAX;
+      for (int d = 0; d < ndim; d++) {
+        for (int i = lo[d] + 1; i < up[d]; i++) {
+          int dist = abs(2 * i - (lo[d] + up[d]));
+          if ((sig[d][i - lower[d]] == 0) && (dist < best_dist)) {
+            best_dist = dist;
+            split_dir = d;
+            split_idx = i;
+          }
+        }
+      }
+
+      // Strongest sign change of the Laplacian of the signatures.
+      if (split_dir < 0) {
+        int best_delta = 0;
+        for (int d = 0; d < ndim; d++) {
+          const int *s = sig[d] - lower[d];
+          for (int i = lo[d] + 2; i < up[d]; i++) {
+            int lap_l = s[i - 2] - 2 * s[i - 1] + s[i];
+            int lap_r = s[i - 1] - 2 * s[i] + s[i + 1];
+            if ((lap_l * lap_r < 0) && (abs(lap_r - lap_l) > best_delta)) {
+              best_delta = abs(lap_r - lap_l);
+              split_dir = d;
+              split_idx = i;
+            }
+          }
+        }
+      }
+
+      // Bisect the longest direction.
+      if (split_dir < 0) {
+        int best_len = 1;
+        for (int d = 0; d < ndim; d++) {
+          if (up[d] - lo[d] + 1 > best_len) {
+            best_len = up[d] - lo[d] + 1;
+            split_dir = d;
+            split_idx = lo[d] + best_len / 2;
+          }
+        }
+      }
+    }
+
+    if (split_dir < 0) {
+      cluster_list_push(list, ndim, lo, up);
+    }
+    else {
+      int up_l[GKYL_MAX_CDIM], lo_r[GKYL_MAX_CDIM];
+      for (int d = 0; d < ndim; d++) {
+        up_l[d] = up[d];
+        lo_r[d] = lo[d];
+      }
+      up_l[split_dir] = split_idx - 1;
+      lo_r[split_dir] = split_idx;
+
+      cluster_box(box, tags, efficiency, lo, up_l, list);
+      cluster_box(box, tags, efficiency, lo_r, up, list);
+    }
+  }
+
+  for (int d = 0; d < ndim; d++) {
+    gkyl_free(sig[d]);
+  }
+}
+
+struct gkyl_range*
+amr_dyn_cluster(const struct gkyl_range* box, const char* tags, double efficiency, int* num_clusters)
+{
+  struct cluster_list list = { .num = 0, .cap = 0, .boxes = 0 };
+  cluster_box(box, tags, efficiency, box->lower, box->upper, &list);
+
+  *num_clusters = list.num;
+  return list.boxes;
+}
+
+static void
+amr_dyn_level_init(const struct amr_dyn_hierarchy* hier, int l, struct amr_dyn_level* lev)
+{
+  const struct amr_dyn_inp *inp = &hier->inp;
+
+  int cells[GKYL_MAX_CDIM];
+  for (int d = 0; d < inp->ndim; d++) {
+    cells[d] = inp->base_cells[d];
+    for (int i = 0; i < l; i++) {
+      cells[d] *= inp->ref_factor;
+    }
+  }
+  gkyl_rect_grid_init(&lev->grid, inp->ndim, inp->lower, inp->upper, cells);
+  lev->fv_proj = gkyl_fv_proj_new(&lev->grid, 2, inp->eqn->num_equations, inp->eval, inp->eval_ctx);
+
+  lev->num_patches = 0;
+  lev->patches = 0;
+  lev->t_old = lev->t_new = 0.0;
+}
+
+static void
+amr_dyn_patch_init(const struct amr_dyn_hierarchy* hier, const struct amr_dyn_level* lev, struct amr_dyn_patch* patch,
+  const struct gkyl_range* box, int parent)
+{
+  const struct amr_dyn_inp *inp = &hier->inp;
+  int ndim = inp->ndim;
+  int meqn = inp->eqn->num_equations;
+  int nghost[GKYL_MAX_CDIM] = { 2, 2, 2 };
+
+  patch->parent = parent;
+
+  gkyl_create_ranges(box, nghost, &patch->ext_range, &patch->range);
+  patch->geom = gkyl_wave_geom_new(&lev->grid, &patch->ext_range, 0, 0, false);
+
+  for (int d = 0; d < ndim + 1; d++) {
+    patch->f[d] = gkyl_array_new(GKYL_DOUBLE, meqn, patch->ext_range.volume);
+  }
+  patch->fold = gkyl_array_new(GKYL_DOUBLE, meqn, patch->ext_range.volume);
+  patch->fdup = gkyl_array_new(GKYL_DOUBLE, meqn, patch->ext_range.volume);
+
+  for (int d = 0; d < ndim; d++) {
+    patch->slvr[d] = gkyl_wave_prop_new(& (struct gkyl_wave_prop_inp) {
+        .grid = &lev->grid,
+        .equation = inp->eqn,
+        .limiter = GKYL_MONOTONIZED_CENTERED,
+        .num_up_dirs = 1,
+        .update_dirs = { d },
+        .cfl = inp->cfl_frac,
+        .geom = patch->geom,
+      }
+    );
+
+    // Physical boundary conditions are only needed on the patch edges lying on the domain boundary.
+    wv_bc_func_t bcfunc = inp->wall[d] ? inp->eqn->wall_bc_func : amr_dyn_copy_bc;
+
+    patch->lower_bc[d] = patch->upper_bc[d] = 0;
+
+    if (patch->range.lower[d] == 1) {
+      patch->lower_bc[d] = gkyl_wv_apply_bc_new(&lev->grid, inp->eqn, patch->geom, d, GKYL_LOWER_EDGE, nghost,
+        bcfunc, 0);
+    }
+
+    if (patch->range.upper[d] == lev->grid.cells[d]) {
+      patch->upper_bc[d] = gkyl_wv_apply_bc_new(&lev->grid, inp->eqn, patch->geom, d, GKYL_UPPER_EDGE, nghost,
+        bcfunc, 0);
+    }
+  }
+}
+
+static void
+amr_dyn_patch_release(int ndim, struct amr_dyn_patch* patch)
+{
+  for (int d = 0; d < ndim; d++) {
+    gkyl_wave_prop_release(patch->slvr[d]);
+
+    if (patch->lower_bc[d]) {
+      gkyl_wv_apply_bc_release(patch->lower_bc[d]);
+    }
+    if (patch->upper_bc[d]) {
+      gkyl_wv_apply_bc_release(patch->upper_bc[d]);
+    }
+  }
+
+  for (int d = 0; d < ndim + 1; d++) {
+    gkyl_array_release(patch->f[d]);
+  }
+  gkyl_array_release(patch->fold);
+  gkyl_array_release(patch->fdup);
+
+  gkyl_wave_geom_release(patch->geom);
+}
+
+static void
+amr_dyn_level_release(int ndim, struct amr_dyn_level* lev)
+{
+  for (int i = 0; i < lev->num_patches; i++) {
+    amr_dyn_patch_release(ndim, &lev->patches[i]);
+  }
+  gkyl_free(lev->patches);
+  gkyl_fv_proj_release(lev->fv_proj);
+}
+
+// Conservative, limited piecewise-linear prolongation of the solution on the parent patch pp (linearly interpolated
+// in time with weight alpha for the new solution) into the cell fidx of level l.
+static void
+prolong_cell(const struct amr_dyn_hierarchy* hier, int l, const struct amr_dyn_patch* pp, double alpha, const int* fidx,
+  double* out)
+{
+  int ndim = hier->inp.ndim;
+  int ref_factor = hier->inp.ref_factor;
+  int meqn = hier->inp.eqn->num_equations;
+  const int *coarse_cells = hier->levels[l - 1].grid.cells;
+
+  int cidx[GKYL_MAX_CDIM];
+  double offset[GKYL_MAX_CDIM]; // Offset of the fine cell center from the coarse cell center, in coarse cells.
+  for (int d = 0; d < ndim; d++) {
+    cidx[d] = coarse_idx(fidx[d], ref_factor);
+    offset[d] = ((fidx[d] - 1 - (cidx[d] - 1) * ref_factor) + 0.5) / ref_factor - 0.5;
+  }
+
+  long loc = gkyl_range_idx(&pp->ext_range, cidx);
+  const double *qc_old = gkyl_array_cfetch(pp->fold, loc);
+  const double *qc_new = gkyl_array_cfetch(pp->f[0], loc);
+
+  double qc[meqn];
+  for (int m = 0; m < meqn; m++) {
+    qc[m] = (1.0 - alpha) * qc_old[m] + alpha * qc_new[m];
+    out[m] = qc[m];
+  }
+
+  // The fine cells average to the coarse cell value, so the slopes do not change the conserved totals. Slopes are
+  // only taken where both neighbors are inside the domain and the parent patch.
+  for (int d = 0; d < ndim; d++) {
+    int idxl[GKYL_MAX_CDIM], idxr[GKYL_MAX_CDIM];
+    for (int i = 0; i < ndim; i++) {
+      idxl[i] = idxr[i] = cidx[i];
+    }
+    idxl[d] -= 1;
+    idxr[d] += 1;
+
+    if ((idxl[d] < 1) || (idxr[d] > coarse_cells[d]) ||
+      !gkyl_range_contains_idx(&pp->ext_range, idxl) || !gkyl_range_contains_idx(&pp->ext_range, idxr)) {
+      continue;
+    }
+
+    long locl = gkyl_range_idx(&pp->ext_range, idxl);
+    long locr = gkyl_range_idx(&pp->ext_range, idxr);
+    const double *ql_old = gkyl_array_cfetch(pp->fold, locl), *ql_new = gkyl_array_cfetch(pp->f[0], locl);
+    const double *qr_old = gkyl_array_cfetch(pp->fold, locr), *qr_new = gkyl_array_cfetch(pp->f[0], locr);
+
+    for (int m = 0; m < meqn; m++) {
+      double ql = (1.0 - alpha) * ql_old[m] + alpha * ql_new[m];
+      double qr = (1.0 - alpha) * qr_old[m] + alpha * qr_new[m];
+      out[m] += minmod(qr - qc[m], qc[m] - ql) * offset[d];
+    }
+  }
+}
+
+// Fill the ghost cells of the solution f[fidx] of every patch on level l at time tm: by prolongation from the parent
+// patches, then by copying from neighboring patches on the same level, and finally by applying the physical boundary
+// conditions.
+static void
+fill_ghosts(const struct amr_dyn_hierarchy* hier, int l, int fidx, double tm)
+{
+  int ndim = hier->inp.ndim;
+  const struct amr_dyn_level *lev = &hier->levels[l];
+
+  if (l > 0) {
+    const struct amr_dyn_level *plev = &hier->levels[l - 1];
+
+    double alpha = 1.0;
+    if (plev->t_new > plev->t_old) {
+      alpha = fmin(1.0, fmax(0.0, (tm - plev->t_old) / (plev->t_new - plev->t_old)));
+    }
+
+    for (int i = 0; i < lev->num_patches; i++) {
+      const struct amr_dyn_patch *patch = &lev->patches[i];
+      const struct amr_dyn_patch *pp = &plev->patches[patch->parent];
+
+      struct gkyl_range_iter iter;
+      gkyl_range_iter_init(&iter, &patch->ext_range);
+      while (gkyl_range_iter_next(&iter)) {
+        if (gkyl_range_contains_idx(&patch->range, iter.idx)) {
+          continue;
+        }
+
+        bool in_domain = true;
+        for (int d = 0; d < ndim; d++) {
+          if ((iter.idx[d] < 1) || (iter.idx[d] > lev->grid.cells[d])) {
+            in_domain = false;
+          }
+        }
+
+        if (in_domain) {
+          prolong_cell(hier, l, pp, alpha, iter.idx,
+            gkyl_array_fetch(patch->f[fidx], gkyl_range_idx(&patch->ext_range, iter.idx)));
+        }
+      }
+    }
+  }
+
+  for (int i = 0; i < lev->num_patches; i++) {
+    const struct amr_dyn_patch *patch = &lev->patches[i];
+
+    for (int j = 0; j < lev->num_patches; j++) {
+      const struct amr_dyn_patch *nbr = &lev->patches[j];
+
+      struct gkyl_range inter;
+      if ((i != j) && gkyl_range_intersect(&inter, &patch->ext_range, &nbr->range)) {
+        struct gkyl_range out_rng, inp_rng;
+        gkyl_sub_range_init(&out_rng, &patch->ext_range, inter.lower, inter.upper);
+        gkyl_sub_range_init(&inp_rng, &nbr->ext_range, inter.lower, inter.upper);
+        gkyl_array_copy_range_to_range(patch->f[fidx], nbr->f[fidx], &out_rng, &inp_rng);
+      }
+    }
+
+    for (int d = 0; d < ndim; d++) {
+      if (patch->lower_bc[d]) {
+        gkyl_wv_apply_bc_advance(patch->lower_bc[d], tm, &patch->range, patch->f[fidx]);
+      }
+      if (patch->upper_bc[d]) {
+        gkyl_wv_apply_bc_advance(patch->upper_bc[d], tm, &patch->range, patch->f[fidx]);
+      }
+    }
+  }
+}
+
+// Restrict the solution on level l onto the covered cells of level l - 1, by averaging the fine cells in each
+// coarse cell.
+static void
+restrict_level(struct amr_dyn_hierarchy* hier, int l)
+{
+  int ndim = hier->inp.ndim;
+  int ref_factor = hier->inp.ref_factor;
+  int meqn = hier->inp.eqn->num_equations;
+
+  struct amr_dyn_level *lev = &hier->levels[l];
+  struct amr_dyn_level *plev = &hier->levels[l - 1];
+
+  int sub_lower[GKYL_MAX_CDIM], sub_upper[GKYL_MAX_CDIM];
+  double fact = 1.0;
+  for (int d = 0; d < ndim; d++) {
+    sub_lower[d] = 0;
+    sub_upper[d] = ref_factor - 1;
+    fact /= ref_factor;
+  }
+  struct gkyl_range sub_range;
+  gkyl_range_init(&sub_range, ndim, sub_lower, sub_upper);
+
+  for (int i = 0; i < lev->num_patches; i++) {
+    const struct amr_dyn_patch *patch = &lev->patches[i];
+    struct amr_dyn_patch *pp = &plev->patches[patch->parent];
+
+    int clower[GKYL_MAX_CDIM], cupper[GKYL_MAX_CDIM];
+    for (int d = 0; d < ndim; d++) {
+      clower[d] = coarse_idx(patch->range.lower[d], ref_factor);
+      cupper[d] = coarse_idx(patch->range.upper[d], ref_factor);
+    }
+    struct gkyl_range crange;
+    gkyl_range_init(&crange, ndim, clower, cupper);
+
+    struct gkyl_range_iter citer;
+    gkyl_range_iter_init(&citer, &crange);
+    while (gkyl_range_iter_next(&citer)) {
+      double *qc = gkyl_array_fetch(pp->f[0], gkyl_range_idx(&pp->ext_range, citer.idx));
+      for (int m = 0; m < meqn; m++) {
+        qc[m] = 0.0;
+      }
+
+      struct gkyl_range_iter siter;
+      gkyl_range_iter_init(&siter, &sub_range);
+      while (gkyl_range_iter_next(&siter)) {
+        int fidx[GKYL_MAX_CDIM];
+        for (int d = 0; d < ndim; d++) {
+          fidx[d] = (citer.idx[d] - 1) * ref_factor + 1 + siter.idx[d];
+        }
+
+        const double *qf = gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, fidx));
+        for (int m = 0; m < meqn; m++) {
+          qc[m] += fact * qf[m];
+        }
+      }
+    }
+  }
+}
+
+// Tag the cells of a patch in which the relative jump of the tagged component in any direction exceeds the
+// threshold, and add buffer cells (inside the patch) around them. The tags are indexed by box, which is set to the
+// range of the patch.
+static char*
+tag_patch(const struct amr_dyn_hierarchy* hier, const struct amr_dyn_patch* patch, struct gkyl_range* box)
+{
+  const struct amr_dyn_inp *inp = &hier->inp;
+  int ndim = inp->ndim;
+  int comp = inp->tag_comp;
+  int buff = inp->tag_buffer;
+
+  gkyl_range_init(box, ndim, patch->range.lower, patch->range.upper);
+  char *raw = gkyl_calloc(box->volume, sizeof(char));
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, box);
+  while (gkyl_range_iter_next(&iter)) {
+    double q = ((const double*) gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, iter.idx)))[comp];
+
+    for (int d = 0; d < ndim; d++) {
+      int idxl[GKYL_MAX_CDIM], idxr[GKYL_MAX_CDIM];
+      for (int i = 0; i < ndim; i++) {
+        idxl[i] = idxr[i] = iter.idx[i];
+      }
+      idxl[d] -= 1;
+      idxr[d] += 1;
+
+      double ql = ((const double*) gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, idxl)))[comp];
+      double qr = ((const double*) gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, idxr)))[comp];
+
+      double scale = fabs(ql) + 2.0 * fabs(q) + fabs(qr);
+      if ((scale > 0.0) && (fabs(qr - ql) > inp->tag_threshold * scale)) {
+        raw[gkyl_range_idx(box, iter.idx)] = 1;
+      }
+    }
+  }
+
+  if (buff <= 0) {
+    return raw;
+  }
+
+  char *tags = gkyl_calloc(box->volume, sizeof(char));
+
+  gkyl_range_iter_init(&iter, box);
+  while (gkyl_range_iter_next(&iter)) {
+    if (raw[gkyl_range_idx(box, iter.idx)]) {
+      int lower[GKYL_MAX_CDIM], upper[GKYL_MAX_CDIM];
+      for (int d = 0; d < ndim; d++) {
+        lower[d] = GKYL_MAX2(box->lower[d], iter.idx[d] - buff);
+        upper[d] = GKYL_MIN2(box->upper[d], iter.idx[d] + buff);
+      }
+      struct gkyl_range nbr_range;
+      gkyl_range_init(&nbr_range, ndim, lower, upper);
+
+      struct gkyl_range_iter nbr_iter;
+      gkyl_range_iter_init(&nbr_iter, &nbr_range);
+      while (gkyl_range_iter_next(&nbr_iter)) {
+        tags[gkyl_range_idx(box, nbr_iter.idx)] = 1;
+      }
+    }
+  }
+
+  gkyl_free(raw);
+  return tags;
+}
+
+// Rebuild level l + 1 from the tagged cells on level l. New patches are filled from the old patches of level l + 1
+// where they overlap, and by prolongation from level l elsewhere (or by projecting the initial condition if init is
+// true). Returns the number of new patches.
+static int
+regrid_level(struct amr_dyn_hierarchy* hier, int l, bool init, double tm)
+{
+  const struct amr_dyn_inp *inp = &hier->inp;
+  int ndim = inp->ndim;
+  int ref_factor = inp->ref_factor;
+
+  struct amr_dyn_level *lev = &hier->levels[l];
+
+  int num_new = 0;
+  struct gkyl_range *boxes = 0;
+  int *parents = 0;
+
+  for (int i = 0; i < lev->num_patches; i++) {
+    struct gkyl_range box;
+    char *tags = tag_patch(hier, &lev->patches[i], &box);
+
+    int num_clusters;
+    struct gkyl_range *clusters = amr_dyn_cluster(&box, tags, inp->cluster_efficiency, &num_clusters);
+
+    if (num_clusters > 0) {
+      boxes = gkyl_realloc(boxes, (num_new + num_clusters) * sizeof(struct gkyl_range));
+      parents = gkyl_realloc(parents, (num_new + num_clusters) * sizeof(int));
+    }
+
+    for (int c = 0; c < num_clusters; c++) {
+      int lower[GKYL_MAX_CDIM], upper[GKYL_MAX_CDIM];
+      for (int d = 0; d < ndim; d++) {
+        lower[d] = (clusters[c].lower[d] - 1) * ref_factor + 1;
+        upper[d] = clusters[c].upper[d] * ref_factor;
+      }
+      gkyl_range_init(&boxes[num_new], ndim, lower, upper);
+      parents[num_new] = i;
+      num_new += 1;
+    }
+
+    gkyl_free(clusters);
+    gkyl_free(tags);
+  }
+
+  if (num_new == 0) {
+    return 0;
+  }
+
+  struct amr_dyn_level *flev = &hier->levels[l + 1];
+  if (l + 1 >= hier->num_levels) {
+    amr_dyn_level_init(hier, l + 1, flev);
+  }
+
+  struct amr_dyn_patch *patches = gkyl_malloc(num_new * sizeof(struct amr_dyn_patch));
+
+  for (int i = 0; i < num_new; i++) {
+    struct amr_dyn_patch *patch = &patches[i];
+    amr_dyn_patch_init(hier, flev, patch, &boxes[i], parents[i]);
+
+    if (init) {
+      gkyl_fv_proj_advance(flev->fv_proj, tm, &patch->range, patch->f[0]);
+    }
+    else {
+      const struct amr_dyn_patch *pp = &lev->patches[parents[i]];
+
+      struct gkyl_range_iter iter;
+      gkyl_range_iter_init(&iter, &patch->range);
+      while (gkyl_range_iter_next(&iter)) {
+        prolong_cell(hier, l + 1, pp, 1.0, iter.idx,
+          gkyl_array_fetch(patch->f[0], gkyl_range_idx(&patch->ext_range, iter.idx)));
+      }
+
+      for (int j = 0; j < flev->num_patches; j++) {
+        const struct amr_dyn_patch *old = &flev->patches[j];
+
+        struct gkyl_range inter;
+        if (gkyl_range_intersect(&inter, &patch->range, &old->range)) {
+          struct gkyl_range out_rng, inp_rng;
+          gkyl_sub_range_init(&out_rng, &patch->ext_range, inter.lower, inter.upper);
+          gkyl_sub_range_init(&inp_rng, &old->ext_range, inter.lower, inter.upper);
+          gkyl_array_copy_range_to_range(patch->f[0], old->f[0], &out_rng, &inp_rng);
+        }
+      }
+    }
+  }
+
+  for (int j = 0; j < flev->num_patches; j++) {
+    amr_dyn_patch_release(ndim, &flev->patches[j]);
+  }
+  gkyl_free(flev->patches);
+
+  flev->num_patches = num_new;
+  flev->patches = patches;
+  flev->t_old = flev->t_new = tm;
+
+  fill_ghosts(hier, l + 1, 0, tm);
+
+  gkyl_free(boxes);
+  gkyl_free(parents);
+
+  return num_new;
+}
+
+static void
+regrid(struct amr_dyn_hierarchy* hier, bool init, double tm)
+{
+  int ndim = hier->inp.ndim;
+
+  for (int l = 0; (l < hier->inp.max_levels - 1) && (l < hier->num_levels); l++) {
+    if (regrid_level(hier, l, init, tm) == 0) {
+      for (int k = l + 1; k < hier->num_levels; k++) {
+        amr_dyn_level_release(ndim, &hier->levels[k]);
+      }
+      hier->num_levels = l + 1;
+    }
+    else if (l + 1 == hier->num_levels) {
+      hier->num_levels = l + 2;
+    }
+  }
+}
+
+struct amr_dyn_hierarchy*
+amr_dyn_hierarchy_new(const struct amr_dyn_inp* inp)
+{
+  struct amr_dyn_hierarchy *hier = gkyl_malloc(sizeof(struct amr_dyn_hierarchy));
+
+  hier->inp = *inp;
+  hier->inp.eqn = gkyl_wv_eqn_acquire(inp->eqn);
+  hier->inp.max_levels = GKYL_MIN2(GKYL_MAX2(inp->max_levels, 1), AMR_DYN_MAX_LEVELS);
+  hier->num_steps = 0;
+
+  // The base level is a single patch covering the whole domain.
+  struct amr_dyn_level *lev = &hier->levels[0];
+  amr_dyn_level_init(hier, 0, lev);
+
+  int lower[GKYL_MAX_CDIM];
+  for (int d = 0; d < inp->ndim; d++) {
+    lower[d] = 1;
+  }
+  struct gkyl_range box;
+  gkyl_range_init(&box, inp->ndim, lower, lev->grid.cells);
+
+  lev->num_patches = 1;
+  lev->patches = gkyl_malloc(sizeof(struct amr_dyn_patch));
+  amr_dyn_patch_init(hier, lev, &lev->patches[0], &box, -1);
+  gkyl_fv_proj_advance(lev->fv_proj, 0.0, &lev->patches[0].range, lev->patches[0].f[0]);
+
+  hier->num_levels = 1;
+  fill_ghosts(hier, 0, 0, 0.0);
+
+  regrid(hier, true, 0.0);
+
+  // Make the coarse data consistent with the initial fine data.
+  for (int l = hier->num_levels - 1; l > 0; l--) {
+    restrict_level(hier, l);
+    fill_ghosts(hier, l - 1, 0, 0.0);
+  }
+
+  return hier;
+}
+
+void
+amr_dyn_regrid(struct amr_dyn_hierarchy* hier, double tm)
+{
+  regrid(hier, false, tm);
+}
+
+double
+amr_dyn_max_dt(const struct amr_dyn_hierarchy* hier)
+{
+  double dt = DBL_MAX;
+  double fact = 1.0;
+
+  for (int l = 0; l < hier->num_levels; l++) {
+    const struct amr_dyn_level *lev = &hier->levels[l];
+
+    for (int i = 0; i < lev->num_patches; i++) {
+      const struct amr_dyn_patch *patch = &lev->patches[i];
+
+      for (int d = 0; d < hier->inp.ndim; d++) {
+        dt = fmin(dt, fact * gkyl_wave_prop_max_dt(patch->slvr[d], &patch->range, patch->f[0]));
+      }
+    }
+
+    fact *= hier->inp.ref_factor;
+  }
+
+  return dt;
+}
+
+void
+amr_dyn_update_patch_job_func(void* ctx)
+{
+  struct amr_dyn_update_patch_ctx *up_ctx = ctx;
+  const struct amr_dyn_patch *patch = up_ctx->patch;
+
+  int d = up_ctx->dir;
+
+  up_ctx->stat = gkyl_wave_prop_advance(patch->slvr[d], up_ctx->t_curr, up_ctx->dt, &patch->range, patch->f[d],
+    patch->f[d + 1]);
+}
+
+// Advance level l from t_curr to t_curr + dt, followed by ref_factor time-steps of each finer level (recursively).
+// Suggested time-steps are returned in units of the coarse (level 0) time-step.
+static struct gkyl_update_status
+advance_level(const struct gkyl_job_pool* job_pool, struct amr_dyn_hierarchy* hier, int l, double t_curr, double dt)
+{
+  int ndim = hier->inp.ndim;
+  int ref_factor = hier->inp.ref_factor;
+
+  struct amr_dyn_level *lev = &hier->levels[l];
+  int num_patches = lev->num_patches;
+
+  double dt_fact = pow(ref_factor, l);
+  double dt_suggested = DBL_MAX;
+
+  for (int i = 0; i < num_patches; i++) {
+    gkyl_array_copy(lev->patches[i].fold, lev->patches[i].f[0]);
+  }
+  lev->t_old = t_curr;
+  lev->t_new = t_curr + dt;
+
+  struct amr_dyn_update_patch_ctx up_ctx[num_patches];
+
+  for (int d = 0; d < ndim; d++) {
+    for (int i = 0; i < num_patches; i++) {
+      up_ctx[i] = (struct amr_dyn_update_patch_ctx) {
+        .patch = &lev->patches[i],
+        .dir = d,
+        .t_curr = t_curr,
+        .dt = dt,
+      };
+    }
+
+#ifdef AMR_USETHREADS
+    for (int i = 0; i < num_patches; i++) {
+      gkyl_job_pool_add_work(job_pool, amr_dyn_update_patch_job_func, &up_ctx[i]);
+    }
+    gkyl_job_pool_wait(job_pool);
+#else
+    for (int i = 0; i < num_patches; i++) {
+      amr_dyn_update_patch_job_func(&up_ctx[i]);
+    }
+#endif
+
+    for (int i = 0; i < num_patches; i++) {
+      if (up_ctx[i].stat.success == false) {
+        return (struct gkyl_update_status) {
+          .success = false,
+          .dt_suggested = dt_fact * up_ctx[i].stat.dt_suggested,
+        };
+      }
+
+      dt_suggested = fmin(dt_suggested, dt_fact * up_ctx[i].stat.dt_suggested);
+    }
+
+    fill_ghosts(hier, l, d + 1, t_curr + dt);
+  }
+
+  for (int i = 0; i < num_patches; i++) {
+    gkyl_array_copy(lev->patches[i].f[0], lev->patches[i].f[ndim]);
+  }
+
+  if (l + 1 < hier->num_levels) {
+    double fine_dt = dt / ref_factor;
+
+    for (int k = 0; k < ref_factor; k++) {
+      struct gkyl_update_status s = advance_level(job_pool, hier, l + 1, t_curr + k * fine_dt, fine_dt);
+
+      if (!s.success) {
+        return s;
+      }
+
+      dt_suggested = fmin(dt_suggested, s.dt_suggested);
+    }
+
+    restrict_level(hier, l + 1);
+    fill_ghosts(hier, l, 0, t_curr + dt);
+  }
+
+  return (struct gkyl_update_status) {
+    .success = true,
+    .dt_suggested = dt_suggested,
+  };
+}
+
+struct gkyl_update_status
+amr_dyn_update(const struct gkyl_job_pool* job_pool, struct amr_dyn_hierarchy* hier, double t_curr, double dt0,
+  struct sim_stats* stats)
+{
+  for (int l = 0; l < hier->num_levels; l++) {
+    for (int i = 0; i < hier->levels[l].num_patches; i++) {
+      gkyl_array_copy(hier->levels[l].patches[i].fdup, hier->levels[l].patches[i].f[0]);
+    }
+  }
+
+  double dt = dt0;
+  struct gkyl_update_status s = advance_level(job_pool, hier, 0, t_curr, dt);
+
+  while (!s.success) {
+    stats->nfail += 1;
+    dt = s.dt_suggested;
+
+    for (int l = 0; l < hier->num_levels; l++) {
+      for (int i = 0; i < hier->levels[l].num_patches; i++) {
+        gkyl_array_copy(hier->levels[l].patches[i].f[0], hier->levels[l].patches[i].fdup);
+      }
+    }
+
+    s = advance_level(job_pool, hier, 0, t_curr, dt);
+  }
+
+  double dt_suggested = s.dt_suggested;
+
+  hier->num_steps += 1;
+  if ((hier->inp.regrid_steps > 0) && (hier->num_steps % hier->inp.regrid_steps == 0)) {
+    amr_dyn_regrid(hier, t_curr + dt);
+
+    // New finer levels may need a smaller time-step.
+    dt_suggested = fmin(dt_suggested, amr_dyn_max_dt(hier));
+  }
+
+  return (struct gkyl_update_status) {
+    .success = true,
+    .dt_actual = dt,
+    .dt_suggested = dt_suggested,
+  };
+}
+
+double
+amr_dyn_integrate(const struct amr_dyn_hierarchy* hier, int comp)
+{
+  int ndim = hier->inp.ndim;
+  int ref_factor = hier->inp.ref_factor;
+
+  double total = 0.0;
+
+  for (int l = 0; l < hier->num_levels; l++) {
+    const struct amr_dyn_level *lev = &hier->levels[l];
+    const struct amr_dyn_level *flev = (l + 1 < hier->num_levels) ? &hier->levels[l + 1] : 0;
+
+    double vol = 1.0;
+    for (int d = 0; d < ndim; d++) {
+      vol *= lev->grid.dx[d];
+    }
+
+    for (int i = 0; i < lev->num_patches; i++) {
+      const struct amr_dyn_patch *patch = &lev->patches[i];
+
+      struct gkyl_range_iter iter;
+      gkyl_range_iter_init(&iter, &patch->range);
+      while (gkyl_range_iter_next(&iter)) {
+        bool covered = false;
+
+        for (int j = 0; flev && (j < flev->num_patches) && !covered; j++) {
+          covered = true;
+          for (int d = 0; d < ndim; d++) {
+            if ((iter.idx[d] < coarse_idx(flev->patches[j].range.lower[d], ref_factor)) ||
+              (iter.idx[d] > coarse_idx(flev->patches[j].range.upper[d], ref_factor))) {
+              covered = false;
+            }
+          }
+        }
+
+        if (!covered) {
+          const double *q = gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, iter.idx));
+          total += vol * q[comp];
+        }
+      }
+    }
+  }
+
+  return total;
+}
+
+void
+amr_dyn_write_sol(const char* fbase, const struct amr_dyn_hierarchy* hier)
+{
+  for (int l = 0; l < hier->num_levels; l++) {
+    const struct amr_dyn_level *lev = &hier->levels[l];
+
+    for (int i = 0; i < lev->num_patches; i++) {
+      const char *fmt = "%s_l%d_p%d.gkyl";
+      int sz = snprintf(0, 0, fmt, fbase, l, i);
+      char file_nm[sz + 1];
+
+      snprintf(file_nm, sizeof file_nm, fmt, fbase, l, i);
+      gkyl_grid_sub_array_write(&lev->grid, &lev->patches[i].range, 0, lev->patches[i].f[0], file_nm);
+    }
+  }
+}
+
+void
+amr_dyn_hierarchy_release(struct amr_dyn_hierarchy* hier)
+{
+  for (int l = 0; l < hier->num_levels; l++) {
+    amr_dyn_level_release(hier->inp.ndim, &hier->levels[l]);
+  }
+  gkyl_wv_eqn_release(hier->inp.eqn);
+  gkyl_free(hier);
+}
+
+void
+amr_dyn_run(const struct gkyl_app_args* app_args, const struct amr_dyn_inp* inp, const char* output,
+  double t_end, int num_frames, double dt_failure_tol, int num_failures_max)
+{
+  struct gkyl_job_pool *job_pool = gkyl_thread_pool_new(app_args->num_threads);
+  struct amr_dyn_hierarchy *hier = amr_dyn_hierarchy_new(inp);
+
+  char amr0[64];
+  snprintf(amr0, 64, "%s_0", output);
+  amr_dyn_write_sol(amr0, hier);
+
+  double t_curr = 0.0;
+  double dt = amr_dyn_max_dt(hier);
+
+  struct sim_stats stats = { };
+
+  struct timespec tm_start = gkyl_wall_clock();
+
+  long step = 1;
+  long num_steps = app_args->num_steps;
+
+  double io_trigger = t_end / num_frames;
+
+  double dt_init = -1.0;
+  int num_failures = 0;
+
+  while ((t_curr < t_end) && (step <= num_steps)) {
+    printf("Taking coarse (level 0) time-step %ld at t = %g; ", step, t_curr);
+    struct gkyl_update_status status = amr_dyn_update(job_pool, hier, t_curr, dt, &stats);
+    printf(" dt = %g, levels = %d\n", status.dt_actual, hier->num_levels);
+
+    if (!status.success) {
+      printf("** Update method failed! Aborting simulation ....\n");
+      break;
+    }
+
+    for (int i = 1; i < num_frames; i++) {
+      if (t_curr < (i * io_trigger) && (t_curr + status.dt_actual) > (i * io_trigger)) {
+        char buf[64];
+        snprintf(buf, 64, "%s_%d", output, i);
+
+        amr_dyn_write_sol(buf, hier);
+      }
+    }
+
+    t_curr += status.dt_actual;
+    dt = status.dt_suggested;
+
+    if (dt_init < 0.0) {
+      dt_init = status.dt_actual;
+    }
+    else if (status.dt_actual < dt_failure_tol * dt_init) {
+      num_failures += 1;
+
+      printf("WARNING: Time-step dt = %g", status.dt_actual);
+      printf(" is below %g*dt_init ...", dt_failure_tol);
+      printf(" num_failures = %d\n", num_failures);
+      if (num_failures >= num_failures_max) {
+        printf("ERROR: Time-step was below %g*dt_init ", dt_failure_tol);
+        printf("%d consecutive times. Aborting simulation ....\n", num_failures_max);
+        break;
+      }
+    }
+    else {
+      num_failures = 0;
+    }
+
+    step += 1;
+  }
+
+  double tm_total_sec = gkyl_time_diff_now_sec(tm_start);
+
+  char buf[64];
+  snprintf(buf, 64, "%s_%d", output, num_frames);
+
+  amr_dyn_write_sol(buf, hier);
+
+  printf("\n");
+  printf("Number of update calls %ld\n", (step - 1));
+  printf("Number of failed time-steps %d\n", stats.nfail);
+  printf("Number of levels at end of simulation %d\n", hier->num_levels);
+  printf("Total updates took %g secs\n", tm_total_sec);
+
+  amr_dyn_hierarchy_release(hier);
+  gkyl_job_pool_release(job_pool);
+}
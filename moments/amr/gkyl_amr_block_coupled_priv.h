@@ -83,6 +83,21 @@ struct five_moment_update_block_ctx {
   int nstrang;
 };
 
+// Job pool information context for filling the ghost cells of a single block for the coupled five-moment equations using threads.
+struct five_moment_sync_block_ctx {
+  const struct gkyl_block_topo *btopo;
+  const struct five_moment_block_data *bdata;
+  int bidx;
+
+  struct gkyl_array *bc_buffer_elc;
+  struct gkyl_array *bc_buffer_ion;
+  struct gkyl_array *bc_buffer_maxwell;
+
+  struct gkyl_array **fld_elc;
+  struct gkyl_array **fld_ion;
+  struct gkyl_array **fld_maxwell;
+};
+
 // Context for copying job pool information for the coupled five-moment equations.
 struct five_moment_copy_job_ctx {
   int bidx;
@@ -384,6 +399,32 @@ void block_coupled_uu_restriction_op(const int tbid, const int tdir, const int i
 void five_moment_sync_blocks(const struct gkyl_block_topo* btopo, const struct five_moment_block_data bdata[],
   struct gkyl_array* fld_elc[], struct gkyl_array* fld_ion[], struct gkyl_array* fld_maxwell[]);
 
+/**
+* Fill the ghost cells of a single (target) block in the block AMR hierarchy by applying all appropriate physical (outer-block) and
+* non-physical (inter-block) boundary conditions for the coupled five-moment equations. Only the ghost cells of the target block are
+* written to.
+*
+* @param btopo Topology/connectivity information for the block hierarchy.
+* @param bdata Block-structured data for the coupled five-moment equations.
+* @param tbid Index of the target block.
+* @param bc_buffer_elc Buffer for the inter-block copies (electrons).
+* @param bc_buffer_ion Buffer for the inter-block copies (ions).
+* @param bc_buffer_maxwell Buffer for the inter-block copies (Maxwell field).
+* @param fld_elc Output array (electrons).
+* @param fld_ion Output array (ions).
+* @param fld_maxwell Output array (Maxwell field).
+*/
+void five_moment_sync_block(const struct gkyl_block_topo* btopo, const struct five_moment_block_data bdata[], int tbid,
+  struct gkyl_array* bc_buffer_elc, struct gkyl_array* bc_buffer_ion, struct gkyl_array* bc_buffer_maxwell,
+  struct gkyl_array* fld_elc[], struct gkyl_array* fld_ion[], struct gkyl_array* fld_maxwell[]);
+
+/**
+* Fill the ghost cells of a single block for the coupled five-moment equations using the thread-based job pool.
+*
+* @param ctx Context to pass to the function.
+*/
+void five_moment_sync_block_job_func(void* ctx);
+
 /**
 * Write block-structured AMR simulation data for the coupled five-moment equations onto disk.
 *
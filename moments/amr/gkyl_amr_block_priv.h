@@ -19,6 +19,7 @@
 #include <gkyl_range.h>
 #include <gkyl_rect_decomp.h>
 #include <gkyl_rect_grid.h>
+#include <gkyl_task_graph.h>
 #include <gkyl_thread_pool.h>
 #include <gkyl_util.h>
 #include <gkyl_wave_geom.h>
@@ -84,6 +85,15 @@ struct euler_update_block_ctx {
   struct gkyl_wave_prop_status stat;
 };
 
+// Job pool information context for filling the ghost cells of a single block for the Euler equations using threads.
+struct euler_sync_block_ctx {
+  const struct gkyl_block_topo *btopo;
+  const struct euler_block_data *bdata;
+  int bidx;
+  struct gkyl_array *bc_buffer;
+  struct gkyl_array **fld;
+};
+
 // Context for copying arbitrary job pool information.
 struct copy_job_ctx {
   int bidx;
@@ -369,6 +379,36 @@ void block_uu_restriction_op(const int tbid, const int tdir, const int i, const
 */
 void euler_sync_blocks(const struct gkyl_block_topo* btopo, const struct euler_block_data bdata[], struct gkyl_array* fld[]);
 
+/**
+* Fill the ghost cells of a single (target) block in the block AMR hierarchy by applying all appropriate physical (outer-block) and
+* non-physical (inter-block) boundary conditions for the Euler equations. Only the ghost cells of the target block are written to.
+*
+* @param btopo Topology/connectivity information for the entire block hierarchy.
+* @param bdata Block-structured data for the Euler equations.
+* @param tbid Index of the target block.
+* @param bc_buffer Buffer for the inter-block copies (must be at least as large as the buffer of any block).
+* @param fld Output array.
+*/
+void euler_sync_block(const struct gkyl_block_topo* btopo, const struct euler_block_data bdata[], int tbid,
+  struct gkyl_array* bc_buffer, struct gkyl_array* fld[]);
+
+/**
+* Find the blocks whose skin cells are copied into the ghost cells of a (target) block when synchronizing the block AMR hierarchy.
+*
+* @param btopo Topology/connectivity information for the entire block hierarchy.
+* @param tbid Index of the target block.
+* @param srcs Output list of source block indices (must have room for num_blocks entries).
+* @return Number of source blocks.
+*/
+int block_sync_sources(const struct gkyl_block_topo* btopo, int tbid, int* srcs);
+
+/**
+* Fill the ghost cells of a single block for the Euler equations using the thread-based job pool.
+*
+* @param ctx Context to pass to the function.
+*/
+void euler_sync_block_job_func(void* ctx);
+
 /**
 * Write block-structured AMR simulation data for the Euler equations onto disk.
 *
@@ -393,7 +433,9 @@ double euler_block_data_max_dt(const struct euler_block_data* bdata);
 void euler_update_block_job_func(void* ctx);
 
 /**
-* Update all blocks in the block AMR hierarchy by using the thread-based job pool for the Euler equations.
+* Update all blocks in the block AMR hierarchy by using the thread-based job pool for the Euler equations. Block updates and
+* inter-block synchronizations are scheduled as a task graph, so each block proceeds to its next direction as soon as its own ghost
+* cells have been filled, without waiting for the other blocks.
 *
 * @param job_pool Job pool for updating block-structured data for the Euler equations using threads.
 * @param btopo Topology/connectivity information for the entire block hierarchy.
@@ -914,4 +914,119 @@ struct ten_moment_2d_double_init {
 * @param argv Array of command line arguments passed to the function.
 * @param init Initialization data for the 2D coupled ten-moment equations.
 */
-void ten_moment_2d_run_double(int argc, char **argv, struct ten_moment_2d_double_init* init);
\ No newline at end of file
+void ten_moment_2d_run_double(int argc, char **argv, struct ten_moment_2d_double_init* init);
+// Initialization data for a 1D simulation using the Euler equations, run with dynamic, block-structured mesh refinement.
+struct euler1d_dynamic_init {
+  int base_Nx;
+  int ref_factor;
+  int max_levels;
+
+  double x1;
+  double x2;
+
+  evalf_t eval;
+  double gas_gamma;
+
+  char euler_output[64];
+
+  bool low_order_flux;
+  double cfl_frac;
+
+  double tag_threshold;
+  int tag_buffer;
+  double cluster_efficiency;
+  int regrid_steps;
+
+  double t_end;
+  int num_frames;
+  double dt_failure_tol;
+  int num_failures_max;
+};
+
+/**
+* Run a 1D simulation using the Euler equations, with dynamic, block-structured mesh refinement.
+*
+* @param argc Number of command line arguments passed to the function.
+* @param argv Array of command line arguments passed to the function.
+* @param init Initialization data for the 1D Euler equations.
+*/
+void euler1d_run_dynamic(int argc, char **argv, struct euler1d_dynamic_init* init);
+
+// Initialization data for a 2D simulation using the Euler equations, run with dynamic, block-structured mesh refinement.
+struct euler2d_dynamic_init {
+  int base_Nx;
+  int base_Ny;
+  int ref_factor;
+  int max_levels;
+
+  double x1;
+  double y1;
+  double x2;
+  double y2;
+
+  bool wall_x;
+  bool wall_y;
+
+  evalf_t eval;
+  double gas_gamma;
+
+  char euler_output[64];
+
+  bool low_order_flux;
+  double cfl_frac;
+
+  double tag_threshold;
+  int tag_buffer;
+  double cluster_efficiency;
+  int regrid_steps;
+
+  double t_end;
+  int num_frames;
+  double dt_failure_tol;
+  int num_failures_max;
+};
+
+/**
+* Run a 2D simulation using the Euler equations, with dynamic, block-structured mesh refinement.
+*
+* @param argc Number of command line arguments passed to the function.
+* @param argv Array of command line arguments passed to the function.
+* @param init Initialization data for the 2D Euler equations.
+*/
+void euler2d_run_dynamic(int argc, char **argv, struct euler2d_dynamic_init* init);
+
+// Initialization data for a 1D simulation using the (neutral) ten-moment equations, run with dynamic, block-structured mesh refinement.
+struct ten_moment_1d_dynamic_init {
+  int base_Nx;
+  int ref_factor;
+  int max_levels;
+
+  double x1;
+  double x2;
+
+  evalf_t eval;
+  double k0;
+
+  char ten_moment_output[64];
+
+  double cfl_frac;
+
+  double tag_threshold;
+  int tag_buffer;
+  double cluster_efficiency;
+  int regrid_steps;
+
+  double t_end;
+  int num_frames;
+  double dt_failure_tol;
+  int num_failures_max;
+};
+
+/**
+* Run a 1D simulation using the (neutral) ten-moment equations, with dynamic, block-structured mesh refinement.
+*
+* @param argc Number of command line arguments passed to the function.
+* @param argv Array of command line arguments passed to the function.
+* @param init Initialization data for the 1D ten-moment equations.
+*/
+void ten_moment_1d_run_dynamic(int argc, char **argv, struct ten_moment_1d_dynamic_init* init);
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <gkyl_amr_block_priv.h>
+
+// Definitions of private structs and APIs attached to these objects, for use in the dynamic (error-driven) AMR subsystem.
+
+// Maximum number of refinement levels in the dynamic AMR hierarchy (including the base level).
+#define AMR_DYN_MAX_LEVELS 8
+
+// Input parameters for the dynamic AMR hierarchy.
+struct amr_dyn_inp {
+  int ndim;
+  double lower[GKYL_MAX_CDIM];
+  double upper[GKYL_MAX_CDIM];
+  int base_cells[GKYL_MAX_CDIM];
+
+  int max_levels; // Maximum number of levels (including the base level).
+  int ref_factor; // Refinement factor between consecutive levels.
+
+  const struct gkyl_wv_eqn *eqn; // Equation object (Euler, ten-moment, etc.).
+  double cfl_frac;
+
+  evalf_t eval; // Initial condition.
+  void *eval_ctx;
+
+  bool wall[GKYL_MAX_CDIM]; // Use wall (rather than copy) boundary conditions in each direction.
+
+  int tag_comp; // Component of the solution used by the error estimator.
+  double tag_threshold; // Cells with a relative jump above this threshold are refined.
+  int tag_buffer; // Number of buffer cells added around tagged cells.
+  double cluster_efficiency; // Minimum fraction of tagged cells in each refinement patch.
+  int regrid_steps; // Number of coarse (level 0) time-steps between regrids.
+};
+
+// A single refinement patch on a level of the dynamic AMR hierarchy.
+struct amr_dyn_patch {
+  int parent; // Index of the parent patch on the next coarser level (-1 on the base level).
+
+  struct gkyl_range ext_range;
+  struct gkyl_range range;
+  struct gkyl_array *f[GKYL_MAX_CDIM + 1];
+  struct gkyl_array *fold; // Solution at the start of the current time-step of the level.
+  struct gkyl_array *fdup; // Solution at the start of the coarse time-step (for redoing failed time-steps).
+
+  struct gkyl_wave_geom *geom;
+  gkyl_wave_prop *slvr[GKYL_MAX_CDIM];
+
+  struct gkyl_wv_apply_bc *lower_bc[GKYL_MAX_CDIM];
+  struct gkyl_wv_apply_bc *upper_bc[GKYL_MAX_CDIM];
+};
+
+// A single level of the dynamic AMR hierarchy.
+struct amr_dyn_level {
+  struct gkyl_rect_grid grid; // Grid spanning the whole domain at the resolution of this level.
+  gkyl_fv_proj *fv_proj;
+
+  int num_patches;
+  struct amr_dyn_patch *patches;
+
+  double t_old; // Time of the fold solutions on this level.
+  double t_new; // Time of the f[0] solutions on this level.
+};
+
+// Dynamic, block-structured AMR hierarchy: the base level covers the whole domain, and each finer level consists of
+// patches, each nested inside a single patch of the next coarser level.
+struct amr_dyn_hierarchy {
+  struct amr_dyn_inp inp;
+
+  int num_levels; // Number of levels currently in the hierarchy.
+  struct amr_dyn_level levels[AMR_DYN_MAX_LEVELS];
+
+  long num_steps; // Number of coarse time-steps taken since the last regrid.
+};
+
+// Job pool information context for updating a patch of the dynamic AMR hierarchy using threads.
+struct amr_dyn_update_patch_ctx {
+  const struct amr_dyn_patch *patch;
+  int dir;
+  double t_curr;
+  double dt;
+  struct gkyl_wave_prop_status stat;
+};
+
+/**
+* Cluster the tagged cells in a box into rectangular patches, using the Berger-Rigoutsos signature algorithm.
+*
+* @param box Box containing the tagged cells.
+* @param tags Tags (1 for tagged cells, 0 otherwise), indexed with gkyl_range_idx on box.
+* @param efficiency Minimum fraction of tagged cells in each patch.
+* @param num_clusters On output, the number of patches.
+* @return Newly allocated array of patches (to be freed with gkyl_free).
+*/
+struct gkyl_range* amr_dyn_cluster(const struct gkyl_range* box, const char* tags, double efficiency, int* num_clusters);
+
+/**
+* Create a new dynamic AMR hierarchy, refining the initial condition until no more cells are tagged or the maximum
+* number of levels is reached.
+*
+* @param inp Input parameters for the hierarchy.
+* @return New dynamic AMR hierarchy.
+*/
+struct amr_dyn_hierarchy* amr_dyn_hierarchy_new(const struct amr_dyn_inp* inp);
+
+/**
+* Regrid the dynamic AMR hierarchy: tag cells on each level with the error estimator, cluster the tags into new
+* patches of the next finer level, and fill these from the old patches and by conservative prolongation.
+*
+* @param hier Dynamic AMR hierarchy.
+* @param tm Current simulation time.
+*/
+void amr_dyn_regrid(struct amr_dyn_hierarchy* hier, double tm);
+
+/**
+* Calculate the maximum stable (coarse) time-step across all levels of the dynamic AMR hierarchy.
+*
+* @param hier Dynamic AMR hierarchy.
+* @return Maximum stable time-step.
+*/
+double amr_dyn_max_dt(const struct amr_dyn_hierarchy* hier);
+
+/**
+* Take a single coarse time-step across the dynamic AMR hierarchy, sub-cycling the finer levels in time, and regrid
+* every regrid_steps coarse time-steps.
+*
+* @param job_pool Job pool for updating the patches using threads.
+* @param hier Dynamic AMR hierarchy.
+* @param t_curr Current simulation time.
+* @param dt0 Initial guess for the maximum stable time-step.
+* @param stats Simulation statistics (allowing for tracking of the number of failed time-steps).
+* @return Status of the update (success, suggested time-step and actual time-step).
+*/
+struct gkyl_update_status amr_dyn_update(const struct gkyl_job_pool* job_pool, struct amr_dyn_hierarchy* hier,
+  double t_curr, double dt0, struct sim_stats* stats);
+
+/**
+* Integrate a component of the solution over the composite grid (the finest data available at each point).
+*
+* @param hier Dynamic AMR hierarchy.
+* @param comp Component to integrate.
+* @return Integral over the domain.
+*/
+double amr_dyn_integrate(const struct amr_dyn_hierarchy* hier, int comp);
+
+/**
+* Write the simulation output for every patch of the dynamic AMR hierarchy onto disk.
+*
+* @param fbase Base file name schema to use for the simulation output.
+* @param hier Dynamic AMR hierarchy.
+*/
+void amr_dyn_write_sol(const char* fbase, const struct amr_dyn_hierarchy* hier);
+
+/**
+* Release the dynamic AMR hierarchy.
+*
+* @param hier Dynamic AMR hierarchy.
+*/
+void amr_dyn_hierarchy_release(struct amr_dyn_hierarchy* hier);
+
+/**
+* Run a simulation with dynamic, block-structured mesh refinement.
+*
+* @param app_args Parsed command line arguments.
+* @param inp Input parameters for the hierarchy.
+* @param output Base file name for the simulation output.
+* @param t_end Final simulation time.
+* @param num_frames Number of output frames.
+* @param dt_failure_tol Minimum allowable fraction of the initial time-step.
+* @param num_failures_max Maximum allowable number of consecutive small time-steps.
+*/
+void amr_dyn_run(const struct gkyl_app_args* app_args, const struct amr_dyn_inp* inp, const char* output,
+  double t_end, int num_frames, double dt_failure_tol, int num_failures_max);
@@ -0,0 +1,169 @@
+// Sod-type shock tube test, using dynamic, block-structured mesh refinement (up to two levels of 2x refinement), for the 5-moment (Euler) equations.
+// Input parameters match the initial conditions in Section 2.6.2, with the contact discontinuity placed at x = 0.75 rather than x = 0.5, from the thesis:
+// A. Hakim (2006), "High Resolution Wave Propagation Schemes for Two-Fluid Plasma Simulations",
+// PhD Thesis, University of Washington.
+// https://www.aa.washington.edu/sites/aa/files/research/cpdlab/docs/PhDthesis_hakim.pdf
+
+#include <gkyl_amr_core.h>
+
+struct amr_euler_sodshock_ctx
+{
+  // Physical constants (using normalized code units).
+  double gas_gamma; // Adiabatic index.
+
+  double rhol; // Left fluid mass density.
+  double ul; // Left fluid velocity.
+  double pl; // Left fluid pressure.
+
+  double rhor; // Right fluid mass density.
+  double ur; // Right fluid velocity.
+  double pr; // Right fluid pressure.
+
+  // Simulation parameters.
+  int Nx; // Coarse cell count (x-direction).
+  int ref_factor; // Refinement factor.
+  int max_levels; // Maximum number of refinement levels (including the base level).
+  double Lx; // Coarse domain size (x-direction).
+  double cfl_frac; // CFL coefficient.
+
+  double tag_threshold; // Relative jump in mass density above which cells are refined.
+  int tag_buffer; // Number of buffer cells around refined cells.
+  double cluster_efficiency; // Minimum fraction of tagged cells in each refinement patch.
+  int regrid_steps; // Number of coarse time-steps between regrids.
+
+  double t_end; // Final simulation time.
+  int num_frames; // Number of output frames.
+  double dt_failure_tol; // Minimum allowable fraction of initial time-step.
+  int num_failures_max; // Maximum allowable number of consecutive small time-steps.
+};
+
+struct amr_euler_sodshock_ctx
+create_ctx(void)
+{
+  // Physical constants (using normalized code units).
+  double gas_gamma = 1.4; // Adiabatic index.
+
+  double rhol = 3.0; // Left fluid mass density.
+  double ul = 0.0; // Left fluid velocity.
+  double pl = 3.0; // Left fluid pressure.
+
+  double rhor = 1.0; // Right fluid mass density.
+  double ur = 0.0; // Right fluid velocity.
+  double pr = 1.0; // Right fluid pressure.
+
+  // Simulation parameters.
+  int Nx = 32; // Coarse cell count (x-direction).
+  int ref_factor = 2; // Refinement factor.
+  int max_levels = 3; // Maximum number of refinement levels (including the base level).
+  double Lx = 1.0; // Coarse domain size (x-direction).
+  double cfl_frac = 0.95; // CFL coefficient.
+
+  double tag_threshold = 0.02; // Relative jump in mass density above which cells are refined.
+  int tag_buffer = 2; // Number of buffer cells around refined cells.
+  double cluster_efficiency = 0.7; // Minimum fraction of tagged cells in each refinement patch.
+  int regrid_steps = 2; // Number of coarse time-steps between regrids.
+
+  double t_end = 0.1; // Final simulation time.
+  int num_frames = 1; // Number of output frames.
+  double dt_failure_tol = 1.0e-4; // Minimum allowable fraction of initial time-step.
+  int num_failures_max = 20; // Maximum allowable number of consecutive small time-steps.
+
+  struct amr_euler_sodshock_ctx ctx = {
+    .gas_gamma = gas_gamma,
+    .rhol = rhol,
+    .ul = ul,
+    .pl = pl,
+    .rhor = rhor,
+    .ur = ur,
+    .pr = pr,
+    .Nx = Nx,
+    .ref_factor = ref_factor,
+    .max_levels = max_levels,
+    .Lx = Lx,
+    .cfl_frac = cfl_frac,
+    .tag_threshold = tag_threshold,
+    .tag_buffer = tag_buffer,
+    .cluster_efficiency = cluster_efficiency,
+    .regrid_steps = regrid_steps,
+    .t_end = t_end,
+    .num_frames = num_frames,
+    .dt_failure_tol = dt_failure_tol,
+    .num_failures_max = num_failures_max,
+  };
+
+  return ctx;
+}
+
+void
+evalEulerInit(double t, const double* GKYL_RESTRICT xn, double* GKYL_RESTRICT fout, void* ctx)
+{
+  double x = xn[0];
+  struct amr_euler_sodshock_ctx new_ctx = create_ctx(); // Context for initialization functions.
+  struct amr_euler_sodshock_ctx *app = &new_ctx;
+
+  double gas_gamma = app->gas_gamma;
+
+  double rhol = app->rhol;
+  double ul = app->ul;
+  double pl = app->pl;
+
+  double rhor = app->rhor;
+  double ur = app->ur;
+  double pr = app->pr;
+
+  double rho = 0.0;
+  double u = 0.0;
+  double p = 0.0;
+
+  if (x < 0.75) {
+    rho = rhol; // Fluid mass density (left).
+    u = ul; // Fluid velocity (left).
+    p = pl; // Fluid pressure (left).
+  }
+  else {
+    rho = rhor; // Fluid mass density (right).
+    u = ur; // Fluid velocity (right).
+    p = pr; // Fluid pressure (right).
+  }
+  
+  // Set fluid mass density.
+  fout[0] = rho;
+  // Set fluid momentum density.
+  fout[1] = rho * u; fout[2] = 0.0; fout[3] = 0.0;
+  // Set fluid total energy density.
+  fout[4] = p / (gas_gamma - 1.0) + 0.5 * rho * u * u;
+}
+
+int main(int argc, char **argv)
+{
+  struct amr_euler_sodshock_ctx ctx = create_ctx(); // Context for initialization functions.
+
+  struct euler1d_dynamic_init init = {
+    .base_Nx = ctx.Nx,
+    .ref_factor = ctx.ref_factor,
+    .max_levels = ctx.max_levels,
+
+    .x1 = 0.25,
+    .x2 = 0.25 + ctx.Lx,
+
+    .eval = evalEulerInit,
+    .gas_gamma = ctx.gas_gamma,
+
+    .euler_output = "amr_euler_sodshock_dyn",
+
+    .low_order_flux = false,
+    .cfl_frac = ctx.cfl_frac,
+
+    .tag_threshold = ctx.tag_threshold,
+    .tag_buffer = ctx.tag_buffer,
+    .cluster_efficiency = ctx.cluster_efficiency,
+    .regrid_steps = ctx.regrid_steps,
+
+    .t_end = ctx.t_end,
+    .num_frames = ctx.num_frames,
+    .dt_failure_tol = ctx.dt_failure_tol,
+    .num_failures_max = ctx.num_failures_max,
+  };
+
+  euler1d_run_dynamic(argc, argv, &init);
+}
@@ -166,6 +166,8 @@ struct gkyl_moment {
 
   bool has_nT_sources;
 
+  int num_source_threads; // number of threads for implicit source update (0 or 1: serial)
+
   bool has_braginskii; // has Braginskii transport
   double coll_fac; // multiplicative collisionality factor for Braginskii  
 
@@ -259,7 +261,10 @@ struct gkyl_app_restart_status gkyl_moment_app_from_file_field(gkyl_moment_app *
   const char *fname);
 
 /**
- * Read species data from .gkyl file.
+ * Read species data from .gkyl file. For species whose static
+ * auxiliary variables (e.g. a GR spacetime) are stored apart, files
+ * holding the full state vector are also accepted; any other component
+ * count gives GKYL_ARRAY_RIO_DATA_MISMATCH.
  *
  * @param app App object.
  * @param sidx Index of species to read
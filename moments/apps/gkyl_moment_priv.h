@@ -131,6 +131,9 @@ struct moment_species {
   int num_equations;            // number of equations in species
   struct gkyl_wv_eqn *equation; // equation object
 
+  int num_aux; // number of static auxiliary variables (e.g. a static spacetime) stored apart from the evolved ones
+  struct gkyl_array *aux; // static auxiliary variables (NULL if num_aux is 0); projected in ghost cells too, never synced or written
+
   enum gkyl_moment_scheme scheme_type; // scheme to update equations
 
   // 
@@ -323,6 +326,8 @@ struct gkyl_moment_app {
   // scaling factors for collision frequencies so that nu_sr=nu_base_sr/rho_s
   // nu_rs=nu_base_rs/rho_r, and nu_base_sr=nu_base_rs
   double nu_base[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES];
+
+  int num_source_threads; // number of threads for implicit source update
 };
 
 // Meta-data for IO
@@ -401,6 +406,12 @@ void moment_species_init(const struct gkyl_moment *mom,
   struct gkyl_moment_app *app,
   struct moment_species *sp);
 
+// Project the full initial state of a species with static auxiliary
+// variables: the auxiliary variables are stored in sp->aux and, if fout
+// is not NULL, the evolved variables in fout
+void moment_species_project_aux(gkyl_moment_app *app,
+  struct moment_species *sp, double t0, struct gkyl_array *fout);
+
 // Apply BCs to species data "f"
 void moment_species_apply_bc(gkyl_moment_app *app, double tcurr,
   const struct moment_species *sp,
@@ -25,6 +25,7 @@ moment_coupling_init(const struct gkyl_moment_app *app, struct moment_coupling *
       .mass = app->species[i].mass,
       // If gradient-based or neural network-based closure is present, k0=0.0 in source solve to avoid applying local closure.
       .k0 = (app->species[i].has_grad_closure || app->species[i].has_nn_closure) ? 0.0 : app->species[i].k0,
+      .aux = app->species[i].aux,
     };
 
   src_inp.has_collision = app->has_collision;
@@ -159,6 +160,8 @@ moment_coupling_init(const struct gkyl_moment_app *app, struct moment_coupling *
   if (app->field.use_explicit_em_coupling)
     src_inp.use_explicit_em_coupling = 1;
 
+  src_inp.num_threads = app->num_source_threads;
+
   // create updater to solve for sources
   src->slvr = gkyl_moment_em_coupling_new(src_inp);
 
@@ -196,6 +199,7 @@ moment_coupling_init(const struct gkyl_moment_app *app, struct moment_coupling *
         .k0 = app->species[i].k0,
         .poly_order = app->species[i].poly_order,
         .ann = app->species[i].ann,
+        .num_threads = app->num_source_threads,
       };
       src->nn_closure_slvr[i] = gkyl_ten_moment_nn_closure_new(nn_closure_inp);
     }
@@ -1,6 +1,8 @@
+#include <gkyl_level_set.h>
 #include <gkyl_moment_priv.h>
 #include <gkyl_util.h>
 #include <gkyl_wv_euler.h>
+#include <gkyl_wv_gr_euler.h>
 
 // initialize species
 void
@@ -16,9 +18,17 @@ moment_species_init(const struct gkyl_moment *mom, const struct gkyl_moment_spec
   sp->init = mom_sp->init;
 
   sp->eqn_type = mom_sp->equation->type;
-  sp->num_equations = mom_sp->equation->num_equations;
   sp->equation = gkyl_wv_eqn_acquire(mom_sp->equation);
 
+  // A static spacetime never changes, so it is stored apart from the
+  // evolved fluid variables rather than being carried through the
+  // wave-propagation update, the BCs and the output
+  sp->num_aux = 0;
+  if (sp->eqn_type == GKYL_EQN_GR_EULER && mom->scheme_type == GKYL_MOMENT_WAVE_PROP)
+    sp->num_aux = gkyl_wv_gr_euler_num_static_spacetime(mom_sp->equation);
+  sp->num_equations = mom_sp->equation->num_equations - sp->num_aux;
+  sp->aux = sp->num_aux ? mkarr(false, sp->num_aux, app->local_ext.volume) : 0;
+
   // Do we need to update source terms for this fluid?
   // Sources can be electromagnetic fields, closure-related, applied accelerations
   // volume expansion, friction, reactivity, etc. 
@@ -131,6 +141,10 @@ moment_species_init(const struct gkyl_moment *mom, const struct gkyl_moment_spec
   int meqn = sp->num_equations;  
 
   if (sp->scheme_type == GKYL_MOMENT_WAVE_PROP) {
+    // band of cells that may need reinitialization, shared by the
+    // directional updaters as each sweeps the output of the previous one
+    struct gkyl_level_set_band *band = sp->aux ? 0 : gkyl_level_set_band_new(mom_sp->equation);
+    
     // create updaters for each directional update
     for (int d=0; d<ndim; ++d)
       sp->slvr[d] = gkyl_wave_prop_new( &(struct gkyl_wave_prop_inp) {
@@ -144,9 +158,13 @@ moment_species_init(const struct gkyl_moment *mom, const struct gkyl_moment_spec
           .update_dirs = { d },
           .cfl = app->cfl,
           .geom = app->geom,
-          .comm = app->comm
+          .comm = app->comm,
+          .aux = sp->aux,
+          .band = band,
         }
       );
+    if (band)
+      gkyl_level_set_band_release(band);
       
     sp->fdup = mkarr(false, meqn, app->local_ext.volume);
     // allocate arrays
@@ -320,6 +338,15 @@ moment_species_init(const struct gkyl_moment *mom, const struct gkyl_moment_spec
     }
   }
 
+  if (sp->aux) {
+    for (int d=0; d<app->ndim; ++d) {
+      if (sp->lower_bc[d])
+        gkyl_wv_apply_bc_set_aux(sp->lower_bc[d], sp->aux);
+      if (sp->upper_bc[d])
+        gkyl_wv_apply_bc_set_aux(sp->upper_bc[d], sp->aux);
+    }
+  }
+
   // allocate array for applied acceleration/forces for each species
   sp->app_accel = mkarr(false, 3, app->local_ext.volume);
   gkyl_array_clear(sp->app_accel, 0.0);
@@ -366,6 +393,27 @@ moment_species_init(const struct gkyl_moment *mom, const struct gkyl_moment_spec
   sp->is_first_q_write_call = true;
 }
 
+// project full initial state, splitting it into static auxiliary and
+// evolved variables
+void
+moment_species_project_aux(gkyl_moment_app *app, struct moment_species *sp,
+  double t0, struct gkyl_array *fout)
+{
+  // the auxiliary variables are projected in the ghost cells too, as
+  // BCs are only applied to the evolved variables
+  struct gkyl_array *qfull = mkarr(false, sp->equation->num_equations, app->local_ext.volume);
+  gkyl_fv_proj *proj = gkyl_fv_proj_new(&app->grid, 2, sp->equation->num_equations,
+    sp->init, sp->ctx);
+  gkyl_fv_proj_advance(proj, t0, &app->local_ext, qfull);
+  gkyl_fv_proj_release(proj);
+
+  gkyl_array_set_offset(sp->aux, 1.0, qfull, sp->num_equations);
+  if (fout)
+    gkyl_array_set_offset(fout, 1.0, qfull, 0);
+
+  gkyl_array_release(qfull);
+}
+
 // apply BCs to species
 void
 moment_species_apply_bc(gkyl_moment_app *app, double tcurr,
@@ -537,6 +585,8 @@ moment_species_release(const struct moment_species *sp)
   }
 
   gkyl_array_release(sp->bc_buffer);
+  if (sp->aux)
+    gkyl_array_release(sp->aux);
 
   gkyl_dynvec_release(sp->integ_q);
 }
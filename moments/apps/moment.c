@@ -113,7 +113,7 @@ gkyl_moment_app_new(struct gkyl_moment *mom)
   }
   else {
     // Create decomp.
-    app->decomp = gkyl_rect_decomp_new_from_cuts(app->ndim, mom->parallelism.cuts, &app->global);
+    app->decomp = app_decomp_new(&mom->parallelism, &app->grid, &app->global, &app->global_ext);
 
     // Create a new communicator with the decomposition in it.
     app->comm = gkyl_comm_split_comm(mom->parallelism.comm, 0, app->decomp);
@@ -198,6 +198,8 @@ gkyl_moment_app_new(struct gkyl_moment *mom)
     for (int r=0; r<app->num_species; ++r)
       app->nu_base[s][r] = mom->nu_base[s][r];
 
+  app->num_source_threads = mom->num_source_threads;
+
   // There are a significant number of options which necessitate the source solve in fluids
   // (e.g. applied acceleration, geometric sources, multi-species transport, electromagnetic coupling, etc.).
   // To facilitate these options, each fluid species stores a boolean for whether or not it will require a 
@@ -299,12 +301,17 @@ gkyl_moment_app_apply_ic_species(gkyl_moment_app* app, int sidx, double t0)
   assert(sidx < app->num_species);
 
   app->tcurr = t0;
-  int num_quad = app->scheme_type == GKYL_MOMENT_MP ? 4 : 2;  
-  gkyl_fv_proj *proj = gkyl_fv_proj_new(&app->grid, num_quad, app->species[sidx].num_equations,
-    app->species[sidx].init, app->species[sidx].ctx);
+  if (app->species[sidx].num_aux) {
+    moment_species_project_aux(app, &app->species[sidx], t0, app->species[sidx].fcurr);
+  }
+  else {
+    int num_quad = app->scheme_type == GKYL_MOMENT_MP ? 4 : 2;  
+    gkyl_fv_proj *proj = gkyl_fv_proj_new(&app->grid, num_quad, app->species[sidx].num_equations,
+      app->species[sidx].init, app->species[sidx].ctx);
   
-  gkyl_fv_proj_advance(proj, t0, &app->local, app->species[sidx].fcurr);
-  gkyl_fv_proj_release(proj);
+    gkyl_fv_proj_advance(proj, t0, &app->local, app->species[sidx].fcurr);
+    gkyl_fv_proj_release(proj);
+  }
 
   if (app->species[sidx].has_app_accel) {
     gkyl_fv_proj_advance(app->species[sidx].app_accel_proj, t0, &app->local, app->species[sidx].app_accel);
@@ -720,10 +727,12 @@ gkyl_moment_app_stat_write(const gkyl_moment_app* app)
   cstr_drop(&fileNm);
 }
 
+// Read header of file, checking it is on the app's grid. On success,
+// the number of components in the file is returned in ncomp
 static struct gkyl_app_restart_status
-header_from_file(gkyl_moment_app *app, const char *fname)
+header_from_file(gkyl_moment_app *app, const char *fname, int *ncomp)
 {
-  struct gkyl_app_restart_status rstat = { .io_status = 0 };
+  struct gkyl_app_restart_status rstat = { .io_status = GKYL_ARRAY_RIO_FOPEN_FAILED };
   
   FILE *fp = 0;
   with_file(fp, fname, "r") {
@@ -736,6 +745,7 @@ header_from_file(gkyl_moment_app *app, const char *fname)
         rstat.io_status = GKYL_ARRAY_RIO_DATA_MISMATCH;
       if (hdr.etype != GKYL_DOUBLE)
         rstat.io_status = GKYL_ARRAY_RIO_DATA_MISMATCH;
+      *ncomp = hdr.esznc/sizeof(double);
     }
 
     struct moment_output_meta meta =
@@ -764,7 +774,8 @@ gkyl_moment_app_from_file_field(gkyl_moment_app *app, const char *fname)
       .stime = 0.0
     };
 
-  struct gkyl_app_restart_status rstat = header_from_file(app, fname);
+  int ncomp = 0;
+  struct gkyl_app_restart_status rstat = header_from_file(app, fname, &ncomp);
 
   if (GKYL_ARRAY_RIO_SUCCESS == rstat.io_status) {
     rstat.io_status =
@@ -792,13 +803,38 @@ struct gkyl_app_restart_status
 gkyl_moment_app_from_file_species(gkyl_moment_app *app, int sidx,
   const char *fname)
 {
-  struct gkyl_app_restart_status rstat = header_from_file(app, fname);
+  struct moment_species *sp = &app->species[sidx];
+  int ncomp = 0;
+  struct gkyl_app_restart_status rstat = header_from_file(app, fname, &ncomp);
+
+  // Static auxiliary variables are not written out, so recompute them.
+  if (sp->num_aux) {
+    moment_species_project_aux(app, sp, rstat.stime, 0);
+  }
   
   if (GKYL_ARRAY_RIO_SUCCESS == rstat.io_status) {
-    rstat.io_status =
-      gkyl_comm_array_read(app->comm, &app->grid, &app->local, app->species[sidx].fcurr, fname);
+    if (sp->num_aux && ncomp == sp->fcurr->ncomp + sp->num_aux) {
+      // Frame written with the auxiliary variables in the state vector
+      // (e.g. a GR spacetime): keep only the evolved variables.
+      struct gkyl_array *ffull = mkarr(false, ncomp, app->local_ext.volume);
+      rstat.io_status =
+        gkyl_comm_array_read(app->comm, &app->grid, &app->local, ffull, fname);
+      if (GKYL_ARRAY_RIO_SUCCESS == rstat.io_status)
+        gkyl_array_set_offset(sp->fcurr, 1.0, ffull, 0);
+      gkyl_array_release(ffull);
+    }
+    else if (ncomp != sp->fcurr->ncomp) {
+      gkyl_moment_app_cout(app, stderr,
+        "Restart of species '%s' from '%s': file has %d components, expected %d\n",
+        sp->name, fname, ncomp, sp->fcurr->ncomp);
+      rstat.io_status = GKYL_ARRAY_RIO_DATA_MISMATCH;
+    }
+    else {
+      rstat.io_status =
+        gkyl_comm_array_read(app->comm, &app->grid, &app->local, sp->fcurr, fname);
+    }
     if (GKYL_ARRAY_RIO_SUCCESS == rstat.io_status) {
-      moment_species_apply_bc(app, rstat.stime, &app->species[sidx], app->species[sidx].fcurr);
+      moment_species_apply_bc(app, rstat.stime, sp, sp->fcurr);
     }
   }
 
@@ -0,0 +1,253 @@
+#include <acutest.h>
+#include <math.h>
+
+#include <gkyl_amr_dynamic_priv.h>
+
+static void
+eval_sod(double t, const double* GKYL_RESTRICT xn, double* GKYL_RESTRICT fout, void* ctx)
+{
+  double gas_gamma = 1.4;
+  double x = xn[0];
+
+  double rho = x < 0.5 ? 3.0 : 1.0;
+  double p = x < 0.5 ? 3.0 : 1.0;
+
+  fout[0] = rho;
+  fout[1] = 0.0; fout[2] = 0.0; fout[3] = 0.0;
+  fout[4] = p / (gas_gamma - 1.0);
+}
+
+static void
+eval_riem_2d(double t, const double* GKYL_RESTRICT xn, double* GKYL_RESTRICT fout, void* ctx)
+{
+  double gas_gamma = 1.4;
+  double x = xn[0], y = xn[1];
+
+  double r2 = (x - 0.5) * (x - 0.5) + (y - 0.5) * (y - 0.5);
+  double rho = r2 < 0.04 ? 2.0 : 1.0;
+  double p = r2 < 0.04 ? 4.0 : 1.0;
+
+  fout[0] = rho;
+  fout[1] = 0.0; fout[2] = 0.0; fout[3] = 0.0;
+  fout[4] = p / (gas_gamma - 1.0);
+}
+
+static void
+eval_ten_moment(double t, const double* GKYL_RESTRICT xn, double* GKYL_RESTRICT fout, void* ctx)
+{
+  double x = xn[0];
+
+  double rho = x < 0.5 ? 1.0 : 0.125;
+  double p = x < 0.5 ? 1.0 : 0.1;
+
+  fout[0] = rho;
+  fout[1] = 0.0; fout[2] = 0.0; fout[3] = 0.0;
+  fout[4] = p; fout[5] = 0.0; fout[6] = 0.0;
+  fout[7] = p; fout[8] = 0.0;
+  fout[9] = p;
+}
+
+static void
+test_cluster(void)
+{
+  struct gkyl_range box;
+  gkyl_range_init(&box, 2, (int[]) { 1, 1 }, (int[]) { 16, 16 });
+
+  // Two separate blocks of tagged cells.
+  char *tags = gkyl_calloc(box.volume, sizeof(char));
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &box);
+  while (gkyl_range_iter_next(&iter)) {
+    int i = iter.idx[0], j = iter.idx[1];
+    if (((i >= 2) && (i <= 4) && (j >= 3) && (j <= 6)) || ((i >= 10) && (i <= 15) && (j >= 11) && (j <= 12))) {
+      tags[gkyl_range_idx(&box, iter.idx)] = 1;
+    }
+  }
+
+  int num_clusters;
+  struct gkyl_range *clusters = amr_dyn_cluster(&box, tags, 0.7, &num_clusters);
+
+  TEST_CHECK( num_clusters == 2 );
+
+  long vol = 0;
+  for (int c = 0; c < num_clusters; c++) {
+    vol += clusters[c].volume;
+  }
+  TEST_CHECK( vol == 12 + 12 );
+
+  // Every tagged cell must be covered by some cluster.
+  gkyl_range_iter_init(&iter, &box);
+  while (gkyl_range_iter_next(&iter)) {
+    if (tags[gkyl_range_idx(&box, iter.idx)]) {
+      bool covered = false;
+      for (int c = 0; c < num_clusters; c++) {
+        covered = covered || gkyl_range_contains_idx(&clusters[c], iter.idx);
+      }
+      TEST_CHECK( covered );
+    }
+  }
+
+  gkyl_free(clusters);
+  gkyl_free(tags);
+}
+
+static void
+test_conservation(struct gkyl_wv_eqn* eqn, int ndim, evalf_t eval, int num_steps)
+{
+  struct amr_dyn_inp inp = {
+    .ndim = ndim,
+    .lower = { 0.0, 0.0 },
+    .upper = { 1.0, 1.0 },
+    .base_cells = { 32, 32 },
+    .max_levels = 3,
+    .ref_factor = 2,
+    .eqn = eqn,
+    .cfl_frac = 0.9,
+    .eval = eval,
+    .wall = { true, true },
+    .tag_comp = 0,
+    .tag_threshold = 0.02,
+    .tag_buffer = 2,
+    .cluster_efficiency = 0.7,
+    .regrid_steps = 2,
+  };
+
+  struct amr_dyn_hierarchy *hier = amr_dyn_hierarchy_new(&inp);
+  TEST_CHECK( hier->num_levels == 3 );
+
+  int meqn = eqn->num_equations;
+  double tot0[meqn];
+  for (int m = 0; m < meqn; m++) {
+    tot0[m] = amr_dyn_integrate(hier, m);
+  }
+
+  // Regridding in place (without any time-steps) redistributes, but does not change, the conserved totals.
+  amr_dyn_regrid(hier, 0.0);
+  for (int m = 0; m < meqn; m++) {
+    TEST_CHECK( gkyl_compare_double(tot0[m], amr_dyn_integrate(hier, m), 1.0e-12) );
+  }
+
+  struct gkyl_job_pool *job_pool = gkyl_thread_pool_new(1);
+  struct sim_stats stats = { };
+
+  double t_curr = 0.0;
+  double dt = amr_dyn_max_dt(hier);
+  for (int step = 0; step < num_steps; step++) {
+    struct gkyl_update_status status = amr_dyn_update(job_pool, hier, t_curr, dt, &stats);
+    TEST_CHECK( status.success );
+
+    t_curr += status.dt_actual;
+    dt = status.dt_suggested;
+  }
+
+  TEST_CHECK( hier->num_levels > 1 );
+
+  // There is no refluxing at coarse-fine interfaces, so conservation only holds approximately. Walls keep the mass
+  // and energy inside the domain.
+  double rho_tot = amr_dyn_integrate(hier, 0);
+  TEST_CHECK( fabs(rho_tot - tot0[0]) < 1.0e-3 * fabs(tot0[0]) );
+  TEST_MSG( "Expected: %.15e, Got: %.15e", tot0[0], rho_tot );
+
+  // The solution must stay physical (positive density) on every patch.
+  for (int l = 0; l < hier->num_levels; l++) {
+    for (int i = 0; i < hier->levels[l].num_patches; i++) {
+      const struct amr_dyn_patch *patch = &hier->levels[l].patches[i];
+
+      struct gkyl_range_iter iter;
+      gkyl_range_iter_init(&iter, &patch->range);
+      while (gkyl_range_iter_next(&iter)) {
+        const double *q = gkyl_array_cfetch(patch->f[0], gkyl_range_idx(&patch->ext_range, iter.idx));
+        TEST_CHECK( q[0] > 0.0 );
+      }
+    }
+  }
+
+  gkyl_job_pool_release(job_pool);
+  amr_dyn_hierarchy_release(hier);
+}
+
+static void
+test_euler_1d(void)
+{
+  struct gkyl_wv_eqn *euler = gkyl_wv_euler_new(1.4, false);
+  test_conservation(euler, 1, eval_sod, 40);
+  gkyl_wv_eqn_release(euler);
+}
+
+static void
+test_euler_2d(void)
+{
+  struct gkyl_wv_eqn *euler = gkyl_wv_euler_new(1.4, false);
+  test_conservation(euler, 2, eval_riem_2d, 10);
+  gkyl_wv_eqn_release(euler);
+}
+
+static void
+test_ten_moment_1d(void)
+{
+  struct gkyl_wv_eqn *ten_moment = gkyl_wv_ten_moment_new(0.0, false, false, 0, 0, false);
+  test_conservation(ten_moment, 1, eval_ten_moment, 40);
+  gkyl_wv_eqn_release(ten_moment);
+}
+
+static void
+test_track_shock(void)
+{
+  struct gkyl_wv_eqn *euler = gkyl_wv_euler_new(1.4, false);
+
+  struct amr_dyn_inp inp = {
+    .ndim = 1,
+    .lower = { 0.0 },
+    .upper = { 1.0 },
+    .base_cells = { 64 },
+    .max_levels = 2,
+    .ref_factor = 2,
+    .eqn = euler,
+    .cfl_frac = 0.9,
+    .eval = eval_sod,
+    .tag_comp = 0,
+    .tag_threshold = 0.05,
+    .tag_buffer = 2,
+    .cluster_efficiency = 0.7,
+    .regrid_steps = 1,
+  };
+
+  struct amr_dyn_hierarchy *hier = amr_dyn_hierarchy_new(&inp);
+
+  struct gkyl_job_pool *job_pool = gkyl_thread_pool_new(1);
+  struct sim_stats stats = { };
+
+  double t_curr = 0.0;
+  double dt = amr_dyn_max_dt(hier);
+  while (t_curr < 0.1) {
+    struct gkyl_update_status status = amr_dyn_update(job_pool, hier, t_curr, fmin(dt, 0.1 - t_curr), &stats);
+    t_curr += status.dt_actual;
+    dt = status.dt_suggested;
+  }
+
+  // The shock has moved right, to x ~ 0.5 + 0.1 * 1.45; the fine level must follow it.
+  double x_shock = 0.5 + 0.1 * 1.45;
+  TEST_CHECK( hier->num_levels == 2 );
+
+  bool covered = false;
+  const struct amr_dyn_level *flev = &hier->levels[1];
+  for (int i = 0; i < flev->num_patches; i++) {
+    double xl = flev->grid.lower[0] + (flev->patches[i].range.lower[0] - 1) * flev->grid.dx[0];
+    double xu = flev->grid.lower[0] + flev->patches[i].range.upper[0] * flev->grid.dx[0];
+    covered = covered || ((xl < x_shock) && (xu > x_shock));
+  }
+  TEST_CHECK( covered );
+
+  gkyl_job_pool_release(job_pool);
+  amr_dyn_hierarchy_release(hier);
+  gkyl_wv_eqn_release(euler);
+}
+
+TEST_LIST = {
+  { "test_cluster", test_cluster },
+  { "test_euler_1d", test_euler_1d },
+  { "test_euler_2d", test_euler_2d },
+  { "test_ten_moment_1d", test_ten_moment_1d },
+  { "test_track_shock", test_track_shock },
+  { NULL, NULL },
+};
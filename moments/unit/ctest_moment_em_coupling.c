@@ -0,0 +1,241 @@
+#include <acutest.h>
+
+#include <gkyl_array.h>
+#include <gkyl_mat.h>
+#include <gkyl_moment_em_coupling.h>
+#include <gkyl_moment_em_coupling_priv.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_grid.h>
+
+static double
+rand_in(double lo, double hi)
+{
+  return lo + (hi - lo)*rand()/(double) RAND_MAX;
+}
+
+static struct gkyl_moment_em_coupling_inp
+collision_inp(const struct gkyl_rect_grid *grid, int nfluids, double charge)
+{
+  struct gkyl_moment_em_coupling_inp inp = {
+    .grid = grid,
+    .nfluids = nfluids,
+    .epsilon0 = 1.0,
+    .mu0 = 1.0,
+    .has_collision = true,
+  };
+  for (int i=0; i<nfluids; ++i) {
+    inp.param[i] = (struct gkyl_moment_em_coupling_data) {
+      .type = GKYL_EQN_EULER,
+      .charge = i % 2 ? charge : -charge,
+      .mass = rand_in(0.5, 4.0),
+    };
+    for (int j=0; j<i; ++j)
+      inp.nu_base[i][j] = inp.nu_base[j][i] = rand_in(0.5, 2.0);
+  }
+  return inp;
+}
+
+static void
+rand_euler(double f[5])
+{
+  f[0] = rand_in(0.5, 2.0);
+  for (int d=0; d<3; ++d)
+    f[1+d] = f[0]*rand_in(-1.0, 1.0);
+  f[4] = rand_in(2.0, 4.0) + 0.5*(f[1]*f[1] + f[2]*f[2] + f[3]*f[3])/f[0];
+}
+
+// Reference collision update, solving the linear systems with LAPACK.
+static void
+ref_collision_update(const struct gkyl_moment_em_coupling_inp *inp, double dt, double fluid[][5])
+{
+  int n = inp->nfluids;
+  double nu[n][n], u[n][3], T[n];
+  for (int i=0; i<n; ++i)
+    for (int j=0; j<n; ++j)
+      nu[i][j] = inp->nu_base[i][j]*fluid[j][0];
+
+  struct gkyl_mat *lhs = gkyl_mat_new(n, n, 0.0);
+  struct gkyl_mat *rhs = gkyl_mat_new(n, 3, 0.0);
+  for (int i=0; i<n; ++i) {
+    for (int d=0; d<3; ++d)
+      gkyl_mat_set(rhs, i, d, fluid[i][1+d]/fluid[i][0]);
+    double diag = 1.0;
+    for (int j=0; j<n; ++j) {
+      diag += 0.5*dt*nu[i][j];
+      if (i != j)
+        gkyl_mat_set(lhs, i, j, -0.5*dt*nu[i][j]);
+    }
+    gkyl_mat_set(lhs, i, i, diag);
+  }
+  long ipiv[n];
+  gkyl_mat_linsolve_lu(lhs, rhs, ipiv);
+  for (int i=0; i<n; ++i)
+    for (int d=0; d<3; ++d)
+      u[i][d] = gkyl_mat_get(rhs, i, d);
+
+  struct gkyl_mat *lhs_T = gkyl_mat_new(n, n, 0.0);
+  struct gkyl_mat *rhs_T = gkyl_mat_new(n, 1, 0.0);
+  for (int i=0; i<n; ++i) {
+    double m = inp->param[i].mass, *f = fluid[i];
+    T[i] = (f[4] - 0.5*(f[1]*f[1] + f[2]*f[2] + f[3]*f[3])/f[0])/f[0]*m;
+    double diag = 1.0, r = T[i];
+    for (int j=0; j<n; ++j) {
+      if (i == j) continue;
+      double m_j = inp->param[j].mass;
+      double du_sq = 0.0;
+      for (int d=0; d<3; ++d)
+        du_sq += (u[i][d] - u[j][d])*(u[i][d] - u[j][d]);
+      double coeff = dt*nu[i][j]*m/(m + m_j);
+      r += 0.5*coeff*m_j*du_sq;
+      diag += coeff;
+      gkyl_mat_set(lhs_T, i, j, -coeff);
+    }
+    gkyl_mat_set(lhs_T, i, i, diag);
+    gkyl_mat_set(rhs_T, i, 0, r);
+  }
+  gkyl_mat_linsolve_lu(lhs_T, rhs_T, ipiv);
+
+  for (int i=0; i<n; ++i) {
+    double *f = fluid[i], m = inp->param[i].mass;
+    f[4] = (2.0*gkyl_mat_get(rhs_T, i, 0) - T[i])*f[0]/m;
+    for (int d=0; d<3; ++d)
+      f[1+d] = 2.0*f[0]*u[i][d] - f[1+d];
+    f[4] += 0.5*(f[1]*f[1] + f[2]*f[2] + f[3]*f[3])/f[0];
+  }
+
+  gkyl_mat_release(lhs);
+  gkyl_mat_release(rhs);
+  gkyl_mat_release(lhs_T);
+  gkyl_mat_release(rhs_T);
+}
+
+static void
+test_collision(int nfluids)
+{
+  srand(nfluids);
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, 1, (double[]) { 0.0 }, (double[]) { 1.0 }, (int[]) { 1 });
+  struct gkyl_moment_em_coupling_inp inp = collision_inp(&grid, nfluids, 0.0);
+  gkyl_moment_em_coupling *mom_em = gkyl_moment_em_coupling_new(inp);
+
+  double dt = 0.3;
+  double fluid[GKYL_MAX_SPECIES][5], fluid_ref[GKYL_MAX_SPECIES][5];
+  double *fluid_s[GKYL_MAX_SPECIES];
+  for (int i=0; i<nfluids; ++i) {
+    rand_euler(fluid[i]);
+    for (int k=0; k<5; ++k) fluid_ref[i][k] = fluid[i][k];
+    fluid_s[i] = fluid[i];
+  }
+
+  double mom_old[3] = { 0.0 };
+  for (int i=0; i<nfluids; ++i)
+    for (int d=0; d<3; ++d)
+      mom_old[d] += fluid[i][1+d];
+
+  implicit_collision_source_update(mom_em, dt, fluid_s);
+  ref_collision_update(&inp, dt, fluid_ref);
+
+  for (int i=0; i<nfluids; ++i) {
+    for (int k=0; k<5; ++k) {
+      TEST_CHECK( gkyl_compare_double(fluid[i][k], fluid_ref[i][k], 1e-12) );
+      TEST_MSG("nfluids %d, fluid %d, component %d: %.15e vs %.15e", nfluids, i, k, fluid[i][k], fluid_ref[i][k]);
+    }
+  }
+
+  // Collisions conserve total momentum.
+  double mom_new[3] = { 0.0 };
+  for (int i=0; i<nfluids; ++i)
+    for (int d=0; d<3; ++d)
+      mom_new[d] += fluid[i][1+d];
+  for (int d=0; d<3; ++d)
+    TEST_CHECK( fabs(mom_new[d] - mom_old[d]) < 1e-12 );
+
+  gkyl_moment_em_coupling_release(mom_em);
+}
+
+void test_collision_1() { test_collision(1); }
+void test_collision_2() { test_collision(2); }
+void test_collision_3() { test_collision(3); }
+void test_collision_4() { test_collision(4); }
+void test_collision_6() { test_collision(6); }
+
+void
+test_threaded_advance()
+{
+  int nfluids = 3;
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, 2, (double[]) { 0.0, 0.0 }, (double[]) { 1.0, 1.0 }, (int[]) { 13, 11 });
+  struct gkyl_range range;
+  gkyl_range_init_from_shape(&range, 2, grid.cells);
+
+  srand(7);
+  struct gkyl_moment_em_coupling_inp inp = collision_inp(&grid, nfluids, 1.0);
+  gkyl_moment_em_coupling *serial = gkyl_moment_em_coupling_new(inp);
+  inp.num_threads = 3;
+  gkyl_moment_em_coupling *threaded = gkyl_moment_em_coupling_new(inp);
+
+  struct gkyl_array *fluid[2][GKYL_MAX_SPECIES], *em[2];
+  const struct gkyl_array *app_accel[GKYL_MAX_SPECIES], *p_rhs[GKYL_MAX_SPECIES], *nT_sources[GKYL_MAX_SPECIES];
+  struct gkyl_array *zero5 = gkyl_array_new(GKYL_DOUBLE, 5, range.volume);
+  struct gkyl_array *zero3 = gkyl_array_new(GKYL_DOUBLE, 3, range.volume);
+  struct gkyl_array *zero8 = gkyl_array_new(GKYL_DOUBLE, 8, range.volume);
+  for (int i=0; i<nfluids; ++i) {
+    fluid[0][i] = gkyl_array_new(GKYL_DOUBLE, 5, range.volume);
+    for (long c=0; c<range.volume; ++c)
+      rand_euler(gkyl_array_fetch(fluid[0][i], c));
+    fluid[1][i] = gkyl_array_new(GKYL_DOUBLE, 5, range.volume);
+    gkyl_array_copy(fluid[1][i], fluid[0][i]);
+    app_accel[i] = zero3;
+    p_rhs[i] = zero5;
+    nT_sources[i] = zero5;
+  }
+  em[0] = gkyl_array_new(GKYL_DOUBLE, 8, range.volume);
+  double *em_d = em[0]->data;
+  for (long k=0; k<8*range.volume; ++k)
+    em_d[k] = rand_in(-1.0, 1.0);
+  em[1] = gkyl_array_new(GKYL_DOUBLE, 8, range.volume);
+  gkyl_array_copy(em[1], em[0]);
+
+  for (int s=0; s<3; ++s) {
+    gkyl_moment_em_coupling_implicit_advance(serial, 0.1*s, 0.1, &range, fluid[0], app_accel, p_rhs, em[0],
+      zero3, zero8, nT_sources);
+    gkyl_moment_em_coupling_implicit_advance(threaded, 0.1*s, 0.1, &range, fluid[1], app_accel, p_rhs, em[1],
+      zero3, zero8, nT_sources);
+  }
+
+  // Cells are independent, so the threaded update is identical to the serial one.
+  for (int i=0; i<nfluids; ++i) {
+    const double *f0 = fluid[0][i]->data, *f1 = fluid[1][i]->data;
+    long ndiff = 0;
+    for (long k=0; k<5*range.volume; ++k)
+      ndiff += f0[k] != f1[k];
+    TEST_CHECK( ndiff == 0 );
+  }
+  const double *e0 = em[0]->data, *e1 = em[1]->data;
+  long ndiff = 0;
+  for (long k=0; k<8*range.volume; ++k)
+    ndiff += e0[k] != e1[k];
+  TEST_CHECK( ndiff == 0 );
+
+  for (int i=0; i<nfluids; ++i) {
+    gkyl_array_release(fluid[0][i]);
+    gkyl_array_release(fluid[1][i]);
+  }
+  gkyl_array_release(em[0]);
+  gkyl_array_release(em[1]);
+  gkyl_array_release(zero3);
+  gkyl_array_release(zero5);
+  gkyl_array_release(zero8);
+  gkyl_moment_em_coupling_release(serial);
+  gkyl_moment_em_coupling_release(threaded);
+}
+
+TEST_LIST = {
+  { "test_collision_1", test_collision_1 },
+  { "test_collision_2", test_collision_2 },
+  { "test_collision_3", test_collision_3 },
+  { "test_collision_4", test_collision_4 },
+  { "test_collision_6", test_collision_6 },
+  { "test_threaded_advance", test_threaded_advance },
+  { NULL, NULL },
+};
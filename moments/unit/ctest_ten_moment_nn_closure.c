@@ -0,0 +1,220 @@
+#include <acutest.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_array.h>
+#include <gkyl_array_ops.h>
+#include <gkyl_moment_non_ideal_priv.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_decomp.h>
+#include <gkyl_rect_grid.h>
+#include <gkyl_ten_moment_nn_closure.h>
+#include <gkyl_ten_moment_nn_closure_priv.h>
+
+static kann_t*
+make_ann(int n_in, int n_out, int width, int depth)
+{
+  kad_node_t *t = kann_layer_input(n_in);
+  for (int i = 0; i < depth; i++) {
+    t = kann_layer_dense(t, width);
+    t = kad_tanh(t);
+  }
+  t = kann_layer_cost(t, n_out, KANN_C_MSE);
+
+  return kann_new(t, 0);
+}
+
+static void
+test_dense_net(int n_in, int n_out, int ntile)
+{
+  kann_srand(n_in);
+  kann_t *ann = make_ann(n_in, n_out, 16, 2);
+
+  struct nn_dense_net *net = nn_dense_net_new(ann);
+  TEST_CHECK( net != 0 );
+  TEST_CHECK( net->num_layers == 3 );
+  TEST_CHECK( net->layers[0].n_in == n_in );
+  TEST_CHECK( net->layers[2].n_out == n_out );
+  TEST_CHECK( net->layers[0].act == NN_ACT_TANH );
+  TEST_CHECK( net->layers[2].act == NN_ACT_NONE );
+
+  struct nn_tile_mem *mem = nn_tile_mem_new(n_in, n_out, net);
+
+  srand(ntile);
+  for (int k = 0; k < ntile * n_in; k++) {
+    mem->input_data[k] = 2.0 * ((double) rand() / RAND_MAX) - 1.0;
+  }
+
+  nn_dense_net_apply(net, mem, ntile);
+
+  // The batched evaluation must give the same outputs as kann, to float precision.
+  for (int c = 0; c < ntile; c++) {
+    const float *out = kann_apply1(ann, &mem->input_data[c * n_in]);
+    for (int o = 0; o < n_out; o++) {
+      TEST_CHECK( fabs(mem->output_data[(c * n_out) + o] - out[o]) < 1.0e-5 * (1.0 + fabs(out[o])) );
+    }
+  }
+
+  nn_tile_mem_release(mem);
+  nn_dense_net_release(net);
+  kann_delete(ann);
+}
+
+static void
+test_dense_net_1x(void)
+{
+  test_dense_net(6, 4, NN_TILE_SIZE);
+}
+
+static void
+test_dense_net_2x(void)
+{
+  test_dense_net(12, 8, 37);
+}
+
+static void
+test_unsupported_net(void)
+{
+  // A network with a matrix product is not a plain dense network.
+  kad_node_t *t = kann_layer_input(6);
+  t = kad_relu(kad_matmul(t, kann_new_weight(6, 4)));
+  t = kann_layer_cost(t, 4, KANN_C_MSE);
+  kann_t *ann = kann_new(t, 0);
+
+  TEST_CHECK( nn_dense_net_new(ann) == 0 );
+
+  kann_delete(ann);
+}
+
+static void
+eval_fluid(const double* xn, double* fluid, double* em)
+{
+  double x = xn[0], y = xn[1];
+
+  double rho = 1.0 + 0.2 * sin(2.0 * M_PI * x) * cos(2.0 * M_PI * y);
+  double ux = 0.1 * cos(2.0 * M_PI * x), uy = 0.05 * sin(2.0 * M_PI * y), uz = 0.02;
+  double pxx = 1.0 + 0.1 * cos(2.0 * M_PI * (x + y)), pyy = 0.8 + 0.1 * sin(2.0 * M_PI * x), pzz = 0.9;
+  double pxy = 0.05 * sin(2.0 * M_PI * y), pxz = 0.01, pyz = 0.02 * cos(2.0 * M_PI * x);
+
+  fluid[RHO] = rho;
+  fluid[MX] = rho * ux; fluid[MY] = rho * uy; fluid[MZ] = rho * uz;
+  fluid[P11] = pxx + (rho * ux * ux); fluid[P12] = pxy + (rho * ux * uy); fluid[P13] = pxz + (rho * ux * uz);
+  fluid[P22] = pyy + (rho * uy * uy); fluid[P23] = pyz + (rho * uy * uz); fluid[P33] = pzz + (rho * uz * uz);
+
+  for (int i = 0; i < 8; i++) {
+    em[i] = 0.0;
+  }
+  em[BX] = 1.0 + 0.3 * sin(2.0 * M_PI * y);
+  em[BY] = 0.5 * cos(2.0 * M_PI * x);
+  em[BZ] = 0.2;
+}
+
+static void
+test_advance(int ndim)
+{
+  int poly_order = 1;
+  int n_in = ndim == 1 ? 6 : 12, n_out = ndim == 1 ? 4 : 8;
+  int cells[] = { 48, 40 };
+
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, ndim, (double[]) { 0.0, 0.0 }, (double[]) { 1.0, 1.0 }, cells);
+
+  struct gkyl_range local, local_ext, non_ideal_local, non_ideal_local_ext;
+  gkyl_create_grid_ranges(&grid, (int[]) { 2, 2 }, &local_ext, &local);
+  gkyl_create_ranges(&local, (int[]) { 1, 1 }, &non_ideal_local_ext, &non_ideal_local);
+
+  struct gkyl_array *fluid = gkyl_array_new(GKYL_DOUBLE, 10, local_ext.volume);
+  struct gkyl_array *em_tot = gkyl_array_new(GKYL_DOUBLE, 8, local_ext.volume);
+  struct gkyl_array *heat_flux = gkyl_array_new(GKYL_DOUBLE, 10, non_ideal_local_ext.volume);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &local_ext);
+  while (gkyl_range_iter_next(&iter)) {
+    double xc[GKYL_MAX_DIM] = { 0.0 };
+    gkyl_rect_grid_cell_center(&grid, iter.idx, xc);
+
+    long loc = gkyl_range_idx(&local_ext, iter.idx);
+    eval_fluid(xc, gkyl_array_fetch(fluid, loc), gkyl_array_fetch(em_tot, loc));
+  }
+
+  kann_srand(ndim);
+  kann_t *ann = make_ann(n_in, n_out, 16, 2);
+
+  // Reference: the same updater, with the network evaluated cell by cell by kann.
+  struct gkyl_array *rhs[3];
+  for (int k = 0; k < 3; k++) {
+    rhs[k] = gkyl_array_new(GKYL_DOUBLE, 10, local_ext.volume);
+    gkyl_array_clear(rhs[k], 0.0);
+
+    struct gkyl_ten_moment_nn_closure_inp inp = {
+      .grid = &grid,
+      .poly_order = poly_order,
+      .k0 = 1.0,
+      .ann = ann,
+      .num_threads = k == 2 ? 3 : 1,
+    };
+    gkyl_ten_moment_nn_closure *nnclosure = gkyl_ten_moment_nn_closure_new(inp);
+    TEST_CHECK( nnclosure->net != 0 );
+
+    if (k == 0) {
+      nn_dense_net_release(nnclosure->net);
+      nnclosure->net = 0;
+    }
+
+    gkyl_ten_moment_nn_closure_advance(nnclosure, &non_ideal_local_ext, &local, fluid, em_tot, heat_flux, rhs[k]);
+    gkyl_ten_moment_nn_closure_release(nnclosure);
+  }
+
+  double rhs_max = 0.0;
+  gkyl_range_iter_init(&iter, &local);
+  while (gkyl_range_iter_next(&iter)) {
+    const double *r = gkyl_array_cfetch(rhs[0], gkyl_range_idx(&local, iter.idx));
+    for (int m = 0; m < 10; m++) {
+      rhs_max = fmax(rhs_max, fabs(r[m]));
+    }
+  }
+  TEST_CHECK( rhs_max > 0.0 );
+
+  gkyl_range_iter_init(&iter, &local);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&local, iter.idx);
+    const double *r0 = gkyl_array_cfetch(rhs[0], loc);
+    const double *r1 = gkyl_array_cfetch(rhs[1], loc);
+    const double *r2 = gkyl_array_cfetch(rhs[2], loc);
+
+    for (int m = 0; m < 10; m++) {
+      TEST_CHECK( fabs(r1[m] - r0[m]) < 1.0e-4 * rhs_max );
+      TEST_CHECK( fabs(r2[m] - r1[m]) < 1.0e-12 * rhs_max );
+    }
+  }
+
+  for (int k = 0; k < 3; k++) {
+    gkyl_array_release(rhs[k]);
+  }
+  gkyl_array_release(fluid);
+  gkyl_array_release(em_tot);
+  gkyl_array_release(heat_flux);
+  kann_delete(ann);
+}
+
+static void
+test_advance_1x(void)
+{
+  test_advance(1);
+}
+
+static void
+test_advance_2x(void)
+{
+  test_advance(2);
+}
+
+TEST_LIST = {
+  { "test_dense_net_1x", test_dense_net_1x },
+  { "test_dense_net_2x", test_dense_net_2x },
+  { "test_unsupported_net", test_unsupported_net },
+  { "test_advance_1x", test_advance_1x },
+  { "test_advance_2x", test_advance_2x },
+  { NULL, NULL },
+};
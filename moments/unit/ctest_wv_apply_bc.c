@@ -422,10 +422,75 @@ test_bc_buff_rtheta()
   gkyl_array_release(bc_buffer);
 }
 
+static void
+bc_aux(const struct gkyl_wv_eqn* eqn, double t, int nc, const double *skin, double *restrict ghost, void *ctx)
+{
+  // BC sees the full state, including the auxiliary variables
+  for (int c=0; c<nc; ++c) ghost[c] = skin[c];
+  ghost[0] = skin[0] + skin[4];
+  ghost[1] = -skin[1];
+}
+
+void
+test_aux()
+{
+  int ndim = 1;
+  double lower[] = {-1.0}, upper[] = {1.0};
+  int cells[] = {16};
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, ndim, lower, upper, cells);
+
+  int nghost[GKYL_MAX_DIM] = { 2 };
+  struct gkyl_range range, ext_range;
+  gkyl_create_grid_ranges(&grid, nghost, &ext_range, &range);
+
+  struct gkyl_wave_geom *wg = gkyl_wave_geom_new(&grid, &ext_range, nomapc2p, &ndim, false);
+  struct gkyl_wv_eqn *eqn = gkyl_wv_euler_new(1.4, false);
+
+  gkyl_wv_apply_bc *lbc = gkyl_wv_apply_bc_new(&grid, eqn, wg,
+    0, GKYL_LOWER_EDGE, nghost, bc_aux, NULL);
+  gkyl_wv_apply_bc *rbc = gkyl_wv_apply_bc_new(&grid, eqn, wg,
+    0, GKYL_UPPER_EDGE, nghost, bc_aux, NULL);
+
+  // density and x-momentum are evolved, the rest of the state is auxiliary
+  struct gkyl_array *fluid = gkyl_array_new(GKYL_DOUBLE, 2, ext_range.volume);
+  struct gkyl_array *aux = gkyl_array_new(GKYL_DOUBLE, 3, ext_range.volume);
+  gkyl_wv_apply_bc_set_aux(lbc, aux);
+  gkyl_wv_apply_bc_set_aux(rbc, aux);
+
+  for (long i=0; i<ext_range.volume; ++i) {
+    double *q = gkyl_array_fetch(fluid, i), *a = gkyl_array_fetch(aux, i);
+    q[0] = 1.0 + i; q[1] = 0.5 + i;
+    a[0] = 0.0; a[1] = 0.0; a[2] = 10.0 + i;
+  }
+
+  gkyl_wv_apply_bc_advance(lbc, 0.0, &range, fluid);
+  gkyl_wv_apply_bc_advance(rbc, 0.0, &range, fluid);
+
+  // ghost cells 0, 1 mirror skin cells 3, 2; 18, 19 mirror 17, 16
+  int ghost[] = { 0, 1, 18, 19 }, skin[] = { 3, 2, 17, 16 };
+  for (int k=0; k<4; ++k) {
+    const double *q = gkyl_array_cfetch(fluid, ghost[k]);
+    const double *a = gkyl_array_cfetch(aux, ghost[k]);
+    TEST_CHECK( q[0] == (1.0 + skin[k]) + (10.0 + skin[k]) );
+    TEST_CHECK( q[1] == -(0.5 + skin[k]) );
+    // auxiliary variables are left alone
+    TEST_CHECK( a[2] == 10.0 + ghost[k] );
+  }
+
+  gkyl_wv_apply_bc_release(lbc);
+  gkyl_wv_apply_bc_release(rbc);
+  gkyl_wv_eqn_release(eqn);
+  gkyl_wave_geom_release(wg);
+  gkyl_array_release(fluid);
+  gkyl_array_release(aux);
+}
+
 TEST_LIST = {
   { "test_1", test_1 },
   { "test_2", test_2 },
   { "test_3", test_3 },
   { "test_bc_buff_rtheta", test_bc_buff_rtheta },
+  { "test_aux", test_aux },
   { NULL, NULL },
 };
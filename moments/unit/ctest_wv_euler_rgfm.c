@@ -1,6 +1,11 @@
 #include <acutest.h>
 
+#include <gkyl_array.h>
+#include <gkyl_level_set.h>
+#include <gkyl_rect_decomp.h>
 #include <gkyl_util.h>
+#include <gkyl_wave_geom.h>
+#include <gkyl_wave_prop.h>
 #include <gkyl_wv_euler_rgfm.h>
 #include <gkyl_wv_euler_rgfm_priv.h>
 
@@ -580,6 +585,201 @@ test_euler_rgfm_threespecies_waves_2()
   gkyl_free(gas_gamma_s);
 }
 
+void
+test_euler_rgfm_reinit_level_set()
+{
+  double gas_gamma_s[2] = { 1.4, 1.67 };
+  int reinit_freq = 3;
+  struct gkyl_wv_eqn *euler_rgfm = gkyl_wv_euler_rgfm_new(2, gas_gamma_s, reinit_freq, false);
+
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, 1, (double[]) { 0.0 }, (double[]) { 1.0 }, (int[]) { 20 });
+  struct gkyl_range local, local_ext;
+  gkyl_create_grid_ranges(&grid, (int[]) { 3 }, &local_ext, &local);
+
+  struct gkyl_wave_geom *geom = gkyl_wave_geom_new(&grid, &local_ext, 0, 0, false);
+  gkyl_wave_prop *wv = gkyl_wave_prop_new( &(struct gkyl_wave_prop_inp) {
+      .grid = &grid,
+      .equation = euler_rgfm,
+      .limiter = GKYL_MONOTONIZED_CENTERED,
+      .num_up_dirs = 1,
+      .update_dirs = { 0 },
+      .cfl = 0.9,
+      .geom = geom,
+    }
+  );
+
+  // Species 1 occupies cells up to 10, species 2 the rest of the domain.
+  struct gkyl_array *q = gkyl_array_new(GKYL_DOUBLE, euler_rgfm->num_equations, local_ext.volume);
+  for (int i = local_ext.lower[0]; i <= local_ext.upper[0]; i++) {
+    double *qi = gkyl_array_fetch(q, gkyl_range_idx(&local_ext, (int[]) { i }));
+    for (int m = 0; m < euler_rgfm->num_equations; m++) {
+      qi[m] = 0.0;
+    }
+    qi[0] = 2.0;
+    qi[5] = (i <= 10) ? 1.8 : 0.4;
+    qi[6] = qi[5];
+    qi[7] = 2.0 - qi[5];
+    qi[8] = (i == 5 || i == 9) ? 1.0 : 10.0;
+  }
+
+  int idxl[GKYL_MAX_DIM] = { 0 };
+  euler_rgfm_reinit_level_set(wv, &local, idxl, local.lower[0], local.upper[0], q, 0, 0);
+
+  for (int i = local.lower[0]; i <= local.upper[0]; i++) {
+    const double *qi = gkyl_array_cfetch(q, gkyl_range_idx(&local, (int[]) { i }));
+
+    if (i == 5 || i == 9) {
+      // Level set not yet due for reinitialization.
+      TEST_CHECK( qi[5] == (i <= 10 ? 1.8 : 0.4) );
+      TEST_CHECK( qi[8] == 2.0 );
+    }
+    else if (i >= 8 && i <= 10) {
+      // Within three cells of the interface, on the species 1 side.
+      TEST_CHECK( gkyl_compare(qi[5], 0.99999 * 2.0, 1e-15) );
+      TEST_CHECK( gkyl_compare(qi[6], 0.99999 * 2.0, 1e-15) );
+      TEST_CHECK( gkyl_compare(qi[7], 0.00001 * 2.0, 1e-15) );
+      TEST_CHECK( qi[8] == 0.0 );
+    }
+    else if (i >= 11 && i <= 13) {
+      // Within three cells of the interface, on the species 2 side.
+      TEST_CHECK( gkyl_compare(qi[5], 0.00001 * 2.0, 1e-15) );
+      TEST_CHECK( gkyl_compare(qi[6], 0.00001 * 2.0, 1e-15) );
+      TEST_CHECK( gkyl_compare(qi[7], 0.99999 * 2.0, 1e-15) );
+      TEST_CHECK( qi[8] == 0.0 );
+    }
+    else {
+      // Away from the interface, only the reinitialization counter is reset.
+      TEST_CHECK( qi[5] == (i <= 10 ? 1.8 : 0.4) );
+      TEST_CHECK( qi[7] == 2.0 - qi[5] );
+      TEST_CHECK( qi[8] == 0.0 );
+    }
+  }
+
+  gkyl_array_release(q);
+  gkyl_wave_prop_release(wv);
+  gkyl_wave_geom_release(geom);
+  gkyl_wv_eqn_release(euler_rgfm);
+}
+
+// Two-species state of a circular bubble of species 1, centered on (xc, yc), advected by a uniform flow.
+static void
+rgfm_bubble_state(double gas_gamma_s[2], double x, double y, double xc, double yc, double *q)
+{
+  double phi1 = ((x - xc) * (x - xc)) + ((y - yc) * (y - yc)) < 0.01 ? 0.99999 : 0.00001;
+  double rho1 = 1.0, rho2 = 0.5, vx = 0.6, vy = 0.4, p = 1.0;
+  double rho = (phi1 * rho1) + ((1.0 - phi1) * rho2);
+  double E1 = (p / (gas_gamma_s[0] - 1.0)) + (0.5 * rho1 * ((vx * vx) + (vy * vy)));
+  double E2 = (p / (gas_gamma_s[1] - 1.0)) + (0.5 * rho2 * ((vx * vx) + (vy * vy)));
+
+  q[0] = rho; q[1] = rho * vx; q[2] = rho * vy; q[3] = 0.0;
+  q[4] = (phi1 * E1) + ((1.0 - phi1) * E2);
+  q[5] = rho * phi1; q[6] = phi1 * rho1; q[7] = (1.0 - phi1) * rho2;
+}
+
+// Advance the bubble with dimensionally-split sweeps, reinitializing the level set either in every cell (band_mode = 0), or
+// only in the band of cells near the interface, tracked across sweeps that each start from the output of the previous one
+// (band_mode = 1), or rebuilt in every step as the solution is copied back between steps (band_mode = 2).
+static struct gkyl_array*
+rgfm_bubble_run(int band_mode, bool stagger_counters, int num_steps)
+{
+  double gas_gamma_s[2] = { 1.4, 1.67 };
+  struct gkyl_wv_eqn *euler_rgfm = gkyl_wv_euler_rgfm_new(2, gas_gamma_s, 2, false);
+
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, 2, (double[]) { 0.0, 0.0 }, (double[]) { 1.0, 1.0 }, (int[]) { 64, 64 });
+  struct gkyl_range local, local_ext;
+  gkyl_create_grid_ranges(&grid, (int[]) { 3, 3 }, &local_ext, &local);
+
+  struct gkyl_wave_geom *geom = gkyl_wave_geom_new(&grid, &local_ext, 0, 0, false);
+  gkyl_level_set_band *band = band_mode ? gkyl_level_set_band_new(euler_rgfm) : 0;
+  gkyl_wave_prop *wv[2];
+  for (int d = 0; d < 2; d++) {
+    wv[d] = gkyl_wave_prop_new( &(struct gkyl_wave_prop_inp) {
+        .grid = &grid,
+        .equation = euler_rgfm,
+        .limiter = GKYL_MONOTONIZED_CENTERED,
+        .num_up_dirs = 1,
+        .update_dirs = { d },
+        .cfl = 0.9,
+        .geom = geom,
+        .band = band,
+      }
+    );
+  }
+  if (band) {
+    gkyl_level_set_band_release(band);
+  }
+
+  struct gkyl_array *f[3];
+  for (int k = 0; k < 3; k++) {
+    f[k] = gkyl_array_new(GKYL_DOUBLE, euler_rgfm->num_equations, local_ext.volume);
+  }
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &local_ext);
+  while (gkyl_range_iter_next(&iter)) {
+    double xc[2];
+    gkyl_rect_grid_cell_center(&grid, iter.idx, xc);
+    for (int k = 0; k < 3; k++) {
+      double *q = gkyl_array_fetch(f[k], gkyl_range_idx(&local_ext, iter.idx));
+      rgfm_bubble_state(gas_gamma_s, xc[0], xc[1], 0.35, 0.35, q);
+      q[8] = stagger_counters ? ((7 * iter.idx[0]) + (3 * iter.idx[1])) % 4 : 0.0;
+    }
+  }
+
+  double dt = 0.9 * grid.dx[0] / 2.6;
+  int curr = 0;
+  for (int n = 0; n < num_steps; n++) {
+    if (band_mode == 2) {
+      // Sweep f[0] -> f[1] -> f[2], then copy the solution back into f[0].
+      for (int d = 0; d < 2; d++) {
+        struct gkyl_wave_prop_status stat = gkyl_wave_prop_advance(wv[d], n * dt, dt, &local, f[d], f[d + 1]);
+        TEST_CHECK( stat.success );
+      }
+      gkyl_array_copy(f[0], f[2]);
+    }
+    else {
+      for (int d = 0; d < 2; d++) {
+        struct gkyl_wave_prop_status stat = gkyl_wave_prop_advance(wv[d], n * dt, dt, &local, f[curr], f[(curr + 1) % 3]);
+        TEST_CHECK( stat.success );
+        curr = (curr + 1) % 3;
+      }
+    }
+  }
+
+  struct gkyl_array *q = gkyl_array_acquire(f[curr]);
+  for (int k = 0; k < 3; k++) {
+    gkyl_array_release(f[k]);
+  }
+  for (int d = 0; d < 2; d++) {
+    gkyl_wave_prop_release(wv[d]);
+  }
+  gkyl_wave_geom_release(geom);
+  gkyl_wv_eqn_release(euler_rgfm);
+
+  return q;
+}
+
+void
+test_euler_rgfm_reinit_level_set_band()
+{
+  for (int stagger = 0; stagger < 2; stagger++) {
+    struct gkyl_array *q_ref = rgfm_bubble_run(0, stagger, 30);
+
+    for (int band_mode = 1; band_mode <= 2; band_mode++) {
+      struct gkyl_array *q = rgfm_bubble_run(band_mode, stagger, 30);
+
+      // Restricting the reinitialization to the band must not change the solution at all.
+      TEST_CHECK( memcmp(q->data, q_ref->data, q->size * q->esznc) == 0 );
+      TEST_MSG( "band mode %d, staggered counters %d", band_mode, stagger );
+
+      gkyl_array_release(q);
+    }
+    gkyl_array_release(q_ref);
+  }
+}
+
 TEST_LIST = {
   { "euler_rgfm_twospecies_basic", test_euler_rgfm_twospecies_basic },
   { "euler_rgfm_threespecies_basic", test_euler_rgfm_threespecies_basic },
@@ -587,5 +787,7 @@ TEST_LIST = {
   { "euler_rgfm_twospecies_waves_2", test_euler_rgfm_twospecies_waves_2 },
   { "euler_rgfm_threespecies_waves", test_euler_rgfm_threespecies_waves },
   { "euler_rgfm_threespecies_waves_2", test_euler_rgfm_threespecies_waves_2 },
+  { "euler_rgfm_reinit_level_set", test_euler_rgfm_reinit_level_set },
+  { "euler_rgfm_reinit_level_set_band", test_euler_rgfm_reinit_level_set_band },
   { NULL, NULL },
 };
\ No newline at end of file
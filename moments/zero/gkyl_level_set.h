@@ -6,6 +6,8 @@
 #include <gkyl_array.h>
 #include <gkyl_array_ops.h>
 #include <gkyl_null_comm.h>
+#include <gkyl_range.h>
+#include <gkyl_ref_count.h>
 #include <gkyl_rect_decomp.h>
 #include <gkyl_util.h>
 #include <gkyl_wave_geom.h>
@@ -21,6 +23,75 @@
 #include <gkyl_wv_gr_twofluid_priv.h>
 #include <gkyl_gr_blackhole.h>
 
+// Object type for the band of cells that may be modified by level set reinitialization (in the Riemann ghost fluid method)
+// or by the static gauge reinitialization (in the general relativistic equations). Cells outside the band are only visited
+// to reset their reinitialization counters.
+typedef struct gkyl_level_set_band gkyl_level_set_band;
+
+/**
+ * Create a new band tracker for the equation's reinitialization. The band covers the cells within three cells
+ * of a mass fraction = 0.5 crossing (Riemann ghost fluid method), or the cells that are not in the quiescent state of the
+ * excision region (static gauge). It is rebuilt after each sweep in which cells are reinitialized, and otherwise widened by
+ * one cell per sweep, which bounds the motion of the interface under CFL <= 1. The band may be shared by the updaters of the
+ * different directions that advance the same solution.
+ *
+ * @param eqn Equation object.
+ * @return New band tracker, or NULL if the equation has no reinitialization that can be restricted to a band.
+ */
+gkyl_level_set_band* gkyl_level_set_band_new(const struct gkyl_wv_eqn *eqn);
+
+/**
+ * Acquire pointer to band tracker. Delete using the release() method.
+ *
+ * @param band Band tracker.
+ * @return Acquired band tracker.
+ */
+gkyl_level_set_band* gkyl_level_set_band_acquire(const gkyl_level_set_band *band);
+
+/**
+ * Begin a sweep from qin into qout over update_range. The band is only carried over from the last tracked sweep if qin is the
+ * output array of that sweep; otherwise it is rebuilt from qin when the first cell is due for reinitialization.
+ *
+ * @param band Band tracker.
+ * @param update_range Range of cells to be updated.
+ * @param qin Input array of fluid variables.
+ * @param qout Output array of fluid variables.
+ */
+void gkyl_level_set_band_begin_sweep(gkyl_level_set_band *band, const struct gkyl_range *update_range,
+  const struct gkyl_array *qin, struct gkyl_array *qout);
+
+/**
+ * Check whether a cell due for reinitialization lies in the band (and so must be reinitialized).
+ *
+ * @param band Band tracker.
+ * @param update_range Range of cells to be updated.
+ * @param idx Index of the cell.
+ * @return True if the cell is in the band.
+ */
+bool gkyl_level_set_band_cell_active(gkyl_level_set_band *band, const struct gkyl_range *update_range, const int *idx);
+
+/**
+ * End a sweep begun with gkyl_level_set_band_begin_sweep, once all cells of qout have been updated and reinitialized.
+ *
+ * @param band Band tracker.
+ * @param update_range Range of cells updated.
+ */
+void gkyl_level_set_band_end_sweep(gkyl_level_set_band *band, const struct gkyl_range *update_range);
+
+/**
+ * Discard the band, e.g. when a sweep was abandoned. The next sweep due for reinitialization rebuilds it.
+ *
+ * @param band Band tracker.
+ */
+void gkyl_level_set_band_invalidate(gkyl_level_set_band *band);
+
+/**
+ * Release band tracker.
+ *
+ * @param band Band tracker to release.
+ */
+void gkyl_level_set_band_release(gkyl_level_set_band *band);
+
 /**
  * Reinitialize the level set function in the Riemann ghost fluid method for the Euler equations.
  *
@@ -31,10 +102,11 @@
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 euler_rgfm_reinit_level_set(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Maxwell equations.
@@ -46,10 +118,11 @@ euler_rgfm_reinit_level_set(gkyl_wave_prop *wv, const struct gkyl_range *update_
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_maxwell_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Maxwell equations in the tetrad basis.
@@ -61,10 +134,11 @@ gr_maxwell_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_rang
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_maxwell_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Euler equations (general equation of state).
@@ -76,10 +150,11 @@ gr_maxwell_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upda
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Euler equations in the tetrad basis (general equation of state).
@@ -91,10 +166,11 @@ gr_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range,
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Euler equations (ultra-relativistic equation of state).
@@ -106,10 +182,11 @@ gr_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_ultra_rel_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic Euler equations in the tetrad basis (ultra-relativistic equation of state).
@@ -121,10 +198,11 @@ gr_ultra_rel_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upd
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
 void
 gr_ultra_rel_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir);
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
 
 /**
  * Impose gauge conditions for the general relativistic two-fluid equations.
@@ -136,7 +214,8 @@ gr_ultra_rel_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_ran
  * @param upidx_c Upper index of cells to update.
  * @param qout Output array of fluid variables.
  * @param dir Direction in which to perform the update.
+ * @param band Band of cells that may need reinitialization (NULL to visit every cell).
  */
  void
  gr_twofluid_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-   struct gkyl_array *qout, int dir);
\ No newline at end of file
+   struct gkyl_array *qout, int dir, gkyl_level_set_band *band);
\ No newline at end of file
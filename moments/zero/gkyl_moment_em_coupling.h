@@ -16,6 +16,8 @@ struct gkyl_moment_em_coupling_data {
   double mass; // Species mass.
 
   double k0; // Closure parameter (for 10-moment equations only; defaults to 0.0).
+
+  const struct gkyl_array *aux; // Static auxiliary variables stored apart from the fluid array (NULL if the fluid array holds the full state).
 };
 
 struct gkyl_moment_em_coupling_inp {
@@ -75,6 +77,8 @@ struct gkyl_moment_em_coupling_inp {
   double gr_twofluid_charge_ion; // Ion charge for general relativistic two-fluid equations.
   double gr_twofluid_gas_gamma_elc; // Adiabatic index for electrons in general relativistic two-fluid equations.
   double gr_twofluid_gas_gamma_ion; // Adiabatic index for ions in general relativistic two-fluid equations.
+
+  int num_threads; // Number of threads for the implicit source update (0 or 1 for a serial update).
 };
 
 // Moment-EM coupling object.
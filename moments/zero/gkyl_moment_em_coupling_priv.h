@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string.h>
+#include <gkyl_job_pool.h>
 #include <gkyl_moment_em_coupling.h>
 #include <gkyl_sources_implicit_priv.h>
 #include <gkyl_sources_explicit_priv.h>
@@ -67,4 +68,6 @@ struct gkyl_moment_em_coupling {
   double gr_twofluid_charge_ion; // Ion charge for general relativistic two-fluid equations.
   double gr_twofluid_gas_gamma_elc; // Adiabatic index for electrons in general relativistic two-fluid equations.
   double gr_twofluid_gas_gamma_ion; // Adiabatic index for ions in general relativistic two-fluid equations.
+
+  struct gkyl_job_pool *thread_pool; // Pool for the threaded implicit source update (NULL for a serial update).
 };
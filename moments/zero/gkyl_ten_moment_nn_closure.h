@@ -16,6 +16,7 @@ struct gkyl_ten_moment_nn_closure_inp
   int poly_order; // Polynomial order of learned DG coefficients.
   double k0; // Damping coefficient.
   kann_t* ann; // Neural network architecture.
+  int num_threads; // Number of threads for the closure update (0 or 1 for a serial update).
 };
 
 // Object type.
@@ -34,6 +35,7 @@ gkyl_ten_moment_nn_closure_new(struct gkyl_ten_moment_nn_closure_inp inp);
 
 /**
  * Compute the right-hand-side contribution to the ten moment equation system from a machine-learned magnetized closure trained on PKPM simulations.
+ * Cells are processed in tiles, and the network is evaluated on all cells of a tile at once; tiles are spread over the threads of the updater.
  * The update_rng MUST be a sub-range of the range on which the array is defined. That is, it must be either the same range as the arary range, or one
  * created using the gkyl_sub_range_init method.
  *
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <gkyl_job_pool.h>
+#include <gkyl_ten_moment_nn_closure.h>
+
+// Number of cells whose network inputs are evaluated together in one batched forward pass.
+#define NN_TILE_SIZE 256
+
+// Activation function applied after a dense layer.
+enum nn_activation {
+  NN_ACT_NONE, NN_ACT_TANH, NN_ACT_SIGM, NN_ACT_RELU
+};
+
+// Dense layer y = act(W x + b) of a feed-forward network.
+struct nn_dense_layer {
+  int n_in, n_out; // Number of inputs and outputs of the layer.
+  float *wt; // Transposed weight matrix (n_in x n_out, row-major), so a tile of cells is multiplied by it in one GEMM.
+  float *b; // Bias vector (n_out).
+  enum nn_activation act; // Activation function.
+};
+
+// Feed-forward network made only of dense layers, extracted from a kann network for batched inference.
+struct nn_dense_net {
+  int num_layers; // Number of dense layers.
+  struct nn_dense_layer *layers; // Dense layers, from input to output.
+};
+
+// Per-thread memory for evaluating the closure on a tile of cells.
+struct nn_tile_mem {
+  int n_in, n_out; // Number of network inputs and outputs per cell.
+  float *input_data; // Network inputs (NN_TILE_SIZE x n_in, one row per cell).
+  float *output_data; // Network outputs (NN_TILE_SIZE x n_out, one row per cell).
+  long *linc_vertex, *linc_center; // Linear indices of each cell of the tile in the heat flux and update ranges.
+  int num_hidden; // Number of hidden layers (0 without a dense network).
+  float **hidden; // Outputs of each hidden layer (NN_TILE_SIZE x n, one row per cell).
+};
+
+struct gkyl_ten_moment_nn_closure
+{
+  struct gkyl_rect_grid grid; // Grid on which to solve equations.
+  int ndim; // Number of dimensions.
+  int poly_order; // Polynomial order of learned DG coefficients.
+  double k0; // Damping coefficient.
+  kann_t* ann; // Neural network architecture.
+
+  struct nn_dense_net *net; // Dense layers of the network for batched inference (NULL if the network is not a plain dense network).
+  struct gkyl_job_pool *thread_pool; // Pool for the threaded closure update (NULL for a serial update).
+  int num_mem; // Number of per-thread tile memories.
+  struct nn_tile_mem **mem; // Per-thread tile memories.
+};
+
+/**
+* Extract the dense layers of a kann network, i.e. a chain of kann_layer_dense layers, each optionally followed by a tanh, sigmoid or
+* ReLU activation (and dropout, which does nothing at inference time). The weights are copied into transposed, contiguous arrays.
+*
+* @param ann Neural network.
+* @return New dense network, or NULL if ann contains any other operation.
+*/
+struct nn_dense_net* nn_dense_net_new(kann_t* ann);
+
+/**
+* Evaluate the dense network on the first ntile cells of a tile, using one matrix-matrix multiply (sgemm) per layer.
+*
+* @param net Dense network.
+* @param mem Tile memory (inputs are read from mem->input_data, outputs written to mem->output_data).
+* @param ntile Number of cells in the tile (at most NN_TILE_SIZE).
+*/
+void nn_dense_net_apply(const struct nn_dense_net* net, struct nn_tile_mem* mem, int ntile);
+
+/**
+* Release dense network.
+*
+* @param net Dense network to release.
+*/
+void nn_dense_net_release(struct nn_dense_net* net);
+
+/**
+* Allocate memory for evaluating the closure on a tile of cells.
+*
+* @param n_in Number of network inputs per cell.
+* @param n_out Number of network outputs per cell.
+* @param net Dense network (may be NULL, in which case no hidden layer outputs are allocated).
+* @return New tile memory.
+*/
+struct nn_tile_mem* nn_tile_mem_new(int n_in, int n_out, const struct nn_dense_net* net);
+
+/**
+* Release tile memory.
+*
+* @param mem Tile memory to release.
+*/
+void nn_tile_mem_release(struct nn_tile_mem* mem);
@@ -51,6 +51,18 @@ struct gkyl_wave_prop_inp {
 
   const struct gkyl_wave_geom *geom; // geometry
   const struct gkyl_comm *comm; // communcator
+
+  // auxiliary variables (e.g. a static spacetime) making up the last
+  // aux->ncomp components of the equation's state vector. If set, the
+  // input/output arrays only hold the evolved variables, and aux is
+  // only read. NULL if the arrays hold the full state vector.
+  const struct gkyl_array *aux;
+
+  // band of cells that may need level set or gauge reinitialization
+  // (see gkyl_level_set.h), shared by the updaters advancing the same
+  // solution along different directions. NULL to reinitialize
+  // without tracking the band.
+  struct gkyl_level_set_band *band;
 };
 
 // Some statics from update calls
@@ -28,6 +28,18 @@ gkyl_wv_apply_bc* gkyl_wv_apply_bc_new(const struct gkyl_rect_grid *grid,
   int dir, enum gkyl_edge_loc edge, const int *nghost,
   wv_bc_func_t bcfunc, void *ctx);
 
+/**
+ * Set auxiliary variables (e.g. a static spacetime) making up the last
+ * aux->ncomp components of the equation's state vector. The arrays
+ * passed to the advance methods then only hold the evolved variables:
+ * BC functions see the full state vector of the skin cell, but only
+ * the evolved variables of the ghost cell are set. Pass NULL to unset.
+ *
+ * @param bc BC updater
+ * @param aux Auxiliary variables (not modified)
+ */
+void gkyl_wv_apply_bc_set_aux(gkyl_wv_apply_bc *bc, const struct gkyl_array *aux);
+
 /**
  * Apply boundary condition on specified field. If the update_rng does
  * not touch the edge in specified dir then nothing is done.
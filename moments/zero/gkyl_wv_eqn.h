@@ -139,6 +139,27 @@ gkyl_default_source_func(const struct gkyl_wv_eqn *eqn, const double *qin, doubl
   }
 }
 
+/**
+ * Assemble the full state vector of an equation system whose last
+ * num_aux variables (for example, a static spacetime) are stored
+ * apart from the evolved variables.
+ *
+ * @param eqn Equation object
+ * @param num_aux Number of auxiliary variables
+ * @param q Evolved variables (first num_equations-num_aux components of the state)
+ * @param aux Auxiliary variables
+ * @param qfull On output, full state vector (num_equations components)
+ */
+GKYL_CU_DH
+static inline void
+gkyl_wv_eqn_assemble_state(const struct gkyl_wv_eqn *eqn, int num_aux,
+  const double *q, const double *aux, double *qfull)
+{
+  int nevol = eqn->num_equations - num_aux;
+  for (int i=0; i<nevol; ++i) qfull[i] = q[i];
+  for (int i=0; i<num_aux; ++i) qfull[nevol+i] = aux[i];
+}
+
 /**
  * Compute waves and speeds from left/right conserved variables. The
  * 'waves' array has size num_equations X num_waves in length. The 'm'
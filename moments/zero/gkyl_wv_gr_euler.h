@@ -77,4 +77,15 @@ gkyl_wv_gr_euler_reinit_freq(const struct gkyl_wv_eqn* eqn);
 * @return Pointer to the base spacetime object.
 */
 struct gkyl_gr_spacetime*
-gkyl_wv_gr_euler_spacetime(const struct gkyl_wv_eqn* eqn);
\ No newline at end of file
+gkyl_wv_gr_euler_spacetime(const struct gkyl_wv_eqn* eqn);
+
+/**
+* Get number of static spacetime variables: the last components of the state vector (lapse function, shift vector, spatial metric and
+* extrinsic curvature tensors, excision flag, their derivatives and the spatial coordinates), which never change in a static gauge and
+* may therefore be stored apart from the evolved fluid variables.
+*
+* @param eqn General relativistic Euler equations object with ideal gas equation of state.
+* @return Number of static spacetime variables (0 if the spacetime gauge is not static).
+*/
+int
+gkyl_wv_gr_euler_num_static_spacetime(const struct gkyl_wv_eqn* eqn);
@@ -8,6 +8,8 @@ struct gkyl_wave_prop {
   enum gkyl_wave_limiter limiter; // Limiter to use.
   double cfl; // CFL number.
   const struct gkyl_wv_eqn *equation; // Equation object.
+  const struct gkyl_array *aux; // Auxiliary variables (NULL if none).
+  int meqn; // Number of evolved variables stored in solution arrays.
 
   bool force_low_order_flux; // Only use Lax flux.
   bool check_inv_domain; // Flag to indicate if invariant domains are checked.
@@ -29,53 +31,440 @@ struct gkyl_wave_prop {
   long n_max_bad_cells; // Maximum number of cells fixed in a call.
 };
 
+// Number of cells on either side of a cell searched for a mass fraction = 0.5 crossing during level set reinitialization.
+#define RGFM_REINIT_BAND 3
+// Number of cells whose mass fractions are cached while sweeping along a pencil (a power of two spanning the search band).
+#define RGFM_REINIT_CACHE 8
+
+// Mass fractions of the cells of a pencil, computed at most once per cell and kept only for the cells within the search band
+// of the cell currently being reinitialized.
+struct rgfm_frac_cache {
+  const struct gkyl_array *q; // Array of fluid variables.
+  long loc0, stride; // Linear index of the first cell of the pencil, and distance between consecutive cells of the pencil.
+  int loidx; // Index of the first cell of the pencil.
+  int num_frac; // Number of mass fractions per cell.
+  int tag[RGFM_REINIT_CACHE]; // Index of the cell held in each cache slot.
+  double *frac[RGFM_REINIT_CACHE]; // Mass fractions held in each cache slot.
+};
+
+// Mass fractions of cell i of the pencil (the interface side of a cell never changes during reinitialization, so the cached
+// values remain valid for the comparisons against 0.5).
+static inline const double*
+rgfm_frac_cache_get(struct rgfm_frac_cache *cache, int i)
+{
+  int slot = i & (RGFM_REINIT_CACHE - 1);
+  if (cache->tag[slot] != i) {
+    const double *q = gkyl_array_cfetch(cache->q, cache->loc0 + ((i - cache->loidx) * cache->stride));
+    for (int j = 0; j < cache->num_frac; j++) {
+      cache->frac[slot][j] = q[5 + j] / q[0];
+    }
+    cache->tag[slot] = i;
+  }
+  return cache->frac[slot];
+}
+
+// Kind of cells around which the band is built.
+enum level_set_band_kind {
+  LEVEL_SET_BAND_RGFM, // Cells adjacent to a mass fraction = 0.5 crossing.
+  LEVEL_SET_BAND_EXCISION, // Cells not in the quiescent (zeroed) state of the excision region.
+};
+
+struct gkyl_level_set_band {
+  enum level_set_band_kind kind; // Kind of cells around which the band is built.
+  int width; // Number of cells the band extends on either side of the cells around which it is built.
+  int num_frac; // Number of mass fractions per cell (RGFM only).
+  int num_zero, flag_idx; // Number of components zeroed in the excision region, and index of the excision flag (excision only).
+  const struct gkyl_gr_spacetime *spacetime; // Spacetime whose excision region is tracked (excision only).
+
+  struct gkyl_range range; // Cells tracked (a copy of the update range, indexed from zero).
+  bool valid; // True if the mask holds every cell that may be modified by reinitialization.
+  int grow; // Number of sweeps since the mask was built (and not yet applied to the mask).
+  bool due; // True if a cell was due for reinitialization in the current sweep.
+  bool prepared; // True if the mask has been brought up to date in the current sweep.
+  const struct gkyl_array *qin, *qout; // Input and output arrays of the current sweep.
+  const struct gkyl_array *qlast; // Output array of the last tracked sweep.
+  unsigned char *mask, *tmp; // Mask of active cells, and scratch space for building it.
+
+  struct gkyl_ref_count ref_count;
+};
+
+static void
+level_set_band_free(const struct gkyl_ref_count *ref)
+{
+  struct gkyl_level_set_band *band = container_of(ref, struct gkyl_level_set_band, ref_count);
+  gkyl_free(band->mask);
+  gkyl_free(band->tmp);
+  gkyl_free(band);
+}
+
+gkyl_level_set_band*
+gkyl_level_set_band_new(const struct gkyl_wv_eqn *eqn)
+{
+  enum level_set_band_kind kind = LEVEL_SET_BAND_EXCISION;
+  int width = 0, num_frac = 0, num_zero = 0, flag_idx = 0;
+  enum gkyl_spacetime_gauge gauge = GKYL_STATIC_GAUGE;
+  const struct gkyl_gr_spacetime *spacetime = 0;
+
+  switch (eqn->type) {
+    case GKYL_EQN_EULER_RGFM:
+      kind = LEVEL_SET_BAND_RGFM;
+      width = RGFM_REINIT_BAND;
+      num_frac = container_of(eqn, struct wv_euler_rgfm, eqn)->num_species - 1;
+      break;
+
+    case GKYL_EQN_GR_MAXWELL: {
+      const struct wv_gr_maxwell *gr = container_of(eqn, struct wv_gr_maxwell, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 22; flag_idx = 21;
+      break;
+    }
+    case GKYL_EQN_GR_MAXWELL_TETRAD: {
+      const struct wv_gr_maxwell_tetrad *gr = container_of(eqn, struct wv_gr_maxwell_tetrad, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 22; flag_idx = 21;
+      break;
+    }
+    case GKYL_EQN_GR_EULER: {
+      const struct wv_gr_euler *gr = container_of(eqn, struct wv_gr_euler, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 67; flag_idx = 27;
+      break;
+    }
+    case GKYL_EQN_GR_EULER_TETRAD: {
+      const struct wv_gr_euler_tetrad *gr = container_of(eqn, struct wv_gr_euler_tetrad, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 67; flag_idx = 27;
+      break;
+    }
+    case GKYL_EQN_GR_ULTRA_REL_EULER: {
+      const struct wv_gr_ultra_rel_euler *gr = container_of(eqn, struct wv_gr_ultra_rel_euler, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 66; flag_idx = 26;
+      break;
+    }
+    case GKYL_EQN_GR_ULTRA_REL_EULER_TETRAD: {
+      const struct wv_gr_ultra_rel_euler_tetrad *gr = container_of(eqn, struct wv_gr_ultra_rel_euler_tetrad, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 66; flag_idx = 26;
+      break;
+    }
+    case GKYL_EQN_GR_TWOFLUID: {
+      const struct wv_gr_twofluid *gr = container_of(eqn, struct wv_gr_twofluid, eqn);
+      gauge = gr->spacetime_gauge; spacetime = gr->spacetime;
+      num_zero = 80; flag_idx = 40;
+      break;
+    }
+
+    default:
+      return 0;
+  }
+  // Only the static gauge leaves the excision region untouched between reinitializations.
+  if (gauge != GKYL_STATIC_GAUGE) {
+    return 0;
+  }
+
+  struct gkyl_level_set_band *band = gkyl_malloc(sizeof(*band));
+  band->kind = kind;
+  band->width = width;
+  band->num_frac = num_frac;
+  band->num_zero = num_zero;
+  band->flag_idx = flag_idx;
+  band->spacetime = spacetime;
+
+  gkyl_range_init(&band->range, 1, (int[]) { 0 }, (int[]) { -1 });
+  band->valid = false;
+  band->grow = 0;
+  band->due = band->prepared = false;
+  band->qin = band->qout = band->qlast = 0;
+  band->mask = band->tmp = 0;
+
+  band->ref_count = gkyl_ref_count_init(level_set_band_free);
+
+  return band;
+}
+
+gkyl_level_set_band*
+gkyl_level_set_band_acquire(const gkyl_level_set_band *band)
+{
+  gkyl_ref_count_inc(&band->ref_count);
+  return (struct gkyl_level_set_band*) band;
+}
+
+// True if the cells of the two ranges have the same indices.
+static bool
+level_set_band_same_cells(const struct gkyl_range *r1, const struct gkyl_range *r2)
+{
+  if (r1->ndim != r2->ndim) {
+    return false;
+  }
+  for (int d = 0; d < r1->ndim; d++) {
+    if ((r1->lower[d] != r2->lower[d]) || (r1->upper[d] != r2->upper[d])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Dilate the cells set in mask by r cells along direction dir, writing the result into out. Both arrays are laid out as band->range.
+static void
+level_set_band_dilate_dir(const struct gkyl_range *range, int dir, int r, const unsigned char *mask, unsigned char *out)
+{
+  long n = gkyl_range_shape(range, dir);
+  long stride = 1;
+  for (int d = dir + 1; d < range->ndim; d++) {
+    stride *= gkyl_range_shape(range, d);
+  }
+  long num_outer = range->volume / (n * stride);
+
+  for (long o = 0; o < num_outer; o++) {
+    for (long s = 0; s < stride; s++) {
+      unsigned char *out_line = out + (o * n * stride) + s;
+      const unsigned char *line = mask + (o * n * stride) + s;
+
+      // Distance to the nearest set cell on the left, and then on the right.
+      long last = -r - 1;
+      for (long i = 0; i < n; i++) {
+        if (line[i * stride]) {
+          last = i;
+        }
+        out_line[i * stride] = (i - last <= r);
+      }
+      long next = n + r + 1;
+      for (long i = n - 1; i >= 0; i--) {
+        if (line[i * stride]) {
+          next = i;
+        }
+        if (next - i <= r) {
+          out_line[i * stride] = 1;
+        }
+      }
+    }
+  }
+}
+
+// Dilate the mask by r cells along every direction (a box of half-width r around each set cell).
+static void
+level_set_band_dilate(struct gkyl_level_set_band *band, int r)
+{
+  if (r <= 0) {
+    return;
+  }
+  for (int d = 0; d < band->range.ndim; d++) {
+    level_set_band_dilate_dir(&band->range, d, r, band->mask, band->tmp);
+    unsigned char *swap = band->mask;
+    band->mask = band->tmp;
+    band->tmp = swap;
+  }
+}
+
+// True if the mass fraction of any species lies on different sides of 0.5 in the two cells.
+static inline bool
+rgfm_side_differs(int num_frac, const double *q1, const double *q2)
+{
+  for (int j = 0; j < num_frac; j++) {
+    if ((q1[5 + j] / q1[0] >= 0.5) != (q2[5 + j] / q2[0] >= 0.5)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// True if the cell holds exactly the state written into the excision region by the gauge reinitialization, which leaves
+// such a cell unchanged.
+static bool
+excision_quiescent(const struct gkyl_level_set_band *band, const double *q)
+{
+  if (q[band->flag_idx] != -1.0) {
+    return false;
+  }
+  for (int i = 0; i < band->num_zero; i++) {
+    if ((i != band->flag_idx) && ((q[i] != 0.0) || signbit(q[i]))) {
+      return false;
+    }
+  }
+
+  bool in_excision_region;
+  const double *pos = &q[band->num_zero + 1];
+  band->spacetime->excision_region_func(band->spacetime, 0.0, pos[0], pos[1], pos[2], &in_excision_region);
+  return in_excision_region;
+}
+
+// True if the band is to be built around cell idx of q. Cells on the boundary of the range are always included, as their
+// ghost cells change outside of the sweeps.
+static bool
+level_set_band_is_seed(const struct gkyl_level_set_band *band, const struct gkyl_range *update_range,
+  const struct gkyl_array *q, const int *idx)
+{
+  const struct gkyl_range *range = &band->range;
+  for (int d = 0; d < range->ndim; d++) {
+    if ((idx[d] == range->lower[d]) || (idx[d] == range->upper[d])) {
+      return true;
+    }
+  }
+
+  const double *qc = gkyl_array_cfetch(q, gkyl_range_idx(update_range, idx));
+  if (band->kind == LEVEL_SET_BAND_EXCISION) {
+    return !excision_quiescent(band, qc);
+  }
+
+  int nidx[GKYL_MAX_DIM];
+  gkyl_copy_int_arr(range->ndim, idx, nidx);
+  for (int d = 0; d < range->ndim; d++) {
+    for (int s = -1; s <= 1; s += 2) {
+      nidx[d] = idx[d] + s;
+      if (rgfm_side_differs(band->num_frac, qc, gkyl_array_cfetch(q, gkyl_range_idx(update_range, nidx)))) {
+        return true;
+      }
+    }
+    nidx[d] = idx[d];
+  }
+  return false;
+}
+
+// Build the mask from the state q: the band of half-width (width + extra) around the seed cells. If within_mask is true,
+// seeds are only looked for among the cells of the current mask.
+static void
+level_set_band_build(struct gkyl_level_set_band *band, const struct gkyl_range *update_range, const struct gkyl_array *q,
+  bool within_mask, int extra)
+{
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &band->range);
+  long loc = 0;
+  while (gkyl_range_iter_next(&iter)) {
+    band->tmp[loc] = (!within_mask || band->mask[loc]) && level_set_band_is_seed(band, update_range, q, iter.idx);
+    loc += 1;
+  }
+  unsigned char *swap = band->mask;
+  band->mask = band->tmp;
+  band->tmp = swap;
+
+  level_set_band_dilate(band, band->width + extra);
+  band->grow = 0;
+  band->valid = true;
+}
+
+void
+gkyl_level_set_band_begin_sweep(gkyl_level_set_band *band, const struct gkyl_range *update_range,
+  const struct gkyl_array *qin, struct gkyl_array *qout)
+{
+  if (!level_set_band_same_cells(&band->range, update_range)) {
+    gkyl_range_init(&band->range, update_range->ndim, update_range->lower, update_range->upper);
+    band->mask = gkyl_realloc(band->mask, band->range.volume);
+    band->tmp = gkyl_realloc(band->tmp, band->range.volume);
+    band->valid = false;
+  }
+  // The mask is only carried over if this sweep starts from the state left by the last tracked one.
+  if (qin != band->qlast) {
+    band->valid = false;
+  }
+
+  // Under CFL <= 1, a sweep moves the cells around which the band is built by at most one cell.
+  band->grow += 1;
+  band->due = band->prepared = false;
+  band->qin = qin;
+  band->qout = qout;
+}
+
+bool
+gkyl_level_set_band_cell_active(gkyl_level_set_band *band, const struct gkyl_range *update_range, const int *idx)
+{
+  if (!band->prepared) {
+    // First cell due for reinitialization in this sweep: bring the mask up to date.
+    if (band->valid) {
+      level_set_band_dilate(band, band->grow);
+      band->grow = 0;
+    }
+    else if (band->qin != band->qout) {
+      level_set_band_build(band, update_range, band->qin, false, 1);
+    }
+    band->prepared = true;
+    band->due = true;
+  }
+  return !band->valid || band->mask[gkyl_range_idx(&band->range, idx)];
+}
+
+void
+gkyl_level_set_band_end_sweep(gkyl_level_set_band *band, const struct gkyl_range *update_range)
+{
+  // Cells were reinitialized in this sweep: shrink the band back around the cells that now need it.
+  if (band->due) {
+    level_set_band_build(band, update_range, band->qout, band->valid, 0);
+  }
+  band->qlast = band->qout;
+}
+
+void
+gkyl_level_set_band_invalidate(gkyl_level_set_band *band)
+{
+  band->valid = false;
+  band->qlast = 0;
+}
+
+void
+gkyl_level_set_band_release(gkyl_level_set_band *band)
+{
+  gkyl_ref_count_dec(&band->ref_count);
+}
+
 void
 euler_rgfm_reinit_level_set(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_euler_rgfm *euler_rgfm = container_of(eqn, struct wv_euler_rgfm, eqn);
   int num_species = euler_rgfm->num_species;
   int reinit_freq = euler_rgfm->reinit_freq;
 
-  for (int i = loidx_c; i <= upidx_c; i++) {
-    idxl[dir] = i;
+  // Cells of the pencil are visited with a fixed stride, rather than by recomputing their linear indices.
+  idxl[dir] = loidx_c;
+  long loc0 = gkyl_range_idx(update_range, idxl);
+  idxl[dir] = loidx_c + 1;
+  long stride = gkyl_range_idx(update_range, idxl) - loc0;
+
+  double frac_data[RGFM_REINIT_CACHE][num_species > 1 ? num_species - 1 : 1];
+  struct rgfm_frac_cache cache = {
+    .q = qout,
+    .loc0 = loc0,
+    .stride = stride,
+    .loidx = loidx_c,
+    .num_frac = num_species - 1,
+  };
+  for (int k = 0; k < RGFM_REINIT_CACHE; k++) {
+    cache.tag[k] = loidx_c - RGFM_REINIT_BAND - RGFM_REINIT_CACHE; // Not a cell of the pencil.
+    cache.frac[k] = frac_data[k];
+  }
 
-    double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
+  for (int i = loidx_c; i <= upidx_c; i++) {
+    double *qnew = gkyl_array_fetch(qout, loc0 + ((i - loidx_c) * stride));
 
     double reinit_param = qnew[4 + (2 * num_species)];
 
-    if (reinit_param > reinit_freq) {
+    idxl[dir] = i;
+    if (reinit_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+      // Outside the band no neighbor lies on the other side of the interface, so only the reinitialization counter is reset.
+      qnew[4 + (2 * num_species)] = 0.0;
+    }
+    else if (reinit_param > reinit_freq) {
       double rho_total = qnew[0];
 
+      // Only cells within RGFM_REINIT_BAND cells of a crossing of the interface are reinitialized: a cell is in this narrow
+      // band for species j if any of its neighbors lies on the other side of the interface.
+      const double *frac_nb[2 * RGFM_REINIT_BAND];
+      for (int k = 1; k <= RGFM_REINIT_BAND; k++) {
+        frac_nb[k - 1] = rgfm_frac_cache_get(&cache, i - k);
+        frac_nb[RGFM_REINIT_BAND + k - 1] = rgfm_frac_cache_get(&cache, i + k);
+      }
+
       bool update_up = false;
       bool update_down = false;
       for (int j = 0; j < num_species - 1; j++) {
         if (qnew[5 + j] / rho_total >= 0.5) {
-          idxl[dir] = i - 1;
-          double *ql = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i - 2;
-          double *qll = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i - 3;
-          double *qlll = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-        
-          double rho_total_l = ql[0];
-          double rho_total_ll = qll[0];
-          double rho_total_lll = qlll[0];
-
-          idxl[dir] = i + 1;
-          double *qr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i + 2;
-          double *qrr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i + 3;
-          double *qrrr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-        
-          double rho_total_r = qr[0];
-          double rho_total_rr = qrr[0];
-          double rho_total_rrr = qrrr[0];
-        
-          if (ql[5 + j] / rho_total_l < 0.5 || qll[5 + j] / rho_total_ll < 0.5 || qlll[5 + j] / rho_total_lll < 0.5 || qr[5 + j] / rho_total_r < 0.5 ||
-            qrr[5 + j] / rho_total_rr < 0.5 || qrrr[5 + j] / rho_total_rrr < 0.5)  {
+          bool near_interface = false;
+          for (int k = 0; k < 2 * RGFM_REINIT_BAND; k++) {
+            near_interface = near_interface || (frac_nb[k][j] < 0.5);
+          }
+
+          if (near_interface) {
             qnew[5 + j] = 0.99999 * rho_total;
             qnew[4 + num_species + j] = 0.99999 * rho_total;
             update_up = true;
@@ -83,30 +472,12 @@ euler_rgfm_reinit_level_set(gkyl_wave_prop *wv, const struct gkyl_range *update_
         }
         
         if (qnew[5 + j] / rho_total < 0.5) {
-          idxl[dir] = i - 1;
-          double *ql = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i - 2;
-          double *qll = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i - 3;
-          double *qlll = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-        
-          double rho_total_l = ql[0];
-          double rho_total_ll = qll[0];
-          double rho_total_lll = qlll[0];
-
-          idxl[dir] = i + 1;
-          double *qr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i + 2;
-          double *qrr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-          idxl[dir] = i + 3;
-          double *qrrr = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
-        
-          double rho_total_r = qr[0];
-          double rho_total_rr = qrr[0];
-          double rho_total_rrr = qrrr[0];
+          bool near_interface = false;
+          for (int k = 0; k < 2 * RGFM_REINIT_BAND; k++) {
+            near_interface = near_interface || (frac_nb[k][j] >= 0.5);
+          }
 
-          if (qr[5 + j] / rho_total_r >= 0.5 || qrr[5 + j] / rho_total_rr >= 0.5 || qrrr[5 + j] / rho_total_rrr >= 0.5 || ql[5 + j] / rho_total_l >= 0.5 ||
-            qll[5 + j] / rho_total_ll >= 0.5 || qlll[5 + j] / rho_total_lll >= 0.5) {
+          if (near_interface) {
             qnew[5 + j] = 0.00001 * rho_total;
             qnew[4 + num_species + j] = 0.00001 * rho_total;
             update_down = true;
@@ -131,7 +502,7 @@ euler_rgfm_reinit_level_set(gkyl_wave_prop *wv, const struct gkyl_range *update_
 
 void
 gr_maxwell_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_maxwell *gr_maxwell = container_of(eqn, struct wv_gr_maxwell, eqn);
@@ -148,7 +519,11 @@ gr_maxwell_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_rang
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[22];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[22] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[23];
         double y = qnew[24];
         double z = qnew[25];
@@ -203,7 +578,7 @@ gr_maxwell_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_rang
 
 void
 gr_maxwell_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_maxwell_tetrad *gr_maxwell_tetrad = container_of(eqn, struct wv_gr_maxwell_tetrad, eqn);
@@ -220,7 +595,11 @@ gr_maxwell_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upda
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[22];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[22] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[23];
         double y = qnew[24];
         double z = qnew[25];
@@ -275,7 +654,7 @@ gr_maxwell_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upda
 
 void
 gr_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_euler *gr_euler = container_of(eqn, struct wv_gr_euler, eqn);
@@ -292,7 +671,11 @@ gr_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range,
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[67];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[67] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[68];
         double y = qnew[69];
         double z = qnew[70];
@@ -408,7 +791,7 @@ gr_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range,
 
 void
 gr_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_euler_tetrad *gr_euler_tetrad = container_of(eqn, struct wv_gr_euler_tetrad, eqn);
@@ -425,7 +808,11 @@ gr_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[67];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[67] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[68];
         double y = qnew[69];
         double z = qnew[70];
@@ -541,7 +928,7 @@ gr_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update
 
 void
 gr_ultra_rel_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_ultra_rel_euler *gr_ultra_rel_euler = container_of(eqn, struct wv_gr_ultra_rel_euler, eqn);
@@ -558,7 +945,11 @@ gr_ultra_rel_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upd
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[66];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[66] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[67];
         double y = qnew[68];
         double z = qnew[69];
@@ -804,7 +1195,7 @@ gr_ultra_rel_euler_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *upd
 
 void
 gr_ultra_rel_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_ultra_rel_euler_tetrad *gr_ultra_rel_euler_tetrad = container_of(eqn, struct wv_gr_ultra_rel_euler_tetrad, eqn);
@@ -821,7 +1212,11 @@ gr_ultra_rel_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_ran
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[66];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[66] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[67];
         double y = qnew[68];
         double z = qnew[69];
@@ -1067,7 +1462,7 @@ gr_ultra_rel_euler_tetrad_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_ran
 
 void
 gr_twofluid_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_range, int idxl[GKYL_MAX_DIM], int loidx_c, int upidx_c,
-  struct gkyl_array *qout, int dir)
+  struct gkyl_array *qout, int dir, gkyl_level_set_band *band)
 {
   const struct gkyl_wv_eqn* eqn = wv->equation;
   const struct wv_gr_twofluid *gr_twofluid = container_of(eqn, struct wv_gr_twofluid, eqn);
@@ -1084,7 +1479,11 @@ gr_twofluid_impose_gauge(gkyl_wave_prop *wv, const struct gkyl_range *update_ran
       double *qnew = gkyl_array_fetch(qout, gkyl_range_idx(update_range, idxl));
       double evol_param = qnew[80];
 
-      if (evol_param > reinit_freq) {
+      if (evol_param > reinit_freq && band && !gkyl_level_set_band_cell_active(band, update_range, idxl)) {
+        // Quiescent cell of the excision region, which reinitialization would leave unchanged.
+        qnew[80] = 0.0;
+      }
+      else if (evol_param > reinit_freq) {
         double x = qnew[81];
         double y = qnew[82];
         double z = qnew[83];
@@ -4,6 +4,9 @@
 #include <gkyl_moment_em_coupling.h>
 #include <gkyl_moment_em_coupling_priv.h>
 #include <gkyl_mat.h>
+#include <gkyl_thread_pool.h>
+
+#include <string.h>
 
 gkyl_moment_em_coupling*
 gkyl_moment_em_coupling_new(struct gkyl_moment_em_coupling_inp inp)
@@ -115,13 +118,19 @@ gkyl_moment_em_coupling_new(struct gkyl_moment_em_coupling_inp inp)
     mom_em->gr_twofluid_gas_gamma_ion = inp.gr_twofluid_gas_gamma_ion;
   }
 
+  mom_em->thread_pool = 0;
+  if (inp.num_threads > 1) {
+    mom_em->thread_pool = gkyl_thread_pool_new(inp.num_threads);
+  }
+
   return mom_em;
 }
 
-void
-gkyl_moment_em_coupling_implicit_advance(const gkyl_moment_em_coupling* mom_em, double t_curr, double dt, const struct gkyl_range* update_range,
-  struct gkyl_array* fluid[GKYL_MAX_SPECIES], const struct gkyl_array* app_accel[GKYL_MAX_SPECIES], const struct gkyl_array* p_rhs[GKYL_MAX_SPECIES],
-  struct gkyl_array* em, const struct gkyl_array* app_current, const struct gkyl_array* ext_em, const struct gkyl_array* nT_sources[GKYL_MAX_SPECIES])
+// Integrate the sources implicitly in the cells of the given range (which may be a split of the update range).
+static void
+implicit_advance_range(const gkyl_moment_em_coupling* mom_em, double t_curr, double dt, const struct gkyl_range* range,
+  struct gkyl_array* const* fluid, const struct gkyl_array* const* app_accel, const struct gkyl_array* const* p_rhs,
+  struct gkyl_array* em, const struct gkyl_array* app_current, const struct gkyl_array* ext_em, const struct gkyl_array* const* nT_sources)
 {
   int nfluids = mom_em->nfluids;
   double *fluid_s[GKYL_MAX_SPECIES];
@@ -129,17 +138,33 @@ gkyl_moment_em_coupling_implicit_advance(const gkyl_moment_em_coupling* mom_em,
   const double *p_rhs_s[GKYL_MAX_SPECIES];
   const double *nT_sources_s[GKYL_MAX_SPECIES];
 
+  // Fluids whose static auxiliary variables are stored apart are updated in a copy of their full state vector.
+  int max_comp = 1;
+  for (int i = 0; i < nfluids; i++) {
+    if (mom_em->param[i].aux) {
+      max_comp = GKYL_MAX2(max_comp, fluid[i]->ncomp + mom_em->param[i].aux->ncomp);
+    }
+  }
+  double fluid_full[nfluids][max_comp];
+
   struct gkyl_range_iter iter;
-  gkyl_range_iter_init(&iter, update_range);
+  gkyl_range_iter_init(&iter, range);
 
   while (gkyl_range_iter_next(&iter)) {
-    long cell_idx = gkyl_range_idx(update_range, iter.idx);
+    long cell_idx = gkyl_range_idx(range, iter.idx);
 
     for (int i = 0; i < nfluids; i++) {
       fluid_s[i] = gkyl_array_fetch(fluid[i], cell_idx);
       app_accel_s[i] = gkyl_array_cfetch(app_accel[i], cell_idx);
       p_rhs_s[i] = gkyl_array_cfetch(p_rhs[i], cell_idx);
       nT_sources_s[i] = gkyl_array_cfetch(nT_sources[i], cell_idx);
+
+      const struct gkyl_array *aux = mom_em->param[i].aux;
+      if (aux) {
+        memcpy(fluid_full[i], fluid_s[i], sizeof(double[fluid[i]->ncomp]));
+        memcpy(&fluid_full[i][fluid[i]->ncomp], gkyl_array_cfetch(aux, cell_idx), sizeof(double[aux->ncomp]));
+        fluid_s[i] = fluid_full[i];
+      }
     }
 
     double *em_arr = em ? gkyl_array_fetch(em, cell_idx) : 0;
@@ -147,7 +172,67 @@ gkyl_moment_em_coupling_implicit_advance(const gkyl_moment_em_coupling* mom_em,
     const double *ext_em_arr = ext_em ? gkyl_array_cfetch(ext_em, cell_idx) : 0;
 
     implicit_source_coupling_update(mom_em, t_curr, dt, fluid_s, app_accel_s, p_rhs_s, em_arr, app_current_arr, ext_em_arr, nT_sources_s);
+
+    for (int i = 0; i < nfluids; i++) {
+      if (mom_em->param[i].aux) {
+        memcpy(gkyl_array_fetch(fluid[i], cell_idx), fluid_full[i], sizeof(double[fluid[i]->ncomp]));
+      }
+    }
+  }
+}
+
+// Context for the implicit source update of one split of the update range.
+struct implicit_advance_ctx {
+  const gkyl_moment_em_coupling* mom_em;
+  double t_curr, dt;
+  struct gkyl_range range; // Split of the update range.
+  struct gkyl_array* const* fluid;
+  const struct gkyl_array* const* app_accel;
+  const struct gkyl_array* const* p_rhs;
+  struct gkyl_array* em;
+  const struct gkyl_array* app_current;
+  const struct gkyl_array* ext_em;
+  const struct gkyl_array* const* nT_sources;
+};
+
+static void
+implicit_advance_job(void* ctx)
+{
+  struct implicit_advance_ctx *actx = ctx;
+  implicit_advance_range(actx->mom_em, actx->t_curr, actx->dt, &actx->range, actx->fluid, actx->app_accel, actx->p_rhs,
+    actx->em, actx->app_current, actx->ext_em, actx->nT_sources);
+}
+
+void
+gkyl_moment_em_coupling_implicit_advance(const gkyl_moment_em_coupling* mom_em, double t_curr, double dt, const struct gkyl_range* update_range,
+  struct gkyl_array* fluid[GKYL_MAX_SPECIES], const struct gkyl_array* app_accel[GKYL_MAX_SPECIES], const struct gkyl_array* p_rhs[GKYL_MAX_SPECIES],
+  struct gkyl_array* em, const struct gkyl_array* app_current, const struct gkyl_array* ext_em, const struct gkyl_array* nT_sources[GKYL_MAX_SPECIES])
+{
+  if (!mom_em->thread_pool) {
+    implicit_advance_range(mom_em, t_curr, dt, update_range, fluid, app_accel, p_rhs, em, app_current, ext_em, nT_sources);
+    return;
+  }
+
+  // Each cell is updated independently, so contiguous chunks of the update range are handed to the threads.
+  int nthreads = mom_em->thread_pool->pool_size;
+  struct implicit_advance_ctx actx[nthreads];
+  for (int tid = 0; tid < nthreads; tid++) {
+    actx[tid] = (struct implicit_advance_ctx) {
+      .mom_em = mom_em,
+      .t_curr = t_curr,
+      .dt = dt,
+      .range = gkyl_range_split((struct gkyl_range*) update_range, nthreads, tid),
+      .fluid = fluid,
+      .app_accel = app_accel,
+      .p_rhs = p_rhs,
+      .em = em,
+      .app_current = app_current,
+      .ext_em = ext_em,
+      .nT_sources = nT_sources,
+    };
+    gkyl_job_pool_add_work(mom_em->thread_pool, implicit_advance_job, &actx[tid]);
   }
+  gkyl_job_pool_wait(mom_em->thread_pool);
 }
 
 void
@@ -191,5 +276,8 @@ gkyl_moment_em_coupling_explicit_advance(const gkyl_moment_em_coupling* mom_em,
 void
 gkyl_moment_em_coupling_release(gkyl_moment_em_coupling* mom_em)
 {
+  if (mom_em->thread_pool) {
+    gkyl_job_pool_release(mom_em->thread_pool);
+  }
   gkyl_free(mom_em);
 }
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include <gkyl_alloc.h>
 #include <gkyl_array_ops.h>
 #include <gkyl_fv_proj.h>
-#include <gkyl_mat.h>
 #include <gkyl_moment_em_coupling_priv.h>
 #include <gkyl_sources_explicit_priv.h>
 #include <gkyl_sources_implicit_priv.h>
@@ -246,38 +245,116 @@ implicit_neut_source_update(const gkyl_moment_em_coupling* mom_em, double t_curr
   }
 }
 
-void
-implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double dt, double* fluid_s[GKYL_MAX_SPECIES])
+// Solve the n x n system A X = B in place (B has nrhs <= 3 columns) by
+// Gaussian elimination with partial pivoting. A and B live on the stack,
+// so the update allocates nothing. Returns false if A is singular.
+static inline bool
+small_lu_solve(int n, int nrhs, double A[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES], double B[GKYL_MAX_SPECIES][3])
 {
-  int nfluids = mom_em->nfluids;
-  double nu_base[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES];
-  for (int i  = 0; i < nfluids; i++) {
-    for (int j = 0; j < nfluids; j++) {
-      nu_base[i][j] = (mom_em->nu_base)[i][j];
+  for (int k = 0; k < n; k++) {
+    int piv = k;
+    for (int i = k + 1; i < n; i++) {
+      if (fabs(A[i][k]) > fabs(A[piv][k])) {
+        piv = i;
+      }
+    }
+    if (A[piv][k] == 0.0) {
+      return false;
+    }
+
+    if (piv != k) {
+      for (int j = k; j < n; j++) {
+        double tmp = A[k][j]; A[k][j] = A[piv][j]; A[piv][j] = tmp;
+      }
+      for (int r = 0; r < nrhs; r++) {
+        double tmp = B[k][r]; B[k][r] = B[piv][r]; B[piv][r] = tmp;
+      }
+    }
+
+    double inv_akk = 1.0 / A[k][k];
+    for (int i = k + 1; i < n; i++) {
+      double fac = A[i][k] * inv_akk;
+      for (int j = k + 1; j < n; j++) {
+        A[i][j] -= fac * A[k][j];
+      }
+      for (int r = 0; r < nrhs; r++) {
+        B[i][r] -= fac * B[k][r];
+      }
     }
   }
 
-  double nu[nfluids * nfluids];
-  for (int i = 0; i < nfluids; i++) {
-    double *nu_i = nu + (nfluids * i);
+  for (int i = n - 1; i >= 0; i--) {
+    double inv_aii = 1.0 / A[i][i];
+    for (int r = 0; r < nrhs; r++) {
+      double sum = B[i][r];
+      for (int j = i + 1; j < n; j++) {
+        sum -= A[i][j] * B[j][r];
+      }
+      B[i][r] = sum * inv_aii;
+    }
+  }
 
-    for (int j = 0; j < nfluids; j++) {
-      double rho = fluid_s[j][0];
+  return true;
+}
+
+// Solve the small collisional system A X = B in place. One and two
+// fluids are solved in closed form; for three and four fluids the
+// constant size lets the compiler fully unroll the elimination.
+static bool
+small_linsolve(int n, int nrhs, double A[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES], double B[GKYL_MAX_SPECIES][3])
+{
+  switch (n) {
+    case 1:
+      if (A[0][0] == 0.0) {
+        return false;
+      }
+      for (int r = 0; r < nrhs; r++) {
+        B[0][r] /= A[0][0];
+      }
+      return true;
 
-      nu_i[j] = nu_base[i][j] * rho;
+    case 2: {
+      double det = (A[0][0] * A[1][1]) - (A[0][1] * A[1][0]);
+      if (det == 0.0) {
+        return false;
+      }
+      double inv_det = 1.0 / det;
+      for (int r = 0; r < nrhs; r++) {
+        double b0 = B[0][r], b1 = B[1][r];
+        B[0][r] = ((A[1][1] * b0) - (A[0][1] * b1)) * inv_det;
+        B[1][r] = ((A[0][0] * b1) - (A[1][0] * b0)) * inv_det;
+      }
+      return true;
     }
+
+    case 3:
+      return small_lu_solve(3, nrhs, A, B);
+
+    case 4:
+      return small_lu_solve(4, nrhs, A, B);
+
+    default:
+      return small_lu_solve(n, nrhs, A, B);
   }
+}
 
-  double lhs[nfluids][nfluids];
-  double rhs[nfluids][3];
+void
+implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double dt, double* fluid_s[GKYL_MAX_SPECIES])
+{
+  int nfluids = mom_em->nfluids;
+
+  double nu[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES];
   for (int i = 0; i < nfluids; i++) {
     for (int j = 0; j < nfluids; j++) {
-      lhs[i][j] = 0.0;
-    }
+      double rho = fluid_s[j][0];
 
-    rhs[i][0] = 0.0; rhs[i][1] = 0.0; rhs[i][2] = 0.0;
+      nu[i][j] = mom_em->nu_base[i][j] * rho;
+    }
   }
 
+  // Velocities at the half time-step: the same matrix applies to all three components.
+  double lhs[GKYL_MAX_SPECIES][GKYL_MAX_SPECIES];
+  double rhs[GKYL_MAX_SPECIES][3];
   for (int i = 0; i < nfluids; i++) {
     double *f = fluid_s[i];
 
@@ -288,53 +365,28 @@ implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double d
     rhs[i][1] = mom_y / rho;
     rhs[i][2] = mom_z / rho;
 
+    for (int j = 0; j < nfluids; j++) {
+      lhs[i][j] = 0.0;
+    }
     lhs[i][i] = 1.0;
-    double* nu_i = nu + (nfluids * i);
 
     for (int j = 0; j < nfluids; j++) {
       if (i == j) {
-        lhs[i][i] += 0.5 * dt * nu_i[i];
+        lhs[i][i] += 0.5 * dt * nu[i][i];
       }
       else {
-        double dt_nu_ij = 0.5 * dt * nu_i[j];
+        double dt_nu_ij = 0.5 * dt * nu[i][j];
         lhs[i][i] += dt_nu_ij;
         lhs[i][j] -= dt_nu_ij;
       }
     }
   }
 
-  struct gkyl_mat *lhs_mat = gkyl_mat_new(nfluids, nfluids, 0.0);
-  struct gkyl_mat *rhs_mat = gkyl_mat_new(nfluids, 3, 0.0);
-
-  for (int i = 0; i < nfluids; i++) {
-    for (int j = 0; j < nfluids; j++) {
-      gkyl_mat_set(lhs_mat, i, j, lhs[i][j]);
-    }
-
-    gkyl_mat_set(rhs_mat, i, 0, rhs[i][0]);
-    gkyl_mat_set(rhs_mat, i, 1, rhs[i][1]);
-    gkyl_mat_set(rhs_mat, i, 2, rhs[i][2]);
-  }
-
-  gkyl_mem_buff sol_buff = gkyl_mem_buff_new(sizeof(long[nfluids]));
-  bool status = gkyl_mat_linsolve_lu(lhs_mat, rhs_mat, gkyl_mem_buff_data(sol_buff));
-
-  for (int i = 0; i < nfluids; i++) {
-    for (int j = 0; j < 3; j++) {
-      rhs[i][j] = gkyl_mat_get(rhs_mat, i, j);
-    }
-  }
-
-  double rhs_T[nfluids][1];
-  for (int i = 0; i < nfluids; i++) {
-    rhs_T[i][0] = 0.0;
-
-    for (int j = 0; j < nfluids; j++) {
-      lhs[i][j] = 0.0;
-    }
-  }
+  small_linsolve(nfluids, 3, lhs, rhs);
 
-  double T[nfluids];
+  // Temperatures at the half time-step, including frictional heating.
+  double rhs_T[GKYL_MAX_SPECIES][3];
+  double T[GKYL_MAX_SPECIES];
   for (int i = 0; i < nfluids; i++) {
     double *f = fluid_s[i];
     double m = mom_em->param[i].mass;
@@ -346,9 +398,11 @@ implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double d
 
     T[i] = (internal_energy / rho) * m;
     rhs_T[i][0] = T[i];
-    lhs[i][i] = 1.0;
 
-    double *nu_i = nu + (nfluids * i);
+    for (int j = 0; j < nfluids; j++) {
+      lhs[i][j] = 0.0;
+    }
+    lhs[i][i] = 1.0;
 
     for (int j = 0; j < nfluids; j++) {
       if (i != j) {
@@ -356,7 +410,7 @@ implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double d
         
         double du_sq = ((rhs[i][0] - rhs[j][0]) * (rhs[i][0] - rhs[j][0])) + ((rhs[i][1] - rhs[j][1]) * (rhs[i][1] - rhs[j][1])) +
           ((rhs[i][2] - rhs[j][2]) * (rhs[i][2] - rhs[j][2]));
-        double coeff_ij = (dt * nu_i[j] * m) / (m + m_j);
+        double coeff_ij = (dt * nu[i][j] * m) / (m + m_j);
 
         rhs_T[i][0] += 0.5 * coeff_ij * m_j * du_sq;
         lhs[i][i] += coeff_ij;
@@ -365,22 +419,7 @@ implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double d
     }
   }
 
-  struct gkyl_mat *lhs_T_mat = gkyl_mat_new(nfluids, nfluids, 0.0);
-  struct gkyl_mat *rhs_T_mat = gkyl_mat_new(nfluids, 1, 0.0);
-
-  for (int i = 0; i < nfluids; i++) {
-    for (int j = 0; j < nfluids; j++) {
-      gkyl_mat_set(lhs_T_mat, i, j, lhs[i][j]);
-    }
-
-    gkyl_mat_set(rhs_T_mat, i, 0, rhs_T[i][0]);
-  }
-
-  status = gkyl_mat_linsolve_lu(lhs_T_mat, rhs_T_mat, gkyl_mem_buff_data(sol_buff));
-
-  for (int i = 0; i < nfluids; i++) {
-    rhs_T[i][0] = gkyl_mat_get(rhs_T_mat, i, 0);
-  }
+  small_linsolve(nfluids, 1, lhs, rhs_T);
 
   for (int i = 0; i < nfluids; i++) {
     double *f = fluid_s[i];
@@ -405,11 +444,6 @@ implicit_collision_source_update(const gkyl_moment_em_coupling* mom_em, double d
     mom_x = f[1], mom_y = f[2], mom_z = f[3];
     f[4] = E + (0.5 * ((mom_x * mom_x) + (mom_y * mom_y) + (mom_z * mom_z)) / rho);
   }
-
-  gkyl_mem_buff_release(sol_buff);
-  gkyl_mat_release(lhs_mat);
-  gkyl_mat_release(rhs_mat);
-  gkyl_mat_release(rhs_T_mat);
 }
 
 void
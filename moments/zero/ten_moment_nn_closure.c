@@ -1,7 +1,18 @@
 #include <gkyl_alloc.h>
 #include <gkyl_array_ops.h>
 #include <gkyl_ten_moment_nn_closure.h>
+#include <gkyl_ten_moment_nn_closure_priv.h>
 #include <gkyl_moment_non_ideal_priv.h>
+#include <gkyl_thread_pool.h>
+
+#include <string.h>
+
+// BLAS includes
+#ifdef GKYL_USING_FRAMEWORK_ACCELERATE
+# include <Accelerate/Accelerate.h>
+#else
+# include <cblas.h>
+#endif
 
 // Makes indexing cleaner.
 static const unsigned Q111 = 0;
@@ -31,33 +42,11 @@ enum loc_2d {
   UL_2D, UU_2D
 };
 
-struct gkyl_ten_moment_nn_closure
-{
-  struct gkyl_rect_grid grid; // Grid on which to solve equations.
-  int ndim; // Number of dimensions.
-  int poly_order; // Polynomial order of learned DG coefficients.
-  double k0; // Damping coefficient.
-  kann_t* ann; // Neural network architecture.
+// Operators of the kann computational graph (indices into kad_op_list) that make up a dense network.
+enum {
+  KAD_OP_ADD = 1, KAD_OP_CMUL = 3, KAD_OP_SIGM = 6, KAD_OP_TANH = 7, KAD_OP_RELU = 8, KAD_OP_DROPOUT = 15
 };
 
-static void
-create_offsets_vertices(const struct gkyl_range* range, long offsets[])
-{
-  // Box-spanning stencil.
-  struct gkyl_range box3;
-  gkyl_range_init(&box3, range->ndim, (int[]) { -1, -1, -1 }, (int[]) { 0, 0, 0 });
-
-  struct gkyl_range_iter iter3;
-  gkyl_range_iter_init(&iter3, &box3);
-
-  // Construct a list of offsets.
-  int count = 0;
-  while (gkyl_range_iter_next(&iter3)) {
-    offsets[count] = gkyl_range_offset(range, iter3.idx);
-    count += 1;
-  }
-}
-
 static void
 create_offsets_centers(const struct gkyl_range *range, long offsets[])
 {
@@ -729,11 +718,11 @@ calc_mag_heat_flux(const gkyl_ten_moment_nn_closure *nnclosure, const double *fl
 }
 
 static void
-calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double *fluid_d[], const double *em_tot_d[], double *rhs)
+calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double *fluid_d[], const double *em_tot_d[], float *input_data,
+  const float *output_data, double *rhs)
 {
   const int ndim = nnclosure->ndim;
   const int poly_order = nnclosure->poly_order;
-  kann_t* ann = nnclosure->ann;
 
   double rho_avg = 0.0;
   double drho_dx = 0.0, drho_dy = 0.0, drho_dz = 0.0;
@@ -758,25 +747,6 @@ calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double
   double divQy[6] = { 0.0 };
   double divQz[6] = { 0.0 };
 
-  float *input_data;
-  float *output_data;
-  if (ndim == 1) {
-    if (poly_order == 1) {
-      input_data = gkyl_malloc(sizeof(float[6]));
-      output_data = gkyl_malloc(sizeof(float[4]));
-    }
-    else if (poly_order == 2) {
-      input_data = gkyl_malloc(sizeof(float[9]));
-      output_data = gkyl_malloc(sizeof(float[6]));
-    }
-  }
-  else if (ndim == 2) {
-    if (poly_order == 1) {
-      input_data = gkyl_malloc(sizeof(float[12]));
-      output_data = gkyl_malloc(sizeof(float[8]));
-    }
-  }
-
   if (ndim == 1) {
     if (poly_order == 1 ) {
       const double dx = nnclosure->grid.dx[0];
@@ -874,10 +844,9 @@ calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double
       input_data[4] = p_perp;
       input_data[5] = p_perp_dx;
 
-      const float *output_data_predicted = kann_apply1(ann, input_data);
-
-      for (int i = 0; i < 4; i++) {
-        output_data[i] = output_data_predicted[i];
+      if (output_data == 0) {
+        // Only the network inputs are wanted for this cell.
+        return;
       }
 
       double q_par = output_data[0];
@@ -1106,10 +1075,9 @@ calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double
       input_data[7] = p_perp_dx;
       input_data[8] = p_perp_dx_dx;
 
-      const float *output_data_predicted = kann_apply1(ann, input_data);
-
-      for (int i = 0; i < 6; i++) {
-        output_data[i] = output_data_predicted[i];
+      if (output_data == 0) {
+        // Only the network inputs are wanted for this cell.
+        return;
       }
 
       double q_par = output_data[0];
@@ -1370,10 +1338,9 @@ calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double
       input_data[10] = p_perp_dy;
       input_data[11] = p_perp_dx_dy;
 
-      const float *output_data_predicted = kann_apply1(ann, input_data);
-
-      for (int i = 0; i < 8; i++) {
-        output_data[i] = output_data_predicted[i];
+      if (output_data == 0) {
+        // Only the network inputs are wanted for this cell.
+        return;
       }
 
       double q_par = output_data[0];
@@ -1518,102 +1485,317 @@ calc_nn_closure_update(const gkyl_ten_moment_nn_closure *nnclosure, const double
   rhs[P22] = alpha * rho_avg * vth_avg * (divQx[3] + divQy[3] + divQz[3]);
   rhs[P23] = alpha * rho_avg * vth_avg * (divQx[4] + divQy[4] + divQz[4]);
   rhs[P33] = alpha * rho_avg * vth_avg * (divQx[5] + divQy[5] + divQz[5]);
-
-  gkyl_free(input_data);
-  gkyl_free(output_data);
 }
 
-void
-gkyl_ten_moment_nn_closure_advance(const gkyl_ten_moment_nn_closure *nnclosure, const struct gkyl_range *heat_flux_rng, const struct gkyl_range *update_rng,
-  const struct gkyl_array *fluid, const struct gkyl_array *em_tot, struct gkyl_array *heat_flux, struct gkyl_array *rhs)
+struct nn_dense_net*
+nn_dense_net_new(kann_t* ann)
 {
-  int poly_order = nnclosure->poly_order;
-  int ndim = update_rng->ndim;
-  long sz[] = { 2, 4, 8 };
-  long sz_p2[] = { 3, 9, 27 };
+  int i_out = kann_find(ann, KANN_F_OUT, 0);
+  if (i_out < 0) {
+    return 0;
+  }
 
-  long offsets_vertices[sz[ndim - 1]];
-  long offsets_vertices_p2[sz_p2[ndim - 1]];
-  if (poly_order == 1) {
-    create_offsets_vertices(update_rng, offsets_vertices);
+  // Walk the graph back from the output to the input, one dense layer (and its activation) at a time.
+  int num_layers = 0;
+  kad_node_t *dense[ann->n];
+  enum nn_activation act[ann->n];
+
+  kad_node_t *p = ann->v[i_out];
+  while (true) {
+    while (p->op == KAD_OP_DROPOUT) {
+      p = p->child[0];
+    }
+    if (kad_is_feed(p)) {
+      break;
+    }
+
+    act[num_layers] = NN_ACT_NONE;
+    if (p->op == KAD_OP_TANH || p->op == KAD_OP_SIGM || p->op == KAD_OP_RELU) {
+      act[num_layers] = p->op == KAD_OP_TANH ? NN_ACT_TANH : (p->op == KAD_OP_SIGM ? NN_ACT_SIGM : NN_ACT_RELU);
+      p = p->child[0];
+    }
+
+    // Dense layer: add(cmul(x, w), b).
+    if (p->op != KAD_OP_ADD || p->child[0]->op != KAD_OP_CMUL || !kad_is_var(p->child[1]) || !kad_is_var(p->child[0]->child[1])) {
+      return 0;
+    }
+    dense[num_layers] = p;
+    num_layers += 1;
+
+    p = p->child[0]->child[0];
   }
-  else {
-    create_offsets_vertices(update_rng, offsets_vertices_p2);
+  if (!(p->ext_flag & KANN_F_IN) || num_layers == 0) {
+    return 0;
   }
 
-  long offsets_centers[sz[ndim - 1]];
-  long offsets_centers_p2[sz_p2[ndim - 1]];
-  if (poly_order == 1) {
-    create_offsets_centers(heat_flux_rng, offsets_centers);
+  struct nn_dense_net *net = gkyl_malloc(sizeof(struct nn_dense_net));
+  net->num_layers = num_layers;
+  net->layers = gkyl_malloc(sizeof(struct nn_dense_layer[num_layers]));
+
+  for (int l = 0; l < num_layers; l++) {
+    const kad_node_t *w = dense[num_layers - 1 - l]->child[0]->child[1];
+    const kad_node_t *b = dense[num_layers - 1 - l]->child[1];
+    struct nn_dense_layer *layer = &net->layers[l];
+
+    // kann stores the weights as an n_out x n_in row-major matrix; keep the transpose, so that the inputs of a tile
+    // (one row per cell) multiply it directly.
+    layer->n_out = w->d[0];
+    layer->n_in = w->d[1];
+    layer->act = act[num_layers - 1 - l];
+    layer->wt = gkyl_malloc(sizeof(float[layer->n_in * layer->n_out]));
+    layer->b = gkyl_malloc(sizeof(float[layer->n_out]));
+
+    for (int o = 0; o < layer->n_out; o++) {
+      for (int i = 0; i < layer->n_in; i++) {
+        layer->wt[(i * layer->n_out) + o] = w->x[(o * layer->n_in) + i];
+      }
+      layer->b[o] = b->x[o];
+    }
   }
-  else {
-    create_offsets_centers(heat_flux_rng, offsets_centers_p2);
+
+  for (int l = 1; l < num_layers; l++) {
+    if (net->layers[l].n_in != net->layers[l - 1].n_out) {
+      nn_dense_net_release(net);
+      return 0;
+    }
   }
 
-  const double *fluid_d[sz[ndim - 1]];
-  const double *fluid_d_p2[sz_p2[ndim - 1]];
-  const double *em_tot_d[sz[ndim - 1]];
-  const double *em_tot_d_p2[sz_p2[ndim - 1]];
-  double *heat_flux_d;
-  const double *heat_flux_up[sz[ndim - 1]];
-  const double *heat_flux_up_p2[sz_p2[ndim - 1]];
-  double *rhs_d;
-
-  struct gkyl_range_iter iter_vertex;
-  gkyl_range_iter_init(&iter_vertex, heat_flux_rng);
-  while (gkyl_range_iter_next(&iter_vertex)) {
-    long linc_vertex = gkyl_range_idx(heat_flux_rng, iter_vertex.idx);
-    long linc_center = gkyl_range_idx(update_rng, iter_vertex.idx);
+  return net;
+}
 
-    if (poly_order == 1) {
-      for (int i = 0; i < sz[ndim - 1]; i++) {
-        em_tot_d[i] = gkyl_array_cfetch(em_tot, linc_center + offsets_vertices[i]);
-        fluid_d[i] = gkyl_array_cfetch(fluid, linc_center + offsets_vertices[i]);
+void
+nn_dense_net_apply(const struct nn_dense_net* net, struct nn_tile_mem* mem, int ntile)
+{
+  const float *x = mem->input_data;
+
+  for (int l = 0; l < net->num_layers; l++) {
+    const struct nn_dense_layer *layer = &net->layers[l];
+    int n_out = layer->n_out;
+    float *y = l == net->num_layers - 1 ? mem->output_data : mem->hidden[l];
+
+    for (int c = 0; c < ntile; c++) {
+      for (int o = 0; o < n_out; o++) {
+        y[(c * n_out) + o] = layer->b[o];
       }
     }
-    else {
-      for (int i = 0; i < sz_p2[ndim - 1]; i++) {
-        em_tot_d_p2[i] = gkyl_array_cfetch(em_tot, linc_center + offsets_vertices_p2[i]);
-        fluid_d_p2[i] = gkyl_array_cfetch(fluid, linc_center + offsets_vertices_p2[i]);
+
+    // y = x W^T + b, for all cells of the tile at once.
+    cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, ntile, n_out, layer->n_in, 1.0f, x, layer->n_in, layer->wt, n_out,
+      1.0f, y, n_out);
+
+    // Activations are computed as in kann.
+    long n = (long) n_out * ntile;
+    if (layer->act == NN_ACT_TANH) {
+      for (long k = 0; k < n; k++) {
+        float e = expf(-2.0f * y[k]);
+        y[k] = y[k] < -20.0f ? -1.0f : (1.0f - e) / (1.0f + e);
+      }
+    }
+    else if (layer->act == NN_ACT_SIGM) {
+      for (long k = 0; k < n; k++) {
+        y[k] = 1.0f / (1.0f + expf(-y[k]));
+      }
+    }
+    else if (layer->act == NN_ACT_RELU) {
+      for (long k = 0; k < n; k++) {
+        y[k] = y[k] > 0.0f ? y[k] : 0.0f;
       }
     }
 
-    heat_flux_d = gkyl_array_fetch(heat_flux, linc_vertex);
+    x = y;
+  }
+}
+
+void
+nn_dense_net_release(struct nn_dense_net* net)
+{
+  for (int l = 0; l < net->num_layers; l++) {
+    gkyl_free(net->layers[l].wt);
+    gkyl_free(net->layers[l].b);
+  }
+  gkyl_free(net->layers);
+  gkyl_free(net);
+}
 
-    // Unnecessary to calculate heat flux separately for now, so commenting this out for efficiency.
-    // calc_mag_heat_flux(nnclosure, fluid_d, em_tot_d, heat_flux_d);
+struct nn_tile_mem*
+nn_tile_mem_new(int n_in, int n_out, const struct nn_dense_net* net)
+{
+  struct nn_tile_mem *mem = gkyl_malloc(sizeof(struct nn_tile_mem));
+
+  mem->n_in = n_in;
+  mem->n_out = n_out;
+  mem->input_data = gkyl_calloc(NN_TILE_SIZE * n_in, sizeof(float));
+  mem->output_data = gkyl_calloc(NN_TILE_SIZE * n_out, sizeof(float));
+  mem->linc_vertex = gkyl_malloc(sizeof(long[NN_TILE_SIZE]));
+  mem->linc_center = gkyl_malloc(sizeof(long[NN_TILE_SIZE]));
+
+  mem->num_hidden = net ? net->num_layers - 1 : 0;
+  mem->hidden = gkyl_malloc(sizeof(float*[mem->num_hidden + 1]));
+  for (int l = 0; l < mem->num_hidden; l++) {
+    mem->hidden[l] = gkyl_calloc(NN_TILE_SIZE * net->layers[l].n_out, sizeof(float));
   }
 
-  struct gkyl_range_iter iter_center;
-  gkyl_range_iter_init(&iter_center, update_rng);
-  while (gkyl_range_iter_next(&iter_center)) {
-    long linc_vertex = gkyl_range_idx(heat_flux_rng, iter_center.idx);
-    long linc_center = gkyl_range_idx(update_rng, iter_center.idx);
+  return mem;
+}
 
-    if (poly_order == 1) {
-      for (int i = 0; i < sz[ndim - 1]; i++) {
-        em_tot_d[i] = gkyl_array_cfetch(em_tot, linc_vertex + offsets_centers[i]);
-        fluid_d[i] = gkyl_array_cfetch(fluid, linc_vertex + offsets_centers[i]);
-      }
+void
+nn_tile_mem_release(struct nn_tile_mem* mem)
+{
+  for (int l = 0; l < mem->num_hidden; l++) {
+    gkyl_free(mem->hidden[l]);
+  }
+  gkyl_free(mem->hidden);
+  gkyl_free(mem->input_data);
+  gkyl_free(mem->output_data);
+  gkyl_free(mem->linc_vertex);
+  gkyl_free(mem->linc_center);
+  gkyl_free(mem);
+}
+
+// Number of network inputs and outputs per cell.
+static void
+nn_closure_dims(int ndim, int poly_order, int* n_in, int* n_out)
+{
+  if (ndim == 1 && poly_order == 1) {
+    *n_in = 6; *n_out = 4;
+  }
+  else if (ndim == 1 && poly_order == 2) {
+    *n_in = 9; *n_out = 6;
+  }
+  else {
+    *n_in = 12; *n_out = 8;
+  }
+}
+
+// Context for the closure update of one split of the update range.
+struct nn_closure_advance_ctx {
+  const gkyl_ten_moment_nn_closure *nnclosure;
+  struct nn_tile_mem *mem; // Tile memory for this split.
+  struct gkyl_range range; // Split of the update range.
+  const struct gkyl_range *heat_flux_rng;
+  const struct gkyl_range *update_rng;
+  int nsten; // Number of cells in the stencil.
+  const long *offsets; // Offsets of the stencil cells.
+  const struct gkyl_array *fluid;
+  const struct gkyl_array *em_tot;
+  struct gkyl_array *rhs;
+};
+
+static inline void
+fetch_stencil(const struct nn_closure_advance_ctx *actx, long linc_vertex, const double *fluid_d[], const double *em_tot_d[])
+{
+  for (int i = 0; i < actx->nsten; i++) {
+    em_tot_d[i] = gkyl_array_cfetch(actx->em_tot, linc_vertex + actx->offsets[i]);
+    fluid_d[i] = gkyl_array_cfetch(actx->fluid, linc_vertex + actx->offsets[i]);
+  }
+}
+
+// Update the cells of a split of the update range, NN_TILE_SIZE cells at a time: gather the network inputs of all cells of
+// the tile, evaluate the network on the whole tile, and then compute the update of each cell from its network outputs. The
+// per-cell stencil work is cheap next to the network evaluation, so it is redone in the last step rather than stored.
+static void
+nn_closure_advance_range(const struct nn_closure_advance_ctx *actx)
+{
+  const gkyl_ten_moment_nn_closure *nnclosure = actx->nnclosure;
+  struct nn_tile_mem *mem = actx->mem;
+  int n_in = mem->n_in, n_out = mem->n_out;
+
+  const double *fluid_d[actx->nsten];
+  const double *em_tot_d[actx->nsten];
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &actx->range);
+  bool more = gkyl_range_iter_next(&iter);
+
+  while (more) {
+    int ntile = 0;
+    while (more && ntile < NN_TILE_SIZE) {
+      long linc_vertex = gkyl_range_idx(actx->heat_flux_rng, iter.idx);
+      mem->linc_vertex[ntile] = linc_vertex;
+      mem->linc_center[ntile] = gkyl_range_idx(actx->update_rng, iter.idx);
+
+      fetch_stencil(actx, linc_vertex, fluid_d, em_tot_d);
+      calc_nn_closure_update(nnclosure, fluid_d, em_tot_d, &mem->input_data[ntile * n_in], 0, 0);
+
+      ntile += 1;
+      more = gkyl_range_iter_next(&iter);
+    }
+
+    if (nnclosure->net) {
+      nn_dense_net_apply(nnclosure->net, mem, ntile);
     }
     else {
-      for (int i = 0; i < sz_p2[ndim - 1]; i++) {
-        em_tot_d_p2[i] = gkyl_array_cfetch(em_tot, linc_vertex + offsets_centers_p2[i]);
-        fluid_d_p2[i] = gkyl_array_cfetch(fluid, linc_vertex + offsets_centers_p2[i]);
+      for (int c = 0; c < ntile; c++) {
+        const float *output_data = kann_apply1(nnclosure->ann, &mem->input_data[c * n_in]);
+        memcpy(&mem->output_data[c * n_out], output_data, sizeof(float[n_out]));
       }
     }
 
-    rhs_d = gkyl_array_fetch(rhs, linc_center);
-
-    if (poly_order == 1) {
-      calc_nn_closure_update(nnclosure, fluid_d, em_tot_d, rhs_d);
-    }
-    else {
-      calc_nn_closure_update(nnclosure, fluid_d_p2, em_tot_d_p2, rhs_d);
+    for (int c = 0; c < ntile; c++) {
+      fetch_stencil(actx, mem->linc_vertex[c], fluid_d, em_tot_d);
+      calc_nn_closure_update(nnclosure, fluid_d, em_tot_d, &mem->input_data[c * n_in], &mem->output_data[c * n_out],
+        gkyl_array_fetch(actx->rhs, mem->linc_center[c]));
     }
   }
 }
 
+static void
+nn_closure_advance_job(void* ctx)
+{
+  nn_closure_advance_range(ctx);
+}
+
+void
+gkyl_ten_moment_nn_closure_advance(const gkyl_ten_moment_nn_closure *nnclosure, const struct gkyl_range *heat_flux_rng, const struct gkyl_range *update_rng,
+  const struct gkyl_array *fluid, const struct gkyl_array *em_tot, struct gkyl_array *heat_flux, struct gkyl_array *rhs)
+{
+  int poly_order = nnclosure->poly_order;
+  int ndim = update_rng->ndim;
+  long sz[] = { 2, 4, 8 };
+  long sz_p2[] = { 3, 9, 27 };
+
+  long offsets_centers[sz[ndim - 1]];
+  long offsets_centers_p2[sz_p2[ndim - 1]];
+  if (poly_order == 1) {
+    create_offsets_centers(heat_flux_rng, offsets_centers);
+  }
+  else {
+    create_offsets_centers(heat_flux_rng, offsets_centers_p2);
+  }
+
+  // The magnetized heat flux (calc_mag_heat_flux) is not needed
+  // separately for now, so heat_flux is not filled.
+
+  struct nn_closure_advance_ctx actx = {
+    .nnclosure = nnclosure,
+    .mem = nnclosure->mem[0],
+    .range = *update_rng,
+    .heat_flux_rng = heat_flux_rng,
+    .update_rng = update_rng,
+    .nsten = poly_order == 1 ? sz[ndim - 1] : sz_p2[ndim - 1],
+    .offsets = poly_order == 1 ? offsets_centers : offsets_centers_p2,
+    .fluid = fluid,
+    .em_tot = em_tot,
+    .rhs = rhs,
+  };
+
+  if (!nnclosure->thread_pool) {
+    nn_closure_advance_range(&actx);
+    return;
+  }
+
+  // Each cell is updated independently, so contiguous chunks of the update range are handed to the threads.
+  int nthreads = nnclosure->thread_pool->pool_size;
+  struct nn_closure_advance_ctx actx_split[nthreads];
+  for (int tid = 0; tid < nthreads; tid++) {
+    actx_split[tid] = actx;
+    actx_split[tid].mem = nnclosure->mem[tid];
+    actx_split[tid].range = gkyl_range_split((struct gkyl_range*) update_rng, nthreads, tid);
+    gkyl_job_pool_add_work(nnclosure->thread_pool, nn_closure_advance_job, &actx_split[tid]);
+  }
+  gkyl_job_pool_wait(nnclosure->thread_pool);
+}
+
 gkyl_ten_moment_nn_closure*
 gkyl_ten_moment_nn_closure_new(struct gkyl_ten_moment_nn_closure_inp inp)
 {
@@ -1625,11 +1807,43 @@ gkyl_ten_moment_nn_closure_new(struct gkyl_ten_moment_nn_closure_inp inp)
   up->poly_order = inp.poly_order;
   up->ann = inp.ann;
 
+  int n_in, n_out;
+  nn_closure_dims(up->ndim, up->poly_order, &n_in, &n_out);
+
+  // Networks that are not a plain stack of dense layers (or do not have the expected shape) are evaluated cell by cell with kann.
+  up->net = nn_dense_net_new(inp.ann);
+  if (up->net && (up->net->layers[0].n_in != n_in || up->net->layers[up->net->num_layers - 1].n_out != n_out)) {
+    nn_dense_net_release(up->net);
+    up->net = 0;
+  }
+
+  // kann evaluates a network in place, so the cell-by-cell fallback cannot be threaded.
+  up->thread_pool = 0;
+  if (inp.num_threads > 1 && up->net) {
+    up->thread_pool = gkyl_thread_pool_new(inp.num_threads);
+  }
+
+  up->num_mem = up->thread_pool ? up->thread_pool->pool_size : 1;
+  up->mem = gkyl_malloc(sizeof(struct nn_tile_mem*[up->num_mem]));
+  for (int i = 0; i < up->num_mem; i++) {
+    up->mem[i] = nn_tile_mem_new(n_in, n_out, up->net);
+  }
+
   return up;
 }
 
 void
 gkyl_ten_moment_nn_closure_release(gkyl_ten_moment_nn_closure *nnclosure)
 {
-  free(nnclosure);
-}
\ No newline at end of file
+  for (int i = 0; i < nnclosure->num_mem; i++) {
+    nn_tile_mem_release(nnclosure->mem[i]);
+  }
+  gkyl_free(nnclosure->mem);
+  if (nnclosure->net) {
+    nn_dense_net_release(nnclosure->net);
+  }
+  if (nnclosure->thread_pool) {
+    gkyl_job_pool_release(nnclosure->thread_pool);
+  }
+  gkyl_free(nnclosure);
+}
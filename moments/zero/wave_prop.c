@@ -21,6 +21,8 @@ struct gkyl_wave_prop {
   enum gkyl_wave_limiter limiter; // limiter to use
   double cfl; // CFL number
   const struct gkyl_wv_eqn *equation; // equation object
+  const struct gkyl_array *aux; // auxiliary variables (NULL if none)
+  int meqn; // number of evolved variables stored in solution arrays
 
   bool force_low_order_flux; // only use Lax flux
   bool check_inv_domain; // flag to indicate if invariant domains are checked
@@ -34,6 +36,11 @@ struct gkyl_wave_prop {
   struct gkyl_array *waves, *apdq, *amdq, *speeds, *flux2;
   // flags to indicate if fluctuations should be recomputed
   struct gkyl_array *redo_fluct;
+  // full state vectors of the cells of a 1D slice (NULL if no
+  // auxiliary variables)
+  struct gkyl_array *qfull;
+  // band of cells that may need reinitialization (NULL if not tracked)
+  struct gkyl_level_set_band *band;
 
   // some stats
   long n_calls; // number of calls to updater
@@ -119,6 +126,9 @@ gkyl_wave_prop_new(const struct gkyl_wave_prop_inp *winp)
   up->cfl = winp->cfl;
   up->equation = gkyl_wv_eqn_acquire(winp->equation);
 
+  up->aux = winp->aux ? gkyl_array_acquire(winp->aux) : 0;
+  up->meqn = up->equation->num_equations - (up->aux ? up->aux->ncomp : 0);
+
   if (winp->comm)
     up->comm = gkyl_comm_acquire(winp->comm);
   else
@@ -141,7 +151,7 @@ gkyl_wave_prop_new(const struct gkyl_wave_prop_inp *winp)
 
   // allocate memory to store 1D slices of waves, speeds and
   // second-order correction flux
-  int meqn = winp->equation->num_equations, mwaves = winp->equation->num_waves;
+  int meqn = up->meqn, mwaves = winp->equation->num_waves;
   up->waves = gkyl_array_new(GKYL_DOUBLE, meqn*mwaves, max_1d);
   up->apdq = gkyl_array_new(GKYL_DOUBLE, meqn, max_1d);
   up->amdq = gkyl_array_new(GKYL_DOUBLE, meqn, max_1d);
@@ -149,8 +159,11 @@ gkyl_wave_prop_new(const struct gkyl_wave_prop_inp *winp)
   up->flux2 = gkyl_array_new(GKYL_DOUBLE, meqn, max_1d);
 
   up->redo_fluct = gkyl_array_new(GKYL_DOUBLE, meqn, max_1d);
+  up->qfull = up->aux ?
+    gkyl_array_new(GKYL_DOUBLE, up->equation->num_equations, max_1d) : 0;
 
   up->geom = gkyl_wave_geom_acquire(winp->geom);
+  up->band = winp->band ? gkyl_level_set_band_acquire(winp->band) : 0;
 
   up->n_calls = up->n_bad_advance_calls = 0;
   up->n_bad_cells = up->n_max_bad_cells = 0;
@@ -166,6 +179,62 @@ copy_wv_vec(int n, double * GKYL_RESTRICT out, const double * GKYL_RESTRICT inp)
   for (int i=0; i<n; ++i) out[i] = inp[i];
 }
 
+// Full state vector of cell loc: either the solution itself, or its
+// evolved variables followed by the auxiliary ones (assembled in qfull)
+static inline const double*
+cell_state(const gkyl_wave_prop *wv, const struct gkyl_array *q, long loc, double *qfull)
+{
+  if (!wv->aux)
+    return gkyl_array_cfetch(q, loc);
+  gkyl_wv_eqn_assemble_state(wv->equation, wv->aux->ncomp,
+    gkyl_array_cfetch(q, loc), gkyl_array_cfetch(wv->aux, loc), qfull);
+  return qfull;
+}
+
+// Copy the auxiliary variables of the cells of a 1D slice into the
+// trailing components of their full state vectors, once per slice
+static void
+slice_load_aux(gkyl_wave_prop *wv, const struct gkyl_range *update_range,
+  const struct gkyl_range *cell_slice, int dir, int *idx)
+{
+  int nevol = wv->meqn, naux = wv->aux->ncomp;
+  for (int i=cell_slice->lower[0]; i<=cell_slice->upper[0]; ++i) {
+    idx[dir] = i;
+    const double *aux = gkyl_array_cfetch(wv->aux, gkyl_range_idx(update_range, idx));
+    double *qf = gkyl_array_fetch(wv->qfull, gkyl_ridx(*cell_slice, i));
+    for (int c=0; c<naux; ++c) qf[nevol+c] = aux[c];
+  }
+}
+
+// Full state vector of cell i of a 1D slice: either the solution
+// itself, or its evolved variables copied in front of the auxiliary
+// ones loaded by slice_load_aux
+static inline const double*
+slice_state(const gkyl_wave_prop *wv, const struct gkyl_array *q, long loc,
+  const struct gkyl_range *cell_slice, int i)
+{
+  if (!wv->aux)
+    return gkyl_array_cfetch(q, loc);
+  double *qf = gkyl_array_fetch(wv->qfull, gkyl_ridx(*cell_slice, i));
+  copy_wv_vec(wv->meqn, qf, gkyl_array_cfetch(q, loc));
+  return qf;
+}
+
+// Rotate a wave or fluctuation back to global coordinates, keeping
+// only the evolved variables
+static inline void
+rotate_to_global_evolved(const gkyl_wave_prop *wv, const double *tau1, const double *tau2, const double *norm,
+  const double *qlocal, double *qglobal)
+{
+  if (!wv->aux) {
+    gkyl_wv_eqn_rotate_to_global(wv->equation, tau1, tau2, norm, qlocal, qglobal);
+    return;
+  }
+  double qfull[wv->equation->num_equations];
+  gkyl_wv_eqn_rotate_to_global(wv->equation, tau1, tau2, norm, qlocal, qfull);
+  copy_wv_vec(wv->meqn, qglobal, qfull);
+}
+
 static inline void
 calc_jump(int n, const double *ql, const double *qr, double * GKYL_RESTRICT jump)
 {
@@ -237,7 +306,7 @@ limit_waves(const gkyl_wave_prop *wv, int mwaves,
   const struct gkyl_range *slice_range,
   int lower, int upper, struct gkyl_array *waves, const struct gkyl_array *speed)
 {
-  int meqn = wv->equation->num_equations;
+  int meqn = wv->meqn;
 
   for (int mw=0; mw<mwaves; ++mw) {
     const double *wl = gkyl_array_cfetch(waves, gkyl_ridx(*slice_range, lower-1));
@@ -273,18 +342,20 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
   wv->n_calls += 1;
   
   int ndim = update_range->ndim;
-  int meqn = wv->equation->num_equations;
+  // number of evolved variables, and size of the full state vector
+  // seen by the equation object
+  int meqn = wv->meqn, meqn_full = wv->equation->num_equations;
   //  when forced to use Lax fluxes, we only have a single wave
   int mwaves = wv->force_low_order_flux ? 2 :  wv->equation->num_waves;
 
   double cfla = 0.0, cfl = wv->cfl, cflm = 1.1*cfl;
   double is_cfl_violated = 0.0; // delibrately a double
   
-  double ql_local[meqn], qr_local[meqn];
-  double fjump_local[meqn];
-  double waves_local[meqn*mwaves];
-  double amdq_local[meqn], apdq_local[meqn];
-  double delta[meqn];
+  double ql_local[meqn_full], qr_local[meqn_full];
+  double fjump_local[meqn_full];
+  double waves_local[meqn_full*mwaves];
+  double amdq_local[meqn_full], apdq_local[meqn_full];
+  double delta[meqn_full];
 
   int idxl[GKYL_MAX_DIM], idxr[GKYL_MAX_DIM];
 
@@ -310,12 +381,18 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
 
     struct gkyl_range slice_range;
     gkyl_range_init(&slice_range, 1, (int[]) { loidx }, (int[]) { upidx } );
+    // cells to the left and right of the edges in the slice
+    struct gkyl_range cell_slice;
+    gkyl_range_init(&cell_slice, 1, (int[]) { loidx-1 }, (int[]) { upidx } );
 
     struct gkyl_range perp_range;
     gkyl_range_shorten_from_above(&perp_range, update_range, dir, 1);
     struct gkyl_range_iter iter;
     gkyl_range_iter_init(&iter, &perp_range);
 
+    if (wv->band)
+      gkyl_level_set_band_begin_sweep(wv->band, update_range, qin, qout);
+
     // outer loop is over perpendicular directions, inner loop over 1D
     // slice along that direction
     while (gkyl_range_iter_next(&iter)) {
@@ -324,6 +401,8 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
       gkyl_copy_int_arr(ndim, iter.idx, idxr);
 
       gkyl_array_clear(wv->redo_fluct, 1.0);
+      if (wv->aux)
+        slice_load_aux(wv, update_range, &cell_slice, dir, idxl);
       
       enum gkyl_wv_flux_type ftype = wv->force_low_order_flux ?
         GKYL_WV_LOW_ORDER_FLUX : GKYL_WV_HIGH_ORDER_FLUX;
@@ -359,14 +438,14 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
             long lidx = gkyl_range_idx(update_range, idxl);
             long ridx = gkyl_range_idx(update_range, idxr);
 
-            const double *qinl = gkyl_array_cfetch(qin, lidx);
-            const double *qinr = gkyl_array_cfetch(qin, ridx);
+            const double *qinl = slice_state(wv, qin, lidx, &cell_slice, i-1);
+            const double *qinr = slice_state(wv, qin, ridx, &cell_slice, i);
 
             gkyl_wv_eqn_rotate_to_local(wv->equation, cg->tau1[dir], cg->tau2[dir], cg->norm[dir], qinl, ql_local);
             gkyl_wv_eqn_rotate_to_local(wv->equation, cg->tau1[dir], cg->tau2[dir], cg->norm[dir], qinr, qr_local);
 
             if (wv->split_type == GKYL_WAVE_QWAVE)
-              calc_jump(meqn, ql_local, qr_local, delta);
+              calc_jump(meqn_full, ql_local, qr_local, delta);
             else
               gkyl_wv_eqn_flux_jump(wv->equation, ql_local, qr_local, delta);
 
@@ -389,17 +468,17 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
             double *waves = gkyl_array_fetch(wv->waves, sidx);
             for (int mw=0; mw<mwaves; ++mw)
               // rotate waves back
-              gkyl_wv_eqn_rotate_to_global(wv->equation, 
-                cg->tau1[dir], cg->tau2[dir], cg->norm[dir], &waves_local[mw*meqn], &waves[mw*meqn]
+              rotate_to_global_evolved(wv,
+                cg->tau1[dir], cg->tau2[dir], cg->norm[dir], &waves_local[mw*meqn_full], &waves[mw*meqn]
               );
 
             // rotate fluctuations
             double *amdq = gkyl_array_fetch(wv->amdq, sidx);
-            gkyl_wv_eqn_rotate_to_global(wv->equation, 
+            rotate_to_global_evolved(wv,
               cg->tau1[dir], cg->tau2[dir], cg->norm[dir], amdq_local, amdq);
             
             double *apdq = gkyl_array_fetch(wv->apdq, sidx);
-           gkyl_wv_eqn_rotate_to_global(wv->equation, 
+            rotate_to_global_evolved(wv,
               cg->tau1[dir], cg->tau2[dir], cg->norm[dir], apdq_local, apdq);
           }
           
@@ -499,7 +578,7 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
           // of each bad cell
           for (int i=loidx_c; i<=upidx_c; ++i) {
             idxl[dir] = i;
-            const double *qt = gkyl_array_cfetch(qout, gkyl_range_idx(update_range, idxl));
+            const double *qt = slice_state(wv, qout, gkyl_range_idx(update_range, idxl), &cell_slice, i);
             if (!gkyl_wv_eqn_check_inv(wv->equation, qt)) {
 
               double *redo_fluct_l = gkyl_array_fetch(wv->redo_fluct, gkyl_ridx(slice_range, i));
@@ -523,34 +602,39 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
         }
 
         if (wv->equation->type == GKYL_EQN_EULER_RGFM) {
-          euler_rgfm_reinit_level_set(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          euler_rgfm_reinit_level_set(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_MAXWELL) {
-          gr_maxwell_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_maxwell_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_MAXWELL_TETRAD) {
-          gr_maxwell_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_maxwell_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
-        if (wv->equation->type == GKYL_EQN_GR_EULER) {
-          gr_euler_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+        // a static spacetime stored as auxiliary variables is never
+        // modified, and so needs no reinitialization
+        if (wv->equation->type == GKYL_EQN_GR_EULER && !wv->aux) {
+          gr_euler_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_EULER_TETRAD) {
-          gr_euler_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_euler_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_ULTRA_REL_EULER) {
-          gr_ultra_rel_euler_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_ultra_rel_euler_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_ULTRA_REL_EULER_TETRAD) {
-          gr_ultra_rel_euler_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_ultra_rel_euler_tetrad_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
         if (wv->equation->type == GKYL_EQN_GR_TWOFLUID) {
-          gr_twofluid_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir);
+          gr_twofluid_impose_gauge(wv, update_range, idxl, loidx_c, upidx_c, qout, dir, wv->band);
         }
 
         state = next_state; // change state for next sweep
         
       } // end loop over sweeps
     } // end loop over perpendicular directions
+
+    if (wv->band)
+      gkyl_level_set_band_end_sweep(wv->band, update_range);
   } // end loop over directions
 
   outsideloop:
@@ -567,13 +651,17 @@ gkyl_wave_prop_advance(gkyl_wave_prop *wv,
 
   double dt_suggested = dt*cfl/fmax(cfla, DBL_MIN);
 
-  if (is_cfl_violated > 0.0)
+  if (is_cfl_violated > 0.0) {
+    // the band no longer matches the partially updated solution
+    if (wv->band)
+      gkyl_level_set_band_invalidate(wv->band);
     // indicate failure, and return smaller stable time-step
     return (struct gkyl_wave_prop_status) {
       .success = 0,
       .dt_suggested = dt_suggested,
       .max_speed = max_speed,
     };
+  }
   
   // on success, suggest only bigger time-step; (Only way dt can
   // reduce is if the update fails. If the code comes here the update
@@ -591,17 +679,18 @@ gkyl_wave_prop_max_dt(const gkyl_wave_prop *wv, const struct gkyl_range *update_
   const struct gkyl_array *qin)
 {
   double max_dt = DBL_MAX;
+  double qfull[wv->equation->num_equations];
   
   struct gkyl_range_iter iter;
   gkyl_range_iter_init(&iter, update_range);
   while (gkyl_range_iter_next(&iter)) {
 
+    const double *q = cell_state(wv, qin, gkyl_range_idx(update_range, iter.idx), qfull);
+    double maxs = gkyl_wv_eqn_max_speed(wv->equation, q);
+
     for (int d=0; d<wv->num_up_dirs; ++d) {
       int dir = wv->update_dirs[d];
       double dx = wv->grid.dx[dir];
-
-      const double *q = gkyl_array_cfetch(qin, gkyl_range_idx(update_range, iter.idx));
-      double maxs = gkyl_wv_eqn_max_speed(wv->equation, q);
       max_dt = fmin(max_dt, wv->cfl*dx/maxs);
     }
     
@@ -625,6 +714,10 @@ void
 gkyl_wave_prop_release(gkyl_wave_prop* up)
 {
   gkyl_wv_eqn_release(up->equation);
+  if (up->aux) {
+    gkyl_array_release(up->aux);
+    gkyl_array_release(up->qfull);
+  }
   gkyl_array_release(up->waves);
   gkyl_array_release(up->apdq);
   gkyl_array_release(up->amdq);
@@ -634,6 +727,8 @@ gkyl_wave_prop_release(gkyl_wave_prop* up)
   gkyl_comm_release(up->comm);
   
   gkyl_wave_geom_release(up->geom);
+  if (up->band)
+    gkyl_level_set_band_release(up->band);
   
   gkyl_free(up);
 }
@@ -14,6 +14,7 @@ struct gkyl_wv_apply_bc {
 
   const struct gkyl_wv_eqn *eqn; // equation 
   const struct gkyl_wave_geom *geom; // geometry needed for BCs
+  const struct gkyl_array *aux; // auxiliary variables (NULL if none)
   
   wv_bc_func_t bcfunc; // function pointer
   void *ctx; // context to pass to function
@@ -37,6 +38,7 @@ gkyl_wv_apply_bc_new(const struct gkyl_rect_grid *grid,
 
   up->eqn = gkyl_wv_eqn_acquire(eqn);
   up->geom = gkyl_wave_geom_acquire(geom);
+  up->aux = 0;
   
   up->bcfunc = bcfunc;
   up->ctx = ctx;
@@ -49,6 +51,26 @@ gkyl_wv_apply_bc_new(const struct gkyl_rect_grid *grid,
   return up;
 }
 
+void
+gkyl_wv_apply_bc_set_aux(gkyl_wv_apply_bc *bc, const struct gkyl_array *aux)
+{
+  if (bc->aux)
+    gkyl_array_release(bc->aux);
+  bc->aux = aux ? gkyl_array_acquire(aux) : 0;
+}
+
+// Skin-cell state vector: either the array data itself, or its evolved
+// variables followed by the auxiliary ones (assembled in qfull)
+static inline const double*
+skin_state(const gkyl_wv_apply_bc *bc, const struct gkyl_array *q, long loc, double *qfull)
+{
+  if (!bc->aux)
+    return gkyl_array_cfetch(q, loc);
+  gkyl_wv_eqn_assemble_state(bc->eqn, bc->aux->ncomp,
+    gkyl_array_cfetch(q, loc), gkyl_array_cfetch(bc->aux, loc), qfull);
+  return qfull;
+}
+
 void
 gkyl_wv_apply_bc_advance(const gkyl_wv_apply_bc *bc, double tm,
   const struct gkyl_range *update_rng, struct gkyl_array *out)
@@ -56,8 +78,13 @@ gkyl_wv_apply_bc_advance(const gkyl_wv_apply_bc *bc, double tm,
   enum gkyl_edge_loc edge = bc->edge;
   int dir = bc->dir, ndim = bc->grid.ndim, ncomp = out->ncomp;
   int meqn = bc->eqn->num_equations;
+  // with auxiliary variables, BC functions see the full state vector
+  // but only the evolved variables are written to the ghost cells
+  int nevol = meqn - (bc->aux ? bc->aux->ncomp : 0);
+  if (bc->aux) ncomp = meqn;
 
   double skin_local[meqn], ghost_local[meqn];
+  double skin_full[meqn], ghost_full[meqn];
 
   // return immediately if update region does not touch boundary
   if ( (edge == GKYL_LOWER_EDGE) && (update_rng->lower[dir] > bc->range.lower[dir]) )
@@ -110,14 +137,21 @@ gkyl_wv_apply_bc_advance(const gkyl_wv_apply_bc *bc, double tm,
 
     // rotate skin data to local coordinates
     gkyl_wv_eqn_rotate_to_local(bc->eqn, wg->tau1[dir], wg->tau2[dir], wg->norm[dir],
-      gkyl_array_fetch(out, sloc), skin_local);
+      skin_state(bc, out, sloc, skin_full), skin_local);
       
     // apply boundary condition in local coordinates
     bc->bcfunc(bc->eqn, tm, ncomp, skin_local, ghost_local, bc->ctx);
 
     // rotate back to global
-    gkyl_wv_eqn_rotate_to_global(bc->eqn, wg->tau1[dir], wg->tau2[dir], wg->norm[dir],
-      ghost_local, gkyl_array_fetch(out, gloc));
+    if (bc->aux) {
+      gkyl_wv_eqn_rotate_to_global(bc->eqn, wg->tau1[dir], wg->tau2[dir], wg->norm[dir],
+        ghost_local, ghost_full);
+      gkyl_copy_double_arr(nevol, ghost_full, gkyl_array_fetch(out, gloc));
+    }
+    else {
+      gkyl_wv_eqn_rotate_to_global(bc->eqn, wg->tau1[dir], wg->tau2[dir], wg->norm[dir],
+        ghost_local, gkyl_array_fetch(out, gloc));
+    }
   }
 }
 
@@ -128,8 +162,13 @@ gkyl_wv_apply_bc_to_buff(const gkyl_wv_apply_bc *bc, double tm,
   enum gkyl_edge_loc edge = bc->edge;
   int dir = bc->dir, ndim = bc->grid.ndim, ncomp = inp->ncomp;
   int meqn = bc->eqn->num_equations;
+  // with auxiliary variables, only the evolved variables are copied
+  // to the buffer
+  int nevol = meqn - (bc->aux ? bc->aux->ncomp : 0);
+  if (bc->aux) ncomp = meqn;
 
   double skin_local[meqn], ghost_local[meqn];
+  double skin_full[meqn], ghost_full[meqn];
 
   // return immediately if update region does not touch boundary
   if ( (edge == GKYL_LOWER_EDGE) && (update_rng->lower[dir] > bc->range.lower[dir]) )
@@ -178,15 +217,22 @@ gkyl_wv_apply_bc_to_buff(const gkyl_wv_apply_bc *bc, double tm,
 
     // rotate skin data to local coordinates of skin-cell edge
     gkyl_wv_eqn_rotate_to_local(bc->eqn, wgs->tau1[dir], wgs->tau2[dir], wgs->norm[dir],
-      gkyl_array_cfetch(inp, sloc), skin_local);
+      skin_state(bc, inp, sloc, skin_full), skin_local);
       
     // apply boundary condition in local coordinates
     bc->bcfunc(bc->eqn, tm, ncomp, skin_local, ghost_local, bc->ctx);
 
     // rotate back to global coordinates as defined on ghost cell edge
     const struct gkyl_wave_cell_geom *wgg = gkyl_wave_geom_get(bc->geom, gidx);
-    gkyl_wv_eqn_rotate_to_global(bc->eqn, wgg->tau1[dir], wgg->tau2[dir], wgg->norm[dir],
-      ghost_local, buffer+meqn*count);
+    if (bc->aux) {
+      gkyl_wv_eqn_rotate_to_global(bc->eqn, wgg->tau1[dir], wgg->tau2[dir], wgg->norm[dir],
+        ghost_local, ghost_full);
+      gkyl_copy_double_arr(nevol, ghost_full, buffer+nevol*count);
+    }
+    else {
+      gkyl_wv_eqn_rotate_to_global(bc->eqn, wgg->tau1[dir], wgg->tau2[dir], wgg->norm[dir],
+        ghost_local, buffer+meqn*count);
+    }
 
     count += 1;
   }  
@@ -197,5 +243,7 @@ gkyl_wv_apply_bc_release(gkyl_wv_apply_bc* bc)
 {
   gkyl_wv_eqn_release(bc->eqn);
   gkyl_wave_geom_release(bc->geom);
+  if (bc->aux)
+    gkyl_array_release(bc->aux);
   gkyl_free(bc);
 }
@@ -1833,4 +1833,17 @@ gkyl_wv_gr_euler_spacetime(const struct gkyl_wv_eqn* eqn)
   struct gkyl_gr_spacetime *spacetime = gr_euler->spacetime;
 
   return spacetime;
-}
\ No newline at end of file
+}
+
+int
+gkyl_wv_gr_euler_num_static_spacetime(const struct gkyl_wv_eqn* eqn)
+{
+  const struct wv_gr_euler *gr_euler = container_of(eqn, struct wv_gr_euler, eqn);
+
+  if (gr_euler->spacetime_gauge == GKYL_STATIC_GAUGE) {
+    return eqn->num_equations - 5;
+  }
+  else {
+    return 0;
+  }
+}
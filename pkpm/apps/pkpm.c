@@ -190,7 +190,7 @@ gkyl_pkpm_app_new(struct gkyl_pkpm *pkpm)
   }
   else {
     // Create decomp.
-    app->decomp = gkyl_rect_decomp_new_from_cuts(app->cdim, pkpm->parallelism.cuts, &app->global);
+    app->decomp = app_decomp_new(&pkpm->parallelism, &app->grid, &app->global, &app->global_ext);
 
     // Create a new communicator with the decomposition in it.
     app->comm = gkyl_comm_split_comm(pkpm->parallelism.comm, 0, app->decomp);
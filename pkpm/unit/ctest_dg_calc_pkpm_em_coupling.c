@@ -0,0 +1,172 @@
+#include <acutest.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_array.h>
+#include <gkyl_array_ops.h>
+#include <gkyl_basis.h>
+#include <gkyl_dg_calc_pkpm_em_coupling.h>
+#include <gkyl_dg_calc_pkpm_em_coupling_priv.h>
+#include <gkyl_mat.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_decomp.h>
+#include <gkyl_rect_grid.h>
+#include <gkyl_util.h>
+
+// allocate array filled with random numbers in [lo, hi)
+static struct gkyl_array*
+mkarr_rand(long nc, long size, double lo, double hi, pcg64_random_t *rng)
+{
+  struct gkyl_array* a = gkyl_array_new(GKYL_DOUBLE, nc, size);
+  double *d = a->data;
+  for (long i=0; i<nc*size; ++i)
+    d[i] = lo + (hi-lo)*gkyl_pcg64_rand_double(rng);
+  return a;
+}
+
+// Compare the updater against the LU solve of the full system in each
+// cell, done here with the set and copy kernels used by the updater.
+static void
+test_em_coupling(int cdim, int poly_order, enum gkyl_basis_type b_type,
+  int num_species, bool field_static)
+{
+  struct gkyl_basis basis;
+  if (b_type == GKYL_BASIS_MODAL_TENSOR)
+    gkyl_cart_modal_tensor(&basis, cdim, poly_order);
+  else
+    gkyl_cart_modal_serendip(&basis, cdim, poly_order);
+  int nc = basis.num_basis;
+
+  int cells[] = { 5, 3 };
+  double lower[] = { 0.0, 0.0 }, upper[] = { 1.0, 1.0 };
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, cdim, lower, upper, cells);
+  int ghost[] = { 1, 1 };
+  struct gkyl_range local, local_ext;
+  gkyl_create_grid_ranges(&grid, ghost, &local_ext, &local);
+
+  pcg64_random_t rng = gkyl_pcg64_init(0);
+
+  double qbym[GKYL_MAX_SPECIES] = { -10.0, 1.0, 0.5 };
+  double epsilon0 = 1.0, dt = 0.05;
+
+  // Mass densities are positive, cell averages dominate.
+  struct gkyl_array *app_accel[GKYL_MAX_SPECIES], *moms[GKYL_MAX_SPECIES], *flows[GKYL_MAX_SPECIES];
+  struct gkyl_array *fluid_sc[GKYL_MAX_SPECIES], *fluid_lu[GKYL_MAX_SPECIES];
+  for (int s=0; s<num_species; ++s) {
+    app_accel[s] = mkarr_rand(3*nc, local_ext.volume, -0.1, 0.1, &rng);
+    moms[s] = mkarr_rand(3*nc, local_ext.volume, -0.1, 0.1, &rng);
+    flows[s] = mkarr_rand(3*nc, local_ext.volume, -1.0, 1.0, &rng);
+    fluid_sc[s] = gkyl_array_new(GKYL_DOUBLE, 3*nc, local_ext.volume);
+    fluid_lu[s] = gkyl_array_new(GKYL_DOUBLE, 3*nc, local_ext.volume);
+    for (long i=0; i<local_ext.volume; ++i)
+      ((double*) gkyl_array_fetch(moms[s], i))[0] += 1.0 + s;
+  }
+  struct gkyl_array *ext_em = mkarr_rand(8*nc, local_ext.volume, -0.5, 0.5, &rng);
+  struct gkyl_array *app_current = mkarr_rand(3*nc, local_ext.volume, -0.5, 0.5, &rng);
+  struct gkyl_array *em_sc = mkarr_rand(8*nc, local_ext.volume, -1.0, 1.0, &rng);
+  struct gkyl_array *em_lu = gkyl_array_new(GKYL_DOUBLE, 8*nc, local_ext.volume);
+  gkyl_array_copy(em_lu, em_sc);
+
+  struct gkyl_dg_calc_pkpm_em_coupling *up = gkyl_dg_calc_pkpm_em_coupling_new(&basis,
+    &local, num_species, qbym, epsilon0, field_static, false);
+  gkyl_dg_calc_pkpm_em_coupling_advance(up, dt, (const struct gkyl_array **) app_accel, ext_em,
+    app_current, (const struct gkyl_array **) moms, (const struct gkyl_array **) flows, fluid_sc, em_sc);
+  gkyl_dg_calc_pkpm_em_coupling_release(up);
+
+  // Reference solve.
+  pkpm_em_coupling_set_t set = choose_pkpm_em_coupling_set_kern(b_type, cdim, poly_order);
+  pkpm_em_coupling_copy_t copy = choose_pkpm_em_coupling_copy_kern(b_type, cdim, poly_order);
+  int n = nc*(3*num_species + 3);
+  struct gkyl_nmat *As = gkyl_nmat_new(1, n, n), *xs = gkyl_nmat_new(1, n, 1);
+
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &local);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&local, iter.idx);
+    const double *accel_d[GKYL_MAX_SPECIES], *moms_d[GKYL_MAX_SPECIES], *flows_d[GKYL_MAX_SPECIES];
+    double *fluid_d[GKYL_MAX_SPECIES];
+    for (int s=0; s<num_species; ++s) {
+      accel_d[s] = gkyl_array_cfetch(app_accel[s], loc);
+      moms_d[s] = gkyl_array_cfetch(moms[s], loc);
+      flows_d[s] = gkyl_array_cfetch(flows[s], loc);
+      fluid_d[s] = gkyl_array_fetch(fluid_lu[s], loc);
+    }
+    double *em_d = gkyl_array_fetch(em_lu, loc);
+
+    set(0, num_species, qbym, epsilon0, field_static, dt, As, xs, accel_d,
+      gkyl_array_cfetch(ext_em, loc), gkyl_array_cfetch(app_current, loc), moms_d, flows_d, em_d);
+    TEST_CHECK( gkyl_nmat_linsolve_lu(As, xs) );
+    copy(0, num_species, qbym, epsilon0, xs, moms_d, flows_d, fluid_d, em_d);
+  }
+
+  gkyl_range_iter_init(&iter, &local);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&local, iter.idx);
+    for (int s=0; s<num_species; ++s) {
+      const double *f_sc = gkyl_array_cfetch(fluid_sc[s], loc), *f_lu = gkyl_array_cfetch(fluid_lu[s], loc);
+      for (int k=0; k<3*nc; ++k) {
+        TEST_CHECK( gkyl_compare_double(f_sc[k], f_lu[k], 1e-11) );
+        TEST_MSG( "species %d comp %d: %.15e vs %.15e", s, k, f_sc[k], f_lu[k] );
+      }
+    }
+    const double *e_sc = gkyl_array_cfetch(em_sc, loc), *e_lu = gkyl_array_cfetch(em_lu, loc);
+    for (int k=0; k<8*nc; ++k) {
+      TEST_CHECK( gkyl_compare_double(e_sc[k], e_lu[k], 1e-11) );
+      TEST_MSG( "em comp %d: %.15e vs %.15e", k, e_sc[k], e_lu[k] );
+    }
+  }
+
+  gkyl_nmat_release(As);
+  gkyl_nmat_release(xs);
+  for (int s=0; s<num_species; ++s) {
+    gkyl_array_release(app_accel[s]);
+    gkyl_array_release(moms[s]);
+    gkyl_array_release(flows[s]);
+    gkyl_array_release(fluid_sc[s]);
+    gkyl_array_release(fluid_lu[s]);
+  }
+  gkyl_array_release(ext_em);
+  gkyl_array_release(app_current);
+  gkyl_array_release(em_sc);
+  gkyl_array_release(em_lu);
+}
+
+void
+test_1x_p1()
+{
+  for (int ns=1; ns<=3; ++ns) {
+    test_em_coupling(1, 1, GKYL_BASIS_MODAL_SERENDIPITY, ns, false);
+    test_em_coupling(1, 1, GKYL_BASIS_MODAL_SERENDIPITY, ns, true);
+  }
+}
+
+void
+test_1x_p2()
+{
+  for (int ns=1; ns<=3; ++ns) {
+    test_em_coupling(1, 2, GKYL_BASIS_MODAL_SERENDIPITY, ns, false);
+    test_em_coupling(1, 2, GKYL_BASIS_MODAL_SERENDIPITY, ns, true);
+  }
+}
+
+void
+test_2x_p1()
+{
+  for (int ns=1; ns<=3; ++ns)
+    test_em_coupling(2, 1, GKYL_BASIS_MODAL_SERENDIPITY, ns, false);
+}
+
+void
+test_2x_tensor_p2()
+{
+  for (int ns=1; ns<=3; ++ns)
+    test_em_coupling(2, 2, GKYL_BASIS_MODAL_TENSOR, ns, false);
+}
+
+TEST_LIST = {
+  { "test_1x_p1", test_1x_p1 },
+  { "test_1x_p2", test_1x_p2 },
+  { "test_2x_p1", test_2x_p1 },
+  { "test_2x_tensor_p2", test_2x_tensor_p2 },
+  { NULL, NULL },
+};
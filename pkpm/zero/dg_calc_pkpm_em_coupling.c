@@ -31,11 +31,20 @@ gkyl_dg_calc_pkpm_em_coupling_new(const struct gkyl_basis* cbasis,
   up->pkpm_em_coupling_set = choose_pkpm_em_coupling_set_kern(b_type, cdim, poly_order);
   up->pkpm_em_coupling_copy = choose_pkpm_em_coupling_copy_kern(b_type, cdim, poly_order);
 
-  // Linear system size is nc*(3*num_species + 3)
+  // Linear system size is nc*(3*num_species + 3). Systems are
+  // assembled and solved in tiles of cells so memory does not scale
+  // with the size of mem_range
   up->num_species = num_species;
-  up->As = gkyl_nmat_new(mem_range->volume, nc*(3*up->num_species + 3), nc*(3*up->num_species + 3));
-  up->xs = gkyl_nmat_new(mem_range->volume, nc*(3*up->num_species + 3), 1);
-  up->mem = gkyl_nmat_linsolve_lu_new(up->As->num, up->As->nr);
+  up->tile_cells = GKYL_MIN2(mem_range->volume, GKYL_NMAT_TILE_CELLS);
+  up->tile_loc = gkyl_malloc(sizeof(long[up->tile_cells]));
+  up->As = gkyl_nmat_new(up->tile_cells, nc*(3*up->num_species + 3), nc*(3*up->num_species + 3));
+  up->xs = gkyl_nmat_new(up->tile_cells, nc*(3*up->num_species + 3), 1);
+  // On the host the species flow velocities are eliminated in place
+  // (see pkpm_em_coupling_schur_solve), so no batched LU memory is
+  // needed. With a single species there is nothing to gain from the
+  // elimination and the full systems are LU factored instead.
+  up->num_basis = nc;
+  up->mem = num_species == 1 ? gkyl_nmat_linsolve_lu_new(up->As->num, up->As->nr) : 0;
 
   // Boolean for whether or not self-consistent EM fields are static
   up->pkpm_field_static = pkpm_field_static;
@@ -53,6 +62,183 @@ gkyl_dg_calc_pkpm_em_coupling_new(const struct gkyl_basis* cbasis,
   return up;
 }
 
+// LU factor the n x n matrix a (column major, leading dimension lda)
+// in place, with partial pivoting. Returns false if a is singular.
+static bool
+lu_factor(int n, double *a, long lda, int *ipiv)
+{
+  for (int k=0; k<n; ++k) {
+    int p = k;
+    for (int i=k+1; i<n; ++i)
+      if (fabs(a[i+k*lda]) > fabs(a[p+k*lda])) p = i;
+    if (a[p+k*lda] == 0.0) return false;
+    ipiv[k] = p;
+    if (p != k)
+      for (int j=0; j<n; ++j) {
+        double t = a[k+j*lda]; a[k+j*lda] = a[p+j*lda]; a[p+j*lda] = t;
+      }
+
+    double inv = 1.0/a[k+k*lda];
+    for (int i=k+1; i<n; ++i)
+      a[i+k*lda] *= inv;
+    for (int j=k+1; j<n; ++j) {
+      double akj = a[k+j*lda];
+      if (akj == 0.0) continue;
+      for (int i=k+1; i<n; ++i)
+        a[i+j*lda] -= a[i+k*lda]*akj;
+    }
+  }
+  return true;
+}
+
+// Solve for the nrhs columns of b (leading dimension ldb) in place,
+// given the LU factors computed by lu_factor.
+static void
+lu_solve(int n, const double *a, long lda, const int *ipiv, int nrhs, double *b, long ldb)
+{
+  for (int r=0; r<nrhs; ++r) {
+    double *br = &b[r*ldb];
+    for (int k=0; k<n; ++k)
+      if (ipiv[k] != k) {
+        double t = br[k]; br[k] = br[ipiv[k]]; br[ipiv[k]] = t;
+      }
+    for (int k=0; k<n; ++k) {
+      if (br[k] == 0.0) continue;
+      for (int i=k+1; i<n; ++i)
+        br[i] -= a[i+k*lda]*br[k];
+    }
+    for (int k=n-1; k>=0; --k) {
+      br[k] /= a[k+k*lda];
+      if (br[k] == 0.0) continue;
+      for (int i=0; i<k; ++i)
+        br[i] -= a[i+k*lda]*br[k];
+    }
+  }
+}
+
+// Check that the 3*nc x 3*nc block d (leading dimension lda) only
+// couples like components, i.e. its off-diagonal nc x nc blocks vanish.
+static bool
+pkpm_em_coupling_is_comp_diag(int nc, const double *d, long lda)
+{
+  for (int dj=0; dj<3; ++dj)
+    for (int di=0; di<3; ++di) {
+      if (di == dj) continue;
+      for (int j=0; j<nc; ++j)
+        for (int i=0; i<nc; ++i)
+          if (d[(di*nc+i) + (dj*nc+j)*lda] != 0.0) return false;
+    }
+  return true;
+}
+
+// Solve the linear system in a single cell. Ordering the unknowns as
+// the flow velocities u_s of each species followed by the electric
+// field E, the system has the block structure
+//
+//   [ M_s      C_s  ] [ u_s ]   [ r_s ]
+//   [ D_s ...  A_EE ] [  E  ] = [ r_E ]
+//
+// with no coupling between species. M_s holds the Lorentz force
+// rotation of species s and D_s its current in Ampere's law, which
+// only couples like components of u_s and E (i.e. D_s is block
+// diagonal in the components, which is asserted). Eliminating
+// u_s = M_s^{-1} (r_s - C_s E) leaves the Schur complement
+//
+//   (A_EE - sum_s D_s M_s^{-1} C_s) E = r_E - sum_s D_s M_s^{-1} r_s
+//
+// so only systems of size 3*nc are factored. All the work is done in
+// the storage of A and x: on return x holds the solution, as for the
+// LU solve of the full system, and A is overwritten.
+static bool
+pkpm_em_coupling_schur_solve(const struct gkyl_dg_calc_pkpm_em_coupling *up, 
+  struct gkyl_mat *A, struct gkyl_mat *x)
+{
+  int nc = up->num_basis, n3 = 3*nc;
+  long eoff = up->num_species*n3, lda = A->nr;
+  double *a = A->data, *sol = x->data;
+  int ipiv[n3];
+
+  for (int s=0; s<up->num_species; ++s) {
+    long off = s*n3;
+    assert(pkpm_em_coupling_is_comp_diag(nc, &a[eoff+off*lda], lda));
+
+    // Replace C_s and r_s by M_s^{-1} C_s and M_s^{-1} r_s
+    if (!lu_factor(n3, &a[off+off*lda], lda, ipiv))
+      return false;
+    lu_solve(n3, &a[off+off*lda], lda, ipiv, n3, &a[off+eoff*lda], lda);
+    lu_solve(n3, &a[off+off*lda], lda, ipiv, 1, &sol[off], n3);
+
+    // Subtract D_s M_s^{-1} [C_s | r_s] from [A_EE | r_E], one
+    // component at a time
+    for (int d=0; d<3; ++d) {
+      for (int j=0; j<=n3; ++j) {
+        double *Sj = j<n3 ? &a[(eoff+d*nc) + (eoff+j)*lda] : &sol[eoff+d*nc];
+        const double *Wj = j<n3 ? &a[(off+d*nc) + (eoff+j)*lda] : &sol[off+d*nc];
+        for (int k=0; k<nc; ++k) {
+          if (Wj[k] == 0.0) continue;
+          const double *Dk = &a[(eoff+d*nc) + (off+d*nc+k)*lda];
+          for (int i=0; i<nc; ++i)
+            Sj[i] -= Dk[i]*Wj[k];
+        }
+      }
+    }
+  }
+
+  if (!lu_factor(n3, &a[eoff+eoff*lda], lda, ipiv))
+    return false;
+  lu_solve(n3, &a[eoff+eoff*lda], lda, ipiv, 1, &sol[eoff], n3);
+
+  // Back-substitute for the flow velocities
+  for (int s=0; s<up->num_species; ++s) {
+    long off = s*n3;
+    for (int j=0; j<n3; ++j) {
+      double Ej = sol[eoff+j];
+      for (int i=0; i<n3; ++i)
+        sol[off+i] -= a[(off+i) + (eoff+j)*lda]*Ej;
+    }
+  }
+  return true;
+}
+
+// Solve the linear systems in the current tile and copy the solution
+// to the output arrays
+static void
+pkpm_em_coupling_solve_tile(struct gkyl_dg_calc_pkpm_em_coupling *up, long ntile, 
+  const struct gkyl_array* vlasov_pkpm_moms[GKYL_MAX_SPECIES], const struct gkyl_array* pkpm_u[GKYL_MAX_SPECIES], 
+  struct gkyl_array* euler_pkpm[GKYL_MAX_SPECIES], struct gkyl_array* em)
+{
+  int num_species = up->num_species;
+  double *fluids[GKYL_MAX_SPECIES];
+  const double *pkpm_moms[GKYL_MAX_SPECIES];
+  const double *pkpm_flows[GKYL_MAX_SPECIES];
+
+  if (up->mem) {
+    bool status = gkyl_nmat_linsolve_lu_pa_num(up->mem, ntile, up->As, up->xs);
+    assert(status);
+  }
+
+  for (long c=0; c<ntile; ++c) {
+    long loc = up->tile_loc[c];
+
+    if (!up->mem) {
+      struct gkyl_mat A = gkyl_nmat_get(up->As, c);
+      struct gkyl_mat x = gkyl_nmat_get(up->xs, c);
+      bool status = pkpm_em_coupling_schur_solve(up, &A, &x);
+      assert(status);
+    }
+
+    for (int n=0; n<num_species; ++n) {
+      pkpm_moms[n] = gkyl_array_cfetch(vlasov_pkpm_moms[n], loc);
+      pkpm_flows[n] = gkyl_array_cfetch(pkpm_u[n], loc);
+      fluids[n] = gkyl_array_fetch(euler_pkpm[n], loc);
+    }
+    double *em_d = gkyl_array_fetch(em, loc);
+
+    up->pkpm_em_coupling_copy(c, up->num_species, up->qbym, up->epsilon0, 
+      up->xs, pkpm_moms, pkpm_flows, fluids, em_d);
+  }
+}
+
 void 
 gkyl_dg_calc_pkpm_em_coupling_advance(struct gkyl_dg_calc_pkpm_em_coupling *up, double dt, 
   const struct gkyl_array* app_accel[GKYL_MAX_SPECIES], 
@@ -68,15 +254,15 @@ gkyl_dg_calc_pkpm_em_coupling_advance(struct gkyl_dg_calc_pkpm_em_coupling *up,
   }
 #endif
   int num_species = up->num_species;
-  double *fluids[GKYL_MAX_SPECIES];
   const double *app_accels[GKYL_MAX_SPECIES];
   const double *pkpm_moms[GKYL_MAX_SPECIES];
   const double *pkpm_flows[GKYL_MAX_SPECIES];
 
-  // First loop over mem_range for solving linear systems to compute primitive moments
+  // Loop over mem_range setting the linear systems to compute the
+  // primitive moments, solving them each time a tile is filled
   struct gkyl_range_iter iter;
   gkyl_range_iter_init(&iter, &up->mem_range);
-  long count = 0;
+  long ntile = 0;
   while (gkyl_range_iter_next(&iter)) {
     long loc = gkyl_range_idx(&up->mem_range, iter.idx);
 
@@ -89,34 +275,19 @@ gkyl_dg_calc_pkpm_em_coupling_advance(struct gkyl_dg_calc_pkpm_em_coupling *up,
     const double *app_current_d = gkyl_array_cfetch(app_current, loc);
     double *em_d = gkyl_array_fetch(em, loc);
 
-    up->pkpm_em_coupling_set(count, 
+    up->pkpm_em_coupling_set(ntile, 
       up->num_species, up->qbym, up->epsilon0, up->pkpm_field_static, dt, 
       up->As, up->xs, 
       app_accels, ext_em_d, app_current_d, pkpm_moms, pkpm_flows, em_d);
 
-    count += 1;
-  }
-
-  bool status = gkyl_nmat_linsolve_lu_pa(up->mem, up->As, up->xs);
-  assert(status);
-
-  gkyl_range_iter_init(&iter, &up->mem_range);
-  count = 0;
-  while (gkyl_range_iter_next(&iter)) {
-    long loc = gkyl_range_idx(&up->mem_range, iter.idx);
-
-    for (int n=0; n<num_species; ++n) {
-      pkpm_moms[n] = gkyl_array_cfetch(vlasov_pkpm_moms[n], loc);
-      pkpm_flows[n] = gkyl_array_cfetch(pkpm_u[n], loc);
-      fluids[n] = gkyl_array_fetch(euler_pkpm[n], loc);
+    up->tile_loc[ntile++] = loc;
+    if (ntile == up->tile_cells) {
+      pkpm_em_coupling_solve_tile(up, ntile, vlasov_pkpm_moms, pkpm_u, euler_pkpm, em);
+      ntile = 0;
     }
-    double *em_d = gkyl_array_fetch(em, loc);
-
-    up->pkpm_em_coupling_copy(count, up->num_species, up->qbym, up->epsilon0, 
-      up->xs, pkpm_moms, pkpm_flows, fluids, em_d);
-
-    count += 1;
   }
+  if (ntile > 0)
+    pkpm_em_coupling_solve_tile(up, ntile, vlasov_pkpm_moms, pkpm_u, euler_pkpm, em);
 }
 
 void 
@@ -124,10 +295,15 @@ gkyl_dg_calc_pkpm_em_coupling_release(gkyl_dg_calc_pkpm_em_coupling *up)
 {
   gkyl_nmat_release(up->As);
   gkyl_nmat_release(up->xs);
-  gkyl_nmat_linsolve_lu_release(up->mem);
+  gkyl_free(up->tile_loc);
   
-  if (GKYL_IS_CU_ALLOC(up->flags)) 
+  if (GKYL_IS_CU_ALLOC(up->flags)) {
+    gkyl_nmat_linsolve_lu_release(up->mem);
     gkyl_cu_free(up->on_dev);
-
+  }
+  else if (up->mem) {
+    gkyl_nmat_linsolve_lu_release(up->mem);
+  }
+  
   gkyl_free(up);
 }
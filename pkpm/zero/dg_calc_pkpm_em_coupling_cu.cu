@@ -245,6 +245,9 @@ gkyl_dg_calc_pkpm_em_coupling_cu_dev_new(const struct gkyl_basis* cbasis,
   up->As = gkyl_nmat_cu_dev_new(mem_range->volume, nc*(3*up->num_species + 3), nc*(3*up->num_species + 3));
   up->xs = gkyl_nmat_cu_dev_new(mem_range->volume, nc*(3*up->num_species + 3), 1);
   up->mem = gkyl_nmat_linsolve_lu_cu_dev_new(up->As->num, up->As->nr);
+  // The whole range is solved in a single batch on the GPU
+  up->tile_cells = mem_range->volume;
+  up->tile_loc = 0;
 
   // Boolean for whether or not self-consistent EM fields are static
   up->pkpm_field_static = pkpm_field_static;
@@ -69,15 +69,20 @@ gkyl_dg_calc_pkpm_vars_new(const struct gkyl_rect_grid *conf_grid,
     up->pkpm_limiter[d] = choose_pkpm_limiter_kern(d, b_type, cdim, poly_order);
   }
 
-  // There are Ncomp*range->volume linear systems to be solved 
+  // The linear systems are assembled and solved in tiles of cells
+  // so memory does not scale with the size of mem_range
+  up->tile_cells = GKYL_MIN2(mem_range->volume, GKYL_NMAT_TILE_CELLS);
+  up->tile_loc = gkyl_malloc(sizeof(long[up->tile_cells]));
+
+  // There are Ncomp*tile_cells linear systems to be solved in each tile
   // 6 components: ux, uy, uz, div(p_par b)/rho, p_perp/rho, rho/p_perp
-  up->As = gkyl_nmat_new(up->Ncomp*mem_range->volume, nc, nc);
-  up->xs = gkyl_nmat_new(up->Ncomp*mem_range->volume, nc, 1);
+  up->As = gkyl_nmat_new(up->Ncomp*up->tile_cells, nc, nc);
+  up->xs = gkyl_nmat_new(up->Ncomp*up->tile_cells, nc, 1);
   up->mem = gkyl_nmat_linsolve_lu_new(up->As->num, up->As->nr);
 
   // Linear system for just solving for ux, uy, uz
-  up->As_u = gkyl_nmat_new(3*mem_range->volume, nc, nc);
-  up->xs_u = gkyl_nmat_new(3*mem_range->volume, nc, 1);
+  up->As_u = gkyl_nmat_new(3*up->tile_cells, nc, nc);
+  up->xs_u = gkyl_nmat_new(3*up->tile_cells, nc, 1);
   up->mem_u = gkyl_nmat_linsolve_lu_new(up->As_u->num, up->As_u->nr);
 
   up->flags = 0;
@@ -87,6 +92,27 @@ gkyl_dg_calc_pkpm_vars_new(const struct gkyl_rect_grid *conf_grid,
   return up;
 }
 
+// Solve the linear systems for the primitive moments in the current
+// tile and copy the solution to the output arrays
+static void
+pkpm_vars_solve_tile(struct gkyl_dg_calc_pkpm_vars *up, long ntile, 
+  struct gkyl_array* prim, struct gkyl_array* prim_surf)
+{
+  if (up->poly_order > 1) {
+    bool status = gkyl_nmat_linsolve_lu_pa_num(up->mem, up->Ncomp*ntile, up->As, up->xs);
+    assert(status);
+  }
+
+  for (long c=0; c<ntile; ++c) {
+    long loc = up->tile_loc[c];
+
+    double* prim_d = gkyl_array_fetch(prim, loc);
+    double* prim_surf_d = gkyl_array_fetch(prim_surf, loc);
+
+    up->pkpm_copy(c*up->Ncomp, up->xs, prim_d, prim_surf_d);
+  }
+}
+
 void gkyl_dg_calc_pkpm_vars_advance(struct gkyl_dg_calc_pkpm_vars *up, 
   const struct gkyl_array* vlasov_pkpm_moms, const struct gkyl_array* euler_pkpm, 
   const struct gkyl_array* p_ij, const struct gkyl_array* pkpm_div_ppar, 
@@ -101,10 +127,11 @@ void gkyl_dg_calc_pkpm_vars_advance(struct gkyl_dg_calc_pkpm_vars *up,
   }
 #endif
 
-  // First loop over mem_range for solving linear systems to compute primitive moments
+  // Loop over mem_range setting the linear systems to compute the
+  // primitive moments, solving them each time a tile is filled
   struct gkyl_range_iter iter;
   gkyl_range_iter_init(&iter, &up->mem_range);
-  long count = 0;
+  long ntile = 0;
   while (gkyl_range_iter_next(&iter)) {
     long loc = gkyl_range_idx(&up->mem_range, iter.idx);
 
@@ -115,28 +142,33 @@ void gkyl_dg_calc_pkpm_vars_advance(struct gkyl_dg_calc_pkpm_vars *up,
 
     int* cell_avg_prim_d = gkyl_array_fetch(cell_avg_prim, loc);
 
-    cell_avg_prim_d[0] = up->pkpm_set(count, up->As, up->xs, 
+    cell_avg_prim_d[0] = up->pkpm_set(ntile*up->Ncomp, up->As, up->xs, 
       vlasov_pkpm_moms_d, euler_pkpm_d, p_ij_d, pkpm_div_ppar_d);
 
-    count += up->Ncomp;
+    up->tile_loc[ntile++] = loc;
+    if (ntile == up->tile_cells) {
+      pkpm_vars_solve_tile(up, ntile, prim, prim_surf);
+      ntile = 0;
+    }
   }
+  if (ntile > 0)
+    pkpm_vars_solve_tile(up, ntile, prim, prim_surf);
+}
 
+// Solve the linear systems for the flow velocity in the current tile
+// and copy the solution to the output array
+static void
+pkpm_vars_u_solve_tile(struct gkyl_dg_calc_pkpm_vars *up, long ntile, 
+  struct gkyl_array* pkpm_u)
+{
   if (up->poly_order > 1) {
-    bool status = gkyl_nmat_linsolve_lu_pa(up->mem, up->As, up->xs);
+    bool status = gkyl_nmat_linsolve_lu_pa_num(up->mem_u, 3*ntile, up->As_u, up->xs_u);
     assert(status);
   }
 
-  gkyl_range_iter_init(&iter, &up->mem_range);
-  count = 0;
-  while (gkyl_range_iter_next(&iter)) {
-    long loc = gkyl_range_idx(&up->mem_range, iter.idx);
-
-    double* prim_d = gkyl_array_fetch(prim, loc);
-    double* prim_surf_d = gkyl_array_fetch(prim_surf, loc);
-
-    up->pkpm_copy(count, up->xs, prim_d, prim_surf_d);
-
-    count += up->Ncomp;
+  for (long c=0; c<ntile; ++c) {
+    double* pkpm_u_d = gkyl_array_fetch(pkpm_u, up->tile_loc[c]);
+    up->pkpm_u_copy(3*c, up->xs_u, pkpm_u_d);
   }
 }
 
@@ -152,10 +184,11 @@ void gkyl_dg_calc_pkpm_vars_u(struct gkyl_dg_calc_pkpm_vars *up,
   }
 #endif
 
-  // First loop over mem_range for solving linear systems to compute primitive moments
+  // Loop over mem_range setting the linear systems to compute the
+  // flow velocity, solving them each time a tile is filled
   struct gkyl_range_iter iter;
   gkyl_range_iter_init(&iter, &up->mem_range);
-  long count = 0;
+  long ntile = 0;
   while (gkyl_range_iter_next(&iter)) {
     long loc = gkyl_range_idx(&up->mem_range, iter.idx);
 
@@ -164,28 +197,17 @@ void gkyl_dg_calc_pkpm_vars_u(struct gkyl_dg_calc_pkpm_vars *up,
 
     int* cell_avg_prim_d = gkyl_array_fetch(cell_avg_prim, loc);
 
-    cell_avg_prim_d[0] = up->pkpm_u_set(count, up->As_u, up->xs_u, 
+    cell_avg_prim_d[0] = up->pkpm_u_set(3*ntile, up->As_u, up->xs_u, 
       vlasov_pkpm_moms_d, euler_pkpm_d);
 
-    count += 3;
-  }
-
-  if (up->poly_order > 1) {
-    bool status = gkyl_nmat_linsolve_lu_pa(up->mem_u, up->As_u, up->xs_u);
-    assert(status);
-  }
-
-  gkyl_range_iter_init(&iter, &up->mem_range);
-  count = 0;
-  while (gkyl_range_iter_next(&iter)) {
-    long loc = gkyl_range_idx(&up->mem_range, iter.idx);
-
-    double* pkpm_u_d = gkyl_array_fetch(pkpm_u, loc);
-
-    up->pkpm_u_copy(count, up->xs_u, pkpm_u_d);
-
-    count += 3;
+    up->tile_loc[ntile++] = loc;
+    if (ntile == up->tile_cells) {
+      pkpm_vars_u_solve_tile(up, ntile, pkpm_u);
+      ntile = 0;
+    }
   }
+  if (ntile > 0)
+    pkpm_vars_u_solve_tile(up, ntile, pkpm_u);
 }
 
 void gkyl_dg_calc_pkpm_vars_pressure(struct gkyl_dg_calc_pkpm_vars *up, const struct gkyl_range *conf_range, 
@@ -497,6 +519,7 @@ void gkyl_dg_calc_pkpm_vars_release(gkyl_dg_calc_pkpm_vars *up)
   gkyl_nmat_release(up->As_u);
   gkyl_nmat_release(up->xs_u);
   gkyl_nmat_linsolve_lu_release(up->mem_u);
+  gkyl_free(up->tile_loc);
   
   if (GKYL_IS_CU_ALLOC(up->flags))
     gkyl_cu_free(up->on_dev);
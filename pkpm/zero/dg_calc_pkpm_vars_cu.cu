@@ -663,6 +663,10 @@ gkyl_dg_calc_pkpm_vars_cu_dev_new(const struct gkyl_rect_grid *conf_grid,
   up->xs_u = gkyl_nmat_cu_dev_new(3*mem_range->volume, nc, 1);
   up->mem_u = gkyl_nmat_linsolve_lu_cu_dev_new(up->As_u->num, up->As_u->nr);
 
+  // The whole range is solved in a single batch on the GPU
+  up->tile_cells = mem_range->volume;
+  up->tile_loc = 0;
+
   up->flags = 0;
   GKYL_SET_CU_ALLOC(up->flags);
 
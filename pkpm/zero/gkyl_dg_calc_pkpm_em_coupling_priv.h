@@ -32,7 +32,10 @@ struct gkyl_dg_calc_pkpm_em_coupling {
   struct gkyl_range mem_range; // Configuration space range for linear solve
 
   struct gkyl_nmat *As, *xs; // matrices for LHS and RHS
-  gkyl_nmat_mem *mem; // memory for use in batched linear solve
+  gkyl_nmat_mem *mem; // memory for use in batched linear solve (GPU, or host with one species)
+  long tile_cells; // number of cells whose systems are solved together (host only)
+  long *tile_loc; // linear index of each cell in current tile (host only)
+  int num_basis; // number of configuration space basis functions
 
   pkpm_em_coupling_set_t pkpm_em_coupling_set;  // kernel for setting matrices for linear solve
   pkpm_em_coupling_copy_t pkpm_em_coupling_copy; // kernel for copying solution to output
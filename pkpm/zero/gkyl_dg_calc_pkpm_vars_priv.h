@@ -96,6 +96,8 @@ struct gkyl_dg_calc_pkpm_vars {
 
   struct gkyl_nmat *As_u, *xs_u; // matrices for LHS and RHS for flow velocity solve
   gkyl_nmat_mem *mem_u; // memory for use in batched linear solve for velocity
+  long tile_cells; // number of cells whose systems are solved together (host only)
+  long *tile_loc; // linear index of each cell in current tile (host only)
 
   pkpm_set_t pkpm_set;  // kernel for setting matrices for linear solve
   pkpm_copy_t pkpm_copy; // kernel for copying solution to output; also computed needed surface expansions
@@ -287,6 +287,9 @@ struct gkyl_vm {
   void (*mapc2p)(double t, const double *xc, double *xp, void *ctx);
 
   double cfl_frac; // CFL fraction to use (default 1.0)
+  // time-stepper to use (default GKYL_SSP_RK3). GKYL_SSP_RK43 is not
+  // supported for electrostatic (Vlasov-Poisson) runs
+  enum gkyl_time_stepper_type time_stepper;
 
   int num_periodic_dir; // number of periodic directions
   int periodic_dirs[3]; // list of periodic directions
@@ -318,7 +321,7 @@ struct gkyl_vlasov_stat {
   double stage_3_dt_diff[2]; // [min,max] rel-diff for stage-3 failure
     
   double total_tm; // time for simulation (not including ICs)
-  double rk3_tm; // time for SSP RK3 step
+  double rk3_tm; // time for SSP-RK step (RK3 or RK43)
   double fl_em_tm; // time for implicit fluid-EM coupling step
   double init_species_tm; // time to initialize all species
   double init_fluid_species_tm; // time to initialize all fluid species
@@ -611,6 +614,21 @@ void gkyl_vlasov_app_write_lte_corr_status(gkyl_vlasov_app *app);
  */
 void gkyl_vlasov_app_write_field_energy(gkyl_vlasov_app* app);
 
+/**
+ * Write the current and peak array memory used by each species,
+ * operator and the field, and the peak array memory per rank (max over
+ * ranks). The numbers are for the whole process, so they include other
+ * apps in it. If target_bytes is positive, also suggest the number of
+ * subdomains needed for the peak memory per rank to fit in it.
+ *
+ * @param app App object.
+ * @param target_bytes Target memory per rank, in bytes (0 for none).
+ * @param iostream Where to write report to (e.g. stdout, stderr).
+ * @return Suggested number of subdomains (same as now if target is met).
+ */
+int gkyl_vlasov_app_mem_report(gkyl_vlasov_app* app, double target_bytes,
+  FILE *iostream);
+
 /**
  * Write stats to file. Data is written in json format.
  *
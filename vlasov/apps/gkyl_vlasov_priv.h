@@ -714,6 +714,8 @@ struct gkyl_vlasov_app {
 
   // pointer to function that takes a single-step of simulation
   struct gkyl_update_status (*update_func)(gkyl_vlasov_app *app, double dt0);
+  // explicit SSP-RK stepper, called by update_func
+  struct gkyl_update_status (*ssp_rk_func)(gkyl_vlasov_app *app, double dt0);
   // Function used to compute the field energy. 
   void (*field_energy_calc)(gkyl_vlasov_app *app, double tm, const struct vm_field *field);
   struct gkyl_vlasov_stat stat; // statistics
@@ -734,13 +736,18 @@ void vlasov_forward_euler(gkyl_vlasov_app* app, double tcurr, double dt,
 void vlasov_update_implicit_coll(gkyl_vlasov_app *app,  double dt0);
 
 // Take a single time-step using a first-order operator split 
-// implicit fluid-EM coupling and/or implicit BGK collisions + SSP RK3
+// implicit fluid-EM coupling and/or implicit BGK collisions + SSP RK
 struct gkyl_update_status vlasov_update_op_split(gkyl_vlasov_app *app,  double dt0);
 
 // Take a single time-step using a SSP-RK3 stepper
 struct gkyl_update_status vlasov_update_ssp_rk3(gkyl_vlasov_app *app,
   double dt0);
 
+// Take a single time-step using a four-stage, third-order low-storage
+// SSP-RK stepper, stable for twice the forward Euler time-step
+struct gkyl_update_status vlasov_update_ssp_rk43(gkyl_vlasov_app *app,
+  double dt0);
+
 // Take a single time-step in Vlasov-Poisson using a SSP-RK3 stepper.
 struct gkyl_update_status vlasov_poisson_update_ssp_rk3(gkyl_vlasov_app *app,
   double dt0);
@@ -202,7 +202,7 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
   }
   else {
     // Create decomp.
-    app->decomp = gkyl_rect_decomp_new_from_cuts(app->cdim, vm->parallelism.cuts, &app->global);
+    app->decomp = app_decomp_new(&vm->parallelism, &app->grid, &app->global, &app->global_ext);
 
     // Create a new communicator with the decomposition in it.
     app->comm = gkyl_comm_split_comm(vm->parallelism.comm, 0, app->decomp);
@@ -248,11 +248,14 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
   }
 
   // create geometry object
+  gkyl_mem_account_push("geometry");
   app->geom = gkyl_wave_geom_new(&app->grid, &app->local_ext,
     app->mapc2p, app->c2p_ctx, app->use_gpu);
+  gkyl_mem_account_pop();
 
   app->has_field = !vm->skip_field; // note inversion of truth value
   if (app->has_field) {
+    gkyl_mem_account_push("field");
     if (vm->is_electrostatic) {
       app->field = vp_field_new(vm, app);
       app->field_energy_calc = vp_field_calc_energy;
@@ -261,6 +264,7 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
       app->field = vm_field_new(vm, app);
       app->field_energy_calc = vm_field_calc_energy;
     }
+    gkyl_mem_account_pop();
   }
 
   // allocate space to store species objects
@@ -282,8 +286,11 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
     app->fluid_species[i].info = vm->fluid_species[i];
 
   // initialize each species
-  for (int i=0; i<ns; ++i) 
+  for (int i=0; i<ns; ++i) {
+    gkyl_mem_account_push(app->species[i].info.name);
     vm_species_init(vm, app, &app->species[i]);
+    gkyl_mem_account_pop();
+  }
 
   // initialize species wall emission terms: these rely
   // on other species which must be allocated in the previous step
@@ -299,8 +306,13 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
   // allocated in the previous step
   for (int i=0; i<ns; ++i)
     if (app->species[i].collision_id == GKYL_LBO_COLLISIONS &&
-        app->species[i].lbo.num_cross_collisions)
+        app->species[i].lbo.num_cross_collisions) {
+      gkyl_mem_account_push(app->species[i].info.name);
+      gkyl_mem_account_push("lbo_cross");
       vm_species_lbo_cross_init(app, &app->species[i], &app->species[i].lbo);
+      gkyl_mem_account_pop();
+      gkyl_mem_account_pop();
+    }
 
   // initialize each species source terms: this has to be done here
   // as they may initialize a bflux updater for their source species.
@@ -313,8 +325,11 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
   // initialize each fluid species
   // Fluid species must be initialized after kinetic species, as some fluid species couple
   // to kinetic species and pointers are allocated by the kinetic species objects
-  for (int i=0; i<nsf; ++i)
+  for (int i=0; i<nsf; ++i) {
+    gkyl_mem_account_push(app->fluid_species[i].info.name);
     vm_fluid_species_init(vm, app, &app->fluid_species[i]);
+    gkyl_mem_account_pop();
+  }
 
   for (int i=0; i<nsf; ++i)
     if (app->fluid_species[i].source_id)
@@ -341,15 +356,22 @@ gkyl_vlasov_app_new(struct gkyl_vm *vm)
   // we perform a first-order operator split and treat those terms implicitly.
   // Otherwise, we default to an SSP-RK3 method. 
   if (vm->is_electrostatic) {
+    // Vlasov-Poisson only has an SSP-RK3 stepper
+    assert(vm->time_stepper == GKYL_SSP_RK3);
     app->update_func = vlasov_poisson_update_ssp_rk3;
     app->field_calc_ext_em = vp_field_calc_ext_em;
   }
   else {
+    if (vm->time_stepper == GKYL_SSP_RK43)
+      app->ssp_rk_func = vlasov_update_ssp_rk43;
+    else
+      app->ssp_rk_func = vlasov_update_ssp_rk3;
+
     if (app->has_implicit_coll_scheme || app->has_fluid_em_coupling) {
       app->update_func = vlasov_update_op_split;
     }
     else {
-      app->update_func = vlasov_update_ssp_rk3;
+      app->update_func = app->ssp_rk_func;
     }
     app->field_calc_ext_em = vm_field_calc_ext_em;
   }
@@ -1187,6 +1209,16 @@ comm_reduce_app_stat(const gkyl_vlasov_app* app,
     global->species_lbo_coll_diff_tm);
 }
 
+int
+gkyl_vlasov_app_mem_report(gkyl_vlasov_app* app, double target_bytes,
+  FILE *iostream)
+{
+  // At most one subdomain per configuration-space cell.
+  long max_decomp = app->global.volume;
+  return app_mem_report(app->comm, app->use_gpu, app->decomp->ndecomp,
+    max_decomp > INT_MAX ? INT_MAX : max_decomp, target_bytes, iostream);
+}
+
 void
 gkyl_vlasov_app_stat_write(gkyl_vlasov_app* app)
 {
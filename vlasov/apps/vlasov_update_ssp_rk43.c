@@ -0,0 +1,198 @@
+#include <gkyl_vlasov_priv.h>
+
+// Four-stage, third-order SSP-RK method (SSPRK(4,3)) in two-register form:
+//   f1   = f + h*L(f)
+//   f1   = f1 + h*L(f1)
+//   f1   = 2/3*f + 1/3*(f1 + h*L(f1))
+//   fnew = f1 + h*L(f1)
+// with h = dt/2, applied to the species, fluid species and EM field. Every
+// stage is a forward Euler step of h, so the method is stable for dt up to
+// twice the forward Euler time-step.
+
+// Take the forward Euler step of a stage: stage 1 steps f into f1, the
+// other stages step f1 into fnew. Also applies BCs and limiters.
+static void
+rk43_forward_euler(gkyl_vlasov_app* app, double tcurr, double t, double h,
+  bool first_stage, struct gkyl_update_status *st)
+{
+  int ns = app->num_species;
+  int nfs = app->num_fluid_species;
+
+  const struct gkyl_array *fin[ns];
+  struct gkyl_array *fout[ns];
+  const struct gkyl_array *fluidin[nfs];
+  struct gkyl_array *fluidout[nfs];
+
+  for (int i=0; i<ns; ++i) {
+    fin[i] = first_stage ? app->species[i].f : app->species[i].f1;
+    fout[i] = first_stage ? app->species[i].f1 : app->species[i].fnew;
+  }
+  for (int i=0; i<nfs; ++i) {
+    fluidin[i] = first_stage ? app->fluid_species[i].fluid : app->fluid_species[i].fluid1;
+    fluidout[i] = first_stage ? app->fluid_species[i].fluid1 : app->fluid_species[i].fluidnew;
+  }
+  const struct gkyl_array *emin = 0;
+  struct gkyl_array *emout = 0;
+  if (app->has_field) {
+    emin = first_stage ? app->field->em : app->field->em1;
+    emout = first_stage ? app->field->em1 : app->field->emnew;
+  }
+
+  vlasov_forward_euler(app, t, h, fin, fluidin, emin, fout, fluidout, emout, st);
+
+  vm_apply_bc(app, tcurr, fout, fluidout, emout);
+
+  // Limit fluid and EM solutions if desired (done after update as post-hoc fix)
+  for (int i=0; i<nfs; ++i) {
+    vm_fluid_species_limiter(app, &app->fluid_species[i], fluidout[i]);
+  }
+  if (app->has_field) {
+    vm_field_limiter(app, app->field, emout);
+  }
+}
+
+// Registers of the species, fluid species and EM field.
+enum rk43_reg { RK43_F, RK43_F1, RK43_FNEW };
+
+static struct gkyl_array*
+rk43_species_reg(struct vm_species *s, enum rk43_reg r)
+{
+  return r == RK43_F ? s->f : (r == RK43_F1 ? s->f1 : s->fnew);
+}
+
+static struct gkyl_array*
+rk43_fluid_reg(struct vm_fluid_species *s, enum rk43_reg r)
+{
+  return r == RK43_F ? s->fluid : (r == RK43_F1 ? s->fluid1 : s->fluidnew);
+}
+
+static struct gkyl_array*
+rk43_em_reg(struct vm_field *field, enum rk43_reg r)
+{
+  return r == RK43_F ? field->em : (r == RK43_F1 ? field->em1 : field->emnew);
+}
+
+// Set out = c1*a + c2*b for the species, fluid species and EM field.
+static void
+rk43_combine(gkyl_vlasov_app* app, enum rk43_reg out, double c1, enum rk43_reg a,
+  double c2, enum rk43_reg b)
+{
+  for (int i=0; i<app->num_species; ++i) {
+    struct vm_species *s = &app->species[i];
+    array_combine(rk43_species_reg(s, out), c1, rk43_species_reg(s, a),
+      c2, rk43_species_reg(s, b), &s->local_ext);
+  }
+  for (int i=0; i<app->num_fluid_species; ++i) {
+    struct vm_fluid_species *s = &app->fluid_species[i];
+    array_combine(rk43_fluid_reg(s, out), c1, rk43_fluid_reg(s, a),
+      c2, rk43_fluid_reg(s, b), &app->local_ext);
+  }
+  if (app->has_field)
+    array_combine(rk43_em_reg(app->field, out), c1, rk43_em_reg(app->field, a),
+      c2, rk43_em_reg(app->field, b), &app->local_ext);
+}
+
+// Copy register inp into register out.
+static void
+rk43_copy(gkyl_vlasov_app* app, enum rk43_reg out, enum rk43_reg inp)
+{
+  for (int i=0; i<app->num_species; ++i) {
+    struct vm_species *s = &app->species[i];
+    gkyl_array_copy_range(rk43_species_reg(s, out), rk43_species_reg(s, inp), &s->local_ext);
+  }
+  for (int i=0; i<app->num_fluid_species; ++i) {
+    struct vm_fluid_species *s = &app->fluid_species[i];
+    gkyl_array_copy_range(rk43_fluid_reg(s, out), rk43_fluid_reg(s, inp), &app->local_ext);
+  }
+  if (app->has_field)
+    gkyl_array_copy_range(rk43_em_reg(app->field, out), rk43_em_reg(app->field, inp), &app->local_ext);
+}
+
+// Collect the stats of a stage that could not take the step h, and
+// return the step to restart stage 1 with.
+static double
+rk43_stage_fail(gkyl_vlasov_app* app, double h, double h_actual, bool second_stage)
+{
+  double dt_rel_diff = (h-h_actual)/h_actual;
+  double *dt_diff = second_stage ? app->stat.stage_2_dt_diff : app->stat.stage_3_dt_diff;
+  dt_diff[0] = fmin(dt_diff[0], dt_rel_diff);
+  dt_diff[1] = fmax(dt_diff[1], dt_rel_diff);
+  if (second_stage)
+    app->stat.nstage_2_fail += 1;
+  else
+    app->stat.nstage_3_fail += 1;
+
+  return h_actual;
+}
+
+// Take time-step using the SSPRK(4,3) method. Also sets the status object
+// which has the actual and suggested dts used. These can be different
+// from the actual time-step.
+struct gkyl_update_status
+vlasov_update_ssp_rk43(gkyl_vlasov_app* app, double dt0)
+{
+  struct gkyl_update_status st = { .success = true };
+
+  // time-stepper state
+  enum { RK_STAGE_1, RK_STAGE_2, RK_STAGE_3, RK_STAGE_4, RK_COMPLETE } state = RK_STAGE_1;
+
+  // h is the forward Euler step of each stage, dt = 2*h.
+  double tcurr = app->tcurr, h = dt0/2.0;
+  while (state != RK_COMPLETE) {
+    struct timespec rk_tm = gkyl_wall_clock();
+    switch (state) {
+      case RK_STAGE_1:
+        rk43_forward_euler(app, tcurr, tcurr, h, true, &st);
+        h = st.dt_actual;
+        state = RK_STAGE_2;
+        break;
+
+      case RK_STAGE_2:
+        rk43_forward_euler(app, tcurr, tcurr+h, h, false, &st);
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, h, st.dt_actual, true);
+          state = RK_STAGE_1; // restart from stage 1
+        }
+        else {
+          rk43_copy(app, RK43_F1, RK43_FNEW);
+          state = RK_STAGE_3;
+        }
+        break;
+
+      case RK_STAGE_3:
+        rk43_forward_euler(app, tcurr, tcurr+2.0*h, h, false, &st);
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, h, st.dt_actual, false);
+          state = RK_STAGE_1; // restart from stage 1
+        }
+        else {
+          rk43_combine(app, RK43_F1, 1.0/3.0, RK43_FNEW, 2.0/3.0, RK43_F);
+          state = RK_STAGE_4;
+        }
+        break;
+
+      case RK_STAGE_4:
+        rk43_forward_euler(app, tcurr, tcurr+h, h, false, &st);
+        if (st.dt_actual < h) {
+          h = rk43_stage_fail(app, h, st.dt_actual, false);
+          state = RK_STAGE_1; // restart from stage 1
+        }
+        else {
+          rk43_copy(app, RK43_F, RK43_FNEW);
+
+          // Report the full step, and the largest stable one, which is
+          // twice the forward Euler step.
+          st.dt_actual = 2.0*h;
+          st.dt_suggested = 2.0*st.dt_suggested;
+          state = RK_COMPLETE;
+        }
+        break;
+
+      case RK_COMPLETE: // can't happen: suppresses warning
+        break;
+    }
+    app->stat.rk3_tm += gkyl_time_diff_now_sec(rk_tm);
+  }
+
+  return st;
+}
@@ -65,9 +65,9 @@ vm_species_init(struct gkyl_vm *vm, struct gkyl_vlasov_app *app, struct vm_speci
   s->field_id = app->has_field ? app->field->field_id : GKYL_FIELD_NULL; // Save field type.
 
   // allocate distribution function arrays
-  s->f = mkarr(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
-  s->f1 = mkarr(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
-  s->fnew = mkarr(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
+  s->f = mkarr_distf(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
+  s->f1 = mkarr_distf(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
+  s->fnew = mkarr_distf(app->use_gpu, app->basis.num_basis, s->local_ext.volume);
 
   s->f_host = s->f;
   if (app->use_gpu)
@@ -0,0 +1,315 @@
+// Benchmarks of the Vlasov volume, surface and boundary-surface kernels
+// and of the Vlasov moment calculation, over dimensions, polynomial
+// orders and bases. Run with -h for options.
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_bench.h>
+#include <gkyl_dg_eqn.h>
+#include <gkyl_dg_vlasov.h>
+#include <gkyl_mom_calc.h>
+#include <gkyl_mom_vlasov.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_grid.h>
+
+// Fill array with values in [-0.5, 0.5) plus an offset.
+static void
+fill_array(struct gkyl_array *arr, double offset, unsigned seed)
+{
+  srand(seed);
+  double *d = arr->data;
+  for (long i=0; i<arr->size*arr->ncomp; ++i)
+    d[i] = offset + rand()/(RAND_MAX+1.0) - 0.5;
+}
+
+struct vlasov_ctx {
+  int cdim, pdim, num_basis;
+  struct gkyl_rect_grid grid;
+  struct gkyl_range range; // phase-space range (no ghosts)
+  const struct gkyl_dg_eqn *eqn;
+  struct gkyl_array *f, *rhs;
+  int dir; // direction for surface kernels
+  struct gkyl_range surf_range; // cells with both neighbors in dir
+  struct gkyl_range skin_range; // lower skin cells in dir
+  int idx[GKYL_MAX_DIM]; // cell used to count FLOPs
+};
+
+static void
+bench_vol(void *ctx, long ncells)
+{
+  struct vlasov_ctx *vc = ctx;
+  double xc[GKYL_MAX_DIM];
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &vc->range);
+  while (gkyl_range_iter_next(&iter)) {
+    long loc = gkyl_range_idx(&vc->range, iter.idx);
+    gkyl_rect_grid_cell_center(&vc->grid, iter.idx, xc);
+    vc->eqn->vol_term(vc->eqn, xc, vc->grid.dx, iter.idx,
+      gkyl_array_cfetch(vc->f, loc), gkyl_array_fetch(vc->rhs, loc));
+  }
+}
+
+static void
+bench_surf(void *ctx, long ncells)
+{
+  struct vlasov_ctx *vc = ctx;
+  int dir = vc->dir;
+  double xcl[GKYL_MAX_DIM], xcc[GKYL_MAX_DIM], xcr[GKYL_MAX_DIM];
+  int idxl[GKYL_MAX_DIM], idxr[GKYL_MAX_DIM];
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &vc->surf_range);
+  while (gkyl_range_iter_next(&iter)) {
+    gkyl_copy_int_arr(vc->pdim, iter.idx, idxl);
+    gkyl_copy_int_arr(vc->pdim, iter.idx, idxr);
+    idxl[dir] -= 1; idxr[dir] += 1;
+    gkyl_rect_grid_cell_center(&vc->grid, idxl, xcl);
+    gkyl_rect_grid_cell_center(&vc->grid, iter.idx, xcc);
+    gkyl_rect_grid_cell_center(&vc->grid, idxr, xcr);
+    long locl = gkyl_range_idx(&vc->range, idxl);
+    long locc = gkyl_range_idx(&vc->range, iter.idx);
+    long locr = gkyl_range_idx(&vc->range, idxr);
+    vc->eqn->surf_term(vc->eqn, dir, xcl, xcc, xcr,
+      vc->grid.dx, vc->grid.dx, vc->grid.dx, idxl, iter.idx, idxr,
+      gkyl_array_cfetch(vc->f, locl), gkyl_array_cfetch(vc->f, locc), gkyl_array_cfetch(vc->f, locr),
+      gkyl_array_fetch(vc->rhs, locc));
+  }
+}
+
+static void
+bench_boundary_surf(void *ctx, long ncells)
+{
+  struct vlasov_ctx *vc = ctx;
+  int dir = vc->dir;
+  double xce[GKYL_MAX_DIM], xcs[GKYL_MAX_DIM];
+  int idxe[GKYL_MAX_DIM];
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &vc->skin_range);
+  while (gkyl_range_iter_next(&iter)) {
+    gkyl_copy_int_arr(vc->pdim, iter.idx, idxe);
+    idxe[dir] += 1;
+    gkyl_rect_grid_cell_center(&vc->grid, idxe, xce);
+    gkyl_rect_grid_cell_center(&vc->grid, iter.idx, xcs);
+    long loce = gkyl_range_idx(&vc->range, idxe);
+    long locs = gkyl_range_idx(&vc->range, iter.idx);
+    vc->eqn->boundary_surf_term(vc->eqn, dir, xce, xcs, vc->grid.dx, vc->grid.dx,
+      idxe, iter.idx, -1, gkyl_array_cfetch(vc->f, loce), gkyl_array_cfetch(vc->f, locs),
+      gkyl_array_fetch(vc->rhs, locs));
+  }
+}
+
+// Kernels applied to a single cell, for counting FLOPs.
+static void
+linear_vol(void *ctx, const double *inp, double *out)
+{
+  struct vlasov_ctx *vc = ctx;
+  double xc[GKYL_MAX_DIM];
+  gkyl_rect_grid_cell_center(&vc->grid, vc->idx, xc);
+  for (int k=0; k<vc->num_basis; ++k) out[k] = 0.0;
+  vc->eqn->vol_term(vc->eqn, xc, vc->grid.dx, vc->idx, inp, out);
+}
+
+static void
+linear_surf(void *ctx, const double *inp, double *out)
+{
+  struct vlasov_ctx *vc = ctx;
+  int nb = vc->num_basis, dir = vc->dir;
+  double xcl[GKYL_MAX_DIM], xcc[GKYL_MAX_DIM], xcr[GKYL_MAX_DIM];
+  int idxl[GKYL_MAX_DIM], idxr[GKYL_MAX_DIM];
+  gkyl_copy_int_arr(vc->pdim, vc->idx, idxl);
+  gkyl_copy_int_arr(vc->pdim, vc->idx, idxr);
+  idxl[dir] -= 1; idxr[dir] += 1;
+  gkyl_rect_grid_cell_center(&vc->grid, idxl, xcl);
+  gkyl_rect_grid_cell_center(&vc->grid, vc->idx, xcc);
+  gkyl_rect_grid_cell_center(&vc->grid, idxr, xcr);
+  for (int k=0; k<nb; ++k) out[k] = 0.0;
+  vc->eqn->surf_term(vc->eqn, dir, xcl, xcc, xcr,
+    vc->grid.dx, vc->grid.dx, vc->grid.dx, idxl, vc->idx, idxr,
+    inp, inp+nb, inp+2*nb, out);
+}
+
+static void
+linear_boundary_surf(void *ctx, const double *inp, double *out)
+{
+  struct vlasov_ctx *vc = ctx;
+  int nb = vc->num_basis, dir = vc->dir;
+  double xce[GKYL_MAX_DIM], xcs[GKYL_MAX_DIM];
+  int idxe[GKYL_MAX_DIM];
+  gkyl_copy_int_arr(vc->pdim, vc->idx, idxe);
+  idxe[dir] += 1;
+  gkyl_rect_grid_cell_center(&vc->grid, idxe, xce);
+  gkyl_rect_grid_cell_center(&vc->grid, vc->idx, xcs);
+  for (int k=0; k<nb; ++k) out[k] = 0.0;
+  vc->eqn->boundary_surf_term(vc->eqn, dir, xce, xcs, vc->grid.dx, vc->grid.dx,
+    idxe, vc->idx, -1, inp, inp+nb, out);
+}
+
+struct mom_ctx {
+  gkyl_mom_calc *calc;
+  const struct gkyl_range *phase_range, *conf_range;
+  const struct gkyl_array *f;
+  struct gkyl_array *mom;
+};
+
+static void
+bench_mom(void *ctx, long ncells)
+{
+  struct mom_ctx *mc = ctx;
+  gkyl_mom_calc_advance(mc->calc, mc->phase_range, mc->conf_range, mc->f, mc->mom);
+}
+
+static void
+vlasov_kernels(gkyl_bench *bench, int cdim, int vdim, int poly_order, const char *bnm)
+{
+  char prefix[64], nm[128];
+  snprintf(prefix, sizeof prefix, "vlasov_%dx%dv_%s_p%d", cdim, vdim, bnm, poly_order);
+
+  int pdim = cdim+vdim;
+  struct gkyl_basis cbasis, pbasis;
+  if (strcmp(bnm, "ser") == 0) {
+    gkyl_cart_modal_serendip(&cbasis, cdim, poly_order);
+    if (poly_order == 1)
+      gkyl_cart_modal_hybrid(&pbasis, cdim, vdim);
+    else
+      gkyl_cart_modal_serendip(&pbasis, pdim, poly_order);
+  }
+  else {
+    gkyl_cart_modal_tensor(&cbasis, cdim, poly_order);
+    gkyl_cart_modal_tensor(&pbasis, pdim, poly_order);
+  }
+  int nb = pbasis.num_basis;
+
+  // About 32 MB in f, with at least 4 cells in each direction.
+  int ncdir = GKYL_MAX2(4, (int) floor(pow((1L << 22)/nb, 1.0/pdim)));
+  int cells[GKYL_MAX_DIM];
+  double lower[GKYL_MAX_DIM], upper[GKYL_MAX_DIM];
+  for (int d=0; d<pdim; ++d) {
+    cells[d] = ncdir;
+    lower[d] = -1.0; upper[d] = 1.0;
+  }
+
+  struct vlasov_ctx vc = { .cdim = cdim, .pdim = pdim, .num_basis = nb };
+  gkyl_rect_grid_init(&vc.grid, pdim, lower, upper, cells);
+  gkyl_range_init_from_shape(&vc.range, pdim, cells);
+  struct gkyl_range conf_range;
+  gkyl_range_init_from_shape(&conf_range, cdim, cells);
+
+  struct gkyl_array *field = gkyl_array_new(GKYL_DOUBLE, 8*cbasis.num_basis, conf_range.volume);
+  fill_array(field, 0.0, 3);
+  vc.f = gkyl_array_new(GKYL_DOUBLE, nb, vc.range.volume);
+  vc.rhs = gkyl_array_new(GKYL_DOUBLE, nb, vc.range.volume);
+  fill_array(vc.f, 1.0, 1);
+
+  struct gkyl_dg_eqn *eqn = gkyl_dg_vlasov_new(&cbasis, &pbasis, &conf_range, &vc.range,
+    GKYL_MODEL_DEFAULT, GKYL_FIELD_E_B, false);
+  gkyl_vlasov_set_auxfields(eqn, (struct gkyl_dg_vlasov_auxfields) { .field = field });
+  vc.eqn = eqn;
+  for (int d=0; d<pdim; ++d)
+    vc.idx[d] = ncdir/2;
+
+  double fbytes = sizeof(double[nb]);
+  // f is read, and the RHS read and written.
+  struct gkyl_bench_work work = { .bytes = 3*fbytes };
+
+  snprintf(nm, sizeof nm, "%s_vol", prefix);
+  if (gkyl_bench_enabled(bench, nm)) {
+    work.flops = gkyl_bench_linear_flops(linear_vol, &vc, nb, nb);
+    gkyl_bench_run(bench, nm, bench_vol, &vc, vc.range.volume, work);
+  }
+
+  const char *dnames = "xyz";
+  for (int d=0; d<pdim; ++d) {
+    vc.dir = d;
+    char dnm[8];
+    if (d < cdim)
+      snprintf(dnm, sizeof dnm, "%c", dnames[d]);
+    else
+      snprintf(dnm, sizeof dnm, "v%c", dnames[d-cdim]);
+
+    int lo[GKYL_MAX_DIM], up[GKYL_MAX_DIM];
+    for (int k=0; k<pdim; ++k) {
+      lo[k] = vc.range.lower[k];
+      up[k] = vc.range.upper[k];
+    }
+    lo[d] += 1; up[d] -= 1;
+    gkyl_sub_range_init(&vc.surf_range, &vc.range, lo, up);
+
+    snprintf(nm, sizeof nm, "%s_surf%s", prefix, dnm);
+    if (gkyl_bench_enabled(bench, nm)) {
+      work.flops = gkyl_bench_linear_flops(linear_surf, &vc, 3*nb, nb);
+      gkyl_bench_run(bench, nm, bench_surf, &vc, vc.surf_range.volume, work);
+    }
+
+    // Boundary-surface kernels are only used in velocity space.
+    if (d < cdim) continue;
+    for (int k=0; k<pdim; ++k) {
+      lo[k] = vc.range.lower[k];
+      up[k] = vc.range.upper[k];
+    }
+    up[d] = lo[d];
+    gkyl_sub_range_init(&vc.skin_range, &vc.range, lo, up);
+
+    snprintf(nm, sizeof nm, "%s_boundary_surf%s", prefix, dnm);
+    if (gkyl_bench_enabled(bench, nm)) {
+      work.flops = gkyl_bench_linear_flops(linear_boundary_surf, &vc, 2*nb, nb);
+      gkyl_bench_run(bench, nm, bench_boundary_surf, &vc, vc.skin_range.volume, work);
+    }
+  }
+
+  // Moments: f is read and the moments of each configuration-space cell
+  // accumulated.
+  const enum gkyl_distribution_moments mom_types[] = { GKYL_F_MOMENT_M0, GKYL_F_MOMENT_M1 };
+  const char *mom_names[] = { "M0", "M1" };
+  for (int m=0; m<2; ++m) {
+    snprintf(nm, sizeof nm, "%s_mom_%s", prefix, mom_names[m]);
+    if (!gkyl_bench_enabled(bench, nm)) continue;
+
+    struct gkyl_mom_type *momt = gkyl_mom_vlasov_new(&cbasis, &pbasis, mom_types[m], false);
+    struct mom_ctx mc = {
+      .calc = gkyl_mom_calc_new(&vc.grid, momt, false),
+      .phase_range = &vc.range,
+      .conf_range = &conf_range,
+      .f = vc.f,
+      .mom = gkyl_array_new(GKYL_DOUBLE, momt->num_mom*cbasis.num_basis, conf_range.volume),
+    };
+    gkyl_bench_run(bench, nm, bench_mom, &mc, vc.range.volume,
+      (struct gkyl_bench_work) { .bytes = fbytes });
+
+    gkyl_array_release(mc.mom);
+    gkyl_mom_calc_release(mc.calc);
+    gkyl_mom_type_release(momt);
+  }
+
+  gkyl_dg_eqn_release(eqn);
+  gkyl_array_release(field);
+  gkyl_array_release(vc.f);
+  gkyl_array_release(vc.rhs);
+}
+
+int
+main(int argc, char **argv)
+{
+  if (argc > 1 && strcmp(argv[1], "-h") == 0) {
+    printf("Usage: %s [-b baseline] [-o output] [-f filter] [-t threshold] [-m min-time]\n", argv[0]);
+    return 0;
+  }
+  struct gkyl_bench_inp inp = gkyl_bench_parse_args(argc, argv);
+  gkyl_bench *bench = gkyl_bench_new(&inp);
+
+  const int dims[][2] = { {1,1}, {1,2}, {1,3}, {2,2}, {2,3}, {3,3} };
+  const char *bnames[] = { "ser", "tensor" };
+  for (int b=0; b<2; ++b) {
+    for (int i=0; i<sizeof(dims)/sizeof(dims[0]); ++i) {
+      for (int p=1; p<=2; ++p) {
+        // No p=2 kernels in 6D.
+        if (dims[i][0] == 3 && p == 2) continue;
+        vlasov_kernels(bench, dims[i][0], dims[i][1], p, bnames[b]);
+      }
+    }
+  }
+
+  return gkyl_bench_release(bench) > 0 ? 1 : 0;
+}
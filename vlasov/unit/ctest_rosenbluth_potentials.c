@@ -0,0 +1,171 @@
+#include <acutest.h>
+
+#include <math.h>
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_gauss_quad_data.h>
+#include <gkyl_proj_on_basis.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_decomp.h>
+#include <gkyl_rect_grid.h>
+#include <gkyl_rosenbluth_potentials.h>
+#include <gkyl_thread_pool.h>
+#include <gkyl_util.h>
+
+static double
+den_1x(double x)
+{
+  return 1.0+0.5*x;
+}
+
+static void
+eval_maxwellian_1x3v(double t, const double *xn, double* GKYL_RESTRICT fout, void *ctx)
+{
+  double x = xn[0], vx = xn[1], vy = xn[2], vz = xn[3];
+  fout[0] = den_1x(x)/pow(2.0*M_PI, 1.5)*exp(-0.5*(vx*vx+vy*vy+vz*vz));
+}
+
+// Potentials of a Maxwellian with unit thermal speed and density n.
+static double
+h_maxwellian(double n, double v)
+{
+  return v < 1e-12? n*sqrt(2.0/M_PI) : n*erf(v/sqrt(2.0))/v;
+}
+
+static double
+g_maxwellian(double n, double v)
+{
+  if (v < 1e-12)
+    return 2.0*n*sqrt(2.0/M_PI);
+  return n*((v+1.0/v)*erf(v/sqrt(2.0)) + sqrt(2.0/M_PI)*exp(-0.5*v*v));
+}
+
+static void
+calc_potentials(int poly_order, int num_threads, struct gkyl_array **h_out, struct gkyl_array **g_out,
+  struct gkyl_rect_grid *grid_out, struct gkyl_range *local_out, struct gkyl_basis *basis_out)
+{
+  const int cdim = 1, vdim = 3, pdim = cdim+vdim;
+  double lower[] = {-1.0, -6.0, -6.0, -6.0}, upper[] = {1.0, 6.0, 6.0, 6.0};
+  int cells[] = {2, 12, 12, 12};
+  struct gkyl_rect_grid grid;
+  gkyl_rect_grid_init(&grid, pdim, lower, upper, cells);
+
+  struct gkyl_basis basis;
+  gkyl_cart_modal_serendip(&basis, pdim, poly_order);
+
+  int ghost[] = {1, 0, 0, 0};
+  struct gkyl_range local, local_ext;
+  gkyl_create_grid_ranges(&grid, ghost, &local_ext, &local);
+
+  struct gkyl_range conf_local, vel_local;
+  gkyl_range_init(&conf_local, cdim, local.lower, local.upper);
+  gkyl_range_init(&vel_local, vdim, local.lower+cdim, local.upper+cdim);
+
+  struct gkyl_array *f = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, local_ext.volume);
+  struct gkyl_array *h = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, local_ext.volume);
+  struct gkyl_array *g = gkyl_array_new(GKYL_DOUBLE, basis.num_basis, local_ext.volume);
+
+  gkyl_proj_on_basis *proj = gkyl_proj_on_basis_new(&grid, &basis, poly_order+1, 1,
+    eval_maxwellian_1x3v, 0);
+  gkyl_proj_on_basis_advance(proj, 0.0, &local, f);
+  gkyl_proj_on_basis_release(proj);
+
+  struct gkyl_job_pool *job_pool = num_threads > 0? gkyl_thread_pool_new(num_threads) : 0;
+  struct gkyl_rosenbluth_potentials *rosen = gkyl_rosenbluth_potentials_new(&grid, &basis,
+    &conf_local, &vel_local, job_pool);
+  gkyl_rosenbluth_potentials_advance(rosen, &local_ext, f, h, g);
+  gkyl_rosenbluth_potentials_release(rosen);
+  if (job_pool)
+    gkyl_job_pool_release(job_pool);
+
+  gkyl_array_release(f);
+  *h_out = h;
+  *g_out = g;
+  *grid_out = grid;
+  *local_out = local_ext;
+  *basis_out = basis;
+}
+
+static void
+test_1x3v_maxwellian(int poly_order)
+{
+  struct gkyl_array *h, *g;
+  struct gkyl_rect_grid grid;
+  struct gkyl_range local_ext;
+  struct gkyl_basis basis;
+  calc_potentials(poly_order, 0, &h, &g, &grid, &local_ext, &basis);
+
+  // Compare the cell averages of the potentials.
+  struct gkyl_range local;
+  int lower[] = {1, 1, 1, 1};
+  gkyl_sub_range_init(&local, &local_ext, lower, grid.cells);
+
+  double max_herr = 0.0, max_gerr = 0.0;
+  struct gkyl_range_iter iter;
+  gkyl_range_iter_init(&iter, &local);
+  while (gkyl_range_iter_next(&iter)) {
+    double xc[4];
+    gkyl_rect_grid_cell_center(&grid, iter.idx, xc);
+    double n = den_1x(xc[0]);
+
+    // Cell averages of the exact potentials.
+    const double *ord = gkyl_gauss_ordinates[4], *wgt = gkyl_gauss_weights[4];
+    double h_ex = 0.0, g_ex = 0.0;
+    for (int i=0; i<4; ++i)
+      for (int j=0; j<4; ++j)
+        for (int k=0; k<4; ++k) {
+          double vx = xc[1]+0.5*grid.dx[1]*ord[i], vy = xc[2]+0.5*grid.dx[2]*ord[j];
+          double vz = xc[3]+0.5*grid.dx[3]*ord[k];
+          double v = sqrt(vx*vx+vy*vy+vz*vz);
+          h_ex += wgt[i]*wgt[j]*wgt[k]*h_maxwellian(n, v)/8.0;
+          g_ex += wgt[i]*wgt[j]*wgt[k]*g_maxwellian(n, v)/8.0;
+        }
+
+    long linidx = gkyl_range_idx(&local_ext, iter.idx);
+    double cellav_fac = 1.0/pow(sqrt(2.0), grid.ndim);
+    const double *h_c = gkyl_array_cfetch(h, linidx), *g_c = gkyl_array_cfetch(g, linidx);
+    max_herr = fmax(max_herr, fabs(cellav_fac*h_c[0]/h_ex-1.0));
+    max_gerr = fmax(max_gerr, fabs(cellav_fac*g_c[0]/g_ex-1.0));
+  }
+  TEST_CHECK( max_herr < 1e-2 );
+  TEST_MSG( "max relative error in H: %.6e", max_herr );
+  TEST_CHECK( max_gerr < 1e-2 );
+  TEST_MSG( "max relative error in G: %.6e", max_gerr );
+
+  gkyl_array_release(h);
+  gkyl_array_release(g);
+}
+
+static void
+test_1x3v_threads(int poly_order)
+{
+  struct gkyl_array *h, *g, *h_th, *g_th;
+  struct gkyl_rect_grid grid;
+  struct gkyl_range local_ext;
+  struct gkyl_basis basis;
+  calc_potentials(poly_order, 0, &h, &g, &grid, &local_ext, &basis);
+  calc_potentials(poly_order, 2, &h_th, &g_th, &grid, &local_ext, &basis);
+
+  const double *h_d = h->data, *g_d = g->data, *h_th_d = h_th->data, *g_th_d = g_th->data;
+  for (long i=0; i<h->size*h->ncomp; ++i) {
+    TEST_CHECK( h_d[i] == h_th_d[i] );
+    TEST_CHECK( g_d[i] == g_th_d[i] );
+  }
+
+  gkyl_array_release(h);
+  gkyl_array_release(g);
+  gkyl_array_release(h_th);
+  gkyl_array_release(g_th);
+}
+
+void test_1x3v_maxwellian_p1() { test_1x3v_maxwellian(1); }
+void test_1x3v_maxwellian_p2() { test_1x3v_maxwellian(2); }
+void test_1x3v_threads_p1() { test_1x3v_threads(1); }
+
+TEST_LIST = {
+  { "test_1x3v_maxwellian_p1", test_1x3v_maxwellian_p1 },
+  { "test_1x3v_maxwellian_p2", test_1x3v_maxwellian_p2 },
+  { "test_1x3v_threads_p1", test_1x3v_threads_p1 },
+  { NULL, NULL },
+};
@@ -46,9 +46,13 @@ gkyl_dg_calc_sr_vars_new(const struct gkyl_rect_grid *phase_grid, const struct g
   // Linear system for solving for the drift velocity V_drift = M1i/M0 
   // and then computing the rest-frame density n = GammaV_inv*M0 
   // where GammaV_inv = sqrt(1 - |V_drift|^2)
+  // The systems are assembled and solved in tiles of cells so memory 
+  // does not scale with the size of mem_range
   up->Ncomp = vdim; 
-  up->As = gkyl_nmat_new(up->Ncomp*mem_range->volume, nc, nc);
-  up->xs = gkyl_nmat_new(up->Ncomp*mem_range->volume, nc, 1);
+  up->tile_cells = GKYL_MIN2(mem_range->volume, GKYL_NMAT_TILE_CELLS);
+  up->tile_loc = gkyl_malloc(sizeof(long[up->tile_cells]));
+  up->As = gkyl_nmat_new(up->Ncomp*up->tile_cells, nc, nc);
+  up->xs = gkyl_nmat_new(up->Ncomp*up->tile_cells, nc, 1);
   up->mem = gkyl_nmat_linsolve_lu_new(up->As->num, up->As->nr);
 
   up->flags = 0;
@@ -81,6 +85,27 @@ void gkyl_calc_sr_vars_init_p_vars(struct gkyl_dg_calc_sr_vars *up,
   }
 }
 
+// Solve the linear systems for V_drift in the current tile and
+// compute the rest-frame density n = M0/Gamma
+static void
+sr_vars_n_solve_tile(struct gkyl_dg_calc_sr_vars *up, long ntile, 
+  const struct gkyl_array* M0, struct gkyl_array* n)
+{
+  if (up->poly_order > 1) {
+    bool status = gkyl_nmat_linsolve_lu_pa_num(up->mem, up->Ncomp*ntile, up->As, up->xs);
+    assert(status);
+  }
+
+  for (long c=0; c<ntile; ++c) {
+    long loc = up->tile_loc[c];
+
+    const double *M0_d = gkyl_array_cfetch(M0, loc);
+    double* n_d = gkyl_array_fetch(n, loc);
+
+    up->sr_n_copy(c*up->Ncomp, up->xs, M0_d, n_d);
+  }
+}
+
 void gkyl_dg_calc_sr_vars_n(struct gkyl_dg_calc_sr_vars *up, 
   const struct gkyl_array* M0, const struct gkyl_array* M1i, struct gkyl_array* n)
 {
@@ -90,40 +115,28 @@ void gkyl_dg_calc_sr_vars_n(struct gkyl_dg_calc_sr_vars *up,
   }
 #endif
 
-  // First loop over mem_range for setting matrices to solve linear systems for V_drift
+  // Loop over mem_range setting the matrices for the linear systems for V_drift,
+  // solving them and constructing 1/Gamma = sqrt(1 - V_drift^2) each time a 
+  // tile is filled
   struct gkyl_range_iter iter;
   gkyl_range_iter_init(&iter, &up->mem_range);
-  long count = 0;
+  long ntile = 0;
   while (gkyl_range_iter_next(&iter)) {
     long loc = gkyl_range_idx(&up->mem_range, iter.idx);
 
     const double *M0_d = gkyl_array_cfetch(M0, loc);
     const double *M1i_d = gkyl_array_cfetch(M1i, loc);
 
-    up->sr_n_set(count, up->As, up->xs, M0_d, M1i_d);
-
-    count += up->Ncomp;
-  }
+    up->sr_n_set(ntile*up->Ncomp, up->As, up->xs, M0_d, M1i_d);
 
-  if (up->poly_order > 1) {
-    bool status = gkyl_nmat_linsolve_lu_pa(up->mem, up->As, up->xs);
-    assert(status);
-  }
-
-  // Then loop over mem_range to construct 1/Gamma = sqrt(1 - V_drift^2)
-  // to solve for the rest-frame density n = M0/Gamma
-  gkyl_range_iter_init(&iter, &up->mem_range);
-  count = 0;
-  while (gkyl_range_iter_next(&iter)) {
-    long loc = gkyl_range_idx(&up->mem_range, iter.idx);
-
-    const double *M0_d = gkyl_array_cfetch(M0, loc);
-    double* n_d = gkyl_array_fetch(n, loc);
-
-    up->sr_n_copy(count, up->xs, M0_d, n_d);
-
-    count += up->Ncomp;
+    up->tile_loc[ntile++] = loc;
+    if (ntile == up->tile_cells) {
+      sr_vars_n_solve_tile(up, ntile, M0, n);
+      ntile = 0;
+    }
   }
+  if (ntile > 0)
+    sr_vars_n_solve_tile(up, ntile, M0, n);
 }
 
 void gkyl_dg_calc_sr_vars_GammaV(struct gkyl_dg_calc_sr_vars *up, 
@@ -208,6 +221,7 @@ void gkyl_dg_calc_sr_vars_release(gkyl_dg_calc_sr_vars *up)
   gkyl_nmat_release(up->As);
   gkyl_nmat_release(up->xs);
   gkyl_nmat_linsolve_lu_release(up->mem);
+  gkyl_free(up->tile_loc);
 
   if (GKYL_IS_CU_ALLOC(up->flags))
     gkyl_cu_free(up->on_dev);
@@ -294,6 +294,9 @@ gkyl_dg_calc_sr_vars_cu_dev_new(const struct gkyl_rect_grid *phase_grid, const s
   up->As = gkyl_nmat_cu_dev_new(up->Ncomp*mem_range->volume, nc, nc);
   up->xs = gkyl_nmat_cu_dev_new(up->Ncomp*mem_range->volume, nc, 1);
   up->mem = gkyl_nmat_linsolve_lu_cu_dev_new(up->As->num, up->As->nr);
+  // The whole range is solved in a single batch on the GPU
+  up->tile_cells = mem_range->volume;
+  up->tile_loc = 0;
 
   up->flags = 0;
   GKYL_SET_CU_ALLOC(up->flags);
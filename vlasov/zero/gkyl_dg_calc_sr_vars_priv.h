@@ -58,6 +58,8 @@ struct gkyl_dg_calc_sr_vars {
   struct gkyl_nmat *As, *xs; // matrices for LHS and RHS for V_drift solve to find rest-frame density.
   gkyl_nmat_mem *mem; // memory for use in batched linear solve for V_drift solve to find rest-frame density.
   int Ncomp; // number of components in the linear solve (vdim components of V_drift from weak division).
+  long tile_cells; // number of cells whose systems are solved together (host only).
+  long *tile_loc; // linear index of each cell in current tile (host only).
 
   p_vars_t sr_p_vars; // kernel for computing gamma = sqrt(1 + p^2) and its inverse on momentum (four-velocity) grid. 
   sr_n_set_t sr_n_set; // kernel for setting matrices for linear solve for rest-frame density.
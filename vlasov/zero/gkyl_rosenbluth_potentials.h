@@ -0,0 +1,61 @@
+#pragma once
+
+#include <gkyl_array.h>
+#include <gkyl_basis.h>
+#include <gkyl_job_pool.h>
+#include <gkyl_range.h>
+#include <gkyl_rect_grid.h>
+
+// Object type
+typedef struct gkyl_rosenbluth_potentials gkyl_rosenbluth_potentials;
+
+/**
+ * Create new updater to compute the Rosenbluth potentials
+ *   H(v) = int f(v')/|v-v'| dv',    G(v) = int f(v') |v-v'| dv',
+ * which satisfy lap(H) = -4 pi f and lap(G) = 2 H, needed by the
+ * Fokker-Planck drag and diffusion terms (see gkyl_dg_updater_fpo_vlasov.h).
+ *
+ * In each configuration-space cell f is sampled on a uniform lattice of
+ * (poly_order+1) points per velocity cell and direction, and the free-space
+ * convolutions are computed with zero-padded FFTs (Hockney's method). The
+ * Green's functions are integrated exactly over each lattice sub-cell and
+ * transformed once, at construction, so every conf cell only needs one
+ * forward and one inverse FFT (H and G are returned in the real and
+ * imaginary parts). The potentials at the lattice points are then fitted
+ * (least squares) onto the phase-space basis.
+ *
+ * The velocity domain must not be decomposed (vel_range must span the whole
+ * velocity grid), and vdim must be 3. Configuration-space cells are split
+ * evenly amongst the threads of the (optional) job pool.
+ *
+ * @param grid Phase-space grid.
+ * @param pbasis Phase-space basis the DG fields are defined with.
+ * @param conf_range Configuration-space range to compute the potentials in.
+ * @param vel_range Velocity-space range (whole velocity domain).
+ * @param job_pool Job pool to thread over configuration space (NULL to run serially).
+ * @return New updater pointer.
+ */
+struct gkyl_rosenbluth_potentials*
+gkyl_rosenbluth_potentials_new(const struct gkyl_rect_grid *grid,
+  const struct gkyl_basis *pbasis, const struct gkyl_range *conf_range,
+  const struct gkyl_range *vel_range, const struct gkyl_job_pool *job_pool);
+
+/**
+ * Compute the Rosenbluth potentials of f.
+ *
+ * @param up Rosenbluth potentials updater.
+ * @param phase_range Phase-space range the arrays are defined on.
+ * @param fin Input distribution function.
+ * @param h Output first Rosenbluth potential, H.
+ * @param g Output second Rosenbluth potential, G.
+ */
+void gkyl_rosenbluth_potentials_advance(struct gkyl_rosenbluth_potentials *up,
+  const struct gkyl_range *phase_range, const struct gkyl_array *fin,
+  struct gkyl_array *h, struct gkyl_array *g);
+
+/**
+ * Delete updater.
+ *
+ * @param up Updater to delete.
+ */
+void gkyl_rosenbluth_potentials_release(struct gkyl_rosenbluth_potentials *up);
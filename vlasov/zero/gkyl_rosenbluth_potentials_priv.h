@@ -0,0 +1,57 @@
+#pragma once
+
+// Private header for rosenbluth_potentials updater, not for direct use in user code.
+
+#include <complex.h>
+
+#include <gkyl_rosenbluth_potentials.h>
+
+// Workspace used by each thread (one per chunk of conf-space cells).
+struct rosenbluth_potentials_work {
+  double *fnod; // f at the velocity lattice, for each conf node.
+  double *hnod, *gnod; // H and G at the velocity lattice, for each conf node.
+  double complex *buff; // Zero-padded FFT buffer.
+  double complex *line; // Buffer for 1D FFTs.
+  double *cell_nod; // Values at the nodes of a single phase-space cell.
+};
+
+// Context passed to each job.
+struct rosenbluth_potentials_job_ctx {
+  struct gkyl_rosenbluth_potentials *up;
+  struct rosenbluth_potentials_work *work;
+  long loc_lo, loc_up; // Conf-space cells [loc_lo, loc_up) this job updates.
+  const struct gkyl_range *phase_range;
+  const struct gkyl_array *fin;
+  struct gkyl_array *h, *g;
+};
+
+// Primary struct in this updater.
+struct gkyl_rosenbluth_potentials {
+  int cdim, pdim; // Conf- and phase-space dimensions.
+  int num_basis; // Number of phase-space basis functions.
+  struct gkyl_range conf_range; // Conf-space range to update.
+  struct gkyl_range vel_range; // Velocity-space range.
+
+  int num_nod1d; // Number of lattice points per cell per direction.
+  int num_cnod, num_vnod; // Number of conf/velocity nodes in a cell.
+  int num_nod; // Number of nodes in a phase-space cell.
+  double *basis_at_nod; // Basis evaluated at nodes (num_nod x num_basis, row major).
+  double *nod_to_mod; // Least squares fit from nodes to modal coefficients
+                      // (num_basis x num_nod, row major).
+  long *vnod_off; // Offset of each velocity node in the lattice, relative to
+                  // the first node in its cell.
+
+  int lat_cells[3]; // Number of lattice points in each velocity direction.
+  long lat_vol; // Total number of lattice points.
+  int fft_len[3]; // Length of the zero-padded FFTs in each direction.
+  long fft_vol; // Total number of points in the zero-padded FFT.
+  double complex *twiddle[3]; // FFT twiddle factors in each direction.
+  double complex *kern_hat; // FFT of the H Green's function (real part) and the
+                            // G one (imaginary part), integrated over a lattice
+                            // cell and divided by fft_vol.
+
+  const struct gkyl_job_pool *job_pool; // Job pool (may be NULL).
+  int num_jobs; // Number of chunks conf space is split into.
+  struct rosenbluth_potentials_work *work; // Per-job workspace.
+  struct rosenbluth_potentials_job_ctx *job_ctx; // Per-job context.
+};
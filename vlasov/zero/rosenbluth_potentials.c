@@ -0,0 +1,459 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include <gkyl_alloc.h>
+#include <gkyl_gauss_quad_data.h>
+#include <gkyl_mat.h>
+#include <gkyl_rosenbluth_potentials.h>
+#include <gkyl_rosenbluth_potentials_priv.h>
+
+// Primitive of 1/r, i.e. int_0^x int_0^y int_0^z 1/r dz dy dx up to terms
+// that cancel in a box integral, for x,y,z >= 0.
+static double
+inv_r_prim(double x, double y, double z)
+{
+  double r = sqrt(x*x+y*y+z*z);
+  double out = 0.0;
+  if (y > 0.0 && z > 0.0) out += y*z*log(x+r);
+  if (x > 0.0 && z > 0.0) out += x*z*log(y+r);
+  if (x > 0.0 && y > 0.0) out += x*y*log(z+r);
+  if (x > 0.0) out -= 0.5*x*x*atan(y*z/(x*r));
+  if (y > 0.0) out -= 0.5*y*y*atan(x*z/(y*r));
+  if (z > 0.0) out -= 0.5*z*z*atan(x*y/(z*r));
+  return out;
+}
+
+// Integral of 1/r over the box between the origin and (x,y,z).
+static double
+inv_r_origin(double x, double y, double z)
+{
+  double ax = fabs(x), ay = fabs(y), az = fabs(z);
+  double out = inv_r_prim(ax,ay,az)
+    - inv_r_prim(0.0,ay,az) - inv_r_prim(ax,0.0,az) - inv_r_prim(ax,ay,0.0)
+    + inv_r_prim(ax,0.0,0.0) + inv_r_prim(0.0,ay,0.0) + inv_r_prim(0.0,0.0,az);
+  return (x < 0.0? -1.0 : 1.0)*(y < 0.0? -1.0 : 1.0)*(z < 0.0? -1.0 : 1.0)*out;
+}
+
+// Exact integral of 1/r over the box [lo,up].
+static double
+inv_r_box(const double *lo, const double *up)
+{
+  double out = 0.0;
+  for (int i=0; i<8; ++i) {
+    double sign = 1.0, x[3];
+    for (int d=0; d<3; ++d) {
+      bool is_up = (i >> d) & 1;
+      x[d] = is_up? up[d] : lo[d];
+      sign *= is_up? 1.0 : -1.0;
+    }
+    out += sign*inv_r_origin(x[0], x[1], x[2]);
+  }
+  return out;
+}
+
+// Gaussian quadrature of 1/r (pow=-1) or r (pow=1) over the box [lo,up].
+static double
+r_pow_box_quad(int pow, const double *lo, const double *up, int num_quad)
+{
+  const double *ord = gkyl_gauss_ordinates[num_quad], *wgt = gkyl_gauss_weights[num_quad];
+  double xc[3], dxh[3];
+  for (int d=0; d<3; ++d) {
+    xc[d] = 0.5*(lo[d]+up[d]);
+    dxh[d] = 0.5*(up[d]-lo[d]);
+  }
+  double out = 0.0;
+  for (int i=0; i<num_quad; ++i) {
+    double x = xc[0]+dxh[0]*ord[i];
+    for (int j=0; j<num_quad; ++j) {
+      double y = xc[1]+dxh[1]*ord[j];
+      for (int k=0; k<num_quad; ++k) {
+        double z = xc[2]+dxh[2]*ord[k];
+        double r = sqrt(x*x+y*y+z*z);
+        out += wgt[i]*wgt[j]*wgt[k]*(pow < 0? 1.0/r : r);
+      }
+    }
+  }
+  return dxh[0]*dxh[1]*dxh[2]*out;
+}
+
+// In-place radix-2 FFT of length n (a power of 2). tw[k] = exp(-2 pi i k/n).
+static void
+fft_1d(double complex *a, int n, const double complex *tw, bool inverse)
+{
+  for (int i=1, j=0; i<n; ++i) {
+    int bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      double complex tmp = a[i];
+      a[i] = a[j];
+      a[j] = tmp;
+    }
+  }
+  for (int len=2; len<=n; len <<= 1) {
+    int half = len/2, step = n/len;
+    for (int i=0; i<n; i+=len) {
+      for (int k=0; k<half; ++k) {
+        double complex w = inverse? conj(tw[k*step]) : tw[k*step];
+        double complex u = a[i+k], v = a[i+k+half]*w;
+        a[i+k] = u+v;
+        a[i+k+half] = u-v;
+      }
+    }
+  }
+}
+
+// FFT along direction dir of the 3D buffer, only for lines whose index in the
+// other directions is below ext (the rest are known to be zero or not needed).
+static void
+fft_pass(const struct gkyl_rosenbluth_potentials *up, double complex *buff,
+  double complex *line, int dir, const int *ext, bool inverse)
+{
+  const int *len = up->fft_len;
+  long stride[3] = { (long) len[1]*len[2], len[2], 1 };
+  int d1 = dir == 0? 1 : 0, d2 = dir == 2? 1 : 2;
+  for (int i=0; i<ext[d1]; ++i) {
+    for (int j=0; j<ext[d2]; ++j) {
+      double complex *b = buff + i*stride[d1] + j*stride[d2];
+      for (int k=0; k<len[dir]; ++k) line[k] = b[k*stride[dir]];
+      fft_1d(line, len[dir], up->twiddle[dir], inverse);
+      for (int k=0; k<len[dir]; ++k) b[k*stride[dir]] = line[k];
+    }
+  }
+}
+
+// Forward FFT of a buffer that is zero outside of the lattice.
+static void
+fft_forward(const struct gkyl_rosenbluth_potentials *up, double complex *buff, double complex *line)
+{
+  const int *lat = up->lat_cells, *len = up->fft_len;
+  fft_pass(up, buff, line, 2, (int[]) { lat[0], lat[1], len[2] }, false);
+  fft_pass(up, buff, line, 1, (int[]) { lat[0], len[1], len[2] }, false);
+  fft_pass(up, buff, line, 0, (int[]) { len[0], len[1], len[2] }, false);
+}
+
+// Inverse FFT of a buffer, only computing the values on the lattice.
+static void
+fft_inverse(const struct gkyl_rosenbluth_potentials *up, double complex *buff, double complex *line)
+{
+  const int *lat = up->lat_cells, *len = up->fft_len;
+  fft_pass(up, buff, line, 0, (int[]) { len[0], len[1], len[2] }, true);
+  fft_pass(up, buff, line, 1, (int[]) { lat[0], len[1], len[2] }, true);
+  fft_pass(up, buff, line, 2, (int[]) { lat[0], lat[1], len[2] }, true);
+}
+
+// Index of the lattice point (l0,l1,l2) in the zero-padded FFT buffer.
+static inline long
+buff_idx(const struct gkyl_rosenbluth_potentials *up, int l0, int l1, int l2)
+{
+  return ((long) l0*up->fft_len[1] + l1)*up->fft_len[2] + l2;
+}
+
+// Convolve f on the lattice with the H and G Green's functions.
+static void
+convolve(const struct gkyl_rosenbluth_potentials *up, struct rosenbluth_potentials_work *work,
+  const double *fnod, double *hnod, double *gnod)
+{
+  const int *lat = up->lat_cells;
+  double complex *buff = work->buff;
+  memset(buff, 0, up->fft_vol*sizeof(double complex));
+  for (int l0=0; l0<lat[0]; ++l0)
+    for (int l1=0; l1<lat[1]; ++l1) {
+      double complex *b = buff + buff_idx(up, l0, l1, 0);
+      const double *f = fnod + ((long) l0*lat[1] + l1)*lat[2];
+      for (int l2=0; l2<lat[2]; ++l2) b[l2] = f[l2];
+    }
+
+  fft_forward(up, buff, work->line);
+  for (long i=0; i<up->fft_vol; ++i) buff[i] *= up->kern_hat[i];
+  fft_inverse(up, buff, work->line);
+
+  for (int l0=0; l0<lat[0]; ++l0)
+    for (int l1=0; l1<lat[1]; ++l1) {
+      const double complex *b = buff + buff_idx(up, l0, l1, 0);
+      long loff = ((long) l0*lat[1] + l1)*lat[2];
+      for (int l2=0; l2<lat[2]; ++l2) {
+        hnod[loff+l2] = creal(b[l2]);
+        gnod[loff+l2] = cimag(b[l2]);
+      }
+    }
+}
+
+static void
+rosenbluth_potentials_job(void *ctx)
+{
+  struct rosenbluth_potentials_job_ctx *jc = ctx;
+  const struct gkyl_rosenbluth_potentials *up = jc->up;
+  struct rosenbluth_potentials_work *work = jc->work;
+
+  int cdim = up->cdim, num_basis = up->num_basis, num_nod = up->num_nod;
+  int num_vnod = up->num_vnod, npd = up->num_nod1d;
+  const int *lat = up->lat_cells;
+  double *cell_nod = work->cell_nod;
+
+  int pidx[GKYL_MAX_DIM];
+  for (long cloc=jc->loc_lo; cloc<jc->loc_up; ++cloc) {
+    gkyl_range_inv_idx(&up->conf_range, cloc, pidx);
+
+    // Sample f on the velocity lattice, at each conf-space node.
+    struct gkyl_range_iter viter;
+    gkyl_range_iter_init(&viter, &up->vel_range);
+    while (gkyl_range_iter_next(&viter)) {
+      for (int d=0; d<3; ++d) pidx[cdim+d] = viter.idx[d];
+      const double *f_c = gkyl_array_cfetch(jc->fin, gkyl_range_idx(jc->phase_range, pidx));
+      for (int n=0; n<num_nod; ++n) {
+        const double *b = up->basis_at_nod + n*num_basis;
+        double val = 0.0;
+        for (int k=0; k<num_basis; ++k) val += b[k]*f_c[k];
+        cell_nod[n] = val;
+      }
+
+      long lbase = (((long) (viter.idx[0]-up->vel_range.lower[0])*lat[1]
+          + (viter.idx[1]-up->vel_range.lower[1]))*lat[2]
+        + (viter.idx[2]-up->vel_range.lower[2]))*npd;
+      for (int n=0; n<num_nod; ++n) {
+        int cn = n/num_vnod, vn = n % num_vnod;
+        work->fnod[cn*up->lat_vol + lbase + up->vnod_off[vn]] = cell_nod[n];
+      }
+    }
+
+    for (int cn=0; cn<up->num_cnod; ++cn)
+      convolve(up, work, work->fnod + cn*up->lat_vol, work->hnod + cn*up->lat_vol,
+        work->gnod + cn*up->lat_vol);
+
+    // Fit the potentials at the nodes onto the phase-space basis.
+    gkyl_range_iter_init(&viter, &up->vel_range);
+    while (gkyl_range_iter_next(&viter)) {
+      for (int d=0; d<3; ++d) pidx[cdim+d] = viter.idx[d];
+      long linidx = gkyl_range_idx(jc->phase_range, pidx);
+
+      long lbase = (((long) (viter.idx[0]-up->vel_range.lower[0])*lat[1]
+          + (viter.idx[1]-up->vel_range.lower[1]))*lat[2]
+        + (viter.idx[2]-up->vel_range.lower[2]))*npd;
+
+      for (int pot=0; pot<2; ++pot) {
+        const double *pnod = pot == 0? work->hnod : work->gnod;
+        double *p_c = gkyl_array_fetch(pot == 0? jc->h : jc->g, linidx);
+        for (int n=0; n<num_nod; ++n) {
+          int cn = n/num_vnod, vn = n % num_vnod;
+          cell_nod[n] = pnod[cn*up->lat_vol + lbase + up->vnod_off[vn]];
+        }
+        for (int k=0; k<num_basis; ++k) {
+          const double *m = up->nod_to_mod + k*num_nod;
+          double val = 0.0;
+          for (int n=0; n<num_nod; ++n) val += m[n]*cell_nod[n];
+          p_c[k] = val;
+        }
+      }
+    }
+  }
+}
+
+// Evaluate the basis at the nodes and compute the least squares fit from
+// nodal values to modal coefficients.
+static void
+init_nodes(struct gkyl_rosenbluth_potentials *up, const struct gkyl_basis *pbasis)
+{
+  int pdim = up->pdim, npd = up->num_nod1d, num_basis = up->num_basis, num_nod = up->num_nod;
+
+  struct gkyl_mat *bmat = gkyl_mat_new(num_nod, num_basis, 0.0);
+  up->basis_at_nod = gkyl_malloc(sizeof(double[num_nod*num_basis]));
+  double z[GKYL_MAX_DIM], b[num_basis];
+  for (int n=0; n<num_nod; ++n) {
+    // Node n = cn*num_vnod+vn, with the last direction varying fastest.
+    for (int d=pdim-1, rem=n; d>=0; --d) {
+      z[d] = -1.0 + (2.0*(rem % npd)+1.0)/npd;
+      rem /= npd;
+    }
+    pbasis->eval(z, b);
+    for (int k=0; k<num_basis; ++k) {
+      up->basis_at_nod[n*num_basis+k] = b[k];
+      gkyl_mat_set(bmat, n, k, b[k]);
+    }
+  }
+
+  // Solve (B^T B) X = B^T.
+  struct gkyl_mat *btb = gkyl_mat_new(num_basis, num_basis, 0.0);
+  gkyl_mat_mm(1.0, 0.0, GKYL_TRANS, bmat, GKYL_NO_TRANS, bmat, btb, false);
+  struct gkyl_mat *bt = gkyl_mat_new(num_basis, num_nod, 0.0);
+  for (int n=0; n<num_nod; ++n)
+    for (int k=0; k<num_basis; ++k)
+      gkyl_mat_set(bt, k, n, gkyl_mat_get(bmat, n, k));
+  long ipiv[num_basis];
+  bool status = gkyl_mat_linsolve_lu(btb, bt, ipiv);
+  assert(status);
+
+  up->nod_to_mod = gkyl_malloc(sizeof(double[num_basis*num_nod]));
+  for (int k=0; k<num_basis; ++k)
+    for (int n=0; n<num_nod; ++n)
+      up->nod_to_mod[k*num_nod+n] = gkyl_mat_get(bt, k, n);
+
+  up->vnod_off = gkyl_malloc(sizeof(long[up->num_vnod]));
+  for (int vn=0; vn<up->num_vnod; ++vn) {
+    int a0 = vn/(npd*npd), a1 = (vn/npd) % npd, a2 = vn % npd;
+    up->vnod_off[vn] = ((long) a0*up->lat_cells[1] + a1)*up->lat_cells[2] + a2;
+  }
+
+  gkyl_mat_release(bt);
+  gkyl_mat_release(btb);
+  gkyl_mat_release(bmat);
+}
+
+// Compute the FFT of the Green's functions integrated over lattice cells.
+static void
+init_kernels(struct gkyl_rosenbluth_potentials *up, const double *dv)
+{
+  const int *lat = up->lat_cells, *len = up->fft_len;
+  up->kern_hat = gkyl_malloc(up->fft_vol*sizeof(double complex));
+  memset(up->kern_hat, 0, up->fft_vol*sizeof(double complex));
+
+  for (int o0=1-lat[0]; o0<lat[0]; ++o0) {
+    for (int o1=1-lat[1]; o1<lat[1]; ++o1) {
+      for (int o2=1-lat[2]; o2<lat[2]; ++o2) {
+        int off[3] = { o0, o1, o2 };
+        double lo[3], up_[3];
+        int dist = 0;
+        for (int d=0; d<3; ++d) {
+          lo[d] = (off[d]-0.5)*dv[d];
+          up_[d] = (off[d]+0.5)*dv[d];
+          dist = GKYL_MAX2(dist, abs(off[d]));
+        }
+        // 1/r is integrated exactly near the singularity, and r (whose
+        // gradient is discontinuous at the origin) with more points.
+        double kh = dist > 2? r_pow_box_quad(-1, lo, up_, 4) : inv_r_box(lo, up_);
+        double kg = r_pow_box_quad(1, lo, up_, dist > 2? 4 : gkyl_gauss_max);
+        long idx = buff_idx(up, o0 < 0? len[0]+o0 : o0, o1 < 0? len[1]+o1 : o1,
+          o2 < 0? len[2]+o2 : o2);
+        up->kern_hat[idx] = kh + I*kg;
+      }
+    }
+  }
+
+  // Both kernels are real and even, so their transforms are real and can be
+  // stored in the real and imaginary parts of a single transform.
+  double complex *line = gkyl_malloc(sizeof(double complex[GKYL_MAX2(len[0], GKYL_MAX2(len[1], len[2]))]));
+  fft_pass(up, up->kern_hat, line, 2, len, false);
+  fft_pass(up, up->kern_hat, line, 1, len, false);
+  fft_pass(up, up->kern_hat, line, 0, len, false);
+  gkyl_free(line);
+  for (long i=0; i<up->fft_vol; ++i) up->kern_hat[i] /= up->fft_vol;
+}
+
+struct gkyl_rosenbluth_potentials*
+gkyl_rosenbluth_potentials_new(const struct gkyl_rect_grid *grid,
+  const struct gkyl_basis *pbasis, const struct gkyl_range *conf_range,
+  const struct gkyl_range *vel_range, const struct gkyl_job_pool *job_pool)
+{
+  struct gkyl_rosenbluth_potentials *up = gkyl_malloc(sizeof(*up));
+
+  up->pdim = grid->ndim;
+  up->cdim = conf_range->ndim;
+  assert(up->pdim - up->cdim == 3);
+  up->num_basis = pbasis->num_basis;
+
+  // Use a copy of the conf range that is not a sub-range, so that the
+  // inverse indexer can be used to split it amongst threads.
+  gkyl_range_init(&up->conf_range, up->cdim, conf_range->lower, conf_range->upper);
+  up->vel_range = *vel_range;
+
+  up->num_nod1d = pbasis->poly_order+1;
+  up->num_cnod = up->num_vnod = 1;
+  for (int d=0; d<up->cdim; ++d) up->num_cnod *= up->num_nod1d;
+  for (int d=0; d<3; ++d) up->num_vnod *= up->num_nod1d;
+  up->num_nod = up->num_cnod*up->num_vnod;
+
+  // Lattice and zero-padded FFT sizes.
+  double dv[3];
+  up->lat_vol = up->fft_vol = 1;
+  for (int d=0; d<3; ++d) {
+    assert(vel_range->upper[d]-vel_range->lower[d]+1 == grid->cells[up->cdim+d]);
+    up->lat_cells[d] = up->num_nod1d*grid->cells[up->cdim+d];
+    dv[d] = grid->dx[up->cdim+d]/up->num_nod1d;
+    up->fft_len[d] = 1;
+    while (up->fft_len[d] < 2*up->lat_cells[d]) up->fft_len[d] *= 2;
+    up->lat_vol *= up->lat_cells[d];
+    up->fft_vol *= up->fft_len[d];
+
+    up->twiddle[d] = gkyl_malloc(sizeof(double complex[up->fft_len[d]/2]));
+    for (int k=0; k<up->fft_len[d]/2; ++k)
+      up->twiddle[d][k] = cexp(-2.0*M_PI*I*k/up->fft_len[d]);
+  }
+
+  init_nodes(up, pbasis);
+  init_kernels(up, dv);
+
+  // Split conf space amongst threads, each with its own workspace.
+  up->job_pool = job_pool? gkyl_job_pool_acquire(job_pool) : 0;
+  up->num_jobs = job_pool? GKYL_MIN2(job_pool->pool_size, up->conf_range.volume) : 1;
+  up->num_jobs = GKYL_MAX2(up->num_jobs, 1);
+  up->work = gkyl_malloc(up->num_jobs*sizeof(struct rosenbluth_potentials_work));
+  up->job_ctx = gkyl_malloc(up->num_jobs*sizeof(struct rosenbluth_potentials_job_ctx));
+  int max_len = GKYL_MAX2(up->fft_len[0], GKYL_MAX2(up->fft_len[1], up->fft_len[2]));
+  for (int j=0; j<up->num_jobs; ++j) {
+    struct rosenbluth_potentials_work *work = &up->work[j];
+    work->fnod = gkyl_malloc(sizeof(double[up->num_cnod*up->lat_vol]));
+    work->hnod = gkyl_malloc(sizeof(double[up->num_cnod*up->lat_vol]));
+    work->gnod = gkyl_malloc(sizeof(double[up->num_cnod*up->lat_vol]));
+    work->buff = gkyl_malloc(up->fft_vol*sizeof(double complex));
+    work->line = gkyl_malloc(sizeof(double complex[max_len]));
+    work->cell_nod = gkyl_malloc(sizeof(double[up->num_nod]));
+
+    up->job_ctx[j] = (struct rosenbluth_potentials_job_ctx) {
+      .up = up,
+      .work = work,
+      .loc_lo = j*up->conf_range.volume/up->num_jobs,
+      .loc_up = (j+1)*up->conf_range.volume/up->num_jobs,
+    };
+  }
+
+  return up;
+}
+
+void
+gkyl_rosenbluth_potentials_advance(struct gkyl_rosenbluth_potentials *up,
+  const struct gkyl_range *phase_range, const struct gkyl_array *fin,
+  struct gkyl_array *h, struct gkyl_array *g)
+{
+  for (int j=0; j<up->num_jobs; ++j) {
+    up->job_ctx[j].phase_range = phase_range;
+    up->job_ctx[j].fin = fin;
+    up->job_ctx[j].h = h;
+    up->job_ctx[j].g = g;
+  }
+
+  if (up->job_pool) {
+    for (int j=0; j<up->num_jobs; ++j)
+      gkyl_job_pool_add_work(up->job_pool, rosenbluth_potentials_job, &up->job_ctx[j]);
+    gkyl_job_pool_wait(up->job_pool);
+  }
+  else {
+    rosenbluth_potentials_job(&up->job_ctx[0]);
+  }
+}
+
+void
+gkyl_rosenbluth_potentials_release(struct gkyl_rosenbluth_potentials *up)
+{
+  for (int j=0; j<up->num_jobs; ++j) {
+    struct rosenbluth_potentials_work *work = &up->work[j];
+    gkyl_free(work->fnod);
+    gkyl_free(work->hnod);
+    gkyl_free(work->gnod);
+    gkyl_free(work->buff);
+    gkyl_free(work->line);
+    gkyl_free(work->cell_nod);
+  }
+  gkyl_free(up->work);
+  gkyl_free(up->job_ctx);
+  if (up->job_pool)
+    gkyl_job_pool_release(up->job_pool);
+
+  for (int d=0; d<3; ++d)
+    gkyl_free(up->twiddle[d]);
+  gkyl_free(up->kern_hat);
+  gkyl_free(up->basis_at_nod);
+  gkyl_free(up->nod_to_mod);
+  gkyl_free(up->vnod_off);
+  gkyl_free(up);
+}